@@ -15,6 +15,7 @@
 
 #include <hpx/components/component_storage/server/component_storage.hpp>
 
+#include <string>
 #include <vector>
 
 namespace hpx { namespace components
@@ -30,6 +31,17 @@ namespace hpx { namespace components
         component_storage(hpx::id_type target_locality);
         component_storage(hpx::future<naming::id_type> && f);
 
+        /// Create a storage instance on the given locality which keeps the
+        /// migrated components in the given file. All components found in an
+        /// existing file are made accessible again, they can be resurrected
+        /// using \a migrate_from_storage.
+        ///
+        /// \note The global ids of the restored components are bound to the
+        ///       storage instance, the application has to be restarted on
+        ///       the same set of localities for this to work.
+        component_storage(hpx::id_type target_locality,
+            std::string const& path);
+
         hpx::future<naming::id_type> migrate_to_here(std::vector<char> const&,
             naming::id_type const&, naming::address const&);
         hpx::future<std::vector<char> > migrate_from_here(
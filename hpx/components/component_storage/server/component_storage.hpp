@@ -17,7 +17,10 @@
 #include <hpx/components/containers/unordered/unordered_map.hpp>
 
 #include <hpx/components/component_storage/export_definitions.hpp>
+#include <hpx/components/component_storage/server/persistent_storage.hpp>
 
+#include <memory>
+#include <string>
 #include <vector>
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -32,17 +35,31 @@ namespace hpx { namespace components { namespace server
     public:
         component_storage();
 
+        // Keep the migrated components in the memory mapped log stored in
+        // the given file (see persistent_storage).
+        explicit component_storage(std::string const& path);
+
         naming::gid_type migrate_to_here(std::vector<char> const&,
             naming::id_type, naming::address const&);
         std::vector<char> migrate_from_here(naming::gid_type const&);
-        std::size_t size() const { return data_.size(); }
+        std::size_t size() const
+        {
+            return log_ ? log_->size() : data_.size();
+        }
+
+        // Bind the components found in the log of a persistent storage to
+        // this storage instance, this makes them accessible again after the
+        // application was restarted. Returns the number of components.
+        std::size_t restore();
 
         HPX_DEFINE_COMPONENT_ACTION(component_storage, migrate_to_here);
         HPX_DEFINE_COMPONENT_ACTION(component_storage, migrate_from_here);
         HPX_DEFINE_COMPONENT_ACTION(component_storage, size);
+        HPX_DEFINE_COMPONENT_ACTION(component_storage, restore);
 
     private:
         hpx::unordered_map<naming::gid_type, std::vector<char> > data_;
+        std::unique_ptr<persistent_storage> log_;
     };
 }}}
 
@@ -55,6 +72,9 @@ HPX_REGISTER_ACTION_DECLARATION(
 HPX_REGISTER_ACTION_DECLARATION(
     hpx::components::server::component_storage::size_action,
     component_storage_size_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpx::components::server::component_storage::restore_action,
+    component_storage_restore_action);
 
 typedef std::vector<char> hpx_component_storage_data_type;
 HPX_REGISTER_UNORDERED_MAP_DECLARATION(
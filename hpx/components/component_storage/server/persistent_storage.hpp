@@ -0,0 +1,126 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_COMPONENT_STORAGE_PERSISTENT_STORAGE_OCT_18_2016_0412PM)
+#define HPX_COMPONENT_STORAGE_PERSISTENT_STORAGE_OCT_18_2016_0412PM
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/runtime/naming/address.hpp>
+#include <hpx/runtime/naming/name.hpp>
+
+#include <hpx/components/component_storage/export_definitions.hpp>
+
+#include <boost/cstdint.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace components { namespace server
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // The persistent_storage is the file backed storage engine used by the
+    // component_storage if it was created for a file. The serialized
+    // components are appended to a log which is mapped into memory, an index
+    // maps the global id of each stored component to its record in the log.
+    // Cold components are therefore paged out of memory by the operating
+    // system and survive a restart of the application: the index is rebuilt
+    // from the log when the file is opened again.
+    //
+    // Erasing a component only marks its record as dead. The space used by
+    // dead records is reclaimed by a compaction which runs on a separate
+    // HPX thread once the dead records outweigh the live ones. It copies the
+    // live records into a new file which replaces the log afterwards.
+    //
+    // The layout of the log file is:
+    //
+    //      file_header | record_header | data | record_header | data | ...
+    //
+    // where every data block is padded to a multiple of 8 bytes. Only the
+    // records up to file_header::end_ are valid, it is updated after a
+    // record was written completely.
+    class HPX_MIGRATE_TO_STORAGE_EXPORT persistent_storage
+    {
+    private:
+        typedef lcos::local::spinlock mutex_type;
+
+        struct mapping;
+
+        struct index_entry
+        {
+            std::size_t offset_;        // offset of the record in the log
+            std::size_t size_;          // size of the stored data
+            naming::address addr_;      // last address of the component
+        };
+
+        typedef std::unordered_map<naming::gid_type, index_entry> index_type;
+
+    public:
+        // Open (or create) the log stored in the file with the given name.
+        explicit persistent_storage(std::string const& path);
+        ~persistent_storage();
+
+        persistent_storage(persistent_storage const&) = delete;
+        persistent_storage& operator=(persistent_storage const&) = delete;
+
+        // Append the data of the component with the given id to the log, an
+        // earlier record for the same id is replaced.
+        void store(naming::gid_type const& gid, naming::address const& addr,
+            std::vector<char> const& data);
+
+        // Retrieve the data of the component with the given id, returns
+        // false if no such component is stored.
+        bool load(naming::gid_type const& gid, std::vector<char>& data,
+            bool erase = false);
+
+        // Return the ids and last addresses of all stored components.
+        std::vector<std::pair<naming::gid_type, naming::address> >
+            entries() const;
+
+        std::size_t size() const;
+
+        std::string const& path() const { return path_; }
+
+        // Write all modified pages back to the file.
+        void flush();
+
+        // Reclaim the space used by dead records.
+        void compact();
+
+    private:
+        void open();
+        void close();
+
+        void reserve(std::size_t size);
+        void rebuild_index();
+        void erase_record(index_entry const& e);
+
+        void maybe_compact(std::unique_lock<mutex_type>& l);
+        void compact_log();
+
+        std::string path_;
+        int fd_;
+        std::shared_ptr<mapping> mapping_;
+
+        mutable mutex_type mtx_;
+        index_type index_;
+
+        std::size_t end_;               // end of the valid records
+        std::size_t live_bytes_;
+        std::size_t dead_bytes_;
+
+        bool compacting_;
+        hpx::future<void> compaction_;
+    };
+}}}
+
+#endif
@@ -0,0 +1,449 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file concurrent_unordered_map.hpp
+
+#if !defined(HPX_CONCURRENT_UNORDERED_MAP_OCT_18_2016_0815PM)
+#define HPX_CONCURRENT_UNORDERED_MAP_OCT_18_2016_0815PM
+
+#include <hpx/config.hpp>
+#include <hpx/parallel/algorithms/for_loop.hpp>
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/detail/yield_k.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/optional.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Reader/writer spinlock. Any number of readers may hold the lock at the
+    // same time. A writer announces itself first (which keeps new readers
+    // from entering) and then waits for the active readers to leave.
+    class shared_spinlock
+    {
+        HPX_NON_COPYABLE(shared_spinlock);
+
+        enum { writer = 0x40000000 };
+
+    public:
+        shared_spinlock()
+          : state_(0)
+        {}
+
+        void lock()
+        {
+            for (std::size_t k = 0; /**/; ++k)
+            {
+                boost::int32_t s = state_.load(boost::memory_order_relaxed);
+                if (!(s & writer) && state_.compare_exchange_weak(s, s | writer,
+                        boost::memory_order_acquire))
+                {
+                    break;
+                }
+                util::detail::yield_k(k, "hpx::detail::shared_spinlock::lock");
+            }
+
+            for (std::size_t k = 0;
+                 state_.load(boost::memory_order_acquire) != writer; ++k)
+            {
+                util::detail::yield_k(k, "hpx::detail::shared_spinlock::lock");
+            }
+        }
+
+        void unlock()
+        {
+            HPX_ASSERT(state_.load(boost::memory_order_relaxed) == writer);
+            state_.store(0, boost::memory_order_release);
+        }
+
+        void lock_shared()
+        {
+            for (std::size_t k = 0; /**/; ++k)
+            {
+                boost::int32_t s = state_.load(boost::memory_order_relaxed);
+                if (!(s & writer) && state_.compare_exchange_weak(s, s + 1,
+                        boost::memory_order_acquire))
+                {
+                    break;
+                }
+                util::detail::yield_k(k,
+                    "hpx::detail::shared_spinlock::lock_shared");
+            }
+        }
+
+        void unlock_shared()
+        {
+            HPX_ASSERT(
+                (state_.load(boost::memory_order_relaxed) & ~writer) != 0);
+            state_.fetch_sub(1, boost::memory_order_release);
+        }
+
+    private:
+        boost::atomic<boost::int32_t> state_;
+    };
+
+    struct shared_lock_guard
+    {
+        HPX_NON_COPYABLE(shared_lock_guard);
+
+        explicit shared_lock_guard(shared_spinlock& mtx)
+          : mtx_(mtx)
+        {
+            mtx_.lock_shared();
+        }
+        ~shared_lock_guard()
+        {
+            mtx_.unlock_shared();
+        }
+
+        shared_spinlock& mtx_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Hash table which can be concurrently accessed by any number of
+    /// threads.
+    ///
+    /// The keys are distributed over a (power of two) number of stripes,
+    /// each of which is a std::unordered_map protected by its own reader/
+    /// writer lock. Lookups only take the lock of their stripe in shared
+    /// mode, i.e. readers never block each other, and writers only block
+    /// the accesses to the same stripe. The batched operations sort the keys
+    /// by stripe, take every stripe lock only once, and process large batches
+    /// in parallel on all available cores.
+    template <typename Key, typename T, typename Hash = std::hash<Key>,
+        typename KeyEqual = std::equal_to<Key> >
+    class concurrent_unordered_map
+    {
+    public:
+        typedef std::unordered_map<Key, T, Hash, KeyEqual> data_type;
+        typedef typename data_type::size_type size_type;
+
+        // batches with less keys than this are processed sequentially
+        static const std::size_t parallel_batch_threshold = 4096;
+
+    private:
+        enum { cache_line_size = 64 };
+
+        struct stripe
+        {
+            mutable shared_spinlock mtx_;
+            data_type data_;
+
+            // avoid false sharing between the locks of neighboring stripes
+            char pad_[cache_line_size];
+        };
+
+        static std::size_t round_up_to_power_of_two(std::size_t size)
+        {
+            std::size_t result = 1;
+            while (result < size)
+                result <<= 1;
+            return result;
+        }
+
+    public:
+        explicit concurrent_unordered_map(std::size_t num_stripes = 64,
+                size_type bucket_count = 0, Hash const& hash = Hash(),
+                KeyEqual const& equal = KeyEqual())
+          : hash_(hash),
+            mask_(round_up_to_power_of_two(num_stripes) - 1),
+            stripes_(new stripe[mask_ + 1])
+        {
+            size_type stripe_bucket_count = bucket_count / (mask_ + 1);
+            for (std::size_t s = 0; s <= mask_; ++s)
+                stripes_[s].data_ = data_type(stripe_bucket_count, hash, equal);
+        }
+
+        concurrent_unordered_map(concurrent_unordered_map const& rhs)
+          : hash_(rhs.hash_),
+            mask_(rhs.mask_),
+            stripes_(new stripe[mask_ + 1])
+        {
+            for (std::size_t s = 0; s <= mask_; ++s)
+            {
+                shared_lock_guard l(rhs.stripes_[s].mtx_);
+                stripes_[s].data_ = rhs.stripes_[s].data_;
+            }
+        }
+
+        concurrent_unordered_map(concurrent_unordered_map && rhs)
+          : hash_(rhs.hash_),
+            mask_(rhs.mask_),
+            stripes_(new stripe[mask_ + 1])
+        {
+            for (std::size_t s = 0; s <= mask_; ++s)
+            {
+                std::lock_guard<shared_spinlock> l(rhs.stripes_[s].mtx_);
+                stripes_[s].data_ = std::move(rhs.stripes_[s].data_);
+            }
+        }
+
+        concurrent_unordered_map& operator=(concurrent_unordered_map const& rhs)
+        {
+            if (this != &rhs)
+                set_data(rhs.get_data());
+            return *this;
+        }
+
+        concurrent_unordered_map& operator=(concurrent_unordered_map && rhs)
+        {
+            if (this != &rhs)
+            {
+                data_type data;
+                for (std::size_t s = 0; s <= rhs.mask_; ++s)
+                {
+                    std::lock_guard<shared_spinlock> l(rhs.stripes_[s].mtx_);
+                    data_type& d = rhs.stripes_[s].data_;
+                    for (auto& v : d)
+                        data.emplace(v.first, std::move(v.second));
+                    d.clear();
+                }
+                set_data(std::move(data));
+            }
+            return *this;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        size_type size() const
+        {
+            size_type result = 0;
+            for (std::size_t s = 0; s <= mask_; ++s)
+            {
+                shared_lock_guard l(stripes_[s].mtx_);
+                result += stripes_[s].data_.size();
+            }
+            return result;
+        }
+
+        size_type max_size() const
+        {
+            return stripes_[0].data_.max_size();
+        }
+
+        bool empty() const
+        {
+            return size() == 0;
+        }
+
+        std::size_t num_stripes() const
+        {
+            return mask_ + 1;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        /// Return a copy of the value stored for the given key, returns an
+        /// empty optional if the key is not stored in the table.
+        boost::optional<T> get_value(Key const& key) const
+        {
+            stripe const& s = stripes_[stripe_index(key)];
+            shared_lock_guard l(s.mtx_);
+
+            typename data_type::const_iterator it = s.data_.find(key);
+            if (it == s.data_.end())
+                return boost::optional<T>();
+
+            return boost::optional<T>(it->second);
+        }
+
+        /// Move the value stored for the given key out of the table and
+        /// erase it, returns an empty optional if the key is not stored in
+        /// the table.
+        boost::optional<T> extract_value(Key const& key)
+        {
+            stripe& s = stripes_[stripe_index(key)];
+            std::lock_guard<shared_spinlock> l(s.mtx_);
+
+            typename data_type::iterator it = s.data_.find(key);
+            if (it == s.data_.end())
+                return boost::optional<T>();
+
+            boost::optional<T> result(std::move(it->second));
+            s.data_.erase(it);
+            return result;
+        }
+
+        /// Store the given value for the given key.
+        template <typename T_>
+        void set_value(Key const& key, T_ && val)
+        {
+            stripe& s = stripes_[stripe_index(key)];
+            std::lock_guard<shared_spinlock> l(s.mtx_);
+            s.data_[key] = std::forward<T_>(val);
+        }
+
+        /// Erase the value stored for the given key, returns the number of
+        /// erased elements.
+        size_type erase(Key const& key)
+        {
+            stripe& s = stripes_[stripe_index(key)];
+            std::lock_guard<shared_spinlock> l(s.mtx_);
+            return s.data_.erase(key);
+        }
+
+        void clear()
+        {
+            for (std::size_t s = 0; s <= mask_; ++s)
+            {
+                std::lock_guard<shared_spinlock> l(stripes_[s].mtx_);
+                stripes_[s].data_.clear();
+            }
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        /// Copy the values stored for all of the given keys to \a vals,
+        /// returns false if any of the keys is not stored in the table.
+        bool get_values(std::vector<Key> const& keys,
+            std::vector<T>& vals) const
+        {
+            // the stripes are visited concurrently and in any order, T is
+            // not required to be default constructible
+            std::vector<boost::optional<T> > found_vals(keys.size());
+
+            boost::atomic<bool> found(true);
+            for_each_batch(keys,
+                [&](std::size_t stripe_num, std::size_t const* first,
+                    std::size_t const* last)
+                {
+                    stripe const& s = stripes_[stripe_num];
+                    shared_lock_guard l(s.mtx_);
+
+                    for (/**/; first != last; ++first)
+                    {
+                        typename data_type::const_iterator it =
+                            s.data_.find(keys[*first]);
+                        if (it == s.data_.end())
+                        {
+                            found.store(false, boost::memory_order_relaxed);
+                            continue;
+                        }
+                        found_vals[*first] = it->second;
+                    }
+                });
+
+            if (!found.load(boost::memory_order_relaxed))
+                return false;
+
+            vals.clear();
+            vals.reserve(keys.size());
+            for (boost::optional<T>& val : found_vals)
+                vals.push_back(std::move(*val));
+            return true;
+        }
+
+        /// Store the given values for the given keys.
+        void set_values(std::vector<Key> const& keys,
+            std::vector<T> const& vals)
+        {
+            HPX_ASSERT(keys.size() == vals.size());
+
+            for_each_batch(keys,
+                [&](std::size_t stripe_num, std::size_t const* first,
+                    std::size_t const* last)
+                {
+                    stripe& s = stripes_[stripe_num];
+                    std::lock_guard<shared_spinlock> l(s.mtx_);
+
+                    for (/**/; first != last; ++first)
+                        s.data_[keys[*first]] = vals[*first];
+                });
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        /// Return a copy of all stored elements
+        data_type get_data() const
+        {
+            data_type result(0, hash_, stripes_[0].data_.key_eq());
+            for (std::size_t s = 0; s <= mask_; ++s)
+            {
+                shared_lock_guard l(stripes_[s].mtx_);
+                result.insert(stripes_[s].data_.begin(),
+                    stripes_[s].data_.end());
+            }
+            return result;
+        }
+
+        /// Replace all stored elements with the given ones
+        void set_data(data_type && data)
+        {
+            clear();
+            for (auto& v : data)
+                set_value(v.first, std::move(v.second));
+        }
+
+    private:
+        std::size_t stripe_index(Key const& key) const
+        {
+            // mix the hash value as the stripe is selected from its upper
+            // bits, which are left unused by many (identity-like) hashes
+            boost::uint64_t h = static_cast<boost::uint64_t>(hash_(key));
+            return static_cast<std::size_t>(
+                (h * 0x9E3779B97F4A7C15ull) >> 40) & mask_;
+        }
+
+        // Invoke f(stripe_num, first, last) for all stripes, where
+        // [first, last) is the range of indices of the keys stored in
+        // the stripe.
+        template <typename F>
+        void for_each_batch(std::vector<Key> const& keys, F && f) const
+        {
+            std::size_t const count = keys.size();
+            if (count < parallel_batch_threshold)
+            {
+                for (std::size_t i = 0; i != count; ++i)
+                    f(stripe_index(keys[i]), &i, &i + 1);
+                return;
+            }
+
+            // sort the indices of the keys by stripe
+            std::size_t const num_stripes = mask_ + 1;
+
+            std::vector<std::size_t> stripe_nums(count);
+            std::vector<std::size_t> offsets(num_stripes + 1, 0);
+            for (std::size_t i = 0; i != count; ++i)
+            {
+                stripe_nums[i] = stripe_index(keys[i]);
+                ++offsets[stripe_nums[i] + 1];
+            }
+            for (std::size_t s = 0; s != num_stripes; ++s)
+                offsets[s + 1] += offsets[s];
+
+            std::vector<std::size_t> indices(count);
+            {
+                std::vector<std::size_t> pos(
+                    offsets.begin(), offsets.end() - 1);
+                for (std::size_t i = 0; i != count; ++i)
+                    indices[pos[stripe_nums[i]]++] = i;
+            }
+
+            hpx::parallel::for_loop(hpx::parallel::par,
+                std::size_t(0), num_stripes,
+                [&](std::size_t s)
+                {
+                    if (offsets[s] != offsets[s + 1])
+                    {
+                        f(s, indices.data() + offsets[s],
+                            indices.data() + offsets[s + 1]);
+                    }
+                });
+        }
+
+    private:
+        Hash hash_;
+        std::size_t const mask_;
+        std::unique_ptr<stripe[]> stripes_;
+    };
+}}
+
+#endif
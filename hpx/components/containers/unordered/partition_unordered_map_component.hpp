@@ -23,12 +23,15 @@
 #include <hpx/runtime/actions/plain_action.hpp>
 #include <hpx/runtime/components/client_base.hpp>
 #include <hpx/runtime/components/component_factory.hpp>
-#include <hpx/runtime/components/server/locking_hook.hpp>
 #include <hpx/runtime/components/server/simple_component_base.hpp>
+#include <hpx/runtime/get_os_thread_count.hpp>
 #include <hpx/runtime/get_ptr.hpp>
 #include <hpx/throw_exception.hpp>
 #include <hpx/util/assert.hpp>
 
+#include <hpx/components/containers/unordered/concurrent_unordered_map.hpp>
+
+#include <boost/optional.hpp>
 #include <boost/preprocessor/cat.hpp>
 
 #include <iostream>
@@ -44,28 +47,34 @@ namespace hpx { namespace server
     /// \brief This is the basic wrapper class for stl unordered_map.
     ///
     /// This contain the implementation of the partition_unordered_map's
-    /// component functionality.
+    /// component functionality. The data is stored in a concurrent hash
+    /// table, which allows for all actions to be executed concurrently.
     template <typename Key, typename T, typename Hash = std::hash<Key>,
         typename KeyEqual = std::equal_to<Key> >
     class partition_unordered_map
-      : public components::locking_hook<
-            hpx::components::simple_component_base<
-                partition_unordered_map<Key, T, Hash, KeyEqual> > >
+      : public hpx::components::simple_component_base<
+            partition_unordered_map<Key, T, Hash, KeyEqual> >
     {
     public:
-        typedef std::unordered_map<Key, T, Hash, KeyEqual> data_type;
+        typedef hpx::detail::concurrent_unordered_map<Key, T, Hash, KeyEqual>
+            storage_type;
+        typedef typename storage_type::data_type data_type;
 
         typedef typename data_type::size_type size_type;
-        typedef typename data_type::iterator iterator_type;
-        typedef typename data_type::const_iterator const_iterator_type;
 
-        typedef components::locking_hook<
-                hpx::components::simple_component_base<
-                    partition_unordered_map<Key, T, Hash, KeyEqual> > >
+        typedef hpx::components::simple_component_base<
+                partition_unordered_map<Key, T, Hash, KeyEqual> >
             base_type;
 
     private:
-        data_type partition_unordered_map_;
+        // use a couple of stripes per core to keep the probability of
+        // concurrent accesses hitting the same stripe low
+        static std::size_t default_num_stripes()
+        {
+            return 4 * hpx::get_os_thread_count();
+        }
+
+        storage_type partition_unordered_map_;
 
     public:
         ///////////////////////////////////////////////////////////////////////
@@ -75,16 +84,18 @@ namespace hpx { namespace server
         /// Default Constructor which create partition_unordered_map
         /// with size 0.
         partition_unordered_map()
+          : partition_unordered_map_(default_num_stripes())
         {
         }
 
         explicit partition_unordered_map(size_type bucket_count)
-          : partition_unordered_map_(bucket_count)
+          : partition_unordered_map_(default_num_stripes(), bucket_count)
         {}
 
         partition_unordered_map(size_type bucket_count, Hash const& hash,
                 KeyEqual const& equal)
-          : partition_unordered_map_(bucket_count, hash, equal)
+          : partition_unordered_map_(default_num_stripes(), bucket_count,
+                hash, equal)
         {}
 
         // support components::copy
@@ -121,38 +132,11 @@ namespace hpx { namespace server
         /// Duplicate the copy method for action naming
         data_type get_copied_data() const
         {
-            return partition_unordered_map_;
+            return partition_unordered_map_.get_data();
         }
         void set_copied_data(data_type && d)
         {
-            partition_unordered_map_ = std::move(d);
-        }
-
-        ///////////////////////////////////////////////////////////////////////
-        iterator_type begin()
-        {
-            return partition_unordered_map_.begin();
-        }
-        const_iterator_type begin() const
-        {
-            return partition_unordered_map_.begin();
-        }
-        const_iterator_type cbegin() const
-        {
-            return partition_unordered_map_.cbegin();
-        }
-
-        iterator_type end()
-        {
-            return partition_unordered_map_.end();
-        }
-        const_iterator_type end() const
-        {
-            return partition_unordered_map_.end();
-        }
-        const_iterator_type cend() const
-        {
-            return partition_unordered_map_.cend();
+            partition_unordered_map_.set_data(std::move(d));
         }
 
         ///////////////////////////////////////////////////////////////////////
@@ -171,13 +155,6 @@ namespace hpx { namespace server
             return partition_unordered_map_.max_size();
         }
 
-        /// Returns the number of elements that the container has currently
-        /// allocated space for.
-        size_type capacity() const
-        {
-            return partition_unordered_map_.capacity();
-        }
-
         /// Checks if the container has no elements, i.e. whether
         /// begin() == end().
         bool empty() const
@@ -197,36 +174,19 @@ namespace hpx { namespace server
         /// \return Return the value of the element at position represented
         ///         by \a pos.
         ///
-        struct erase_on_exit
-        {
-            erase_on_exit(data_type& m, typename data_type::iterator& it)
-              : m_(m), it_(it)
-            {}
-            ~erase_on_exit()
-            {
-                m_.erase(it_);
-            }
-
-            data_type& m_;
-            typename data_type::iterator& it_;
-        };
-
         T get_value(Key const& key, bool erase)
         {
-            typename data_type::iterator it = partition_unordered_map_.find(key);
-            if (it == partition_unordered_map_.end())
+            boost::optional<T> result = erase ?
+                partition_unordered_map_.extract_value(key) :
+                partition_unordered_map_.get_value(key);
+            if (!result)
             {
                 HPX_THROW_EXCEPTION(bad_parameter,
                     "partition_unordered_map::get_value",
                     "unable to find requested key in this partition of the "
                     "unordered_map");
             }
-
-            if (!erase)
-                return it->second;
-
-            erase_on_exit t(partition_unordered_map_, it);
-            return it->second;
+            return std::move(*result);
         }
 
         /// Return the element at the position \a pos in the partition_unordered_map
@@ -240,21 +200,12 @@ namespace hpx { namespace server
         std::vector<T> get_values(std::vector<Key> const& keys)
         {
             std::vector<T> result;
-            result.reserve(keys.size());
-
-            for (std::size_t i = 0; i != keys.size(); ++i)
+            if (!partition_unordered_map_.get_values(keys, result))
             {
-                typename data_type::iterator it =
-                    partition_unordered_map_.find(keys[i]);
-                if (it == partition_unordered_map_.end())
-                {
-                    HPX_THROW_EXCEPTION(bad_parameter,
-                        "partition_unordered_map::get_values",
-                        "unable to find requested key in this partition of the "
-                        "unordered_map");
-                    break;
-                }
-                result.push_back(it->second);
+                HPX_THROW_EXCEPTION(bad_parameter,
+                    "partition_unordered_map::get_values",
+                    "unable to find requested key in this partition of the "
+                    "unordered_map");
             }
             return result;
         }
@@ -272,7 +223,7 @@ namespace hpx { namespace server
         ///
         void set_value(Key const& pos, T const& val)
         {
-            partition_unordered_map_[pos] = val;
+            partition_unordered_map_.set_value(pos, val);
         }
 
         /// Copy the value of \a val for the elements at positions \a pos in
@@ -286,10 +237,7 @@ namespace hpx { namespace server
             std::vector<T> const& val)
         {
             HPX_ASSERT(keys.size() == val.size());
-            HPX_ASSERT(keys.size() <= partition_unordered_map_.size());
-
-            for (std::size_t i = 0; i != keys.size(); ++i)
-                partition_unordered_map_[keys[i]] = val[i];
+            partition_unordered_map_.set_values(keys, val);
         }
 
         /// Remove all elements from the vector leaving the
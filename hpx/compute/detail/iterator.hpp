@@ -9,12 +9,14 @@
 #define HPX_COMPUTE_DETAIL_ITERATOR_HPP
 
 #include <hpx/config.hpp>
+#include <hpx/traits/is_contiguous_iterator.hpp>
 #include <hpx/util/assert.hpp>
 
 #include <hpx/compute/detail/get_proxy_type.hpp>
 #include <hpx/compute/traits/allocator_traits.hpp>
 
 #include <iterator>
+#include <type_traits>
 
 namespace hpx { namespace compute { namespace detail
 {
@@ -195,4 +197,19 @@ namespace hpx { namespace compute { namespace detail
     };
 }}}
 
+namespace hpx { namespace traits
+{
+    // The elements of a compute::vector are contiguous in memory if the
+    // allocator hands out plain pointers, this is the case for all host
+    // allocators.
+    template <typename T, typename Allocator>
+    struct is_contiguous_iterator<compute::detail::iterator<T, Allocator> >
+      : std::integral_constant<bool,
+            std::is_pointer<typename compute::detail::iterator<
+                T, Allocator>::pointer>::value &&
+            std::is_lvalue_reference<typename compute::detail::iterator<
+                T, Allocator>::reference>::value>
+    {};
+}}
+
 #endif
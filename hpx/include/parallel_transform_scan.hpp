@@ -8,6 +8,8 @@
 
 #include <hpx/parallel/algorithms/transform_exclusive_scan.hpp>
 #include <hpx/parallel/algorithms/transform_inclusive_scan.hpp>
+#include <hpx/parallel/segmented_algorithms/transform_exclusive_scan.hpp>
+#include <hpx/parallel/segmented_algorithms/transform_inclusive_scan.hpp>
 
 #endif
 
@@ -136,6 +136,7 @@ namespace hpx { namespace lcos
 
 #include <hpx/config.hpp>
 #include <hpx/lcos/detail/async_colocated.hpp>
+#include <hpx/lcos/detail/collective_tree.hpp>
 #include <hpx/lcos/future.hpp>
 #include <hpx/lcos/when_all.hpp>
 #include <hpx/runtime/actions/plain_action.hpp>
@@ -145,7 +146,6 @@ namespace hpx { namespace lcos
 #include <hpx/throw_exception.hpp>
 #include <hpx/traits/extract_action.hpp>
 #include <hpx/traits/promise_local_result.hpp>
-#include <hpx/util/calculate_fanout.hpp>
 #include <hpx/util/detail/count_num_args.hpp>
 #include <hpx/util/detail/pack.hpp>
 #include <hpx/util/tuple.hpp>
@@ -156,6 +156,7 @@ namespace hpx { namespace lcos
 #include <utility>
 #include <vector>
 
+// The maximal arity of the tree spanning the sites of a broadcast
 #if !defined(HPX_BROADCAST_FANOUT)
 #define HPX_BROADCAST_FANOUT 16
 #endif
@@ -545,13 +546,12 @@ namespace hpx { namespace lcos
         {
             if(ids.empty()) return;// hpx::lcos::make_ready_future();
 
-            std::size_t const local_fanout = HPX_BROADCAST_FANOUT;
-            std::size_t local_size = (std::min)(ids.size(), local_fanout);
-            std::size_t fanout = util::calculate_fanout(ids.size(), local_fanout);
+            std::vector<std::size_t> const bounds =
+                collective_tree_split(ids, HPX_BROADCAST_FANOUT);
 
             std::vector<hpx::future<void> > broadcast_futures;
-            broadcast_futures.reserve(local_size + (ids.size()/fanout) + 1);
-            for(std::size_t i = 0; i != local_size; ++i)
+            broadcast_futures.reserve(bounds[0] + bounds.size() - 1);
+            for(std::size_t i = 0; i != bounds[0]; ++i)
             {
                 broadcast_invoke(
                     act
@@ -562,40 +562,41 @@ namespace hpx { namespace lcos
                 );
             }
 
-            if(ids.size() > local_fanout)
-            {
-                std::size_t applied = local_fanout;
-                std::vector<hpx::id_type>::const_iterator it =
-                    ids.begin() + local_fanout;
-
-                typedef
-                    typename detail::make_broadcast_action<
-                        Action
-                    >::type
-                    broadcast_impl_action;
+            typedef
+                typename detail::make_broadcast_action<
+                    Action
+                >::type
+                broadcast_impl_action;
 
-                while(it != ids.end())
+            for(std::size_t i = 1; i != bounds.size(); ++i)
+            {
+                std::size_t first = bounds[i - 1];
+                if(bounds[i] - first == 1)
                 {
-                    HPX_ASSERT(ids.size() >= applied);
-
-                    std::size_t next_fan = (std::min)(fanout, ids.size() - applied);
-                    std::vector<hpx::id_type> ids_next(it, it + next_fan);
-
-                    hpx::id_type id(ids_next[0]);
-                    broadcast_futures.push_back(
-                        hpx::detail::async_colocated<broadcast_impl_action>(
-                            id
-                          , act
-                          , std::move(ids_next)
-                          , global_idx + applied
-                          , std::true_type()
-                          , vs...
-                        )
+                    broadcast_invoke(
+                        act
+                      , broadcast_futures
+                      , ids[first]
+                      , global_idx + first
+                      , vs...
                     );
-
-                    applied += next_fan;
-                    it += next_fan;
+                    continue;
                 }
+
+                std::vector<hpx::id_type> ids_next(
+                    ids.begin() + first, ids.begin() + bounds[i]);
+
+                hpx::id_type id(ids_next[0]);
+                broadcast_futures.push_back(
+                    hpx::detail::async_colocated<broadcast_impl_action>(
+                        id
+                      , act
+                      , std::move(ids_next)
+                      , global_idx + first
+                      , std::true_type()
+                      , vs...
+                    )
+                );
             }
 
             //return hpx::when_all(broadcast_futures).then(&return_void);
@@ -626,13 +627,12 @@ namespace hpx { namespace lcos
             //if(ids.empty()) return hpx::lcos::make_ready_future(result_type());
             if(ids.empty()) return result_type();
 
-            std::size_t const local_fanout = HPX_BROADCAST_FANOUT;
-            std::size_t local_size = (std::min)(ids.size(), local_fanout);
-            std::size_t fanout = util::calculate_fanout(ids.size(), local_fanout);
+            std::vector<std::size_t> const bounds =
+                collective_tree_split(ids, HPX_BROADCAST_FANOUT);
 
             std::vector<hpx::future<result_type> > broadcast_futures;
-            broadcast_futures.reserve(local_size + (ids.size()/fanout) + 1);
-            for(std::size_t i = 0; i != local_size; ++i)
+            broadcast_futures.reserve(bounds[0] + bounds.size() - 1);
+            for(std::size_t i = 0; i != bounds[0]; ++i)
             {
                 broadcast_invoke(
                     act
@@ -644,40 +644,42 @@ namespace hpx { namespace lcos
                 );
             }
 
-            if(ids.size() > local_fanout)
-            {
-                std::size_t applied = local_fanout;
-                std::vector<hpx::id_type>::const_iterator it =
-                    ids.begin() + local_fanout;
-
-                typedef
-                    typename detail::make_broadcast_action<
-                        Action
-                    >::type
-                    broadcast_impl_action;
+            typedef
+                typename detail::make_broadcast_action<
+                    Action
+                >::type
+                broadcast_impl_action;
 
-                while(it != ids.end())
+            for(std::size_t i = 1; i != bounds.size(); ++i)
+            {
+                std::size_t first = bounds[i - 1];
+                if(bounds[i] - first == 1)
                 {
-                    HPX_ASSERT(ids.size() >= applied);
-
-                    std::size_t next_fan = (std::min)(fanout, ids.size() - applied);
-                    std::vector<hpx::id_type> ids_next(it, it + next_fan);
-
-                    hpx::id_type id(ids_next[0]);
-                    broadcast_futures.push_back(
-                        hpx::detail::async_colocated<broadcast_impl_action>(
-                            id
-                          , act
-                          , std::move(ids_next)
-                          , global_idx + applied
-                          , std::false_type()
-                          , vs...
-                        )
+                    broadcast_invoke(
+                        act
+                      , broadcast_futures
+                      , &wrap_into_vector<action_result>
+                      , ids[first]
+                      , global_idx + first
+                      , vs...
                     );
-
-                    applied += next_fan;
-                    it += next_fan;
+                    continue;
                 }
+
+                std::vector<hpx::id_type> ids_next(
+                    ids.begin() + first, ids.begin() + bounds[i]);
+
+                hpx::id_type id(ids_next[0]);
+                broadcast_futures.push_back(
+                    hpx::detail::async_colocated<broadcast_impl_action>(
+                        id
+                      , act
+                      , std::move(ids_next)
+                      , global_idx + first
+                      , std::false_type()
+                      , vs...
+                    )
+                );
             }
 
             return hpx::when_all(broadcast_futures).
@@ -699,10 +701,10 @@ namespace hpx { namespace lcos
         {
             if(ids.empty()) return;
 
-            std::size_t const local_fanout = HPX_BROADCAST_FANOUT;
-            std::size_t local_size = (std::min)(ids.size(), local_fanout);
+            std::vector<std::size_t> const bounds =
+                collective_tree_split(ids, HPX_BROADCAST_FANOUT);
 
-            for(std::size_t i = 0; i != local_size; ++i)
+            for(std::size_t i = 0; i != bounds[0]; ++i)
             {
                 broadcast_invoke_apply(
                     act
@@ -712,38 +714,37 @@ namespace hpx { namespace lcos
                 );
             }
 
-            if(ids.size() > local_fanout)
-            {
-                std::size_t applied = local_fanout;
-                std::vector<hpx::id_type>::const_iterator it =
-                    ids.begin() + local_fanout;
-
-                typedef
-                    typename detail::make_broadcast_apply_action<
-                        Action
-                    >::type
-                    broadcast_impl_action;
+            typedef
+                typename detail::make_broadcast_apply_action<
+                    Action
+                >::type
+                broadcast_impl_action;
 
-                std::size_t fanout = util::calculate_fanout(ids.size(), local_fanout);
-                while(it != ids.end())
+            for(std::size_t i = 1; i != bounds.size(); ++i)
+            {
+                std::size_t first = bounds[i - 1];
+                if(bounds[i] - first == 1)
                 {
-                    HPX_ASSERT(ids.size() >= applied);
-
-                    std::size_t next_fan = (std::min)(fanout, ids.size() - applied);
-                    std::vector<hpx::id_type> ids_next(it, it + next_fan);
-
-                    hpx::id_type id(ids_next[0]);
-                    hpx::detail::apply_colocated<broadcast_impl_action>(
-                        id
-                      , act
-                      , std::move(ids_next)
-                      , global_idx + applied
+                    broadcast_invoke_apply(
+                        act
+                      , ids[first]
+                      , global_idx + first
                       , vs...
                     );
-
-                    applied += next_fan;
-                    it += next_fan;
+                    continue;
                 }
+
+                std::vector<hpx::id_type> ids_next(
+                    ids.begin() + first, ids.begin() + bounds[i]);
+
+                hpx::id_type id(ids_next[0]);
+                hpx::detail::apply_colocated<broadcast_impl_action>(
+                    id
+                  , act
+                  , std::move(ids_next)
+                  , global_idx + first
+                  , vs...
+                );
             }
         }
     }
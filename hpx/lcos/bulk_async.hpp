@@ -0,0 +1,401 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file bulk_async.hpp
+
+#if !defined(HPX_LCOS_BULK_ASYNC_OCT_18_2016_0315PM)
+#define HPX_LCOS_BULK_ASYNC_OCT_18_2016_0315PM
+
+#if defined(DOXYGEN)
+namespace hpx { namespace lcos
+{
+    /// \brief Invoke the given action on a set of global identifiers
+    ///
+    /// The function hpx::lcos::bulk_async invokes the given action on all
+    /// given global identifiers. In contrast to invoking hpx::async for
+    /// every identifier, all identifiers are resolved using a single AGAS
+    /// request (per AGAS instance), the credits of all identifiers are split
+    /// at once, and the parcels going to the same locality are handed to the
+    /// parcel layer together.
+    ///
+    /// \param ids       [in] A list of global identifiers identifying the
+    ///                  target objects for which the given action will be
+    ///                  invoked.
+    /// \param argN      [in] Any number of arbitrary arguments (passed by
+    ///                  by const reference) which will be forwarded to the
+    ///                  action invocations.
+    ///
+    /// \returns         This function returns one future for every given
+    ///                  identifier, representing the result of the
+    ///                  corresponding action invocation.
+    ///
+    template <typename Action, typename ArgN, ...>
+    std::vector<hpx::future<decltype(Action(hpx::id_type, ArgN, ...))> >
+    bulk_async(std::vector<hpx::id_type> const& ids, ArgN argN, ...);
+
+    /// \brief Invoke the given action (fire&forget) on a set of global
+    ///        identifiers
+    ///
+    /// The function hpx::lcos::bulk_apply invokes the given action on all
+    /// given global identifiers, the identifiers are resolved and the
+    /// parcels are sent as described for hpx::lcos::bulk_async.
+    ///
+    /// \param ids       [in] A list of global identifiers identifying the
+    ///                  target objects for which the given action will be
+    ///                  invoked.
+    /// \param argN      [in] Any number of arbitrary arguments (passed by
+    ///                  by const reference) which will be forwarded to the
+    ///                  action invocations.
+    ///
+    template <typename Action, typename ArgN, ...>
+    void bulk_apply(std::vector<hpx::id_type> const& ids, ArgN argN, ...);
+}}
+#else
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/promise.hpp>
+#include <hpx/runtime/actions/action_priority.hpp>
+#include <hpx/runtime/actions/continuation.hpp>
+#include <hpx/runtime/agas/interface.hpp>
+#include <hpx/runtime/applier/apply.hpp>
+#include <hpx/runtime/naming/address.hpp>
+#include <hpx/runtime/naming/id_type.hpp>
+#include <hpx/runtime/naming/name.hpp>
+#include <hpx/runtime/naming/split_gid.hpp>
+#include <hpx/runtime/parcelset/parcel.hpp>
+#include <hpx/runtime/parcelset/parcelhandler.hpp>
+#include <hpx/runtime_fwd.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/traits/action_is_target_valid.hpp>
+#include <hpx/traits/extract_action.hpp>
+#include <hpx/util/bind.hpp>
+#include <hpx/util/decay.hpp>
+
+#include <boost/exception_ptr.hpp>
+#include <boost/format.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace lcos
+{
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // The invocations of bulk_apply don't report their results.
+        struct bulk_apply_handler
+        {
+            template <typename Action, typename ...Ts>
+            void apply(std::size_t, naming::id_type const& id,
+                naming::address&& addr, threads::thread_priority priority,
+                Ts const&... vs)
+            {
+                hpx::detail::apply_impl<Action>(id, std::move(addr),
+                    priority, vs...);
+            }
+
+            template <typename Action, typename ...Ts>
+            parcelset::parcel make_parcel(std::size_t,
+                naming::id_type const& id, naming::address&& addr,
+                threads::thread_priority priority, Ts const&... vs)
+            {
+                return parcelset::parcel(id, std::move(addr), Action(),
+                    priority, vs...);
+            }
+
+            void put_parcels(parcelset::parcelhandler& ph,
+                std::vector<std::size_t> const&,
+                std::vector<parcelset::parcel> parcels)
+            {
+                ph.put_parcels(std::move(parcels));
+            }
+
+            void set_exception(std::vector<std::size_t> const&,
+                boost::exception_ptr const& e)
+            {
+                hpx::report_error(e);
+            }
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // The invocations of bulk_async set one promise each, the promises
+        // are kept alive until all parcels have been sent.
+        template <typename Action>
+        struct bulk_async_handler
+        {
+            typedef typename hpx::traits::extract_action<Action>::type
+                action_type;
+            typedef typename action_type::local_result_type result_type;
+            typedef typename action_type::remote_result_type
+                remote_result_type;
+
+            typedef lcos::promise<result_type, remote_result_type>
+                promise_type;
+            typedef std::shared_ptr<std::vector<promise_type> >
+                promises_type;
+            typedef actions::typed_continuation<
+                    result_type, remote_result_type
+                > continuation_type;
+
+            explicit bulk_async_handler(std::size_t count)
+              : promises_(std::make_shared<std::vector<promise_type> >(count))
+            {}
+
+            std::vector<hpx::future<result_type> > get_futures()
+            {
+                std::vector<hpx::future<result_type> > futures;
+                futures.reserve(promises_->size());
+                for (promise_type& p : *promises_)
+                    futures.push_back(p.get_future());
+                return futures;
+            }
+
+            template <typename Action_, typename ...Ts>
+            void apply(std::size_t i, naming::id_type const& id,
+                naming::address&& addr, threads::thread_priority priority,
+                Ts const&... vs)
+            {
+                hpx::detail::apply_impl<Action_>(get_continuation(i), id,
+                    std::move(addr), priority, vs...);
+            }
+
+            template <typename Action_, typename ...Ts>
+            parcelset::parcel make_parcel(std::size_t i,
+                naming::id_type const& id, naming::address&& addr,
+                threads::thread_priority priority, Ts const&... vs)
+            {
+                return parcelset::parcel(id, std::move(addr),
+                    get_continuation(i), Action_(), priority, vs...);
+            }
+
+            void put_parcels(parcelset::parcelhandler& ph,
+                std::vector<std::size_t> const& indices,
+                std::vector<parcelset::parcel> parcels)
+            {
+                using util::placeholders::_1;
+                using util::placeholders::_2;
+
+                std::vector<parcelset::parcelhandler::write_handler_type>
+                    handlers;
+                handlers.reserve(indices.size());
+                for (std::size_t i : indices)
+                {
+                    handlers.push_back(util::bind(
+                        &bulk_async_handler::parcel_write_handler,
+                        promises_, i, _1, _2));
+                }
+
+                ph.put_parcels(std::move(parcels), std::move(handlers));
+            }
+
+            void set_exception(std::vector<std::size_t> const& indices,
+                boost::exception_ptr const& e)
+            {
+                for (std::size_t i : indices)
+                    (*promises_)[i].set_exception(e);
+            }
+
+        private:
+            continuation_type get_continuation(std::size_t i)
+            {
+                promise_type& p = (*promises_)[i];
+
+                naming::id_type cont_id(p.get_id());
+                naming::detail::set_dont_store_in_cache(cont_id);
+
+                return continuation_type(std::move(cont_id), p.resolve());
+            }
+
+            static void parcel_write_handler(promises_type const& promises,
+                std::size_t i, boost::system::error_code const& ec,
+                parcelset::parcel const& p)
+            {
+                if (ec)
+                {
+                    boost::exception_ptr exception = HPX_GET_EXCEPTION(ec,
+                        "lcos::bulk_async", parcelset::dump_parcel(p));
+                    (*promises)[i].set_exception(exception);
+                }
+            }
+
+            promises_type promises_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        struct bulk_destination
+        {
+            std::vector<std::size_t> indices_;
+            std::vector<parcelset::parcel> parcels_;
+        };
+
+        // Send one group of parcels to every destination locality, the ids
+        // hold the credits which have been split off in advance.
+        template <typename Action, typename Handler, typename ...Ts>
+        void bulk_send_remote(hpx::future<std::vector<naming::id_type> > f,
+            Handler handler, std::vector<std::size_t> const& indices,
+            std::vector<naming::address> addrs,
+            threads::thread_priority priority, Ts const&... vs)
+        {
+            std::vector<naming::id_type> ids;
+            try {
+                ids = f.get();
+            }
+            catch (...) {
+                handler.set_exception(indices, boost::current_exception());
+                return;
+            }
+
+            typedef typename hpx::traits::extract_action<Action>::type
+                action_type;
+
+            std::map<naming::gid_type, bulk_destination> dests;
+            for (std::size_t k = 0; k != indices.size(); ++k)
+            {
+                applier::detail::complement_addr<action_type>(addrs[k]);
+
+                bulk_destination& dest = dests[addrs[k].locality_];
+                dest.indices_.push_back(indices[k]);
+                dest.parcels_.push_back(
+                    handler.template make_parcel<action_type>(indices[k],
+                        ids[k], std::move(addrs[k]), priority, vs...));
+            }
+
+            parcelset::parcelhandler& ph =
+                hpx::applier::get_applier().get_parcel_handler();
+
+            typedef std::map<naming::gid_type, bulk_destination>::value_type
+                destination_type;
+            for (destination_type& dest : dests)
+            {
+                handler.put_parcels(ph, dest.second.indices_,
+                    std::move(dest.second.parcels_));
+            }
+        }
+
+        // Invoke the action directly for all local targets and split the
+        // credits of the remote targets.
+        template <typename Action, typename Handler, typename ...Ts>
+        void bulk_invoke_resolved(
+            hpx::future<std::vector<naming::address> > f,
+            Handler handler, std::vector<naming::id_type> const& ids,
+            threads::thread_priority priority, Ts const&... vs)
+        {
+            std::vector<naming::address> addrs;
+            try {
+                addrs = f.get();
+            }
+            catch (...) {
+                std::vector<std::size_t> indices(ids.size());
+                for (std::size_t i = 0; i != indices.size(); ++i)
+                    indices[i] = i;
+
+                handler.set_exception(indices, boost::current_exception());
+                return;
+            }
+
+            std::vector<std::size_t> indices;
+            std::vector<naming::id_type> remote_ids;
+            std::vector<naming::address> remote_addrs;
+
+            naming::gid_type const& here = hpx::get_locality();
+            for (std::size_t i = 0; i != ids.size(); ++i)
+            {
+                if (addrs[i].locality_ == here)
+                {
+                    handler.template apply<Action>(i, ids[i],
+                        std::move(addrs[i]), priority, vs...);
+                    continue;
+                }
+
+                indices.push_back(i);
+                remote_ids.push_back(ids[i]);
+                remote_addrs.push_back(std::move(addrs[i]));
+            }
+
+            if (indices.empty())
+                return;
+
+            using util::placeholders::_1;
+            naming::detail::split_gids(remote_ids).then(util::bind(
+                util::one_shot(&bulk_send_remote<Action, Handler, Ts...>),
+                _1, std::move(handler), std::move(indices),
+                std::move(remote_addrs), priority, vs...));
+        }
+
+        template <typename Action, typename Handler, typename ...Ts>
+        void bulk_invoke(Handler handler,
+            std::vector<naming::id_type> const& ids, Ts&&... vs)
+        {
+            typedef typename hpx::traits::extract_action<Action>::type
+                action_type;
+
+            for (naming::id_type const& id : ids)
+            {
+                if (!traits::action_is_target_valid<action_type>::call(id))
+                {
+                    HPX_THROW_EXCEPTION(bad_parameter,
+                        "hpx::lcos::detail::bulk_invoke",
+                        boost::str(boost::format(
+                            "the target (destination) does not match the "
+                            "action type (%s)"
+                        ) % hpx::actions::detail::get_action_name<
+                                action_type>()));
+                    return;
+                }
+            }
+
+            using util::placeholders::_1;
+            agas::resolve(ids).then(util::bind(
+                util::one_shot(&bulk_invoke_resolved<
+                    action_type, Handler, typename util::decay<Ts>::type...
+                >),
+                _1, std::move(handler), ids,
+                actions::action_priority<action_type>(),
+                std::forward<Ts>(vs)...));
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename Action, typename ...Ts>
+    std::vector<hpx::future<
+        typename hpx::traits::extract_action<Action>::local_result_type
+    > >
+    bulk_async(std::vector<naming::id_type> const& ids, Ts&&... vs)
+    {
+        typedef detail::bulk_async_handler<Action> handler_type;
+        typedef typename handler_type::result_type result_type;
+
+        if (ids.empty())
+            return std::vector<hpx::future<result_type> >();
+
+        handler_type handler(ids.size());
+        std::vector<hpx::future<result_type> > futures =
+            handler.get_futures();
+
+        detail::bulk_invoke<Action>(std::move(handler), ids,
+            std::forward<Ts>(vs)...);
+
+        return futures;
+    }
+
+    template <typename Action, typename ...Ts>
+    void bulk_apply(std::vector<naming::id_type> const& ids, Ts&&... vs)
+    {
+        if (ids.empty())
+            return;
+
+        detail::bulk_invoke<Action>(detail::bulk_apply_handler(), ids,
+            std::forward<Ts>(vs)...);
+    }
+}}
+
+#endif
+
+#endif
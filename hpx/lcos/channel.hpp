@@ -0,0 +1,167 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_LCOS_CHANNEL_OCT_18_2016_0510PM)
+#define HPX_LCOS_CHANNEL_OCT_18_2016_0510PM
+
+#include <hpx/config.hpp>
+#include <hpx/apply.hpp>
+#include <hpx/async.hpp>
+#include <hpx/lcos/server/channel.hpp>
+#include <hpx/runtime/components/client_base.hpp>
+#include <hpx/runtime/components/derived_component_factory.hpp>
+#include <hpx/runtime/components/server/component.hpp>
+#include <hpx/runtime/components/server/simple_component_base.hpp>
+#include <hpx/runtime/naming/name.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/exception_ptr.hpp>
+#include <boost/preprocessor/cat.hpp>
+#include <boost/preprocessor/stringize.hpp>
+
+#include <memory>
+#include <utility>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace lcos
+{
+    ///////////////////////////////////////////////////////////////////////////
+    /// The client side representation of a \a server#channel. Values are sent
+    /// to the channel by \a set without waiting for their arrival, which
+    /// allows to stream values to a remote channel without a round trip per
+    /// element. Values sent through one client instance (or its copies) are
+    /// numbered and are stored by the channel in the order they were sent.
+    /// Values sent through different client instances may be interleaved.
+    template <typename ValueType, typename RemoteType = ValueType>
+    class channel
+      : public components::client_base<
+            channel<ValueType, RemoteType>,
+            lcos::server::channel<ValueType, RemoteType>
+        >
+    {
+        typedef components::client_base<
+                channel, lcos::server::channel<ValueType, RemoteType>
+            > base_type;
+
+    public:
+        channel()
+        {}
+
+        /// Create a client side representation for the existing
+        /// \a server#channel instance with the given global id \a gid.
+        channel(future<id_type> && gid)
+          : base_type(std::move(gid))
+          , sender_(std::make_shared<sender_data>())
+        {}
+
+        channel(id_type const& gid)
+          : base_type(gid)
+          , sender_(std::make_shared<sender_data>())
+        {}
+
+        ///////////////////////////////////////////////////////////////////////
+        // exposed functionality of this component
+
+        /// Retrieve a future referring to the next value of the channel.
+        future<ValueType> get() const
+        {
+            typedef typename
+                lcos::server::channel<ValueType, RemoteType>::get_action
+            action_type;
+
+            HPX_ASSERT(this->get_id());
+            return hpx::async<action_type>(this->get_id());
+        }
+
+        /// Send a value to the channel, this does not wait for the value to
+        /// arrive.
+        void set(RemoteType && val) const
+        {
+            typedef typename
+                lcos::server::channel<ValueType, RemoteType>::set_action
+            action_type;
+
+            HPX_ASSERT(this->get_id() && sender_);
+            hpx::apply<action_type>(this->get_id(), sender_->id_,
+                sender_->next_++, std::move(val));
+        }
+
+        void set(RemoteType const& val) const
+        {
+            set(RemoteType(val));
+        }
+
+        /// Send a value to the channel and wait until it was stored, which
+        /// suspends the calling thread while the channel is full. This keeps
+        /// the order with respect to the values sent by \a set.
+        void set_sync(RemoteType && val) const
+        {
+            typedef typename
+                lcos::server::channel<ValueType, RemoteType>::set_action
+            action_type;
+
+            HPX_ASSERT(this->get_id() && sender_);
+            hpx::async<action_type>(this->get_id(), sender_->id_,
+                sender_->next_++, std::move(val)).get();
+        }
+
+        void set_sync(RemoteType const& val) const
+        {
+            set_sync(RemoteType(val));
+        }
+
+        /// Make all consumers currently waiting for a value fail.
+        void abort_pending() const
+        {
+            typedef lcos::base_lco::set_exception_action action_type;
+
+            HPX_ASSERT(this->get_id());
+            boost::exception_ptr exception =
+                HPX_GET_EXCEPTION(hpx::no_success, "channel::abort_pending", "");
+            hpx::apply<action_type>(this->get_id(), exception);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        ValueType get_sync() const
+        {
+            return get().get();
+        }
+
+    private:
+        // identifies the values sent through this client and its copies
+        struct sender_data
+        {
+            sender_data()
+              : id_(hpx::detail::get_next_id()), next_(0)
+            {}
+
+            naming::gid_type const id_;
+            boost::atomic<boost::uint64_t> next_;
+        };
+
+        std::shared_ptr<sender_data> sender_;
+    };
+}}
+
+///////////////////////////////////////////////////////////////////////////////
+// Register the component for distributed channels of the given value type
+// (the base_lco_with_value actions for this type have to be registered as
+// well, this is already the case for all fundamental types).
+#define HPX_REGISTER_CHANNEL(type, name)                                      \
+    HPX_REGISTER_ACTION(::hpx::lcos::server::channel<type>::get_action,       \
+        BOOST_PP_CAT(channel_get_action_, name));                             \
+    HPX_REGISTER_ACTION(::hpx::lcos::server::channel<type>::set_action,       \
+        BOOST_PP_CAT(channel_set_action_, name));                             \
+    typedef ::hpx::components::component<                                     \
+        ::hpx::lcos::server::channel<type>                                    \
+    > BOOST_PP_CAT(channel_, name);                                           \
+    HPX_REGISTER_DERIVED_COMPONENT_FACTORY(                                   \
+        BOOST_PP_CAT(channel_, name), BOOST_PP_CAT(channel_, name),           \
+        "hpx::lcos::base_lco_with_value<" BOOST_PP_STRINGIZE(type) ", "       \
+            BOOST_PP_STRINGIZE(type) ">")                                     \
+    /**/
+
+#endif
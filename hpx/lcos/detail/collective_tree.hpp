@@ -0,0 +1,164 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_LCOS_DETAIL_COLLECTIVE_TREE_OCT_18_2016_0410PM)
+#define HPX_LCOS_DETAIL_COLLECTIVE_TREE_OCT_18_2016_0410PM
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/naming/id_type.hpp>
+#include <hpx/runtime/naming/name.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace hpx { namespace lcos { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // The number of sites a k-ary tree of the given depth can span, the
+    // result saturates instead of overflowing.
+    inline std::size_t
+    collective_tree_capacity(std::size_t arity, std::size_t depth)
+    {
+        std::size_t capacity = 1;
+        std::size_t level = 1;
+        for (std::size_t i = 0; i != depth; ++i)
+        {
+            if (level > std::size_t(-1) / arity)
+                return std::size_t(-1);
+            level *= arity;
+
+            if (capacity > std::size_t(-1) - level)
+                return std::size_t(-1);
+            capacity += level;
+        }
+        return capacity;
+    }
+
+    // Calculate the arity of the k-ary tree used to span the given number of
+    // sites. The tree is as shallow as possible for the given maximal arity,
+    // but uses the smallest arity which still reaches this depth. This keeps
+    // the number of messages sent by any site to a minimum without
+    // increasing the latency of the operation.
+    inline std::size_t
+    collective_tree_arity(std::size_t size, std::size_t max_arity)
+    {
+        if (max_arity < 2)
+            max_arity = 2;
+
+        if (size <= max_arity + 1)
+            return size > 1 ? size - 1 : 1;
+
+        std::size_t depth = 1;
+        while (collective_tree_capacity(max_arity, depth) < size)
+            ++depth;
+
+        std::size_t arity = 2;
+        while (collective_tree_capacity(arity, depth) < size)
+            ++arity;
+
+        return arity;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Binomial trees are used by the operations which can't pick their
+    // participants, like gather. The site with the relative rank r (relative
+    // to the root of the operation) is the root of the subtree spanning the
+    // ranks [r, r + lowest bit of r), its parent is r with the lowest bit
+    // cleared. Subtrees are contiguous, the first steps therefore combine
+    // sites with neighboring ranks.
+    inline std::size_t
+    binomial_tree_parent(std::size_t rank)
+    {
+        HPX_ASSERT(rank != 0);
+        return rank & (rank - 1);
+    }
+
+    inline std::size_t
+    binomial_tree_subtree_size(std::size_t rank, std::size_t size)
+    {
+        HPX_ASSERT(rank < size);
+        if (rank == 0)
+            return size;
+
+        std::size_t span = rank & (~rank + 1);
+        return (span < size - rank) ? span : size - rank;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace tree
+    {
+        inline bool is_group_boundary(std::vector<hpx::id_type> const& ids,
+            std::size_t i)
+        {
+            return naming::get_locality_id_from_id(ids[i - 1]) !=
+                naming::get_locality_id_from_id(ids[i]);
+        }
+
+        // Move the given subtree boundary to the closest position in
+        // [lower, upper] where the locality of the sites changes, if there
+        // is one within the given distance.
+        inline std::size_t snap_to_group_boundary(
+            std::vector<hpx::id_type> const& ids, std::size_t pos,
+            std::size_t lower, std::size_t upper, std::size_t distance)
+        {
+            for (std::size_t d = 0; d <= distance; ++d)
+            {
+                if (pos >= lower + d && is_group_boundary(ids, pos - d))
+                    return pos - d;
+                if (pos + d <= upper && is_group_boundary(ids, pos + d))
+                    return pos + d;
+            }
+            return pos;
+        }
+    }
+
+    // Split the sites of a collective operation into the ones which are
+    // invoked directly from here, [0, bounds[0]), and the subtrees
+    // [bounds[i-1], bounds[i]) which are delegated to their first site.
+    //
+    // Small operations are executed flat. Otherwise the first site is
+    // invoked directly (the operation executes colocated with it) and the
+    // others are split into balanced subtrees of a k-ary tree. The subtree
+    // boundaries are moved to the places where the locality of the sites
+    // changes, if possible. The sites on one locality are therefore combined
+    // in one subtree before anything is sent to other localities.
+    inline std::vector<std::size_t>
+    collective_tree_split(std::vector<hpx::id_type> const& ids,
+        std::size_t max_arity)
+    {
+        std::size_t const size = ids.size();
+
+        std::vector<std::size_t> bounds;
+        if (size <= max_arity)
+        {
+            bounds.push_back(size);
+            return bounds;
+        }
+
+        std::size_t const arity = collective_tree_arity(size, max_arity);
+        std::size_t const remaining = size - 1;
+
+        bounds.reserve(arity + 1);
+        bounds.push_back(1);
+        for (std::size_t i = 1; i != arity; ++i)
+        {
+            std::size_t pos = 1 + (remaining * i) / arity;
+            std::size_t lower = bounds.back() + 1;
+            std::size_t upper = size - (arity - i);
+
+            if (pos < lower)
+                pos = lower;
+
+            bounds.push_back(tree::snap_to_group_boundary(ids, pos, lower,
+                upper, remaining / (2 * arity)));
+        }
+        bounds.push_back(size);
+
+        return bounds;
+    }
+}}}
+
+#endif
@@ -24,6 +24,7 @@
 #include <hpx/util/unique_function.hpp>
 #include <hpx/util/unused.hpp>
 
+#include <boost/atomic.hpp>
 #include <boost/exception_ptr.hpp>
 #include <boost/intrusive_ptr.hpp>
 
@@ -33,6 +34,7 @@
 #include <mutex>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 ///////////////////////////////////////////////////////////////////////////////
 namespace hpx { namespace lcos
@@ -167,50 +169,81 @@ namespace detail
     };
 
     ///////////////////////////////////////////////////////////////////////////
-    template <typename F1, typename F2>
-    class compose_cb_impl
+    // The continuations attached to a shared state. Most futures have at most
+    // a couple of continuations, those are stored inline, only additional
+    // ones require an allocation. The continuations are invoked in reverse
+    // order of their registration.
+    class completed_callback_list
     {
-        HPX_MOVABLE_ONLY(compose_cb_impl);
+        HPX_MOVABLE_ONLY(completed_callback_list);
+
+        typedef util::unique_function_nonser<void()> callback_type;
+
+        HPX_STATIC_CONSTEXPR std::size_t inline_size = 2;
 
     public:
-        template <typename A1, typename A2>
-        compose_cb_impl(A1 && f1, A2 && f2)
-          : f1_(std::forward<A1>(f1))
-          , f2_(std::forward<A2>(f2))
+        completed_callback_list()
+          : size_(0)
         {}
 
-        compose_cb_impl(compose_cb_impl&& other)
-          : f1_(std::move(other.f1_))
-          , f2_(std::move(other.f2_))
-        {}
+        completed_callback_list(completed_callback_list && other)
+          : size_(other.size_)
+          , overflow_(std::move(other.overflow_))
+        {
+            for (std::size_t i = 0; i != inline_size; ++i)
+                inline_[i] = std::move(other.inline_[i]);
+            other.size_ = 0;
+        }
+
+        completed_callback_list& operator=(completed_callback_list && other)
+        {
+            size_ = other.size_;
+            for (std::size_t i = 0; i != inline_size; ++i)
+                inline_[i] = std::move(other.inline_[i]);
+            overflow_ = std::move(other.overflow_);
+            other.size_ = 0;
+            return *this;
+        }
+
+        bool empty() const
+        {
+            return size_ == 0;
+        }
+
+        void push_back(callback_type && f)
+        {
+            if (size_ < inline_size)
+                inline_[size_] = std::move(f);
+            else
+                overflow_.push_back(std::move(f));
+            ++size_;
+        }
+
+        void clear()
+        {
+            for (std::size_t i = 0; i != inline_size; ++i)
+                inline_[i].reset();
+            overflow_.clear();
+            size_ = 0;
+        }
 
-        void operator()() const
+        void operator()()
         {
-            f1_();
-            f2_();
+            for (std::size_t i = overflow_.size(); i != 0; --i)
+                overflow_[i - 1]();
+
+            std::size_t const count =
+                size_ < inline_size ? size_ : inline_size;
+            for (std::size_t i = count; i != 0; --i)
+                inline_[i - 1]();
         }
 
     private:
-        F1 f1_;
-        F2 f2_;
+        std::size_t size_;
+        callback_type inline_[inline_size];
+        std::vector<callback_type> overflow_;
     };
 
-    template <typename F1, typename F2>
-    static HPX_FORCEINLINE util::unique_function_nonser<void()>
-    compose_cb(F1 && f1, F2 && f2)
-    {
-        if (!f1)
-            return std::forward<F2>(f2);
-        else if (!f2)
-            return std::forward<F1>(f1);
-
-        // otherwise create a combined callback
-        typedef compose_cb_impl<
-            typename util::decay<F1>::type, typename util::decay<F2>::type
-        > result_type;
-        return result_type(std::forward<F1>(f1), std::forward<F2>(f2));
-    }
-
     ///////////////////////////////////////////////////////////////////////////
     struct handle_continuation_recursion_count
     {
@@ -241,17 +274,24 @@ namespace detail
         typedef util::unique_function_nonser<void()> completed_callback_type;
         typedef lcos::local::spinlock mutex_type;
 
+        // The state is modified without holding the lock. Setting the value
+        // moves the state from empty to writing, which makes sure that the
+        // value is set only once, and from writing to value (or exception)
+        // after the value was constructed. The lock protects the waiting
+        // threads and the continuations only, the thread making the future
+        // ready has to acquire it only if there are any (has_dependents_).
         enum state
         {
             empty = 0,
             ready = 1,
             value = 2 | ready,
-            exception = 4 | ready
+            exception = 4 | ready,
+            writing = 8
         };
 
     public:
         future_data()
-          : state_(empty)
+          : state_(empty), has_dependents_(false)
         {}
 
         ~future_data()
@@ -292,8 +332,15 @@ namespace detail
         virtual result_type* get_result(error_code& ec = throws)
         {
             // yields control if needed
-            wait(ec);
-            if (ec) return nullptr;
+            if (!is_ready())
+            {
+                wait(ec);
+                if (ec) return nullptr;
+            }
+            else if (&ec != &throws)
+            {
+                ec = make_success_code();
+            }
 
             // No locking is required. Once a future has been made ready, which
             // is a postcondition of wait, either:
@@ -302,7 +349,8 @@ namespace detail
             // - there are multiple readers only (shared_future, lock hurts
             //   concurrency)
 
-            if (state_ == empty) {
+            state s = state_.load(boost::memory_order_acquire);
+            if (s == empty) {
                 // the value has already been moved out of this future
                 HPX_THROWS_IF(ec, no_state,
                     "future_data::get_result",
@@ -313,7 +361,7 @@ namespace detail
             // the thread has been re-activated by one of the actions
             // supported by this promise (see promise::set_event
             // and promise::set_exception).
-            if (state_ == exception)
+            if (s == exception)
             {
                 boost::exception_ptr* exception_ptr =
                     reinterpret_cast<boost::exception_ptr*>(&storage_);
@@ -332,7 +380,8 @@ namespace detail
         }
 
         // deferred execution of a given continuation
-        bool run_on_completed(completed_callback_type && on_completed,
+        template <typename Callback>
+        bool run_on_completed(Callback && on_completed,
             boost::exception_ptr& ptr)
         {
             try {
@@ -347,7 +396,8 @@ namespace detail
 
         // make sure continuation invocation does not recurse deeper than
         // allowed
-        void handle_on_completed(completed_callback_type && on_completed)
+        template <typename Callback>
+        void handle_on_completed(Callback && on_completed)
         {
             // We need to run the completion asynchronously if we aren't on a
             // HPX thread
@@ -380,8 +430,10 @@ namespace detail
 
                 error_code ec(lightweight);
                 boost::exception_ptr ptr;
+                typedef typename util::decay<Callback>::type callback_type;
                 if (!run_on_completed_on_new_thread(
-                        util::deferred_call(&future_data::run_on_completed,
+                        util::deferred_call(
+                            &future_data::run_on_completed<callback_type>,
                             std::move(this_), std::move(on_completed),
                             std::ref(ptr)),
                         ec))
@@ -403,73 +455,62 @@ namespace detail
         template <typename Target>
         void set_value(Target && data, error_code& ec = throws)
         {
-            std::unique_lock<mutex_type> l(this->mtx_);
-
             // check whether the data has already been set
-            if (is_ready_locked()) {
-                l.unlock();
+            state expected = empty;
+            if (!state_.compare_exchange_strong(expected, writing)) {
                 HPX_THROWS_IF(ec, promise_already_satisfied,
                     "future_data::set_value",
                     "data has already been set for this future");
                 return;
             }
 
-            completed_callback_type on_completed;
-
-            on_completed = std::move(this->on_completed_);
-
             // set the data
-            result_type* value_ptr =
-                reinterpret_cast<result_type*>(&storage_);
-            ::new ((void*)value_ptr) result_type(
-                future_data_result<Result>::set(std::forward<Target>(data)));
-            state_ = value;
-
-            // handle all threads waiting for the future to become ready
-            cond_.notify_all(std::move(l), ec);
-
-            // Note: cv.notify_all() above 'consumes' the lock 'l' and leaves
-            //       it unlocked when returning.
+            try {
+                result_type* value_ptr =
+                    reinterpret_cast<result_type*>(&storage_);
+                ::new ((void*)value_ptr) result_type(
+                    future_data_result<Result>::set(
+                        std::forward<Target>(data)));
+            }
+            catch (...) {
+                state_.store(empty);
+                throw;
+            }
+            state_.store(value, boost::memory_order_seq_cst);
 
-            // invoke the callback (continuation) function
-            if (on_completed)
-                handle_on_completed(std::move(on_completed));
+            // wake up the waiting threads and run the continuations (see
+            // announce_dependent)
+            if (has_dependents_.load(boost::memory_order_seq_cst))
+                notify_dependents(ec);
+            else if (&ec != &throws)
+                ec = make_success_code();
         }
 
         template <typename Target>
         void set_exception(Target && data, error_code& ec = throws)
         {
-            std::unique_lock<mutex_type> l(this->mtx_);
-
             // check whether the data has already been set
-            if (is_ready_locked()) {
-                l.unlock();
+            state expected = empty;
+            if (!state_.compare_exchange_strong(expected, writing)) {
                 HPX_THROWS_IF(ec, promise_already_satisfied,
                     "future_data::set_exception",
                     "data has already been set for this future");
                 return;
             }
 
-            completed_callback_type on_completed;
-
-            on_completed = std::move(this->on_completed_);
-
             // set the data
             boost::exception_ptr* exception_ptr =
                 reinterpret_cast<boost::exception_ptr*>(&storage_);
             ::new ((void*)exception_ptr) boost::exception_ptr(
                 std::forward<Target>(data));
-            state_ = exception;
-
-            // handle all threads waiting for the future to become ready
-            cond_.notify_all(std::move(l), ec);
+            state_.store(exception, boost::memory_order_seq_cst);
 
-            // Note: cv.notify_all() above 'consumes' the lock 'l' and leaves
-            //       it unlocked when returning.
-
-            // invoke the callback (continuation) function
-            if (on_completed)
-                handle_on_completed(std::move(on_completed));
+            // wake up the waiting threads and run the continuations (see
+            // announce_dependent)
+            if (has_dependents_.load(boost::memory_order_seq_cst))
+                notify_dependents(ec);
+            else if (&ec != &throws)
+                ec = make_success_code();
         }
 
         // helper functions for setting data (if successful) or the error (if
@@ -515,7 +556,7 @@ namespace detail
             // and no reader
 
             // release any stored data and callback functions
-            switch (state_) {
+            switch (state_.load(boost::memory_order_relaxed)) {
             case value:
             {
                 result_type* value_ptr =
@@ -533,8 +574,9 @@ namespace detail
             default: break;
             }
 
-            state_ = empty;
-            on_completed_ = completed_callback_type();
+            state_.store(empty, boost::memory_order_relaxed);
+            has_dependents_.store(false, boost::memory_order_relaxed);
+            on_completed_.clear();
         }
 
         // continuation support
@@ -546,32 +588,34 @@ namespace detail
         {
             if (!data_sink) return;
 
-            std::unique_lock<mutex_type> l(this->mtx_);
-
-            if (is_ready_locked()) {
-
-                HPX_ASSERT(!on_completed_);
-
-                // invoke the callback (continuation) function right away
-                l.unlock();
-
-                handle_on_completed(std::move(data_sink));
-            }
-            else {
-                // store a combined callback wrapping the old and the new one
-                this->on_completed_ = compose_cb(
-                    std::move(data_sink), std::move(on_completed_));
+            if (!is_ready())
+            {
+                std::unique_lock<mutex_type> l(mtx_);
+
+                // announce the continuation before checking the state again,
+                // this guarantees that either the continuation is invoked
+                // right away or by the thread making the future ready
+                if (!announce_dependent()) {
+                    on_completed_.push_back(std::move(data_sink));
+                    return;
+                }
             }
+
+            // invoke the callback (continuation) function right away
+            handle_on_completed(std::move(data_sink));
         }
 
         virtual void wait(error_code& ec = throws)
         {
-            std::unique_lock<mutex_type> l(mtx_);
+            if (!is_ready())
+            {
+                std::unique_lock<mutex_type> l(mtx_);
 
-            // block if this entry is empty
-            if (state_ == empty) {
-                cond_.wait(std::move(l), "future_data::wait", ec);
-                if (ec) return;
+                // block if this entry is empty
+                if (!announce_dependent()) {
+                    cond_.wait(std::move(l), "future_data::wait", ec);
+                    if (ec) return;
+                }
             }
 
             if (&ec != &throws)
@@ -582,19 +626,22 @@ namespace detail
         wait_until(util::steady_clock::time_point const& abs_time,
             error_code& ec = throws)
         {
-            std::unique_lock<mutex_type> l(mtx_);
+            if (!is_ready())
+            {
+                std::unique_lock<mutex_type> l(mtx_);
 
-            // block if this entry is empty
-            if (state_ == empty) {
-                threads::thread_state_ex_enum const reason =
-                    cond_.wait_until(std::move(l), abs_time,
-                        "future_data::wait_until", ec);
-                if (ec) return future_status::uninitialized;
+                // block if this entry is empty
+                if (!announce_dependent()) {
+                    threads::thread_state_ex_enum const reason =
+                        cond_.wait_until(std::move(l), abs_time,
+                            "future_data::wait_until", ec);
+                    if (ec) return future_status::uninitialized;
 
-                if (reason == threads::wait_timeout)
-                    return future_status::timeout;
+                    if (reason == threads::wait_timeout)
+                        return future_status::timeout;
 
-                return future_status::ready;
+                    return future_status::ready;
+                }
             }
 
             if (&ec != &throws)
@@ -607,34 +654,64 @@ namespace detail
         /// \a future.
         bool is_ready() const
         {
-            std::unique_lock<mutex_type> l(mtx_);
-            return is_ready_locked();
+            return (state_.load(boost::memory_order_acquire) & ready) != 0;
         }
 
         bool is_ready_locked() const
         {
-            return (state_ & ready) != 0;
+            return is_ready();
         }
 
         bool has_value() const
         {
-            std::unique_lock<mutex_type> l(mtx_);
-            return state_ == value;
+            return state_.load(boost::memory_order_acquire) == value;
         }
 
         bool has_exception() const
+        {
+            return state_.load(boost::memory_order_acquire) == exception;
+        }
+
+    private:
+        // Register a waiting thread or continuation and check the state
+        // again. This forms a store-load handshake with set_value and
+        // set_exception (which store the state and then load
+        // has_dependents_): all four operations have to be sequentially
+        // consistent, otherwise both sides may miss each other.
+        bool announce_dependent()
+        {
+            has_dependents_.store(true, boost::memory_order_seq_cst);
+            return (state_.load(boost::memory_order_seq_cst) & ready) != 0;
+        }
+
+        // wake up all threads waiting for the future to become ready and
+        // invoke the continuations
+        void notify_dependents(error_code& ec)
         {
             std::unique_lock<mutex_type> l(mtx_);
-            return state_ == exception;
+
+            completed_callback_list on_completed(std::move(on_completed_));
+
+            // handle all threads waiting for the future to become ready
+            cond_.notify_all(std::move(l), ec);
+
+            // Note: cv.notify_all() above 'consumes' the lock 'l' and leaves
+            //       it unlocked when returning.
+
+            // invoke the callback (continuation) functions
+            if (!on_completed.empty())
+                handle_on_completed(std::move(on_completed));
         }
 
     protected:
         mutable mutex_type mtx_;
-        completed_callback_type on_completed_;
+        completed_callback_list on_completed_;
 
     private:
         local::detail::condition_variable cond_;    // threads waiting in read
-        state state_;                               // current state
+        boost::atomic<state> state_;                // current state
+        boost::atomic<bool> has_dependents_;        // waiting threads or
+                                                    // continuations exist
         typename future_data_storage<Result>::type storage_;
     };
 
@@ -713,7 +790,8 @@ namespace detail
         // retrieving the value
         virtual result_type* get_result(error_code& ec = throws)
         {
-            if (!started_test_and_set())
+            // a ready task has been started already
+            if (!this->is_ready() && !started_test_and_set())
                 this->do_run();
             return this->future_data<Result>::get_result(ec);
         }
@@ -721,7 +799,7 @@ namespace detail
         // wait support
         virtual void wait(error_code& ec = throws)
         {
-            if (!started_test_and_set())
+            if (!this->is_ready() && !started_test_and_set())
                 this->do_run();
             this->future_data<Result>::wait(ec);
         }
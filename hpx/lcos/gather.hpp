@@ -60,6 +60,12 @@ namespace hpx { namespace lcos
     /// \param this_site    The sequence number of this invocation (usually
     ///                     the locality id). This value is optional and
     ///                     defaults to whatever hpx::get_locality_id() returns.
+    /// \param  num_sites   The number of participating sites. This value is
+    ///                     optional. If it is supplied, the values are
+    ///                     combined along a binomial tree rooted at the
+    ///                     central gather point instead of being sent to it
+    ///                     directly. All sites have to supply the same value
+    ///                     in this case.
     ///
     /// \returns    This function returns a future which will become ready once
     ///             the gather operation has been completed.
@@ -68,7 +74,8 @@ namespace hpx { namespace lcos
     hpx::future<void>
     gather_there(char const* basename, hpx::future<T> result,
         std::size_t generation = std::size_t(-1), std::size_t root_site = 0,
-        std::size_t this_site = std::size_t(-1));
+        std::size_t this_site = std::size_t(-1),
+        std::size_t num_sites = std::size_t(-1));
 
     /// Gather a set of values from different call sites
     ///
@@ -119,6 +126,12 @@ namespace hpx { namespace lcos
     /// \param this_site    The sequence number of this invocation (usually
     ///                     the locality id). This value is optional and
     ///                     defaults to whatever hpx::get_locality_id() returns.
+    /// \param  num_sites   The number of participating sites. This value is
+    ///                     optional. If it is supplied, the values are
+    ///                     combined along a binomial tree rooted at the
+    ///                     central gather point instead of being sent to it
+    ///                     directly. All sites have to supply the same value
+    ///                     in this case.
     ///
     /// \returns    This function returns a future which will become ready once
     ///             the gather operation has been completed.
@@ -127,12 +140,14 @@ namespace hpx { namespace lcos
     hpx::future<void>
     gather_there(char const* basename, T && result,
         std::size_t generation = std::size_t(-1), std::size_t root_site = 0,
-        std::size_t this_site = std::size_t(-1));
+        std::size_t this_site = std::size_t(-1),
+        std::size_t num_sites = std::size_t(-1));
 }}
 #else
 
 #include <hpx/config.hpp>
 #include <hpx/dataflow.hpp>
+#include <hpx/lcos/detail/collective_tree.hpp>
 #include <hpx/lcos/future.hpp>
 #include <hpx/lcos/local/and_gate.hpp>
 #include <hpx/lcos/local/spinlock.hpp>
@@ -206,10 +221,30 @@ namespace hpx { namespace lcos
                 set_result_locked(which, std::move(t), l);
             }
 
+            // store the values of the consecutive sites starting at first,
+            // these are sent by the root of a subtree
+            void set_results(std::size_t first, std::vector<T> && data)
+            {
+                std::unique_lock<mutex_type> l(mtx_);
+                gate_.synchronize(1, l);
+
+                for (std::size_t i = 0; i != data.size(); ++i)
+                    data_[(first + i) % num_sites_] = std::move(data[i]);
+
+                for (std::size_t i = 0; i != data.size(); ++i)
+                {
+                    // the lock is released once the last value was set
+                    if (gate_.set((first + i) % num_sites_, l))
+                        break;
+                }
+            }
+
             HPX_DEFINE_COMPONENT_ACTION(
                 gather_server, get_result, get_result_action);
             HPX_DEFINE_COMPONENT_ACTION(
                 gather_server, set_result, set_result_action);
+            HPX_DEFINE_COMPONENT_ACTION(
+                gather_server, set_results, set_results_action);
 
         protected:
             template <typename Lock>
@@ -254,6 +289,29 @@ namespace hpx { namespace lcos
             typedef typename gather_server<T>::set_result_action action_type;
             return async(action_type(), f.get(), which, result.get());
         }
+
+        // gather the values of the subtree rooted at this site and forward
+        // them to the parent
+        template <typename T>
+        hpx::future<void>
+        set_subtree_data(hpx::future<hpx::id_type> f,
+            hpx::future<T> result, hpx::future<hpx::id_type> target,
+            std::size_t which)
+        {
+            // the server has to be kept alive until all values have arrived
+            hpx::id_type id = f.get();
+
+            typedef typename gather_server<T>::get_result_action
+                get_action_type;
+            std::vector<T> data =
+                async(get_action_type(), id, std::size_t(0), result.get())
+                    .get();
+
+            typedef typename gather_server<T>::set_results_action
+                set_action_type;
+            return async(set_action_type(), target.get(), which,
+                std::move(data));
+        }
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -286,6 +344,56 @@ namespace hpx { namespace lcos
             );
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // Send the value of this site along a binomial tree spanning all
+        // sites, rooted at the central gather point. Sites which are the
+        // root of a subtree gather the values of this subtree first, using a
+        // gatherer registered with their own site number.
+        template <typename T>
+        hpx::future<void>
+        gather_there_tree(char const* basename, hpx::future<T> result,
+            std::size_t generation, std::size_t root_site,
+            std::size_t this_site, std::size_t num_sites)
+        {
+            std::size_t rank = (this_site + num_sites - root_site) % num_sites;
+            HPX_ASSERT(rank != 0);
+
+            std::size_t parent = binomial_tree_parent(rank);
+            std::size_t size = binomial_tree_subtree_size(rank, num_sites);
+
+            // the central gather point stores the values by site, the roots
+            // of all other subtrees by the rank relative to their own
+            std::size_t which = (parent == 0) ? this_site : rank - parent;
+
+            std::string name(basename);
+            if (generation != std::size_t(-1))
+                name += std::to_string(generation) + "/";
+
+            hpx::future<hpx::id_type> target = hpx::find_from_basename(
+                name, (parent + root_site) % num_sites);
+
+            using util::placeholders::_1;
+            using util::placeholders::_2;
+            using util::placeholders::_3;
+
+            if (size == 1)
+            {
+                return dataflow(
+                        util::bind(&detail::set_data<T>, _1, which, _2),
+                        std::move(target), std::move(result)
+                    );
+            }
+
+            return dataflow(
+                    util::bind(&detail::set_subtree_data<T>, _1, _2, _3, which),
+                    create_gatherer<T>(basename, size, generation, this_site),
+                    std::move(result), std::move(target)
+                );
+        }
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     // destination site needs to be handled differently
     template <typename T>
@@ -337,7 +445,7 @@ namespace hpx { namespace lcos
         typedef typename util::decay<T>::type result_type;
         return dataflow(
                 util::bind(&detail::gather_data<result_type>, _1, this_site, _2),
-                std::move(f), std::forward<T>(result)
+                std::move(f), hpx::make_ready_future(std::forward<T>(result))
             );
     }
 
@@ -379,11 +487,18 @@ namespace hpx { namespace lcos
     hpx::future<void>
     gather_there(char const* basename, hpx::future<T> result,
         std::size_t generation = std::size_t(-1), std::size_t root_site = 0,
-        std::size_t this_site = std::size_t(-1))
+        std::size_t this_site = std::size_t(-1),
+        std::size_t num_sites = std::size_t(-1))
     {
         if (this_site == std::size_t(-1))
             this_site = static_cast<std::size_t>(hpx::get_locality_id());
 
+        if (num_sites != std::size_t(-1))
+        {
+            return detail::gather_there_tree(basename, std::move(result),
+                generation, root_site, this_site, num_sites);
+        }
+
         std::string name(basename);
         if (generation != std::size_t(-1))
             name += std::to_string(generation) + "/";
@@ -409,7 +524,7 @@ namespace hpx { namespace lcos
         typedef typename util::decay<T>::type result_type;
         return dataflow(
                 util::bind(&detail::set_data<result_type>, _1, this_site, _2),
-                std::move(id), std::forward<T>(result)
+                std::move(id), hpx::make_ready_future(std::forward<T>(result))
             );
     }
 
@@ -417,11 +532,19 @@ namespace hpx { namespace lcos
     hpx::future<void>
     gather_there(char const* basename, T && result,
         std::size_t generation = std::size_t(-1), std::size_t root_site = 0,
-        std::size_t this_site = std::size_t(-1))
+        std::size_t this_site = std::size_t(-1),
+        std::size_t num_sites = std::size_t(-1))
     {
         if (this_site == std::size_t(-1))
             this_site = static_cast<std::size_t>(hpx::get_locality_id());
 
+        if (num_sites != std::size_t(-1))
+        {
+            return detail::gather_there_tree(basename,
+                hpx::make_ready_future(std::forward<T>(result)),
+                generation, root_site, this_site, num_sites);
+        }
+
         std::string name(basename);
         if (generation != std::size_t(-1))
             name += std::to_string(generation) + "/";
@@ -438,7 +561,10 @@ namespace hpx { namespace lcos
         BOOST_PP_CAT(gather_get_result_action_, name));                       \
     HPX_REGISTER_ACTION_DECLARATION(                                          \
         hpx::lcos::detail::gather_server<type>::set_result_action,            \
-        BOOST_PP_CAT(set_result_action_, name))                               \
+        BOOST_PP_CAT(set_result_action_, name));                              \
+    HPX_REGISTER_ACTION_DECLARATION(                                          \
+        hpx::lcos::detail::gather_server<type>::set_results_action,           \
+        BOOST_PP_CAT(set_results_action_, name))                              \
     /**/
 
 #define HPX_REGISTER_GATHER(type, name)                                       \
@@ -448,6 +574,9 @@ namespace hpx { namespace lcos
     HPX_REGISTER_ACTION(                                                      \
         hpx::lcos::detail::gather_server<type>::set_result_action,            \
         BOOST_PP_CAT(set_result_action_, name));                              \
+    HPX_REGISTER_ACTION(                                                      \
+        hpx::lcos::detail::gather_server<type>::set_results_action,           \
+        BOOST_PP_CAT(set_results_action_, name));                             \
     typedef hpx::components::simple_component<                                \
         hpx::lcos::detail::gather_server<type>                                \
     > BOOST_PP_CAT(gather_, name);                                            \
@@ -0,0 +1,400 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_LCOS_LOCAL_CHANNEL_OCT_18_2016_0410PM)
+#define HPX_LCOS_LOCAL_CHANNEL_OCT_18_2016_0410PM
+
+#include <hpx/config.hpp>
+#include <hpx/exception.hpp>
+#include <hpx/lcos/detail/future_data.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/local/condition_variable.hpp>
+#include <hpx/lcos/local/mutex.hpp>
+#include <hpx/runtime/threads/thread_helpers.hpp>
+#include <hpx/traits/future_access.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/detail/yield_k.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/exception_ptr.hpp>
+#include <boost/intrusive_ptr.hpp>
+#include <boost/cstdint.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace hpx { namespace lcos { namespace local
+{
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // Bounded multi-producer/multi-consumer queue, see
+        // http://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+        //
+        // Each cell carries a sequence number telling producers and consumers
+        // whether the cell is ready to be written to or read from, which
+        // makes any operation a single CAS on the respective position.
+        template <typename T>
+        class bounded_mpmc_queue
+        {
+            HPX_NON_COPYABLE(bounded_mpmc_queue);
+
+            enum { cache_line_size = 64 };
+
+            struct cell
+            {
+                boost::atomic<std::size_t> sequence_;
+                typename std::aligned_storage<
+                        sizeof(T), std::alignment_of<T>::value
+                    >::type storage_;
+            };
+
+            static std::size_t round_up_to_power_of_two(std::size_t size)
+            {
+                std::size_t result = 2;
+                while (result < size)
+                    result <<= 1;
+                return result;
+            }
+
+        public:
+            explicit bounded_mpmc_queue(std::size_t capacity)
+              : mask_(round_up_to_power_of_two(capacity) - 1),
+                buffer_(new cell[mask_ + 1]),
+                enqueue_pos_(0), dequeue_pos_(0)
+            {
+                for (std::size_t i = 0; i != mask_ + 1; ++i)
+                    buffer_[i].sequence_.store(i, boost::memory_order_relaxed);
+            }
+
+            ~bounded_mpmc_queue()
+            {
+                // destroy all items which were not retrieved
+                std::size_t const end = enqueue_pos_.load();
+                for (std::size_t pos = dequeue_pos_.load(); pos != end; ++pos)
+                {
+                    reinterpret_cast<T*>(
+                        &buffer_[pos & mask_].storage_)->~T();
+                }
+            }
+
+            std::size_t capacity() const
+            {
+                return mask_ + 1;
+            }
+
+            // Returns false if the queue is full.
+            template <typename U>
+            bool push(U && item)
+            {
+                cell* c = nullptr;
+                std::size_t pos = enqueue_pos_.load(boost::memory_order_relaxed);
+                for (;;)
+                {
+                    c = &buffer_[pos & mask_];
+                    std::size_t seq =
+                        c->sequence_.load(boost::memory_order_acquire);
+                    std::ptrdiff_t dif = static_cast<std::ptrdiff_t>(seq) -
+                        static_cast<std::ptrdiff_t>(pos);
+
+                    if (dif == 0)
+                    {
+                        if (enqueue_pos_.compare_exchange_weak(pos, pos + 1,
+                                boost::memory_order_relaxed))
+                        {
+                            break;
+                        }
+                    }
+                    else if (dif < 0)
+                    {
+                        return false;
+                    }
+                    else
+                    {
+                        pos = enqueue_pos_.load(boost::memory_order_relaxed);
+                    }
+                }
+
+                ::new (static_cast<void*>(&c->storage_))
+                    T(std::forward<U>(item));
+                c->sequence_.store(pos + 1, boost::memory_order_release);
+                return true;
+            }
+
+            // Returns false if the queue is empty, otherwise passes the
+            // oldest item (as an rvalue) to the given function.
+            template <typename F>
+            bool consume(F && f)
+            {
+                cell* c = nullptr;
+                std::size_t pos = dequeue_pos_.load(boost::memory_order_relaxed);
+                for (;;)
+                {
+                    c = &buffer_[pos & mask_];
+                    std::size_t seq =
+                        c->sequence_.load(boost::memory_order_acquire);
+                    std::ptrdiff_t dif = static_cast<std::ptrdiff_t>(seq) -
+                        static_cast<std::ptrdiff_t>(pos + 1);
+
+                    if (dif == 0)
+                    {
+                        if (dequeue_pos_.compare_exchange_weak(pos, pos + 1,
+                                boost::memory_order_relaxed))
+                        {
+                            break;
+                        }
+                    }
+                    else if (dif < 0)
+                    {
+                        return false;
+                    }
+                    else
+                    {
+                        pos = dequeue_pos_.load(boost::memory_order_relaxed);
+                    }
+                }
+
+                T* p = reinterpret_cast<T*>(&c->storage_);
+                f(std::move(*p));
+                p->~T();
+                c->sequence_.store(pos + mask_ + 1, boost::memory_order_release);
+                return true;
+            }
+
+            // Returns false if the queue is empty.
+            bool pop(T& item)
+            {
+                return consume([&item](T && val) { item = std::move(val); });
+            }
+
+        private:
+            std::size_t const mask_;
+            std::unique_ptr<cell[]> buffer_;
+
+            char pad0_[cache_line_size];
+            boost::atomic<std::size_t> enqueue_pos_;
+            char pad1_[cache_line_size - sizeof(boost::atomic<std::size_t>)];
+            boost::atomic<std::size_t> dequeue_pos_;
+            char pad2_[cache_line_size - sizeof(boost::atomic<std::size_t>)];
+        };
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// A channel is a multi-producer/multi-consumer queue of values. Producers
+    /// hand values to the channel by calling \a set, consumers receive a
+    /// future referring to the next value by calling \a get. Neither
+    /// operation acquires a lock.
+    ///
+    /// The channel keeps a single counter which is the number of buffered
+    /// values minus the number of consumers waiting for a value. Depending on
+    /// the value of that counter, \a set either passes its value directly to
+    /// the shared state of the oldest waiting consumer, or it appends the
+    /// value to a bounded ring buffer. In the same way, \a get either returns
+    /// a ready future holding the oldest buffered value, or it registers a new
+    /// shared state which will be made ready by a subsequent \a set.
+    ///
+    /// The channel holds at most \a capacity values (and at most \a capacity
+    /// waiting consumers), \a set suspends the calling thread while the value
+    /// buffer is full (and \a get while the consumer buffer is full). Values
+    /// set by one thread are handed out in the order they were set.
+    template <typename T>
+    class channel
+    {
+        HPX_NON_COPYABLE(channel);
+
+        typedef lcos::detail::future_data<T> shared_state_type;
+
+    public:
+        typedef T value_type;
+
+        explicit channel(std::size_t capacity = 1024)
+          : balance_(0), blocked_(0), values_(capacity), waiters_(capacity)
+        {}
+
+        ~channel()
+        {
+            if (balance_.load(boost::memory_order_relaxed) < 0)
+            {
+                abort_pending(HPX_GET_EXCEPTION(hpx::broken_promise,
+                    "lcos::local::channel::~channel",
+                    "the channel was destroyed while a value was pending"));
+            }
+        }
+
+        /// Return the maximum number of buffered values.
+        std::size_t capacity() const
+        {
+            return values_.capacity();
+        }
+
+        /// Return the number of currently buffered values (if positive) or
+        /// the number of consumers waiting for a value (if negative).
+        boost::int64_t balance() const
+        {
+            return balance_.load(boost::memory_order_relaxed);
+        }
+
+        /// Add a value to the channel. This either makes the future of the
+        /// oldest waiting consumer ready or buffers the value.
+        template <typename U>
+        void set(U && val)
+        {
+            boost::int64_t b = balance_.fetch_add(1);
+            if (b < 0)
+            {
+                // a consumer has announced itself already, pass the value on
+                // directly (wait for the consumer to finish its registration)
+                boost::intrusive_ptr<shared_state_type> waiter = pop_waiter();
+                waiter->set_value(std::forward<U>(val));
+                return;
+            }
+
+            if (!values_.push(std::forward<U>(val)))
+            {
+                // the value buffer is full, push is a no-op in this case
+                wait_for_space(
+                    [&]() { return values_.push(std::forward<U>(val)); });
+            }
+        }
+
+        /// Retrieve a future referring to the next value of the channel.
+        hpx::future<T> get()
+        {
+            boost::int64_t b = balance_.fetch_sub(1);
+            if (b > 0)
+            {
+                // a value has been announced already (wait for the producer
+                // to finish storing it)
+                hpx::future<T> f;
+                auto make_ready =
+                    [&f](T && val)
+                    {
+                        f = hpx::make_ready_future(std::move(val));
+                    };
+
+                for (std::size_t k = 0; !values_.consume(make_ready); ++k)
+                {
+                    util::detail::yield_k(k,
+                        "hpx::lcos::local::channel::get");
+                }
+                notify_blocked();
+                return f;
+            }
+
+            // the reference count of the new shared state accounts for the
+            // pointer held by the waiter queue
+            boost::intrusive_ptr<shared_state_type> p(new shared_state_type);
+            shared_state_type* waiter = p.get();
+            intrusive_ptr_add_ref(waiter);
+
+            if (!waiters_.push(waiter))
+            {
+                wait_for_space([&]() { return waiters_.push(waiter); });
+            }
+
+            return traits::future_access<hpx::future<T> >::create(std::move(p));
+        }
+
+        /// Retrieve the next value of the channel if one is available.
+        bool try_get(T& val)
+        {
+            boost::int64_t b = balance_.load(boost::memory_order_relaxed);
+            while (b > 0)
+            {
+                if (balance_.compare_exchange_weak(b, b - 1))
+                {
+                    for (std::size_t k = 0; !values_.pop(val); ++k)
+                    {
+                        util::detail::yield_k(k,
+                            "hpx::lcos::local::channel::try_get");
+                    }
+                    notify_blocked();
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /// Make the futures of all currently waiting consumers ready by
+        /// storing the given exception. Returns the number of aborted
+        /// consumers.
+        std::size_t abort_pending(boost::exception_ptr const& e)
+        {
+            std::size_t count = 0;
+            boost::int64_t b = balance_.load(boost::memory_order_relaxed);
+            while (b < 0)
+            {
+                if (balance_.compare_exchange_weak(b, b + 1))
+                {
+                    boost::intrusive_ptr<shared_state_type> waiter =
+                        pop_waiter();
+                    waiter->set_exception(e);
+                    ++count;
+                    b = balance_.load(boost::memory_order_relaxed);
+                }
+            }
+            return count;
+        }
+
+    private:
+        // Suspend the calling thread until try_push succeeds. Every thread
+        // which frees a slot in one of the buffers calls notify_blocked.
+        template <typename F>
+        void wait_for_space(F && try_push)
+        {
+            std::unique_lock<mutex_type> l(mtx_);
+
+            // pairs with the fence in notify_blocked: either the thread
+            // freeing a slot sees blocked_ != 0, or try_push sees the slot
+            blocked_.fetch_add(1, boost::memory_order_relaxed);
+            boost::atomic_thread_fence(boost::memory_order_seq_cst);
+
+            while (!try_push())
+                cond_.wait(l);
+
+            blocked_.fetch_sub(1, boost::memory_order_relaxed);
+        }
+
+        void notify_blocked()
+        {
+            boost::atomic_thread_fence(boost::memory_order_seq_cst);
+            if (blocked_.load(boost::memory_order_relaxed) != 0)
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                cond_.notify_all();
+            }
+        }
+
+        boost::intrusive_ptr<shared_state_type> pop_waiter()
+        {
+            shared_state_type* waiter = nullptr;
+            for (std::size_t k = 0; !waiters_.pop(waiter); ++k)
+            {
+                util::detail::yield_k(k,
+                    "hpx::lcos::local::channel::pop_waiter");
+            }
+
+            notify_blocked();
+
+            // adopt the reference held by the waiter queue
+            return boost::intrusive_ptr<shared_state_type>(waiter, false);
+        }
+
+        typedef lcos::local::mutex mutex_type;
+
+        boost::atomic<boost::int64_t> balance_;
+        boost::atomic<std::size_t> blocked_;
+        mutex_type mtx_;
+        condition_variable cond_;
+        detail::bounded_mpmc_queue<T> values_;
+        detail::bounded_mpmc_queue<shared_state_type*> waiters_;
+    };
+}}}
+
+#endif
@@ -72,7 +72,7 @@ namespace hpx { namespace lcos { namespace local
 #endif
             else if(k < 32 || k & 1) //-V112
             {
-                if (hpx::threads::get_self_ptr())
+                if (hpx::threads::get_suspendable_self_ptr())
                 {
                     hpx::this_thread::suspend(hpx::threads::pending,
                         "hpx::lcos::local::spinlock::yield");
@@ -99,7 +99,7 @@ namespace hpx { namespace lcos { namespace local
                 }
 #endif
 
-                if (hpx::threads::get_self_ptr())
+                if (hpx::threads::get_suspendable_self_ptr())
                 {
                     hpx::this_thread::suspend(hpx::threads::pending,
                         "hpx::lcos::local::spinlock::yield");
@@ -79,6 +79,7 @@ namespace hpx { namespace lcos
 
 #include <hpx/config.hpp>
 #include <hpx/lcos/detail/async_colocated.hpp>
+#include <hpx/lcos/detail/collective_tree.hpp>
 #include <hpx/lcos/future.hpp>
 #include <hpx/lcos/when_all.hpp>
 #include <hpx/runtime/actions/action_support.hpp>
@@ -87,7 +88,6 @@ namespace hpx { namespace lcos
 #include <hpx/traits/extract_action.hpp>
 #include <hpx/traits/promise_local_result.hpp>
 #include <hpx/util/assert.hpp>
-#include <hpx/util/calculate_fanout.hpp>
 #include <hpx/util/decay.hpp>
 #include <hpx/util/detail/count_num_args.hpp>
 #include <hpx/util/detail/pack.hpp>
@@ -98,6 +98,7 @@ namespace hpx { namespace lcos
 #include <utility>
 #include <vector>
 
+// The maximal arity of the tree spanning the sites of a reduction
 #if !defined(HPX_REDUCE_FANOUT)
 #define HPX_REDUCE_FANOUT 16
 #endif
@@ -312,13 +313,14 @@ namespace hpx { namespace lcos
 
             if(ids.empty()) return result_type();
 
-            std::size_t const local_fanout = HPX_REDUCE_FANOUT;
-            std::size_t local_size = (std::min)(ids.size(), local_fanout);
-            std::size_t fanout = util::calculate_fanout(ids.size(), local_fanout);
+            // the results of the sites in a subtree are reduced before they
+            // are sent to the parent of the subtree
+            std::vector<std::size_t> const bounds =
+                collective_tree_split(ids, HPX_REDUCE_FANOUT);
 
             std::vector<hpx::future<result_type> > reduce_futures;
-            reduce_futures.reserve(local_size + (ids.size()/fanout) + 1);
-            for(std::size_t i = 0; i != local_size; ++i)
+            reduce_futures.reserve(bounds[0] + bounds.size() - 1);
+            for(std::size_t i = 0; i != bounds[0]; ++i)
             {
                 reduce_invoke(
                     act
@@ -329,39 +331,40 @@ namespace hpx { namespace lcos
                 );
             }
 
-            if(ids.size() > local_fanout)
-            {
-                std::size_t applied = local_fanout;
-                std::vector<hpx::id_type>::const_iterator it =
-                    ids.begin() + local_fanout;
-
-                typedef
-                    typename detail::make_reduce_action<Action>::
-                        template reduce_invoker<ReduceOp>::type
-                    reduce_impl_action;
+            typedef
+                typename detail::make_reduce_action<Action>::
+                    template reduce_invoker<ReduceOp>::type
+                reduce_impl_action;
 
-                while(it != ids.end())
+            for(std::size_t i = 1; i != bounds.size(); ++i)
+            {
+                std::size_t first = bounds[i - 1];
+                if(bounds[i] - first == 1)
                 {
-                    HPX_ASSERT(ids.size() >= applied);
-
-                    std::size_t next_fan = (std::min)(fanout, ids.size() - applied);
-                    std::vector<hpx::id_type> ids_next(it, it + next_fan);
-
-                    hpx::id_type id(ids_next[0]);
-                    reduce_futures.push_back(
-                        hpx::detail::async_colocated<reduce_impl_action>(
-                            id
-                          , act
-                          , std::move(ids_next)
-                          , reduce_op
-                          , global_idx + applied
-                          , vs...
-                        )
+                    reduce_invoke(
+                        act
+                      , reduce_futures
+                      , ids[first]
+                      , global_idx + first
+                      , vs...
                     );
-
-                    applied += next_fan;
-                    it += next_fan;
+                    continue;
                 }
+
+                std::vector<hpx::id_type> ids_next(
+                    ids.begin() + first, ids.begin() + bounds[i]);
+
+                hpx::id_type id(ids_next[0]);
+                reduce_futures.push_back(
+                    hpx::detail::async_colocated<reduce_impl_action>(
+                        id
+                      , act
+                      , std::move(ids_next)
+                      , reduce_op
+                      , global_idx + first
+                      , vs...
+                    )
+                );
             }
 
             return hpx::when_all(reduce_futures).
@@ -0,0 +1,150 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_LCOS_SERVER_CHANNEL_OCT_18_2016_0455PM)
+#define HPX_LCOS_SERVER_CHANNEL_OCT_18_2016_0455PM
+
+#include <hpx/config.hpp>
+#include <hpx/error_code.hpp>
+#include <hpx/lcos/base_lco_with_value.hpp>
+#include <hpx/lcos/local/channel.hpp>
+#include <hpx/lcos/local/condition_variable.hpp>
+#include <hpx/lcos/local/mutex.hpp>
+#include <hpx/runtime/actions/component_action.hpp>
+#include <hpx/runtime/components/component_type.hpp>
+#include <hpx/runtime/components/server/component_base.hpp>
+#include <hpx/runtime/naming/name.hpp>
+#include <hpx/traits/get_remote_result.hpp>
+#include <hpx/util/unlock_guard.hpp>
+
+#include <boost/cstdint.hpp>
+#include <boost/exception_ptr.hpp>
+
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <utility>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace lcos { namespace server
+{
+    /// A channel is an addressable version of \a lcos::local::channel. Values
+    /// are added by applying the \a set_action, every invocation of the
+    /// \a get_action retrieves the next value. Every value carries the id of
+    /// its sender and a sequence number, the values of one sender are
+    /// stored in the order of their sequence numbers.
+    template <typename ValueType, typename RemoteType = ValueType>
+    class channel;
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename ValueType, typename RemoteType>
+    class channel
+      : public lcos::base_lco_with_value<ValueType, RemoteType>
+      , public components::component_base<channel<ValueType, RemoteType> >
+    {
+    public:
+        typedef lcos::base_lco_with_value<ValueType, RemoteType> base_type_holder;
+
+    private:
+        typedef components::component_base<channel> base_type;
+        typedef lcos::local::mutex mutex_type;
+
+    public:
+        channel()
+        {}
+
+        explicit channel(std::size_t capacity)
+          : channel_(capacity)
+        {}
+
+        // disambiguate base classes
+        using base_type::finalize;
+        typedef typename base_type::wrapping_type wrapping_type;
+
+        static components::component_type get_component_type()
+        {
+            return components::get_component_type<channel>();
+        }
+        static void set_component_type(components::component_type type)
+        {
+            components::set_component_type<channel>(type);
+        }
+
+        // standard LCO action implementations
+
+        /// Add a value to the channel.
+        void set_value (RemoteType && result)
+        {
+            channel_.set(traits::get_remote_result<ValueType, RemoteType>::call(
+                std::move(result)));
+        }
+
+        /// The \a function set_exception is called whenever a
+        /// \a set_exception_action is applied on an instance of a LCO. This
+        /// makes all currently waiting consumers fail with the given error.
+        ///
+        /// \param e      [in] The exception encapsulating the error to report
+        ///               to this LCO instance.
+        void set_exception(boost::exception_ptr const& e)
+        {
+            channel_.abort_pending(e);
+        }
+
+        // Retrieve the next value from the channel. This suspends the calling
+        // thread until a value is available.
+        ValueType get_value(error_code& ec = throws)
+        {
+            return channel_.get().get(ec);
+        }
+
+        // The LCO actions above are direct actions, they run on the thread
+        // which received the parcel (or on the caller's thread for local
+        // channels). Both may suspend, so the client uses these instead.
+        ValueType get()
+        {
+            return get_value();
+        }
+
+        // Store the value with the given sequence number as soon as all
+        // values sent before by the same sender have been stored.
+        void set(naming::gid_type const& sender, boost::uint64_t sequence,
+            RemoteType && val)
+        {
+            std::unique_lock<mutex_type> l(mtx_);
+
+            // references to map elements stay valid on insertion
+            boost::uint64_t& next = senders_[sender];
+            while (next != sequence)
+                cond_.wait(l);
+
+            try {
+                // storing the value may suspend while the channel is full
+                util::unlock_guard<std::unique_lock<mutex_type> > ul(l);
+                set_value(std::move(val));
+            }
+            catch (...) {
+                ++next;
+                cond_.notify_all();
+                throw;
+            }
+
+            ++next;
+            cond_.notify_all();
+        }
+
+        HPX_DEFINE_COMPONENT_ACTION(channel, get, get_action);
+        HPX_DEFINE_COMPONENT_ACTION(channel, set, set_action);
+
+    private:
+        lcos::local::channel<ValueType> channel_;
+
+        // the sequence number of the next value expected from each sender
+        mutex_type mtx_;
+        lcos::local::condition_variable cond_;
+        std::map<naming::gid_type, boost::uint64_t> senders_;
+    };
+}}}
+
+#endif
@@ -29,6 +29,7 @@
 #include <hpx/parallel/util/projection_identity.hpp>
 #include <hpx/parallel/util/scan_partitioner.hpp>
 #include <hpx/parallel/util/transfer.hpp>
+#include <hpx/parallel/util/vector_pack.hpp>
 #include <hpx/parallel/util/zip_iterator.hpp>
 
 #include <algorithm>
@@ -47,7 +48,27 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
     namespace detail
     {
         /// \cond NOINTERNAL
+        template <typename InIter, typename OutIter>
+        HPX_HOST_DEVICE HPX_FORCEINLINE
+        void copy_partition(InIter first, std::size_t count, OutIter dest,
+            std::false_type)
+        {
+            util::copy_n_helper(first, count, dest);
+        }
+
+        // copy the partition through plain pointers, both iterators refer to
+        // contiguous memory, this enables the use of memmove for trivially
+        // copyable elements
+        template <typename InIter, typename OutIter>
+        HPX_FORCEINLINE
+        void copy_partition(InIter first, std::size_t count, OutIter dest,
+            std::true_type)
+        {
+            util::copy_n_helper(util::get_pointer(first), count,
+                util::get_pointer(dest));
+        }
 
+        template <typename Vectorize>
         struct copy_iteration
         {
             template <typename Iter>
@@ -56,7 +77,8 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
             {
                 using hpx::util::get;
                 auto const& iters = part_begin.get_iterator_tuple();
-                util::copy_n_helper(get<0>(iters), part_size, get<1>(iters));
+                copy_partition(get<0>(iters), part_size, get<1>(iters),
+                    Vectorize());
             }
         };
 
@@ -86,13 +108,16 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
                 OutIter dest)
             {
                 typedef hpx::util::zip_iterator<FwdIter, OutIter> zip_iterator;
+                typedef typename util::detail::is_vectorpack<
+                        ExPolicy, FwdIter, OutIter
+                    >::type vectorize;
 
                 return get_iter_pair(
                     util::foreach_partitioner<ExPolicy>::call(
                         std::forward<ExPolicy>(policy),
                         hpx::util::make_zip_iterator(first, dest),
                         std::distance(first, last),
-                        copy_iteration(),
+                        copy_iteration<vectorize>(),
                         [](zip_iterator && last) -> zip_iterator
                         {
                             using hpx::util::get;
@@ -223,20 +248,15 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
                 OutIter dest)
             {
                 typedef hpx::util::zip_iterator<FwdIter, OutIter> zip_iterator;
+                typedef typename util::detail::is_vectorpack<
+                        ExPolicy, FwdIter, OutIter
+                    >::type vectorize;
 
                 return get_iter_pair(
                     util::foreach_partitioner<ExPolicy>::call(
                         std::forward<ExPolicy>(policy),
                         hpx::util::make_zip_iterator(first, dest), count,
-                        [](std::size_t, zip_iterator part_begin,
-                            std::size_t part_size)
-                        {
-                            using hpx::util::get;
-
-                            auto const& iters = part_begin.get_iterator_tuple();
-                            util::copy_n_helper(get<0>(iters), part_size,
-                                get<1>(iters));
-                        },
+                        copy_iteration<vectorize>(),
                         [](zip_iterator && last) -> zip_iterator
                         {
                             using hpx::util::get;
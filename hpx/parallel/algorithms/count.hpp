@@ -11,6 +11,7 @@
 #include <hpx/config.hpp>
 #include <hpx/traits/is_iterator.hpp>
 #include <hpx/traits/segmented_iterator_traits.hpp>
+#include <hpx/util/invoke.hpp>
 #include <hpx/util/unwrapped.hpp>
 
 #include <hpx/parallel/algorithms/detail/dispatch.hpp>
@@ -19,10 +20,12 @@
 #include <hpx/parallel/util/detail/algorithm_result.hpp>
 #include <hpx/parallel/util/loop.hpp>
 #include <hpx/parallel/util/partitioner.hpp>
+#include <hpx/parallel/util/vector_pack.hpp>
 
 #include <boost/range/functions.hpp>
 
 #include <algorithm>
+#include <functional>
 #include <iterator>
 #include <type_traits>
 #include <utility>
@@ -35,6 +38,37 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
     namespace detail
     {
         /// \cond NOINTERNAL
+        template <typename Value, typename Iter, typename Pred>
+        Value count_partition(Iter part_begin, std::size_t part_size,
+            Pred const& pred, std::false_type)
+        {
+            Value ret = 0;
+            util::loop_n(part_begin, part_size,
+                [&pred, &ret](Iter const& curr)
+                {
+                    if (hpx::util::invoke(pred, *curr))
+                        ++ret;
+                });
+            return ret;
+        }
+
+        // count the matching elements of the partition in packs, the
+        // iterator refers to contiguous memory
+        template <typename Value, typename Iter, typename Pred>
+        Value count_partition(Iter part_begin, std::size_t part_size,
+            Pred const& pred, std::true_type)
+        {
+            typedef typename util::detail::vector_pack_pointer<Iter>::type
+                pointer;
+
+            return util::vector_pack_reduce_n<Value>(part_size,
+                [&pred](pointer curr) -> Value
+                {
+                    return hpx::util::invoke(pred, *curr) ? 1 : 0;
+                },
+                std::plus<Value>(), util::get_pointer(part_begin));
+        }
+
         template <typename Value>
         struct count
           : public detail::algorithm<count<Value>, Value>
@@ -66,19 +100,24 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
                         >::get(0);
                 }
 
+                typedef typename std::iterator_traits<Iter>::reference
+                    reference;
+                typedef typename util::detail::is_vectorpack<
+                        ExPolicy, Iter
+                    >::type vectorize;
+
                 return util::partitioner<ExPolicy, difference_type>::call(
                     std::forward<ExPolicy>(policy),
                     first, std::distance(first, last),
                     [value](Iter part_begin, std::size_t part_size) -> difference_type
                     {
-                        difference_type ret = 0;
-                        util::loop_n(part_begin, part_size,
-                            [&value, &ret](Iter const& curr)
+                        return count_partition<difference_type>(
+                            part_begin, part_size,
+                            [&value](reference v) -> bool
                             {
-                                if (value == *curr)
-                                    ++ret;
-                            });
-                        return ret;
+                                return value == v;
+                            },
+                            vectorize());
                     },
                     hpx::util::unwrapped(
                         [](std::vector<difference_type>&& results)
@@ -218,22 +257,19 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
                         >::get(0);
                 }
 
+                typedef typename util::detail::is_vectorpack<
+                        ExPolicy, Iter
+                    >::type vectorize;
+
+                // MSVC bails out if 'op' is captured by reference
                 return util::partitioner<ExPolicy, difference_type>::call(
                     std::forward<ExPolicy>(policy),
                     first, std::distance(first, last),
                     [op](Iter part_begin, std::size_t part_size)
                     ->  difference_type
                     {
-                        difference_type ret = 0;
-
-                        // MSVC bails out if 'op' is captured by reference
-                        util::loop_n(part_begin, part_size,
-                            [op, &ret](Iter const& curr)
-                            {
-                                if (hpx::util::invoke(op, *curr))
-                                    ++ret;
-                            });
-                        return ret;
+                        return count_partition<difference_type>(
+                            part_begin, part_size, op, vectorize());
                     },
                     hpx::util::unwrapped(
                         [](std::vector<difference_type> && results)
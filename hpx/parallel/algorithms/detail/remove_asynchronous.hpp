@@ -0,0 +1,78 @@
+//  Copyright (c) 2015 John Biddiscombe
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_ALGORITHMS_REMOVE_ASYNCHRONOUS_OCT_18_2016_0520PM)
+#define HPX_PARALLEL_ALGORITHMS_REMOVE_ASYNCHRONOUS_OCT_18_2016_0520PM
+
+#include <hpx/config.hpp>
+
+#include <hpx/parallel/config/inline_namespace.hpp>
+#include <hpx/parallel/execution_policy.hpp>
+
+namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1) { namespace detail
+{
+    /// \cond NOINTERNAL
+
+    // -----------------------------------------------------------------------
+    // when we are being run with an asynchronous policy, we do not want to
+    // pass the policy directly to other algorithms we are using - as we
+    // would have to wait internally on them before proceeding.
+    // Instead create a new policy from the old one which removes the
+    // async/future. The executor and the executor parameters of the original
+    // policy are transferred using:
+    //
+    //      remove_asynchronous<ExPolicy>::type().on(policy.executor())
+    //          .with(policy.parameters())
+    // -----------------------------------------------------------------------
+    template <typename ExPolicy>
+    struct remove_asynchronous
+    {
+        typedef ExPolicy type;
+    };
+
+    template <>
+    struct remove_asynchronous<parallel_vector_execution_policy>
+    {
+        typedef parallel_execution_policy type;
+    };
+
+    template <typename Executor, typename Parameters>
+    struct remove_asynchronous<
+        parallel_vector_execution_policy_shim<Executor, Parameters> >
+    {
+        typedef parallel_execution_policy type;
+    };
+
+    template <>
+    struct remove_asynchronous<sequential_task_execution_policy>
+    {
+        typedef sequential_execution_policy type;
+    };
+
+    template <typename Executor, typename Parameters>
+    struct remove_asynchronous<
+        sequential_task_execution_policy_shim<Executor, Parameters> >
+    {
+        typedef sequential_execution_policy type;
+    };
+
+    template <>
+    struct remove_asynchronous<parallel_task_execution_policy>
+    {
+        typedef parallel_execution_policy type;
+    };
+
+    template <typename Executor, typename Parameters>
+    struct remove_asynchronous<
+        parallel_task_execution_policy_shim<Executor, Parameters> >
+    {
+        typedef parallel_execution_policy type;
+    };
+
+    /// \endcond
+}}}}
+
+#endif
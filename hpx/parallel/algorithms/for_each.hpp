@@ -24,6 +24,7 @@
 #include <hpx/parallel/util/foreach_partitioner.hpp>
 #include <hpx/parallel/util/loop.hpp>
 #include <hpx/parallel/util/projection_identity.hpp>
+#include <hpx/parallel/util/vector_pack.hpp>
 
 #include <algorithm>
 #include <iterator>
@@ -37,7 +38,8 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
     namespace detail
     {
         /// \cond NOINTERNAL
-        template <typename F, typename Proj>
+        template <typename F, typename Proj,
+            typename Vectorize = std::false_type>
         struct for_each_iteration
         {
             typedef typename hpx::util::decay<F>::type fun_type;
@@ -69,6 +71,14 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
             HPX_HOST_DEVICE
             void operator()(std::size_t /*part_index*/,
                 Iter part_begin, std::size_t part_size)
+            {
+                call(part_begin, part_size, Vectorize());
+            }
+
+        private:
+            template <typename Iter>
+            HPX_HOST_DEVICE
+            void call(Iter part_begin, std::size_t part_size, std::false_type)
             {
                 typedef typename util::detail::loop_n<Iter>::type it_type;
 
@@ -79,6 +89,22 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
                         hpx::util::invoke(f_, hpx::util::invoke(proj_, *curr));
                     });
             }
+
+            // process the partition in packs, the iterator refers to
+            // contiguous memory
+            template <typename Iter>
+            void call(Iter part_begin, std::size_t part_size, std::true_type)
+            {
+                typedef typename std::iterator_traits<Iter>::reference
+                    reference;
+
+                util::vector_pack_for_each_n(
+                    part_begin, part_size,
+                    [this](reference v) mutable
+                    {
+                        hpx::util::invoke(f_, hpx::util::invoke(proj_, v));
+                    });
+            }
         };
 
         template <typename Iter>
@@ -113,9 +139,13 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
             {
                 if (count != 0)
                 {
+                    typedef typename util::detail::is_vectorpack<
+                            ExPolicy, InIter
+                        >::type vectorize;
+
                     return util::foreach_partitioner<ExPolicy>::call(
                         std::forward<ExPolicy>(policy), first, count,
-                        for_each_iteration<F, Proj>(
+                        for_each_iteration<F, Proj, vectorize>(
                             std::forward<F>(f), std::forward<Proj>(proj)
                         ),
                         [](InIter && last) -> InIter
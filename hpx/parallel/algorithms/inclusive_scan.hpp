@@ -10,6 +10,7 @@
 
 #include <hpx/config.hpp>
 #include <hpx/traits/is_iterator.hpp>
+#include <hpx/traits/segmented_iterator_traits.hpp>
 #include <hpx/util/unwrapped.hpp>
 #include <hpx/util/zip_iterator.hpp>
 
@@ -147,6 +148,34 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
                     });
             }
         };
+
+        ///////////////////////////////////////////////////////////////////////
+        // non-segmented implementation
+        template <typename ExPolicy, typename InIter, typename OutIter,
+            typename T, typename Op>
+        inline typename util::detail::algorithm_result<ExPolicy, OutIter>::type
+        inclusive_scan_(ExPolicy && policy, InIter first, InIter last,
+            OutIter dest, T && init, Op && op, std::false_type)
+        {
+            typedef std::integral_constant<bool,
+                    is_sequential_execution_policy<ExPolicy>::value ||
+                   !hpx::traits::is_forward_iterator<InIter>::value ||
+                   !hpx::traits::is_forward_iterator<OutIter>::value
+                > is_seq;
+
+            return detail::inclusive_scan<OutIter>().call(
+                std::forward<ExPolicy>(policy), is_seq(),
+                first, last, dest, std::forward<T>(init),
+                std::forward<Op>(op));
+        }
+
+        // segmented implementation
+        template <typename ExPolicy, typename InIter, typename OutIter,
+            typename T, typename Op>
+        inline typename util::detail::algorithm_result<ExPolicy, OutIter>::type
+        inclusive_scan_(ExPolicy && policy, InIter first, InIter last,
+            OutIter dest, T && init, Op && op, std::true_type);
+
         /// \endcond
     }
 
@@ -246,14 +275,14 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
             "Requires at least output iterator.");
 
         typedef std::integral_constant<bool,
-                is_sequential_execution_policy<ExPolicy>::value ||
-               !hpx::traits::is_forward_iterator<InIter>::value ||
-               !hpx::traits::is_forward_iterator<OutIter>::value
-            > is_seq;
+                hpx::traits::is_segmented_iterator<InIter>::value &&
+                hpx::traits::is_segmented_iterator<OutIter>::value
+            > is_segmented;
 
-        return detail::inclusive_scan<OutIter>().call(
-            std::forward<ExPolicy>(policy), is_seq(),
-            first, last, dest, std::move(init), std::forward<Op>(op));
+        return detail::inclusive_scan_(
+            std::forward<ExPolicy>(policy),
+            first, last, dest, std::move(init), std::forward<Op>(op),
+            is_segmented());
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -332,14 +361,13 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
             "Requires at least output iterator.");
 
         typedef std::integral_constant<bool,
-                is_sequential_execution_policy<ExPolicy>::value ||
-               !hpx::traits::is_forward_iterator<InIter>::value ||
-               !hpx::traits::is_forward_iterator<OutIter>::value
-            > is_seq;
+                hpx::traits::is_segmented_iterator<InIter>::value &&
+                hpx::traits::is_segmented_iterator<OutIter>::value
+            > is_segmented;
 
-        return detail::inclusive_scan<OutIter>().call(
-            std::forward<ExPolicy>(policy), is_seq(),
-            first, last, dest, std::move(init), std::plus<T>());
+        return detail::inclusive_scan_(
+            std::forward<ExPolicy>(policy),
+            first, last, dest, std::move(init), std::plus<T>(), is_segmented());
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -414,16 +442,16 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
             "Requires at least output iterator.");
 
         typedef std::integral_constant<bool,
-                is_sequential_execution_policy<ExPolicy>::value ||
-               !hpx::traits::is_forward_iterator<InIter>::value ||
-               !hpx::traits::is_forward_iterator<OutIter>::value
-            > is_seq;
+                hpx::traits::is_segmented_iterator<InIter>::value &&
+                hpx::traits::is_segmented_iterator<OutIter>::value
+            > is_segmented;
 
         typedef typename std::iterator_traits<InIter>::value_type value_type;
 
-        return detail::inclusive_scan<OutIter>().call(
-            std::forward<ExPolicy>(policy), is_seq(),
-            first, last, dest, value_type(), std::plus<value_type>());
+        return detail::inclusive_scan_(
+            std::forward<ExPolicy>(policy),
+            first, last, dest, value_type(), std::plus<value_type>(),
+            is_segmented());
     }
 }}}
 
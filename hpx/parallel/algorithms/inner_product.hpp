@@ -18,6 +18,7 @@
 #include <hpx/parallel/util/detail/algorithm_result.hpp>
 #include <hpx/parallel/util/loop.hpp>
 #include <hpx/parallel/util/partitioner.hpp>
+#include <hpx/parallel/util/vector_pack.hpp>
 
 #include <algorithm>
 #include <iterator>
@@ -33,6 +34,53 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
     namespace detail
     {
         /// \cond NOINTERNAL
+        template <typename T, typename FwdIter1, typename FwdIter2,
+            typename Op1, typename Op2>
+        T inner_product_partition(
+            hpx::util::zip_iterator<FwdIter1, FwdIter2> part_begin,
+            std::size_t part_size, Op1 const& op1, Op2 const& op2,
+            std::false_type)
+        {
+            typedef hpx::util::zip_iterator<FwdIter1, FwdIter2> zip_iterator;
+
+            using hpx::util::get;
+            T part_sum = op2(get<0>(*part_begin), get<1>(*part_begin));
+            ++part_begin;
+
+            // VS2015RC bails out when op is captured by ref
+            util::loop_n(part_begin, part_size - 1,
+                [=, &part_sum](zip_iterator it)
+                {
+                    part_sum = op1(part_sum, op2(get<0>(*it), get<1>(*it)));
+                });
+            return part_sum;
+        }
+
+        // reduce the partition in packs, both iterators refer to contiguous
+        // memory
+        template <typename T, typename FwdIter1, typename FwdIter2,
+            typename Op1, typename Op2>
+        T inner_product_partition(
+            hpx::util::zip_iterator<FwdIter1, FwdIter2> part_begin,
+            std::size_t part_size, Op1 const& op1, Op2 const& op2,
+            std::true_type)
+        {
+            typedef typename util::detail::vector_pack_pointer<FwdIter1>::type
+                pointer1;
+            typedef typename util::detail::vector_pack_pointer<FwdIter2>::type
+                pointer2;
+
+            using hpx::util::get;
+            auto const& iters = part_begin.get_iterator_tuple();
+            return util::vector_pack_reduce_n<T>(part_size,
+                [&op2](pointer1 curr1, pointer2 curr2) -> T
+                {
+                    return op2(*curr1, *curr2);
+                },
+                op1, util::get_pointer(get<0>(iters)),
+                util::get_pointer(get<1>(iters)));
+        }
+
         template <typename T>
         struct inner_product
           : public detail::algorithm<inner_product<T>, T>
@@ -71,25 +119,18 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
 
                 difference_type count = std::distance(first1, last1);
 
+                typedef typename util::detail::is_vectorpack_reduce<
+                        ExPolicy, T, FwdIter1, FwdIter2
+                    >::type vectorize;
+
                 using hpx::util::make_zip_iterator;
                 return util::partitioner<ExPolicy, T>::call(
                     std::forward<ExPolicy>(policy),
                     make_zip_iterator(first1, first2), count,
                     [op1, op2](zip_iterator part_begin, std::size_t part_size) ->T
                     {
-                        using hpx::util::get;
-                        T part_sum = op2(
-                            get<0>(*part_begin), get<1>(*part_begin));
-                        ++part_begin;
-
-                        // VS2015RC bails out when op is captured by ref
-                        util::loop_n(part_begin, part_size - 1,
-                            [=, &part_sum](zip_iterator it)
-                            {
-                                part_sum = op1(
-                                    part_sum, op2(get<0>(*it), get<1>(*it)));
-                            });
-                        return part_sum;
+                        return inner_product_partition<T>(part_begin,
+                            part_size, op1, op2, vectorize());
                     },
                     [init, op1](std::vector<hpx::future<T> > && results) -> T
                     {
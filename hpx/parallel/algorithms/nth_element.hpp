@@ -0,0 +1,526 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file parallel/algorithms/nth_element.hpp
+
+#if !defined(HPX_PARALLEL_ALGORITHM_NTH_ELEMENT_OCT_18_2016_0545PM)
+#define HPX_PARALLEL_ALGORITHM_NTH_ELEMENT_OCT_18_2016_0545PM
+
+#include <hpx/config.hpp>
+#include <hpx/exception_list.hpp>
+#include <hpx/hpx_finalize.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/traits/concepts.hpp>
+#include <hpx/traits/is_iterator.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/decay.hpp>
+
+#include <hpx/parallel/algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/algorithms/detail/remove_asynchronous.hpp>
+#include <hpx/parallel/config/inline_namespace.hpp>
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/executors/executor_information_traits.hpp>
+#include <hpx/parallel/executors/executor_traits.hpp>
+#include <hpx/parallel/traits/projected.hpp>
+#include <hpx/parallel/util/compare_projected.hpp>
+#include <hpx/parallel/util/detail/algorithm_result.hpp>
+#include <hpx/parallel/util/partitioner.hpp>
+#include <hpx/parallel/util/projection_identity.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // nth_element
+    namespace detail
+    {
+        /// \cond NOINTERNAL
+        static const std::size_t nth_element_limit_per_task = 65536ul;
+
+        ///////////////////////////////////////////////////////////////////////
+        // Rethrow the exception currently being handled by a selection which
+        // runs on a new thread: std::bad_alloc and exception_list are passed
+        // on unchanged, everything else is packaged up as an exception_list.
+        template <typename ExPolicy>
+        struct handle_selection_exception
+        {
+            HPX_ATTRIBUTE_NORETURN static void call()
+            {
+                try {
+                    throw;
+                }
+                catch (std::bad_alloc const&) {
+                    throw;
+                }
+                catch (exception_list const&) {
+                    throw;
+                }
+                catch (...) {
+                    boost::throw_exception(
+                        exception_list(boost::current_exception()));
+                }
+            }
+        };
+
+        template <>
+        struct handle_selection_exception<parallel_vector_execution_policy>
+        {
+            HPX_ATTRIBUTE_NORETURN static void call()
+            {
+                hpx::terminate();
+            }
+        };
+
+        template <typename Executor, typename Parameters>
+        struct handle_selection_exception<
+                parallel_vector_execution_policy_shim<Executor, Parameters> >
+          : handle_selection_exception<parallel_vector_execution_policy>
+        {};
+
+        ///////////////////////////////////////////////////////////////////////
+        struct partition_chunk
+        {
+            std::size_t begin;
+            std::size_t middle;     // first element not satisfying the pred
+            std::size_t end;
+        };
+
+        // A range of element positions [begin, end) together with the
+        // number of elements in all preceding ranges of the same kind.
+        struct misplaced_range
+        {
+            std::size_t begin;
+            std::size_t end;
+            std::size_t offset;
+        };
+
+        struct swap_chunk
+        {
+            std::size_t first;
+            std::size_t count;
+        };
+
+        // Return the position of the n'th element in the given ranges.
+        inline std::pair<std::size_t, std::size_t>
+        find_misplaced(std::vector<misplaced_range> const& ranges,
+            std::size_t n)
+        {
+            std::size_t i = 0, count = ranges.size();
+            while (count != 0)
+            {
+                std::size_t step = count / 2;
+                if (ranges[i + step].offset <= n)
+                {
+                    i += step + 1;
+                    count -= step + 1;
+                }
+                else
+                {
+                    count = step;
+                }
+            }
+
+            HPX_ASSERT(i != 0);
+            --i;
+            return std::make_pair(i, ranges[i].begin + (n - ranges[i].offset));
+        }
+
+        //------------------------------------------------------------------------
+        //  function : parallel_partition
+        /// \brief Reorder the elements in [first, last) such that all elements
+        ///        satisfying pred precede the ones which don't. Returns an
+        ///        iterator referring to the first element of the second group.
+        /// \remarks Equally sized chunks of the sequence are partitioned
+        ///        independently first. Afterwards, every element of the
+        ///        second group placed before the partition point is swapped
+        ///        with an element of the first group placed after it. Both
+        ///        steps are executed in parallel. The given policy must not
+        ///        be asynchronous.
+        //------------------------------------------------------------------------
+        template <typename ExPolicy, typename RandomIt, typename Pred>
+        RandomIt parallel_partition(ExPolicy && policy, RandomIt first,
+            RandomIt last, Pred const& pred)
+        {
+            typedef typename hpx::util::decay<ExPolicy>::type::executor_type
+                executor_type;
+
+            std::size_t const count = std::size_t(last - first);
+            std::size_t cores = executor_information_traits<executor_type>::
+                processing_units_count(policy.executor(), policy.parameters());
+
+            std::size_t chunk_count = (std::min)(cores,
+                (count + nth_element_limit_per_task - 1) /
+                    nth_element_limit_per_task);
+            if (chunk_count <= 1)
+                return std::partition(first, last, pred);
+
+            std::vector<partition_chunk> chunks(chunk_count);
+            std::size_t step = (count + chunk_count - 1) / chunk_count;
+            for (std::size_t i = 0; i != chunk_count; ++i)
+            {
+                chunks[i].begin = (std::min)(i * step, count);
+                chunks[i].end = (std::min)(chunks[i].begin + step, count);
+            }
+
+            typedef std::vector<partition_chunk>::iterator chunk_iterator;
+
+            // partition each of the chunks
+            util::partitioner<ExPolicy>::call(
+                policy, chunks.begin(), chunk_count,
+                [first, &pred](chunk_iterator it, std::size_t size)
+                {
+                    for (/**/; size != 0; --size, ++it)
+                    {
+                        it->middle = std::partition(first + it->begin,
+                            first + it->end, pred) - first;
+                    }
+                },
+                [](std::vector<hpx::future<void> > &&) {});
+
+            // The partition point is known now. Collect the elements which
+            // are placed on the wrong side of it.
+            std::size_t boundary = 0;
+            for (partition_chunk const& c : chunks)
+                boundary += c.middle - c.begin;
+
+            std::vector<misplaced_range> left, right;
+            std::size_t left_count = 0, right_count = 0;
+            for (partition_chunk const& c : chunks)
+            {
+                std::size_t end = (std::min)(c.end, boundary);
+                if (c.middle < end)
+                {
+                    misplaced_range r = { c.middle, end, left_count };
+                    left.push_back(r);
+                    left_count += end - c.middle;
+                }
+
+                std::size_t begin = (std::max)(c.begin, boundary);
+                if (begin < c.middle)
+                {
+                    misplaced_range r = { begin, c.middle, right_count };
+                    right.push_back(r);
+                    right_count += c.middle - begin;
+                }
+            }
+
+            HPX_ASSERT(left_count == right_count);
+            if (left_count == 0)
+                return first + boundary;
+
+            // swap the misplaced elements pairwise
+            std::size_t swap_count = (std::min)(cores,
+                (left_count + nth_element_limit_per_task - 1) /
+                    nth_element_limit_per_task);
+
+            std::vector<swap_chunk> swaps(swap_count);
+            std::size_t swap_step = (left_count + swap_count - 1) / swap_count;
+            for (std::size_t i = 0; i != swap_count; ++i)
+            {
+                swaps[i].first = (std::min)(i * swap_step, left_count);
+                swaps[i].count =
+                    (std::min)(swaps[i].first + swap_step, left_count) -
+                        swaps[i].first;
+            }
+
+            typedef std::vector<swap_chunk>::iterator swap_iterator;
+
+            util::partitioner<ExPolicy>::call(
+                policy, swaps.begin(), swap_count,
+                [first, &left, &right](swap_iterator it, std::size_t size)
+                {
+                    for (/**/; size != 0; --size, ++it)
+                    {
+                        std::size_t n = it->count;
+                        if (n == 0)
+                            continue;
+
+                        std::pair<std::size_t, std::size_t> l =
+                            find_misplaced(left, it->first);
+                        std::pair<std::size_t, std::size_t> r =
+                            find_misplaced(right, it->first);
+
+                        while (true)
+                        {
+                            std::size_t m = (std::min)(n, (std::min)(
+                                left[l.first].end - l.second,
+                                right[r.first].end - r.second));
+
+                            std::swap_ranges(first + l.second,
+                                first + l.second + m, first + r.second);
+
+                            n -= m;
+                            if (n == 0)
+                                break;
+
+                            l.second += m;
+                            if (l.second == left[l.first].end)
+                                l.second = left[++l.first].begin;
+
+                            r.second += m;
+                            if (r.second == right[r.first].end)
+                                r.second = right[++r.first].begin;
+                        }
+                    }
+                },
+                [](std::vector<hpx::future<void> > &&) {});
+
+            return first + boundary;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename T, typename Compare>
+        T const& median_of_three(T const& a, T const& b, T const& c,
+            Compare const& comp)
+        {
+            if (comp(a, b))
+            {
+                if (comp(b, c))
+                    return b;
+                return comp(a, c) ? c : a;
+            }
+            if (comp(a, c))
+                return a;
+            return comp(b, c) ? c : b;
+        }
+
+        //------------------------------------------------------------------------
+        //  function : parallel_nth_element
+        /// \brief Quickselect using a parallel three-way partitioning step,
+        ///        the remaining range is handed to std::nth_element once it
+        ///        has become small enough. The given policy must not be
+        ///        asynchronous.
+        //------------------------------------------------------------------------
+        template <typename ExPolicy, typename RandomIt, typename Compare>
+        void parallel_nth_element(ExPolicy && policy, RandomIt first,
+            RandomIt nth, RandomIt last, Compare const& comp)
+        {
+            typedef typename std::iterator_traits<RandomIt>::value_type
+                value_type;
+
+            if (nth == last)
+                return;
+
+            while (std::size_t(last - first) > nth_element_limit_per_task)
+            {
+                // select the pivot as the pseudo-median of nine
+                std::size_t const eighth = std::size_t(last - first) / 8;
+                RandomIt mid = first + 4 * eighth;
+                value_type const pivot = median_of_three(
+                    median_of_three(*first, *(first + eighth),
+                        *(first + 2 * eighth), comp),
+                    median_of_three(*(mid - eighth), *mid, *(mid + eighth),
+                        comp),
+                    median_of_three(*(last - 1 - 2 * eighth),
+                        *(last - 1 - eighth), *(last - 1), comp),
+                    comp);
+
+                // elements less than the pivot
+                RandomIt middle1 = parallel_partition(policy, first, last,
+                    [&comp, &pivot](value_type const& val)
+                    {
+                        return comp(val, pivot);
+                    });
+                if (nth < middle1)
+                {
+                    last = middle1;
+                    continue;
+                }
+
+                // elements equivalent to the pivot
+                RandomIt middle2 = parallel_partition(policy, middle1, last,
+                    [&comp, &pivot](value_type const& val)
+                    {
+                        return !comp(pivot, val);
+                    });
+                if (nth < middle2)
+                    return;
+
+                first = middle2;
+            }
+
+            std::nth_element(first, nth, last, comp);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // nth_element
+        template <typename RandomIt>
+        struct nth_element
+          : public detail::algorithm<nth_element<RandomIt>, RandomIt>
+        {
+            nth_element()
+              : nth_element::algorithm("nth_element")
+            {}
+
+            template <typename ExPolicy, typename Compare, typename Proj>
+            static RandomIt
+            sequential(ExPolicy, RandomIt first, RandomIt nth, RandomIt last,
+                Compare && comp, Proj && proj)
+            {
+                std::nth_element(first, nth, last,
+                    util::compare_projected<Compare, Proj>(
+                            std::forward<Compare>(comp),
+                            std::forward<Proj>(proj)
+                        ));
+                return last;
+            }
+
+            template <typename ExPolicy, typename Compare, typename Proj>
+            static typename util::detail::algorithm_result<
+                ExPolicy, RandomIt
+            >::type
+            parallel(ExPolicy && policy, RandomIt first, RandomIt nth,
+                RandomIt last, Compare && comp, Proj && proj)
+            {
+                typedef typename hpx::util::decay<ExPolicy>::type::executor_type
+                    executor_type;
+                typedef typename hpx::parallel::executor_traits<executor_type>
+                    executor_traits;
+
+                typedef util::compare_projected<
+                        typename hpx::util::decay<Compare>::type,
+                        typename hpx::util::decay<Proj>::type
+                    > compare_type;
+
+                typedef typename detail::remove_asynchronous<
+                        typename hpx::util::decay<ExPolicy>::type
+                    >::type sync_policy_type;
+
+                auto sync_policy = sync_policy_type().on(policy.executor())
+                    .with(policy.parameters());
+                compare_type f(std::forward<Compare>(comp),
+                    std::forward<Proj>(proj));
+
+                // the selection waits for its partitioning steps, run it on
+                // a new thread for asynchronous policies
+                return util::detail::algorithm_result<ExPolicy, RandomIt>::get(
+                    executor_traits::async_execute(
+                        policy.executor(),
+                        [sync_policy, first, nth, last, f]() mutable
+                            -> RandomIt
+                        {
+                            try {
+                                parallel_nth_element(sync_policy, first, nth,
+                                    last, f);
+                            }
+                            catch (...) {
+                                handle_selection_exception<
+                                        sync_policy_type
+                                    >::call();
+                            }
+                            return last;
+                        }));
+            }
+        };
+        /// \endcond
+    }
+
+    //-----------------------------------------------------------------------------
+    /// Rearranges the elements in the range [first, last) such that the
+    /// element pointed at by \a nth is changed to whatever element would occur
+    /// in that position if [first, last) was sorted. All of the elements
+    /// before this new \a nth element are less than or equal to the elements
+    /// after the new \a nth element. The order of the elements within the two
+    /// groups is unspecified.
+    ///
+    /// \note   Complexity: Linear in std::distance(first, last) on average.
+    ///
+    /// \tparam ExPolicy    The type of the execution policy to use (deduced).
+    ///                     It describes the manner in which the execution
+    ///                     of the algorithm may be parallelized and the manner
+    ///                     in which it applies user-provided function objects.
+    /// \tparam RandomIt    The type of the source iterators used (deduced).
+    ///                     This iterator type must meet the requirements of a
+    ///                     random access iterator.
+    /// \tparam Comp        The type of the function/function object to use
+    ///                     (deduced).
+    /// \tparam Proj        The type of an optional projection function. This
+    ///                     defaults to \a util::projection_identity
+    ///
+    /// \param policy       The execution policy to use for the scheduling of
+    ///                     the iterations.
+    /// \param first        Refers to the beginning of the sequence of elements
+    ///                     the algorithm will be applied to.
+    /// \param nth          Refers to the element which will hold the value it
+    ///                     would have after sorting the sequence.
+    /// \param last         Refers to the end of the sequence of elements the
+    ///                     algorithm will be applied to.
+    /// \param comp         comp is a callable object. The return value of the
+    ///                     INVOKE operation applied to an object of type Comp,
+    ///                     when contextually converted to bool, yields true if
+    ///                     the first argument of the call is less than the
+    ///                     second, and false otherwise. It is assumed that comp
+    ///                     will not apply any non-constant function through the
+    ///                     dereferenced iterator.
+    /// \param proj         Specifies the function (or function object) which
+    ///                     will be invoked for each pair of elements as a
+    ///                     projection operation before the actual predicate
+    ///                     \a comp is invoked.
+    ///
+    /// \a comp has to induce a strict weak ordering on the values.
+    ///
+    /// The application of function objects in parallel algorithm
+    /// invoked with an execution policy object of type
+    /// \a sequential_execution_policy execute in sequential order in the
+    /// calling thread.
+    ///
+    /// The application of function objects in parallel algorithm
+    /// invoked with an execution policy object of type
+    /// \a parallel_execution_policy or \a parallel_task_execution_policy are
+    /// permitted to execute in an unordered fashion in unspecified
+    /// threads, and indeterminately sequenced within each thread.
+    ///
+    /// The parallel versions of this algorithm repeatedly partition the
+    /// sequence around a pivot element (in parallel) until the remaining part
+    /// containing \a nth is small enough to be handled sequentially. The
+    /// value type of the sequence has to be copy constructible.
+    ///
+    /// \returns  The \a nth_element algorithm returns a
+    ///           \a hpx::future<RandomIt> if the execution policy is of
+    ///           type
+    ///           \a sequential_task_execution_policy or
+    ///           \a parallel_task_execution_policy and returns \a RandomIt
+    ///           otherwise.
+    ///           The algorithm returns an iterator pointing to the first
+    ///           element after the last element in the input sequence.
+    //-----------------------------------------------------------------------------
+    template <typename ExPolicy, typename RandomIt,
+        typename Proj = util::projection_identity,
+        typename Compare = std::less<
+            typename std::remove_reference<
+                typename traits::projected_result_of<Proj, RandomIt>::type
+            >::type
+        >,
+    HPX_CONCEPT_REQUIRES_(
+        is_execution_policy<ExPolicy>::value &&
+        hpx::traits::is_iterator<RandomIt>::value &&
+        traits::is_projected<Proj, RandomIt>::value &&
+        traits::is_indirect_callable<
+            Compare,
+                traits::projected<Proj, RandomIt>,
+                traits::projected<Proj, RandomIt>
+        >::value)>
+    typename util::detail::algorithm_result<ExPolicy, RandomIt>::type
+    nth_element(ExPolicy && policy, RandomIt first, RandomIt nth,
+        RandomIt last, Compare && comp = Compare(), Proj && proj = Proj())
+    {
+        static_assert(
+            (hpx::traits::is_random_access_iterator<RandomIt>::value),
+            "Requires a random access iterator.");
+
+        typedef is_sequential_execution_policy<ExPolicy> is_seq;
+
+        return detail::nth_element<RandomIt>().call(
+            std::forward<ExPolicy>(policy), is_seq(), first, nth, last,
+            std::forward<Compare>(comp), std::forward<Proj>(proj));
+    }
+}}}
+
+#endif
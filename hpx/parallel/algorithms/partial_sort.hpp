@@ -0,0 +1,453 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file parallel/algorithms/partial_sort.hpp
+
+#if !defined(HPX_PARALLEL_ALGORITHM_PARTIAL_SORT_OCT_18_2016_0615PM)
+#define HPX_PARALLEL_ALGORITHM_PARTIAL_SORT_OCT_18_2016_0615PM
+
+#include <hpx/config.hpp>
+#include <hpx/traits/concepts.hpp>
+#include <hpx/traits/is_iterator.hpp>
+#include <hpx/util/decay.hpp>
+
+#include <hpx/parallel/algorithms/copy.hpp>
+#include <hpx/parallel/algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/algorithms/detail/remove_asynchronous.hpp>
+#include <hpx/parallel/algorithms/move.hpp>
+#include <hpx/parallel/algorithms/nth_element.hpp>
+#include <hpx/parallel/algorithms/sort.hpp>
+#include <hpx/parallel/config/inline_namespace.hpp>
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/executors/executor_traits.hpp>
+#include <hpx/parallel/traits/projected.hpp>
+#include <hpx/parallel/util/compare_projected.hpp>
+#include <hpx/parallel/util/detail/algorithm_result.hpp>
+#include <hpx/parallel/util/projection_identity.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // partial_sort
+    namespace detail
+    {
+        /// \cond NOINTERNAL
+
+        // Select the smallest elements using the parallel nth_element, sort
+        // those afterwards. The given policy must not be asynchronous.
+        template <typename ExPolicy, typename RandomIt, typename Compare>
+        void parallel_partial_sort(ExPolicy && policy, RandomIt first,
+            RandomIt middle, RandomIt last, Compare const& comp)
+        {
+            if (first == middle)
+                return;
+
+            parallel_nth_element(policy, first, middle, last, comp);
+            parallel_sort_async(policy, first, middle, comp).get();
+        }
+
+        template <typename RandomIt>
+        struct partial_sort
+          : public detail::algorithm<partial_sort<RandomIt>, RandomIt>
+        {
+            partial_sort()
+              : partial_sort::algorithm("partial_sort")
+            {}
+
+            template <typename ExPolicy, typename Compare, typename Proj>
+            static RandomIt
+            sequential(ExPolicy, RandomIt first, RandomIt middle,
+                RandomIt last, Compare && comp, Proj && proj)
+            {
+                std::partial_sort(first, middle, last,
+                    util::compare_projected<Compare, Proj>(
+                            std::forward<Compare>(comp),
+                            std::forward<Proj>(proj)
+                        ));
+                return last;
+            }
+
+            template <typename ExPolicy, typename Compare, typename Proj>
+            static typename util::detail::algorithm_result<
+                ExPolicy, RandomIt
+            >::type
+            parallel(ExPolicy && policy, RandomIt first, RandomIt middle,
+                RandomIt last, Compare && comp, Proj && proj)
+            {
+                typedef typename hpx::util::decay<ExPolicy>::type::executor_type
+                    executor_type;
+                typedef typename hpx::parallel::executor_traits<executor_type>
+                    executor_traits;
+
+                typedef util::compare_projected<
+                        typename hpx::util::decay<Compare>::type,
+                        typename hpx::util::decay<Proj>::type
+                    > compare_type;
+
+                typedef typename detail::remove_asynchronous<
+                        typename hpx::util::decay<ExPolicy>::type
+                    >::type sync_policy_type;
+
+                auto sync_policy = sync_policy_type().on(policy.executor())
+                    .with(policy.parameters());
+                compare_type f(std::forward<Compare>(comp),
+                    std::forward<Proj>(proj));
+
+                return util::detail::algorithm_result<ExPolicy, RandomIt>::get(
+                    executor_traits::async_execute(
+                        policy.executor(),
+                        [sync_policy, first, middle, last, f]() mutable
+                            -> RandomIt
+                        {
+                            try {
+                                parallel_partial_sort(sync_policy, first,
+                                    middle, last, f);
+                            }
+                            catch (...) {
+                                handle_selection_exception<
+                                        sync_policy_type
+                                    >::call();
+                            }
+                            return last;
+                        }));
+            }
+        };
+        /// \endcond
+    }
+
+    //-----------------------------------------------------------------------------
+    /// Rearranges the elements in the range [first, last) such that the range
+    /// [first, middle) contains the sorted middle - first smallest elements
+    /// of the range [first, last). The order of equal elements is not
+    /// guaranteed to be preserved. The order of the remaining elements in the
+    /// range [middle, last) is unspecified.
+    ///
+    /// \note   Complexity: Approximately (last - first) * log(middle - first)
+    ///                     applications of \a comp.
+    ///
+    /// \tparam ExPolicy    The type of the execution policy to use (deduced).
+    ///                     It describes the manner in which the execution
+    ///                     of the algorithm may be parallelized and the manner
+    ///                     in which it applies user-provided function objects.
+    /// \tparam RandomIt    The type of the source iterators used (deduced).
+    ///                     This iterator type must meet the requirements of a
+    ///                     random access iterator.
+    /// \tparam Comp        The type of the function/function object to use
+    ///                     (deduced).
+    /// \tparam Proj        The type of an optional projection function. This
+    ///                     defaults to \a util::projection_identity
+    ///
+    /// \param policy       The execution policy to use for the scheduling of
+    ///                     the iterations.
+    /// \param first        Refers to the beginning of the sequence of elements
+    ///                     the algorithm will be applied to.
+    /// \param middle       Refers to the end of the range which will hold the
+    ///                     sorted elements.
+    /// \param last         Refers to the end of the sequence of elements the
+    ///                     algorithm will be applied to.
+    /// \param comp         comp is a callable object. The return value of the
+    ///                     INVOKE operation applied to an object of type Comp,
+    ///                     when contextually converted to bool, yields true if
+    ///                     the first argument of the call is less than the
+    ///                     second, and false otherwise. It is assumed that comp
+    ///                     will not apply any non-constant function through the
+    ///                     dereferenced iterator.
+    /// \param proj         Specifies the function (or function object) which
+    ///                     will be invoked for each pair of elements as a
+    ///                     projection operation before the actual predicate
+    ///                     \a comp is invoked.
+    ///
+    /// \a comp has to induce a strict weak ordering on the values.
+    ///
+    /// The application of function objects in parallel algorithm
+    /// invoked with an execution policy object of type
+    /// \a sequential_execution_policy execute in sequential order in the
+    /// calling thread.
+    ///
+    /// The application of function objects in parallel algorithm
+    /// invoked with an execution policy object of type
+    /// \a parallel_execution_policy or \a parallel_task_execution_policy are
+    /// permitted to execute in an unordered fashion in unspecified
+    /// threads, and indeterminately sequenced within each thread.
+    ///
+    /// The parallel versions of this algorithm select the smallest elements
+    /// using the parallel \a nth_element and sort them using the parallel
+    /// \a sort afterwards.
+    ///
+    /// \returns  The \a partial_sort algorithm returns a
+    ///           \a hpx::future<RandomIt> if the execution policy is of
+    ///           type
+    ///           \a sequential_task_execution_policy or
+    ///           \a parallel_task_execution_policy and returns \a RandomIt
+    ///           otherwise.
+    ///           The algorithm returns an iterator pointing to the first
+    ///           element after the last element in the input sequence.
+    //-----------------------------------------------------------------------------
+    template <typename ExPolicy, typename RandomIt,
+        typename Proj = util::projection_identity,
+        typename Compare = std::less<
+            typename std::remove_reference<
+                typename traits::projected_result_of<Proj, RandomIt>::type
+            >::type
+        >,
+    HPX_CONCEPT_REQUIRES_(
+        is_execution_policy<ExPolicy>::value &&
+        hpx::traits::is_iterator<RandomIt>::value &&
+        traits::is_projected<Proj, RandomIt>::value &&
+        traits::is_indirect_callable<
+            Compare,
+                traits::projected<Proj, RandomIt>,
+                traits::projected<Proj, RandomIt>
+        >::value)>
+    typename util::detail::algorithm_result<ExPolicy, RandomIt>::type
+    partial_sort(ExPolicy && policy, RandomIt first, RandomIt middle,
+        RandomIt last, Compare && comp = Compare(), Proj && proj = Proj())
+    {
+        static_assert(
+            (hpx::traits::is_random_access_iterator<RandomIt>::value),
+            "Requires a random access iterator.");
+
+        typedef is_sequential_execution_policy<ExPolicy> is_seq;
+
+        return detail::partial_sort<RandomIt>().call(
+            std::forward<ExPolicy>(policy), is_seq(), first, middle, last,
+            std::forward<Compare>(comp), std::forward<Proj>(proj));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // partial_sort_copy
+    namespace detail
+    {
+        /// \cond NOINTERNAL
+
+        // Copy the smallest elements of [first, last) in sorted order to the
+        // destination range. The given policy must not be asynchronous.
+        template <typename ExPolicy, typename FwdIter, typename RandomIt,
+            typename Compare>
+        RandomIt parallel_partial_sort_copy(ExPolicy && policy,
+            FwdIter first, FwdIter last, RandomIt d_first, RandomIt d_last,
+            Compare const& comp)
+        {
+            typedef typename std::iterator_traits<FwdIter>::value_type
+                value_type;
+
+            std::size_t count = std::size_t(std::distance(first, last));
+            std::size_t d_count = std::size_t(d_last - d_first);
+            if (count == 0 || d_count == 0)
+                return d_first;
+
+            // all elements fit, sort the destination range only
+            if (count <= d_count)
+            {
+                hpx::parallel::copy(policy, first, last, d_first);
+                parallel_sort_async(policy, d_first, d_first + count, comp)
+                    .get();
+                return d_first + count;
+            }
+
+            // select and sort the smallest elements in a temporary buffer
+            std::vector<value_type> buffer(first, last);
+            parallel_partial_sort(policy, buffer.begin(),
+                buffer.begin() + d_count, buffer.end(), comp);
+
+            hpx::parallel::move(policy, buffer.begin(),
+                buffer.begin() + d_count, d_first);
+            return d_last;
+        }
+
+        template <typename RandomIt>
+        struct partial_sort_copy
+          : public detail::algorithm<partial_sort_copy<RandomIt>, RandomIt>
+        {
+            partial_sort_copy()
+              : partial_sort_copy::algorithm("partial_sort_copy")
+            {}
+
+            template <typename ExPolicy, typename InIter, typename Compare,
+                typename Proj>
+            static RandomIt
+            sequential(ExPolicy, InIter first, InIter last,
+                RandomIt d_first, RandomIt d_last, Compare && comp,
+                Proj && proj)
+            {
+                return std::partial_sort_copy(first, last, d_first, d_last,
+                    util::compare_projected<Compare, Proj>(
+                            std::forward<Compare>(comp),
+                            std::forward<Proj>(proj)
+                        ));
+            }
+
+            template <typename ExPolicy, typename FwdIter, typename Compare,
+                typename Proj>
+            static typename util::detail::algorithm_result<
+                ExPolicy, RandomIt
+            >::type
+            parallel(ExPolicy && policy, FwdIter first, FwdIter last,
+                RandomIt d_first, RandomIt d_last, Compare && comp,
+                Proj && proj)
+            {
+                typedef typename hpx::util::decay<ExPolicy>::type::executor_type
+                    executor_type;
+                typedef typename hpx::parallel::executor_traits<executor_type>
+                    executor_traits;
+
+                typedef util::compare_projected<
+                        typename hpx::util::decay<Compare>::type,
+                        typename hpx::util::decay<Proj>::type
+                    > compare_type;
+
+                typedef typename detail::remove_asynchronous<
+                        typename hpx::util::decay<ExPolicy>::type
+                    >::type sync_policy_type;
+
+                auto sync_policy = sync_policy_type().on(policy.executor())
+                    .with(policy.parameters());
+                compare_type f(std::forward<Compare>(comp),
+                    std::forward<Proj>(proj));
+
+                return util::detail::algorithm_result<ExPolicy, RandomIt>::get(
+                    executor_traits::async_execute(
+                        policy.executor(),
+                        [sync_policy, first, last, d_first, d_last, f]()
+                            mutable -> RandomIt
+                        {
+                            try {
+                                return parallel_partial_sort_copy(
+                                    sync_policy, first, last, d_first,
+                                    d_last, f);
+                            }
+                            catch (...) {
+                                handle_selection_exception<
+                                        sync_policy_type
+                                    >::call();
+                            }
+                        }));
+            }
+        };
+        /// \endcond
+    }
+
+    //-----------------------------------------------------------------------------
+    /// Sorts some of the elements in the range [first, last) in ascending
+    /// order, storing the result in the range [d_first, d_last). At most
+    /// d_last - d_first of the elements are moved to the range
+    /// [d_first, d_first + n) and then sorted, where n is the number of
+    /// elements to sort (n = min(last - first, d_last - d_first)). The order
+    /// of equal elements is not guaranteed to be preserved.
+    ///
+    /// \note   Complexity: O(N·log(min(D,N))), where N =
+    ///                     std::distance(first, last) and D =
+    ///                     std::distance(d_first, d_last) comparisons.
+    ///
+    /// \tparam ExPolicy    The type of the execution policy to use (deduced).
+    ///                     It describes the manner in which the execution
+    ///                     of the algorithm may be parallelized and the manner
+    ///                     in which it applies user-provided function objects.
+    /// \tparam InIter      The type of the source iterators used (deduced).
+    ///                     This iterator type must meet the requirements of an
+    ///                     input iterator.
+    /// \tparam RandomIt    The type of the destination iterators used
+    ///                     (deduced). This iterator type must meet the
+    ///                     requirements of a random access iterator.
+    /// \tparam Comp        The type of the function/function object to use
+    ///                     (deduced).
+    /// \tparam Proj        The type of an optional projection function. This
+    ///                     defaults to \a util::projection_identity
+    ///
+    /// \param policy       The execution policy to use for the scheduling of
+    ///                     the iterations.
+    /// \param first        Refers to the beginning of the sequence of elements
+    ///                     the algorithm will be applied to.
+    /// \param last         Refers to the end of the sequence of elements the
+    ///                     algorithm will be applied to.
+    /// \param d_first      Refers to the beginning of the destination range.
+    /// \param d_last       Refers to the end of the destination range.
+    /// \param comp         comp is a callable object. The return value of the
+    ///                     INVOKE operation applied to an object of type Comp,
+    ///                     when contextually converted to bool, yields true if
+    ///                     the first argument of the call is less than the
+    ///                     second, and false otherwise. It is assumed that comp
+    ///                     will not apply any non-constant function through the
+    ///                     dereferenced iterator.
+    /// \param proj         Specifies the function (or function object) which
+    ///                     will be invoked for each pair of elements as a
+    ///                     projection operation before the actual predicate
+    ///                     \a comp is invoked.
+    ///
+    /// \a comp has to induce a strict weak ordering on the values.
+    ///
+    /// The application of function objects in parallel algorithm
+    /// invoked with an execution policy object of type
+    /// \a sequential_execution_policy execute in sequential order in the
+    /// calling thread.
+    ///
+    /// The application of function objects in parallel algorithm
+    /// invoked with an execution policy object of type
+    /// \a parallel_execution_policy or \a parallel_task_execution_policy are
+    /// permitted to execute in an unordered fashion in unspecified
+    /// threads, and indeterminately sequenced within each thread.
+    ///
+    /// If the source range is longer than the destination range, the
+    /// parallel versions of this algorithm copy the source range into a
+    /// temporary buffer before selecting the smallest elements.
+    ///
+    /// \returns  The \a partial_sort_copy algorithm returns a
+    ///           \a hpx::future<RandomIt> if the execution policy is of
+    ///           type
+    ///           \a sequential_task_execution_policy or
+    ///           \a parallel_task_execution_policy and returns \a RandomIt
+    ///           otherwise.
+    ///           The algorithm returns an iterator to the element defining
+    ///           the upper boundary of the sorted range, i.e.
+    ///           d_first + min(last - first, d_last - d_first).
+    //-----------------------------------------------------------------------------
+    template <typename ExPolicy, typename InIter, typename RandomIt,
+        typename Proj = util::projection_identity,
+        typename Compare = std::less<
+            typename std::remove_reference<
+                typename traits::projected_result_of<Proj, InIter>::type
+            >::type
+        >,
+    HPX_CONCEPT_REQUIRES_(
+        is_execution_policy<ExPolicy>::value &&
+        hpx::traits::is_iterator<InIter>::value &&
+        hpx::traits::is_iterator<RandomIt>::value &&
+        traits::is_projected<Proj, InIter>::value &&
+        traits::is_indirect_callable<
+            Compare,
+                traits::projected<Proj, InIter>,
+                traits::projected<Proj, InIter>
+        >::value)>
+    typename util::detail::algorithm_result<ExPolicy, RandomIt>::type
+    partial_sort_copy(ExPolicy && policy, InIter first, InIter last,
+        RandomIt d_first, RandomIt d_last, Compare && comp = Compare(),
+        Proj && proj = Proj())
+    {
+        static_assert(
+            (hpx::traits::is_input_iterator<InIter>::value),
+            "Requires at least input iterator.");
+        static_assert(
+            (hpx::traits::is_random_access_iterator<RandomIt>::value),
+            "Requires a random access iterator.");
+
+        typedef std::integral_constant<bool,
+                is_sequential_execution_policy<ExPolicy>::value ||
+               !hpx::traits::is_forward_iterator<InIter>::value
+            > is_seq;
+
+        return detail::partial_sort_copy<RandomIt>().call(
+            std::forward<ExPolicy>(policy), is_seq(), first, last,
+            d_first, d_last,
+            std::forward<Compare>(comp), std::forward<Proj>(proj));
+    }
+}}}
+
+#endif
@@ -18,6 +18,7 @@
 #include <hpx/parallel/util/detail/algorithm_result.hpp>
 #include <hpx/parallel/util/loop.hpp>
 #include <hpx/parallel/util/partitioner.hpp>
+#include <hpx/parallel/util/vector_pack.hpp>
 
 #include <boost/range/functions.hpp>
 
@@ -35,6 +36,29 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
     namespace detail
     {
         /// \cond NOINTERNAL
+        template <typename T, typename FwdIter, typename Reduce>
+        T reduce_partition(FwdIter part_begin, std::size_t part_size,
+            Reduce const& r, std::false_type)
+        {
+            T val = *part_begin;
+            return util::accumulate_n(++part_begin, --part_size,
+                std::move(val), r);
+        }
+
+        // reduce the partition in packs, the iterator refers to contiguous
+        // memory
+        template <typename T, typename FwdIter, typename Reduce>
+        T reduce_partition(FwdIter part_begin, std::size_t part_size,
+            Reduce const& r, std::true_type)
+        {
+            typedef typename util::detail::vector_pack_pointer<FwdIter>::type
+                pointer;
+
+            return util::vector_pack_reduce_n<T>(part_size,
+                [](pointer curr) -> T { return *curr; }, r,
+                util::get_pointer(part_begin));
+        }
+
         template <typename T>
         struct reduce : public detail::algorithm<reduce<T>, T>
         {
@@ -64,14 +88,17 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
                         std::forward<T_>(init));
                 }
 
+                typedef typename util::detail::is_vectorpack_reduce<
+                        ExPolicy, T, FwdIter
+                    >::type vectorize;
+
                 return util::partitioner<ExPolicy, T>::call(
                     std::forward<ExPolicy>(policy),
                     first, std::distance(first, last),
                     [r](FwdIter part_begin, std::size_t part_size) -> T
                     {
-                        T val = *part_begin;
-                        return util::accumulate_n(++part_begin, --part_size,
-                            std::move(val), r);
+                        return reduce_partition<T>(part_begin, part_size, r,
+                            vectorize());
                     },
                     hpx::util::unwrapped([init, r](std::vector<T> && results)
                     {
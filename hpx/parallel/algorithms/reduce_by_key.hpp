@@ -11,6 +11,7 @@
 #include <hpx/parallel/executors.hpp>
 //
 #include <hpx/parallel/algorithms/copy.hpp>
+#include <hpx/parallel/algorithms/detail/remove_asynchronous.hpp>
 #include <hpx/parallel/algorithms/for_each.hpp>
 #include <hpx/parallel/algorithms/inclusive_scan.hpp>
 #include <hpx/parallel/algorithms/sort.hpp>
@@ -195,40 +196,6 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
                 });
         }
 
-        // -------------------------------------------------------------------
-        // when we are being run with an asynchronous policy, we do not want to
-        // pass the policy directly to other algorithms we are using - as we
-        // would have to wait internally on them before proceeding.
-        // Instead create a new policy from the old one which removes the async/future
-        // -------------------------------------------------------------------
-        template<typename ExPolicy>
-        struct remove_asynchronous
-        {
-            typedef ExPolicy type;
-        };
-
-        template<>
-        struct remove_asynchronous<
-            hpx::parallel::parallel_vector_execution_policy
-        >
-        {
-            typedef hpx::parallel::parallel_execution_policy type;
-        };
-
-        template<>
-        struct remove_asynchronous<
-            hpx::parallel::sequential_task_execution_policy
-        >
-        {
-            typedef hpx::parallel::sequential_execution_policy type;
-        };
-
-        template<>
-        struct remove_asynchronous<hpx::parallel::parallel_task_execution_policy>
-        {
-            typedef hpx::parallel::parallel_execution_policy type;
-        };
-
         // -------------------------------------------------------------------
         // The main algorithm is implemented here, it replaces any async
         // execution policy with a non async one so that no waits are
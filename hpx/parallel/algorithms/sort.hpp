@@ -12,6 +12,7 @@
 #include <hpx/dataflow.hpp>
 #include <hpx/traits/concepts.hpp>
 #include <hpx/traits/is_iterator.hpp>
+#include <hpx/traits/segmented_iterator_traits.hpp>
 #include <hpx/util/assert.hpp>
 #include <hpx/util/decay.hpp>
 #include <hpx/util/invoke.hpp>
@@ -90,6 +91,12 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
             }
         };
 
+        template <typename Executor, typename Parameters, typename R>
+        struct handle_sort_exception<
+                parallel_vector_execution_policy_shim<Executor, Parameters>, R>
+          : handle_sort_exception<parallel_vector_execution_policy, R>
+        {};
+
         ///////////////////////////////////////////////////////////////////////
         // std::is_sorted is not available on all supported platforms yet
         template <typename Iter, typename Compare>
@@ -282,9 +289,10 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
               : sort::algorithm("sort")
             {}
 
-            template <typename ExPolicy, typename Compare, typename Proj>
-            static RandomIt
-            sequential(ExPolicy, RandomIt first, RandomIt last,
+            template <typename ExPolicy, typename Iter, typename Compare,
+                typename Proj>
+            static Iter
+            sequential(ExPolicy, Iter first, Iter last,
                 Compare && comp, Proj && proj)
             {
                 std::sort(first, last,
@@ -295,16 +303,17 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
                 return last;
             }
 
-            template <typename ExPolicy, typename Compare, typename Proj>
+            template <typename ExPolicy, typename Iter, typename Compare,
+                typename Proj>
             static typename util::detail::algorithm_result<
-                ExPolicy, RandomIt
+                ExPolicy, Iter
             >::type
-            parallel(ExPolicy && policy, RandomIt first, RandomIt last,
+            parallel(ExPolicy && policy, Iter first, Iter last,
                 Compare && comp, Proj && proj)
             {
                 // call the sort routine and return the right type,
                 // depending on execution policy
-                return util::detail::algorithm_result<ExPolicy, RandomIt>::get(
+                return util::detail::algorithm_result<ExPolicy, Iter>::get(
                     parallel_sort_async(std::forward<ExPolicy>(policy),
                         first, last,
                         util::compare_projected<Compare, Proj>(
@@ -313,6 +322,29 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
                         )));
             }
         };
+
+        ///////////////////////////////////////////////////////////////////////
+        // non-segmented implementation
+        template <typename ExPolicy, typename RandomIt, typename Compare,
+            typename Proj>
+        inline typename util::detail::algorithm_result<ExPolicy, RandomIt>::type
+        sort_(ExPolicy && policy, RandomIt first, RandomIt last,
+            Compare && comp, Proj && proj, std::false_type)
+        {
+            typedef is_sequential_execution_policy<ExPolicy> is_seq;
+
+            return detail::sort<RandomIt>().call(
+                std::forward<ExPolicy>(policy), is_seq(), first, last,
+                std::forward<Compare>(comp), std::forward<Proj>(proj));
+        }
+
+        // segmented implementation
+        template <typename ExPolicy, typename RandomIt, typename Compare,
+            typename Proj>
+        inline typename util::detail::algorithm_result<ExPolicy, RandomIt>::type
+        sort_(ExPolicy && policy, RandomIt first, RandomIt last,
+            Compare && comp, Proj && proj, std::true_type);
+
         /// \endcond
     }
 
@@ -407,11 +439,12 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
             (hpx::traits::is_random_access_iterator<RandomIt>::value),
             "Requires a random access iterator.");
 
-        typedef is_sequential_execution_policy<ExPolicy> is_seq;
+        typedef hpx::traits::is_segmented_iterator<RandomIt> is_segmented;
 
-        return detail::sort<RandomIt>().call(
-            std::forward<ExPolicy>(policy), is_seq(), first, last,
-            std::forward<Compare>(comp), std::forward<Proj>(proj));
+        return detail::sort_(
+            std::forward<ExPolicy>(policy), first, last,
+            std::forward<Compare>(comp), std::forward<Proj>(proj),
+            is_segmented());
     }
 }}}
 
@@ -0,0 +1,437 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file parallel/algorithms/stable_sort.hpp
+
+#if !defined(HPX_PARALLEL_ALGORITHM_STABLE_SORT_OCT_18_2016_0530PM)
+#define HPX_PARALLEL_ALGORITHM_STABLE_SORT_OCT_18_2016_0530PM
+
+#include <hpx/config.hpp>
+#include <hpx/dataflow.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/traits/concepts.hpp>
+#include <hpx/traits/is_iterator.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/decay.hpp>
+
+#include <hpx/parallel/algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/algorithms/sort.hpp>
+#include <hpx/parallel/config/inline_namespace.hpp>
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/executors/executor_traits.hpp>
+#include <hpx/parallel/traits/projected.hpp>
+#include <hpx/parallel/util/compare_projected.hpp>
+#include <hpx/parallel/util/detail/algorithm_result.hpp>
+#include <hpx/parallel/util/detail/handle_local_exceptions.hpp>
+#include <hpx/parallel/util/projection_identity.hpp>
+
+#include <boost/exception_ptr.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // stable_sort
+    namespace detail
+    {
+        /// \cond NOINTERNAL
+        static const std::size_t stable_sort_limit_per_task = 65536ul;
+        static const std::size_t merge_limit_per_task = 65536ul;
+
+        ///////////////////////////////////////////////////////////////////////
+        // Wait for both given futures and combine their exceptions, if any.
+        // std::bad_alloc is rethrown unchanged.
+        inline void join_stable_sort_tasks(hpx::future<void> && left,
+            hpx::future<void> && right)
+        {
+            if (left.has_exception() || right.has_exception())
+            {
+                typedef util::detail::handle_local_exceptions<
+                        parallel_execution_policy
+                    > handle_local_exceptions;
+
+                std::list<boost::exception_ptr> errors;
+                if (left.has_exception())
+                    handle_local_exceptions::call(
+                        left.get_exception_ptr(), errors);
+                if (right.has_exception())
+                    handle_local_exceptions::call(
+                        right.get_exception_ptr(), errors);
+
+                boost::throw_exception(exception_list(std::move(errors)));
+            }
+        }
+
+        //------------------------------------------------------------------------
+        //  function : parallel_merge
+        /// \brief Move-merge the sorted ranges [first1, last1) and
+        ///        [first2, last2) into the range starting at dest.
+        /// \remarks Large merges are split recursively: the middle element of
+        ///        the longer input range is located in the shorter one and
+        ///        both halves are merged independently. Elements of the first
+        ///        range are placed before equivalent elements of the second
+        ///        range, which keeps the merge stable.
+        //------------------------------------------------------------------------
+        template <typename ExPolicy, typename Iter1, typename Iter2,
+            typename OutIter, typename Compare>
+        hpx::future<void> parallel_merge(ExPolicy policy,
+            Iter1 first1, Iter1 last1, Iter2 first2, Iter2 last2,
+            OutIter dest, Compare comp)
+        {
+            typedef typename ExPolicy::executor_type executor_type;
+            typedef typename hpx::parallel::executor_traits<executor_type>
+                executor_traits;
+
+            std::size_t len1 = std::size_t(last1 - first1);
+            std::size_t len2 = std::size_t(last2 - first2);
+
+            if (len1 + len2 <= merge_limit_per_task)
+            {
+                std::merge(
+                    std::make_move_iterator(first1),
+                    std::make_move_iterator(last1),
+                    std::make_move_iterator(first2),
+                    std::make_move_iterator(last2),
+                    dest, comp);
+                return hpx::make_ready_future();
+            }
+
+            Iter1 mid1 = first1;
+            Iter2 mid2 = first2;
+            if (len1 >= len2)
+            {
+                mid1 = first1 + len1 / 2;
+                mid2 = std::lower_bound(first2, last2, *mid1, comp);
+            }
+            else
+            {
+                mid2 = first2 + len2 / 2;
+                mid1 = std::upper_bound(first1, last1, *mid2, comp);
+            }
+
+            OutIter mid_dest = dest + ((mid1 - first1) + (mid2 - first2));
+
+            hpx::future<void> left =
+                executor_traits::async_execute(
+                    policy.executor(),
+                        &parallel_merge<ExPolicy, Iter1, Iter2, OutIter, Compare>,
+                        policy, first1, mid1, first2, mid2, dest, comp);
+
+            hpx::future<void> right =
+                parallel_merge(policy, mid1, last1, mid2, last2, mid_dest, comp);
+
+            return hpx::dataflow(&join_stable_sort_tasks,
+                std::move(left), std::move(right));
+        }
+
+        //------------------------------------------------------------------------
+        //  function : stable_sort_thread
+        /// \brief Sort the elements of the section [first, last) of the
+        ///        sequence, the elements of which are located in the
+        ///        corresponding section of the buffer starting at buf.
+        /// \remarks The sorted elements are placed into [first, last) if
+        ///        to_sequence is true, and into the buffer otherwise. Both
+        ///        halves of a section are sorted into the respective other
+        ///        memory, which is where the final merge reads them from.
+        //------------------------------------------------------------------------
+        template <typename ExPolicy, typename RandomIt, typename BufIter,
+            typename Compare>
+        hpx::future<void> stable_sort_thread(ExPolicy policy,
+            RandomIt first, RandomIt last, BufIter buf, bool to_sequence,
+            Compare comp)
+        {
+            typedef typename ExPolicy::executor_type executor_type;
+            typedef typename hpx::parallel::executor_traits<executor_type>
+                executor_traits;
+
+            std::size_t N = std::size_t(last - first);
+            if (N <= stable_sort_limit_per_task)
+            {
+                return executor_traits::async_execute(
+                    policy.executor(),
+                    [first, last, buf, N, to_sequence, comp]()
+                    {
+                        if (to_sequence)
+                        {
+                            std::move(buf, buf + N, first);
+                            std::stable_sort(first, last, comp);
+                        }
+                        else
+                        {
+                            std::stable_sort(buf, buf + N, comp);
+                        }
+                    });
+            }
+
+            std::size_t nx = N >> 1;
+            RandomIt mid = first + nx;
+            BufIter buf_mid = buf + nx;
+
+            // spawn tasks for each half, sorting into the respective other
+            // memory
+            hpx::future<void> left =
+                executor_traits::async_execute(
+                    policy.executor(),
+                        &stable_sort_thread<ExPolicy, RandomIt, BufIter, Compare>,
+                        policy, first, mid, buf, !to_sequence, comp);
+
+            hpx::future<void> right =
+                executor_traits::async_execute(
+                    policy.executor(),
+                        &stable_sort_thread<ExPolicy, RandomIt, BufIter, Compare>,
+                        policy, mid, last, buf_mid, !to_sequence, comp);
+
+            return hpx::dataflow(
+                [=](hpx::future<void> && left, hpx::future<void> && right)
+                    -> hpx::future<void>
+                {
+                    join_stable_sort_tasks(std::move(left), std::move(right));
+
+                    if (to_sequence)
+                    {
+                        return parallel_merge(policy, buf, buf_mid,
+                            buf_mid, buf + N, first, comp);
+                    }
+                    return parallel_merge(policy, first, mid, mid, last,
+                        buf, comp);
+                },
+                std::move(left), std::move(right));
+        }
+
+        //------------------------------------------------------------------------
+        //  function : parallel_stable_sort_async
+        //------------------------------------------------------------------------
+        /// @param [in] first : iterator to the first element to sort
+        /// @param [in] last : iterator to the next element after the last
+        /// @param [in] comp : object for to compare
+        /// @remarks The elements are moved to a temporary buffer of the same
+        ///          size as the sequence, sorting moves them back.
+        template <typename ExPolicy, typename RandomIt, typename Compare>
+        hpx::future<RandomIt>
+        parallel_stable_sort_async(ExPolicy && policy, RandomIt first,
+            RandomIt last, Compare comp)
+        {
+            typedef typename hpx::util::decay<ExPolicy>::type policy_type;
+            typedef typename std::iterator_traits<RandomIt>::value_type
+                value_type;
+            typedef std::vector<value_type> buffer_type;
+            typedef typename buffer_type::iterator buffer_iterator;
+
+            hpx::future<RandomIt> result;
+            try {
+                std::ptrdiff_t N = last - first;
+                HPX_ASSERT(N >= 0);
+
+                if (std::size_t(N) < stable_sort_limit_per_task)
+                {
+                    std::stable_sort(first, last, comp);
+                    return hpx::make_ready_future(last);
+                }
+
+                // check if already sorted
+                if (detail::is_sorted_sequential(first, last, comp))
+                    return hpx::make_ready_future(last);
+
+                std::shared_ptr<buffer_type> buffer =
+                    std::make_shared<buffer_type>(
+                        std::make_move_iterator(first),
+                        std::make_move_iterator(last));
+
+                typedef typename policy_type::executor_type executor_type;
+                typedef typename hpx::parallel::executor_traits<executor_type>
+                    executor_traits;
+
+                hpx::future<void> f = executor_traits::async_execute(
+                    policy.executor(),
+                        &stable_sort_thread<
+                            policy_type, RandomIt, buffer_iterator, Compare
+                        >,
+                        policy_type(policy), first, last, buffer->begin(), true,
+                        comp);
+
+                // keep the buffer alive until all tasks have finished
+                result = f.then(
+                    [buffer, last](hpx::future<void> && f) -> RandomIt
+                    {
+                        f.get();
+                        return last;
+                    });
+            }
+            catch (...) {
+                return detail::handle_sort_exception<ExPolicy, RandomIt>::call(
+                    boost::current_exception());
+            }
+
+            if (result.has_exception())
+            {
+                return detail::handle_sort_exception<ExPolicy, RandomIt>::call(
+                    std::move(result));
+            }
+
+            return result;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // stable_sort
+        template <typename RandomIt>
+        struct stable_sort
+          : public detail::algorithm<stable_sort<RandomIt>, RandomIt>
+        {
+            stable_sort()
+              : stable_sort::algorithm("stable_sort")
+            {}
+
+            template <typename ExPolicy, typename Compare, typename Proj>
+            static RandomIt
+            sequential(ExPolicy, RandomIt first, RandomIt last,
+                Compare && comp, Proj && proj)
+            {
+                std::stable_sort(first, last,
+                    util::compare_projected<Compare, Proj>(
+                            std::forward<Compare>(comp),
+                            std::forward<Proj>(proj)
+                        ));
+                return last;
+            }
+
+            template <typename ExPolicy, typename Compare, typename Proj>
+            static typename util::detail::algorithm_result<
+                ExPolicy, RandomIt
+            >::type
+            parallel(ExPolicy && policy, RandomIt first, RandomIt last,
+                Compare && comp, Proj && proj)
+            {
+                // the comparison function object is copied into the spawned
+                // tasks, it must not refer to the passed arguments
+                typedef util::compare_projected<
+                        typename hpx::util::decay<Compare>::type,
+                        typename hpx::util::decay<Proj>::type
+                    > compare_type;
+
+                // call the sort routine and return the right type,
+                // depending on execution policy
+                return util::detail::algorithm_result<ExPolicy, RandomIt>::get(
+                    parallel_stable_sort_async(std::forward<ExPolicy>(policy),
+                        first, last,
+                        compare_type(
+                            std::forward<Compare>(comp),
+                            std::forward<Proj>(proj)
+                        )));
+            }
+        };
+        /// \endcond
+    }
+
+    //-----------------------------------------------------------------------------
+    /// Sorts the elements in the range [first, last) in ascending order. The
+    /// order of equal elements is guaranteed to be preserved. The function
+    /// uses the given comparison function object comp (defaults to using
+    /// operator<()).
+    ///
+    /// \note   Complexity: O(Nlog(N)), where N = std::distance(first, last)
+    ///                     comparisons.
+    ///
+    /// A sequence is sorted with respect to a comparator \a comp and a
+    /// projection \a proj if for every iterator i pointing to the sequence and
+    /// every non-negative integer n such that i + n is a valid iterator
+    /// pointing to an element of the sequence, and
+    /// INVOKE(comp, INVOKE(proj, *(i + n)), INVOKE(proj, *i)) == false.
+    ///
+    /// \tparam ExPolicy    The type of the execution policy to use (deduced).
+    ///                     It describes the manner in which the execution
+    ///                     of the algorithm may be parallelized and the manner
+    ///                     in which it applies user-provided function objects.
+    /// \tparam Iter        The type of the source iterators used (deduced).
+    ///                     This iterator type must meet the requirements of a
+    ///                     random access iterator.
+    /// \tparam Comp        The type of the function/function object to use
+    ///                     (deduced).
+    /// \tparam Proj        The type of an optional projection function. This
+    ///                     defaults to \a util::projection_identity
+    ///
+    /// \param policy       The execution policy to use for the scheduling of
+    ///                     the iterations.
+    /// \param first        Refers to the beginning of the sequence of elements
+    ///                     the algorithm will be applied to.
+    /// \param last         Refers to the end of the sequence of elements the
+    ///                     algorithm will be applied to.
+    /// \param comp         comp is a callable object. The return value of the
+    ///                     INVOKE operation applied to an object of type Comp,
+    ///                     when contextually converted to bool, yields true if
+    ///                     the first argument of the call is less than the
+    ///                     second, and false otherwise. It is assumed that comp
+    ///                     will not apply any non-constant function through the
+    ///                     dereferenced iterator.
+    /// \param proj         Specifies the function (or function object) which
+    ///                     will be invoked for each pair of elements as a
+    ///                     projection operation before the actual predicate
+    ///                     \a comp is invoked.
+    ///
+    /// \a comp has to induce a strict weak ordering on the values.
+    ///
+    /// The application of function objects in parallel algorithm
+    /// invoked with an execution policy object of type
+    /// \a sequential_execution_policy execute in sequential order in the
+    /// calling thread.
+    ///
+    /// The application of function objects in parallel algorithm
+    /// invoked with an execution policy object of type
+    /// \a parallel_execution_policy or \a parallel_task_execution_policy are
+    /// permitted to execute in an unordered fashion in unspecified
+    /// threads, and indeterminately sequenced within each thread.
+    ///
+    /// The parallel versions of this algorithm move the elements to a
+    /// temporary buffer of the size of the sequence and merge sorted
+    /// sections of the sequence in parallel.
+    ///
+    /// \returns  The \a stable_sort algorithm returns a
+    ///           \a hpx::future<RandomIt> if the execution policy is of
+    ///           type
+    ///           \a sequential_task_execution_policy or
+    ///           \a parallel_task_execution_policy and returns \a RandomIt
+    ///           otherwise.
+    ///           The algorithm returns an iterator pointing to the first
+    ///           element after the last element in the input sequence.
+    //-----------------------------------------------------------------------------
+    template <typename ExPolicy, typename RandomIt,
+        typename Proj = util::projection_identity,
+        typename Compare = std::less<
+            typename std::remove_reference<
+                typename traits::projected_result_of<Proj, RandomIt>::type
+            >::type
+        >,
+    HPX_CONCEPT_REQUIRES_(
+        is_execution_policy<ExPolicy>::value &&
+        hpx::traits::is_iterator<RandomIt>::value &&
+        traits::is_projected<Proj, RandomIt>::value &&
+        traits::is_indirect_callable<
+            Compare,
+                traits::projected<Proj, RandomIt>,
+                traits::projected<Proj, RandomIt>
+        >::value)>
+    typename util::detail::algorithm_result<ExPolicy, RandomIt>::type
+    stable_sort(ExPolicy && policy, RandomIt first, RandomIt last,
+        Compare && comp = Compare(), Proj && proj = Proj())
+    {
+        static_assert(
+            (hpx::traits::is_random_access_iterator<RandomIt>::value),
+            "Requires a random access iterator.");
+
+        typedef is_sequential_execution_policy<ExPolicy> is_seq;
+
+        return detail::stable_sort<RandomIt>().call(
+            std::forward<ExPolicy>(policy), is_seq(), first, last,
+            std::forward<Compare>(comp), std::forward<Proj>(proj));
+    }
+}}}
+
+#endif
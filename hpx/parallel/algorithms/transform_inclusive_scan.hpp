@@ -10,6 +10,7 @@
 
 #include <hpx/config.hpp>
 #include <hpx/traits/is_iterator.hpp>
+#include <hpx/traits/segmented_iterator_traits.hpp>
 
 #include <hpx/parallel/algorithms/detail/dispatch.hpp>
 #include <hpx/parallel/algorithms/inclusive_scan.hpp>
@@ -149,6 +150,34 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
                     });
             }
         };
+
+        ///////////////////////////////////////////////////////////////////////
+        // non-segmented implementation
+        template <typename ExPolicy, typename InIter, typename OutIter,
+            typename Conv, typename T, typename Op>
+        inline typename util::detail::algorithm_result<ExPolicy, OutIter>::type
+        transform_inclusive_scan_(ExPolicy && policy, InIter first, InIter last,
+            OutIter dest, Conv && conv, T && init, Op && op, std::false_type)
+        {
+            typedef std::integral_constant<bool,
+                    is_sequential_execution_policy<ExPolicy>::value ||
+                   !hpx::traits::is_forward_iterator<InIter>::value ||
+                   !hpx::traits::is_forward_iterator<OutIter>::value
+                > is_seq;
+
+            return detail::transform_inclusive_scan<OutIter>().call(
+                std::forward<ExPolicy>(policy), is_seq(),
+                first, last, dest, std::forward<Conv>(conv),
+                std::forward<T>(init), std::forward<Op>(op));
+        }
+
+        // segmented implementation
+        template <typename ExPolicy, typename InIter, typename OutIter,
+            typename Conv, typename T, typename Op>
+        inline typename util::detail::algorithm_result<ExPolicy, OutIter>::type
+        transform_inclusive_scan_(ExPolicy && policy, InIter first, InIter last,
+            OutIter dest, Conv && conv, T && init, Op && op, std::true_type);
+
         /// \endcond
     }
 
@@ -271,15 +300,14 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
             "Requires at least output iterator.");
 
         typedef std::integral_constant<bool,
-                is_sequential_execution_policy<ExPolicy>::value ||
-               !hpx::traits::is_forward_iterator<InIter>::value ||
-               !hpx::traits::is_forward_iterator<OutIter>::value
-            > is_seq;
+                hpx::traits::is_segmented_iterator<InIter>::value &&
+                hpx::traits::is_segmented_iterator<OutIter>::value
+            > is_segmented;
 
-        return detail::transform_inclusive_scan<OutIter>().call(
-            std::forward<ExPolicy>(policy), is_seq(),
+        return detail::transform_inclusive_scan_(
+            std::forward<ExPolicy>(policy),
             first, last, dest, std::forward<Conv>(conv), std::move(init),
-            std::forward<Op>(op));
+            std::forward<Op>(op), is_segmented());
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -398,17 +426,16 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
             "Requires at least output iterator.");
 
         typedef std::integral_constant<bool,
-                is_sequential_execution_policy<ExPolicy>::value ||
-               !hpx::traits::is_forward_iterator<InIter>::value ||
-               !hpx::traits::is_forward_iterator<OutIter>::value
-            > is_seq;
+                hpx::traits::is_segmented_iterator<InIter>::value &&
+                hpx::traits::is_segmented_iterator<OutIter>::value
+            > is_segmented;
 
         typedef typename std::iterator_traits<InIter>::value_type value_type;
 
-        return detail::transform_inclusive_scan<OutIter>().call(
-            std::forward<ExPolicy>(policy), is_seq(),
+        return detail::transform_inclusive_scan_(
+            std::forward<ExPolicy>(policy),
             first, last, dest, std::forward<Conv>(conv), value_type(),
-            std::forward<Op>(op));
+            std::forward<Op>(op), is_segmented());
     }
 }}}
 
@@ -20,6 +20,7 @@
 #include <hpx/parallel/util/detail/algorithm_result.hpp>
 #include <hpx/parallel/util/loop.hpp>
 #include <hpx/parallel/util/partitioner.hpp>
+#include <hpx/parallel/util/vector_pack.hpp>
 
 #include <boost/range/functions.hpp>
 
@@ -37,6 +38,42 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
     namespace detail
     {
         /// \cond NOINTERNAL
+        template <typename T, typename FwdIter, typename Reduce,
+            typename Convert>
+        T transform_reduce_partition(FwdIter part_begin,
+            std::size_t part_size, Reduce const& r, Convert const& conv,
+            std::false_type)
+        {
+            typedef typename std::iterator_traits<FwdIter>::reference
+                reference;
+
+            T val = conv(*part_begin);
+            return util::accumulate_n(++part_begin, --part_size,
+                std::move(val),
+                // MSVC14 bails out if r and conv are captured by
+                // reference
+                [=](T const& res, reference next)
+                {
+                    return r(res, conv(next));
+                });
+        }
+
+        // reduce the partition in packs, the iterator refers to contiguous
+        // memory
+        template <typename T, typename FwdIter, typename Reduce,
+            typename Convert>
+        T transform_reduce_partition(FwdIter part_begin,
+            std::size_t part_size, Reduce const& r, Convert const& conv,
+            std::true_type)
+        {
+            typedef typename util::detail::vector_pack_pointer<FwdIter>::type
+                pointer;
+
+            return util::vector_pack_reduce_n<T>(part_size,
+                [&conv](pointer curr) -> T { return conv(*curr); }, r,
+                util::get_pointer(part_begin));
+        }
+
         template <typename T>
         struct transform_reduce
           : public detail::algorithm<transform_reduce<T>, T>
@@ -74,23 +111,17 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
                         std::move(init_));
                 }
 
-                typedef typename std::iterator_traits<FwdIter>::reference
-                    reference;
+                typedef typename util::detail::is_vectorpack_reduce<
+                        ExPolicy, T, FwdIter
+                    >::type vectorize;
 
                 return util::partitioner<ExPolicy, T>::call(
                     std::forward<ExPolicy>(policy),
                     first, std::distance(first, last),
                     [r, conv](FwdIter part_begin, std::size_t part_size) -> T
                     {
-                        T val = conv(*part_begin);
-                        return util::accumulate_n(++part_begin, --part_size,
-                            std::move(val),
-                            // MSVC14 bails out if r and conv are captured by
-                            // reference
-                            [=](T const& res, reference next)
-                            {
-                                return r(res, conv(next));
-                            });
+                        return transform_reduce_partition<T>(part_begin,
+                            part_size, r, conv, vectorize());
                     },
                     hpx::util::unwrapped([init, r](std::vector<T> && results)
                     {
@@ -126,6 +126,13 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
             }
         };
 
+        template <typename Executor, typename Parameters, typename Result>
+        struct handle_exception_impl<
+                parallel_vector_execution_policy_shim<
+                    Executor, Parameters>, Result>
+          : handle_exception_impl<parallel_vector_execution_policy, Result>
+        {};
+
         template <typename ExPolicy, typename Result = void>
         struct handle_exception
           : handle_exception_impl<
@@ -1211,6 +1211,18 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
         /// policy.
         typedef parallel::parallel_execution_tag execution_category;
 
+        /// Rebind the type of executor used by this execution policy. The
+        /// execution category of Executor shall not be weaker than that of
+        /// this execution policy
+        template <typename Executor_, typename Parameters_>
+        struct rebind
+        {
+            /// The type of the rebound execution policy
+            typedef parallel_vector_execution_policy_shim<
+                    Executor_, Parameters_
+                > type;
+        };
+
         /// \cond NOINTERNAL
         parallel_vector_execution_policy() {}
         /// \endcond
@@ -1228,6 +1240,64 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
             return *this;
         }
 
+        /// Create a new parallel_vector_execution_policy referencing an
+        /// executor.
+        ///
+        /// \param exec         [in] The executor to use for the execution of
+        ///                     the parallel algorithm the returned execution
+        ///                     policy is used with
+        ///
+        /// \returns The new parallel_vector_execution_policy
+        ///
+        template <typename Executor>
+        typename rebind_executor<
+            parallel_vector_execution_policy, Executor,
+            executor_parameters_type
+        >::type
+        on(Executor && exec) const
+        {
+            static_assert(
+                hpx::traits::is_executor<Executor>::value ||
+                hpx::traits::is_threads_executor<Executor>::value,
+                "hpx::traits::is_executor<Executor>::value || "
+                "hpx::traits::is_threads_executor<Executor>::value");
+
+            typedef typename rebind_executor<
+                parallel_vector_execution_policy, Executor,
+                executor_parameters_type
+            >::type rebound_type;
+            return rebound_type(std::forward<Executor>(exec), parameters());
+        }
+
+        /// Create a new parallel_vector_execution_policy from the given
+        /// execution parameters
+        ///
+        /// \tparam Parameters  The type of the executor parameters to
+        ///                     associate with this execution policy.
+        ///
+        /// \param params       [in] The executor parameters to use for the
+        ///                     execution of the parallel algorithm the
+        ///                     returned execution policy is used with.
+        ///
+        /// \note Requires: is_executor_parameters<Parameters>::value is true
+        ///
+        /// \returns The new parallel_vector_execution_policy
+        ///
+        template <typename... Parameters, typename ParametersType =
+            typename executor_parameters_join<Parameters...>::type>
+        typename rebind_executor<
+            parallel_vector_execution_policy, executor_type, ParametersType
+        >::type
+        with(Parameters &&... params) const
+        {
+            typedef typename rebind_executor<
+                parallel_vector_execution_policy, executor_type,
+                ParametersType
+            >::type rebound_type;
+            return rebound_type(executor(),
+                join_executor_parameters(std::forward<Parameters>(params)...));
+        }
+
     public:
         /// Return the associated executor object.
         executor_type& executor() { return exec_; }
@@ -1255,6 +1325,150 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
     /// Default vector execution policy object.
     static parallel_vector_execution_policy const par_vec;
 
+    /// The class parallel_vector_execution_policy_shim is an execution policy
+    /// type used as a unique type to disambiguate parallel algorithm
+    /// overloading and indicate that a parallel algorithm's execution may be
+    /// vectorized.
+    template <typename Executor, typename Parameters>
+    struct parallel_vector_execution_policy_shim
+      : parallel_vector_execution_policy
+    {
+        /// The type of the executor associated with this execution policy
+        typedef Executor executor_type;
+
+        /// The type of the associated executor parameters object which is
+        /// associated with this execution policy
+        typedef Parameters executor_parameters_type;
+
+        /// The category of the execution agents created by this execution
+        /// policy.
+        typedef typename executor_traits<executor_type>::execution_category
+            execution_category;
+
+        /// Rebind the type of executor used by this execution policy. The
+        /// execution category of Executor shall not be weaker than that of
+        /// this execution policy
+        template <typename Executor_, typename Parameters_>
+        struct rebind
+        {
+            /// The type of the rebound execution policy
+            typedef parallel_vector_execution_policy_shim<
+                    Executor_, Parameters_
+                > type;
+        };
+
+        /// Create a new parallel_vector_execution_policy_shim from itself
+        ///
+        /// \param tag          [in] Specify that the corresponding asynchronous
+        ///                     execution policy should be used
+        ///
+        /// \returns The new parallel_vector_execution_policy_shim
+        ///
+        parallel_vector_execution_policy_shim operator()(
+            task_execution_policy_tag tag) const
+        {
+            return *this;
+        }
+
+        /// Create a new parallel_vector_execution_policy_shim from the given
+        /// executor
+        ///
+        /// \tparam Executor    The type of the executor to associate with this
+        ///                     execution policy.
+        ///
+        /// \param exec         [in] The executor to use for the
+        ///                     execution of the parallel algorithm the
+        ///                     returned execution policy is used with.
+        ///
+        /// \note Requires: is_executor<Executor>::value is true
+        ///
+        /// \returns The new parallel_vector_execution_policy_shim
+        ///
+        template <typename Executor_>
+        typename rebind_executor<
+            parallel_vector_execution_policy_shim, Executor_,
+            executor_parameters_type
+        >::type
+        on(Executor_ && exec) const
+        {
+            static_assert(
+                hpx::traits::is_executor<Executor_>::value ||
+                hpx::traits::is_threads_executor<Executor_>::value,
+                "hpx::traits::is_executor<Executor_>::value || "
+                "hpx::traits::is_threads_executor<Executor_>::value");
+
+            typedef typename rebind_executor<
+                parallel_vector_execution_policy_shim, Executor_,
+                executor_parameters_type
+            >::type rebound_type;
+            return rebound_type(std::forward<Executor_>(exec), params_);
+        }
+
+        /// Create a new parallel_vector_execution_policy_shim from the given
+        /// execution parameters
+        ///
+        /// \tparam Parameters  The type of the executor parameters to
+        ///                     associate with this execution policy.
+        ///
+        /// \param params       [in] The executor parameters to use for the
+        ///                     execution of the parallel algorithm the
+        ///                     returned execution policy is used with.
+        ///
+        /// \note Requires: is_executor_parameters<Parameters>::value is true
+        ///
+        /// \returns The new parallel_vector_execution_policy_shim
+        ///
+        template <typename... Parameters_, typename ParametersType =
+            typename executor_parameters_join<Parameters_...>::type>
+        typename rebind_executor<
+            parallel_vector_execution_policy_shim, executor_type,
+            ParametersType
+        >::type
+        with(Parameters_ &&... params) const
+        {
+            typedef typename rebind_executor<
+                parallel_vector_execution_policy_shim, executor_type,
+                ParametersType
+            >::type rebound_type;
+            return rebound_type(exec_,
+                join_executor_parameters(std::forward<Parameters_>(params)...));
+        }
+
+        /// Return the associated executor object.
+        Executor& executor() { return exec_; }
+        /// Return the associated executor object.
+        Executor const& executor() const { return exec_; }
+
+        /// Return the associated executor parameters object.
+        Parameters& parameters() { return params_; }
+        /// Return the associated executor parameters object.
+        Parameters const& parameters() const { return params_; }
+
+        /// \cond NOINTERNAL
+        parallel_vector_execution_policy_shim() {}
+
+        template <typename Executor_, typename Parameters_>
+        parallel_vector_execution_policy_shim(
+                Executor_ && exec, Parameters_ && params)
+          : exec_(std::forward<Executor_>(exec)),
+            params_(std::forward<Parameters_>(params))
+        {}
+
+    private:
+        friend class hpx::serialization::access;
+
+        template <typename Archive>
+        void serialize(Archive & ar, const unsigned int version)
+        {
+            ar & exec_ & params_;
+        }
+
+    private:
+        Executor exec_;
+        Parameters params_;
+        /// \endcond
+    };
+
     ///////////////////////////////////////////////////////////////////////////
     // Allow to detect execution policies which were created as a result
     // of a rebind operation. This information can be used to inhibit the
@@ -1290,6 +1504,12 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
                 parallel_task_execution_policy_shim<Executor, Parameters> >
           : std::true_type
         {};
+
+        template <typename Executor, typename Parameters>
+        struct is_rebound_execution_policy<
+                parallel_vector_execution_policy_shim<Executor, Parameters> >
+          : std::true_type
+        {};
     }
 
     template <typename T>
@@ -1379,6 +1599,12 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
           : std::true_type
         {};
 
+        template <typename Executor, typename Parameters>
+        struct is_execution_policy<
+                parallel_vector_execution_policy_shim<Executor, Parameters> >
+          : std::true_type
+        {};
+
         template <>
         struct is_execution_policy<sequential_execution_policy>
           : std::true_type
@@ -1463,6 +1689,12 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
           : std::true_type
         {};
 
+        template <typename Executor, typename Parameters>
+        struct is_parallel_execution_policy<
+                parallel_vector_execution_policy_shim<Executor, Parameters> >
+          : std::true_type
+        {};
+
         template <>
         struct is_parallel_execution_policy<parallel_task_execution_policy>
           : std::true_type
@@ -1602,6 +1834,49 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
       : detail::is_async_execution_policy<typename hpx::util::decay<T>::type>
     {};
 
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        /// \cond NOINTERNAL
+        template <typename T>
+        struct is_vectorpack_execution_policy
+          : std::false_type
+        {};
+
+        template <>
+        struct is_vectorpack_execution_policy<parallel_vector_execution_policy>
+          : std::true_type
+        {};
+
+        template <typename Executor, typename Parameters>
+        struct is_vectorpack_execution_policy<
+                parallel_vector_execution_policy_shim<Executor, Parameters> >
+          : std::true_type
+        {};
+        /// \endcond
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Extension: Detect whether given execution policy allows algorithms to
+    ///            process contiguous ranges in packs of vector width
+    ///
+    /// 1. The type is_vectorpack_execution_policy can be used to select
+    ///    the vectorizing loop kernels of the algorithms (see
+    ///    hpx/parallel/util/vector_pack.hpp).
+    /// 2. If T is the type of a standard or implementation-defined execution
+    ///    policy, is_vectorpack_execution_policy<T> shall be publicly derived
+    ///    from integral_constant<bool, true>, otherwise from
+    ///    integral_constant<bool, false>.
+    /// 3. The behavior of a program that adds specializations for
+    ///    is_vectorpack_execution_policy is undefined.
+    ///
+    // extension:
+    template <typename T>
+    struct is_vectorpack_execution_policy
+      : detail::is_vectorpack_execution_policy<
+            typename hpx::util::decay<T>::type>
+    {};
+
 #if defined(HPX_HAVE_GENERIC_EXECUTION_POLICY)
     ///////////////////////////////////////////////////////////////////////////
     ///
@@ -34,6 +34,9 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
     struct parallel_task_execution_policy_shim;
 
     struct parallel_vector_execution_policy;
+
+    template <typename Executor, typename Parameters>
+    struct parallel_vector_execution_policy_shim;
 }}}
 
 #endif
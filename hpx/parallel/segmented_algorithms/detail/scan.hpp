@@ -0,0 +1,353 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_SEGMENTED_ALGORITHM_DETAIL_SCAN_OCT_18_2016_0730PM)
+#define HPX_PARALLEL_SEGMENTED_ALGORITHM_DETAIL_SCAN_OCT_18_2016_0730PM
+
+#include <hpx/config.hpp>
+#include <hpx/dataflow.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/runtime/naming/id_type.hpp>
+#include <hpx/runtime/naming/name.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/traits/segmented_iterator_traits.hpp>
+#include <hpx/util/decay.hpp>
+#include <hpx/util/invoke.hpp>
+#include <hpx/util/unwrapped.hpp>
+
+#include <hpx/parallel/algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/algorithms/detail/remove_asynchronous.hpp>
+#include <hpx/parallel/algorithms/transform_exclusive_scan.hpp>
+#include <hpx/parallel/algorithms/transform_inclusive_scan.hpp>
+#include <hpx/parallel/config/inline_namespace.hpp>
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/segmented_algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/util/detail/algorithm_result.hpp>
+#include <hpx/parallel/util/detail/handle_remote_exceptions.hpp>
+#include <hpx/parallel/util/partitioner.hpp>
+
+#include <boost/exception_ptr.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <list>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // segmented_scan
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        /// \cond NOINTERNAL
+
+        // The segmented scans are distributed two-phase scans:
+        //
+        //  1) the total of every segment (but the last) is computed where
+        //     the segment lives,
+        //  2) the totals are combined into the initial values for all
+        //     segments, each of those becomes available as soon as the
+        //     totals of all preceding segments are known,
+        //  3) every segment is scanned in place (where it lives) starting
+        //     from its initial value.
+        //
+        // Only the segment totals are sent back to the caller, the elements
+        // themselves are never moved. The output range has to be
+        // partitioned in the same way as the input range.
+
+        template <typename T, typename Iter, typename Conv, typename Op>
+        T segmented_scan_accumulate(Iter first, std::size_t count, T val,
+            Conv const& conv, Op const& op)
+        {
+            for (/**/; count != 0; (void) --count, ++first)
+            {
+                val = hpx::util::invoke(op, val,
+                    hpx::util::invoke(conv, *first));
+            }
+            return val;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // calculate the total of a segment
+        template <typename T>
+        struct segmented_scan_total
+          : public detail::algorithm<segmented_scan_total<T>, T>
+        {
+            segmented_scan_total()
+              : segmented_scan_total::algorithm("segmented_scan_total")
+            {}
+
+            template <typename ExPolicy, typename InIter, typename Conv,
+                typename Op>
+            static T
+            sequential(ExPolicy, InIter first, InIter last, Conv && conv,
+                Op && op)
+            {
+                T val = hpx::util::invoke(conv, *first);
+                return segmented_scan_accumulate(std::next(first),
+                    std::distance(first, last) - 1, std::move(val), conv, op);
+            }
+
+            template <typename ExPolicy, typename InIter, typename Conv,
+                typename Op>
+            static typename util::detail::algorithm_result<ExPolicy, T>::type
+            parallel(ExPolicy && policy, InIter first, InIter last,
+                Conv && conv, Op && op)
+            {
+                // the partial totals are combined in order, op does not
+                // have to be commutative
+                return util::partitioner<ExPolicy, T>::call(
+                    std::forward<ExPolicy>(policy),
+                    first, std::distance(first, last),
+                    [conv, op](InIter part_begin, std::size_t part_size) -> T
+                    {
+                        T val = hpx::util::invoke(conv, *part_begin);
+                        return segmented_scan_accumulate(std::next(part_begin),
+                            part_size - 1, std::move(val), conv, op);
+                    },
+                    hpx::util::unwrapped(
+                        [op](std::vector<T> && totals) -> T
+                        {
+                            auto it = totals.begin();
+                            T val = *it;
+                            for (++it; it != totals.end(); ++it)
+                                val = hpx::util::invoke(op, val, *it);
+                            return val;
+                        }));
+            }
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // scan a segment starting off the given initial value
+        template <typename OutIter, typename T>
+        struct segmented_scan_segment
+          : public detail::algorithm<segmented_scan_segment<OutIter, T>, OutIter>
+        {
+            segmented_scan_segment()
+              : segmented_scan_segment::algorithm("segmented_scan_segment")
+            {}
+
+            template <typename ExPolicy, typename InIter, typename FwdIter,
+                typename Conv, typename Op>
+            static FwdIter
+            sequential(ExPolicy, InIter first, InIter last, FwdIter dest,
+                T init, Conv && conv, Op && op, bool inclusive)
+            {
+                // every element is read before the corresponding output is
+                // written, this allows for the scan to be performed in place
+                for (/**/; first != last; (void) ++first, ++dest)
+                {
+                    T val = hpx::util::invoke(conv, *first);
+                    if (inclusive)
+                    {
+                        init = hpx::util::invoke(op, init, std::move(val));
+                        *dest = init;
+                    }
+                    else
+                    {
+                        *dest = init;
+                        init = hpx::util::invoke(op, init, std::move(val));
+                    }
+                }
+                return dest;
+            }
+
+            template <typename ExPolicy, typename InIter, typename FwdIter,
+                typename Conv, typename Op>
+            static typename util::detail::algorithm_result<
+                ExPolicy, FwdIter
+            >::type
+            parallel(ExPolicy && policy, InIter first, InIter last,
+                FwdIter dest, T init, Conv && conv, Op && op, bool inclusive)
+            {
+                if (inclusive)
+                {
+                    return hpx::parallel::transform_inclusive_scan(
+                        std::forward<ExPolicy>(policy), first, last, dest,
+                        std::forward<Conv>(conv), std::move(init),
+                        std::forward<Op>(op));
+                }
+                return hpx::parallel::transform_exclusive_scan(
+                    std::forward<ExPolicy>(policy), first, last, dest,
+                    std::forward<Conv>(conv), std::move(init),
+                    std::forward<Op>(op));
+            }
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename ExPolicy, typename SegIter, typename OutIter,
+            typename Conv, typename T, typename Op>
+        typename util::detail::algorithm_result<ExPolicy, OutIter>::type
+        segmented_scan(ExPolicy const& policy, SegIter first, SegIter last,
+            OutIter dest, Conv const& conv, T const& init, Op const& op,
+            bool inclusive)
+        {
+            typedef hpx::traits::segmented_iterator_traits<SegIter> traits;
+            typedef typename traits::segment_iterator segment_iterator;
+            typedef typename traits::local_iterator local_iterator_type;
+
+            typedef hpx::traits::segmented_iterator_traits<OutIter> out_traits;
+            typedef typename out_traits::segment_iterator out_segment_iterator;
+            typedef typename out_traits::local_iterator
+                out_local_iterator_type;
+
+            typedef typename hpx::util::decay<ExPolicy>::type policy_type;
+            typedef parallel::is_sequential_execution_policy<ExPolicy> is_seq;
+            typedef util::detail::algorithm_result<ExPolicy, OutIter> result;
+
+            // the remote parts of the algorithm always block, the caller
+            // is not blocked for asynchronous execution policies
+            typedef typename remove_asynchronous<policy_type>::type
+                sync_policy_type;
+
+            if (first == last)
+                return result::get(std::move(dest));
+
+            segment_iterator sit = traits::segment(first);
+            segment_iterator send = traits::segment(last);
+
+            // collect all (non-empty) local ranges
+            std::vector<id_type> ids;
+            std::vector<local_iterator_type> begins, ends;
+            std::vector<std::size_t> sizes;
+
+            auto add_segment =
+                [&](segment_iterator const& it, local_iterator_type beg,
+                    local_iterator_type end)
+                {
+                    if (beg != end)
+                    {
+                        ids.push_back(traits::get_id(it));
+                        begins.push_back(beg);
+                        ends.push_back(end);
+                        sizes.push_back(std::distance(beg, end));
+                    }
+                };
+
+            if (sit == send)
+            {
+                // all elements are on the same partition
+                add_segment(sit, traits::local(first), traits::local(last));
+            }
+            else {
+                // handle the remaining part of the first partition
+                add_segment(sit, traits::local(first), traits::end(sit));
+
+                // handle all of the full partitions
+                for (++sit; sit != send; ++sit)
+                    add_segment(sit, traits::begin(sit), traits::end(sit));
+
+                // handle the beginning of the last partition
+                add_segment(sit, traits::begin(sit), traits::local(last));
+            }
+
+            std::size_t const segments = ids.size();
+
+            // find the corresponding local output ranges
+            std::vector<out_local_iterator_type> dests;
+            dests.reserve(segments);
+
+            OutIter out = dest;
+            for (std::size_t i = 0; i != segments; ++i)
+            {
+                out_segment_iterator oseg = out_traits::segment(out);
+                out_local_iterator_type obeg = out_traits::local(out);
+                if (std::size_t(std::distance(obeg, out_traits::end(oseg))) <
+                    sizes[i])
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "hpx::parallel::detail::segmented_scan",
+                        "the output range has to be partitioned in the same "
+                        "way as the input range");
+                }
+
+                // every segment is scanned on the locality of its input, the
+                // corresponding output has to be local there as well
+                if (naming::get_locality_id_from_id(out_traits::get_id(oseg)) !=
+                    naming::get_locality_id_from_id(ids[i]))
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "hpx::parallel::detail::segmented_scan",
+                        "the output range has to be located on the same "
+                        "localities as the input range");
+                }
+
+                dests.push_back(obeg);
+                std::advance(out, sizes[i]);
+            }
+
+            // step 1 & 2: calculate the totals of all segments and pipeline
+            // them into the initial values of the subsequent segments
+            std::vector<shared_future<T> > inits;
+            inits.reserve(segments);
+            inits.push_back(hpx::make_ready_future(init));
+
+            for (std::size_t i = 0; i != segments - 1; ++i)
+            {
+                future<T> total = dispatch_async(ids[i],
+                    segmented_scan_total<T>(), sync_policy_type(),
+                    is_seq(), begins[i], ends[i], conv, op);
+
+                inits.push_back(
+                    dataflow(
+                        [op](shared_future<T> prev,
+                            future<T> total) -> T
+                        {
+                            return hpx::util::invoke(op, prev.get(),
+                                total.get());
+                        },
+                        inits.back(), std::move(total)));
+            }
+
+            // step 3: scan every segment as soon as its initial value is
+            // available
+            std::vector<future<out_local_iterator_type> > scans;
+            scans.reserve(segments);
+
+            for (std::size_t i = 0; i != segments; ++i)
+            {
+                id_type id = ids[i];
+                local_iterator_type beg = begins[i];
+                local_iterator_type end = ends[i];
+                out_local_iterator_type obeg = dests[i];
+
+                scans.push_back(
+                    dataflow(
+                        [=](shared_future<T> f)
+                            -> future<out_local_iterator_type>
+                        {
+                            return dispatch_async(id,
+                                segmented_scan_segment<
+                                    out_local_iterator_type, T
+                                >(), sync_policy_type(), is_seq(),
+                                beg, end, obeg, f.get(), conv, op,
+                                inclusive);
+                        },
+                        inits[i]));
+            }
+
+            return result::get(
+                dataflow(
+                    [out](std::vector<future<out_local_iterator_type> > && r)
+                        -> OutIter
+                    {
+                        // handle any remote exceptions, will throw on error
+                        std::list<boost::exception_ptr> errors;
+                        parallel::util::detail::handle_remote_exceptions<
+                            policy_type
+                        >::call(r, errors);
+                        return out;
+                    },
+                    std::move(scans)));
+        }
+
+        /// \endcond
+    }
+}}}
+
+#endif
@@ -0,0 +1,694 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_SEGMENTED_ALGORITHM_SORT_OCT_18_2016_0645PM)
+#define HPX_PARALLEL_SEGMENTED_ALGORITHM_SORT_OCT_18_2016_0645PM
+
+#include <hpx/config.hpp>
+#include <hpx/async.hpp>
+#include <hpx/lcos/latch.hpp>
+#include <hpx/lcos/wait_all.hpp>
+#include <hpx/runtime/naming/id_type.hpp>
+#include <hpx/runtime/serialization/vector.hpp>
+#include <hpx/traits/segmented_iterator_traits.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/decay.hpp>
+#include <hpx/util/invoke.hpp>
+#include <hpx/util/unwrapped.hpp>
+
+#include <hpx/parallel/algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/algorithms/detail/remove_asynchronous.hpp>
+#include <hpx/parallel/algorithms/sort.hpp>
+#include <hpx/parallel/config/inline_namespace.hpp>
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/segmented_algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/util/compare_projected.hpp>
+#include <hpx/parallel/util/detail/algorithm_result.hpp>
+#include <hpx/parallel/util/detail/handle_remote_exceptions.hpp>
+
+#include <boost/exception_ptr.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <list>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // segmented_sort
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        /// \cond NOINTERNAL
+
+        // The segmented sort is a distributed sample sort:
+        //
+        //  1) every segment is sorted locally,
+        //  2) every segment contributes a number of regularly spaced samples
+        //     (proportional to its size), the samples are used to select
+        //     one splitter less than there are segments,
+        //  3) every segment determines the bucket boundaries of its (sorted)
+        //     data with respect to the splitters,
+        //  4) every segment gathers the pieces of all buckets which overlap
+        //     with its position in the global sequence from all other
+        //     segments (all-to-all exchange), merges them, and - after all
+        //     segments have read their input - overwrites its data.
+        //
+        // The segments keep their sizes. In order to keep the buckets
+        // balanced even for input with many equal elements, the elements
+        // are ordered by (value, segment, position) while selecting the
+        // splitters and computing the bucket boundaries.
+
+        // number of samples taken per segment (for equally sized segments)
+        static const std::size_t segmented_sort_oversampling = 16;
+
+        // position of the k'th out of count regularly spaced samples
+        inline std::size_t segmented_sort_sample_position(std::size_t k,
+            std::size_t count, std::size_t size)
+        {
+            return ((2 * k + 1) * size) / (2 * count);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // extract regularly spaced samples from a (sorted) segment
+        template <typename Iter>
+        struct segmented_sort_sample
+          : public detail::algorithm<
+                segmented_sort_sample<Iter>,
+                std::vector<typename std::iterator_traits<Iter>::value_type>
+            >
+        {
+            typedef typename std::iterator_traits<Iter>::value_type value_type;
+
+            segmented_sort_sample()
+              : segmented_sort_sample::algorithm("segmented_sort_sample")
+            {}
+
+            template <typename ExPolicy, typename FwdIter>
+            static std::vector<value_type>
+            sequential(ExPolicy, FwdIter first, FwdIter last,
+                std::size_t count)
+            {
+                std::size_t size = std::distance(first, last);
+
+                std::vector<value_type> samples;
+                samples.reserve(count);
+                for (std::size_t k = 0; k != count; ++k)
+                {
+                    samples.push_back(*std::next(first,
+                        segmented_sort_sample_position(k, count, size)));
+                }
+                return samples;
+            }
+
+            template <typename ExPolicy, typename FwdIter>
+            static typename util::detail::algorithm_result<
+                ExPolicy, std::vector<value_type>
+            >::type
+            parallel(ExPolicy && policy, FwdIter first, FwdIter last,
+                std::size_t count)
+            {
+                return util::detail::algorithm_result<
+                        ExPolicy, std::vector<value_type>
+                    >::get(sequential(policy, first, last, count));
+            }
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // calculate the bucket boundaries of a (sorted) segment
+        template <typename Iter>
+        struct segmented_sort_bounds
+          : public detail::algorithm<
+                segmented_sort_bounds<Iter>, std::vector<std::size_t>
+            >
+        {
+            typedef typename std::iterator_traits<Iter>::value_type value_type;
+
+            segmented_sort_bounds()
+              : segmented_sort_bounds::algorithm("segmented_sort_bounds")
+            {}
+
+            template <typename ExPolicy, typename FwdIter, typename Compare,
+                typename Proj>
+            static std::vector<std::size_t>
+            sequential(ExPolicy, FwdIter first, FwdIter last,
+                std::size_t segment, std::vector<value_type> const& splitters,
+                std::vector<std::size_t> const& splitter_segments,
+                std::vector<std::size_t> const& splitter_positions,
+                Compare && comp, Proj && proj)
+            {
+                util::compare_projected<Compare, Proj> less(
+                    std::forward<Compare>(comp), std::forward<Proj>(proj));
+
+                std::size_t size = std::distance(first, last);
+
+                std::vector<std::size_t> bounds;
+                bounds.reserve(splitters.size() + 2);
+                bounds.push_back(0);
+
+                for (std::size_t k = 0; k != splitters.size(); ++k)
+                {
+                    // elements equal to the splitter are ordered by their
+                    // segment and position
+                    std::size_t lower = std::distance(first,
+                        std::lower_bound(first, last, splitters[k], less));
+
+                    if (segment > splitter_segments[k])
+                    {
+                        bounds.push_back(lower);
+                        continue;
+                    }
+
+                    std::size_t upper = std::distance(first,
+                        std::upper_bound(first, last, splitters[k], less));
+
+                    if (segment < splitter_segments[k])
+                    {
+                        bounds.push_back(upper);
+                    }
+                    else
+                    {
+                        bounds.push_back((std::max)(lower,
+                            (std::min)(upper, splitter_positions[k])));
+                    }
+                }
+
+                bounds.push_back(size);
+                return bounds;
+            }
+
+            template <typename ExPolicy, typename FwdIter, typename Compare,
+                typename Proj>
+            static typename util::detail::algorithm_result<
+                ExPolicy, std::vector<std::size_t>
+            >::type
+            parallel(ExPolicy && policy, FwdIter first, FwdIter last,
+                std::size_t segment, std::vector<value_type> const& splitters,
+                std::vector<std::size_t> const& splitter_segments,
+                std::vector<std::size_t> const& splitter_positions,
+                Compare && comp, Proj && proj)
+            {
+                return util::detail::algorithm_result<
+                        ExPolicy, std::vector<std::size_t>
+                    >::get(sequential(policy, first, last, segment,
+                        splitters, splitter_segments, splitter_positions,
+                        std::forward<Compare>(comp), std::forward<Proj>(proj)));
+            }
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // retrieve a copy of the elements of a segment
+        template <typename Iter>
+        struct segmented_sort_copy
+          : public detail::algorithm<
+                segmented_sort_copy<Iter>,
+                std::vector<typename std::iterator_traits<Iter>::value_type>
+            >
+        {
+            typedef typename std::iterator_traits<Iter>::value_type value_type;
+
+            segmented_sort_copy()
+              : segmented_sort_copy::algorithm("segmented_sort_copy")
+            {}
+
+            template <typename ExPolicy, typename FwdIter>
+            static std::vector<value_type>
+            sequential(ExPolicy, FwdIter first, FwdIter last)
+            {
+                return std::vector<value_type>(first, last);
+            }
+
+            template <typename ExPolicy, typename FwdIter>
+            static typename util::detail::algorithm_result<
+                ExPolicy, std::vector<value_type>
+            >::type
+            parallel(ExPolicy && policy, FwdIter first, FwdIter last)
+            {
+                return util::detail::algorithm_result<
+                        ExPolicy, std::vector<value_type>
+                    >::get(sequential(policy, first, last));
+            }
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // gather the pieces of all buckets overlapping with a segment, merge
+        // them, and overwrite the segment once all segments have read their
+        // input
+        template <typename Iter>
+        struct segmented_sort_exchange
+          : public detail::algorithm<segmented_sort_exchange<Iter>, Iter>
+        {
+            typedef typename std::iterator_traits<Iter>::value_type value_type;
+
+            segmented_sort_exchange()
+              : segmented_sort_exchange::algorithm("segmented_sort_exchange")
+            {}
+
+            template <typename ExPolicy, typename Compare>
+            static std::vector<value_type>
+            gather(ExPolicy const& policy, std::vector<id_type> const& ids,
+                std::vector<Iter> const& src_first,
+                std::vector<Iter> const& src_last,
+                std::vector<std::size_t> const& pieces,
+                std::vector<std::size_t> const& ranks, Compare const& comp)
+            {
+                // request all pieces at once
+                std::vector<future<std::vector<value_type> > > fetched;
+                fetched.reserve(ids.size());
+                for (std::size_t i = 0; i != ids.size(); ++i)
+                {
+                    fetched.push_back(dispatch_async(ids[i],
+                        segmented_sort_copy<Iter>(), policy, std::true_type(),
+                        src_first[i], src_last[i]));
+                }
+
+                hpx::wait_all(fetched);
+
+                std::list<boost::exception_ptr> errors;
+                parallel::util::detail::handle_remote_exceptions<
+                        ExPolicy
+                    >::call(fetched, errors);
+
+                std::size_t size = 0;
+                for (std::size_t b = 0; b != pieces.size(); ++b)
+                    size += ranks[2 * b + 1] - ranks[2 * b];
+
+                std::vector<value_type> data;
+                data.reserve(size);
+
+                std::size_t piece = 0;
+                for (std::size_t b = 0; b != pieces.size(); ++b)
+                {
+                    // concatenate the (sorted) pieces of this bucket
+                    std::vector<value_type> bucket;
+                    std::vector<std::size_t> bounds(1, 0);
+                    for (std::size_t i = 0; i != pieces[b]; ++i, ++piece)
+                    {
+                        std::vector<value_type> p = fetched[piece].get();
+                        bucket.insert(bucket.end(),
+                            std::make_move_iterator(p.begin()),
+                            std::make_move_iterator(p.end()));
+                        bounds.push_back(bucket.size());
+                    }
+
+                    // merge adjacent pieces until only one is left
+                    while (bounds.size() > 2)
+                    {
+                        std::vector<std::size_t> next(1, 0);
+                        for (std::size_t i = 0; i + 1 < bounds.size(); i += 2)
+                        {
+                            if (i + 2 < bounds.size())
+                            {
+                                std::inplace_merge(
+                                    bucket.begin() + bounds[i],
+                                    bucket.begin() + bounds[i + 1],
+                                    bucket.begin() + bounds[i + 2], comp);
+                                next.push_back(bounds[i + 2]);
+                            }
+                            else
+                            {
+                                next.push_back(bounds[i + 1]);
+                            }
+                        }
+                        bounds = std::move(next);
+                    }
+
+                    // keep the part of the bucket which belongs to the
+                    // segment
+                    data.insert(data.end(),
+                        std::make_move_iterator(
+                            bucket.begin() + ranks[2 * b]),
+                        std::make_move_iterator(
+                            bucket.begin() + ranks[2 * b + 1]));
+                }
+
+                return data;
+            }
+
+            template <typename ExPolicy, typename FwdIter, typename Compare,
+                typename Proj>
+            static FwdIter
+            sequential(ExPolicy policy, FwdIter first, FwdIter last,
+                std::vector<id_type> const& ids,
+                std::vector<Iter> const& src_first,
+                std::vector<Iter> const& src_last,
+                std::vector<std::size_t> const& pieces,
+                std::vector<std::size_t> const& ranks, hpx::lcos::latch l,
+                Compare && comp, Proj && proj)
+            {
+                util::compare_projected<Compare, Proj> less(
+                    std::forward<Compare>(comp), std::forward<Proj>(proj));
+
+                std::vector<value_type> data;
+                try {
+                    data = gather(policy, ids, src_first, src_last, pieces,
+                        ranks, less);
+                }
+                catch (...) {
+                    // make sure no other segment waits forever
+                    l.set_exception(boost::current_exception());
+                    throw;
+                }
+
+                // the data of this segment may be overwritten only after all
+                // segments have gathered their input
+                l.count_down_and_wait();
+
+                HPX_ASSERT(std::size_t(std::distance(first, last)) ==
+                    data.size());
+                return std::move(data.begin(), data.end(), first);
+            }
+
+            template <typename ExPolicy, typename FwdIter, typename Compare,
+                typename Proj>
+            static typename util::detail::algorithm_result<
+                ExPolicy, FwdIter
+            >::type
+            parallel(ExPolicy && policy, FwdIter first, FwdIter last,
+                std::vector<id_type> const& ids,
+                std::vector<Iter> const& src_first,
+                std::vector<Iter> const& src_last,
+                std::vector<std::size_t> const& pieces,
+                std::vector<std::size_t> const& ranks, hpx::lcos::latch l,
+                Compare && comp, Proj && proj)
+            {
+                return util::detail::algorithm_result<ExPolicy, FwdIter>::get(
+                    sequential(policy, first, last, ids, src_first, src_last,
+                        pieces, ranks, l, std::forward<Compare>(comp),
+                        std::forward<Proj>(proj)));
+            }
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename ExPolicy, typename T>
+        std::vector<T>
+        segmented_sort_wait(std::vector<hpx::future<T> > && results)
+        {
+            hpx::wait_all(results);
+
+            // handle any remote exceptions, will throw on error
+            std::list<boost::exception_ptr> errors;
+            parallel::util::detail::handle_remote_exceptions<
+                    ExPolicy
+                >::call(results, errors);
+
+            return hpx::util::unwrapped(std::move(results));
+        }
+
+        template <typename ExPolicy>
+        void segmented_sort_wait(std::vector<hpx::future<void> > && results)
+        {
+            hpx::wait_all(results);
+
+            std::list<boost::exception_ptr> errors;
+            parallel::util::detail::handle_remote_exceptions<
+                    ExPolicy
+                >::call(results, errors);
+        }
+
+        // synchronous implementation, ExPolicy is never asynchronous
+        template <typename ExPolicy, typename SegIter, typename Compare,
+            typename Proj, typename IsSeq>
+        SegIter
+        segmented_sort(ExPolicy const& policy, SegIter first, SegIter last,
+            Compare const& comp, Proj const& proj, IsSeq is_seq)
+        {
+            typedef hpx::traits::segmented_iterator_traits<SegIter> traits;
+            typedef typename traits::segment_iterator segment_iterator;
+            typedef typename traits::local_iterator local_iterator_type;
+            typedef typename std::iterator_traits<SegIter>::value_type
+                value_type;
+
+            segment_iterator sit = traits::segment(first);
+            segment_iterator send = traits::segment(last);
+
+            // collect all (non-empty) local ranges
+            std::vector<id_type> ids;
+            std::vector<local_iterator_type> begins, ends;
+            std::vector<std::size_t> sizes;
+
+            auto add_segment =
+                [&](segment_iterator const& it, local_iterator_type beg,
+                    local_iterator_type end)
+                {
+                    if (beg != end)
+                    {
+                        ids.push_back(traits::get_id(it));
+                        begins.push_back(beg);
+                        ends.push_back(end);
+                        sizes.push_back(std::distance(beg, end));
+                    }
+                };
+
+            if (sit == send)
+            {
+                // all elements are on the same partition
+                add_segment(sit, traits::local(first), traits::local(last));
+            }
+            else {
+                // handle the remaining part of the first partition
+                add_segment(sit, traits::local(first), traits::end(sit));
+
+                // handle all of the full partitions
+                for (++sit; sit != send; ++sit)
+                    add_segment(sit, traits::begin(sit), traits::end(sit));
+
+                // handle the beginning of the last partition
+                add_segment(sit, traits::begin(sit), traits::local(last));
+            }
+
+            std::size_t const segments = ids.size();
+            if (segments == 0)
+                return last;
+
+            // step 1: sort all segments locally
+            {
+                std::vector<future<local_iterator_type> > sorted;
+                sorted.reserve(segments);
+                for (std::size_t i = 0; i != segments; ++i)
+                {
+                    sorted.push_back(dispatch_async(ids[i],
+                        sort<local_iterator_type>(), policy, is_seq,
+                        begins[i], ends[i], comp, proj));
+                }
+                segmented_sort_wait<ExPolicy>(std::move(sorted));
+            }
+
+            if (segments == 1)
+                return last;
+
+            // step 2: select the splitters from regularly spaced samples
+            std::size_t total = 0;
+            for (std::size_t size : sizes)
+                total += size;
+
+            std::vector<std::size_t> counts(segments);
+            std::vector<future<std::vector<value_type> > > sampled;
+            sampled.reserve(segments);
+            for (std::size_t i = 0; i != segments; ++i)
+            {
+                counts[i] = (std::min)(sizes[i], (std::max)(std::size_t(1),
+                    (segmented_sort_oversampling * segments * sizes[i]) /
+                        total));
+
+                sampled.push_back(dispatch_async(ids[i],
+                    segmented_sort_sample<local_iterator_type>(), policy,
+                    is_seq, begins[i], ends[i], counts[i]));
+            }
+
+            std::vector<std::vector<value_type> > samples =
+                segmented_sort_wait<ExPolicy>(std::move(sampled));
+
+            // order all samples by (value, segment, position)
+            std::vector<std::pair<std::size_t, std::size_t> > keys;
+            for (std::size_t i = 0; i != segments; ++i)
+            {
+                for (std::size_t k = 0; k != counts[i]; ++k)
+                    keys.push_back(std::make_pair(i, k));
+            }
+
+            std::sort(keys.begin(), keys.end(),
+                [&](std::pair<std::size_t, std::size_t> const& lhs,
+                    std::pair<std::size_t, std::size_t> const& rhs) -> bool
+                {
+                    value_type const& l = samples[lhs.first][lhs.second];
+                    value_type const& r = samples[rhs.first][rhs.second];
+                    if (hpx::util::invoke(comp, hpx::util::invoke(proj, l),
+                            hpx::util::invoke(proj, r)))
+                    {
+                        return true;
+                    }
+                    if (hpx::util::invoke(comp, hpx::util::invoke(proj, r),
+                            hpx::util::invoke(proj, l)))
+                    {
+                        return false;
+                    }
+                    return lhs < rhs;   // positions increase with k
+                });
+
+            std::vector<value_type> splitters;
+            std::vector<std::size_t> splitter_segments, splitter_positions;
+            splitters.reserve(segments - 1);
+            splitter_segments.reserve(segments - 1);
+            splitter_positions.reserve(segments - 1);
+
+            for (std::size_t b = 1; b != segments; ++b)
+            {
+                std::pair<std::size_t, std::size_t> const& key =
+                    keys[(b * keys.size()) / segments];
+
+                splitters.push_back(samples[key.first][key.second]);
+                splitter_segments.push_back(key.first);
+                splitter_positions.push_back(segmented_sort_sample_position(
+                    key.second, counts[key.first], sizes[key.first]));
+            }
+
+            // step 3: determine the bucket boundaries in all segments
+            std::vector<future<std::vector<std::size_t> > > bounded;
+            bounded.reserve(segments);
+            for (std::size_t i = 0; i != segments; ++i)
+            {
+                bounded.push_back(dispatch_async(ids[i],
+                    segmented_sort_bounds<local_iterator_type>(), policy,
+                    is_seq, begins[i], ends[i], i, splitters,
+                    splitter_segments, splitter_positions, comp, proj));
+            }
+
+            std::vector<std::vector<std::size_t> > bounds =
+                segmented_sort_wait<ExPolicy>(std::move(bounded));
+
+            // global start positions of all buckets
+            std::vector<std::size_t> bucket_start(segments + 1, 0);
+            for (std::size_t b = 0; b != segments; ++b)
+            {
+                std::size_t size = 0;
+                for (std::size_t i = 0; i != segments; ++i)
+                    size += bounds[i][b + 1] - bounds[i][b];
+                bucket_start[b + 1] = bucket_start[b] + size;
+            }
+            HPX_ASSERT(bucket_start[segments] == total);
+
+            // step 4: all-to-all exchange, every segment gathers the parts
+            // of the buckets overlapping with its position in the sequence
+            hpx::lcos::latch l(static_cast<std::ptrdiff_t>(segments));
+
+            std::vector<future<local_iterator_type> > exchanged;
+            exchanged.reserve(segments);
+
+            std::size_t segment_start = 0;
+            for (std::size_t d = 0; d != segments; ++d)
+            {
+                std::size_t segment_end = segment_start + sizes[d];
+
+                std::vector<id_type> src_ids;
+                std::vector<local_iterator_type> src_first, src_last;
+                std::vector<std::size_t> pieces, ranks;
+
+                for (std::size_t b = 0; b != segments; ++b)
+                {
+                    std::size_t lower =
+                        (std::max)(segment_start, bucket_start[b]);
+                    std::size_t upper =
+                        (std::min)(segment_end, bucket_start[b + 1]);
+                    if (lower >= upper)
+                        continue;
+
+                    std::size_t count = 0;
+                    for (std::size_t i = 0; i != segments; ++i)
+                    {
+                        if (bounds[i][b] == bounds[i][b + 1])
+                            continue;
+
+                        src_ids.push_back(ids[i]);
+                        src_first.push_back(begins[i] + bounds[i][b]);
+                        src_last.push_back(begins[i] + bounds[i][b + 1]);
+                        ++count;
+                    }
+
+                    pieces.push_back(count);
+                    ranks.push_back(lower - bucket_start[b]);
+                    ranks.push_back(upper - bucket_start[b]);
+                }
+
+                exchanged.push_back(dispatch_async(ids[d],
+                    segmented_sort_exchange<local_iterator_type>(), policy,
+                    is_seq, begins[d], ends[d], std::move(src_ids),
+                    std::move(src_first), std::move(src_last),
+                    std::move(pieces), std::move(ranks), l, comp, proj));
+
+                segment_start = segment_end;
+            }
+
+            segmented_sort_wait<ExPolicy>(std::move(exchanged));
+            return last;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename ExPolicy, typename SyncPolicy, typename SegIter,
+            typename Compare, typename Proj, typename IsSeq>
+        inline typename util::detail::algorithm_result<ExPolicy, SegIter>::type
+        segmented_sort_async(SyncPolicy const& policy, SegIter first,
+            SegIter last, Compare && comp, Proj && proj, IsSeq is_seq,
+            std::false_type)
+        {
+            return util::detail::algorithm_result<ExPolicy, SegIter>::get(
+                segmented_sort(policy, first, last, comp, proj, is_seq));
+        }
+
+        template <typename ExPolicy, typename SyncPolicy, typename SegIter,
+            typename Compare, typename Proj, typename IsSeq>
+        inline typename util::detail::algorithm_result<ExPolicy, SegIter>::type
+        segmented_sort_async(SyncPolicy const& policy, SegIter first,
+            SegIter last, Compare && comp, Proj && proj, IsSeq is_seq,
+            std::true_type)
+        {
+            // run the (blocking) segmented sort on a new thread
+            return util::detail::algorithm_result<ExPolicy, SegIter>::get(
+                hpx::async(
+                    [=]() -> SegIter
+                    {
+                        return segmented_sort(policy, first, last, comp, proj,
+                            is_seq);
+                    }));
+        }
+
+        // segmented implementation
+        template <typename ExPolicy, typename SegIter, typename Compare,
+            typename Proj>
+        inline typename util::detail::algorithm_result<ExPolicy, SegIter>::type
+        sort_(ExPolicy && policy, SegIter first, SegIter last,
+            Compare && comp, Proj && proj, std::true_type)
+        {
+            typedef typename hpx::util::decay<ExPolicy>::type policy_type;
+            typedef parallel::is_sequential_execution_policy<ExPolicy> is_seq;
+            typedef parallel::is_async_execution_policy<ExPolicy> is_async;
+
+            // the remote parts of the algorithm always block
+            typedef typename remove_asynchronous<policy_type>::type
+                sync_policy_type;
+
+            if (first == last)
+            {
+                return util::detail::algorithm_result<ExPolicy, SegIter>::get(
+                    std::move(last));
+            }
+
+            typedef typename hpx::util::decay<Compare>::type compare_type;
+            typedef typename hpx::util::decay<Proj>::type proj_type;
+
+            return segmented_sort_async<ExPolicy>(sync_policy_type(),
+                first, last, compare_type(std::forward<Compare>(comp)),
+                proj_type(std::forward<Proj>(proj)), is_seq(), is_async());
+        }
+
+        /// \endcond
+    }
+}}}
+
+#endif
@@ -0,0 +1,46 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_SEGMENTED_ALGORITHM_TRANSFORM_INCLUSIVE_SCAN_OCT_18_2016_0755PM)
+#define HPX_PARALLEL_SEGMENTED_ALGORITHM_TRANSFORM_INCLUSIVE_SCAN_OCT_18_2016_0755PM
+
+#include <hpx/config.hpp>
+#include <hpx/util/decay.hpp>
+
+#include <hpx/parallel/algorithms/transform_inclusive_scan.hpp>
+#include <hpx/parallel/config/inline_namespace.hpp>
+#include <hpx/parallel/segmented_algorithms/detail/scan.hpp>
+#include <hpx/parallel/util/detail/algorithm_result.hpp>
+
+#include <type_traits>
+#include <utility>
+
+namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // segmented_transform_inclusive_scan
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        /// \cond NOINTERNAL
+
+        // segmented implementation
+        template <typename ExPolicy, typename InIter, typename OutIter,
+            typename Conv, typename T, typename Op>
+        inline typename util::detail::algorithm_result<ExPolicy, OutIter>::type
+        transform_inclusive_scan_(ExPolicy && policy, InIter first, InIter last,
+            OutIter dest, Conv && conv, T && init, Op && op, std::true_type)
+        {
+            typedef typename hpx::util::decay<T>::type value_type;
+
+            return segmented_scan(policy, first, last, dest, conv,
+                value_type(std::forward<T>(init)), op, true);
+        }
+
+        /// \endcond
+    }
+}}}
+
+#endif
@@ -13,21 +13,30 @@
 #include <hpx/dataflow.hpp>
 #include <hpx/exception.hpp>
 #include <hpx/lcos/future.hpp>
+#include <hpx/lcos/local/condition_variable.hpp>
 #include <hpx/lcos/local/spinlock.hpp>
 #include <hpx/lcos/when_all.hpp>
 #include <hpx/traits/is_future.hpp>
 #include <hpx/util/decay.hpp>
+#include <hpx/util/deferred_call.hpp>
+#include <hpx/util/unique_function.hpp>
+#include <hpx/util/unlock_guard.hpp>
 
 #include <hpx/parallel/config/inline_namespace.hpp>
 #include <hpx/parallel/exception_list.hpp>
 #include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/executors/executor_information_traits.hpp>
+#include <hpx/parallel/executors/executor_traits.hpp>
 #include <hpx/parallel/util/detail/algorithm_result.hpp>
 
+#include <boost/atomic.hpp>
 #include <boost/exception_ptr.hpp>
 
 #include <boost/utility/addressof.hpp>      // boost::addressof
 #include <memory>                           // std::addressof
 
+#include <cstddef>
+#include <deque>
 #include <mutex>
 #include <type_traits>
 #include <utility>
@@ -39,7 +48,8 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v2)
     {
         /// \cond NOINTERNAL
         ///////////////////////////////////////////////////////////////////////
-        void handle_task_block_exceptions(parallel::exception_list& errors)
+        inline void handle_task_block_exceptions(
+            parallel::exception_list& errors)
         {
             try {
                 boost::rethrow_exception(boost::current_exception());
@@ -52,6 +62,14 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v2)
                 errors.add(boost::current_exception());
             }
         }
+
+        // The number of helper threads executing tasks stolen from any of
+        // the active task blocks.
+        inline boost::atomic<std::size_t>& get_task_block_helpers()
+        {
+            static boost::atomic<std::size_t> helpers(0);
+            return helpers;
+        }
         /// \endcond
     }
 
@@ -122,10 +140,176 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v2)
         friend typename util::detail::algorithm_result<ExPolicy_>::type
         define_task_block(ExPolicy_ &&, F &&);
 
+        typedef hpx::util::unique_function_nonser<void()> task_type;
+
+        typedef typename ExPolicy::executor_type executor_type;
+        typedef typename executor_traits<executor_type>::execution_category
+            execution_category;
+
+        // Tasks are handed out as futures only if the task block itself
+        // returns a future, otherwise the tasks are kept in a local queue.
+        typedef hpx::traits::is_future<
+                typename util::detail::algorithm_result<ExPolicy>::type
+            > has_future_result;
+
         explicit task_block(ExPolicy const& policy = ExPolicy())
           : id_(threads::get_self_id()),
-            policy_(policy)
+            policy_(policy),
+            helpers_(0),
+            max_helpers_(0),
+            helping_(false)
+        {
+            if (!has_future_result::value &&
+                !std::is_same<
+                    execution_category, sequential_execution_tag
+                >::value)
+            {
+                max_helpers_ = executor_information_traits<executor_type>::
+                    processing_units_count(
+                        policy_.executor(), policy_.parameters());
+            }
+        }
+
+        // The task block is active on the thread which created it, unless
+        // that thread is currently executing one of its tasks. Only the
+        // owning thread writes helping_, so it must not be read before the
+        // calling thread was found to be the owner.
+        bool is_active() const
         {
+            return id_ == threads::get_self_id() && !helping_;
+        }
+
+        void invoke_task(task_type& task)
+        {
+            try {
+                task();
+            }
+            catch (...) {
+                std::lock_guard<mutex_type> l(mtx_);
+                detail::handle_task_block_exceptions(errors_);
+            }
+        }
+
+        // Reserve a helper thread, the number of helper threads is bounded
+        // by the number of cores used by the executor.
+        bool acquire_helper()
+        {
+            boost::atomic<std::size_t>& helpers =
+                detail::get_task_block_helpers();
+
+            std::size_t count = helpers.load(boost::memory_order_relaxed);
+            while (count < max_helpers_)
+            {
+                if (helpers.compare_exchange_weak(count, count + 1))
+                    return true;
+            }
+            return false;
+        }
+
+        // Executed by helper threads: steal the oldest tasks (which
+        // usually represent the largest amount of work) until none is left.
+        void help()
+        {
+            std::unique_lock<mutex_type> l(mtx_);
+            while (!pending_.empty())
+            {
+                task_type task(std::move(pending_.front()));
+                pending_.pop_front();
+
+                hpx::util::unlock_guard<
+                    std::unique_lock<mutex_type> > ul(l);
+                invoke_task(task);
+            }
+
+            release_helper();
+        }
+
+        // Give back a reserved helper thread, the lock has to be held. The
+        // task block may go out of scope as soon as the lock is released.
+        void release_helper()
+        {
+            --detail::get_task_block_helpers();
+            if (--helpers_ == 0)
+                cond_.notify_all();
+        }
+
+        // Releases the reserved helper thread if scheduling it failed, as
+        // join_tasks would wait for it forever otherwise.
+        struct release_helper_on_error
+        {
+            explicit release_helper_on_error(task_block& tb)
+              : tb_(tb), scheduled_(false)
+            {}
+
+            ~release_helper_on_error()
+            {
+                if (!scheduled_)
+                {
+                    std::lock_guard<mutex_type> l(tb_.mtx_);
+                    tb_.release_helper();
+                }
+            }
+
+            task_block& tb_;
+            bool scheduled_;
+        };
+
+        // Spawn a task without creating a future or a thread for it. The
+        // task is executed by the thread owning the task block while it
+        // waits for the tasks to finish (newest first), unless an idle core
+        // has stolen it before.
+        template <typename F, typename ... Ts>
+        void spawn(std::false_type, F && f, Ts &&... ts)
+        {
+            std::unique_lock<mutex_type> l(mtx_);
+            pending_.push_back(hpx::util::deferred_call(
+                std::forward<F>(f), std::forward<Ts>(ts)...));
+
+            if (helpers_ >= pending_.size() || !acquire_helper())
+                return;
+
+            ++helpers_;
+            l.unlock();
+
+            release_helper_on_error on_error(*this);
+            executor_traits<executor_type>::apply_execute(
+                policy_.executor(), [this]() { help(); });
+            on_error.scheduled_ = true;
+        }
+
+        template <typename F, typename ... Ts>
+        void spawn(std::true_type, F && f, Ts &&... ts)
+        {
+            hpx::future<void> result =
+                executor_traits<executor_type>::async_execute(
+                    policy_.executor(), std::forward<F>(f),
+                    std::forward<Ts>(ts)...);
+
+            std::lock_guard<mutex_type> l(mtx_);
+            tasks_.push_back(std::move(result));
+        }
+
+        // Execute the spawned tasks which have not been stolen and wait for
+        // the helper threads to finish the stolen ones.
+        void join_tasks()
+        {
+            std::unique_lock<mutex_type> l(mtx_);
+            while (!pending_.empty())
+            {
+                task_type task(std::move(pending_.back()));
+                pending_.pop_back();
+
+                helping_ = true;
+                {
+                    hpx::util::unlock_guard<
+                        std::unique_lock<mutex_type> > ul(l);
+                    invoke_task(task);
+                }
+                helping_ = false;
+            }
+
+            while (helpers_ != 0)
+                cond_.wait(l);
         }
 
         void wait_for_completion(std::false_type)
@@ -173,6 +357,8 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v2)
         typename util::detail::algorithm_result<ExPolicy>::type
         when(bool throw_on_error = false)
         {
+            join_tasks();
+
             std::vector<hpx::future<void> > tasks;
             parallel::exception_list errors;
 
@@ -245,22 +431,15 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v2)
         {
             // The proposal requires that the task_block should be
             // 'active' to be usable.
-            if (id_ != threads::get_self_id())
+            if (!is_active())
             {
                 HPX_THROW_EXCEPTION(task_block_not_active,
                     "task_block::run",
                     "the task_block is not active");
             }
 
-            typedef typename ExPolicy::executor_type executor_type;
-
-            hpx::future<void> result =
-                executor_traits<executor_type>::async_execute(
-                    policy_.executor(), std::forward<F>(f),
-                    std::forward<Ts>(ts)...);
-
-            std::lock_guard<mutex_type> l(mtx_);
-            tasks_.push_back(std::move(result));
+            spawn(has_future_result(), std::forward<F>(f),
+                std::forward<Ts>(ts)...);
         }
 
         /// Causes the expression f() to be invoked asynchronously using the
@@ -301,15 +480,13 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v2)
         {
             // The proposal requires that the task_block should be
             // 'active' to be usable.
-            if (id_ != threads::get_self_id())
+            if (!is_active())
             {
                 HPX_THROW_EXCEPTION(task_block_not_active,
                     "task_block::run",
                     "the task_block is not active");
             }
 
-            typedef typename ExPolicy::executor_type executor_type;
-
             hpx::future<void> result =
                 executor_traits<Executor>::async_execute(
                     exec, std::forward<F>(f), std::forward<Ts>(ts)...);
@@ -346,7 +523,7 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v2)
         {
             // The proposal requires that the task_block should be
             // 'active' to be usable.
-            if (id_ != threads::get_self_id())
+            if (!is_active())
             {
                 HPX_THROW_EXCEPTION(task_block_not_active,
                     "task_block::run", "the task_block is not active");
@@ -376,6 +553,13 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v2)
         parallel::exception_list errors_;
         threads::thread_id_type id_;
         ExPolicy policy_;
+
+        // tasks spawned by run() which have not been started yet
+        std::deque<task_type> pending_;
+        lcos::local::condition_variable_any cond_;
+        std::size_t helpers_;       // helper threads stealing from pending_
+        std::size_t max_helpers_;
+        bool helping_;              // the owning thread executes a task
     };
 
     /// Constructs a \a task_block, \a tr, using the given execution policy
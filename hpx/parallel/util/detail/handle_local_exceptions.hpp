@@ -175,6 +175,12 @@ namespace hpx { namespace parallel { namespace util { namespace detail
             }
         }
     };
+
+    template <typename Executor, typename Parameters>
+    struct handle_local_exceptions<
+            parallel_vector_execution_policy_shim<Executor, Parameters> >
+      : handle_local_exceptions<parallel_vector_execution_policy>
+    {};
 }}}}
 
 #endif
@@ -104,6 +104,12 @@ namespace hpx { namespace parallel { namespace util { namespace detail
             }
         }
     };
+
+    template <typename Executor, typename Parameters>
+    struct handle_remote_exceptions<
+            parallel_vector_execution_policy_shim<Executor, Parameters> >
+      : handle_remote_exceptions<parallel_vector_execution_policy>
+    {};
 }}}}
 
 #endif
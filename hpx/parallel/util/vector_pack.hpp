@@ -0,0 +1,311 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_UTIL_VECTOR_PACK_OCT_18_2016_0225PM)
+#define HPX_PARALLEL_UTIL_VECTOR_PACK_OCT_18_2016_0225PM
+
+#include <hpx/config.hpp>
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/traits/is_contiguous_iterator.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/decay.hpp>
+#include <hpx/util/detail/pack.hpp>
+#include <hpx/util/tuple.hpp>
+#include <hpx/util/zip_iterator.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+
+///////////////////////////////////////////////////////////////////////////////
+// The number of bytes processed by one pack of the vectorizing loop kernels.
+// The default corresponds to the width of the AVX-512 registers, which is a
+// multiple of the width of the SSE and AVX registers.
+#if !defined(HPX_PARALLEL_VECTOR_PACK_BYTES)
+#  define HPX_PARALLEL_VECTOR_PACK_BYTES 64
+#endif
+
+// Tell the compiler that the iterations of the following loop are
+// independent from each other.
+#if !defined(HPX_PARALLEL_VECTOR_LOOP)
+#  if defined(__clang__)
+#    define HPX_PARALLEL_VECTOR_LOOP                                          \
+        _Pragma("clang loop vectorize(enable) interleave(enable)")            \
+        /**/
+#  elif defined(__INTEL_COMPILER)
+#    define HPX_PARALLEL_VECTOR_LOOP _Pragma("ivdep") /**/
+#  elif defined(HPX_GCC_VERSION) && HPX_GCC_VERSION >= 40900
+#    define HPX_PARALLEL_VECTOR_LOOP _Pragma("GCC ivdep") /**/
+#  elif defined(HPX_MSVC) && HPX_MSVC >= 1700
+#    define HPX_PARALLEL_VECTOR_LOOP __pragma(loop(ivdep)) /**/
+#  else
+#    define HPX_PARALLEL_VECTOR_LOOP /**/
+#  endif
+#endif
+
+namespace hpx { namespace parallel { namespace util
+{
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // The number of elements of the given type which make up one pack.
+        template <typename T>
+        struct vector_pack_size
+          : std::integral_constant<std::size_t,
+                (sizeof(T) < HPX_PARALLEL_VECTOR_PACK_BYTES) ?
+                    HPX_PARALLEL_VECTOR_PACK_BYTES / sizeof(T) : 1>
+        {};
+
+        // The number of elements to process before the given pointer is
+        // aligned to the pack size. Pointers which can't be aligned by
+        // stepping over whole elements don't get a prologue.
+        template <typename T>
+        HPX_FORCEINLINE std::size_t
+        vector_pack_prologue(T const* p, std::size_t count)
+        {
+            std::size_t misalignment = static_cast<std::size_t>(
+                reinterpret_cast<std::uintptr_t>(p) %
+                    HPX_PARALLEL_VECTOR_PACK_BYTES);
+
+            if (misalignment == 0 || misalignment % sizeof(T) != 0)
+                return 0;
+
+            std::size_t prologue =
+                (HPX_PARALLEL_VECTOR_PACK_BYTES - misalignment) / sizeof(T);
+            return prologue < count ? prologue : count;
+        }
+
+        HPX_FORCEINLINE void vector_pack_advance(std::size_t) {}
+
+        template <typename T, typename ... Ts>
+        HPX_FORCEINLINE void
+        vector_pack_advance(std::size_t n, T*& p, Ts*&... ps)
+        {
+            p += n;
+            vector_pack_advance(n, ps...);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename Iter>
+        struct vector_pack_pointer
+        {
+            typedef typename std::remove_reference<
+                    typename std::iterator_traits<Iter>::reference
+                >::type* type;
+        };
+
+        // Zipped ranges can be processed in packs if all of them are
+        // contiguous.
+        template <typename Iter>
+        struct is_vectorpack_iterator
+          : hpx::traits::is_contiguous_iterator<Iter>
+        {};
+
+        template <typename ... Iters>
+        struct is_vectorpack_iterator<hpx::util::zip_iterator<Iters...> >
+          : hpx::util::detail::all_of<
+                hpx::traits::is_contiguous_iterator<Iters>...
+            >
+        {};
+
+        // Algorithms may process the range [first, first + count) in packs
+        // if the execution policy permits unsequenced execution and if all
+        // involved iterators refer to contiguous memory.
+        template <typename ExPolicy, typename ... Iters>
+        struct is_vectorpack
+          : std::integral_constant<bool,
+                parallel::is_vectorpack_execution_policy<ExPolicy>::value &&
+                hpx::util::detail::all_of<
+                    is_vectorpack_iterator<
+                        typename hpx::util::decay<Iters>::type>...
+                >::value>
+        {};
+
+        // The vectorizing reductions keep one partial result per pack lane,
+        // this requires the result type to be arithmetic.
+        template <typename ExPolicy, typename T, typename ... Iters>
+        struct is_vectorpack_reduce
+          : std::integral_constant<bool,
+                std::is_arithmetic<T>::value &&
+                is_vectorpack<ExPolicy, Iters...>::value>
+        {};
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Return the address of the element a contiguous iterator refers to. The
+    // iterator must be dereferencable unless it is a pointer.
+    template <typename Iter>
+    HPX_FORCEINLINE typename detail::vector_pack_pointer<Iter>::type
+    get_pointer(Iter it)
+    {
+        return std::addressof(*it);
+    }
+
+    template <typename T>
+    HPX_FORCEINLINE T* get_pointer(T* p)
+    {
+        return p;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Invoke f(first + i, rest + i...) for all i in [0, count). The elements
+    // before the first pack boundary of the range starting at first are
+    // processed one by one (prologue), followed by the full packs and the
+    // remaining elements (epilogue). The iterations of a pack are not
+    // sequenced with respect to each other.
+    template <typename F, typename T, typename ... Ts>
+    HPX_FORCEINLINE T*
+    vector_pack_loop_n(std::size_t count, F && f, T* first, Ts*... rest)
+    {
+        static std::size_t const size = detail::vector_pack_size<T>::value;
+
+        std::size_t prologue = detail::vector_pack_prologue(first, count);
+        for (count -= prologue; prologue != 0; --prologue)
+        {
+            f(first, rest...);
+            detail::vector_pack_advance(1, first, rest...);
+        }
+
+        for (/**/; count >= size; count -= size)
+        {
+            HPX_PARALLEL_VECTOR_LOOP
+            for (std::size_t i = 0; i != size; ++i)
+                f(first + i, (rest + i)...);
+
+            detail::vector_pack_advance(size, first, rest...);
+        }
+
+        for (/**/; count != 0; --count)
+        {
+            f(first, rest...);
+            detail::vector_pack_advance(1, first, rest...);
+        }
+        return first;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Reduce the values conv(first + i, rest + i...) for all i in
+    // [0, count) using the given binary operation, count must not be zero.
+    // The packs are reduced into one partial result per lane, which are
+    // combined at the end. The order in which the values are combined is
+    // therefore unspecified (GENERALIZED_SUM).
+    template <typename T, typename Conv, typename Reduce, typename U,
+        typename ... Us>
+    HPX_FORCEINLINE T
+    vector_pack_reduce_n(std::size_t count, Conv && conv, Reduce && r,
+        U* first, Us*... rest)
+    {
+        static std::size_t const size = detail::vector_pack_size<T>::value;
+
+        HPX_ASSERT(count != 0);
+
+        T val = conv(first, rest...);
+        detail::vector_pack_advance(1, first, rest...);
+
+        std::size_t prologue = detail::vector_pack_prologue(first, --count);
+        for (count -= prologue; prologue != 0; --prologue)
+        {
+            val = r(val, conv(first, rest...));
+            detail::vector_pack_advance(1, first, rest...);
+        }
+
+        if (count >= 2 * size)
+        {
+            T partial[size];
+            for (std::size_t i = 0; i != size; ++i)
+                partial[i] = conv(first + i, (rest + i)...);
+
+            detail::vector_pack_advance(size, first, rest...);
+            count -= size;
+
+            for (/**/; count >= size; count -= size)
+            {
+                HPX_PARALLEL_VECTOR_LOOP
+                for (std::size_t i = 0; i != size; ++i)
+                {
+                    partial[i] =
+                        r(partial[i], conv(first + i, (rest + i)...));
+                }
+                detail::vector_pack_advance(size, first, rest...);
+            }
+
+            for (std::size_t i = 0; i != size; ++i)
+                val = r(val, partial[i]);
+        }
+
+        for (/**/; count != 0; --count)
+        {
+            val = r(val, conv(first, rest...));
+            detail::vector_pack_advance(1, first, rest...);
+        }
+        return val;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        template <typename F>
+        struct vector_pack_dereference
+        {
+            F& f_;
+
+            template <typename T>
+            HPX_FORCEINLINE void operator()(T* p) const
+            {
+                f_(*p);
+            }
+        };
+
+        template <typename F>
+        struct vector_pack_zip_dereference
+        {
+            F& f_;
+
+            template <typename ... Ts>
+            HPX_FORCEINLINE void operator()(Ts*... ps) const
+            {
+                f_(hpx::util::forward_as_tuple(*ps...));
+            }
+        };
+
+        template <typename F, typename Tuple, std::size_t ... Is>
+        HPX_FORCEINLINE void
+        vector_pack_zip_loop_n(Tuple const& iters, std::size_t count, F& f,
+            hpx::util::detail::pack_c<std::size_t, Is...>)
+        {
+            util::vector_pack_loop_n(count,
+                vector_pack_zip_dereference<F>{f},
+                util::get_pointer(hpx::util::get<Is>(iters))...);
+        }
+    }
+
+    // Invoke f(*(first + i)) for all i in [0, count), count must not be
+    // zero. For zipped ranges the function is invoked with a tuple of
+    // references to the elements, just like a zip_iterator would.
+    template <typename Iter, typename F>
+    HPX_FORCEINLINE void
+    vector_pack_for_each_n(Iter first, std::size_t count, F && f)
+    {
+        HPX_ASSERT(count != 0);
+        util::vector_pack_loop_n(count,
+            detail::vector_pack_dereference<F>{f}, util::get_pointer(first));
+    }
+
+    template <typename ... Iters, typename F>
+    HPX_FORCEINLINE void
+    vector_pack_for_each_n(hpx::util::zip_iterator<Iters...> first,
+        std::size_t count, F && f)
+    {
+        HPX_ASSERT(count != 0);
+        detail::vector_pack_zip_loop_n(first.get_iterator_tuple(), count, f,
+            typename hpx::util::detail::make_index_pack<
+                sizeof...(Iters)
+            >::type());
+    }
+}}}
+
+#endif
@@ -0,0 +1,53 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file sample_source.hpp
+
+#if !defined(HPX_PERFORMANCE_COUNTERS_SAMPLE_SOURCE_OCT_18_2016_0535PM)
+#define HPX_PERFORMANCE_COUNTERS_SAMPLE_SOURCE_OCT_18_2016_0535PM
+
+#include <hpx/config.hpp>
+#include <hpx/performance_counters/counters.hpp>
+#include <hpx/util/sharded_histogram.hpp>
+
+#include <string>
+
+namespace hpx { namespace performance_counters
+{
+    /// \brief Install a new counter type exposing the samples recorded by
+    ///        instrumentation code into the given histogram.
+    ///
+    /// The function \a install_sample_source registers a new counter type
+    /// with one instance per locality (see \a install_counter_type), its
+    /// value is the number of samples recorded since the last reset. The
+    /// statistics counters computing percentiles, histograms, or rates
+    /// (\c '/statistics{<base_counter_name>}/p99', etc.) which refer to an
+    /// instance of this type on the same locality use the recorded samples
+    /// directly instead of querying their base counter periodically.
+    ///
+    /// The counter type is automatically unregistered during system
+    /// shutdown, the histogram has to outlive the runtime.
+    ///
+    /// \param name   [in] The global virtual name of the counter type. This
+    ///               name is expected to have the format /objectname/countername.
+    /// \param samples [in] The histogram the samples are recorded into.
+    /// \param helptext [in, optional] A longer descriptive text shown to the
+    ///               user to explain the nature of the counters created from
+    ///               this type.
+    /// \param uom    [in] The unit of measure of the recorded samples.
+    /// \param ec     [in,out] this represents the error status on exit,
+    ///               if this is pre-initialized to \a hpx#throws
+    ///               the function will throw on error instead.
+    HPX_EXPORT counter_status install_sample_source(std::string const& name,
+        util::sharded_histogram& samples, std::string const& helptext = "",
+        std::string const& uom = "", error_code& ec = throws);
+
+    /// \brief Return the histogram of the sample source installed on this
+    ///        locality for the given counter type name, or nullptr.
+    HPX_EXPORT util::sharded_histogram* find_sample_source(
+        std::string const& type_name);
+}}
+
+#endif
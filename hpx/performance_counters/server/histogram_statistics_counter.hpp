@@ -0,0 +1,144 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PERFORMANCE_COUNTERS_SERVER_HISTOGRAM_STATISTICS_OCT_18_2016)
+#define HPX_PERFORMANCE_COUNTERS_SERVER_HISTOGRAM_STATISTICS_OCT_18_2016
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/performance_counters/server/base_performance_counter.hpp>
+#include <hpx/runtime/components/server/component_base.hpp>
+#include <hpx/runtime/naming/id_type.hpp>
+#include <hpx/util/interval_timer.hpp>
+#include <hpx/util/sharded_histogram.hpp>
+
+#include <boost/cstdint.hpp>
+
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace performance_counters { namespace server
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // This counter exposes a percentile, a histogram, or the exponentially
+    // weighted rate of change of the values of its base counter. If the base
+    // counter is a sample source on this locality (see install_sample_source)
+    // the samples recorded by the instrumented code are used directly,
+    // otherwise the base counter is queried once per base time interval.
+    class HPX_EXPORT histogram_statistics_counter
+      : public base_performance_counter,
+        public components::component_base<histogram_statistics_counter>
+    {
+        typedef components::component_base<
+            histogram_statistics_counter> base_type;
+
+        // avoid warnings about using this in member initializer list
+        histogram_statistics_counter* this_() { return this; }
+
+    public:
+        typedef histogram_statistics_counter type_holder;
+        typedef base_performance_counter base_type_holder;
+
+        enum statistic_type
+        {
+            statistic_percentile,
+            statistic_histogram,
+            statistic_ewma_rate
+        };
+
+        histogram_statistics_counter()
+          : statistic_(statistic_percentile), quantile_(0), samples_(nullptr),
+            min_boundary_(0), max_boundary_(0), num_buckets_(0),
+            half_life_(0), rate_(0), last_value_(0), last_time_(0),
+            has_rate_(false), has_last_value_(false)
+        {}
+
+        // The parameters are: the base time interval [ms] followed by the
+        // lower and upper boundary and the number of buckets for
+        // statistic_histogram, or the half-life [ms] for statistic_ewma_rate.
+        histogram_statistics_counter(counter_info const& info,
+            std::string const& base_counter_name, statistic_type statistic,
+            double quantile, std::vector<boost::int64_t> const& parameters);
+
+        /// Overloads from the base_counter base class.
+        hpx::performance_counters::counter_value
+            get_counter_value(bool reset = false);
+
+        hpx::performance_counters::counter_values_array
+            get_counter_values_array(bool reset = false);
+
+        bool start();
+
+        bool stop();
+
+        void reset_counter_value();
+
+        void on_terminate() {}
+
+        /// \brief finalize() will be called just before the instance gets
+        ///        destructed
+        void finalize()
+        {
+            base_performance_counter::finalize();
+            base_type::finalize();
+        }
+
+        static components::component_type get_component_type()
+        {
+            return base_type::get_component_type();
+        }
+        static void set_component_type(components::component_type t)
+        {
+            base_type::set_component_type(t);
+        }
+
+    protected:
+        bool evaluate_base_counter(counter_value& value);
+        bool evaluate();
+        bool ensure_base_counter();
+
+        // retrieve the bucket counts collected since the last reset
+        void get_counts(std::vector<boost::uint64_t>& counts, bool reset);
+        void add_value(counter_value const& base_value);
+        void update_rate(boost::int64_t value, boost::int64_t now);
+
+        // the base counter needs to be queried periodically
+        bool is_polling() const
+        {
+            return samples_ == &own_samples_ ||
+                statistic_ == statistic_ewma_rate;
+        }
+
+    private:
+        typedef lcos::local::spinlock mutex_type;
+        mutable mutex_type mtx_;
+
+        hpx::util::interval_timer timer_; ///< base time interval [ms]
+        std::string base_counter_name_;   ///< name of base counter
+        naming::id_type base_counter_id_;
+
+        statistic_type statistic_;
+        double quantile_;
+
+        // the samples are recorded either by the sample source or by
+        // evaluate(), the counts at the last reset are subtracted
+        util::sharded_histogram own_samples_;
+        util::sharded_histogram* samples_;
+        std::vector<boost::uint64_t> reset_counts_;
+
+        boost::int64_t min_boundary_, max_boundary_, num_buckets_;
+
+        // exponentially weighted rate of change (per second)
+        double half_life_;                // [ns]
+        double rate_;
+        boost::int64_t last_value_;
+        boost::int64_t last_time_;        // [ns]
+        bool has_rate_;
+        bool has_last_value_;
+    };
+}}}
+
+#endif
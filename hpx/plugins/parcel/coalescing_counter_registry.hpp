@@ -10,6 +10,7 @@
 
 #if defined(HPX_HAVE_PARCEL_COALESCING)
 
+#include <hpx/lcos/local/spinlock.hpp>
 #include <hpx/performance_counters/counters.hpp>
 #include <hpx/util/jenkins_hash.hpp>
 #include <hpx/util/function.hpp>
@@ -41,13 +42,24 @@ namespace hpx { namespace plugins { namespace parcel
                     get_counter_values_type&)
             > get_counter_values_creator_type;
 
-        struct counter_functions
+        // There is one message handler per action and destination, each of
+        // them registers its own set of counter functions.
+        struct handler_functions
         {
             get_counter_type num_parcels;
             get_counter_type num_messages;
-            get_counter_type num_parcels_per_message;
+            get_counter_type parcels_per_message_parcels;
+            get_counter_type parcels_per_message_messages;
             get_counter_type average_time_between_parcels;
             get_counter_values_creator_type time_between_parcels_histogram_creator;
+            get_counter_values_type time_between_parcels_histogram;
+            get_counter_type batch_size;
+            get_counter_type flush_interval;
+        };
+
+        struct counter_functions
+        {
+            std::vector<handler_functions> handlers;
             boost::int64_t min_boundary, max_boundary, num_buckets;
         };
 
@@ -61,9 +73,11 @@ namespace hpx { namespace plugins { namespace parcel
 
         void register_action(std::string const& name,
             get_counter_type num_parcels, get_counter_type num_messages,
-            get_counter_type time_between_parcels,
+            get_counter_type parcels_per_message_parcels,
+            get_counter_type parcels_per_message_messages,
             get_counter_type average_time_between_parcels,
-            get_counter_values_creator_type time_between_parcels_histogram_creator);
+            get_counter_values_creator_type time_between_parcels_histogram_creator,
+            get_counter_type batch_size, get_counter_type flush_interval);
 
         get_counter_type get_parcels_counter(std::string const& name) const;
         get_counter_type get_messages_counter(std::string const& name) const;
@@ -71,6 +85,9 @@ namespace hpx { namespace plugins { namespace parcel
             std::string const& name) const;
         get_counter_type get_average_time_between_parcels_counter(
             std::string const& name) const;
+        get_counter_type get_batch_size_counter(std::string const& name) const;
+        get_counter_type get_flush_interval_counter(
+            std::string const& name) const;
         get_counter_values_type get_time_between_parcels_histogram_counter(
             std::string const& name, boost::int64_t min_boundary,
             boost::int64_t max_boundary, boost::int64_t num_buckets);
@@ -88,12 +105,33 @@ namespace hpx { namespace plugins { namespace parcel
         }
 
     private:
+        typedef lcos::local::spinlock mutex_type;
+
+        std::vector<handler_functions> get_handlers(
+            std::string const& name, char const* func) const;
+
+        // counts are summed over all destinations, parcels per message are
+        // the ratio of the summed counts, all other values are averaged
+        // weighted by the traffic to each destination
+        boost::int64_t sum_counters(std::string const& name,
+            get_counter_type handler_functions::* counter, bool reset) const;
+        boost::int64_t ratio_counters(std::string const& name,
+            get_counter_type handler_functions::* numerator,
+            get_counter_type handler_functions::* denominator,
+            bool reset) const;
+        boost::int64_t weighted_average_counters(std::string const& name,
+            get_counter_type handler_functions::* counter,
+            get_counter_type handler_functions::* weight, bool reset) const;
+        std::vector<boost::int64_t> average_histograms(
+            std::string const& name, bool reset) const;
+
         struct tag {};
 
         friend struct hpx::util::static_<
                 coalescing_counter_registry, tag
             >;
 
+        mutable mutex_type mtx_;
         map_type map_;
     };
 }}}
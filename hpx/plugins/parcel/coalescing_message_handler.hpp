@@ -56,8 +56,11 @@ namespace hpx { namespace plugins { namespace parcel
         // access performance counter data
         boost::int64_t get_parcels_count(bool reset);
         boost::int64_t get_messages_count(bool reset);
-        boost::int64_t get_parcels_per_message_count(bool reset);
+        boost::int64_t get_parcels_per_message_parcels(bool reset);
+        boost::int64_t get_parcels_per_message_messages(bool reset);
         boost::int64_t get_average_time_between_parcels(bool reset);
+        boost::int64_t get_batch_size(bool reset);
+        boost::int64_t get_flush_interval(bool reset);
         std::vector<boost::int64_t>
             get_time_between_parcels_histogram(bool reset);
         void get_time_between_parcels_histogram_creator(
@@ -73,6 +76,7 @@ namespace hpx { namespace plugins { namespace parcel
         bool flush_locked(std::unique_lock<mutex_type>& l,
             parcelset::policies::message_handler::flush_mode mode,
             bool stop_buffering);
+        void update_parameters_locked();
 
     private:
         mutable mutex_type mtx_;
@@ -83,6 +87,17 @@ namespace hpx { namespace plugins { namespace parcel
         bool allow_background_flush_;
         std::string action_name_;
 
+        // Each instance handles the parcels for one action and one
+        // destination. In adaptive mode the number of parcels to coalesce
+        // and the flush interval are adjusted after each message based on
+        // the (exponentially weighted) average time between parcels.
+        bool adaptive_;
+        std::size_t max_batch_size_;
+        std::size_t latency_target_;                // [us]
+        std::size_t batch_size_;
+        std::size_t interval_;                      // [us]
+        double average_time_between_parcels_;       // [ns]
+
         // performance counter data
         boost::int64_t num_parcels_;
         boost::int64_t reset_num_parcels_;
@@ -60,6 +60,7 @@ namespace hpx { namespace parcelset { namespace policies { namespace mpi
             data.time_ = timer_.elapsed_nanoseconds();
             data.bytes_ = static_cast<std::size_t>(header_.numbytes());
 
+            buffer_.reserve_data(static_cast<std::size_t>(header_.size()));
             buffer_.data_.resize(static_cast<std::size_t>(header_.size()));
             buffer_.num_chunks_ = header_.num_chunks();
         }
@@ -93,6 +94,9 @@ namespace hpx { namespace parcelset { namespace policies { namespace mpi
             std::size_t num_non_zero_copy_chunks =
                 static_cast<std::size_t>(
                     static_cast<boost::uint32_t>(buffer_.num_chunks_.second));
+            buffer_.reserve_transmission_chunks(
+                num_zero_copy_chunks + num_non_zero_copy_chunks
+            );
             buffer_.transmission_chunks_.resize(
                 num_zero_copy_chunks + num_non_zero_copy_chunks
             );
@@ -262,7 +262,7 @@ namespace hpx { namespace parcelset { namespace policies { namespace mpi
             buffer_.data_point_.time_ =
                 util::high_resolution_clock::now() - buffer_.data_point_.time_;
             parcels_sent_.add_data(buffer_.data_point_);
-            buffer_.clear();
+            buffer_.recycle();
 
             return true;
         }
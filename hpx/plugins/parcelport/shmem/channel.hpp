@@ -0,0 +1,370 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_POLICIES_SHMEM_CHANNEL_HPP
+#define HPX_PARCELSET_POLICIES_SHMEM_CHANNEL_HPP
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_PARCELPORT_SHMEM)
+
+#include <hpx/plugins/parcelport/shmem/segment.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string>
+
+namespace hpx { namespace parcelset { namespace policies { namespace shmem
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // A channel connects exactly one sending locality with exactly one
+    // receiving locality. It lives in a shared memory segment created by the
+    // sender and consists of
+    //
+    //  - a single-producer/single-consumer byte ring through which all
+    //    messages are streamed, and
+    //  - a slab of fixed size blocks. The sender copies large zero-copy
+    //    chunks into the slab and passes the location of the blocks through
+    //    the ring. The receiver hands the blocks out to the deserialized
+    //    objects without copying them again and releases them once the
+    //    last reference to the data goes away.
+    //
+    // Only the sender moves the tail of the ring and allocates blocks, only
+    // the receiver moves the head of the ring and frees blocks. This is why
+    // neither side needs any locks.
+    class channel : public std::enable_shared_from_this<channel>
+    {
+    private:
+        HPX_NON_COPYABLE(channel);
+
+        enum { cache_line_size = 64 };
+
+        enum block_state
+        {
+            block_free = 0,
+            block_used = 1
+        };
+
+        struct control_block
+        {
+            boost::atomic<boost::uint64_t> tail_;
+            char pad0_[cache_line_size -
+                sizeof(boost::atomic<boost::uint64_t>)];
+            boost::atomic<boost::uint64_t> head_;
+            char pad1_[cache_line_size -
+                sizeof(boost::atomic<boost::uint64_t>)];
+
+            // immutable after creation
+            boost::uint64_t ring_size_;
+            boost::uint64_t block_size_;
+            boost::uint64_t num_blocks_;
+        };
+
+        typedef boost::atomic<boost::uint32_t> block_state_type;
+
+        static std::size_t align(std::size_t size, std::size_t alignment)
+        {
+            return (size + alignment - 1) & ~(alignment - 1);
+        }
+
+        static std::size_t blocks_offset()
+        {
+            return align(sizeof(control_block), cache_line_size);
+        }
+
+        static std::size_t ring_offset(std::size_t num_blocks)
+        {
+            return align(blocks_offset() +
+                num_blocks * sizeof(block_state_type), 4096);
+        }
+
+        static std::size_t slab_offset(std::size_t ring_size,
+            std::size_t num_blocks)
+        {
+            return ring_offset(num_blocks) + ring_size;
+        }
+
+    public:
+        // sentinel marking chunks which are not stored in the slab
+        static boost::uint64_t const no_block = boost::uint64_t(-1);
+
+        channel()
+          : control_(nullptr), blocks_(nullptr), ring_(nullptr), slab_(nullptr)
+          , ring_mask_(0), cached_head_(0), cached_tail_(0), next_block_(0)
+          , busy_(false)
+        {}
+
+        // Create the channel (sender side), the ring size has to be a power
+        // of two.
+        void create(std::string const& name, std::size_t ring_size,
+            std::size_t block_size, std::size_t num_blocks)
+        {
+            HPX_ASSERT(ring_size != 0 && (ring_size & (ring_size - 1)) == 0);
+
+            boost::atomic<boost::uint64_t> test;
+            if (!test.is_lock_free())
+            {
+                HPX_THROW_EXCEPTION(network_error, "shmem::channel::create",
+                    "the shmem parcelport requires lock-free 64 bit atomics");
+            }
+
+            segment_.create(name,
+                slab_offset(ring_size, num_blocks) + block_size * num_blocks);
+
+            control_block* c = new (segment_.data()) control_block;
+            c->tail_.store(0, boost::memory_order_relaxed);
+            c->head_.store(0, boost::memory_order_relaxed);
+            c->ring_size_ = ring_size;
+            c->block_size_ = block_size;
+            c->num_blocks_ = num_blocks;
+
+            char* blocks = segment_.data() + blocks_offset();
+            for (std::size_t i = 0; i != num_blocks; ++i)
+            {
+                new (blocks + i * sizeof(block_state_type))
+                    block_state_type(block_free);
+            }
+
+            attach();
+        }
+
+        // Map a channel created by the sending locality (receiver side).
+        bool open(std::string const& name)
+        {
+            if (!segment_.open(name))
+                return false;
+
+            attach();
+            return true;
+        }
+
+        std::string const& name() const
+        {
+            return segment_.name();
+        }
+
+        // The ring is written (or read) by one connection at a time, a
+        // connection owns the ring from the first to the last byte of a
+        // message. A message may be completed by a different thread than
+        // the one which started it.
+        bool try_acquire()
+        {
+            return !busy_.load(boost::memory_order_relaxed) &&
+                !busy_.exchange(true, boost::memory_order_acquire);
+        }
+
+        void release()
+        {
+            busy_.store(false, boost::memory_order_release);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // sender side
+
+        // Write as many bytes as currently fit into the ring, return the
+        // number of bytes written.
+        std::size_t write(char const* data, std::size_t size)
+        {
+            boost::uint64_t tail = cached_tail_;
+            std::size_t space = ring_size() - std::size_t(tail - cached_head_);
+            if (space < size)
+            {
+                cached_head_ =
+                    control_->head_.load(boost::memory_order_acquire);
+                space = ring_size() - std::size_t(tail - cached_head_);
+            }
+
+            std::size_t count = (std::min)(size, space);
+            if (count == 0)
+                return 0;
+
+            std::size_t pos = std::size_t(tail) & ring_mask_;
+            std::size_t first = (std::min)(count, ring_size() - pos);
+            std::memcpy(ring_ + pos, data, first);
+            std::memcpy(ring_, data + first, count - first);
+
+            cached_tail_ = tail + count;
+            control_->tail_.store(cached_tail_, boost::memory_order_release);
+            return count;
+        }
+
+        // Reserve consecutive blocks of the slab large enough to hold the
+        // given number of bytes, returns no_block if the slab is exhausted.
+        boost::uint64_t allocate_blocks(std::size_t size)
+        {
+            std::size_t const num_blocks = num_blocks_for(size);
+            std::size_t const total = std::size_t(control_->num_blocks_);
+            if (num_blocks == 0 || num_blocks > total)
+                return no_block;
+
+            // first fit, starting at the block following the most recent
+            // allocation
+            std::size_t start = next_block_;
+            for (std::size_t tried = 0; tried < total; /**/)
+            {
+                if (start + num_blocks > total)
+                {
+                    tried += total - start;
+                    start = 0;
+                    continue;
+                }
+
+                std::size_t i = 0;
+                while (i != num_blocks &&
+                    block(start + i).load(boost::memory_order_acquire) ==
+                        block_free)
+                {
+                    ++i;
+                }
+
+                if (i == num_blocks)
+                {
+                    // the receiver never touches free blocks, no need for
+                    // an atomic read-modify-write
+                    for (i = 0; i != num_blocks; ++i)
+                    {
+                        block(start + i).store(block_used,
+                            boost::memory_order_relaxed);
+                    }
+                    next_block_ = (start + num_blocks) % total;
+                    return start;
+                }
+
+                tried += i + 1;
+                start += i + 1;
+                if (start >= total)
+                    start = 0;
+            }
+            return no_block;
+        }
+
+        char* block_data(boost::uint64_t first_block) const
+        {
+            return slab_ + std::size_t(first_block) *
+                std::size_t(control_->block_size_);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // receiver side
+
+        // Read as many bytes as are currently available (up to the given
+        // size), return the number of bytes read.
+        std::size_t read(char* data, std::size_t size)
+        {
+            boost::uint64_t head = cached_head_;
+            std::size_t available = std::size_t(cached_tail_ - head);
+            if (available < size)
+            {
+                cached_tail_ =
+                    control_->tail_.load(boost::memory_order_acquire);
+                available = std::size_t(cached_tail_ - head);
+            }
+
+            std::size_t count = (std::min)(size, available);
+            if (count == 0)
+                return 0;
+
+            std::size_t pos = std::size_t(head) & ring_mask_;
+            std::size_t first = (std::min)(count, ring_size() - pos);
+            std::memcpy(data, ring_ + pos, first);
+            std::memcpy(data + first, ring_, count - first);
+
+            cached_head_ = head + count;
+            control_->head_.store(cached_head_, boost::memory_order_release);
+            return count;
+        }
+
+        bool empty() const
+        {
+            return cached_head_ ==
+                control_->tail_.load(boost::memory_order_acquire);
+        }
+
+        // Take over the blocks of a chunk handed over by the sender. The
+        // blocks are given back to the sender once the last copy of the
+        // returned pointer goes out of scope, the pointer keeps the channel
+        // (and with it the mapping of the shared memory) alive.
+        std::shared_ptr<char> adopt_blocks(boost::uint64_t first_block,
+            std::size_t size)
+        {
+            std::shared_ptr<channel> self = shared_from_this();
+            std::size_t num_blocks = num_blocks_for(size);
+            return std::shared_ptr<char>(block_data(first_block),
+                [self, first_block, num_blocks](char*)
+                {
+                    self->free_blocks(first_block, num_blocks);
+                });
+        }
+
+    private:
+        void attach()
+        {
+            control_ = reinterpret_cast<control_block*>(segment_.data());
+            blocks_ = segment_.data() + blocks_offset();
+
+            std::size_t num_blocks = std::size_t(control_->num_blocks_);
+            std::size_t ring_size = std::size_t(control_->ring_size_);
+            ring_ = segment_.data() + ring_offset(num_blocks);
+            slab_ = segment_.data() + slab_offset(ring_size, num_blocks);
+            ring_mask_ = ring_size - 1;
+
+            cached_head_ = control_->head_.load(boost::memory_order_acquire);
+            cached_tail_ = control_->tail_.load(boost::memory_order_acquire);
+        }
+
+        std::size_t ring_size() const
+        {
+            return ring_mask_ + 1;
+        }
+
+        std::size_t num_blocks_for(std::size_t size) const
+        {
+            std::size_t block_size = std::size_t(control_->block_size_);
+            return (size + block_size - 1) / block_size;
+        }
+
+        block_state_type& block(std::size_t i) const
+        {
+            return *reinterpret_cast<block_state_type*>(
+                blocks_ + i * sizeof(block_state_type));
+        }
+
+        void free_blocks(boost::uint64_t first_block, std::size_t num_blocks)
+        {
+            for (std::size_t i = 0; i != num_blocks; ++i)
+            {
+                block(std::size_t(first_block) + i).store(block_free,
+                    boost::memory_order_release);
+            }
+        }
+
+        segment segment_;
+        control_block* control_;
+        char* blocks_;
+        char* ring_;
+        char* slab_;
+        std::size_t ring_mask_;
+
+        // local copies of the positions of the other side, refreshed only
+        // if the ring looks full (sender) or empty (receiver)
+        boost::uint64_t cached_head_;
+        boost::uint64_t cached_tail_;
+
+        std::size_t next_block_;
+        boost::atomic<bool> busy_;
+    };
+}}}}
+
+#endif
+
+#endif
@@ -0,0 +1,103 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_POLICIES_SHMEM_HEADER_HPP
+#define HPX_PARCELSET_POLICIES_SHMEM_HEADER_HPP
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_PARCELPORT_SHMEM)
+
+#include <hpx/plugins/parcelport/shmem/channel.hpp>
+
+#include <boost/cstdint.hpp>
+
+#include <cstddef>
+
+namespace hpx { namespace parcelset { namespace policies { namespace shmem
+{
+    // A message is streamed through the ring of a channel as
+    //
+    //  - the header,
+    //  - the transmission chunks (if there are any zero-copy chunks),
+    //  - the serialized data, and
+    //  - a chunk_header for every zero-copy chunk, followed by the contents
+    //    of the chunk unless it was handed over through the slab.
+    struct header
+    {
+        header()
+          : size_(0), numbytes_(0), num_chunks_first_(0)
+          , num_chunks_second_(0)
+        {}
+
+        template <typename Buffer>
+        explicit header(Buffer const& buffer)
+          : size_(buffer.size_)
+          , numbytes_(buffer.data_size_)
+          , num_chunks_first_(buffer.num_chunks_.first)
+          , num_chunks_second_(buffer.num_chunks_.second)
+        {}
+
+        std::size_t size() const
+        {
+            return static_cast<std::size_t>(size_);
+        }
+
+        std::size_t numbytes() const
+        {
+            return static_cast<std::size_t>(numbytes_);
+        }
+
+        boost::uint32_t num_chunks_first() const
+        {
+            return num_chunks_first_;
+        }
+
+        boost::uint32_t num_chunks_second() const
+        {
+            return num_chunks_second_;
+        }
+
+        char* data()
+        {
+            return reinterpret_cast<char*>(this);
+        }
+
+    private:
+        boost::uint64_t size_;
+        boost::uint64_t numbytes_;
+        boost::uint32_t num_chunks_first_;
+        boost::uint32_t num_chunks_second_;
+    };
+
+    struct chunk_header
+    {
+        explicit chunk_header(boost::uint64_t first_block = channel::no_block)
+          : first_block_(first_block)
+        {}
+
+        bool in_slab() const
+        {
+            return first_block_ != channel::no_block;
+        }
+
+        boost::uint64_t first_block() const
+        {
+            return first_block_;
+        }
+
+        char* data()
+        {
+            return reinterpret_cast<char*>(this);
+        }
+
+    private:
+        boost::uint64_t first_block_;
+    };
+}}}}
+
+#endif
+
+#endif
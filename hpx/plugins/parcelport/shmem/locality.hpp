@@ -0,0 +1,103 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_POLICIES_SHMEM_LOCALITY_HPP
+#define HPX_PARCELSET_POLICIES_SHMEM_LOCALITY_HPP
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_PARCELPORT_SHMEM)
+
+#include <hpx/runtime/parcelset/locality.hpp>
+#include <hpx/runtime/serialization/serialize.hpp>
+#include <hpx/runtime/serialization/string.hpp>
+
+#include <boost/cstdint.hpp>
+#include <boost/io/ios_state.hpp>
+
+#include <iosfwd>
+#include <string>
+
+namespace hpx { namespace parcelset
+{
+    namespace policies { namespace shmem
+    {
+        // A shmem locality is identified by the same address and port as the
+        // tcp locality of the same process. The address is used to decide
+        // whether two localities live on the same node, the pair of both
+        // names the shared memory segments used for communication.
+        class locality
+        {
+        public:
+            locality()
+              : port_(boost::uint16_t(-1))
+            {}
+
+            locality(std::string const& addr, boost::uint16_t port)
+              : address_(addr), port_(port)
+            {}
+
+            std::string const & address() const
+            {
+                return address_;
+            }
+
+            boost::uint16_t port() const
+            {
+                return port_;
+            }
+
+            static const char *type()
+            {
+                return "shmem";
+            }
+
+            explicit operator bool() const HPX_NOEXCEPT
+            {
+                return port_ != boost::uint16_t(-1);
+            }
+
+            void save(serialization::output_archive & ar) const
+            {
+                ar << address_;
+                ar << port_;
+            }
+
+            void load(serialization::input_archive & ar)
+            {
+                ar >> address_;
+                ar >> port_;
+            }
+
+        private:
+            friend bool operator==(locality const & lhs, locality const & rhs)
+            {
+                return lhs.address_ == rhs.address_ && lhs.port_ == rhs.port_;
+            }
+
+            friend bool operator<(locality const & lhs, locality const & rhs)
+            {
+                return lhs.address_ < rhs.address_ ||
+                    (lhs.address_ == rhs.address_ && lhs.port_ < rhs.port_);
+            }
+
+            friend std::ostream & operator<<(std::ostream & os,
+                locality const & loc)
+            {
+                boost::io::ios_flags_saver ifs(os);
+                os << loc.address_ << ":" << loc.port_;
+
+                return os;
+            }
+
+            std::string address_;
+            boost::uint16_t port_;
+        };
+    }}
+}}
+
+#endif
+
+#endif
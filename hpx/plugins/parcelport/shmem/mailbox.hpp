@@ -0,0 +1,174 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_POLICIES_SHMEM_MAILBOX_HPP
+#define HPX_PARCELSET_POLICIES_SHMEM_MAILBOX_HPP
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_PARCELPORT_SHMEM)
+
+#include <hpx/plugins/parcelport/shmem/locality.hpp>
+#include <hpx/plugins/parcelport/shmem/segment.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <string>
+
+namespace hpx { namespace parcelset { namespace policies { namespace shmem
+{
+    // Return the name of the mailbox of the given locality.
+    inline std::string mailbox_name(locality const& l)
+    {
+        return segment_name(l.address() + "." + std::to_string(l.port()));
+    }
+
+    // Return the name of the channel connecting the given localities.
+    inline std::string channel_name(locality const& src, locality const& dst)
+    {
+        return segment_name(src.address() + "." + std::to_string(src.port()) +
+            "-" + dst.address() + "." + std::to_string(dst.port()));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Every locality publishes a mailbox, a shared memory segment named after
+    // its address and port. A sending locality announces a newly created
+    // channel by writing the channel's name into a free slot of the mailbox
+    // of the receiving locality, which picks it up while polling for work.
+    class mailbox
+    {
+    private:
+        HPX_NON_COPYABLE(mailbox);
+
+        enum slot_state
+        {
+            slot_empty = 0,
+            slot_claimed = 1,
+            slot_ready = 2
+        };
+
+        enum { max_name_length = 124 };
+
+        struct slot
+        {
+            boost::atomic<boost::uint32_t> state_;
+            char name_[max_name_length];
+        };
+
+        // the number of channels announced so far, this allows to poll the
+        // mailbox without scanning all slots
+        struct control_block
+        {
+            boost::atomic<boost::uint64_t> posted_;
+            char pad_[sizeof(slot) - sizeof(boost::atomic<boost::uint64_t>)];
+        };
+
+    public:
+        enum { num_slots = 1024 };
+
+        mailbox()
+          : control_(nullptr), slots_(nullptr), seen_(0)
+        {}
+
+        // Create the mailbox of this locality.
+        void create(std::string const& name)
+        {
+            segment_.create(name,
+                sizeof(control_block) + num_slots * sizeof(slot));
+            attach();
+
+            new (&control_->posted_) boost::atomic<boost::uint64_t>(0);
+            for (std::size_t i = 0; i != num_slots; ++i)
+            {
+                new (&slots_[i].state_)
+                    boost::atomic<boost::uint32_t>(slot_empty);
+            }
+        }
+
+        // Map the mailbox of another locality.
+        bool open(std::string const& name)
+        {
+            if (!segment_.open(name))
+                return false;
+
+            attach();
+            return true;
+        }
+
+        void close()
+        {
+            segment_.close();
+            control_ = nullptr;
+            slots_ = nullptr;
+        }
+
+        // Announce a channel, returns false if all slots are taken.
+        bool post(std::string const& channel_name)
+        {
+            HPX_ASSERT(channel_name.size() < max_name_length);
+
+            for (std::size_t i = 0; i != num_slots; ++i)
+            {
+                boost::uint32_t expected = slot_empty;
+                if (slots_[i].state_.compare_exchange_strong(expected,
+                        slot_claimed, boost::memory_order_acquire))
+                {
+                    std::memcpy(slots_[i].name_, channel_name.c_str(),
+                        channel_name.size() + 1);
+                    slots_[i].state_.store(slot_ready,
+                        boost::memory_order_release);
+                    control_->posted_.fetch_add(1,
+                        boost::memory_order_release);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // Retrieve the name of the next announced channel, if any. The
+        // slot is available for reuse afterwards.
+        bool get(std::string& channel_name)
+        {
+            if (control_->posted_.load(boost::memory_order_acquire) == seen_)
+                return false;
+
+            for (std::size_t i = 0; i != num_slots; ++i)
+            {
+                if (slots_[i].state_.load(boost::memory_order_acquire) ==
+                    slot_ready)
+                {
+                    channel_name.assign(slots_[i].name_);
+                    slots_[i].state_.store(slot_empty,
+                        boost::memory_order_release);
+                    ++seen_;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+    private:
+        void attach()
+        {
+            control_ = reinterpret_cast<control_block*>(segment_.data());
+            slots_ = reinterpret_cast<slot*>(
+                segment_.data() + sizeof(control_block));
+        }
+
+        segment segment_;
+        control_block* control_;
+        slot* slots_;
+        boost::uint64_t seen_;  // number of channels retrieved (receiver)
+    };
+}}}}
+
+#endif
+
+#endif
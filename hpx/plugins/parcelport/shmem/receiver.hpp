@@ -0,0 +1,117 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_POLICIES_SHMEM_RECEIVER_HPP
+#define HPX_PARCELSET_POLICIES_SHMEM_RECEIVER_HPP
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_PARCELPORT_SHMEM)
+
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/plugins/parcelport/shmem/channel.hpp>
+#include <hpx/plugins/parcelport/shmem/locality.hpp>
+#include <hpx/plugins/parcelport/shmem/mailbox.hpp>
+#include <hpx/plugins/parcelport/shmem/receiver_connection.hpp>
+#include <hpx/throw_exception.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parcelset { namespace policies { namespace shmem
+{
+    template <typename Parcelport>
+    struct receiver
+    {
+        typedef hpx::lcos::local::spinlock mutex_type;
+        typedef
+            receiver_connection<Parcelport>
+            connection_type;
+        typedef std::shared_ptr<connection_type> connection_ptr;
+        typedef std::vector<connection_ptr> connection_list;
+
+        receiver(Parcelport & pp)
+          : pp_(pp)
+          , next_connection_(0)
+        {}
+
+        // Publish the mailbox of this locality, this allows other localities
+        // to announce their channels.
+        void run(locality const& here)
+        {
+            std::unique_lock<mutex_type> l(mailbox_mtx_);
+            mailbox_.create(mailbox_name(here));
+        }
+
+        void stop()
+        {
+            std::unique_lock<mutex_type> l(mailbox_mtx_);
+            mailbox_.close();
+        }
+
+        bool background_work(std::size_t num_thread)
+        {
+            accept();
+
+            // Every call handles one of the inbound channels, they are
+            // visited round robin.
+            connection_ptr rcv;
+            {
+                std::unique_lock<mutex_type> l(
+                    connections_mtx_, std::try_to_lock);
+                if(l && !connections_.empty())
+                {
+                    rcv = connections_[
+                        next_connection_++ % connections_.size()];
+                }
+            }
+
+            return rcv && rcv->receive(num_thread);
+        }
+
+    private:
+        // Map the channels newly announced by other localities.
+        void accept()
+        {
+            std::string name;
+            {
+                std::unique_lock<mutex_type> l(mailbox_mtx_, std::try_to_lock);
+                if(!l || !mailbox_.get(name))
+                    return;
+            }
+
+            std::shared_ptr<channel> ch = std::make_shared<channel>();
+            if(!ch->open(name))
+            {
+                HPX_THROW_EXCEPTION(network_error,
+                    "shmem::receiver::accept",
+                    "could not open the shared memory channel " + name);
+            }
+
+            connection_ptr rcv = std::make_shared<connection_type>(ch, pp_);
+            {
+                std::unique_lock<mutex_type> l(connections_mtx_);
+                connections_.push_back(std::move(rcv));
+            }
+        }
+
+        Parcelport & pp_;
+
+        mutex_type mailbox_mtx_;
+        mailbox mailbox_;
+
+        mutex_type connections_mtx_;
+        connection_list connections_;
+        std::size_t next_connection_;
+    };
+}}}}
+
+#endif
+
+#endif
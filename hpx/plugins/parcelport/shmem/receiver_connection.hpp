@@ -0,0 +1,257 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_POLICIES_SHMEM_RECEIVER_CONNECTION_HPP
+#define HPX_PARCELSET_POLICIES_SHMEM_RECEIVER_CONNECTION_HPP
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_PARCELPORT_SHMEM)
+
+#include <hpx/plugins/parcelport/shmem/channel.hpp>
+#include <hpx/plugins/parcelport/shmem/header.hpp>
+#include <hpx/runtime/parcelset/decode_parcels.hpp>
+#include <hpx/runtime/parcelset/detail/shared_chunk.hpp>
+#include <hpx/runtime/parcelset/parcel_buffer.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
+
+#include <boost/cstdint.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parcelset { namespace policies { namespace shmem
+{
+    // A receiver_connection reads the messages of one inbound channel, one
+    // after the other. The zero-copy chunks are received into reference
+    // counted memory, chunks handed over through the slab are not copied
+    // at all (see serialize_buffer::load).
+    template <typename Parcelport>
+    struct receiver_connection
+    {
+    private:
+        enum connection_state
+        {
+            initialized
+          , rcvd_header
+          , rcvd_transmission_chunks
+          , rcvd_data
+          , rcvd_chunks
+        };
+
+        typedef std::vector<char> data_type;
+        typedef parcelset::detail::shared_chunk chunk_type;
+        typedef parcel_buffer<data_type, chunk_type> buffer_type;
+
+    public:
+        receiver_connection(
+            std::shared_ptr<channel> const& ch
+          , Parcelport & pp
+        )
+          : state_(initialized)
+          , channel_(ch)
+          , pending_(nullptr)
+          , pending_size_(0)
+          , chunks_idx_(0)
+          , chunk_started_(false)
+          , pp_(pp)
+        {
+        }
+
+        // Make as much progress as possible without blocking, returns true
+        // if any data was received.
+        bool receive(std::size_t num_thread = -1)
+        {
+            // the messages of a channel are strictly sequential, only one
+            // thread at a time can make progress
+            if(!channel_->try_acquire()) return false;
+
+            bool has_work = !channel_->empty();
+            if(has_work)
+            {
+                switch (state_)
+                {
+                    case initialized:
+                        receive_header(num_thread);
+                        break;
+                    case rcvd_header:
+                        receive_transmission_chunks(num_thread);
+                        break;
+                    case rcvd_transmission_chunks:
+                        receive_data(num_thread);
+                        break;
+                    case rcvd_data:
+                        receive_chunks(num_thread);
+                        break;
+                    case rcvd_chunks:
+                        done(num_thread);
+                        break;
+                    default:
+                        HPX_ASSERT(false);
+                }
+            }
+
+            channel_->release();
+            return has_work;
+        }
+
+    private:
+        bool receive_header(std::size_t num_thread)
+        {
+            HPX_ASSERT(state_ == initialized);
+
+            buffer_.data_point_.time_ = timer_.elapsed_nanoseconds();
+            set_pending(header_.data(), sizeof(header));
+
+            state_ = rcvd_header;
+            return receive_transmission_chunks(num_thread);
+        }
+
+        bool receive_transmission_chunks(std::size_t num_thread)
+        {
+            HPX_ASSERT(state_ == rcvd_header);
+            if(!fill()) return false;
+
+            buffer_.data_point_.bytes_ = header_.numbytes();
+            buffer_.num_chunks_.first = header_.num_chunks_first();
+            buffer_.num_chunks_.second = header_.num_chunks_second();
+
+            // determine the size of the chunk buffer
+            std::size_t num_zero_copy_chunks = header_.num_chunks_first();
+            std::size_t num_non_zero_copy_chunks =
+                header_.num_chunks_second();
+            if(num_zero_copy_chunks != 0)
+            {
+                buffer_.reserve_transmission_chunks(
+                    num_zero_copy_chunks + num_non_zero_copy_chunks);
+                buffer_.transmission_chunks_.resize(
+                    num_zero_copy_chunks + num_non_zero_copy_chunks);
+                buffer_.chunks_.resize(num_zero_copy_chunks);
+
+                set_pending(
+                    reinterpret_cast<char*>(
+                        buffer_.transmission_chunks_.data()),
+                    buffer_.transmission_chunks_.size() *
+                        sizeof(buffer_type::transmission_chunk_type));
+            }
+
+            state_ = rcvd_transmission_chunks;
+            return receive_data(num_thread);
+        }
+
+        bool receive_data(std::size_t num_thread)
+        {
+            HPX_ASSERT(state_ == rcvd_transmission_chunks);
+            if(!fill()) return false;
+
+            buffer_.reserve_data(header_.size());
+            buffer_.data_.resize(header_.size());
+            set_pending(buffer_.data_.data(), buffer_.data_.size());
+
+            state_ = rcvd_data;
+            return receive_chunks(num_thread);
+        }
+
+        bool receive_chunks(std::size_t num_thread)
+        {
+            HPX_ASSERT(state_ == rcvd_data);
+
+            while(chunks_idx_ < buffer_.chunks_.size())
+            {
+                if(!fill()) return false;
+
+                if(!chunk_started_)
+                {
+                    set_pending(chunk_header_.data(), sizeof(chunk_header));
+                    chunk_started_ = true;
+                    continue;
+                }
+
+                std::size_t chunk_size = static_cast<std::size_t>(
+                    buffer_.transmission_chunks_[chunks_idx_].second);
+                chunk_type& c = buffer_.chunks_[chunks_idx_];
+                if(chunk_header_.in_slab())
+                {
+                    // take over the data handed over by the sender
+                    c = chunk_type(channel_->adopt_blocks(
+                        chunk_header_.first_block(), chunk_size), chunk_size);
+                }
+                else
+                {
+                    c.resize(chunk_size);
+                    set_pending(c.data(), chunk_size);
+                }
+                chunk_started_ = false;
+                ++chunks_idx_;
+            }
+
+            if(!fill()) return false;
+
+            state_ = rcvd_chunks;
+            return done(num_thread);
+        }
+
+        bool done(std::size_t num_thread)
+        {
+            HPX_ASSERT(state_ == rcvd_chunks);
+
+            performance_counters::parcels::data_point& data =
+                buffer_.data_point_;
+            data.time_ = timer_.elapsed_nanoseconds() - data.time_;
+
+            decode_parcels(pp_, std::move(buffer_), num_thread);
+
+            buffer_ = buffer_type();
+            chunks_idx_ = 0;
+            state_ = initialized;
+            return true;
+        }
+
+        void set_pending(char* data, std::size_t size)
+        {
+            HPX_ASSERT(pending_size_ == 0);
+            pending_ = data;
+            pending_size_ = size;
+        }
+
+        // read the pending bytes from the ring, returns false if the ring
+        // does not hold enough data
+        bool fill()
+        {
+            while(pending_size_ != 0)
+            {
+                std::size_t read = channel_->read(pending_, pending_size_);
+                if(read == 0) return false;
+
+                pending_ += read;
+                pending_size_ -= read;
+            }
+            return true;
+        }
+
+        util::high_resolution_timer timer_;
+
+        connection_state state_;
+        std::shared_ptr<channel> channel_;
+
+        header header_;
+        chunk_header chunk_header_;
+        buffer_type buffer_;
+
+        char* pending_;
+        std::size_t pending_size_;
+        std::size_t chunks_idx_;
+        bool chunk_started_;
+
+        Parcelport & pp_;
+    };
+}}}}
+
+#endif
+
+#endif
@@ -0,0 +1,170 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_POLICIES_SHMEM_SEGMENT_HPP
+#define HPX_PARCELSET_POLICIES_SHMEM_SEGMENT_HPP
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_PARCELPORT_SHMEM)
+
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <utility>
+
+namespace hpx { namespace parcelset { namespace policies { namespace shmem
+{
+    // Return a valid name for a POSIX shared memory object which is derived
+    // from the given (locality) names.
+    inline std::string segment_name(std::string const& name)
+    {
+        std::string result("/hpx.shmem.");
+        for (char c : name)
+            result.push_back(c == '/' ? '_' : c);
+        return result;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // A segment is a POSIX shared memory object mapped into the address space
+    // of this process. The process creating the segment owns its name and
+    // removes it when the segment is closed, the mapping stays valid in all
+    // processes which have opened the segment before.
+    class segment
+    {
+    private:
+        HPX_NON_COPYABLE(segment);
+
+    public:
+        segment()
+          : data_(nullptr), size_(0), owner_(false)
+        {}
+
+        ~segment()
+        {
+            close();
+        }
+
+        // Create a new segment of the given size, an existing segment of the
+        // same name (left behind by a previous run) is replaced.
+        void create(std::string const& name, std::size_t size)
+        {
+            HPX_ASSERT(data_ == nullptr);
+
+            int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+            if (fd == -1 && errno == EEXIST)
+            {
+                ::shm_unlink(name.c_str());
+                fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+            }
+            if (fd == -1)
+            {
+                HPX_THROW_EXCEPTION(network_error, "shmem::segment::create",
+                    "shm_open failed for " + name + ": " +
+                    std::strerror(errno));
+            }
+
+            if (::ftruncate(fd, static_cast<off_t>(size)) == -1)
+            {
+                int err = errno;
+                ::close(fd);
+                ::shm_unlink(name.c_str());
+                HPX_THROW_EXCEPTION(network_error, "shmem::segment::create",
+                    "ftruncate failed for " + name + ": " +
+                    std::strerror(err));
+            }
+
+            if (!map(fd, size))
+            {
+                int err = errno;
+                ::shm_unlink(name.c_str());
+                HPX_THROW_EXCEPTION(network_error, "shmem::segment::create",
+                    "mmap failed for " + name + ": " + std::strerror(err));
+            }
+
+            name_ = name;
+            owner_ = true;
+        }
+
+        // Map an existing segment, returns false if no segment of the given
+        // name exists (yet).
+        bool open(std::string const& name)
+        {
+            HPX_ASSERT(data_ == nullptr);
+
+            int fd = ::shm_open(name.c_str(), O_RDWR, 0600);
+            if (fd == -1)
+                return false;
+
+            struct stat st;
+            if (::fstat(fd, &st) == -1 || st.st_size == 0)
+            {
+                ::close(fd);
+                return false;
+            }
+
+            if (!map(fd, static_cast<std::size_t>(st.st_size)))
+                return false;
+
+            name_ = name;
+            owner_ = false;
+            return true;
+        }
+
+        void close()
+        {
+            if (data_ != nullptr)
+            {
+                ::munmap(data_, size_);
+                data_ = nullptr;
+                size_ = 0;
+            }
+            if (owner_)
+            {
+                ::shm_unlink(name_.c_str());
+                owner_ = false;
+            }
+        }
+
+        char* data() const { return data_; }
+        std::size_t size() const { return size_; }
+        std::string const& name() const { return name_; }
+
+    private:
+        bool map(int fd, std::size_t size)
+        {
+            void* p = ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                MAP_SHARED, fd, 0);
+            int err = errno;
+            ::close(fd);
+            errno = err;
+
+            if (p == MAP_FAILED)
+                return false;
+
+            data_ = static_cast<char*>(p);
+            size_ = size;
+            return true;
+        }
+
+        char* data_;
+        std::size_t size_;
+        std::string name_;
+        bool owner_;
+    };
+}}}}
+
+#endif
+
+#endif
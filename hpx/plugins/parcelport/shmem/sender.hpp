@@ -0,0 +1,278 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_POLICIES_SHMEM_SENDER_HPP
+#define HPX_PARCELSET_POLICIES_SHMEM_SENDER_HPP
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_PARCELPORT_SHMEM)
+
+#include <hpx/error_code.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/runtime/threads/thread_helpers.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/detail/yield_k.hpp>
+
+#include <hpx/plugins/parcelport/shmem/channel.hpp>
+#include <hpx/plugins/parcelport/shmem/locality.hpp>
+#include <hpx/plugins/parcelport/shmem/mailbox.hpp>
+#include <hpx/plugins/parcelport/shmem/segment.hpp>
+#include <hpx/plugins/parcelport/shmem/sender_connection.hpp>
+
+#include <boost/atomic.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
+namespace hpx { namespace parcelset { namespace policies { namespace shmem
+{
+    struct sender
+    {
+        typedef
+            sender_connection
+            connection_type;
+        typedef std::shared_ptr<connection_type> connection_ptr;
+        typedef std::deque<connection_ptr> connection_list;
+
+        typedef hpx::lcos::local::spinlock mutex_type;
+
+        struct channel_settings
+        {
+            std::size_t ring_size_;
+            std::size_t block_size_;
+            std::size_t num_blocks_;
+            std::size_t slab_threshold_;
+        };
+
+    private:
+        // There is exactly one channel per destination, it is created by the
+        // first connection to the destination.
+        struct outbound_channel
+        {
+            enum state
+            {
+                connecting, connected, failed
+            };
+
+            outbound_channel()
+              : state_(connecting)
+              , channel_(std::make_shared<channel>())
+            {}
+
+            boost::atomic<int> state_;
+            std::shared_ptr<channel> channel_;
+        };
+
+        typedef std::map<locality, std::shared_ptr<outbound_channel> >
+            channel_map;
+
+    public:
+        sender(locality const& here, channel_settings const& settings)
+          : here_(here)
+          , settings_(settings)
+        {
+        }
+
+        connection_ptr create_connection(parcelset::locality const& there,
+            performance_counters::parcels::gatherer & parcels_sent,
+            error_code& ec)
+        {
+            std::shared_ptr<channel> ch = get_channel(there, ec);
+            if (!ch)
+                return connection_ptr();
+
+            return
+                std::make_shared<connection_type>(
+                    this, ch, there, settings_.slab_threshold_, parcels_sent);
+        }
+
+        void add(connection_ptr const & ptr)
+        {
+            std::unique_lock<mutex_type> l(connections_mtx_);
+            connections_.push_back(ptr);
+        }
+
+        void send_messages(
+            connection_list connections
+        )
+        {
+            // We try to handle all sends
+            connection_list::iterator end = std::remove_if(
+                connections.begin()
+              , connections.end()
+              , [](connection_ptr sender) -> bool
+              {
+                    if(sender->send())
+                    {
+                        error_code ec;
+                        sender->postprocess_handler_(
+                            ec, sender->destination(), sender);
+                        return true;
+                    }
+                    return false;
+              }
+            );
+
+            // If some are still in progress, give them back
+            if(connections.begin() != end)
+            {
+                std::unique_lock<mutex_type> l(connections_mtx_);
+                connections_.insert(
+                    connections_.end()
+                  , std::make_move_iterator(connections.begin())
+                  , std::make_move_iterator(end)
+                );
+            }
+        }
+
+        bool background_work()
+        {
+            connection_list connections;
+            {
+                std::unique_lock<mutex_type> l(
+                    connections_mtx_, std::try_to_lock);
+                if(l && !connections_.empty())
+                {
+                    connections.push_back(connections_.front());
+                    connections_.pop_front();
+                }
+            }
+            if(!connections.empty())
+            {
+                send_messages(std::move(connections));
+                return true;
+            }
+            return false;
+        }
+
+    private:
+        std::shared_ptr<channel> get_channel(
+            parcelset::locality const& there, error_code& ec)
+        {
+            locality const& dest = there.get<locality>();
+
+            std::shared_ptr<outbound_channel> c;
+            bool create = false;
+            {
+                std::unique_lock<mutex_type> l(channels_mtx_);
+                std::shared_ptr<outbound_channel>& entry = channels_[dest];
+                if (!entry)
+                {
+                    entry = std::make_shared<outbound_channel>();
+                    create = true;
+                }
+                c = entry;
+            }
+
+            if (create)
+            {
+                error_code connect_ec(lightweight);
+                bool success = connect(*c->channel_, dest, connect_ec);
+                c->state_.store(success ? outbound_channel::connected :
+                    outbound_channel::failed);
+                if (!success)
+                {
+                    // allow for later attempts to connect
+                    {
+                        std::unique_lock<mutex_type> l(channels_mtx_);
+                        channels_.erase(dest);
+                    }
+                    HPX_THROWS_IF(ec, network_error,
+                        "shmem::sender::get_channel",
+                        connect_ec.get_message());
+                    return std::shared_ptr<channel>();
+                }
+            }
+            else
+            {
+                // wait for the connection to be established by the first
+                // connection to this destination
+                for (std::size_t k = 0;
+                     c->state_.load() == outbound_channel::connecting; ++k)
+                {
+                    hpx::util::detail::yield_k(k,
+                        "shmem::sender::get_channel");
+                }
+                if (c->state_.load() == outbound_channel::failed)
+                {
+                    HPX_THROWS_IF(ec, network_error,
+                        "shmem::sender::get_channel",
+                        "failed to connect to the shared memory channel");
+                    return std::shared_ptr<channel>();
+                }
+            }
+
+            if (&ec != &throws)
+                ec = make_success_code();
+
+            return c->channel_;
+        }
+
+        // Create the channel to the given destination and announce it in the
+        // destination's mailbox. The mailbox might not exist yet if the
+        // destination has not started its parcelport, retry if needed.
+        bool connect(channel& ch, locality const& dest, error_code& ec)
+        {
+            try {
+                ch.create(channel_name(here_, dest), settings_.ring_size_,
+                    settings_.block_size_, settings_.num_blocks_);
+            }
+            catch (hpx::exception const& e) {
+                HPX_THROWS_IF(ec, e.get_error(), "shmem::sender::connect",
+                    e.what());
+                return false;
+            }
+
+            mailbox mb;
+            for (std::size_t i = 0; i < HPX_MAX_NETWORK_RETRIES; ++i)
+            {
+                if (mb.open(mailbox_name(dest)))
+                {
+                    if (mb.post(ch.name()))
+                        return true;
+                    mb.close();
+                }
+
+                // wait for a really short amount of time
+                if (hpx::threads::get_self_ptr()) {
+                    this_thread::suspend(hpx::threads::pending,
+                        "shmem::sender::connect");
+                }
+                else {
+                    std::this_thread::sleep_for(
+                        std::chrono::milliseconds(HPX_NETWORK_RETRIES_SLEEP));
+                }
+            }
+
+            HPX_THROWS_IF(ec, network_error, "shmem::sender::connect",
+                "could not announce the shared memory channel " + ch.name() +
+                " to " + mailbox_name(dest));
+            return false;
+        }
+
+        locality here_;
+        channel_settings settings_;
+
+        mutex_type channels_mtx_;
+        channel_map channels_;
+
+        mutex_type connections_mtx_;
+        connection_list connections_;
+    };
+}}}}
+
+#endif
+
+#endif
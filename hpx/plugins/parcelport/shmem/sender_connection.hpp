@@ -0,0 +1,309 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_POLICIES_SHMEM_SENDER_CONNECTION_HPP
+#define HPX_PARCELSET_POLICIES_SHMEM_SENDER_CONNECTION_HPP
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_PARCELPORT_SHMEM)
+
+#include <hpx/performance_counters/parcels/gatherer.hpp>
+#include <hpx/plugins/parcelport/shmem/channel.hpp>
+#include <hpx/plugins/parcelport/shmem/header.hpp>
+#include <hpx/plugins/parcelport/shmem/locality.hpp>
+#include <hpx/runtime/parcelset/parcelport_connection.hpp>
+#include <hpx/runtime/parcelset_fwd.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+#include <hpx/util/unique_function.hpp>
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parcelset { namespace policies { namespace shmem
+{
+    struct sender;
+    struct sender_connection;
+
+    void add_connection(sender *, std::shared_ptr<sender_connection> const&);
+
+    struct sender_connection
+      : parcelset::parcelport_connection<
+            sender_connection
+          , std::vector<char>
+        >
+    {
+    private:
+        typedef sender sender_type;
+
+        typedef std::vector<char> data_type;
+
+        enum connection_state
+        {
+            initialized
+          , sent_header
+          , sent_transmission_chunks
+          , sent_data
+          , sent_chunks
+        };
+
+        typedef
+            parcelset::parcelport_connection<sender_connection, data_type>
+            base_type;
+
+    public:
+        sender_connection(
+            sender_type * s
+          , std::shared_ptr<channel> const& ch
+          , parcelset::locality const& there
+          , std::size_t slab_threshold
+          , performance_counters::parcels::gatherer & parcels_sent
+        )
+          : state_(initialized)
+          , sender_(s)
+          , channel_(ch)
+          , slab_threshold_(slab_threshold)
+          , pending_(nullptr)
+          , pending_size_(0)
+          , chunks_idx_(0)
+          , chunk_started_(false)
+          , parcels_sent_(parcels_sent)
+          , there_(there)
+        {
+        }
+
+        parcelset::locality const& destination() const
+        {
+            return there_;
+        }
+
+        void verify(parcelset::locality const & parcel_locality_id) const
+        {
+        }
+
+        template <typename Handler, typename ParcelPostprocess>
+        void async_write(Handler && handler,
+            ParcelPostprocess && parcel_postprocess)
+        {
+            HPX_ASSERT(!buffer_.data_.empty());
+            chunks_idx_ = 0;
+            chunk_started_ = false;
+            header_ = header(buffer_);
+
+            state_ = initialized;
+
+            handler_ = std::forward<Handler>(handler);
+
+            if(!send())
+            {
+                postprocess_handler_
+                    = std::forward<ParcelPostprocess>(parcel_postprocess);
+                add_connection(sender_, shared_from_this());
+            }
+            else
+            {
+                error_code ec;
+                parcel_postprocess(ec, there_, shared_from_this());
+            }
+        }
+
+        bool send()
+        {
+            switch(state_)
+            {
+                case initialized:
+                    return send_header();
+                case sent_header:
+                    return send_transmission_chunks();
+                case sent_transmission_chunks:
+                    return send_data();
+                case sent_data:
+                    return send_chunks();
+                case sent_chunks:
+                    return done();
+                default:
+                    HPX_ASSERT(false);
+            }
+
+            return false;
+        }
+
+        bool send_header()
+        {
+            HPX_ASSERT(state_ == initialized);
+
+            // the ring is owned by this connection until the message is
+            // completely written
+            if(!channel_->try_acquire()) return false;
+
+            set_pending(header_.data(), sizeof(header));
+
+            state_ = sent_header;
+            return send_transmission_chunks();
+        }
+
+        bool send_transmission_chunks()
+        {
+            HPX_ASSERT(state_ == sent_header);
+            if(!flush()) return false;
+
+            std::vector<parcel_buffer_type::transmission_chunk_type>& chunks =
+                buffer_.transmission_chunks_;
+            if(header_.num_chunks_first() != 0)
+            {
+                set_pending(reinterpret_cast<char const*>(chunks.data()),
+                    chunks.size() *
+                        sizeof(parcel_buffer_type::transmission_chunk_type));
+            }
+
+            state_ = sent_transmission_chunks;
+            return send_data();
+        }
+
+        bool send_data()
+        {
+            HPX_ASSERT(state_ == sent_transmission_chunks);
+            if(!flush()) return false;
+
+            set_pending(buffer_.data_.data(), buffer_.data_.size());
+
+            state_ = sent_data;
+            return send_chunks();
+        }
+
+        bool send_chunks()
+        {
+            HPX_ASSERT(state_ == sent_data);
+
+            while(chunks_idx_ < buffer_.chunks_.size())
+            {
+                if(!flush()) return false;
+
+                serialization::serialization_chunk& c =
+                    buffer_.chunks_[chunks_idx_];
+                if(c.type_ != serialization::chunk_type_pointer)
+                {
+                    ++chunks_idx_;
+                    continue;
+                }
+
+                if(!chunk_started_)
+                {
+                    // announce the chunk, large chunks are handed over
+                    // through the slab if there is enough room
+                    chunk_header_ = chunk_header(place_in_slab(c));
+                    set_pending(chunk_header_.data(), sizeof(chunk_header));
+                    chunk_started_ = true;
+                    continue;
+                }
+
+                // all other chunks are streamed through the ring
+                if(!chunk_header_.in_slab())
+                {
+                    set_pending(static_cast<char const*>(c.data_.cpos_),
+                        c.size_);
+                }
+                chunk_started_ = false;
+                ++chunks_idx_;
+            }
+
+            if(!flush()) return false;
+
+            state_ = sent_chunks;
+            return done();
+        }
+
+        bool done()
+        {
+            channel_->release();
+
+            error_code ec;
+            handler_(ec);
+            buffer_.data_point_.time_ =
+                util::high_resolution_clock::now() - buffer_.data_point_.time_;
+            parcels_sent_.add_data(buffer_.data_point_);
+            buffer_.recycle();
+
+            return true;
+        }
+
+        util::unique_function_nonser<
+            void(
+                error_code const&
+              , parcelset::locality const&
+              , std::shared_ptr<sender_connection>
+            )
+        > postprocess_handler_;
+
+    private:
+        boost::uint64_t place_in_slab(
+            serialization::serialization_chunk const& c)
+        {
+            if(c.size_ < slab_threshold_)
+                return channel::no_block;
+
+            boost::uint64_t block = channel_->allocate_blocks(c.size_);
+            if(block != channel::no_block)
+            {
+                std::memcpy(channel_->block_data(block), c.data_.cpos_,
+                    c.size_);
+            }
+            return block;
+        }
+
+        void set_pending(char const* data, std::size_t size)
+        {
+            HPX_ASSERT(pending_size_ == 0);
+            pending_ = data;
+            pending_size_ = size;
+        }
+
+        // write the pending bytes to the ring, returns false if the ring
+        // is full
+        bool flush()
+        {
+            while(pending_size_ != 0)
+            {
+                std::size_t written = channel_->write(pending_, pending_size_);
+                if(written == 0) return false;
+
+                pending_ += written;
+                pending_size_ -= written;
+            }
+            return true;
+        }
+
+        connection_state state_;
+        sender_type * sender_;
+        std::shared_ptr<channel> channel_;
+        std::size_t slab_threshold_;
+
+        util::unique_function_nonser<
+            void(
+                error_code const&
+            )
+        > handler_;
+
+        header header_;
+        chunk_header chunk_header_;
+
+        char const* pending_;
+        std::size_t pending_size_;
+        std::size_t chunks_idx_;
+        bool chunk_started_;
+
+        performance_counters::parcels::gatherer & parcels_sent_;
+
+        parcelset::locality there_;
+    };
+}}}}
+
+#endif
+
+#endif
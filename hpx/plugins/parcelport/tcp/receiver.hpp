@@ -20,6 +20,7 @@
 #include <hpx/performance_counters/parcels/data_point.hpp>
 #include <hpx/performance_counters/parcels/gatherer.hpp>
 #include <hpx/runtime/parcelset/decode_parcels.hpp>
+#include <hpx/runtime/parcelset/detail/shared_chunk.hpp>
 #include <hpx/runtime/parcelset/parcelport_connection.hpp>
 #include <hpx/util/bind.hpp>
 #include <hpx/util/high_resolution_timer.hpp>
@@ -43,8 +44,13 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
 {
     class connection_handler;
 
+    // The zero-copy chunks are received into reference counted memory
+    // which is not initialized beforehand. Large serialize_buffer payloads
+    // will refer to this memory instead of copying the data (see
+    // serialize_buffer::load).
     class receiver
-      : public parcelport_connection<receiver, std::vector<char>, std::vector<char> >
+      : public parcelport_connection<receiver, std::vector<char>,
+            parcelset::detail::shared_chunk>
     {
         typedef hpx::lcos::local::spinlock mutex_type;
     public:
@@ -176,6 +182,9 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
                     std::vector<transmission_chunk_type>& chunks =
                         buffer_.transmission_chunks_;
 
+                    buffer_.reserve_transmission_chunks(
+                        static_cast<std::size_t>(
+                            num_zero_copy_chunks + num_non_zero_copy_chunks));
                     chunks.resize(static_cast<std::size_t>(
                         num_zero_copy_chunks + num_non_zero_copy_chunks));
 
@@ -184,6 +193,8 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
                             sizeof(transmission_chunk_type)));
 
                     // add main buffer holding data which was serialized normally
+                    buffer_.reserve_data(
+                        static_cast<std::size_t>(inbound_size));
                     buffer_.data_.resize(static_cast<std::size_t>(inbound_size));
                     buffers.push_back(boost::asio::buffer(buffer_.data_));
 
@@ -192,6 +203,8 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
                 }
                 else {
                     // add main buffer holding data which was serialized normally
+                    buffer_.reserve_data(
+                        static_cast<std::size_t>(inbound_size));
                     buffer_.data_.resize(static_cast<std::size_t>(inbound_size));
                     buffers.push_back(boost::asio::buffer(buffer_.data_));
 
@@ -111,7 +111,10 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
 
             // Write the serialized data to the socket. We use "gather-write"
             // to send both the header and the data in a single write operation.
+            // The zero-copy chunks are sent directly from the memory of the
+            // serialized objects.
             std::vector<boost::asio::const_buffer> buffers;
+            buffers.reserve(5 + buffer_.chunks_.size());
             buffers.push_back(boost::asio::buffer(&buffer_.size_,
                 sizeof(buffer_.size_)));
             buffers.push_back(boost::asio::buffer(&buffer_.data_size_,
@@ -197,7 +200,7 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
 #if defined(HPX_TRACK_STATE_OF_OUTGOING_TCP_CONNECTION)
             state_ = state_handle_read_ack;
 #endif
-            buffer_.clear();
+            buffer_.recycle();
             // Call post-processing handler, which will send remaining pending
             // parcels. Pass along the connection so it can be reused if more
             // parcels have to be sent.
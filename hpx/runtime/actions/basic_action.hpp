@@ -802,6 +802,11 @@ namespace hpx { namespace serialization
 #define HPX_ACTION_USES_HUGE_STACK(action)                                    \
     HPX_ACTION_USES_STACK(action, threads::thread_stacksize_huge)             \
 /**/
+// The action is executed directly on the stack of the worker thread, it must
+// not suspend (see threads::thread_stacksize_nostack).
+#define HPX_ACTION_USES_NO_STACK(action)                                      \
+    HPX_ACTION_USES_STACK(action, threads::thread_stacksize_nostack)          \
+/**/
 // This macro is deprecated. It expands to an inline function which will emit a
 // warning.
 #define HPX_ACTION_DOES_NOT_SUSPEND(action)                                    \
@@ -16,6 +16,7 @@
 #include <hpx/runtime/naming/id_type.hpp>
 #include <hpx/runtime/naming/name.hpp>
 #include <hpx/runtime/serialization/base_object.hpp>
+#include <hpx/runtime/serialization/detail/polymorphic_id_factory.hpp>
 #include <hpx/runtime/serialization/serialize.hpp>
 #include <hpx/runtime/trigger_lco.hpp>
 #include <hpx/throw_exception.hpp>
@@ -234,6 +235,7 @@ namespace hpx { namespace actions
     {
     public:
         typedef void continuation_tag;
+        typedef void serialized_with_id;
 
         continuation() {}
 
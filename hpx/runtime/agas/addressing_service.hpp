@@ -15,13 +15,12 @@
 #include <hpx/exception_fwd.hpp>
 #include <hpx/lcos/local/mutex.hpp>
 #include <hpx/runtime/agas/detail/agas_service_client.hpp>
+#include <hpx/runtime/agas/detail/gva_cache.hpp>
 #include <hpx/runtime/applier/applier.hpp>
 #include <hpx/runtime/components/pinned_ptr.hpp>
 #include <hpx/runtime/naming/address.hpp>
 #include <hpx/runtime/naming/name.hpp>
 #include <hpx/state.hpp>
-#include <hpx/util/cache/lru_cache.hpp>
-#include <hpx/util/cache/statistics/local_full_statistics.hpp>
 #include <hpx/util_fwd.hpp>
 
 #include <boost/atomic.hpp>
@@ -64,19 +63,12 @@ public:
     // }}}
 
     // {{{ gva cache
-    struct gva_cache_key;
-
-    typedef hpx::util::cache::lru_cache<
-        gva_cache_key
-      , gva
-      , hpx::util::cache::statistics::local_full_statistics
-    > gva_cache_type;
+    typedef detail::gva_cache gva_cache_type;
     // }}}
 
     typedef std::set<naming::gid_type> migrated_objects_table_type;
     typedef std::map<naming::gid_type, boost::int64_t> refcnt_requests_type;
 
-    mutable mutex_type gva_cache_mtx_;
     std::shared_ptr<gva_cache_type> gva_cache_;
 
     mutable mutex_type migrated_objects_mtx_;
@@ -209,6 +201,12 @@ public:
       , boost::int64_t compensated_credit
         );
 
+    std::vector<boost::int64_t> synchronize_with_bulk_incref(
+        hpx::future<std::vector<hpx::future<std::vector<response> > > > fut
+      , std::vector<boost::int64_t> credits
+      , std::vector<std::vector<std::size_t> > const& indices
+        );
+
     naming::address::address_type get_primary_ns_lva() const
     {
         return client_->get_primary_ns_ptr();
@@ -232,6 +230,16 @@ protected:
         future<response> f
       , naming::gid_type const& id
         );
+    naming::address resolve_full_response(
+        response const& rep
+      , naming::gid_type const& id
+        );
+    std::vector<naming::address> resolve_bulk_postproc(
+        future<std::vector<future<std::vector<response> > > > f
+      , std::vector<naming::gid_type> const& gids
+      , std::vector<naming::address> addrs
+      , std::vector<std::vector<std::size_t> > const& indices
+        );
     bool bind_postproc(
         future<response> f
       , naming::gid_type const& id
@@ -243,6 +251,16 @@ protected:
         naming::gid_type const& id
         );
 
+private:
+    /// Offsets the given incref against a pending decref, acquires
+    /// \a refcnt_requests_mtx_.
+    bool compensate_pending_decrefs(
+        naming::gid_type const& raw
+      , boost::int64_t credit
+      , std::pair<naming::gid_type, boost::int64_t>& pending_incref
+      , boost::int64_t& pending_decrefs
+        );
+
 private:
     /// Assumes that \a refcnt_requests_mtx_ is locked.
     void send_refcnt_requests(
@@ -1018,6 +1036,14 @@ public:
         return resolve_async(id.get_gid());
     }
 
+    /// \brief Resolve the given global addresses to local addresses
+    ///
+    /// The ids which are not cached are resolved using a single request
+    /// per primary namespace instance (instead of one request per id).
+    hpx::future<std::vector<naming::address> > resolve_async(
+        std::vector<naming::gid_type> const& ids
+        );
+
     ///////////////////////////////////////////////////////////////////////////
     hpx::future<naming::id_type> get_colocation_id_async(
         naming::id_type const& id
@@ -1168,6 +1194,16 @@ public:
       , naming::id_type const& keep_alive = naming::invalid_id
         );
 
+    /// \brief Increment the global reference counts for the given ids
+    ///
+    /// The increments are sent using a single request per primary namespace
+    /// instance. The returned future holds the number of credits added for
+    /// every id.
+    lcos::future<std::vector<boost::int64_t> > incref_async(
+        std::vector<std::pair<naming::gid_type, boost::int64_t> > const&
+            increfs
+        );
+
     boost::int64_t incref(
         naming::gid_type const& gid
       , boost::int64_t credits = 1
@@ -0,0 +1,151 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_AGAS_DETAIL_GVA_CACHE_OCT_18_2016_1105AM)
+#define HPX_AGAS_DETAIL_GVA_CACHE_OCT_18_2016_1105AM
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/runtime/agas/gva.hpp>
+#include <hpx/runtime/naming/name.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+namespace hpx { namespace agas { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    /// The gva_cache holds the mapping of global ids (or ranges of global ids)
+    /// to global virtual addresses which is used by the addressing_service to
+    /// avoid AGAS round trips for resolving remote ids.
+    ///
+    /// The cache is partitioned into a power-of-two number of shards. Each
+    /// shard is a set-associative table. Every table slot is protected by a
+    /// sequence lock, lookups (\a get_entry) never acquire a lock. The only
+    /// shared memory they write to is a reader counter selected by the
+    /// calling thread (and the referenced bit of an entry if not set
+    /// already). Modifications acquire the locks of the affected shards only.
+    /// Replacement inside a set uses the CLOCK algorithm, which approximates
+    /// LRU.
+    ///
+    /// Ids are grouped into blocks of consecutive ids, every block maps onto
+    /// one set. A range of ids is stored in each of the sets the blocks it
+    /// covers map to. Wider ranges use wider blocks: the block size grows by
+    /// a constant factor from one level to the next, each range is stored
+    /// at the lowest level at which it covers not more than a few blocks.
+    /// Lookups probe only the levels which have been used so far.
+    class HPX_EXPORT gva_cache
+    {
+        HPX_NON_COPYABLE(gva_cache);
+
+    public:
+        typedef std::size_t size_type;
+        typedef hpx::lcos::local::spinlock mutex_type;
+
+        /// Construct a cache with (at least) the given number of shards, the
+        /// default is to use twice the number of cores of this machine.
+        explicit gva_cache(size_type num_shards = 0);
+        ~gva_cache();
+
+        /// Return the number of entries currently held.
+        size_type size() const;
+
+        /// Return the maximum number of entries this cache may hold.
+        size_type capacity() const;
+
+        /// Change the maximum size this cache may grow to.
+        void reserve(size_type max_size);
+
+        /// Look up the entry covering the given id. On success \a idbase
+        /// refers to the first id of the range the entry was created for.
+        bool get_entry(naming::gid_type const& gid, naming::gid_type& idbase,
+            gva& g);
+
+        /// Insert the given range or update the existing entry for it. This
+        /// returns false if an entry for a different range collides with the
+        /// new one, \a old_gid and \a old_count will refer to that entry.
+        bool update_if(naming::gid_type const& gid, boost::uint64_t count,
+            gva const& g, naming::gid_type& old_gid, boost::uint64_t& old_count);
+
+        /// Remove all entries whose range starts at the given id.
+        size_type erase(naming::gid_type const& gid);
+
+        /// Remove all entries.
+        size_type clear();
+
+        // statistics
+        std::size_t hits(bool reset);
+        std::size_t misses(bool reset);
+        std::size_t insertions(bool reset);
+        std::size_t evictions(bool reset);
+
+        boost::int64_t get_get_entry_count(bool reset);
+        boost::int64_t get_insert_entry_count(bool reset);
+        boost::int64_t get_update_entry_count(bool reset);
+        boost::int64_t get_erase_entry_count(bool reset);
+
+        boost::int64_t get_get_entry_time(bool reset);
+        boost::int64_t get_insert_entry_time(bool reset);
+        boost::int64_t get_update_entry_time(bool reset);
+        boost::int64_t get_erase_entry_time(bool reset);
+
+    private:
+        struct slot;
+        struct table;
+        struct shard;
+        struct statistics;
+        struct update_on_exit;
+        struct overflow_cache;
+        struct reader_slot;
+        struct read_guard;
+
+        shard& get_shard(boost::uint64_t hash) const;
+
+        bool update_range(naming::gid_type const& gid, boost::uint64_t count,
+            gva const& g, naming::gid_type& old_gid,
+            boost::uint64_t& old_count);
+
+        bool find_overlapping(boost::uint64_t msb, boost::uint64_t lsb,
+            boost::uint64_t last_lsb, std::size_t level,
+            naming::gid_type& old_gid, boost::uint64_t& old_count) const;
+
+        boost::atomic<boost::int64_t>& enter_read() const;
+        void wait_for_readers();
+
+        template <typename F>
+        boost::int64_t accumulate(F && f, bool reset);
+
+        size_type num_shards_;
+        size_type shard_bits_;
+        boost::atomic<size_type> max_size_;
+        boost::atomic<size_type> size_;
+
+        std::unique_ptr<shard[]> shards_;
+
+        // bit mask of the levels which may hold entries
+        boost::atomic<boost::uint32_t> levels_;
+
+        // superseded tables are deleted only after all lookups which may
+        // still refer to them have finished
+        mutex_type reserve_mtx_;
+        boost::atomic<std::size_t> epoch_;
+        size_type num_readers_;
+        std::unique_ptr<reader_slot[]> readers_;
+
+        // ranges wrapping around the lsb of a global id
+        boost::atomic<size_type> overflow_size_;
+        std::unique_ptr<overflow_cache> overflow_;
+    };
+}}}
+
+#include <hpx/config/warnings_suffix.hpp>
+
+#endif
@@ -224,6 +224,11 @@ HPX_API_EXPORT naming::address resolve_sync(
   , error_code& ec = throws
     );
 
+// Resolve all given ids using one request per AGAS primary namespace instance
+HPX_API_EXPORT hpx::future<std::vector<naming::address> > resolve(
+    std::vector<naming::id_type> const& ids
+    );
+
 HPX_API_EXPORT hpx::future<bool> bind(
     naming::gid_type const& id
   , naming::address const& addr
@@ -318,6 +323,12 @@ HPX_API_EXPORT boost::int64_t incref(
   , error_code& ec = throws
     );
 
+// Increment the credits of all given ids using one request per AGAS primary
+// namespace instance, the ids have to be kept alive by the caller
+HPX_API_EXPORT hpx::future<std::vector<boost::int64_t> > incref_async(
+    std::vector<std::pair<naming::gid_type, boost::int64_t> > const& increfs
+  );
+
 ///////////////////////////////////////////////////////////////////////////////
 HPX_API_EXPORT hpx::future<naming::id_type> get_colocation_id(
     naming::id_type const& id);
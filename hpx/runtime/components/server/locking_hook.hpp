@@ -10,6 +10,7 @@
 #include <hpx/lcos/local/spinlock.hpp>
 #include <hpx/runtime/get_lva.hpp>
 #include <hpx/runtime/threads/coroutines/coroutine.hpp>
+#include <hpx/throw_exception.hpp>
 #include <hpx/traits/action_decorate_function.hpp>
 #include <hpx/util/bind.hpp>
 #include <hpx/util/register_locks.hpp>
@@ -129,6 +130,16 @@ namespace hpx { namespace components
             undecorate_wrapper yield_decorator;
             threads::thread_state_ex_enum result = threads::wait_unknown;
 
+            // stackless threads run on the stack of the worker thread, they
+            // can't give up control while holding the lock
+            if (threads::get_self().is_stackless())
+            {
+                HPX_THROW_EXCEPTION(invalid_status,
+                    "locking_hook::yield_function",
+                    "stackless threads (thread_stacksize_nostack) can't be "
+                    "suspended");
+            }
+
             {
                 util::unlock_guard<mutex_type> ul(mtx_);
                 result = threads::get_self().yield_impl(state);
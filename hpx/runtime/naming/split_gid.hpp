@@ -12,12 +12,20 @@
 #include <hpx/runtime/naming/name.hpp>
 
 #include <mutex>
+#include <vector>
 
 namespace hpx { namespace naming { namespace detail
 {
     HPX_EXPORT hpx::future<gid_type> split_gid_if_needed(gid_type& id);
     HPX_EXPORT hpx::future<gid_type> split_gid_if_needed_locked(
         std::unique_lock<gid_type::mutex_type> &l, gid_type& gid);
+
+    // Split the credits of all given (managed) ids ahead of sending them.
+    // The returned ids own the split credits and hand them over when being
+    // serialized. The credits of exhausted ids are replenished using a
+    // single AGAS request.
+    HPX_EXPORT hpx::future<std::vector<id_type> > split_gids(
+        std::vector<id_type> const& ids);
 }}}
 
 #endif
@@ -11,19 +11,25 @@
 #include <hpx/exception.hpp>
 #include <hpx/performance_counters/parcels/data_point.hpp>
 #include <hpx/runtime/naming/name.hpp>
+#include <hpx/runtime/parcelset/detail/buffer_arena.hpp>
+#include <hpx/runtime/parcelset/detail/shared_chunk.hpp>
 #include <hpx/runtime/parcelset/parcel.hpp>
 #include <hpx/runtime/serialization/serialize.hpp>
 #include <hpx/runtime_fwd.hpp>
 #include <hpx/util/high_resolution_timer.hpp>
 
+#include <memory>
 #include <sstream>
 #include <utility>
 #include <vector>
 
 namespace hpx { namespace parcelset
 {
+    // The (optional) chunk_owners receive the objects managing the memory of
+    // the zero-copy chunks, stored at the same position as the chunk itself.
     template <typename Buffer>
-    std::vector<serialization::serialization_chunk> decode_chunks(Buffer & buffer)
+    std::vector<serialization::serialization_chunk> decode_chunks(Buffer & buffer,
+        std::vector<std::shared_ptr<void> >* chunk_owners = nullptr)
     {
         typedef typename Buffer::transmission_chunk_type transmission_chunk_type;
 
@@ -40,7 +46,14 @@ namespace hpx { namespace parcelset
                 static_cast<std::size_t>(
                     static_cast<boost::uint32_t>(buffer.num_chunks_.second));
 
+            detail::reserve_buffer(chunks,
+                num_zero_copy_chunks + num_non_zero_copy_chunks);
             chunks.resize(num_zero_copy_chunks + num_non_zero_copy_chunks);
+            if (chunk_owners != nullptr)
+            {
+                chunk_owners->clear();
+                chunk_owners->resize(chunks.size());
+            }
 
             // place the zero-copy chunks at their spots first
             for (std::size_t i = 0; i != num_zero_copy_chunks; ++i)
@@ -52,6 +65,12 @@ namespace hpx { namespace parcelset
 
                 chunks[first] = serialization::create_pointer_chunk(
                         buffer.chunks_[i].data(), second);
+
+                if (chunk_owners != nullptr)
+                {
+                    (*chunk_owners)[first] =
+                        detail::get_chunk_owner(buffer.chunks_[i]);
+                }
             }
 
             std::size_t index = 0;
@@ -93,8 +112,9 @@ namespace hpx { namespace parcelset
       , std::size_t num_thread = -1
     )
     {
+        std::vector<std::shared_ptr<void> > chunk_owners;
         std::vector<serialization::serialization_chunk> chunks(
-            decode_chunks(buffer));
+            decode_chunks(buffer, &chunk_owners));
         boost::uint64_t inbound_data_size = buffer.data_size_;
 
         // protect from un-handled exceptions bubbling up
@@ -109,7 +129,7 @@ namespace hpx { namespace parcelset
                 {
                     // De-serialize the parcel data
                     serialization::input_archive archive(buffer.data_,
-                        inbound_data_size, &chunks);
+                        inbound_data_size, &chunks, &chunk_owners);
 
                     if(parcel_count == 0)
                         archive >> parcel_count; //-V128
@@ -184,6 +204,10 @@ namespace hpx { namespace parcelset
                 << "decode_message: caught unknown exception.";
             hpx::report_error(boost::current_exception());
         }
+
+        // the decoded parcels don't refer to the received data anymore
+        detail::recycle_buffer(chunks);
+        buffer.recycle();
     }
 
     template <typename Parcelport, typename Buffer>
@@ -0,0 +1,73 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARCELSET_DETAIL_BUFFER_ARENA_OCT_18_2016_0520PM)
+#define HPX_PARCELSET_DETAIL_BUFFER_ARENA_OCT_18_2016_0520PM
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/serialization/serialization_chunk.hpp>
+#include <hpx/util/integer/endian.hpp>
+
+#include <boost/cstdint.hpp>
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parcelset { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // The vectors making up a parcel buffer are recycled once the parcels
+    // have been sent or decoded. The arena keeps them sorted into power of
+    // two size classes (by capacity), every OS-thread caches the buffers it
+    // released most recently, the remaining ones are kept in a global depot
+    // (buffers are usually released on a different OS-thread than the one
+    // which acquired them).
+    //
+    // Buffers which are too small, too large, or which use a custom
+    // allocator are not recycled.
+    typedef std::pair<
+        util::integer::ulittle64_t, util::integer::ulittle64_t
+    > transmission_chunk_type;
+
+    // Make sure the given (empty) buffer can hold at least size elements.
+    // A recycled buffer is used if one with sufficient capacity is
+    // available.
+    HPX_EXPORT void reserve_buffer(std::vector<char>& buffer,
+        std::size_t size);
+    HPX_EXPORT void reserve_buffer(
+        std::vector<serialization::serialization_chunk>& buffer,
+        std::size_t size);
+    HPX_EXPORT void reserve_buffer(
+        std::vector<transmission_chunk_type>& buffer, std::size_t size);
+
+    // Hand the memory of the given buffer back to the arena, the buffer is
+    // left empty (without capacity).
+    HPX_EXPORT void recycle_buffer(std::vector<char>& buffer);
+    HPX_EXPORT void recycle_buffer(
+        std::vector<serialization::serialization_chunk>& buffer);
+    HPX_EXPORT void recycle_buffer(
+        std::vector<transmission_chunk_type>& buffer);
+
+    template <typename Buffer>
+    void reserve_buffer(Buffer& buffer, std::size_t size)
+    {
+        buffer.reserve(size);
+    }
+
+    template <typename Buffer>
+    void recycle_buffer(Buffer& buffer)
+    {
+        buffer.clear();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The number of buffers taken from the arena and the number of buffers
+    // which had to be allocated instead.
+    HPX_EXPORT boost::int64_t get_buffer_arena_hits(bool reset);
+    HPX_EXPORT boost::int64_t get_buffer_arena_misses(bool reset);
+}}}
+
+#endif
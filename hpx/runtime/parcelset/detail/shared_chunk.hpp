@@ -0,0 +1,78 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_RUNTIME_PARCELSET_DETAIL_SHARED_CHUNK_HPP
+#define HPX_RUNTIME_PARCELSET_DETAIL_SHARED_CHUNK_HPP
+
+#include <hpx/config.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace parcelset
+{
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // A shared_chunk holds the data of one zero-copy chunk received by a
+        // parcelport. Its memory is not initialized on allocation and it is
+        // reference counted. This allows for the objects deserialized from
+        // the chunk (see serialize_buffer) to keep referring to the received
+        // data instead of copying it.
+        class shared_chunk
+        {
+        public:
+            typedef char value_type;
+
+            shared_chunk()
+              : size_(0)
+            {}
+
+            // Refer to memory owned by the parcelport (for instance memory
+            // handed over through shared memory), the memory is released
+            // by the given pointer's deleter.
+            shared_chunk(std::shared_ptr<char> data, std::size_t size)
+              : data_(std::move(data)), size_(size)
+            {}
+
+            // Note: this always allocates new memory as the old memory may
+            //       still be referenced by deserialized objects.
+            void resize(std::size_t size)
+            {
+                data_.reset(new char[size], std::default_delete<char[]>());
+                size_ = size;
+            }
+
+            char* data() { return data_.get(); }
+            char const* data() const { return data_.get(); }
+
+            std::size_t size() const { return size_; }
+
+            std::shared_ptr<void> owner() const { return data_; }
+
+        private:
+            std::shared_ptr<char> data_;
+            std::size_t size_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // Return the object managing the lifetime of the memory of the given
+        // received chunk, if any.
+        template <typename Chunk>
+        std::shared_ptr<void> get_chunk_owner(Chunk const&)
+        {
+            return std::shared_ptr<void>();
+        }
+
+        inline std::shared_ptr<void> get_chunk_owner(shared_chunk const& c)
+        {
+            return c.owner();
+        }
+    }
+}}
+
+#endif
@@ -92,7 +92,7 @@ namespace hpx
                     buffer.transmission_chunks_;
 
                 chunks.clear();
-                chunks.reserve(buffer.chunks_.size());
+                buffer.reserve_transmission_chunks(buffer.chunks_.size());
 
                 std::size_t index = 0;
                 for (serialization::serialization_chunk& c : buffer.chunks_)
@@ -174,7 +174,7 @@ namespace hpx
                             archive_flags, dest_locality_id, &buffer.chunks_);
                     }
 
-                    buffer.data_.reserve((std::max)(chunk_default, arg_size));
+                    buffer.reserve_data((std::max)(chunk_default, arg_size));
 
                     // mark start of serialization
                     util::high_resolution_timer timer;
@@ -9,11 +9,13 @@
 
 #include <hpx/config.hpp>
 #include <hpx/performance_counters/parcels/data_point.hpp>
+#include <hpx/runtime/parcelset/detail/buffer_arena.hpp>
 #include <hpx/runtime/serialization/serialization_chunk.hpp>
 #include <hpx/util/integer/endian.hpp>
 
 #include <boost/atomic.hpp>
 
+#include <cstddef>
 #include <utility>
 #include <vector>
 
@@ -84,6 +86,28 @@ namespace hpx { namespace parcelset
             data_point_ = performance_counters::parcels::data_point();
         }
 
+        // Make sure the data buffer can hold the given number of bytes, the
+        // memory is taken from the arena of recycled buffers if possible.
+        void reserve_data(std::size_t size)
+        {
+            detail::reserve_buffer(data_, size);
+        }
+
+        void reserve_transmission_chunks(std::size_t size)
+        {
+            detail::reserve_buffer(transmission_chunks_, size);
+        }
+
+        // Hand the memory of this buffer back to the arena once the data
+        // has been sent or decoded.
+        void recycle()
+        {
+            detail::recycle_buffer(data_);
+            detail::recycle_buffer(chunks_);
+            detail::recycle_buffer(transmission_chunks_);
+            clear();
+        }
+
         BufferType data_;
         std::vector<ChunkType> chunks_;
 
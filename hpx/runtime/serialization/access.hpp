@@ -12,6 +12,8 @@
 #include <hpx/traits/polymorphic_traits.hpp>
 #include <hpx/util/decay.hpp>
 
+#include <boost/cstdint.hpp>
+
 #include <string>
 #include <type_traits>
 
@@ -134,6 +136,12 @@ namespace hpx { namespace serialization
         {
             return t->hpx_serialization_get_name();
         }
+
+        template <typename T> HPX_FORCEINLINE
+        static boost::uint32_t get_id(const T* t)
+        {
+            return t->hpx_serialization_get_id();
+        }
     };
 
 }}
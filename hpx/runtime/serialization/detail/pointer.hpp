@@ -84,6 +84,18 @@ namespace hpx { namespace serialization
                     boost::uint32_t id;
                     ar >> id;
 
+                    if (id == invalid_type_id)
+                    {
+                        // no id has been assigned to this type yet
+                        std::string name;
+                        ar >> name;
+
+                        Pointer t(polymorphic_id_factory::create<
+                            referred_type>(name));
+                        ar >> *t;
+                        return t;
+                    }
+
                     Pointer t(polymorphic_id_factory::create<referred_type>(id));
                     ar >> *t;
                     return t;
@@ -93,6 +105,14 @@ namespace hpx { namespace serialization
                     ar >> name;
                     ar >> id;
 
+                    if (id == invalid_type_id)
+                    {
+                        Pointer t(polymorphic_id_factory::create<
+                            referred_type>(name));
+                        ar >> *t;
+                        return t;
+                    }
+
                     Pointer t(
                         polymorphic_id_factory::create<referred_type>(id, &name));
                     ar >> *t;
@@ -155,15 +175,19 @@ namespace hpx { namespace serialization
                 static void call(output_archive& ar, const Pointer& ptr)
                 {
 #if !defined(HPX_DEBUG)
-                    const boost::uint32_t id =
-                        polymorphic_id_factory::get_id(
-                            access::get_name(ptr.get()));
+                    // the id is cached per type, the name is sent only if
+                    // no id has been assigned to the type yet
+                    const boost::uint32_t id = access::get_id(ptr.get());
                     ar << id;
+                    if (id == invalid_type_id)
+                    {
+                        std::string const name(access::get_name(ptr.get()));
+                        ar << name;
+                    }
                     ar << *ptr;
 #else
                     std::string const name(access::get_name(ptr.get()));
-                    const boost::uint32_t id =
-                        polymorphic_id_factory::get_id(name);
+                    const boost::uint32_t id = access::get_id(ptr.get());
                     ar << name;
                     ar << id;
                     ar << *ptr;
@@ -39,7 +39,7 @@ namespace hpx { namespace serialization {
             typedef std::map<std::string, boost::uint32_t> typename_to_id_t;
             typedef std::vector<ctor_t> cache_t;
 
-            HPX_STATIC_CONSTEXPR boost::uint32_t invalid_id = ~0u;
+            HPX_STATIC_CONSTEXPR boost::uint32_t invalid_id = invalid_type_id;
 
             HPX_EXPORT void register_factory_function(
                 const std::string& type_name, ctor_t ctor);
@@ -110,6 +110,16 @@ namespace hpx { namespace serialization {
                 return static_cast<T*>(ctor());
             }
 
+            // Types which have no id assigned (yet) are sent along with their
+            // name instead, see pointer.hpp
+            template <class T>
+            static T* create(std::string const& name)
+            {
+                return static_cast<T*>(create(name));
+            }
+
+            HPX_EXPORT static void* create(std::string const& name);
+
             HPX_EXPORT static boost::uint32_t get_id(
                 const std::string& type_name);
 
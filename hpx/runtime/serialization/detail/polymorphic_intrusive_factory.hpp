@@ -13,6 +13,8 @@
 #include <hpx/util/demangle_helper.hpp>
 #include <hpx/util/jenkins_hash.hpp>
 
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
 #include <boost/preprocessor/stringize.hpp>
 
 #include <string>
@@ -20,6 +22,29 @@
 
 namespace hpx { namespace serialization { namespace detail
 {
+    // the id of types which have no id assigned (see id_registry)
+    HPX_STATIC_CONSTEXPR boost::uint32_t invalid_type_id = ~0u;
+
+    // Return the id assigned to the given type name, or invalid_type_id.
+    HPX_EXPORT boost::uint32_t try_get_type_id(std::string const& type_name);
+
+    // The ids are agreed on by all localities during startup and never
+    // change afterwards, once known they are cached per type.
+    template <typename T>
+    boost::uint32_t get_type_id(std::string (*get_name)())
+    {
+        static boost::atomic<boost::uint32_t> id(invalid_type_id);
+
+        boost::uint32_t result = id.load(boost::memory_order_relaxed);
+        if (result == invalid_type_id)
+        {
+            result = try_get_type_id(get_name());
+            if (result != invalid_type_id)
+                id.store(result, boost::memory_order_relaxed);
+        }
+        return result;
+    }
+
     class polymorphic_intrusive_factory
     {
         HPX_NON_COPYABLE(polymorphic_intrusive_factory);
@@ -91,6 +116,11 @@ namespace hpx { namespace serialization { namespace detail
   {                                                                           \
       return Class::hpx_serialization_get_name_impl();                        \
   }                                                                           \
+  virtual boost::uint32_t hpx_serialization_get_id() const                    \
+  {                                                                           \
+      return hpx::serialization::detail::get_type_id<Class>(                  \
+          &Class::hpx_serialization_get_name_impl);                           \
+  }                                                                           \
 /**/
 
 #define HPX_SERIALIZATION_POLYMORPHIC_WITH_NAME(Class, Name)                  \
@@ -121,6 +151,10 @@ namespace hpx { namespace serialization { namespace detail
 
 #define HPX_SERIALIZATION_POLYMORPHIC_ABSTRACT(Class)                         \
   virtual std::string hpx_serialization_get_name() const = 0;                 \
+  virtual boost::uint32_t hpx_serialization_get_id() const                    \
+  {                                                                           \
+      return hpx::serialization::detail::invalid_type_id;                     \
+  }                                                                           \
   virtual void load(hpx::serialization::input_archive& ar, unsigned n)        \
   {                                                                           \
       serialize<hpx::serialization::input_archive>(ar, n);                    \
@@ -135,6 +169,10 @@ namespace hpx { namespace serialization { namespace detail
 
 #define HPX_SERIALIZATION_POLYMORPHIC_ABSTRACT_SPLITTED(Class)                \
   virtual std::string hpx_serialization_get_name() const = 0;                 \
+  virtual boost::uint32_t hpx_serialization_get_id() const                    \
+  {                                                                           \
+      return hpx::serialization::detail::invalid_type_id;                     \
+  }                                                                           \
   virtual void load(hpx::serialization::input_archive& ar, unsigned n)        \
   {                                                                           \
       load<hpx::serialization::input_archive>(ar, n);                         \
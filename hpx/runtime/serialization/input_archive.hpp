@@ -36,9 +36,11 @@ namespace hpx { namespace serialization
         template <typename Container>
         input_archive(Container & buffer,
             std::size_t inbound_data_size = 0,
-            const std::vector<serialization_chunk>* chunks = nullptr)
+            const std::vector<serialization_chunk>* chunks = nullptr,
+            const std::vector<std::shared_ptr<void> >* chunk_owners = nullptr)
           : base_type(0U)
-          , buffer_(new input_container<Container>(buffer, chunks, inbound_data_size))
+          , buffer_(new input_container<Container>(buffer, chunks,
+                inbound_data_size, chunk_owners))
         {
             // endianness needs to be saves separately as it is needed to
             // properly interpret the flags
@@ -128,6 +130,8 @@ namespace hpx { namespace serialization
         friend struct basic_archive<input_archive>;
         template <class T>
         friend class array;
+        template <typename T, typename Allocator>
+        friend class serialize_buffer;
 
         template <typename T>
         void load_bitwise(T & t, std::false_type)
@@ -250,6 +254,22 @@ namespace hpx { namespace serialization
             size_ += count;
         }
 
+        // Try to access the data of the next zero-copy chunk in place. On
+        // success, the returned memory is kept alive by the given owner.
+        void const* load_shared_binary_chunk(std::size_t count,
+            std::size_t alignment, std::shared_ptr<void>& owner)
+        {
+            if (0 == count || disable_data_chunking())
+                return nullptr;
+
+            void const* data =
+                buffer_->load_shared_binary_chunk(count, alignment, owner);
+            if (data != nullptr)
+                size_ += count;
+
+            return data;
+        }
+
         // make functions visible through adl
         friend void register_pointer(input_archive& ar,
                 boost::uint64_t pos, detail::ptr_helper_ptr helper)
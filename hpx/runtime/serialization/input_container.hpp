@@ -49,20 +49,26 @@ namespace hpx { namespace serialization
         input_container(Container const& cont, std::size_t inbound_data_size)
           : cont_(cont), current_(0), filter_(),
             decompressed_size_(inbound_data_size),
-            chunks_(nullptr), current_chunk_(std::size_t(-1)), current_chunk_size_(0)
+            chunks_(nullptr), chunk_owners_(nullptr),
+            current_chunk_(std::size_t(-1)), current_chunk_size_(0)
         {}
 
         input_container(Container const& cont,
                 std::vector<serialization_chunk> const* chunks,
-                std::size_t inbound_data_size)
+                std::size_t inbound_data_size,
+                std::vector<std::shared_ptr<void> > const* chunk_owners = nullptr)
           : cont_(cont), current_(0), filter_(),
             decompressed_size_(inbound_data_size),
-            chunks_(nullptr), current_chunk_(std::size_t(-1)), current_chunk_size_(0)
+            chunks_(nullptr), chunk_owners_(nullptr),
+            current_chunk_(std::size_t(-1)), current_chunk_size_(0)
         {
             if (chunks && chunks->size() != 0)
             {
                 chunks_ = chunks;
                 current_chunk_ = 0;
+
+                if (chunk_owners && chunk_owners->size() == chunks->size())
+                    chunk_owners_ = chunk_owners;
             }
         }
 
@@ -154,12 +160,39 @@ namespace hpx { namespace serialization
             }
         }
 
+        void const* load_shared_binary_chunk(std::size_t count,
+            std::size_t alignment, std::shared_ptr<void>& owner) // override
+        {
+            if (filter_.get() || chunk_owners_ == nullptr ||
+                count < HPX_ZERO_COPY_SERIALIZATION_THRESHOLD)
+            {
+                return nullptr;
+            }
+
+            HPX_ASSERT(current_chunk_ != std::size_t(-1));
+            HPX_ASSERT(get_chunk_type(current_chunk_) == chunk_type_pointer);
+
+            std::shared_ptr<void> const& chunk_owner =
+                (*chunk_owners_)[current_chunk_];
+            void const* data = get_chunk_data(current_chunk_).cpos_;
+            if (!chunk_owner || get_chunk_size(current_chunk_) != count ||
+                reinterpret_cast<std::size_t>(data) % alignment != 0)
+            {
+                return nullptr;
+            }
+
+            owner = chunk_owner;
+            ++current_chunk_;
+            return data;
+        }
+
         Container const& cont_;
         std::size_t current_;
         std::unique_ptr<binary_filter> filter_;
         std::size_t decompressed_size_;
 
         std::vector<serialization_chunk> const* chunks_;
+        std::vector<std::shared_ptr<void> > const* chunk_owners_;
         std::size_t current_chunk_;
         std::size_t current_chunk_size_;
     };
@@ -9,15 +9,19 @@
 
 #include <hpx/config.hpp>
 #include <hpx/runtime/serialization/array.hpp>
+#include <hpx/runtime/serialization/input_archive.hpp>
 #include <hpx/runtime/serialization/serialize.hpp>
 #include <hpx/throw_exception.hpp>
+#include <hpx/traits/is_bitwise_serializable.hpp>
 #include <hpx/traits/supports_streaming_with_any.hpp>
 #include <hpx/util/bind.hpp>
 
 #include <boost/shared_array.hpp>
 
 #include <algorithm>
+#include <memory>
 #include <type_traits>
+#include <utility>
 
 namespace hpx { namespace serialization
 {
@@ -36,6 +40,8 @@ namespace hpx { namespace serialization
             dealloc.deallocate(p, size);
         }
 
+        static void shared_deleter(T*, std::shared_ptr<void> const&) {}
+
     public:
         enum init_mode
         {
@@ -258,6 +264,18 @@ namespace hpx { namespace serialization
             using util::placeholders::_1;
             ar >> size_ >> alloc_; //-V128
 
+            // Refer to the received data directly, if possible. This is done
+            // for buffers using the default allocator only, as other
+            // allocators may expect for the data to end up in memory they
+            // manage themselves.
+            typedef std::integral_constant<bool,
+                    std::is_same<Allocator, std::allocator<T> >::value &&
+                    hpx::traits::is_bitwise_serializable<T>::value
+                > use_shared_chunk;
+
+            if (size_ != 0 && load_shared_chunk(ar, use_shared_chunk()))
+                return;
+
             data_.reset(alloc_.allocate(size_),
                 util::bind(&serialize_buffer::deleter<allocator_type>, _1,
                     alloc_, size_));
@@ -268,6 +286,35 @@ namespace hpx { namespace serialization
             }
         }
 
+        template <typename Archive>
+        bool load_shared_chunk(Archive&, std::false_type)
+        {
+            return false;
+        }
+
+        bool load_shared_chunk(input_archive& ar, std::true_type)
+        {
+#ifdef BOOST_BIG_ENDIAN
+            bool archive_endianess_differs = ar.endian_little();
+#else
+            bool archive_endianess_differs = ar.endian_big();
+#endif
+            if (ar.disable_array_optimization() || archive_endianess_differs)
+                return false;
+
+            std::shared_ptr<void> owner;
+            void const* data = ar.load_shared_binary_chunk(size_ * sizeof(T),
+                std::alignment_of<T>::value, owner);
+            if (data == nullptr)
+                return false;
+
+            using util::placeholders::_1;
+            data_.reset(static_cast<T*>(const_cast<void*>(data)),
+                util::bind(&serialize_buffer::shared_deleter, _1,
+                    std::move(owner)));
+            return true;
+        }
+
         HPX_SERIALIZATION_SPLIT_MEMBER()
 
         // this is needed for util::any
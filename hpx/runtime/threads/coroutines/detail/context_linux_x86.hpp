@@ -289,7 +289,9 @@ namespace hpx { namespace threads { namespace coroutines
             {}
 
             static void thread_shutdown()
-            {}
+            {
+                posix::flush_stack_pool();
+            }
 
         private:
 #if defined(__x86_64__)
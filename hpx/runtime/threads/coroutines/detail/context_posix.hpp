@@ -247,7 +247,10 @@ namespace hpx { namespace threads { namespace coroutines
             // global functions to be called for each OS-thread after it started
             // running and before it exits
             static void thread_startup(char const* thread_type) {}
-            static void thread_shutdown() {}
+            static void thread_shutdown()
+            {
+                posix::flush_stack_pool();
+            }
 
             void reset_stack()
             {
@@ -84,6 +84,8 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
 
         arg_type yield_impl(result_type arg)
         {
+            // stackless threads have to be prevented from suspending by the
+            // caller (see this_thread::suspend)
             HPX_ASSERT(m_pimpl);
 
             this->m_pimpl->bind_result(&arg);
@@ -131,20 +133,23 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
 
         bool pending() const
         {
-            HPX_ASSERT(m_pimpl);
+            if (is_stackless())
+                return false;
             return m_pimpl->pending() != 0;
         }
 
         thread_id_repr_type get_thread_id() const
         {
-            HPX_ASSERT(m_pimpl);
+            if (is_stackless())
+                return stackless_id_;
             return m_pimpl->get_thread_id();
         }
 
         std::size_t get_thread_phase() const
         {
 #if defined(HPX_HAVE_THREAD_PHASE_INFORMATION)
-            HPX_ASSERT(m_pimpl);
+            if (is_stackless())
+                return 0;
             return m_pimpl->get_thread_phase();
 #else
             return 0;
@@ -153,6 +158,10 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
 
         std::ptrdiff_t get_available_stack_space()
         {
+            // stackless threads must not run anything inline which might
+            // need a stack of its own
+            if (is_stackless())
+                return 0;
 #if defined(HPX_HAVE_THREADS_GET_STACK_POINTER)
             return m_pimpl->get_available_stack_space();
 #else
@@ -162,24 +171,45 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
 
         explicit coroutine_self(impl_type * pimpl,
                 coroutine_self* next_self = nullptr)
-          : m_pimpl(pimpl), next_self_(next_self)
+          : m_pimpl(pimpl), next_self_(next_self),
+            stackless_id_(nullptr), stackless_recursion_count_(0)
+        {}
+
+        // The context of a stackless thread, which is executed directly on
+        // the stack of the worker thread and can't yield (see
+        // thread_stacksize_nostack).
+        struct stackless_tag {};
+
+        coroutine_self(stackless_tag, thread_id_repr_type id,
+                coroutine_self* next_self = nullptr)
+          : m_pimpl(nullptr), next_self_(next_self),
+            stackless_id_(id), stackless_recursion_count_(0)
         {}
 
+        bool is_stackless() const
+        {
+            return m_pimpl == nullptr;
+        }
+
 #if defined(HPX_HAVE_THREAD_LOCAL_STORAGE)
+        // stackless threads don't support thread local storage
         std::size_t get_thread_data() const
         {
-            HPX_ASSERT(m_pimpl);
+            if (is_stackless())
+                return 0;
             return m_pimpl->get_thread_data();
         }
         std::size_t set_thread_data(std::size_t data)
         {
-            HPX_ASSERT(m_pimpl);
+            if (is_stackless())
+                return 0;
             return m_pimpl->set_thread_data(data);
         }
 
         tss_storage* get_thread_tss_data()
         {
-            HPX_ASSERT(m_pimpl);
+            if (is_stackless())
+                return nullptr;
             return m_pimpl->get_thread_tss_data(false);
         }
 
@@ -192,7 +222,8 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
 
         std::size_t& get_continuation_recursion_count()
         {
-            HPX_ASSERT(m_pimpl);
+            if (is_stackless())
+                return stackless_recursion_count_;
             return m_pimpl->get_continuation_recursion_count();
         }
 
@@ -211,6 +242,9 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
         }
         impl_ptr m_pimpl;
         coroutine_self* next_self_;
+
+        thread_id_repr_type stackless_id_;
+        std::size_t stackless_recursion_count_;
     };
 }}}}
 
@@ -31,6 +31,7 @@
 #define HPX_RUNTIME_THREADS_COROUTINES_DETAIL_POSIX_UTILITY_HPP
 
 #include <hpx/config.hpp>
+#include <hpx/runtime/threads/coroutines/detail/stack_pool.hpp>
 #include <hpx/util/assert.hpp>
 
 // include unist.d conditionally to check for POSIX version. Not all OSs have the
@@ -82,6 +83,13 @@ namespace posix
 
     inline void* alloc_stack(std::size_t size)
     {
+        if (use_stack_pool)
+        {
+            void* stack = pool_alloc_stack(size);
+            if (stack != nullptr)
+                return stack;
+        }
+
         void* real_stack = ::mmap(nullptr,
             size + EXEC_PAGESIZE,
             PROT_EXEC | PROT_READ | PROT_WRITE,
@@ -151,6 +159,10 @@ namespace posix
 
     inline void free_stack(void* stack, std::size_t size)
     {
+        // pooled stacks are never unmapped
+        if (use_stack_pool && pool_free_stack(stack, size))
+            return;
+
 #if defined(HPX_HAVE_THREAD_GUARD_PAGE)
         if (use_guard_pages) {
             void** real_stack =
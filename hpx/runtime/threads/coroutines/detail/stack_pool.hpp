@@ -0,0 +1,52 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_RUNTIME_THREADS_COROUTINES_DETAIL_STACK_POOL_OCT_18_2016_0235PM)
+#define HPX_RUNTIME_THREADS_COROUTINES_DETAIL_STACK_POOL_OCT_18_2016_0235PM
+
+#include <hpx/config.hpp>
+
+#include <boost/cstdint.hpp>
+
+#include <cstddef>
+
+///////////////////////////////////////////////////////////////////////////////
+// The stack pool caches the (mmap'ed) stacks of terminated coroutines to
+// avoid a system call for each newly created HPX-thread. Each OS-thread keeps
+// a private cache of recently used stacks for each stack size. New stacks are
+// carved out of larger slabs which are mapped in one go, the memory of those
+// is committed lazily by the kernel on first touch. Stacks returned to an
+// OS-thread holding more than the configured high-water mark of stacks of the
+// same size are trimmed (their memory is handed back to the operating system
+// using madvise) and are moved to a global pool shared by all OS-threads.
+namespace hpx { namespace threads { namespace coroutines { namespace detail {
+namespace posix
+{
+    // These global variables control the stack pool. They will be set once
+    // by the runtime configuration startup code.
+    HPX_EXPORT extern bool use_stack_pool;
+    HPX_EXPORT extern std::size_t stack_pool_high_water_mark;
+
+    /// Return a stack of the given size from the pool (or from a newly mapped
+    /// slab). Returns nullptr if the pool does not handle stacks of this size.
+    HPX_EXPORT void* pool_alloc_stack(std::size_t size);
+
+    /// Hand the given stack back to the pool. Returns false if the pool does
+    /// not handle stacks of this size, in which case the caller is responsible
+    /// for releasing the stack.
+    HPX_EXPORT bool pool_free_stack(void* stack, std::size_t size);
+
+    /// Move all stacks cached by the calling OS-thread to the global pool.
+    /// This should be called for each OS-thread before it exits.
+    HPX_EXPORT void flush_stack_pool();
+
+    // statistics
+    HPX_EXPORT boost::uint64_t get_stack_allocation_count(bool reset);
+    HPX_EXPORT boost::uint64_t get_stack_reuse_count(bool reset);
+    HPX_EXPORT boost::uint64_t get_stack_trim_count(bool reset);
+}
+}}}}
+
+#endif
@@ -11,6 +11,7 @@
 #include <hpx/runtime/get_config_entry.hpp>
 #include <hpx/runtime/get_thread_name.hpp>
 #include <hpx/runtime/threads/detail/periodic_maintenance.hpp>
+#include <hpx/runtime/threads/detail/set_thread_state.hpp>
 #include <hpx/runtime/threads/thread_data.hpp>
 #include <hpx/state.hpp>
 #include <hpx/util/assert.hpp>
@@ -18,6 +19,7 @@
 #include <hpx/util/hardware/timestamp.hpp>
 #include <hpx/util/itt_notify.hpp>
 #include <hpx/util/safe_lexical_cast.hpp>
+#include <hpx/util/sharded_histogram.hpp>
 
 #include <boost/atomic.hpp>
 #include <boost/cstdint.hpp>
@@ -122,15 +124,28 @@ namespace hpx { namespace threads { namespace detail
 #ifdef HPX_HAVE_THREAD_IDLE_RATES
     struct idle_collect_rate
     {
-        idle_collect_rate(std::uint64_t& tfunc_time, std::uint64_t& exec_time)
+        idle_collect_rate(std::uint64_t& tfunc_time, std::uint64_t& exec_time,
+                util::sharded_histogram* phase_durations = nullptr,
+                double timestamp_scale = 1.0, std::size_t num_thread = 0)
           : start_timestamp_(util::hardware::timestamp())
           , tfunc_time_(tfunc_time)
           , exec_time_(exec_time)
+          , phase_durations_(phase_durations)
+          , timestamp_scale_(timestamp_scale)
+          , num_thread_(num_thread)
         {}
 
         void collect_exec_time(std::uint64_t timestamp)
         {
-            exec_time_ += util::hardware::timestamp() - timestamp;
+            std::uint64_t duration = util::hardware::timestamp() - timestamp;
+            exec_time_ += duration;
+
+            // record the duration of this thread phase [ns]
+            if (phase_durations_)
+            {
+                phase_durations_->record(static_cast<std::uint64_t>(
+                    double(duration) * timestamp_scale_), num_thread_);
+            }
         }
         void take_snapshot()
         {
@@ -150,6 +165,10 @@ namespace hpx { namespace threads { namespace detail
 
         std::uint64_t& tfunc_time_;
         std::uint64_t& exec_time_;
+
+        util::sharded_histogram* phase_durations_;
+        double timestamp_scale_;
+        std::size_t num_thread_;
     };
 
     struct exec_time_wrapper
@@ -183,7 +202,10 @@ namespace hpx { namespace threads { namespace detail
 #else
     struct idle_collect_rate
     {
-        idle_collect_rate(std::uint64_t&, std::uint64_t&) {}
+        idle_collect_rate(std::uint64_t&, std::uint64_t&,
+            util::sharded_histogram* = nullptr, double = 1.0,
+            std::size_t = 0)
+        {}
     };
 
     struct exec_time_wrapper
@@ -202,17 +224,25 @@ namespace hpx { namespace threads { namespace detail
     {
         scheduling_counters(std::int64_t& executed_threads,
                 std::int64_t& executed_thread_phases,
-                std::uint64_t& tfunc_time, std::uint64_t& exec_time)
+                std::uint64_t& tfunc_time, std::uint64_t& exec_time,
+                util::sharded_histogram* phase_durations = nullptr,
+                double timestamp_scale = 1.0)
           : executed_threads_(executed_threads),
             executed_thread_phases_(executed_thread_phases),
             tfunc_time_(tfunc_time),
-            exec_time_(exec_time)
+            exec_time_(exec_time),
+            phase_durations_(phase_durations),
+            timestamp_scale_(timestamp_scale)
         {}
 
         std::int64_t& executed_threads_;
         std::int64_t& executed_thread_phases_;
         std::uint64_t& tfunc_time_;
         std::uint64_t& exec_time_;
+
+        // if set, the duration of each thread phase is recorded here
+        util::sharded_histogram* phase_durations_;
+        double timestamp_scale_;
     };
 
     struct scheduling_callbacks
@@ -228,17 +258,26 @@ namespace hpx { namespace threads { namespace detail
                 std::size_t max_background_threads =
                     hpx::util::safe_lexical_cast<std::size_t>(
                         hpx::get_config_entry("hpx.max_background_threads",
-                            (std::numeric_limits<std::size_t>::max)())))
+                            (std::numeric_limits<std::size_t>::max)())),
+                boost::int64_t max_idle_loop_count =
+                    hpx::util::safe_lexical_cast<boost::int64_t>(
+                        hpx::get_config_entry("hpx.max_idle_loop_count",
+                            HPX_IDLE_LOOP_COUNT_MAX)))
           : outer_(std::move(outer)),
             inner_(std::move(inner)),
             background_(std::move(background)),
-            max_background_threads_(max_background_threads)
+            max_background_threads_(max_background_threads),
+            max_idle_loop_count_(max_idle_loop_count)
         {}
 
         callback_type outer_;
         callback_type inner_;
         background_callback_type background_;
         std::size_t max_background_threads_;
+
+        // number of idle iterations before calling outer_ (which might park
+        // the worker thread)
+        boost::int64_t max_idle_loop_count_;
     };
 
     template <typename SchedulingPolicy>
@@ -255,7 +294,8 @@ namespace hpx { namespace threads { namespace detail
         boost::int64_t idle_loop_count = 0;
         boost::int64_t busy_loop_count = 0;
 
-        idle_collect_rate idle_rate(counters.tfunc_time_, counters.exec_time_);
+        idle_collect_rate idle_rate(counters.tfunc_time_, counters.exec_time_,
+            counters.phase_durations_, counters.timestamp_scale_, num_thread);
         tfunc_time_wrapper tfunc_time_collector(idle_rate);
 
         scheduler.SchedulingPolicy::start_periodic_maintenance(this_state);
@@ -264,6 +304,10 @@ namespace hpx { namespace threads { namespace detail
         bool may_exit = false;
 
         while (true) {
+            // Wake up the threads whose timed suspension has expired
+            if (detail::poll_timers(scheduler, num_thread))
+                idle_loop_count = 0;
+
             // Get the next HPX thread from the queue
             thread_data* thrd = nullptr;
 
@@ -461,10 +505,10 @@ namespace hpx { namespace threads { namespace detail
                 }
             }
             else if ((scheduler.get_scheduler_mode() & policies::fast_idle_mode) ||
-                idle_loop_count > HPX_IDLE_LOOP_COUNT_MAX)
+                idle_loop_count > callbacks.max_idle_loop_count_)
             {
                 // clean up terminated threads
-                if (idle_loop_count > HPX_IDLE_LOOP_COUNT_MAX)
+                if (idle_loop_count > callbacks.max_idle_loop_count_)
                     idle_loop_count = 0;
 
                 // call back into invoking context
@@ -487,6 +531,9 @@ namespace hpx { namespace threads { namespace detail
                 }
             }
         }
+
+        // the remaining timers must not keep any threads alive
+        scheduler.get_timers(num_thread).clear();
     }
 }}}
 
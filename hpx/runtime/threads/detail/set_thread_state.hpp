@@ -7,26 +7,22 @@
 #define HPX_RUNTIME_THREADS_DETAIL_SET_THREAD_STATE_JAN_13_2013_0518PM
 
 #include <hpx/config.hpp>
-#include <hpx/config/asio.hpp>
 #include <hpx/error_code.hpp>
 #include <hpx/runtime/threads/coroutines/coroutine.hpp>
 #include <hpx/runtime/threads/detail/create_thread.hpp>
 #include <hpx/runtime/threads/detail/create_work.hpp>
+#include <hpx/runtime/threads/detail/timer_wheel.hpp>
 #include <hpx/runtime/threads/thread_data.hpp>
 #include <hpx/runtime/threads/thread_helpers.hpp>
 #include <hpx/runtime_fwd.hpp>
 #include <hpx/throw_exception.hpp>
 #include <hpx/util/bind.hpp>
-#include <hpx/util/chrono_traits.hpp>
-#include <hpx/util/io_service_pool.hpp>
 #include <hpx/util/logging.hpp>
 #include <hpx/util/steady_clock.hpp>
 
-#include <boost/asio/basic_deadline_timer.hpp>
-#include <boost/atomic.hpp>
-
 #include <chrono>
 #include <memory>
+#include <vector>
 
 namespace hpx { namespace threads { namespace detail
 {
@@ -232,134 +228,49 @@ namespace hpx { namespace threads { namespace detail
     }
 
     ///////////////////////////////////////////////////////////////////////////
-    /// This thread function is used by the at_timer thread below to trigger
-    /// the required action.
-    inline thread_state_enum wake_timer_thread(
-        thread_id_type const& thrd, thread_state_enum newstate,
-        thread_state_ex_enum newstate_ex, thread_priority priority,
-        thread_id_type const& timer_id,
-        std::shared_ptr<boost::atomic<bool> > const& triggered)
-    {
-        if (HPX_UNLIKELY(!thrd)) {
-            HPX_THROW_EXCEPTION(null_thread_id,
-                "threads::detail::wake_timer_thread",
-                "null thread id encountered (id)");
-            return terminated;
-        }
-        if (HPX_UNLIKELY(!timer_id)) {
-            HPX_THROW_EXCEPTION(null_thread_id,
-                "threads::detail::wake_timer_thread",
-                "null thread id encountered (timer_id)");
-            return terminated;
-        }
-
-        bool oldvalue = false;
-        if (triggered->compare_exchange_strong(oldvalue, true)) //-V601
-        {
-            // timer has not been canceled yet, trigger the requested set_state
-            detail::set_thread_state(thrd, newstate, newstate_ex, priority);
-        }
-
-        // then re-activate the thread holding the deadline_timer
-        error_code ec(lightweight);    // do not throw
-        detail::set_thread_state(timer_id, pending, wait_timeout,
-            thread_priority_boost, std::size_t(-1), ec);
-        return terminated;
-    }
-
-    /// This thread function initiates the required set_state action (on
-    /// behalf of one of the threads#detail#set_thread_state functions).
+    /// Set a timer to set the state of the given \a thread to the given
+    /// new value after it expired (at the given time). The timer is armed in
+    /// the timing wheel of the scheduler, the returned entry can be used to
+    /// cancel it.
     template <typename SchedulingPolicy>
-    thread_state_enum at_timer(SchedulingPolicy& scheduler,
-        util::steady_clock::time_point& abs_time,
-        thread_id_type const& thrd, thread_state_enum newstate,
-        thread_state_ex_enum newstate_ex, thread_priority priority)
+    timer_entry_ptr set_thread_state_timer(SchedulingPolicy& scheduler,
+        util::steady_time_point const& abs_time, thread_id_type const& thrd,
+        thread_state_enum newstate, thread_state_ex_enum newstate_ex,
+        thread_priority priority, std::size_t thread_num, error_code& ec)
     {
         if (HPX_UNLIKELY(!thrd)) {
-            HPX_THROW_EXCEPTION(null_thread_id,
-                "threads::detail::at_timer",
+            HPX_THROWS_IF(ec, null_thread_id,
+                "threads::detail::set_thread_state",
                 "null thread id encountered");
-            return terminated;
+            return timer_entry_ptr();
         }
 
-        // create a new thread in suspended state, which will execute the
-        // requested set_state when timer fires and will re-awaken this thread,
-        // allowing the deadline_timer to go out of scope gracefully
-        thread_id_type self_id = get_self_id();
-
-        std::shared_ptr<boost::atomic<bool> > triggered(
-            std::make_shared<boost::atomic<bool> >(false));
-
-        thread_init_data data(
-            util::bind(&wake_timer_thread,
-                thrd, newstate, newstate_ex, priority,
-                self_id, triggered),
-            "wake_timer", 0, priority);
-
-        thread_id_type wake_id = invalid_thread_id;
-        create_thread(&scheduler, data, wake_id, suspended);
+        timer_entry_ptr timer = std::make_shared<timer_entry>(thrd,
+            timer_wheel::to_ns(abs_time.value()), newstate, newstate_ex,
+            priority, thread_num);
+        scheduler.add_timer(timer);
 
-        // create timer firing in correspondence with given time
-        typedef boost::asio::basic_deadline_timer<
-            util::steady_clock
-          , util::chrono_traits<util::steady_clock>
-        > deadline_timer;
-
-        deadline_timer t (
-            get_thread_pool("timer-pool")->get_io_service(), abs_time);
-
-        // let the timer invoke the set_state on the new (suspended) thread
-        t.async_wait(util::bind(&detail::set_thread_state,
-            wake_id, pending, wait_timeout, priority,
-            std::size_t(-1), boost::ref(throws)));
-
-        // this waits for the thread to be reactivated when the timer fired
-        // if it returns signaled the timer has been canceled, otherwise
-        // the timer fired and the wake_timer_thread above has been executed
-        thread_state_ex_enum statex = get_self().yield(suspended);
-
-        if (wait_timeout != statex) //-V601
-        {
-            triggered->store(true);
-
-            // wake_timer_thread has not been executed yet, cancel timer
-            t.cancel();
-
-            // cancel wake_timer_thread
-            error_code ec(lightweight);    // do not throw
-            detail::set_thread_state(wake_id, pending, wait_abort,
-                priority, std::size_t(-1), ec);
-        }
+        if (&ec != &throws)
+            ec = make_success_code();
 
-        return terminated;
+        return timer;
     }
 
     /// Set a timer to set the state of the given \a thread to the given
     /// new value after it expired (at the given time)
+    ///
+    /// \note The timer does not run as a separate thread anymore, the
+    ///       returned id is always invalid. Use set_thread_state_timer if
+    ///       the timer needs to be canceled.
     template <typename SchedulingPolicy>
     thread_id_type set_thread_state_timed(SchedulingPolicy& scheduler,
         util::steady_time_point const& abs_time, thread_id_type const& thrd,
         thread_state_enum newstate, thread_state_ex_enum newstate_ex,
         thread_priority priority, std::size_t thread_num, error_code& ec)
     {
-        if (HPX_UNLIKELY(!thrd)) {
-            HPX_THROWS_IF(ec, null_thread_id,
-                "threads::detail::set_thread_state",
-                "null thread id encountered");
-            return nullptr;
-        }
-
-        // this creates a new thread which creates the timer and handles the
-        // requested actions
-        thread_init_data data(
-            util::bind(&at_timer<SchedulingPolicy>,
-                boost::ref(scheduler), abs_time.value(), thrd, newstate, newstate_ex,
-                priority),
-            "at_timer (expire at)", 0, priority, thread_num);
-
-        thread_id_type newid = invalid_thread_id;
-        create_thread(&scheduler, data, newid, pending, true, ec); //-V601
-        return newid;
+        set_thread_state_timer(scheduler, abs_time, thrd, newstate,
+            newstate_ex, priority, thread_num, ec);
+        return invalid_thread_id;
     }
 
     template <typename SchedulingPolicy>
@@ -391,6 +302,36 @@ namespace hpx { namespace threads { namespace detail
         return set_thread_state_timed(scheduler, rel_time.from_now(), thrd,
             pending, wait_timeout, thread_priority_normal, std::size_t(-1), ec);
     }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Perform the state changes of all timers armed on the given worker
+    /// thread which have expired, returns whether any timer has fired.
+    template <typename SchedulingPolicy>
+    bool poll_timers(SchedulingPolicy& scheduler, std::size_t num_thread)
+    {
+        timer_wheel& timers = scheduler.get_timers(num_thread);
+        if (timers.size() == 0)
+            return false;
+
+        std::vector<timer_entry_ptr> expired;
+        if (!timers.expire(timer_wheel::now(), expired))
+            return false;
+
+        bool fired = false;
+        for (timer_entry_ptr const& timer : expired)
+        {
+            thread_id_type thrd = timer->trigger();
+            if (!thrd)
+                continue;               // the timer has been canceled
+
+            error_code ec(lightweight);    // do not throw
+            detail::set_thread_state(thrd, timer->get_state(),
+                timer->get_state_ex(), timer->get_priority(),
+                timer->get_thread_num(), ec);
+            fired = true;
+        }
+        return fired;
+    }
 }}}
 
 #endif
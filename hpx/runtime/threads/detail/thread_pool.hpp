@@ -15,6 +15,7 @@
 #include <hpx/runtime/threads/thread_init_data.hpp>
 #include <hpx/runtime/threads/topology.hpp>
 #include <hpx/state.hpp>
+#include <hpx/util/sharded_histogram.hpp>
 #include <hpx/util/steady_clock.hpp>
 
 #include <boost/atomic.hpp>
@@ -104,6 +105,11 @@ namespace hpx { namespace threads { namespace detail
         std::int64_t avg_idle_rate(bool reset);
         std::int64_t avg_idle_rate(std::size_t num_thread, bool reset);
 
+        util::sharded_histogram& get_phase_durations()
+        {
+            return phase_durations_;
+        }
+
 #if defined(HPX_HAVE_THREAD_CREATION_AND_CLEANUP_RATES)
         std::int64_t avg_creation_idle_rate(bool reset);
         std::int64_t avg_cleanup_idle_rate(bool reset);
@@ -127,6 +133,11 @@ namespace hpx { namespace threads { namespace detail
         std::int64_t get_num_stolen_to_pending(std::size_t num, bool reset);
         std::int64_t get_num_stolen_from_staged(std::size_t num, bool reset);
         std::int64_t get_num_stolen_to_staged(std::size_t num, bool reset);
+
+        std::int64_t get_num_stolen_in_core(std::size_t num, bool reset);
+        std::int64_t get_num_stolen_in_numa_domain(std::size_t num, bool reset);
+        std::int64_t get_num_stolen_outside_numa_domain(std::size_t num,
+            bool reset);
 #endif
 
         std::int64_t get_thread_count(thread_state_enum state,
@@ -209,6 +220,9 @@ namespace hpx { namespace threads { namespace detail
         std::vector<std::uint64_t> reset_idle_rate_time_;
         std::vector<std::uint64_t> reset_idle_rate_time_total_;
 
+        // durations of the executed thread phases [ns]
+        util::sharded_histogram phase_durations_;
+
 #if defined(HPX_HAVE_THREAD_CREATION_AND_CLEANUP_RATES)
         std::vector<std::uint64_t> reset_creation_idle_rate_time_;
         std::vector<std::uint64_t> reset_creation_idle_rate_time_total_;
@@ -0,0 +1,355 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_RUNTIME_THREADS_DETAIL_TIMER_WHEEL_OCT_18_2016_0610PM)
+#define HPX_RUNTIME_THREADS_DETAIL_TIMER_WHEEL_OCT_18_2016_0610PM
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/threads/thread_data_fwd.hpp>
+#include <hpx/runtime/threads/thread_enums.hpp>
+#include <hpx/util/spinlock.hpp>
+#include <hpx/util/steady_clock.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace hpx { namespace threads { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // A state change of a thread which has to happen at the given deadline,
+    // see timer_wheel below.
+    class timer_entry
+    {
+    public:
+        timer_entry(thread_id_type const& thrd, boost::uint64_t deadline,
+                thread_state_enum newstate, thread_state_ex_enum newstate_ex,
+                thread_priority priority, std::size_t thread_num)
+          : thrd_(thrd), deadline_(deadline), newstate_(newstate),
+            newstate_ex_(newstate_ex), priority_(priority),
+            thread_num_(thread_num), triggered_(false)
+        {}
+
+        boost::uint64_t get_deadline() const { return deadline_; }
+        thread_state_enum get_state() const { return newstate_; }
+        thread_state_ex_enum get_state_ex() const { return newstate_ex_; }
+        thread_priority get_priority() const { return priority_; }
+        std::size_t get_thread_num() const { return thread_num_; }
+
+        // Prevent the state change from happening, returns false if the
+        // timer has fired already. The reference to the thread is released
+        // right away, the (empty) entry is discarded by the wheel later on.
+        bool cancel()
+        {
+            if (triggered_.exchange(true))
+                return false;
+            thrd_.reset();
+            return true;
+        }
+
+        // Take the thread whose state has to be changed, returns an empty
+        // id if the timer has been canceled.
+        thread_id_type trigger()
+        {
+            thread_id_type thrd;
+            if (!triggered_.exchange(true))
+                thrd.swap(thrd_);
+            return thrd;
+        }
+
+        bool is_triggered() const
+        {
+            return triggered_.load(boost::memory_order_relaxed);
+        }
+
+    private:
+        thread_id_type thrd_;
+        boost::uint64_t deadline_;              // [ns]
+        thread_state_enum newstate_;
+        thread_state_ex_enum newstate_ex_;
+        thread_priority priority_;
+        std::size_t thread_num_;
+        boost::atomic<bool> triggered_;
+    };
+
+    typedef std::shared_ptr<timer_entry> timer_entry_ptr;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // A hierarchical timing wheel (Varghese and Lauck) holding the timers
+    // armed on one worker thread. Level 0 has one slot per tick, a slot of
+    // level n spans 64^n ticks, its timers are redistributed to the lower
+    // levels once the wheel reaches it. Timers beyond the range of the
+    // wheel (~18 minutes) wait in an overflow list.
+    //
+    // Arming a timer is O(1), canceling it only marks the entry. The owning
+    // worker thread collects the expired timers from its scheduling loop,
+    // all other threads only ever add timers.
+    class timer_wheel
+    {
+    private:
+        HPX_NON_COPYABLE(timer_wheel);
+
+    public:
+        enum
+        {
+            tick_bits = 16,                     // one tick is 2^16ns (~66us)
+            slot_bits = 6,
+            num_slots = 1 << slot_bits,
+            num_levels = 4
+        };
+
+        typedef hpx::util::spinlock mutex_type;
+
+        timer_wheel()
+          : current_tick_(to_tick(now())), next_tick_(no_tick()), count_(0)
+        {
+            std::fill(occupied_, occupied_ + num_levels, 0);
+        }
+
+        static boost::uint64_t now()
+        {
+            return to_ns(util::steady_clock::now());
+        }
+
+        static boost::uint64_t to_ns(util::steady_clock::time_point const& t)
+        {
+            return static_cast<boost::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    t.time_since_epoch()).count());
+        }
+
+        // number of armed timers, including canceled timers which have not
+        // been discarded yet
+        std::size_t size() const
+        {
+            return count_.load(boost::memory_order_acquire);
+        }
+
+        // the time [ns] the wheel has to be polled next, the deadline of
+        // the earliest timer is never later than that
+        boost::uint64_t next_deadline() const
+        {
+            boost::uint64_t tick = next_tick_.load(boost::memory_order_acquire);
+            return tick == no_tick() ? tick : tick << tick_bits;
+        }
+
+        void add(timer_entry_ptr const& timer)
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+
+            // an empty wheel may skip all ticks which have passed
+            if (count_.load(boost::memory_order_relaxed) == 0)
+                current_tick_ = (std::max)(current_tick_, to_tick(now()));
+
+            boost::uint64_t tick = insert(timer);
+            count_.fetch_add(1, boost::memory_order_release);
+
+            if (tick < next_tick_.load(boost::memory_order_relaxed))
+                next_tick_.store(tick, boost::memory_order_release);
+        }
+
+        // Move all timers which have expired at the given time [ns] to
+        // 'expired', returns whether any timer was found.
+        bool expire(boost::uint64_t now, std::vector<timer_entry_ptr>& expired)
+        {
+            if (next_deadline() > now)
+                return false;
+
+            boost::uint64_t const now_tick = to_tick(now);
+            std::size_t const size = expired.size();
+
+            std::lock_guard<mutex_type> l(mtx_);
+            while (current_tick_ <= now_tick &&
+                count_.load(boost::memory_order_relaxed) != 0)
+            {
+                std::size_t index = current_tick_ & slot_mask;
+                if (index == 0)
+                    cascade(1);
+
+                boost::uint64_t bits = occupied_[0] >> index;
+                if (bits == 0)
+                {
+                    // nothing left in this block of level 0
+                    current_tick_ = (std::min)(
+                        (current_tick_ | slot_mask) + 1, now_tick + 1);
+                    continue;
+                }
+
+                index += first_set(bits);
+                boost::uint64_t tick = (current_tick_ & ~boost::uint64_t(
+                    slot_mask)) + index;
+                if (tick > now_tick)
+                {
+                    current_tick_ = now_tick + 1;
+                    break;
+                }
+
+                std::vector<timer_entry_ptr>& slot = slots_[0][index];
+                for (timer_entry_ptr& timer : slot)
+                {
+                    if (!timer->is_triggered())
+                        expired.push_back(std::move(timer));
+                }
+                count_.fetch_sub(slot.size(), boost::memory_order_release);
+                slot.clear();
+                occupied_[0] &= ~(boost::uint64_t(1) << index);
+
+                current_tick_ = tick + 1;
+            }
+            if (current_tick_ <= now_tick)
+                current_tick_ = now_tick + 1;
+
+            next_tick_.store(compute_next_tick(), boost::memory_order_release);
+            return expired.size() != size;
+        }
+
+        // Discard all timers without firing them.
+        void clear()
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+            for (std::size_t level = 0; level != num_levels; ++level)
+            {
+                for (std::size_t i = 0; i != num_slots; ++i)
+                    slots_[level][i].clear();
+                occupied_[level] = 0;
+            }
+            overflow_.clear();
+            count_.store(0, boost::memory_order_release);
+            next_tick_.store(no_tick(), boost::memory_order_release);
+        }
+
+    private:
+        static boost::uint64_t const slot_mask = num_slots - 1;
+
+        static boost::uint64_t no_tick()
+        {
+            return (std::numeric_limits<boost::uint64_t>::max)();
+        }
+
+        static boost::uint64_t to_tick(boost::uint64_t ns)
+        {
+            return ns >> tick_bits;
+        }
+
+        static std::size_t first_set(boost::uint64_t bits)
+        {
+#if defined(__GNUC__)
+            return static_cast<std::size_t>(__builtin_ctzll(bits));
+#else
+            std::size_t index = 0;
+            while (!(bits & 1))
+            {
+                bits >>= 1;
+                ++index;
+            }
+            return index;
+#endif
+        }
+
+        // Put the timer into the lowest level whose current block contains
+        // its deadline, returns the tick the timer has been filed for.
+        boost::uint64_t insert(timer_entry_ptr const& timer)
+        {
+            // round up, timers may fire late but never early
+            boost::uint64_t tick = (std::max)(
+                to_tick(timer->get_deadline() + (1 << tick_bits) - 1),
+                current_tick_);
+
+            for (std::size_t level = 0; level != num_levels; ++level)
+            {
+                std::size_t block = (level + 1) * slot_bits;
+                if ((tick >> block) == (current_tick_ >> block))
+                {
+                    std::size_t index =
+                        (tick >> (level * slot_bits)) & slot_mask;
+                    slots_[level][index].push_back(timer);
+                    occupied_[level] |= boost::uint64_t(1) << index;
+                    return tick;
+                }
+            }
+
+            overflow_.push_back(timer);
+            return tick;
+        }
+
+        // The wheel has reached the beginning of a new block of the level
+        // below, redistribute the timers of the corresponding slot.
+        void cascade(std::size_t level)
+        {
+            std::size_t index =
+                (current_tick_ >> (level * slot_bits)) & slot_mask;
+
+            if (index == 0)
+            {
+                if (level + 1 != num_levels)
+                {
+                    cascade(level + 1);
+                }
+                else if (!overflow_.empty())
+                {
+                    std::vector<timer_entry_ptr> timers;
+                    timers.swap(overflow_);
+                    reinsert(timers);
+                }
+            }
+
+            boost::uint64_t bit = boost::uint64_t(1) << index;
+            if (!(occupied_[level] & bit))
+                return;
+
+            std::vector<timer_entry_ptr> timers;
+            timers.swap(slots_[level][index]);
+            occupied_[level] &= ~bit;
+            reinsert(timers);
+        }
+
+        void reinsert(std::vector<timer_entry_ptr>& timers)
+        {
+            for (timer_entry_ptr const& timer : timers)
+            {
+                if (timer->is_triggered())
+                    count_.fetch_sub(1, boost::memory_order_release);
+                else
+                    insert(timer);
+            }
+        }
+
+        boost::uint64_t compute_next_tick() const
+        {
+            if (count_.load(boost::memory_order_relaxed) == 0)
+                return no_tick();
+
+            // the wheel still has to cascade into this block
+            std::size_t index = current_tick_ & slot_mask;
+            if (index == 0)
+                return current_tick_;
+
+            boost::uint64_t bits = occupied_[0] >> index;
+            if (bits == 0)
+                return (current_tick_ | slot_mask) + 1;
+
+            return (current_tick_ & ~boost::uint64_t(slot_mask)) + index +
+                first_set(bits);
+        }
+
+        mutable mutex_type mtx_;
+        boost::uint64_t current_tick_;          // all earlier ticks are done
+        boost::atomic<boost::uint64_t> next_tick_;
+        boost::atomic<std::size_t> count_;
+
+        boost::uint64_t occupied_[num_levels];  // one bit per non-empty slot
+        std::vector<timer_entry_ptr> slots_[num_levels][num_slots];
+        std::vector<timer_entry_ptr> overflow_;
+    };
+}}}
+
+#endif
@@ -15,11 +15,13 @@
 #include <hpx/runtime/threads/topology.hpp>
 #include <hpx/runtime/threads_fwd.hpp>
 #include <hpx/throw_exception.hpp>
+#include <hpx/util/get_and_reset_value.hpp>
 #include <hpx/util/logging.hpp>
 
 #include <boost/atomic.hpp>
 #include <boost/exception_ptr.hpp>
 
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <type_traits>
@@ -71,10 +73,21 @@ namespace hpx { namespace threads { namespace policies
             Mutex, PendingQueuing, StagedQueuing, TerminatedQueuing
         > thread_queue_type;
 
+        // The levels of the machine hierarchy used for hierarchical stealing.
+        // Victims are tried in the order of these levels.
+        enum steal_level
+        {
+            steal_in_core = 0,              ///< victim shares the core
+            steal_in_numa_domain = 1,       ///< victim shares the NUMA domain
+            steal_outside_numa_domain = 2,  ///< any other victim
+            num_steal_levels = 3
+        };
+
         // the scheduler type takes two initialization parameters:
         //    the number of queues
         //    the number of high priority queues
         //    the maxcount per queue
+        //    whether to steal hierarchically (set separately)
         struct init_parameter
         {
             init_parameter()
@@ -82,6 +95,7 @@ namespace hpx { namespace threads { namespace policies
                 num_high_priority_queues_(1),
                 max_queue_thread_count_(max_thread_count),
                 numa_sensitive_(0),
+                hierarchical_stealing_(false),
                 description_("local_priority_queue_scheduler")
             {}
 
@@ -96,6 +110,7 @@ namespace hpx { namespace threads { namespace policies
                         num_queues : num_high_priority_queues),
                 max_queue_thread_count_(max_queue_thread_count),
                 numa_sensitive_(numa_sensitive),
+                hierarchical_stealing_(false),
                 description_(description)
             {}
 
@@ -104,6 +119,7 @@ namespace hpx { namespace threads { namespace policies
                 num_high_priority_queues_(num_queues),
                 max_queue_thread_count_(max_thread_count),
                 numa_sensitive_(false),
+                hierarchical_stealing_(false),
                 description_(description)
             {}
 
@@ -111,6 +127,7 @@ namespace hpx { namespace threads { namespace policies
             std::size_t num_high_priority_queues_;
             std::size_t max_queue_thread_count_;
             std::size_t numa_sensitive_;
+            bool hierarchical_stealing_;
             char const* description_;
         };
         typedef init_parameter init_parameter_type;
@@ -130,11 +147,16 @@ namespace hpx { namespace threads { namespace policies
 #endif
 #if !defined(HPX_HAVE_MORE_THAN_64_THREADS) || defined(HPX_HAVE_MAX_CPU_COUNT)
             numa_domain_masks_(init.num_queues_),
-            outside_numa_domain_masks_(init.num_queues_)
+            outside_numa_domain_masks_(init.num_queues_),
 #else
             numa_domain_masks_(init.num_queues_, topology_.get_machine_affinity_mask()),
             outside_numa_domain_masks_(init.num_queues_,
-                topology_.get_machine_affinity_mask())
+                topology_.get_machine_affinity_mask()),
+#endif
+            hierarchical_stealing_(init.hierarchical_stealing_),
+            victim_threads_(init.num_queues_)
+#ifdef HPX_HAVE_THREAD_STEALING_COUNTS
+          , steal_counts_(new steal_counts[init.num_queues_])
 #endif
         {
 #if !defined(HPX_NATIVE_MIC)        // we know that the MIC has one NUMA domain only
@@ -165,6 +187,7 @@ namespace hpx { namespace threads { namespace policies
         }
 
         bool numa_sensitive() const { return numa_sensitive_ != 0; }
+        bool hierarchical_stealing() const { return hierarchical_stealing_; }
 
         static std::string get_scheduler_name()
         {
@@ -414,6 +437,57 @@ namespace hpx { namespace threads { namespace policies
             }
             return num_stolen_threads;
         }
+
+        // number of HPX-threads and task descriptions stolen by the given
+        // worker thread from each level of the machine hierarchy (used for
+        // hierarchical stealing only)
+        boost::int64_t get_num_stolen_at_level(std::size_t num_thread,
+            steal_level level, bool reset)
+        {
+            if (num_thread == std::size_t(-1))
+            {
+                boost::int64_t num_stolen_threads = 0;
+                for (std::size_t i = 0; i != queues_.size(); ++i)
+                {
+                    num_stolen_threads += util::get_and_reset_value(
+                        steal_counts_[i].stolen_[level], reset);
+                }
+                return num_stolen_threads;
+            }
+
+            HPX_ASSERT(num_thread < queues_.size());
+            return util::get_and_reset_value(
+                steal_counts_[num_thread].stolen_[level], reset);
+        }
+
+        boost::int64_t get_num_stolen_in_core(std::size_t num_thread,
+            bool reset)
+        {
+            return get_num_stolen_at_level(num_thread, steal_in_core, reset);
+        }
+
+        boost::int64_t get_num_stolen_in_numa_domain(std::size_t num_thread,
+            bool reset)
+        {
+            return get_num_stolen_at_level(num_thread, steal_in_numa_domain,
+                reset);
+        }
+
+        boost::int64_t get_num_stolen_outside_numa_domain(
+            std::size_t num_thread, bool reset)
+        {
+            return get_num_stolen_at_level(num_thread,
+                steal_outside_numa_domain, reset);
+        }
+
+        void increment_num_stolen_at_level(std::size_t num_thread,
+            steal_level level, std::size_t num = 1)
+        {
+            steal_counts_[num_thread].stolen_[level] += num;
+        }
+#else
+        void increment_num_stolen_at_level(std::size_t num_thread,
+            steal_level level, std::size_t num = 1) {}
 #endif
 
         ///////////////////////////////////////////////////////////////////////
@@ -536,7 +610,16 @@ namespace hpx { namespace threads { namespace policies
                     return false;
             }
 
-            if (numa_sensitive_ != 0)   // limited or no stealing across domains
+            if (hierarchical_stealing_) // steal along the machine hierarchy
+            {
+                for (steal_victim const& victim : victim_threads_[num_thread])
+                {
+                    if (steal_pending(num_thread, victim, thrd))
+                        return true;
+                }
+            }
+
+            else if (numa_sensitive_ != 0)   // limited or no stealing across domains
             {
 
                 // steal thread from other queue of same NUMA domain
@@ -562,7 +645,7 @@ namespace hpx { namespace threads { namespace policies
                             num_thread < high_priority_queues)
                         {
                             thread_queue_type* q = high_priority_queues_[idx];
-                            if (q->get_next_thread(thrd))
+                            if (q->get_next_thread(thrd, true))
                             {
                                 q->increment_num_stolen_from_pending();
                                 this_high_priority_queue->
@@ -571,7 +654,7 @@ namespace hpx { namespace threads { namespace policies
                             }
                         }
 
-                        if (queues_[idx]->get_next_thread(thrd))
+                        if (queues_[idx]->get_next_thread(thrd, true))
                         {
                             queues_[idx]->increment_num_stolen_from_pending();
                             this_queue->increment_num_stolen_to_pending();
@@ -601,7 +684,7 @@ namespace hpx { namespace threads { namespace policies
                             num_thread < high_priority_queues)
                         {
                             thread_queue_type* q = high_priority_queues_[idx];
-                            if (q->get_next_thread(thrd))
+                            if (q->get_next_thread(thrd, true))
                             {
                                 q->increment_num_stolen_from_pending();
                                 this_high_priority_queue->
@@ -610,7 +693,7 @@ namespace hpx { namespace threads { namespace policies
                             }
                         }
 
-                        if (queues_[idx]->get_next_thread(thrd))
+                        if (queues_[idx]->get_next_thread(thrd, true))
                         {
                             queues_[idx]->increment_num_stolen_from_pending();
                             this_queue->increment_num_stolen_to_pending();
@@ -634,7 +717,7 @@ namespace hpx { namespace threads { namespace policies
                         num_thread < high_priority_queues)
                     {
                         thread_queue_type* q = high_priority_queues_[idx];
-                        if (q->get_next_thread(thrd))
+                        if (q->get_next_thread(thrd, true))
                         {
                             q->increment_num_stolen_from_pending();
                             this_high_priority_queue->
@@ -643,7 +726,7 @@ namespace hpx { namespace threads { namespace policies
                         }
                     }
 
-                    if (queues_[idx]->get_next_thread(thrd))
+                    if (queues_[idx]->get_next_thread(thrd, true))
                     {
                         queues_[idx]->increment_num_stolen_from_pending();
                         this_queue->increment_num_stolen_to_pending();
@@ -984,7 +1067,18 @@ namespace hpx { namespace threads { namespace policies
                 running, idle_loop_count, added) && result;
             if (0 != added) return result;
 
-            if (numa_sensitive_ != 0)   // limited or no cross domain stealing
+            if (hierarchical_stealing_) // steal along the machine hierarchy
+            {
+                for (steal_victim const& victim : victim_threads_[num_thread])
+                {
+                    result = steal_staged(num_thread, victim, running,
+                        idle_loop_count, added) && result;
+                    if (0 != added)
+                        return result;
+                }
+            }
+
+            else if (numa_sensitive_ != 0)   // limited or no cross domain stealing
             {
                 // steal work items: first try to steal from other cores in
                 // the same NUMA node
@@ -1211,6 +1305,13 @@ namespace hpx { namespace threads { namespace policies
                 outside_numa_domain_masks_[num_thread] =
                     not_(node_mask) & machine_mask;
             }
+
+            if (hierarchical_stealing_)
+            {
+                init_victim_threads(num_thread,
+                    numa_sensitive_ == 0 || (numa_sensitive_ == 1 &&
+                        any(first_mask & core_mask)));
+            }
         }
 
         void on_stop_thread(std::size_t num_thread)
@@ -1239,6 +1340,157 @@ namespace hpx { namespace threads { namespace policies
         }
 
     protected:
+        struct steal_victim
+        {
+            std::size_t num_thread_;
+            steal_level level_;
+        };
+
+        // Pre-calculate the list of queues the given worker thread steals
+        // from. The queues of threads running on the same core are tried
+        // first, then those in the same NUMA domain, and finally (if allowed)
+        // all others, where threads on the same socket are preferred. Inside
+        // each level victims are rotated by the thread number to spread the
+        // contention.
+        void init_victim_threads(std::size_t num_thread, bool steal_remote)
+        {
+            std::size_t const queues_size = queues_.size();
+            std::size_t const num_pu = get_pu_num(num_thread);
+
+            mask_type core_mask =
+                topology_.get_core_affinity_mask(num_pu, false);
+            mask_type node_mask =
+                topology_.get_numa_node_affinity_mask(num_pu, false);
+            mask_type socket_mask =
+                topology_.get_socket_affinity_mask(num_pu, false);
+
+            std::vector<steal_victim> in_core, in_numa_domain, in_socket,
+                outside_socket;
+
+            for (std::size_t i = 1; i != queues_size; ++i)
+            {
+                std::size_t const idx = (i + num_thread) % queues_size;
+                std::size_t const pu_num = get_pu_num(idx);
+
+                // topologies without any NUMA information are treated as a
+                // single NUMA domain
+                if (any(core_mask) && test(core_mask, pu_num)) //-V600
+                {
+                    steal_victim v = { idx, steal_in_core };
+                    in_core.push_back(v);
+                }
+                else if (!any(node_mask) || test(node_mask, pu_num)) //-V600
+                {
+                    steal_victim v = { idx, steal_in_numa_domain };
+                    in_numa_domain.push_back(v);
+                }
+                else if (steal_remote)
+                {
+                    steal_victim v = { idx, steal_outside_numa_domain };
+                    if (any(socket_mask) && test(socket_mask, pu_num)) //-V600
+                        in_socket.push_back(v);
+                    else
+                        outside_socket.push_back(v);
+                }
+            }
+
+            std::vector<steal_victim>& victims = victim_threads_[num_thread];
+            victims.clear();
+            victims.reserve(queues_size - 1);
+            victims.insert(victims.end(), in_core.begin(), in_core.end());
+            victims.insert(victims.end(),
+                in_numa_domain.begin(), in_numa_domain.end());
+            victims.insert(victims.end(), in_socket.begin(), in_socket.end());
+            victims.insert(victims.end(),
+                outside_socket.begin(), outside_socket.end());
+        }
+
+        // Try to steal a pending HPX-thread from the given victim.
+        bool steal_pending(std::size_t num_thread, steal_victim const& victim,
+            threads::thread_data*& thrd)
+        {
+            std::size_t const high_priority_queues =
+                high_priority_queues_.size();
+            std::size_t const idx = victim.num_thread_;
+
+            if (idx < high_priority_queues && num_thread < high_priority_queues)
+            {
+                thread_queue_type* q = high_priority_queues_[idx];
+                if (q->get_next_thread(thrd, true))
+                {
+                    q->increment_num_stolen_from_pending();
+                    high_priority_queues_[num_thread]->
+                        increment_num_stolen_to_pending();
+                    increment_num_stolen_at_level(num_thread, victim.level_);
+                    return true;
+                }
+            }
+
+            if (queues_[idx]->get_next_thread(thrd, true))
+            {
+                queues_[idx]->increment_num_stolen_from_pending();
+                queues_[num_thread]->increment_num_stolen_to_pending();
+                increment_num_stolen_at_level(num_thread, victim.level_);
+                return true;
+            }
+            return false;
+        }
+
+        // Try to convert task descriptions staged at the given victim into
+        // HPX-threads in our own queues.
+        bool steal_staged(std::size_t num_thread, steal_victim const& victim,
+            bool running, boost::int64_t& idle_loop_count, std::size_t& added)
+        {
+            std::size_t const high_priority_queues =
+                high_priority_queues_.size();
+            std::size_t const idx = victim.num_thread_;
+            bool result = true;
+
+            if (idx < high_priority_queues && num_thread < high_priority_queues)
+            {
+                thread_queue_type* q = high_priority_queues_[idx];
+                thread_queue_type* this_high_priority_queue =
+                    high_priority_queues_[num_thread];
+
+                result = this_high_priority_queue->wait_or_add_new(running,
+                    idle_loop_count, added, q) && result;
+                if (0 != added)
+                {
+                    q->increment_num_stolen_from_staged(added);
+                    this_high_priority_queue->
+                        increment_num_stolen_to_staged(added);
+                    increment_num_stolen_at_level(num_thread, victim.level_,
+                        added);
+                    return result;
+                }
+            }
+
+            thread_queue_type* this_queue = queues_[num_thread];
+            result = this_queue->wait_or_add_new(running, idle_loop_count,
+                added, queues_[idx]) && result;
+            if (0 != added)
+            {
+                queues_[idx]->increment_num_stolen_from_staged(added);
+                this_queue->increment_num_stolen_to_staged(added);
+                increment_num_stolen_at_level(num_thread, victim.level_, added);
+            }
+            return result;
+        }
+
+#ifdef HPX_HAVE_THREAD_STEALING_COUNTS
+        struct steal_counts
+        {
+            steal_counts()
+            {
+                for (std::size_t i = 0; i != num_steal_levels; ++i)
+                    stolen_[i].store(0);
+            }
+
+            boost::atomic<boost::int64_t> stolen_[num_steal_levels];
+            char pad_[64];      // avoid false sharing between workers
+        };
+#endif
+
         std::size_t max_queue_thread_count_;
         std::vector<thread_queue_type*> queues_;
         std::vector<thread_queue_type*> high_priority_queues_;
@@ -1252,6 +1504,12 @@ namespace hpx { namespace threads { namespace policies
 #endif
         std::vector<mask_type> numa_domain_masks_;
         std::vector<mask_type> outside_numa_domain_masks_;
+
+        bool hierarchical_stealing_;
+        std::vector<std::vector<steal_victim> > victim_threads_;
+#ifdef HPX_HAVE_THREAD_STEALING_COUNTS
+        std::unique_ptr<steal_counts[]> steal_counts_;
+#endif
     };
 }}}
 
@@ -10,11 +10,16 @@
 
 #include <hpx/config.hpp>
 
+#include <hpx/util/lockfree/chase_lev_deque.hpp>
 #include <hpx/util/lockfree/deque.hpp>
+#include <boost/atomic.hpp>
 #include <boost/cstdint.hpp>
 #include <boost/lockfree/queue.hpp>
 #include <boost/lockfree/stack.hpp>
 
+#include <cstddef>
+#include <thread>
+
 namespace hpx { namespace threads { namespace policies
 {
 
@@ -183,6 +188,95 @@ struct lockfree_abp_lifo
 
 #endif // HPX_HAVE_ABP_SCHEDULER
 
+///////////////////////////////////////////////////////////////////////////////
+// LIFO for the owning OS thread + FIFO stealing at the opposite end, based on
+// a Chase-Lev work-stealing deque.
+//
+// The Chase-Lev deque allows for push/pop at its bottom end by a single owner
+// only, which is done without any atomic read-modify-write operation. The
+// owner is the (first) OS thread which pops from this queue without stealing,
+// i.e. the worker thread the queue belongs to. Any items pushed by other OS
+// threads (or pushed to the 'other end') go through a separate multi-producer
+// lockfree queue which is drained after the local deque runs dry.
+#if defined(HPX_HAVE_CHASE_LEV_SCHEDULER)
+struct lockfree_chase_lev_lifo;
+
+template <typename T>
+struct lockfree_chase_lev_lifo_backend
+{
+    typedef boost::lockfree::chase_lev_deque<T> container_type;
+    typedef boost::lockfree::queue<T> overflow_container_type;
+    typedef T value_type;
+    typedef T& reference;
+    typedef T const& const_reference;
+    typedef boost::uint64_t size_type;
+
+    lockfree_chase_lev_lifo_backend(
+        size_type initial_size = 0
+      , size_type num_thread = size_type(-1)
+        )
+      : owner_(std::thread::id())
+      , queue_(std::size_t(initial_size))
+      , overflow_queue_(std::size_t(initial_size))
+    {}
+
+    bool push(const_reference val, bool other_end = false)
+    {
+        if (!other_end && is_owner())
+            return queue_.push(val);
+        return overflow_queue_.push(val);
+    }
+
+    bool pop(reference val, bool steal = true)
+    {
+        if (is_owner() || (!steal && try_set_owner()))
+        {
+            if (queue_.pop(val))
+                return true;
+        }
+        else if (queue_.steal(val))
+        {
+            return true;
+        }
+        return overflow_queue_.pop(val);
+    }
+
+    bool empty()
+    {
+        return queue_.empty() && overflow_queue_.empty();
+    }
+
+  private:
+    bool is_owner() const
+    {
+        return owner_.load(boost::memory_order_relaxed) ==
+            std::this_thread::get_id();
+    }
+
+    // The first OS thread popping without stealing becomes the owner.
+    bool try_set_owner()
+    {
+        std::thread::id none;
+        return owner_.compare_exchange_strong(none,
+            std::this_thread::get_id());
+    }
+
+    boost::atomic<std::thread::id> owner_;
+    container_type queue_;
+    overflow_container_type overflow_queue_;
+};
+
+struct lockfree_chase_lev_lifo
+{
+    template <typename T>
+    struct apply
+    {
+        typedef lockfree_chase_lev_lifo_backend<T> type;
+    };
+};
+
+#endif // HPX_HAVE_CHASE_LEV_SCHEDULER
+
 }}}
 
 #endif // HPX_FB3518C8_4493_450E_A823_A9F8A3185B2D
@@ -12,7 +12,9 @@
 
 #include <hpx/config.hpp>
 #include <hpx/runtime/agas/interface.hpp>
+#include <hpx/runtime/get_worker_thread_num.hpp>
 #include <hpx/runtime/parcelset_fwd.hpp>
+#include <hpx/runtime/threads/detail/timer_wheel.hpp>
 #include <hpx/runtime/threads/policies/affinity_data.hpp>
 #include <hpx/runtime/threads/policies/scheduler_mode.hpp>
 #include <hpx/runtime/threads/thread_init_data.hpp>
@@ -43,27 +45,6 @@
 ///////////////////////////////////////////////////////////////////////////////
 namespace hpx { namespace threads { namespace policies
 {
-#if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
-    namespace detail
-    {
-        struct reset_on_exit
-        {
-            reset_on_exit(boost::atomic<boost::int32_t>& counter)
-              : counter_(counter)
-            {
-                ++counter_;
-                HPX_ASSERT(counter_ > 0);
-            }
-            ~reset_on_exit()
-            {
-                HPX_ASSERT(counter_ > 0);
-                --counter_;
-            }
-            boost::atomic<boost::int32_t>& counter_;
-        };
-    }
-#endif
-
     ///////////////////////////////////////////////////////////////////////////
     /// The scheduler_base defines the interface to be implemented by all
     /// scheduler policies
@@ -80,9 +61,11 @@ namespace hpx { namespace threads { namespace policies
           , affinity_data_(num_threads)
           , mode_(mode)
 #if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
-          , wait_count_(0)
+          , parking_(num_threads)
+          , num_parked_(0)
 #endif
           , states_(num_threads)
+          , timers_(num_threads != 0 ? num_threads : 1)
           , description_(description)
         {
             for (std::size_t i = 0; i != num_threads; ++i)
@@ -116,15 +99,78 @@ namespace hpx { namespace threads { namespace policies
             return affinity_data_.init(data, topology);
         }
 
-        void idle_callback(std::size_t /*num_thread*/)
+        /// Park the calling worker thread until work is added for it (see
+        /// do_some_work), the next timer armed on it expires, or a timeout
+        /// has passed. The timeout starts at one millisecond and grows with
+        /// every consecutive call up to the given time [ms].
+        void idle_callback(std::size_t num_thread,
+            boost::int64_t max_idle_backoff_time = 1000)
         {
 #if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
-            // Put this thread to sleep for some time, additionally it gets
-            // woken up on new work.
-            boost::chrono::milliseconds period(++wait_count_);
+            if (num_thread >= parking_.size())
+                return;
+
+            parking_slot& slot = parking_[num_thread];
+
+            boost::int64_t wait_count = ++slot.wait_count_;
+            if (wait_count > max_idle_backoff_time)
+            {
+                wait_count = max_idle_backoff_time;
+                slot.wait_count_.store(
+                    boost::uint32_t(max_idle_backoff_time));
+            }
+
+            boost::chrono::nanoseconds period =
+                boost::chrono::milliseconds(wait_count);
+
+            // do not oversleep the next timer armed on this thread
+            if (num_thread < timers_.size())
+            {
+                boost::uint64_t deadline = timers_[num_thread].next_deadline();
+                boost::uint64_t now = threads::detail::timer_wheel::now();
+                if (deadline <= now)
+                    return;
+                if (deadline - now < boost::uint64_t(period.count()))
+                {
+                    period = boost::chrono::nanoseconds(
+                        static_cast<boost::int64_t>(deadline - now));
+                }
+            }
+
+            slot.state_.store(parking_slot::parked);
+            ++num_parked_;
+
+            // work might have been added before this thread was registered
+            // as being parked (pairs with the fence in do_some_work)
+            boost::atomic_thread_fence(boost::memory_order_seq_cst);
+            if (get_queue_length(num_thread) == 0)
+            {
+                boost::chrono::steady_clock::time_point deadline =
+                    boost::chrono::steady_clock::now() + period;
+
+                boost::unique_lock<boost::mutex> l(slot.mtx_);
+                while (slot.state_.load() == parking_slot::parked)
+                {
+                    if (slot.cond_.wait_until(l, deadline) ==
+                        boost::cv_status::timeout)
+                    {
+                        break;
+                    }
+                }
+            }
 
-            boost::unique_lock<boost::mutex> l(mtx_);
-            cond_.wait_for(l, period);
+            // leave the registry of parked threads, unless this has been
+            // done already by the thread waking us up
+            int expected = parking_slot::parked;
+            if (slot.state_.compare_exchange_strong(
+                    expected, parking_slot::running))
+            {
+                --num_parked_;
+            }
+            else
+            {
+                slot.state_.store(parking_slot::running);
+            }
 #endif
         }
 
@@ -141,19 +187,93 @@ namespace hpx { namespace threads { namespace policies
 
         /// This function gets called by the thread-manager whenever new work
         /// has been added, allowing the scheduler to reactivate one or more of
-        /// possibly idling OS threads
+        /// possibly idling OS threads. The worker thread the work has been
+        /// added for is woken up if it is parked, otherwise the parked worker
+        /// thread closest to it is woken up (it will try to steal the work).
         void do_some_work(std::size_t num_thread)
         {
 #if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
-            wait_count_.store(0, boost::memory_order_release);
+            boost::atomic_thread_fence(boost::memory_order_seq_cst);
+            if (num_parked_.load(boost::memory_order_relaxed) == 0)
+                return;
+
+            std::size_t const num_slots = parking_.size();
+            if (num_thread >= num_slots)
+                num_thread = hpx::get_worker_thread_num();
+
+            std::size_t first = 1;
+            if (num_thread < num_slots)
+            {
+                if (unpark(num_thread))
+                    return;
 
-            if (num_thread == std::size_t(-1))
-                cond_.notify_all();
+                // the worker thread is running, it will not back off for
+                // long once it runs out of work
+                parking_[num_thread].wait_count_.store(0,
+                    boost::memory_order_relaxed);
+            }
             else
-                cond_.notify_one();
+            {
+                // work added from outside of the worker threads
+                num_thread = 0;
+                first = 0;
+            }
+
+            // wake the closest parked worker thread
+            for (std::size_t i = first; i < num_slots; ++i)
+            {
+                std::size_t offset = (i + 1) / 2;
+                std::size_t candidate = (i % 2) ?
+                    (num_thread + offset) % num_slots :
+                    (num_thread + num_slots - offset) % num_slots;
+                if (unpark(candidate))
+                    return;
+            }
+#endif
+        }
+
+        /// Wake up all parked worker threads, for instance while stopping.
+        void unpark_all_workers()
+        {
+#if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
+            for (std::size_t i = 0; i != parking_.size(); ++i)
+                unpark(i);
+#endif
+        }
+
+        /// Arm a timed state change of a thread. The timer is kept in the
+        /// timing wheel of the calling worker thread, timers armed from
+        /// outside of the worker threads go to the wheel of the worker
+        /// thread the state change is targeted at (or the first one).
+        void add_timer(threads::detail::timer_entry_ptr const& timer)
+        {
+            std::size_t const num_wheels = timers_.size();
+            std::size_t num_thread = hpx::get_worker_thread_num();
+            if (num_thread < num_wheels)
+            {
+                timers_[num_thread].add(timer);
+                return;
+            }
+
+            num_thread = timer->get_thread_num();
+            if (num_thread >= num_wheels)
+                num_thread = 0;
+            timers_[num_thread].add(timer);
+
+            // the owning worker thread might be parked
+#if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
+            if (num_thread < parking_.size())
+                unpark(num_thread);
 #endif
         }
 
+        /// Retrieve the timing wheel polled by the given worker thread
+        threads::detail::timer_wheel& get_timers(std::size_t num_thread)
+        {
+            HPX_ASSERT(num_thread < timers_.size());
+            return timers_[num_thread];
+        }
+
         // allow to access/manipulate states
         boost::atomic<hpx::state>& get_state(std::size_t num_thread)
         {
@@ -245,6 +365,24 @@ namespace hpx { namespace threads { namespace policies
             bool reset) = 0;
         virtual boost::int64_t get_num_stolen_to_staged(std::size_t num_thread,
             bool reset) = 0;
+
+        // only schedulers supporting hierarchical stealing count the steals
+        // per level of the machine hierarchy
+        virtual boost::int64_t get_num_stolen_in_core(std::size_t num_thread,
+            bool reset)
+        {
+            return 0;
+        }
+        virtual boost::int64_t get_num_stolen_in_numa_domain(
+            std::size_t num_thread, bool reset)
+        {
+            return 0;
+        }
+        virtual boost::int64_t get_num_stolen_outside_numa_domain(
+            std::size_t num_thread, bool reset)
+        {
+            return 0;
+        }
 #endif
 
         virtual boost::int64_t get_queue_length(
@@ -304,13 +442,53 @@ namespace hpx { namespace threads { namespace policies
         boost::atomic<scheduler_mode> mode_;
 
 #if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
-        // support for suspension on idle queues
-        boost::mutex mtx_;
-        boost::condition_variable cond_;
-        boost::atomic<boost::uint32_t> wait_count_;
+        // Wake up the given worker thread if it is parked, returns whether
+        // it was parked.
+        bool unpark(std::size_t num_thread)
+        {
+            parking_slot& slot = parking_[num_thread];
+
+            int expected = parking_slot::parked;
+            if (!slot.state_.compare_exchange_strong(
+                    expected, parking_slot::notified))
+            {
+                return false;
+            }
+            --num_parked_;
+            slot.wait_count_.store(0, boost::memory_order_relaxed);
+
+            // the worker thread is either waiting already or will see the
+            // new state before starting to wait
+            {
+                boost::lock_guard<boost::mutex> l(slot.mtx_);
+            }
+            slot.cond_.notify_one();
+            return true;
+        }
+
+        // support for parking worker threads on idle queues, one slot per
+        // worker thread
+        struct parking_slot
+        {
+            enum { running, parked, notified };
+
+            parking_slot() : state_(running), wait_count_(0) {}
+
+            boost::atomic<int> state_;
+            boost::atomic<boost::uint32_t> wait_count_;
+            boost::mutex mtx_;
+            boost::condition_variable cond_;
+        };
+
+        std::vector<parking_slot> parking_;
+        boost::atomic<std::size_t> num_parked_;
 #endif
 
         std::vector<boost::atomic<hpx::state> > states_;
+
+        // timed state changes, one timing wheel per worker thread
+        std::vector<threads::detail::timer_wheel> timers_;
+
         char const* description_;
 
 #if defined(HPX_HAVE_SCHEDULER_LOCAL_STORAGE)
@@ -194,6 +194,10 @@ namespace hpx { namespace threads { namespace policies
                     heap = &thread_heap_huge_;
                     break;
 
+                case thread_stacksize_nostack:
+                    heap = &thread_heap_nostack_;
+                    break;
+
                 default:
                     break;
                 }
@@ -407,6 +411,10 @@ namespace hpx { namespace threads { namespace policies
                     thread_heap_huge_.push_front(thrd);
                     break;
 
+                case thread_stacksize_nostack:
+                    thread_heap_nostack_.push_front(thrd);
+                    break;
+
                 default:
                     HPX_ASSERT(false);
                     break;
@@ -541,6 +549,7 @@ namespace hpx { namespace threads { namespace policies
             thread_heap_medium_(),
             thread_heap_large_(),
             thread_heap_huge_(),
+            thread_heap_nostack_(),
 #ifdef HPX_HAVE_THREAD_CREATION_AND_CLEANUP_RATES
             add_new_time_(0),
             cleanup_terminated_time_(0),
@@ -1017,6 +1026,7 @@ namespace hpx { namespace threads { namespace policies
         std::list<thread_id_type> thread_heap_medium_;
         std::list<thread_id_type> thread_heap_large_;
         std::list<thread_id_type> thread_heap_huge_;
+        std::list<thread_id_type> thread_heap_nostack_;
 
 #ifdef HPX_HAVE_THREAD_CREATION_AND_CLEANUP_RATES
         boost::uint64_t add_new_time_;
@@ -496,6 +496,13 @@ namespace hpx { namespace threads
             return stacksize_;
         }
 
+        /// Return whether this thread runs directly on the stack of the
+        /// worker thread executing it (see thread_stacksize_nostack).
+        bool is_stackless() const
+        {
+            return stacksize_ == thread_stacksize_nostack;
+        }
+
         pool_type* get_pool()
         {
             return pool_;
@@ -509,12 +516,18 @@ namespace hpx { namespace threads
         ///                 thread's scheduling status.
         thread_state_enum operator()()
         {
+            if (is_stackless())
+                return invoke_stackless();
+
             HPX_ASSERT(this_() == coroutine_.get_thread_id());
             return coroutine_(set_state_ex(wait_signaled));
         }
 
         thread_id_type get_thread_id() const
         {
+            if (is_stackless())
+                return thread_id_type(const_cast<thread_data*>(this));
+
             return thread_id_type(
                     reinterpret_cast<thread_data*>(coroutine_.get_thread_id())
                 );
@@ -525,6 +538,8 @@ namespace hpx { namespace threads
 #ifndef HPX_HAVE_THREAD_PHASE_INFORMATION
             return 0;
 #else
+            if (is_stackless())
+                return 0;
             return coroutine_.get_thread_phase();
 #endif
         }
@@ -550,6 +565,13 @@ namespace hpx { namespace threads
 
             rebind_base(init_data, newstate);
 
+            if (is_stackless())
+            {
+                stackless_func_ = std::move(init_data.func);
+                stackless_target_ = std::move(init_data.target);
+                return;
+            }
+
             coroutine_.rebind(std::move(init_data.func),
                 std::move(init_data.target), this_());
 
@@ -593,10 +615,20 @@ namespace hpx { namespace threads
             scheduler_base_(init_data.scheduler_base),
             count_(0),
             stacksize_(init_data.stacksize),
-            coroutine_(std::move(init_data.func), std::move(init_data.target),
-                this_(), init_data.stacksize),
             pool_(&pool)
         {
+            if (is_stackless())
+            {
+                stackless_func_ = std::move(init_data.func);
+                stackless_target_ = std::move(init_data.target);
+            }
+            else
+            {
+                coroutine_ = coroutine_type(std::move(init_data.func),
+                    std::move(init_data.target), this_(), init_data.stacksize);
+                HPX_ASSERT(coroutine_.is_ready());
+            }
+
             LTM_(debug) << "thread::thread(" << this << "), description("
                         << get_description() << ")";
 
@@ -615,7 +647,40 @@ namespace hpx { namespace threads
                 parent_locality_id_ = get_locality_id();
 #endif
             HPX_ASSERT(init_data.stacksize != 0);
-            HPX_ASSERT(coroutine_.is_ready());
+        }
+
+        // Execute the thread function of a stackless thread directly on the
+        // stack of the calling worker thread, without any context switch.
+        // Suspending the thread is rejected by this_thread::suspend.
+        thread_state_enum invoke_stackless()
+        {
+            typedef coroutines::detail::coroutine_self self_type;
+
+            self_type* old_self = self_type::get_self();
+            self_type self(self_type::stackless_tag(), this_(), old_self);
+            self_type::set_self(&self);
+
+            thread_state_enum result = terminated;
+            try {
+                result = stackless_func_(set_state_ex(wait_signaled));
+            }
+            catch (...) {
+                self_type::set_self(old_self);
+                reset_stackless();
+                throw;
+            }
+            self_type::set_self(old_self);
+
+            // release the bound function, as the coroutine does
+            if (result == terminated)
+                reset_stackless();
+            return result;
+        }
+
+        void reset_stackless()
+        {
+            stackless_func_.reset();
+            stackless_target_ = naming::invalid_id;
         }
 
         void rebind_base(thread_init_data& init_data, thread_state_enum newstate)
@@ -722,6 +787,11 @@ namespace hpx { namespace threads
 
         coroutine_type coroutine_;
         pool_type* pool_;
+
+        // the function and target of a stackless thread, which has no
+        // coroutine
+        function_type stackless_func_;
+        naming::id_type stackless_target_;
     };
 
     typedef thread_data::pool_type thread_pool;
@@ -58,6 +58,12 @@ namespace hpx { namespace threads
     /// specific) self reference to the current HPX thread.
     HPX_API_EXPORT thread_self* get_self_ptr();
 
+    /// The function \a get_suspendable_self_ptr returns a pointer to the (OS
+    /// thread specific) self reference to the current HPX thread, or zero if
+    /// the current thread is not a HPX thread or is not allowed to suspend
+    /// (see \a thread_stacksize_nostack).
+    HPX_API_EXPORT thread_self* get_suspendable_self_ptr();
+
     /// The function \a get_ctx_ptr returns a pointer to the internal data
     /// associated with each coroutine.
     HPX_API_EXPORT thread_self_impl_type* get_ctx_ptr();
@@ -0,0 +1,65 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_TRAITS_IS_CONTIGUOUS_ITERATOR_OCT_18_2016_0214PM)
+#define HPX_TRAITS_IS_CONTIGUOUS_ITERATOR_OCT_18_2016_0214PM
+
+#include <hpx/config.hpp>
+#include <hpx/traits/is_iterator.hpp>
+
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+namespace hpx { namespace traits
+{
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        template <typename Iter, typename Enable = void>
+        struct is_vector_iterator
+          : std::false_type
+        {};
+
+        // std::vector<bool> does not store its elements contiguously
+        template <typename Iter>
+        struct is_vector_iterator<Iter,
+                typename std::enable_if<
+                    is_iterator<Iter>::value &&
+                   !std::is_same<bool,
+                        typename std::iterator_traits<Iter>::value_type
+                    >::value
+                >::type>
+          : std::integral_constant<bool,
+                std::is_same<Iter, typename std::vector<
+                        typename std::iterator_traits<Iter>::value_type
+                    >::iterator>::value ||
+                std::is_same<Iter, typename std::vector<
+                        typename std::iterator_traits<Iter>::value_type
+                    >::const_iterator>::value>
+        {};
+    }
+
+    // An iterator is contiguous if the elements it refers to are stored next
+    // to each other in memory, i.e. if std::addressof(*(it + n)) is equal to
+    // std::addressof(*it) + n. Iterator types of other containers can be
+    // registered by specializing this trait.
+    template <typename Iter, typename Enable = void>
+    struct is_contiguous_iterator
+      : detail::is_vector_iterator<typename std::decay<Iter>::type>
+    {};
+
+    template <typename T>
+    struct is_contiguous_iterator<T*>
+      : std::true_type
+    {};
+
+    template <typename T>
+    struct is_contiguous_iterator<T* const>
+      : std::true_type
+    {};
+}}
+
+#endif
@@ -42,7 +42,8 @@ namespace hpx { namespace util
             num_localities_(1),
             pu_step_(1),
             pu_offset_(0),
-            numa_sensitive_(0)
+            numa_sensitive_(0),
+            hierarchical_stealing_(false)
         {}
 
         int call(boost::program_options::options_description const& desc_cmdline,
@@ -67,6 +68,7 @@ namespace hpx { namespace util
         std::string affinity_domain_;
         std::string affinity_bind_;
         std::size_t numa_sensitive_;
+        bool hierarchical_stealing_;
 
     protected:
         bool handle_arguments(util::manage_config& cfgmap,
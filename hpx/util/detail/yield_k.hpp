@@ -26,7 +26,7 @@ namespace hpx { namespace util { namespace detail {
 #endif
         else if(k < 32 || k & 1) //-V112
         {
-            if(!hpx::threads::get_self_ptr())
+            if(!hpx::threads::get_suspendable_self_ptr())
             {
 #if defined(HPX_WINDOWS)
                 Sleep(0);
@@ -42,7 +42,7 @@ namespace hpx { namespace util { namespace detail {
         }
         else
         {
-            if(!hpx::threads::get_self_ptr())
+            if(!hpx::threads::get_suspendable_self_ptr())
             {
 #if defined(HPX_WINDOWS)
                 Sleep(1);
@@ -0,0 +1,220 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Algorithms from "Dynamic Circular Work-Stealing Deque"
+//  by D. Chase and Y. Lev
+//  Link: http://dl.acm.org/citation.cfm?id=1073974
+//
+//  Memory orderings from "Correct and Efficient Work-Stealing for Weak
+//  Memory Models" by N. M. Le, A. Pop, A. Cohen and F. Zappa Nardelli
+//  Link: http://dl.acm.org/citation.cfm?id=2442524
+//
+//  C++ implementation - Copyright (C) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+//  Disclaimer: Not a Boost library.
+//
+//  Only the owning thread may call push() and pop(). Any thread may call
+//  steal(). The owner never executes an atomic read-modify-write operation
+//  unless it races with a thief for the last remaining element.
+////////////////////////////////////////////////////////////////////////////////
+
+#if !defined(HPX_UTIL_LOCKFREE_CHASE_LEV_DEQUE_OCT_18_2016_0912AM)
+#define HPX_UTIL_LOCKFREE_CHASE_LEV_DEQUE_OCT_18_2016_0912AM
+
+#include <hpx/config.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace boost { namespace lockfree
+{
+
+template <typename T>
+struct chase_lev_deque
+{
+  private:
+    static_assert(std::is_trivially_copyable<T>::value,
+        "chase_lev_deque<T> requires a trivially copyable T");
+
+    // Keep the index that is written by the owner and the index that is
+    // written by the thieves on separate cache lines.
+    enum { cache_line_size = 64 };
+
+    // Circular buffer of 2^n elements. Superseded buffers are retired (not
+    // freed) until the deque is destroyed as a concurrent thief might still
+    // be reading from them.
+    struct circular_array
+    {
+        explicit circular_array(std::size_t log_size)
+          : log_size_(log_size),
+            mask_((std::size_t(1) << log_size) - 1),
+            buffer_(new boost::atomic<T>[std::size_t(1) << log_size])
+        {}
+
+        ~circular_array()
+        {
+            delete [] buffer_;
+        }
+
+        std::size_t size() const
+        {
+            return mask_ + 1;
+        }
+
+        T get(boost::int64_t i) const
+        {
+            return buffer_[std::size_t(i) & mask_].load(
+                boost::memory_order_relaxed);
+        }
+
+        void put(boost::int64_t i, T const& val)
+        {
+            buffer_[std::size_t(i) & mask_].store(
+                val, boost::memory_order_relaxed);
+        }
+
+        circular_array* grow(boost::int64_t bottom, boost::int64_t top) const
+        {
+            circular_array* a = new circular_array(log_size_ + 1);
+            for (boost::int64_t i = top; i != bottom; ++i)
+                a->put(i, get(i));
+            return a;
+        }
+
+        std::size_t log_size_;
+        std::size_t mask_;
+        boost::atomic<T>* buffer_;
+
+    private:
+        circular_array(circular_array const&);
+        circular_array& operator=(circular_array const&);
+    };
+
+    static std::size_t log2_capacity(std::size_t initial_size)
+    {
+        std::size_t log_size = 4;
+        while ((std::size_t(1) << log_size) < initial_size)
+            ++log_size;
+        return log_size;
+    }
+
+  public:
+    explicit chase_lev_deque(std::size_t initial_size = 0)
+      : top_(0), bottom_(0),
+        array_(new circular_array(log2_capacity(initial_size)))
+    {}
+
+    ~chase_lev_deque()
+    {
+        delete array_.load(boost::memory_order_relaxed);
+        for (circular_array* a : retired_)
+            delete a;
+    }
+
+    // Owner only: add an element at the bottom end of the deque.
+    bool push(T const& val)
+    {
+        boost::int64_t b = bottom_.load(boost::memory_order_relaxed);
+        boost::int64_t t = top_.load(boost::memory_order_acquire);
+        circular_array* a = array_.load(boost::memory_order_relaxed);
+
+        if (b - t > boost::int64_t(a->size()) - 1)
+        {
+            circular_array* new_a = a->grow(b, t);
+            retired_.push_back(a);
+            array_.store(new_a, boost::memory_order_release);
+            a = new_a;
+        }
+
+        a->put(b, val);
+        boost::atomic_thread_fence(boost::memory_order_release);
+        bottom_.store(b + 1, boost::memory_order_relaxed);
+        return true;
+    }
+
+    // Owner only: remove an element from the bottom end of the deque (LIFO).
+    bool pop(T& val)
+    {
+        boost::int64_t b = bottom_.load(boost::memory_order_relaxed) - 1;
+        circular_array* a = array_.load(boost::memory_order_relaxed);
+        bottom_.store(b, boost::memory_order_relaxed);
+        boost::atomic_thread_fence(boost::memory_order_seq_cst);
+        boost::int64_t t = top_.load(boost::memory_order_relaxed);
+
+        if (t > b)
+        {
+            // deque was empty
+            bottom_.store(b + 1, boost::memory_order_relaxed);
+            return false;
+        }
+
+        val = a->get(b);
+        if (t != b)
+            return true;        // more than one element left, no race
+
+        // single last element, compete with thieves
+        bool result = top_.compare_exchange_strong(t, t + 1,
+            boost::memory_order_seq_cst, boost::memory_order_relaxed);
+        bottom_.store(b + 1, boost::memory_order_relaxed);
+        return result;
+    }
+
+    // Any thread: remove an element from the top end of the deque (FIFO).
+    bool steal(T& val)
+    {
+        boost::int64_t t = top_.load(boost::memory_order_acquire);
+        boost::atomic_thread_fence(boost::memory_order_seq_cst);
+        boost::int64_t b = bottom_.load(boost::memory_order_acquire);
+
+        while (t < b)
+        {
+            circular_array* a = array_.load(boost::memory_order_acquire);
+            val = a->get(t);
+            if (top_.compare_exchange_strong(t, t + 1,
+                    boost::memory_order_seq_cst, boost::memory_order_relaxed))
+            {
+                return true;
+            }
+
+            // lost the race against another thief or the owner, t has been
+            // reloaded by the failed CAS
+            boost::atomic_thread_fence(boost::memory_order_seq_cst);
+            b = bottom_.load(boost::memory_order_acquire);
+        }
+        return false;
+    }
+
+    bool empty() const
+    {
+        boost::int64_t b = bottom_.load(boost::memory_order_relaxed);
+        boost::int64_t t = top_.load(boost::memory_order_relaxed);
+        return b <= t;
+    }
+
+    std::size_t size() const
+    {
+        boost::int64_t b = bottom_.load(boost::memory_order_relaxed);
+        boost::int64_t t = top_.load(boost::memory_order_relaxed);
+        return b > t ? std::size_t(b - t) : 0;
+    }
+
+  private:
+    chase_lev_deque(chase_lev_deque const&);
+    chase_lev_deque& operator=(chase_lev_deque const&);
+
+    boost::atomic<boost::int64_t> top_;
+    char pad0_[cache_line_size - sizeof(boost::atomic<boost::int64_t>)];
+
+    boost::atomic<boost::int64_t> bottom_;
+    boost::atomic<circular_array*> array_;
+    std::vector<circular_array*> retired_;      // accessed by owner only
+};
+
+}}
+
+#endif
@@ -44,6 +44,10 @@ namespace hpx { namespace util
         bool start(bool evaluate = true);
         bool stop();
 
+        // (re-)start the timer using the given relative expiration time
+        bool start(hpx::util::steady_duration const& rel_time,
+            bool evaluate = true);
+
         bool is_started() const;
         bool is_terminated() const;
 
@@ -143,6 +143,8 @@ namespace hpx { namespace util
 
 #if defined(__linux) || defined(linux) || defined(__linux__) || defined(__FreeBSD__)
         bool init_use_stack_guard_pages() const;
+        bool init_use_stack_pool() const;
+        std::size_t init_stack_pool_high_water_mark() const;
 #endif
 
         void pre_initialize_ini();
@@ -0,0 +1,198 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_UTIL_SHARDED_HISTOGRAM_OCT_18_2016_0520PM)
+#define HPX_UTIL_SHARDED_HISTOGRAM_OCT_18_2016_0520PM
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/get_worker_thread_num.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace hpx { namespace util
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // A histogram of non-negative integer samples with logarithmically
+    // growing buckets (in the spirit of HDR histograms): every power of two
+    // is subdivided into 2^precision_bits buckets of equal width, which
+    // bounds the relative error of the reported values by 2^-precision_bits.
+    //
+    // The counts are kept in shards, usually one per worker thread. Recording
+    // a sample is a single relaxed atomic increment which never waits for
+    // other writers or for readers. Readers sum up all shards, the result is
+    // exact only if no samples are recorded concurrently, which is sufficient
+    // for performance counters.
+    class sharded_histogram
+    {
+    public:
+        enum
+        {
+            precision_bits = 4,
+            sub_buckets = 1 << precision_bits,
+            num_buckets = (64 - precision_bits + 1) * sub_buckets
+        };
+
+    private:
+        enum { cache_line_size = 64 };
+
+        struct shard
+        {
+            boost::atomic<boost::uint64_t> counts_[num_buckets];
+            boost::atomic<boost::uint64_t> sum_;
+            char pad_[cache_line_size];
+        };
+
+    public:
+        explicit sharded_histogram(std::size_t num_shards = 1)
+          : num_shards_(num_shards != 0 ? num_shards : 1),
+            shards_(new shard[num_shards_])
+        {
+            reset();
+        }
+
+        std::size_t get_num_shards() const
+        {
+            return num_shards_;
+        }
+
+        // Record a sample into the shard of the calling worker thread, all
+        // other threads share the last shard.
+        void record(boost::uint64_t value)
+        {
+            std::size_t num_thread = hpx::get_worker_thread_num();
+            record(value, num_thread < num_shards_ ? num_thread :
+                num_shards_ - 1);
+        }
+
+        void record(boost::uint64_t value, std::size_t num_shard)
+        {
+            shard& s = shards_[num_shard % num_shards_];
+            s.counts_[bucket_index(value)].fetch_add(1,
+                boost::memory_order_relaxed);
+            s.sum_.fetch_add(value, boost::memory_order_relaxed);
+        }
+
+        // Sum up the bucket counts of all shards.
+        void get_counts(std::vector<boost::uint64_t>& counts) const
+        {
+            counts.assign(num_buckets, 0);
+            for (std::size_t i = 0; i != num_shards_; ++i)
+            {
+                shard const& s = shards_[i];
+                for (std::size_t j = 0; j != num_buckets; ++j)
+                    counts[j] += s.counts_[j].load(boost::memory_order_relaxed);
+            }
+        }
+
+        boost::uint64_t get_count() const
+        {
+            std::vector<boost::uint64_t> counts;
+            get_counts(counts);
+
+            boost::uint64_t count = 0;
+            for (boost::uint64_t c : counts)
+                count += c;
+            return count;
+        }
+
+        boost::uint64_t get_sum() const
+        {
+            boost::uint64_t sum = 0;
+            for (std::size_t i = 0; i != num_shards_; ++i)
+                sum += shards_[i].sum_.load(boost::memory_order_relaxed);
+            return sum;
+        }
+
+        void reset()
+        {
+            for (std::size_t i = 0; i != num_shards_; ++i)
+            {
+                shard& s = shards_[i];
+                for (std::size_t j = 0; j != num_buckets; ++j)
+                    s.counts_[j].store(0, boost::memory_order_relaxed);
+                s.sum_.store(0, boost::memory_order_relaxed);
+            }
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        static std::size_t bucket_index(boost::uint64_t value)
+        {
+            if (value < sub_buckets)
+                return static_cast<std::size_t>(value);
+
+            std::size_t shift = floor_log2(value) - precision_bits;
+            return shift * sub_buckets + static_cast<std::size_t>(
+                value >> shift);
+        }
+
+        static boost::uint64_t bucket_lower_bound(std::size_t index)
+        {
+            if (index < 2 * sub_buckets)
+                return index;
+
+            std::size_t shift = index / sub_buckets - 1;
+            return boost::uint64_t(index - shift * sub_buckets) << shift;
+        }
+
+        static boost::uint64_t bucket_upper_bound(std::size_t index)
+        {
+            if (index == num_buckets - 1)
+                return ~boost::uint64_t(0);
+            return bucket_lower_bound(index + 1) - 1;
+        }
+
+        // Return the smallest value which is larger than or equal to the
+        // given fraction (0..1) of all samples counted in 'counts'.
+        static boost::uint64_t value_at_quantile(
+            std::vector<boost::uint64_t> const& counts, double quantile)
+        {
+            boost::uint64_t total = 0;
+            for (boost::uint64_t c : counts)
+                total += c;
+            if (total == 0)
+                return 0;
+
+            boost::uint64_t rank = static_cast<boost::uint64_t>(
+                std::ceil(quantile * double(total)));
+            if (rank == 0)
+                rank = 1;
+
+            boost::uint64_t seen = 0;
+            for (std::size_t i = 0; i != counts.size(); ++i)
+            {
+                seen += counts[i];
+                if (seen >= rank)
+                    return bucket_upper_bound(i);
+            }
+            return bucket_upper_bound(counts.size() - 1);
+        }
+
+    private:
+        static std::size_t floor_log2(boost::uint64_t value)
+        {
+            std::size_t result = 0;
+            for (std::size_t shift = 32; shift != 0; shift /= 2)
+            {
+                if (value >= (boost::uint64_t(1) << shift))
+                {
+                    value >>= shift;
+                    result += shift;
+                }
+            }
+            return result;
+        }
+
+        std::size_t num_shards_;
+        std::unique_ptr<shard[]> shards_;
+    };
+}}
+
+#endif
@@ -0,0 +1,176 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_UTIL_STREAM_COUNTERS_OCT_18_2016_0410PM)
+#define HPX_UTIL_STREAM_COUNTERS_OCT_18_2016_0410PM
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/local/mutex.hpp>
+#include <hpx/performance_counters/counters.hpp>
+#include <hpx/util/interval_timer.hpp>
+
+#include <boost/cstdint.hpp>
+#include <boost/exception_ptr.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <cstddef>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+namespace hpx { namespace performance_counters { namespace server
+{
+    class base_performance_counter;
+}}}
+
+namespace hpx { namespace util
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // The stream_counters object samples the given performance counters at a
+    // fixed interval and streams the values to a file or to a TCP socket
+    // ('tcp://host:port'), '{locality}' in the destination is replaced with
+    // the locality id. Only the counters located on the calling locality are
+    // sampled, their values are read directly (no actions are invoked).
+    //
+    // The samples are stored in a ring buffer which is drained by a dedicated
+    // OS thread, all I/O (including connecting to the destination) happens
+    // on that thread, the sampling thread never blocks on the destination.
+    // The writer thread wakes up whenever 'buffer_size' samples are
+    // available. Samples are dropped if the ring buffer (four times
+    // 'buffer_size' samples) overflows. Optionally, every 'downsample'
+    // consecutive samples are averaged into one.
+    //
+    // Stream format (all integers are LEB128 encoded, signed integers are
+    // zigzag encoded first):
+    //
+    //   header:  "HPXC", version (1 byte), locality id, interval [ns],
+    //            downsample factor, number of counters, followed by the
+    //            name, unit of measure (both length prefixed), scaling
+    //            (signed), and scale_inverse (1 byte) of each counter
+    //   blocks:  number of samples, followed by the samples, each sample
+    //            holds the timestamp [ns] and the raw counter values, all
+    //            stored as the (signed) difference to the previous sample
+    //
+    // Invalid counter values are stored as repetitions of the previous value.
+    class HPX_EXPORT stream_counters
+    {
+        // avoid warning about using this in member initializer list
+        stream_counters* this_() { return this; }
+
+    public:
+        stream_counters(std::vector<std::string> const& names,
+            boost::int64_t interval, std::string const& dest,
+            std::size_t downsample = 1, std::size_t buffer_size = 1024);
+        ~stream_counters();
+
+        void start();
+        void stop();
+
+        bool evaluate();
+        void terminate();
+
+        // Ask the writer thread to write all buffered samples to the
+        // destination, this does not wait for the data to be written.
+        void flush();
+
+    protected:
+        typedef performance_counters::server::base_performance_counter
+            counter_type;
+
+        void find_counters();
+        bool find_counter(performance_counters::counter_info const& info,
+            error_code& ec);
+
+        void resolve_destination();
+        bool push_sample();
+        void write_header(std::vector<char>& buffer);
+
+        // executed by the writer thread
+        void open_destination();
+        void write_samples(std::vector<char>& buffer,
+            std::vector<boost::int64_t> const& samples);
+        void writer_main();
+        void stop_writer();
+
+    private:
+        typedef lcos::local::mutex mutex_type;
+
+        mutex_type mtx_;                      // protects the sampling state
+
+        std::vector<std::string> names_;      // counter instance names
+        std::vector<naming::id_type> ids_;    // gids of counter instances
+        std::vector<std::string> uoms_;       // units of measure
+        std::vector<counter_type*> counters_;
+        std::vector<boost::int64_t> scaling_;
+        std::vector<bool> scale_inverse_;
+
+        std::string destination_;
+        bool header_written_;
+        bool running_;
+
+        std::size_t downsample_;
+        std::size_t buffer_size_;
+
+        // the accumulated values are used for downsampling, the last values
+        // read from the counters replace invalid values
+        std::vector<boost::int64_t> accumulated_;
+        std::size_t num_accumulated_;
+        std::vector<boost::int64_t> last_values_;
+
+        // The ring buffer shared with the writer thread, the samples
+        // (timestamp followed by the counter values) are stored
+        // consecutively.
+        boost::mutex ring_mtx_;
+        boost::condition_variable ring_cond_;
+        std::vector<boost::int64_t> ring_;
+        std::size_t ring_capacity_;           // [samples]
+        std::size_t ring_head_;
+        std::size_t ring_count_;
+        std::size_t dropped_;
+        std::vector<char> header_;            // not yet written header
+        bool flush_requested_;
+        bool stop_requested_;
+        boost::exception_ptr writer_error_;
+
+        // owned by the writer thread: the stream and the last sample written
+        // to it
+        boost::thread writer_;
+        std::unique_ptr<std::ostream> stream_;
+        std::vector<boost::int64_t> last_sample_;
+
+        boost::int64_t interval_;
+        interval_timer timer_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The decoded contents of a counter stream as written by stream_counters.
+    struct counter_time_series
+    {
+        boost::uint32_t locality_id_;
+        boost::int64_t interval_;                 // [ns]
+        std::size_t downsample_;
+
+        std::vector<std::string> names_;
+        std::vector<std::string> uoms_;
+        std::vector<boost::int64_t> scaling_;
+        std::vector<bool> scale_inverse_;
+
+        std::vector<boost::int64_t> timestamps_;  // [ns]
+        std::vector<std::vector<boost::int64_t> > values_;
+    };
+
+    // Decode the given stream, returns false if the stream is malformed.
+    HPX_EXPORT bool read_counter_stream(std::istream& in,
+        counter_time_series& data);
+}}
+
+#include <hpx/config/warnings_suffix.hpp>
+
+#endif
@@ -13,6 +13,9 @@
 #include <boost/format.hpp>
 #include <boost/regex.hpp>
 
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -30,9 +33,11 @@ namespace hpx { namespace plugins { namespace parcel
     void coalescing_counter_registry::register_action(
         std::string const& name,
         get_counter_type num_parcels, get_counter_type num_messages,
-        get_counter_type num_parcels_per_message,
+        get_counter_type parcels_per_message_parcels,
+        get_counter_type parcels_per_message_messages,
         get_counter_type average_time_between_parcels,
-        get_counter_values_creator_type time_between_parcels_histogram_creator)
+        get_counter_values_creator_type time_between_parcels_histogram_creator,
+        get_counter_type batch_size, get_counter_type flush_interval)
     {
         if (name.empty())
         {
@@ -41,38 +46,47 @@ namespace hpx { namespace plugins { namespace parcel
                 "Cannot register an action with an empty name");
         }
 
+        handler_functions data =
+        {
+            num_parcels, num_messages,
+            parcels_per_message_parcels, parcels_per_message_messages,
+            average_time_between_parcels,
+            time_between_parcels_histogram_creator,
+            get_counter_values_type(),
+            batch_size, flush_interval
+        };
+
+        std::unique_lock<mutex_type> l(mtx_);
+
         auto it = map_.find(name);
         if (it == map_.end())
         {
-            counter_functions data =
-            {
-                num_parcels, num_messages,
-                num_parcels_per_message, average_time_between_parcels,
-                time_between_parcels_histogram_creator,
-                0, 0, 1
-            };
-
-            map_.emplace(name, std::move(data));
+            counter_functions functions = { {}, 0, 0, 1 };
+            it = map_.emplace(name, std::move(functions)).first;
         }
-        else
+
+        // every destination has its own message handler, keep all of them
+        std::vector<handler_functions>& handlers = (*it).second.handlers;
+        std::size_t index = handlers.size();
+        handlers.push_back(std::move(data));
+
+        boost::int64_t min_boundary = (*it).second.min_boundary;
+        boost::int64_t max_boundary = (*it).second.max_boundary;
+        boost::int64_t num_buckets = (*it).second.num_buckets;
+
+        if (min_boundary != max_boundary)
         {
-            // replace the existing functions
-            (*it).second.num_parcels = num_parcels;
-            (*it).second.num_messages = num_messages;
-            (*it).second.num_parcels_per_message = num_parcels_per_message;
-            (*it).second.average_time_between_parcels =
-                average_time_between_parcels;
-            (*it).second.time_between_parcels_histogram_creator =
-                time_between_parcels_histogram_creator;
-
-            if ((*it).second.min_boundary != (*it).second.max_boundary)
-            {
-                // instantiate actual histogram collection
-                coalescing_counter_registry::get_counter_values_type result;
-                time_between_parcels_histogram_creator(
-                    (*it).second.min_boundary, (*it).second.max_boundary,
-                    (*it).second.num_buckets, result);
-            }
+            // instantiate actual histogram collection, the creator acquires
+            // the lock of the message handler
+            l.unlock();
+
+            get_counter_values_type histogram;
+            time_between_parcels_histogram_creator(
+                min_boundary, max_boundary, num_buckets, histogram);
+
+            l.lock();
+            map_[name].handlers[index].time_between_parcels_histogram =
+                std::move(histogram);
         }
     }
 
@@ -85,11 +99,139 @@ namespace hpx { namespace plugins { namespace parcel
                 "Cannot register an action with an empty name");
         }
 
+        std::lock_guard<mutex_type> l(mtx_);
+
         auto it = map_.find(name);
         if (it == map_.end())
         {
-            map_.emplace(name, counter_functions());
+            counter_functions functions = { {}, 0, 0, 1 };
+            map_.emplace(name, std::move(functions));
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::vector<coalescing_counter_registry::handler_functions>
+        coalescing_counter_registry::get_handlers(
+            std::string const& name, char const* func) const
+    {
+        std::lock_guard<mutex_type> l(mtx_);
+
+        map_type::const_iterator it = map_.find(name);
+        if (it == map_.end())
+        {
+            HPX_THROW_EXCEPTION(bad_parameter, func, "unknown action type");
+            return std::vector<handler_functions>();
+        }
+        return (*it).second.handlers;
+    }
+
+    boost::int64_t coalescing_counter_registry::sum_counters(
+        std::string const& name,
+        get_counter_type handler_functions::* counter, bool reset) const
+    {
+        // the counter functions acquire the lock of their message handler,
+        // call them on a copy
+        std::vector<handler_functions> handlers = get_handlers(name,
+            "coalescing_counter_registry::sum_counters");
+
+        boost::int64_t result = 0;
+        for (handler_functions const& h : handlers)
+        {
+            result += (h.*counter)(reset);
+        }
+        return result;
+    }
+
+    boost::int64_t coalescing_counter_registry::ratio_counters(
+        std::string const& name,
+        get_counter_type handler_functions::* numerator,
+        get_counter_type handler_functions::* denominator, bool reset) const
+    {
+        std::vector<handler_functions> handlers = get_handlers(name,
+            "coalescing_counter_registry::ratio_counters");
+
+        boost::int64_t sum_numerator = 0;
+        boost::int64_t sum_denominator = 0;
+        for (handler_functions const& h : handlers)
+        {
+            sum_numerator += (h.*numerator)(reset);
+            sum_denominator += (h.*denominator)(reset);
+        }
+
+        if (sum_denominator == 0)
+            return 0;
+        return sum_numerator / sum_denominator;
+    }
+
+    boost::int64_t coalescing_counter_registry::weighted_average_counters(
+        std::string const& name,
+        get_counter_type handler_functions::* counter,
+        get_counter_type handler_functions::* weight, bool reset) const
+    {
+        std::vector<handler_functions> handlers = get_handlers(name,
+            "coalescing_counter_registry::weighted_average_counters");
+        if (handlers.empty())
+            return 0;
+
+        // the weights are read without resetting them, they belong to
+        // counters of their own
+        boost::int64_t sum = 0;
+        boost::int64_t sum_weighted = 0;
+        boost::int64_t sum_weights = 0;
+        for (handler_functions const& h : handlers)
+        {
+            boost::int64_t value = (h.*counter)(reset);
+            boost::int64_t w = (h.*weight)(false);
+
+            sum += value;
+            sum_weighted += value * w;
+            sum_weights += w;
+        }
+
+        // fall back to the plain average as long as nothing was sent
+        if (sum_weights == 0)
+            return sum / boost::int64_t(handlers.size());
+
+        return sum_weighted / sum_weights;
+    }
+
+    std::vector<boost::int64_t>
+        coalescing_counter_registry::average_histograms(
+            std::string const& name, bool reset) const
+    {
+        std::vector<handler_functions> handlers = get_handlers(name,
+            "coalescing_counter_registry::average_histograms");
+
+        std::vector<boost::int64_t> result;
+        boost::int64_t count = 0;
+        for (handler_functions const& h : handlers)
+        {
+            if (h.time_between_parcels_histogram.empty())
+                continue;
+
+            std::vector<boost::int64_t> data =
+                h.time_between_parcels_histogram(reset);
+            if (result.empty())
+            {
+                result = std::move(data);
+            }
+            else
+            {
+                // the first three values are the histogram parameters
+                HPX_ASSERT(data.size() == result.size());
+                for (std::size_t i = 3; i != result.size(); ++i)
+                    result[i] += data[i];
+            }
+            ++count;
         }
+
+        if (count == 0)
+            return empty_histogram(reset);
+
+        for (std::size_t i = 3; i < result.size(); ++i)
+            result[i] /= count;
+
+        return result;
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -97,61 +239,110 @@ namespace hpx { namespace plugins { namespace parcel
         coalescing_counter_registry::get_parcels_counter(
             std::string const& name) const
     {
-        map_type::const_iterator it = map_.find(name);
-        if (it == map_.end())
+        if (get_handlers(name,
+                "coalescing_counter_registry::get_num_parcels_counter").empty())
         {
-            HPX_THROW_EXCEPTION(bad_parameter,
-                "coalescing_counter_registry::get_num_parcels_counter",
-                "unknown action type");
-            return get_counter_type();
+            return get_counter_type();      // no parcel has been sent yet
         }
-        return (*it).second.num_parcels;
+
+        return [this, name](bool reset) -> boost::int64_t
+            {
+                return sum_counters(name, &handler_functions::num_parcels,
+                    reset);
+            };
     }
 
     coalescing_counter_registry::get_counter_type
         coalescing_counter_registry::get_messages_counter(
             std::string const& name) const
     {
-        map_type::const_iterator it = map_.find(name);
-        if (it == map_.end())
+        if (get_handlers(name,
+                "coalescing_counter_registry::get_num_messages_counter"
+            ).empty())
         {
-            HPX_THROW_EXCEPTION(bad_parameter,
-                "coalescing_counter_registry::get_num_messages_counter",
-                "unknown action type");
             return get_counter_type();
         }
-        return (*it).second.num_messages;
+
+        return [this, name](bool reset) -> boost::int64_t
+            {
+                return sum_counters(name, &handler_functions::num_messages,
+                    reset);
+            };
     }
 
     coalescing_counter_registry::get_counter_type
         coalescing_counter_registry::get_parcels_per_message_counter(
             std::string const& name) const
     {
-        map_type::const_iterator it = map_.find(name);
-        if (it == map_.end())
+        if (get_handlers(name,
+                "coalescing_counter_registry::get_num_messages_counter"
+            ).empty())
         {
-            HPX_THROW_EXCEPTION(bad_parameter,
-                "coalescing_counter_registry::get_num_messages_counter",
-                "unknown action type");
             return get_counter_type();
         }
-        return (*it).second.num_parcels_per_message;
+
+        return [this, name](bool reset) -> boost::int64_t
+            {
+                return ratio_counters(name,
+                    &handler_functions::parcels_per_message_parcels,
+                    &handler_functions::parcels_per_message_messages, reset);
+            };
     }
 
     coalescing_counter_registry::get_counter_type
         coalescing_counter_registry::get_average_time_between_parcels_counter(
             std::string const& name) const
     {
-        map_type::const_iterator it = map_.find(name);
-        if (it == map_.end())
-        {
-            HPX_THROW_EXCEPTION(bad_parameter,
+        if (get_handlers(name,
                 "coalescing_counter_registry::"
-                    "get_average_time_between_parcels_counter",
-                "unknown action type");
+                    "get_average_time_between_parcels_counter").empty())
+        {
+            return get_counter_type();
+        }
+
+        return [this, name](bool reset) -> boost::int64_t
+            {
+                return weighted_average_counters(name,
+                    &handler_functions::average_time_between_parcels,
+                    &handler_functions::num_parcels, reset);
+            };
+    }
+
+    coalescing_counter_registry::get_counter_type
+        coalescing_counter_registry::get_batch_size_counter(
+            std::string const& name) const
+    {
+        if (get_handlers(name,
+                "coalescing_counter_registry::get_batch_size_counter").empty())
+        {
+            return get_counter_type();
+        }
+
+        return [this, name](bool reset) -> boost::int64_t
+            {
+                return weighted_average_counters(name,
+                    &handler_functions::batch_size,
+                    &handler_functions::num_messages, reset);
+            };
+    }
+
+    coalescing_counter_registry::get_counter_type
+        coalescing_counter_registry::get_flush_interval_counter(
+            std::string const& name) const
+    {
+        if (get_handlers(name,
+                "coalescing_counter_registry::get_flush_interval_counter"
+            ).empty())
+        {
             return get_counter_type();
         }
-        return (*it).second.average_time_between_parcels;
+
+        return [this, name](bool reset) -> boost::int64_t
+            {
+                return weighted_average_counters(name,
+                    &handler_functions::flush_interval,
+                    &handler_functions::num_messages, reset);
+            };
     }
 
     coalescing_counter_registry::get_counter_values_type
@@ -159,29 +350,52 @@ namespace hpx { namespace plugins { namespace parcel
             std::string const& name, boost::int64_t min_boundary,
             boost::int64_t max_boundary, boost::int64_t num_buckets)
     {
-        map_type::iterator it = map_.find(name);
-        if (it == map_.end())
-        {
-            HPX_THROW_EXCEPTION(bad_parameter,
-                "coalescing_counter_registry::"
-                    "get_time_between_parcels_histogram_counter",
-                "unknown action type");
-            return &coalescing_counter_registry::empty_histogram;
-        }
+        std::vector<handler_functions> handlers;
 
-        if ((*it).second.time_between_parcels_histogram_creator.empty())
         {
-            // no parcel of this type has been sent yet
+            std::lock_guard<mutex_type> l(mtx_);
+
+            map_type::iterator it = map_.find(name);
+            if (it == map_.end())
+            {
+                HPX_THROW_EXCEPTION(bad_parameter,
+                    "coalescing_counter_registry::"
+                        "get_time_between_parcels_histogram_counter",
+                    "unknown action type");
+                return &coalescing_counter_registry::empty_histogram;
+            }
+
+            // message handlers registered from now on will instantiate
+            // their histogram right away
             (*it).second.min_boundary = min_boundary;
             (*it).second.max_boundary = max_boundary;
             (*it).second.num_buckets = num_buckets;
-            return coalescing_counter_registry::get_counter_values_type();
+
+            if ((*it).second.handlers.empty())
+            {
+                // no parcel of this type has been sent yet
+                return coalescing_counter_registry::get_counter_values_type();
+            }
+
+            handlers = (*it).second.handlers;
         }
 
-        coalescing_counter_registry::get_counter_values_type result;
-        (*it).second.time_between_parcels_histogram_creator(
-            min_boundary, max_boundary, num_buckets, result);
-        return result;
+        // instantiate the histograms of the existing message handlers
+        for (std::size_t i = 0; i != handlers.size(); ++i)
+        {
+            get_counter_values_type histogram;
+            handlers[i].time_between_parcels_histogram_creator(
+                min_boundary, max_boundary, num_buckets, histogram);
+
+            std::lock_guard<mutex_type> l(mtx_);
+            map_[name].handlers[i].time_between_parcels_histogram =
+                std::move(histogram);
+        }
+
+        return [this, name](bool reset) -> std::vector<boost::int64_t>
+            {
+                return average_histograms(name, reset);
+            };
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -233,6 +447,15 @@ namespace hpx { namespace plugins { namespace parcel
             parameters = parameters.substr(0, pos);
         }
 
+        // the counter functions below may suspend, don't hold the lock
+        std::vector<std::string> names;
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+            names.reserve(map_.size());
+            for (auto const& action : map_)
+                names.push_back(action.first);
+        }
+
         if (parameters.find_first_of("*?[]") != std::string::npos)
         {
             std::string str_rx(
@@ -243,17 +466,16 @@ namespace hpx { namespace plugins { namespace parcel
             bool found_one = false;
             boost::regex rx(str_rx, boost::regex::perl);
 
-            map_type::const_iterator end = map_.end();
-            for (map_type::const_iterator it = map_.begin(); it != end; ++it)
+            for (std::string const& name : names)
             {
-                if (!boost::regex_match((*it).first, rx))
+                if (!boost::regex_match(name, rx))
                     continue;
                 found_one = true;
 
                 // propagate parameters
                 std::string fullname;
                 performance_counters::counter_path_elements cp = p;
-                cp.parameters_ = (*it).first;
+                cp.parameters_ = name;
                 if (!additional_parameters.empty())
                     cp.parameters_ += additional_parameters;
 
@@ -271,10 +493,9 @@ namespace hpx { namespace plugins { namespace parcel
             {
                 // compose a list of known action types
                 std::string types;
-                map_type::const_iterator end = map_.end();
-                for (map_type::const_iterator it = map_.begin(); it != end; ++it)
+                for (std::string const& name : names)
                 {
-                    types += "  " + (*it).first + "\n";
+                    types += "  " + name + "\n";
                 }
 
                 HPX_THROWS_IF(ec, bad_parameter,
@@ -292,15 +513,13 @@ namespace hpx { namespace plugins { namespace parcel
         }
 
         // use given action type directly
-        map_type::const_iterator it = map_.find(parameters);
-        if (it == map_.end())
+        if (std::find(names.begin(), names.end(), parameters) == names.end())
         {
             // compose a list of known action types
             std::string types;
-            map_type::const_iterator end = map_.end();
-            for (map_type::const_iterator it = map_.begin(); it != end; ++it)
+            for (std::string const& name : names)
             {
-                types += "  " + (*it).first + "\n";
+                types += "  " + name + "\n";
             }
 
             HPX_THROWS_IF(ec, bad_parameter,
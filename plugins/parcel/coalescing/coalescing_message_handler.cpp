@@ -22,7 +22,9 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/accumulators/accumulators.hpp>
 
+#include <algorithm>
 #include <chrono>
+#include <cstddef>
 #include <mutex>
 #include <string>
 #include <utility>
@@ -38,6 +40,9 @@ namespace hpx { namespace traits
     //      ...
     //      num_messages = 50
     //      interval = 100
+    //      allow_background_flush = 1
+    //      adaptive = 0
+    //      latency_target = 100
     //
     template <>
     struct plugin_config_data<hpx::plugins::parcel::coalescing_message_handler>
@@ -46,7 +51,9 @@ namespace hpx { namespace traits
         {
             return "num_messages = 50\n"
                    "interval = 100\n"
-                   "allow_background_flush = 1";
+                   "allow_background_flush = 1\n"
+                   "adaptive = 0\n"
+                   "latency_target = 100";
         }
     };
 }}
@@ -87,6 +94,19 @@ namespace hpx { namespace plugins { namespace parcel
                 "1");
             return !value.empty() && value[0] != '0';
         }
+
+        bool get_adaptive()
+        {
+            std::string value = hpx::get_config_entry(
+                "hpx.plugins.coalescing_message_handler.adaptive", "0");
+            return !value.empty() && value[0] != '0';
+        }
+
+        std::size_t get_latency_target()
+        {
+            return boost::lexical_cast<std::size_t>(hpx::get_config_entry(
+                "hpx.plugins.coalescing_message_handler.latency_target", 100));
+        }
     }
 
     coalescing_message_handler::coalescing_message_handler(
@@ -103,6 +123,12 @@ namespace hpx { namespace plugins { namespace parcel
         stopped_(false),
         allow_background_flush_(detail::get_background_flush()),
         action_name_(action_name),
+        adaptive_(detail::get_adaptive()),
+        max_batch_size_(detail::get_num_messages(num)),
+        latency_target_(detail::get_latency_target()),
+        batch_size_(max_batch_size_),
+        interval_(detail::get_interval(interval)),
+        average_time_between_parcels_(0),
         num_parcels_(0), reset_num_parcels_(0),
             reset_num_parcels_per_message_parcels_(0),
         num_messages_(0), reset_num_messages_(0),
@@ -123,11 +149,15 @@ namespace hpx { namespace plugins { namespace parcel
             util::bind(&coalescing_message_handler::get_parcels_count, this, _1),
             util::bind(&coalescing_message_handler::get_messages_count, this, _1),
             util::bind(&coalescing_message_handler::
-                get_parcels_per_message_count, this, _1),
+                get_parcels_per_message_parcels, this, _1),
+            util::bind(&coalescing_message_handler::
+                get_parcels_per_message_messages, this, _1),
             util::bind(&coalescing_message_handler::
                 get_average_time_between_parcels, this, _1),
             util::bind(&coalescing_message_handler::
-                get_time_between_parcels_histogram_creator, this, _1, _2, _3, _4));
+                get_time_between_parcels_histogram_creator, this, _1, _2, _3, _4),
+            util::bind(&coalescing_message_handler::get_batch_size, this, _1),
+            util::bind(&coalescing_message_handler::get_flush_interval, this, _1));
     }
 
     void coalescing_message_handler::put_parcel(
@@ -137,15 +167,45 @@ namespace hpx { namespace plugins { namespace parcel
         std::unique_lock<mutex_type> l(mtx_);
         ++num_parcels_;
 
-        // collect data for time between parcels histogram
-        if (time_between_parcels_)
+        // collect data for time between parcels histogram and for adapting
+        // the coalescing parameters
+        if (time_between_parcels_ || adaptive_)
         {
             boost::int64_t parcel_time = util::high_resolution_clock::now();
-            (*time_between_parcels_)(parcel_time - last_parcel_time_);
+            boost::int64_t time_between_parcels =
+                parcel_time - last_parcel_time_;
             last_parcel_time_ = parcel_time;
+
+            if (time_between_parcels_)
+                (*time_between_parcels_)(time_between_parcels);
+
+            if (adaptive_)
+            {
+                if (average_time_between_parcels_ == 0)
+                {
+                    average_time_between_parcels_ =
+                        double(time_between_parcels);
+                }
+                else
+                {
+                    average_time_between_parcels_ +=
+                        (double(time_between_parcels) -
+                            average_time_between_parcels_) / 8;
+                }
+            }
+        }
+
+        if (adaptive_ && batch_size_ == 1 && buffer_.empty())
+        {
+            // re-evaluate whether parcels should be coalesced again
+            update_parameters_locked();
+            if (batch_size_ != 1)
+                buffer_ = detail::message_buffer(batch_size_);
         }
 
-        if (stopped_) {
+        // parcels arriving more rarely than the latency target permits are
+        // not worth coalescing
+        if (stopped_ || (batch_size_ == 1 && buffer_.empty())) {
             ++num_messages_;
             l.unlock();
 
@@ -157,10 +217,12 @@ namespace hpx { namespace plugins { namespace parcel
         detail::message_buffer::message_buffer_append_state s =
             buffer_.append(dest, std::move(p), std::move(f));
 
+        std::chrono::microseconds interval(interval_);
+
         switch(s) {
         case detail::message_buffer::first_message:
             l.unlock();
-            timer_.start(false);        // start deadline timer to flush buffer
+            timer_.start(interval, false);  // start deadline timer to flush buffer
             break;
 
         case detail::message_buffer::normal:
@@ -168,7 +230,7 @@ namespace hpx { namespace plugins { namespace parcel
                 break;
 
             l.unlock();
-            timer_.start(false);        // start deadline timer to flush buffer
+            timer_.start(interval, false);  // start deadline timer to flush buffer
             break;
 
         case detail::message_buffer::buffer_now_full:
@@ -233,7 +295,10 @@ namespace hpx { namespace plugins { namespace parcel
         if (buffer_.empty())
             return false;
 
-        detail::message_buffer buff (buffer_.capacity());
+        if (adaptive_)
+            update_parameters_locked();
+
+        detail::message_buffer buff (batch_size_);
         std::swap(buff, buffer_);
 
         ++num_messages_;
@@ -245,6 +310,38 @@ namespace hpx { namespace plugins { namespace parcel
         return true;
     }
 
+    // Choose the number of parcels to coalesce into the next message and the
+    // deadline for flushing it based on the observed time between parcels.
+    // The batch is sized to hold the parcels expected to arrive within the
+    // latency target, which keeps the message rate at about one message per
+    // latency target (or below, if the maximal batch size is reached first).
+    // The deadline allows for filling the batch, but will not exceed the
+    // latency target, limiting the latency added on bursty traffic.
+    void coalescing_message_handler::update_parameters_locked()
+    {
+        double const time_between_parcels = average_time_between_parcels_;
+        double const latency_target = double(latency_target_) * 1000.;
+
+        std::size_t batch_size = max_batch_size_;
+        if (time_between_parcels >= latency_target)
+        {
+            batch_size = 1;
+        }
+        else if (time_between_parcels > 0)
+        {
+            batch_size = (std::min)(max_batch_size_,
+                std::size_t(latency_target / time_between_parcels));
+        }
+        if (batch_size == 0)
+            batch_size = 1;
+
+        double interval = (std::min)(latency_target,
+            double(batch_size + 1) * time_between_parcels);
+
+        batch_size_ = batch_size;
+        interval_ = (std::max)(std::size_t(1), std::size_t(interval / 1000.));
+    }
+
     // performance counter values
     boost::int64_t
     coalescing_message_handler::get_average_time_between_parcels(bool reset)
@@ -285,36 +382,40 @@ namespace hpx { namespace plugins { namespace parcel
         return num_parcels;
     }
 
+    // the parcels and messages counted for the parcels-per-message counter,
+    // which is reset independently from the parcels and messages counters
     boost::int64_t
-        coalescing_message_handler::get_parcels_per_message_count(bool reset)
+        coalescing_message_handler::get_parcels_per_message_parcels(bool reset)
     {
         std::unique_lock<mutex_type> l(mtx_);
-
-        if (num_messages_ == 0)
-        {
-            if (reset)
-            {
-                reset_num_parcels_per_message_parcels_ = num_parcels_;
-                reset_num_parcels_per_message_messages_ = num_messages_;
-            }
-            return 0;
-        }
-
         boost::int64_t num_parcels =
             num_parcels_ - reset_num_parcels_per_message_parcels_;
-        boost::int64_t
-            num_messages = num_messages_ - reset_num_parcels_per_message_messages_;
-
         if (reset)
-        {
             reset_num_parcels_per_message_parcels_ = num_parcels_;
+        return num_parcels;
+    }
+
+    boost::int64_t
+        coalescing_message_handler::get_parcels_per_message_messages(bool reset)
+    {
+        std::unique_lock<mutex_type> l(mtx_);
+        boost::int64_t num_messages =
+            num_messages_ - reset_num_parcels_per_message_messages_;
+        if (reset)
             reset_num_parcels_per_message_messages_ = num_messages_;
-        }
+        return num_messages;
+    }
 
-        if (num_messages == 0)
-            return 0;
+    boost::int64_t coalescing_message_handler::get_batch_size(bool /*reset*/)
+    {
+        std::unique_lock<mutex_type> l(mtx_);
+        return boost::int64_t(batch_size_);
+    }
 
-        return num_parcels / num_messages;
+    boost::int64_t coalescing_message_handler::get_flush_interval(bool /*reset*/)
+    {
+        std::unique_lock<mutex_type> l(mtx_);
+        return boost::int64_t(interval_) * 1000;        // [ns]
     }
 
     boost::int64_t coalescing_message_handler::get_messages_count(bool reset)
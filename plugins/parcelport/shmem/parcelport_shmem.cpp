@@ -0,0 +1,297 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/traits/plugin_config_data.hpp>
+
+#if defined(HPX_HAVE_PARCELPORT_SHMEM)
+
+#include <hpx/plugins/parcelport_factory.hpp>
+#include <hpx/util/command_line_handling.hpp>
+
+// parcelport
+#include <hpx/runtime.hpp>
+#include <hpx/runtime/parcelset/locality.hpp>
+#include <hpx/runtime/parcelset/parcelport_impl.hpp>
+
+#include <hpx/lcos/local/spinlock.hpp>
+
+#include <hpx/plugins/parcelport/shmem/locality.hpp>
+#include <hpx/plugins/parcelport/shmem/receiver.hpp>
+#include <hpx/plugins/parcelport/shmem/sender.hpp>
+
+#include <hpx/util/runtime_configuration.hpp>
+#include <hpx/util/safe_lexical_cast.hpp>
+
+#include <boost/asio/ip/host_name.hpp>
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+namespace hpx
+{
+    bool is_starting();
+}
+
+namespace hpx { namespace parcelset
+{
+    namespace policies { namespace shmem
+    {
+        class HPX_EXPORT parcelport;
+    }}
+
+    template <>
+    struct connection_handler_traits<policies::shmem::parcelport>
+    {
+        typedef policies::shmem::sender_connection connection_type;
+        typedef std::false_type send_early_parcel;
+        typedef std::true_type do_background_work;
+
+        static const char * type()
+        {
+            return "shmem";
+        }
+
+        static const char * pool_name()
+        {
+            return "parcel-pool-shmem";
+        }
+
+        static const char * pool_name_postfix()
+        {
+            return "-shmem";
+        }
+    };
+
+    namespace policies { namespace shmem
+    {
+        void add_connection(sender * s,
+            std::shared_ptr<sender_connection> const &ptr)
+        {
+            s->add(ptr);
+        }
+
+        // The shmem parcelport can only be used as an alternative parcelport
+        // between localities running on the same node. It uses the same
+        // address and port as the tcp parcelport to identify localities.
+        class HPX_EXPORT parcelport
+          : public parcelport_impl<parcelport>
+        {
+            typedef parcelport_impl<parcelport> base_type;
+
+            static parcelset::locality here(
+                util::runtime_configuration const& ini)
+            {
+                if (ini.has_section("hpx.parcel")) {
+                    util::section const* sec = ini.get_section("hpx.parcel");
+                    if (nullptr != sec) {
+                        return parcelset::locality(
+                            locality(
+                                sec->get_entry("address",
+                                    HPX_INITIAL_IP_ADDRESS)
+                              , hpx::util::get_entry_as<boost::uint16_t>(
+                                    *sec, "port", HPX_INITIAL_IP_PORT)
+                            )
+                        );
+                    }
+                }
+                return
+                    parcelset::locality(
+                        locality(
+                            HPX_INITIAL_IP_ADDRESS
+                          , HPX_INITIAL_IP_PORT
+                        )
+                    );
+            }
+
+            static sender::channel_settings channel_settings(
+                util::runtime_configuration const& ini)
+            {
+                sender::channel_settings settings;
+
+                // the size of the ring has to be a power of two
+                std::size_t ring_size = hpx::util::get_entry_as<std::size_t>(
+                    ini, "hpx.parcel.shmem.ring_size", "1048576");
+                settings.ring_size_ = 4096;
+                while (settings.ring_size_ < ring_size)
+                    settings.ring_size_ <<= 1;
+
+                settings.block_size_ = hpx::util::get_entry_as<std::size_t>(
+                    ini, "hpx.parcel.shmem.slab_block_size", "65536");
+                settings.num_blocks_ = hpx::util::get_entry_as<std::size_t>(
+                    ini, "hpx.parcel.shmem.slab_blocks", "256");
+                settings.slab_threshold_ =
+                    hpx::util::get_entry_as<std::size_t>(
+                        ini, "hpx.parcel.shmem.slab_threshold", "16384");
+
+                if (settings.block_size_ == 0)
+                    settings.num_blocks_ = 0;
+                return settings;
+            }
+
+        public:
+            parcelport(util::runtime_configuration const& ini,
+                util::function_nonser<void(std::size_t, char const*)>
+                    const& on_start,
+                util::function_nonser<void()> const& on_stop)
+              : base_type(ini, here(ini), on_start, on_stop)
+              , stopped_(false)
+              , sender_(here_.get<locality>(), channel_settings(ini))
+              , receiver_(*this)
+            {}
+
+            bool can_connect(parcelset::locality const & dest,
+                bool use_alternative)
+            {
+                if (use_alternative)
+                {
+                    return dest.get<locality>().address() ==
+                        here_.get<locality>().address();
+                }
+                return false;
+            }
+
+            /// Start the handling of connections.
+            bool do_run()
+            {
+                receiver_.run(here_.get<locality>());
+                for(std::size_t i = 0; i != io_service_pool_.size(); ++i)
+                {
+                    io_service_pool_.get_io_service(int(i)).post(
+                        hpx::util::bind(
+                            &parcelport::io_service_work, this
+                        )
+                    );
+                }
+                return true;
+            }
+
+            /// Stop the handling of connectons.
+            void do_stop()
+            {
+                while(do_background_work(0))
+                {
+                    if(threads::get_self_ptr())
+                        hpx::this_thread::suspend(hpx::threads::pending,
+                            "shmem::parcelport::do_stop");
+                }
+                stopped_ = true;
+                receiver_.stop();
+            }
+
+            /// Return the name of this locality
+            std::string get_locality_name() const
+            {
+                return boost::asio::ip::host_name();
+            }
+
+            std::shared_ptr<sender_connection> create_connection(
+                parcelset::locality const& l, error_code& ec)
+            {
+                return sender_.create_connection(l, parcels_sent_, ec);
+            }
+
+            parcelset::locality agas_locality(
+                util::runtime_configuration const & ini) const
+            {
+                // This parcelport cannot be used during bootstrapping
+                HPX_ASSERT(false);
+                return parcelset::locality();
+            }
+
+            parcelset::locality create_locality() const
+            {
+                return parcelset::locality(locality());
+            }
+
+            bool background_work(std::size_t num_thread)
+            {
+                if (stopped_)
+                    return false;
+
+                bool has_work = false;
+                has_work = sender_.background_work();
+                has_work = receiver_.background_work(num_thread) || has_work;
+                return has_work;
+            }
+
+        private:
+            boost::atomic<bool> stopped_;
+
+            sender sender_;
+            receiver<parcelport> receiver_;
+
+            void io_service_work()
+            {
+                std::size_t k = 0;
+                // We only execute work on the IO service while HPX is starting
+                while(hpx::is_starting())
+                {
+                    bool has_work = sender_.background_work();
+                    has_work = receiver_.background_work(-1) || has_work;
+                    if(has_work)
+                    {
+                        k = 0;
+                    }
+                    else
+                    {
+                        ++k;
+                        hpx::lcos::local::spinlock::yield(k);
+                    }
+                }
+            }
+        };
+    }}
+}}
+
+#include <hpx/config/warnings_suffix.hpp>
+
+namespace hpx { namespace traits
+{
+    // Inject additional configuration data into the factory registry for this
+    // type. This information ends up in the system wide configuration database
+    // under the plugin specific section:
+    //
+    //      [hpx.parcel.shmem]
+    //      ...
+    //      priority = 40
+    //
+    template <>
+    struct plugin_config_data<hpx::parcelset::policies::shmem::parcelport>
+    {
+        static char const* priority()
+        {
+            return "40";
+        }
+
+        static void init(int *argc, char ***argv,
+            util::command_line_handling &cfg)
+        {
+        }
+
+        static char const* call()
+        {
+            return
+                "ring_size = ${HPX_PARCEL_SHMEM_RING_SIZE:1048576}\n"
+                "slab_block_size = ${HPX_PARCEL_SHMEM_SLAB_BLOCK_SIZE:65536}\n"
+                "slab_blocks = ${HPX_PARCEL_SHMEM_SLAB_BLOCKS:256}\n"
+                "slab_threshold = ${HPX_PARCEL_SHMEM_SLAB_THRESHOLD:16384}\n"
+                "enable = 0"
+                ;
+        }
+    };
+}}
+
+HPX_REGISTER_PARCELPORT(
+    hpx::parcelset::policies::shmem::parcelport,
+    shmem);
+
+#endif
@@ -31,3 +31,6 @@ HPX_REGISTER_ACTION(
 HPX_REGISTER_ACTION(
     hpx::components::server::component_storage::size_action,
     component_storage_size_action);
+HPX_REGISTER_ACTION(
+    hpx::components::server::component_storage::restore_action,
+    component_storage_restore_action);
@@ -9,6 +9,7 @@
 
 #include <hpx/components/component_storage/component_storage.hpp>
 
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -22,6 +23,29 @@ namespace hpx { namespace components
       : base_type(std::move(f))
     {}
 
+    namespace detail
+    {
+        hpx::future<naming::id_type> create_persistent_storage(
+            hpx::id_type const& target_locality, std::string const& path)
+        {
+            typedef server::component_storage::restore_action action_type;
+            return hpx::new_<server::component_storage>(target_locality, path)
+                .then(
+                    [](hpx::future<naming::id_type> && f) -> naming::id_type
+                    {
+                        // make the components stored in the file accessible
+                        naming::id_type id = f.get();
+                        action_type()(id);
+                        return id;
+                    });
+        }
+    }
+
+    component_storage::component_storage(hpx::id_type target_locality,
+            std::string const& path)
+      : base_type(detail::create_persistent_storage(target_locality, path))
+    {}
+
     ///////////////////////////////////////////////////////////////////////////
     hpx::future<naming::id_type> component_storage::migrate_to_here(
         std::vector<char> const& data, naming::id_type const& id,
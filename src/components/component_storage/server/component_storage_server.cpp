@@ -7,6 +7,10 @@
 #include <hpx/components/component_storage/server/component_storage.hpp>
 #include <hpx/runtime/find_localities.hpp>
 
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
 #include <vector>
 
 namespace hpx { namespace components { namespace server
@@ -15,13 +19,20 @@ namespace hpx { namespace components { namespace server
       : data_(container_layout(find_all_localities()))
     {}
 
+    component_storage::component_storage(std::string const& path)
+      : log_(new persistent_storage(path))
+    {}
+
     ///////////////////////////////////////////////////////////////////////////
     naming::gid_type component_storage::migrate_to_here(
         std::vector<char> const& data, naming::id_type id,
         naming::address const& current_lva)
     {
         naming::gid_type gid(naming::detail::get_stripped_gid(id.get_gid()));
-        data_[gid] = data;
+        if (log_)
+            log_->store(gid, current_lva, data);
+        else
+            data_[gid] = data;
 
         // rebind the object to this storage locality
         naming::address addr(current_lva);
@@ -45,8 +56,53 @@ namespace hpx { namespace components { namespace server
     std::vector<char> component_storage::migrate_from_here(
         naming::gid_type const& id)
     {
+        naming::gid_type gid(naming::detail::get_stripped_gid(id));
+        if (log_)
+        {
+            // return the stored data and mark it as erased in the log
+            std::vector<char> data;
+            if (!log_->load(gid, data, true))
+            {
+                std::ostringstream strm;
+                strm << "the component storage " << gid_
+                     << " does not hold the id " << gid;
+
+                HPX_THROW_EXCEPTION(bad_parameter,
+                    "component_storage::migrate_from_here",
+                    strm.str());
+            }
+            return data;
+        }
+
         // return the stored data and erase it from the map
-        return data_.get_value_sync(naming::detail::get_stripped_gid(id), true);
+        return data_.get_value_sync(gid, true);
+    }
+
+    std::size_t component_storage::restore()
+    {
+        if (!log_)
+            return 0;
+
+        typedef std::pair<naming::gid_type, naming::address> entry_type;
+        std::vector<entry_type> entries = log_->entries();
+
+        for (entry_type& e : entries)
+        {
+            naming::address addr(e.second);
+            addr.address_ = 0;       // invalidate lva
+            if (!agas::bind_sync(e.first, addr, this->gid_))
+            {
+                std::ostringstream strm;
+                strm << "failed to rebind id " << e.first
+                     << " to storage locality: " << gid_;
+
+                HPX_THROW_EXCEPTION(duplicate_component_address,
+                    "component_storage::restore",
+                    strm.str());
+                return 0;
+            }
+        }
+        return entries.size();
     }
 }}}
 
@@ -0,0 +1,660 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/async.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/bind.hpp>
+
+#include <hpx/components/component_storage/server/persistent_storage.hpp>
+
+#include <boost/cstdint.hpp>
+
+#if !defined(HPX_WINDOWS)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace components { namespace server
+{
+#if !defined(HPX_WINDOWS)
+    namespace
+    {
+        char const log_magic[8] = { 'H', 'P', 'X', 'S', 'T', 'O', 'R', 'E' };
+        boost::uint64_t const log_version = 1;
+
+        struct file_header
+        {
+            char magic_[8];
+            boost::uint64_t version_;
+            boost::uint64_t end_;
+            boost::uint64_t reserved_;
+        };
+
+        enum record_state
+        {
+            record_erased = 0,
+            record_live = 0x4556494c        // 'LIVE'
+        };
+
+        struct record_header
+        {
+            boost::uint64_t gid_msb_;
+            boost::uint64_t gid_lsb_;
+            boost::uint64_t locality_msb_;
+            boost::uint64_t locality_lsb_;
+            boost::uint32_t type_;
+            boost::uint32_t state_;
+            boost::uint64_t size_;
+        };
+
+        // the log grows in powers of two starting at 1MB
+        std::size_t const initial_size = 1024 * 1024;
+
+        // don't bother compacting logs with less dead data than this
+        std::size_t const min_compaction_size = 1024 * 1024;
+
+        inline std::size_t record_size(std::size_t size)
+        {
+            return sizeof(record_header) + ((size + 7) & ~std::size_t(7));
+        }
+
+        inline std::size_t capacity_for(std::size_t size)
+        {
+            std::size_t capacity = initial_size;
+            while (capacity < size)
+                capacity *= 2;
+            return capacity;
+        }
+
+        std::string error_message(char const* what, std::string const& path)
+        {
+            return std::string(what) + " " + path + ": " + std::strerror(errno);
+        }
+
+        void write_at(int fd, void const* data, std::size_t size,
+            std::size_t offset, std::string const& path)
+        {
+            char const* p = static_cast<char const*>(data);
+            while (size != 0)
+            {
+                ssize_t written = ::pwrite(fd, p, size, off_t(offset));
+                if (written < 0)
+                {
+                    if (errno == EINTR)
+                        continue;
+                    HPX_THROW_EXCEPTION(filesystem_error,
+                        "persistent_storage::write_at",
+                        error_message("could not write to", path));
+                }
+                p += written;
+                size -= std::size_t(written);
+                offset += std::size_t(written);
+            }
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // A mapping of the log file. The log is remapped whenever it grows, a
+    // running compaction keeps the previous mapping alive while it copies
+    // the records from it.
+    struct persistent_storage::mapping
+    {
+        mapping(int fd, std::size_t size, std::string const& path)
+          : data_(nullptr), size_(size)
+        {
+            void* p = ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                MAP_SHARED, fd, 0);
+            if (p == MAP_FAILED)
+            {
+                HPX_THROW_EXCEPTION(filesystem_error,
+                    "persistent_storage::mapping",
+                    error_message("could not map", path));
+            }
+            data_ = static_cast<char*>(p);
+        }
+
+        ~mapping()
+        {
+            ::munmap(data_, size_);
+        }
+
+        file_header& header()
+        {
+            return *reinterpret_cast<file_header*>(data_);
+        }
+
+        record_header& record(std::size_t offset)
+        {
+            return *reinterpret_cast<record_header*>(data_ + offset);
+        }
+
+        char* record_data(std::size_t offset)
+        {
+            return data_ + offset + sizeof(record_header);
+        }
+
+        char* data_;
+        std::size_t size_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    persistent_storage::persistent_storage(std::string const& path)
+      : path_(path)
+      , fd_(-1)
+      , end_(sizeof(file_header))
+      , live_bytes_(0)
+      , dead_bytes_(0)
+      , compacting_(false)
+    {
+        open();
+    }
+
+    persistent_storage::~persistent_storage()
+    {
+        // a running compaction still refers to this object
+        if (compaction_.valid())
+            compaction_.wait();
+
+        if (mapping_)
+            ::msync(mapping_->data_, end_, MS_SYNC);
+        close();
+    }
+
+    void persistent_storage::open()
+    {
+        fd_ = ::open(path_.c_str(), O_RDWR | O_CREAT, 0644);
+        if (fd_ < 0)
+        {
+            HPX_THROW_EXCEPTION(filesystem_error,
+                "persistent_storage::open",
+                error_message("could not open", path_));
+        }
+
+        try {
+            struct stat st;
+            if (::fstat(fd_, &st) != 0)
+            {
+                HPX_THROW_EXCEPTION(filesystem_error,
+                    "persistent_storage::open",
+                    error_message("could not stat", path_));
+            }
+
+            std::size_t size = static_cast<std::size_t>(st.st_size);
+            if (size == 0)
+            {
+                // initialize a new log
+                reserve(initial_size);
+
+                file_header& h = mapping_->header();
+                std::memcpy(h.magic_, log_magic, sizeof(log_magic));
+                h.version_ = log_version;
+                h.end_ = end_;
+                h.reserved_ = 0;
+                return;
+            }
+
+            if (size >= sizeof(file_header))
+                mapping_ = std::make_shared<mapping>(fd_, size, path_);
+
+            if (!mapping_ ||
+                std::memcmp(mapping_->header().magic_, log_magic,
+                    sizeof(log_magic)) != 0 ||
+                mapping_->header().version_ != log_version ||
+                mapping_->header().end_ < sizeof(file_header) ||
+                mapping_->header().end_ > size)
+            {
+                HPX_THROW_EXCEPTION(bad_parameter,
+                    "persistent_storage::open",
+                    path_ + " is not a valid component storage log");
+            }
+
+            end_ = static_cast<std::size_t>(mapping_->header().end_);
+            rebuild_index();
+        }
+        catch (...) {
+            close();
+            throw;
+        }
+    }
+
+    void persistent_storage::close()
+    {
+        mapping_.reset();
+        if (fd_ >= 0)
+        {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+
+    // make sure the log can hold at least the given number of bytes
+    void persistent_storage::reserve(std::size_t size)
+    {
+        if (mapping_ && size <= mapping_->size_)
+            return;
+
+        std::size_t capacity = capacity_for(size);
+        if (::ftruncate(fd_, off_t(capacity)) != 0)
+        {
+            HPX_THROW_EXCEPTION(filesystem_error,
+                "persistent_storage::reserve",
+                error_message("could not resize", path_));
+        }
+
+        // the previous mapping stays valid as the file only grows
+        mapping_ = std::make_shared<mapping>(fd_, capacity, path_);
+    }
+
+    void persistent_storage::rebuild_index()
+    {
+        index_.clear();
+        live_bytes_ = 0;
+        dead_bytes_ = 0;
+
+        std::size_t offset = sizeof(file_header);
+        while (offset != end_)
+        {
+            record_header& r = mapping_->record(offset);
+            if (end_ - offset < sizeof(record_header) ||
+                r.size_ > end_ - offset ||
+                record_size(r.size_) > end_ - offset ||
+                (r.state_ != record_live && r.state_ != record_erased))
+            {
+                HPX_THROW_EXCEPTION(bad_parameter,
+                    "persistent_storage::rebuild_index",
+                    "the component storage log " + path_ + " is corrupted");
+            }
+
+            std::size_t size = record_size(r.size_);
+            if (r.state_ == record_live)
+            {
+                index_entry e = {
+                    offset, static_cast<std::size_t>(r.size_),
+                    naming::address(
+                        naming::gid_type(r.locality_msb_, r.locality_lsb_),
+                        components::component_type(r.type_),
+                        naming::address::address_type(0))
+                };
+
+                live_bytes_ += size;
+
+                // the application might have stopped after a record was
+                // replaced but before the replaced record was marked as
+                // erased, the later record wins
+                naming::gid_type gid(r.gid_msb_, r.gid_lsb_);
+                std::pair<index_type::iterator, bool> p =
+                    index_.insert(index_type::value_type(gid, e));
+                if (!p.second)
+                {
+                    erase_record(p.first->second);
+                    p.first->second = e;
+                }
+            }
+            else
+            {
+                dead_bytes_ += size;
+            }
+
+            offset += size;
+        }
+    }
+
+    void persistent_storage::erase_record(index_entry const& e)
+    {
+        mapping_->record(e.offset_).state_ = record_erased;
+
+        std::size_t size = record_size(e.size_);
+        live_bytes_ -= size;
+        dead_bytes_ += size;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void persistent_storage::store(naming::gid_type const& gid,
+        naming::address const& addr, std::vector<char> const& data)
+    {
+        std::unique_lock<mutex_type> l(mtx_);
+
+        std::size_t offset = end_;
+        std::size_t size = record_size(data.size());
+        reserve(offset + size);
+
+        record_header& r = mapping_->record(offset);
+        r.gid_msb_ = gid.get_msb();
+        r.gid_lsb_ = gid.get_lsb();
+        r.locality_msb_ = addr.locality_.get_msb();
+        r.locality_lsb_ = addr.locality_.get_lsb();
+        r.type_ = static_cast<boost::uint32_t>(addr.type_);
+        r.state_ = record_live;
+        r.size_ = data.size();
+
+        if (!data.empty())
+        {
+            std::memcpy(mapping_->record_data(offset), data.data(),
+                data.size());
+        }
+
+        // commit the new record
+        end_ = offset + size;
+        mapping_->header().end_ = end_;
+        live_bytes_ += size;
+
+        index_entry e = { offset, data.size(), addr };
+        std::pair<index_type::iterator, bool> p =
+            index_.insert(index_type::value_type(gid, e));
+        if (!p.second)
+        {
+            erase_record(p.first->second);
+            p.first->second = e;
+        }
+
+        maybe_compact(l);
+    }
+
+    bool persistent_storage::load(naming::gid_type const& gid,
+        std::vector<char>& data, bool erase)
+    {
+        std::unique_lock<mutex_type> l(mtx_);
+
+        index_type::iterator it = index_.find(gid);
+        if (it == index_.end())
+            return false;
+
+        char const* p = mapping_->record_data(it->second.offset_);
+        data.assign(p, p + it->second.size_);
+
+        if (erase)
+        {
+            erase_record(it->second);
+            index_.erase(it);
+            maybe_compact(l);
+        }
+        return true;
+    }
+
+    std::vector<std::pair<naming::gid_type, naming::address> >
+        persistent_storage::entries() const
+    {
+        std::vector<std::pair<naming::gid_type, naming::address> > result;
+
+        std::lock_guard<mutex_type> l(mtx_);
+        result.reserve(index_.size());
+        for (index_type::value_type const& e : index_)
+            result.push_back(std::make_pair(e.first, e.second.addr_));
+        return result;
+    }
+
+    std::size_t persistent_storage::size() const
+    {
+        std::lock_guard<mutex_type> l(mtx_);
+        return index_.size();
+    }
+
+    void persistent_storage::flush()
+    {
+        std::lock_guard<mutex_type> l(mtx_);
+        if (::msync(mapping_->data_, end_, MS_SYNC) != 0)
+        {
+            HPX_THROW_EXCEPTION(filesystem_error,
+                "persistent_storage::flush",
+                error_message("could not synchronize", path_));
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void persistent_storage::compact()
+    {
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+            if (compacting_)
+                return;
+            compacting_ = true;
+        }
+        compact_log();
+    }
+
+    void persistent_storage::maybe_compact(std::unique_lock<mutex_type>& l)
+    {
+        HPX_ASSERT(l.owns_lock());
+
+        if (compacting_ || dead_bytes_ < min_compaction_size ||
+            dead_bytes_ <= live_bytes_)
+        {
+            return;
+        }
+
+        // the compaction needs the lock, run it on a new thread
+        compacting_ = true;
+        compaction_ = hpx::async(launch::async,
+            util::bind(&persistent_storage::compact_log, this));
+    }
+
+    // The compaction copies the live records into a new file in three steps:
+    //
+    // 1) take a snapshot of the index (under the lock)
+    // 2) copy the records of the snapshot (without holding the lock, the
+    //    snapshot's records are not modified anymore as the log only grows)
+    // 3) copy the records appended in the meantime and mark the copies of
+    //    the records erased in the meantime as dead, then replace the log
+    //    by the new file (under the lock)
+    void persistent_storage::compact_log()
+    {
+        struct moved_record
+        {
+            naming::gid_type gid_;
+            std::size_t offset_;
+            std::size_t new_offset_;
+            std::size_t size_;
+        };
+
+        std::string const new_path = path_ + ".compact";
+        int fd = ::open(new_path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+
+        try {
+            if (fd < 0)
+            {
+                HPX_THROW_EXCEPTION(filesystem_error,
+                    "persistent_storage::compact_log",
+                    error_message("could not open", new_path));
+            }
+
+            // step 1
+            std::shared_ptr<mapping> snapshot;
+            std::size_t snapshot_end = 0;
+            std::vector<moved_record> moved;
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                snapshot = mapping_;
+                snapshot_end = end_;
+
+                moved.reserve(index_.size());
+                for (index_type::value_type const& e : index_)
+                {
+                    moved_record r = { e.first, e.second.offset_, 0,
+                        record_size(e.second.size_) };
+                    moved.push_back(r);
+                }
+            }
+
+            // copy the records in the order they appear in the log
+            std::sort(moved.begin(), moved.end(),
+                [](moved_record const& lhs, moved_record const& rhs)
+                {
+                    return lhs.offset_ < rhs.offset_;
+                });
+
+            // step 2
+            std::size_t new_end = sizeof(file_header);
+            for (moved_record& r : moved)
+            {
+                record_header h = snapshot->record(r.offset_);
+                h.state_ = record_live;
+
+                write_at(fd, &h, sizeof(h), new_end, new_path);
+                write_at(fd, snapshot->record_data(r.offset_),
+                    r.size_ - sizeof(record_header),
+                    new_end + sizeof(record_header), new_path);
+
+                r.new_offset_ = new_end;
+                new_end += r.size_;
+            }
+            snapshot.reset();
+
+            if (::fsync(fd) != 0)
+            {
+                HPX_THROW_EXCEPTION(filesystem_error,
+                    "persistent_storage::compact_log",
+                    error_message("could not synchronize", new_path));
+            }
+
+            // step 3
+            std::lock_guard<mutex_type> l(mtx_);
+
+            std::size_t live_bytes = 0;
+            std::size_t dead_bytes = 0;
+
+            // the new offsets of the records which are still live
+            std::vector<std::pair<index_entry*, std::size_t> > offsets;
+            offsets.reserve(index_.size());
+
+            for (index_type::value_type& e : index_)
+            {
+                if (e.second.offset_ < snapshot_end)
+                    continue;
+
+                std::size_t size = record_size(e.second.size_);
+                write_at(fd, &mapping_->record(e.second.offset_), size,
+                    new_end, new_path);
+
+                offsets.push_back(std::make_pair(&e.second, new_end));
+                live_bytes += size;
+                new_end += size;
+            }
+
+            for (moved_record const& r : moved)
+            {
+                index_type::iterator it = index_.find(r.gid_);
+                if (it != index_.end() && it->second.offset_ == r.offset_)
+                {
+                    offsets.push_back(
+                        std::make_pair(&it->second, r.new_offset_));
+                    live_bytes += r.size_;
+                }
+                else
+                {
+                    boost::uint32_t state = record_erased;
+                    write_at(fd, &state, sizeof(state),
+                        r.new_offset_ + offsetof(record_header, state_),
+                        new_path);
+                    dead_bytes += r.size_;
+                }
+            }
+
+            file_header h;
+            std::memcpy(h.magic_, log_magic, sizeof(log_magic));
+            h.version_ = log_version;
+            h.end_ = new_end;
+            h.reserved_ = 0;
+            write_at(fd, &h, sizeof(h), 0, new_path);
+
+            std::size_t capacity = capacity_for(new_end);
+            if (::ftruncate(fd, off_t(capacity)) != 0)
+            {
+                HPX_THROW_EXCEPTION(filesystem_error,
+                    "persistent_storage::compact_log",
+                    error_message("could not resize", new_path));
+            }
+
+            std::shared_ptr<mapping> new_mapping =
+                std::make_shared<mapping>(fd, capacity, new_path);
+
+            if (std::rename(new_path.c_str(), path_.c_str()) != 0)
+            {
+                HPX_THROW_EXCEPTION(filesystem_error,
+                    "persistent_storage::compact_log",
+                    error_message("could not replace", path_));
+            }
+
+            // nothing can fail anymore, switch over to the new log
+            for (std::pair<index_entry*, std::size_t> const& o : offsets)
+                o.first->offset_ = o.second;
+
+            ::close(fd_);
+            fd_ = fd;
+            mapping_ = std::move(new_mapping);
+
+            end_ = new_end;
+            live_bytes_ = live_bytes;
+            dead_bytes_ = dead_bytes;
+            compacting_ = false;
+        }
+        catch (...) {
+            if (fd >= 0)
+            {
+                ::close(fd);
+                ::unlink(new_path.c_str());
+            }
+
+            std::lock_guard<mutex_type> l(mtx_);
+            compacting_ = false;
+            throw;
+        }
+    }
+
+#else
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Memory mapped files are not supported on Windows (yet).
+    struct persistent_storage::mapping {};
+
+    persistent_storage::persistent_storage(std::string const& path)
+      : path_(path), fd_(-1), end_(0), live_bytes_(0), dead_bytes_(0),
+        compacting_(false)
+    {
+        HPX_THROW_EXCEPTION(not_implemented,
+            "persistent_storage::persistent_storage",
+            "the persistent component storage is not supported on Windows");
+    }
+
+    persistent_storage::~persistent_storage() {}
+
+    void persistent_storage::store(naming::gid_type const&,
+        naming::address const&, std::vector<char> const&)
+    {}
+
+    bool persistent_storage::load(naming::gid_type const&,
+        std::vector<char>&, bool)
+    {
+        return false;
+    }
+
+    std::vector<std::pair<naming::gid_type, naming::address> >
+        persistent_storage::entries() const
+    {
+        return std::vector<std::pair<naming::gid_type, naming::address> >();
+    }
+
+    std::size_t persistent_storage::size() const { return 0; }
+
+    void persistent_storage::flush() {}
+    void persistent_storage::compact() {}
+
+#endif
+}}}
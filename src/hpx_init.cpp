@@ -26,6 +26,7 @@
 #include <hpx/util/command_line_handling.hpp>
 #include <hpx/util/function.hpp>
 #include <hpx/util/query_counters.hpp>
+#include <hpx/util/stream_counters.hpp>
 
 #include <boost/algorithm/string/split.hpp>
 #include <boost/algorithm/string/classification.hpp>
@@ -296,6 +297,20 @@ namespace hpx { namespace detail
             hpx::terminate();
         }
     }
+
+    void start_stream_counters(
+        std::shared_ptr<util::stream_counters> const& sc)
+    {
+        try {
+            HPX_ASSERT(sc);
+            sc->start();
+        }
+        catch (...) {
+            std::cerr << hpx::diagnostic_information(boost::current_exception())
+                << std::flush;
+            hpx::terminate();
+        }
+    }
 }}
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -453,6 +468,61 @@ namespace hpx
                     "--hpx:reset-counters, valid in conjunction with "
                     "--hpx:print-counter only");
             }
+
+            if (vm.count("hpx:stream-counter")) {
+                std::vector<std::string> counters =
+                    vm["hpx:stream-counter"].as<std::vector<std::string> >();
+
+                std::size_t interval = 1;
+                if (vm.count("hpx:stream-counter-interval")) {
+                    interval = vm["hpx:stream-counter-interval"]
+                        .as<std::size_t>();
+                }
+
+                std::string destination("counters.{locality}.bin");
+                if (vm.count("hpx:stream-counter-destination")) {
+                    destination = vm["hpx:stream-counter-destination"]
+                        .as<std::string>();
+                }
+
+                std::size_t downsample = 1;
+                if (vm.count("hpx:stream-counter-downsample")) {
+                    downsample = vm["hpx:stream-counter-downsample"]
+                        .as<std::size_t>();
+                }
+
+                if (interval == 0) {
+                    throw detail::command_line_error("Invalid command line "
+                        "option --hpx:stream-counter-interval, the interval "
+                        "must not be zero");
+                }
+
+                std::shared_ptr<util::stream_counters> sc =
+                    std::make_shared<util::stream_counters>(
+                        counters, interval, destination, downsample);
+
+                // schedule to start sampling, the buffered samples are
+                // written at shutdown
+                rt.add_startup_function(
+                    util::bind(&start_stream_counters, sc));
+                rt.add_pre_shutdown_function(
+                    util::bind(&util::stream_counters::stop, sc));
+            }
+            else if (vm.count("hpx:stream-counter-interval")) {
+                throw detail::command_line_error("Invalid command line option "
+                    "--hpx:stream-counter-interval, valid in conjunction with "
+                    "--hpx:stream-counter only");
+            }
+            else if (vm.count("hpx:stream-counter-destination")) {
+                throw detail::command_line_error("Invalid command line option "
+                    "--hpx:stream-counter-destination, valid in conjunction "
+                    "with --hpx:stream-counter only");
+            }
+            else if (vm.count("hpx:stream-counter-downsample")) {
+                throw detail::command_line_error("Invalid command line option "
+                    "--hpx:stream-counter-downsample, valid in conjunction "
+                    "with --hpx:stream-counter only");
+            }
         }
 
         void add_startup_functions(hpx::runtime& rt,
@@ -512,6 +582,18 @@ namespace hpx
             }
         }
 
+        void ensure_hierarchical_stealing_compatibility(
+            boost::program_options::variables_map const& vm)
+        {
+            if (vm.count("hpx:hierarchical-stealing")) {
+                throw detail::command_line_error("Invalid command line option "
+                    "--hpx:hierarchical-stealing, valid for "
+                    "--hpx:queuing=local-priority, "
+                    "--hpx:queuing=abp-priority, or "
+                    "--hpx:queuing=chase-lev-priority only");
+            }
+        }
+
         void ensure_hierarchy_arity_compatibility(
             boost::program_options::variables_map const& vm)
         {
@@ -527,6 +609,7 @@ namespace hpx
         {
             ensure_high_priority_compatibility(vm);
             ensure_numa_sensitivity_compatibility(vm);
+            ensure_hierarchical_stealing_compatibility(vm);
             ensure_hierarchy_arity_compatibility(vm);
         }
 
@@ -729,6 +812,7 @@ namespace hpx
 #if defined(HPX_HAVE_LOCAL_SCHEDULER)
             ensure_high_priority_compatibility(cfg.vm_);
             ensure_hierarchy_arity_compatibility(cfg.vm_);
+            ensure_hierarchical_stealing_compatibility(cfg.vm_);
 
             std::size_t pu_offset = get_pu_offset(cfg);
             std::size_t pu_step = get_pu_step(cfg);
@@ -771,6 +855,7 @@ namespace hpx
 #if defined(HPX_HAVE_THROTTLE_SCHEDULER) && defined(HPX_HAVE_APEX)
             ensure_high_priority_compatibility(cfg.vm_);
             ensure_hierarchy_arity_compatibility(cfg.vm_);
+            ensure_hierarchical_stealing_compatibility(cfg.vm_);
 
             std::size_t pu_offset = get_pu_offset(cfg);
             std::size_t pu_step = get_pu_step(cfg);
@@ -814,6 +899,7 @@ namespace hpx
         {
 #if defined(HPX_HAVE_STATIC_PRIORITY_SCHEDULER)
             ensure_hierarchy_arity_compatibility(cfg.vm_);
+            ensure_hierarchical_stealing_compatibility(cfg.vm_);
 
             std::size_t num_high_priority_queues =
                 get_num_high_priority_queues(cfg);
@@ -861,6 +947,7 @@ namespace hpx
 #if defined(HPX_HAVE_STATIC_SCHEDULER)
             ensure_high_priority_compatibility(cfg.vm_);
             ensure_hierarchy_arity_compatibility(cfg.vm_);
+            ensure_hierarchical_stealing_compatibility(cfg.vm_);
 
             std::size_t pu_offset = get_pu_offset(cfg);
             std::size_t pu_step = get_pu_step(cfg);
@@ -918,6 +1005,7 @@ namespace hpx
             local_queue_policy::init_parameter_type init(
                 cfg.num_threads_, num_high_priority_queues, 1000,
                 numa_sensitive, "core-local_priority_queue_scheduler");
+            init.hierarchical_stealing_ = cfg.hierarchical_stealing_;
             threads::policies::init_affinity_data affinity_init(
                 pu_offset, pu_step, affinity_domain, affinity_desc);
 
@@ -951,6 +1039,7 @@ namespace hpx
             abp_priority_queue_policy::init_parameter_type init(
                 cfg.num_threads_, num_high_priority_queues, 1000,
                 cfg.numa_sensitive_, "core-abp_fifo_priority_queue_scheduler");
+            init.hierarchical_stealing_ = cfg.hierarchical_stealing_;
 
             // Build and configure this runtime instance.
             typedef hpx::runtime_impl<abp_priority_queue_policy> runtime_type;
@@ -967,6 +1056,55 @@ namespace hpx
 #endif
         }
 
+        ///////////////////////////////////////////////////////////////////////
+        // priority Chase-Lev scheduler: local priority scheduler using one
+        // Chase-Lev work-stealing deque per OS thread for its pending work
+        // items, the owning OS thread pushes/pops at one end without atomic
+        // read-modify-write operations, all other OS threads steal from the
+        // other end.
+        int run_priority_chase_lev(startup_function_type startup,
+            shutdown_function_type shutdown,
+            util::command_line_handling& cfg, bool blocking)
+        {
+#if defined(HPX_HAVE_CHASE_LEV_SCHEDULER)
+            ensure_hierarchy_arity_compatibility(cfg.vm_);
+
+            std::size_t num_high_priority_queues =
+                get_num_high_priority_queues(cfg);
+            std::size_t pu_offset = get_pu_offset(cfg);
+            std::size_t pu_step = get_pu_step(cfg);
+            std::string affinity_domain = get_affinity_domain(cfg);
+            std::string affinity_desc;
+            std::size_t numa_sensitive =
+                get_affinity_description(cfg, affinity_desc);
+
+            // scheduling policy
+            typedef hpx::threads::policies::chase_lev_priority_queue_scheduler
+                chase_lev_priority_queue_policy;
+            chase_lev_priority_queue_policy::init_parameter_type init(
+                cfg.num_threads_, num_high_priority_queues, 1000,
+                numa_sensitive, "core-chase_lev_priority_queue_scheduler");
+            init.hierarchical_stealing_ = cfg.hierarchical_stealing_;
+            threads::policies::init_affinity_data affinity_init(
+                pu_offset, pu_step, affinity_domain, affinity_desc);
+
+            // Build and configure this runtime instance.
+            typedef hpx::runtime_impl<chase_lev_priority_queue_policy>
+                runtime_type;
+            std::unique_ptr<hpx::runtime> rt(
+                new runtime_type(cfg.rtcfg_, cfg.mode_, cfg.num_threads_, init,
+                    affinity_init));
+
+            return run_or_start(blocking, std::move(rt), cfg,
+                std::move(startup), std::move(shutdown));
+#else
+            throw detail::command_line_error("Command line option "
+                "--hpx:queuing=chase-lev-priority "
+                "is not configured in this build. Please rebuild with "
+                "'cmake -DHPX_WITH_THREAD_SCHEDULERS=chase-lev-priority'.");
+#endif
+        }
+
         ///////////////////////////////////////////////////////////////////////
         // hierarchical scheduler: The thread queues are built up hierarchically
         // this avoids contention during work stealing
@@ -977,6 +1115,7 @@ namespace hpx
 #if defined(HPX_HAVE_HIERARCHY_SCHEDULER)
             ensure_high_priority_compatibility(cfg.vm_);
             ensure_numa_sensitivity_compatibility(cfg.vm_);
+            ensure_hierarchical_stealing_compatibility(cfg.vm_);
             ensure_hwloc_compatibility(cfg.vm_);
 
             // scheduling policy
@@ -1012,6 +1151,7 @@ namespace hpx
         {
 #if defined(HPX_HAVE_PERIODIC_PRIORITY_SCHEDULER)
             ensure_hierarchy_arity_compatibility(cfg.vm_);
+            ensure_hierarchical_stealing_compatibility(cfg.vm_);
             ensure_hwloc_compatibility(cfg.vm_);
 
             std::size_t num_high_priority_queues =
@@ -1130,6 +1270,15 @@ namespace hpx
                     result = run_priority_abp(std::move(startup),
                         std::move(shutdown), cfg, blocking);
                 }
+                else if (0 == std::string("chase-lev-priority").find(cfg.queuing_))
+                {
+                    // local scheduler with priority queue (one Chase-Lev
+                    // work-stealing deque for each OS thread plus separate
+                    // queues for low/high priority HPX-threads)
+                    cfg.queuing_ = "chase-lev-priority";
+                    result = run_priority_chase_lev(std::move(startup),
+                        std::move(shutdown), cfg, blocking);
+                }
                 else if (0 == std::string("hierarchy").find(cfg.queuing_))
                 {
                     // hierarchy scheduler: tree of queues, with work
@@ -11,6 +11,7 @@
 #include <hpx/performance_counters/server/raw_counter.hpp>
 #include <hpx/performance_counters/server/raw_values_counter.hpp>
 #include <hpx/performance_counters/server/elapsed_time_counter.hpp>
+#include <hpx/performance_counters/server/histogram_statistics_counter.hpp>
 #include <hpx/performance_counters/server/statistics_counter.hpp>
 #include <hpx/performance_counters/server/arithmetics_counter.hpp>
 #include <hpx/util/bind.hpp>
@@ -21,6 +22,7 @@
 #include <boost/regex.hpp>
 #include <boost/accumulators/statistics_fwd.hpp>
 
+#include <cmath>
 #include <string>
 #include <utility>
 #include <vector>
@@ -681,12 +683,14 @@ namespace hpx { namespace performance_counters
         }
 
         // make sure the requested counter type is supported
-        if (counter_aggregating != (*it).second.info_.type_ ||
-            counter_aggregating != info.type_)
+        if ((counter_aggregating != (*it).second.info_.type_ ||
+                counter_aggregating != info.type_) &&
+            (counter_histogram != (*it).second.info_.type_ ||
+                counter_histogram != info.type_))
         {
             HPX_THROWS_IF(ec, bad_parameter, "registry::create_statistics_counter",
                 "invalid counter type requested \
-                 (only counter_aggregating is supported)");
+                 (only counter_aggregating and counter_histogram are supported)");
             return status_counter_type_unknown;
         }
 
@@ -761,6 +765,41 @@ namespace hpx { namespace performance_counters
                 gid = components::server::construct<counter_t>(
                     complemented_info, base_counter_name, sample_interval, 0);
             }
+            else if (p.countername_ == "p50" || p.countername_ == "p90" ||
+                p.countername_ == "p99" || p.countername_ == "p999")
+            {
+                typedef hpx::components::component<
+                    hpx::performance_counters::server::
+                        histogram_statistics_counter
+                > counter_t;
+
+                // p999 denotes the 99.9th percentile
+                std::string digits = p.countername_.substr(1);
+                double quantile = std::stod(digits) /
+                    std::pow(10.0, double(digits.size()));
+
+                gid = components::server::construct<counter_t>(
+                    complemented_info, base_counter_name,
+                    counter_t::statistic_percentile, quantile, parameters);
+            }
+            else if (p.countername_ == "histogram") {
+                typedef hpx::components::component<
+                    hpx::performance_counters::server::
+                        histogram_statistics_counter
+                > counter_t;
+                gid = components::server::construct<counter_t>(
+                    complemented_info, base_counter_name,
+                    counter_t::statistic_histogram, 0.0, parameters);
+            }
+            else if (p.countername_ == "ewma_rate") {
+                typedef hpx::components::component<
+                    hpx::performance_counters::server::
+                        histogram_statistics_counter
+                > counter_t;
+                gid = components::server::construct<counter_t>(
+                    complemented_info, base_counter_name,
+                    counter_t::statistic_ewma_rate, 0.0, parameters);
+            }
             else {
                 HPX_THROWS_IF(ec, bad_parameter,
                     "registry::create_statistics_counter",
@@ -0,0 +1,119 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/runtime.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/performance_counters/manage_counter_type.hpp>
+#include <hpx/performance_counters/sample_source.hpp>
+#include <hpx/util/bind.hpp>
+#include <hpx/util/function.hpp>
+#include <hpx/util/sharded_histogram.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace hpx { namespace performance_counters
+{
+    namespace detail
+    {
+        struct sample_source
+        {
+            sample_source(util::sharded_histogram& samples)
+              : samples_(samples), reset_count_(0)
+            {}
+
+            boost::int64_t get_count(bool reset)
+            {
+                boost::uint64_t count = samples_.get_count();
+                boost::uint64_t prev = reset ?
+                    reset_count_.exchange(count) : reset_count_.load();
+                return static_cast<boost::int64_t>(count - prev);
+            }
+
+            util::sharded_histogram& samples_;
+            boost::atomic<boost::uint64_t> reset_count_;
+        };
+
+        struct sample_sources
+        {
+            typedef lcos::local::spinlock mutex_type;
+
+            mutex_type mtx_;
+            std::map<std::string, std::shared_ptr<sample_source> > sources_;
+        };
+
+        sample_sources& get_sample_sources()
+        {
+            static sample_sources sources;
+            return sources;
+        }
+
+        void remove_sample_source(std::string const& type_name)
+        {
+            sample_sources& s = get_sample_sources();
+
+            std::lock_guard<sample_sources::mutex_type> l(s.mtx_);
+            s.sources_.erase(type_name);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    counter_status install_sample_source(std::string const& name,
+        util::sharded_histogram& samples, std::string const& helptext,
+        std::string const& uom, error_code& ec)
+    {
+        std::string type_name;
+        counter_status status = get_counter_type_name(name, type_name, ec);
+        if (!status_is_valid(status)) return status;
+
+        std::shared_ptr<detail::sample_source> source =
+            std::make_shared<detail::sample_source>(samples);
+
+        {
+            detail::sample_sources& s = detail::get_sample_sources();
+
+            std::lock_guard<detail::sample_sources::mutex_type> l(s.mtx_);
+            if (!s.sources_.insert(std::make_pair(type_name, source)).second)
+            {
+                HPX_THROWS_IF(ec, bad_parameter, "install_sample_source",
+                    "sample source " + type_name + " is already installed");
+                return status_already_defined;
+            }
+        }
+
+        // The counters of this type only report the number of samples, the
+        // samples themselves are accessed by the statistics counters.
+        using util::placeholders::_1;
+        status = install_counter_type(name,
+            util::bind(&detail::sample_source::get_count, source, _1),
+            helptext, uom, ec);
+        if (ec || !status_is_valid(status))
+        {
+            detail::remove_sample_source(type_name);
+            return status;
+        }
+
+        get_runtime().add_shutdown_function(
+            util::bind(&detail::remove_sample_source, type_name));
+        return status_valid_data;
+    }
+
+    util::sharded_histogram* find_sample_source(std::string const& type_name)
+    {
+        detail::sample_sources& s = detail::get_sample_sources();
+
+        std::lock_guard<detail::sample_sources::mutex_type> l(s.mtx_);
+        auto it = s.sources_.find(type_name);
+        if (it == s.sources_.end())
+            return nullptr;
+        return &it->second->samples_;
+    }
+}}
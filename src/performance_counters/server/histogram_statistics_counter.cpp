@@ -0,0 +1,420 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/components/derived_component_factory.hpp>
+#include <hpx/runtime/actions/continuation.hpp>
+#include <hpx/runtime/get_locality_id.hpp>
+#include <hpx/util/bind.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+#include <hpx/util/unlock_guard.hpp>
+#include <hpx/performance_counters/counters.hpp>
+#include <hpx/performance_counters/sample_source.hpp>
+#include <hpx/performance_counters/stubs/performance_counter.hpp>
+#include <hpx/performance_counters/server/histogram_statistics_counter.hpp>
+
+#include <boost/format.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+typedef hpx::components::component<
+    hpx::performance_counters::server::histogram_statistics_counter
+> histogram_statistics_counter_type;
+
+HPX_REGISTER_DERIVED_COMPONENT_FACTORY(
+    histogram_statistics_counter_type, histogram_statistics_counter,
+    "base_performance_counter", hpx::components::factory_enabled)
+HPX_DEFINE_GET_COMPONENT_TYPE(
+    hpx::performance_counters::server::histogram_statistics_counter)
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace performance_counters { namespace server
+{
+    namespace detail
+    {
+        boost::int64_t get_interval(
+            std::vector<boost::int64_t> const& parameters)
+        {
+            return parameters.empty() ? 1000 : parameters[0];
+        }
+
+        boost::int64_t get_parameter(
+            std::vector<boost::int64_t> const& parameters, std::size_t i,
+            boost::int64_t default_value)
+        {
+            return parameters.size() > i ? parameters[i] : default_value;
+        }
+    }
+
+    histogram_statistics_counter::histogram_statistics_counter(
+            counter_info const& info, std::string const& base_counter_name,
+            statistic_type statistic, double quantile,
+            std::vector<boost::int64_t> const& parameters)
+      : base_type_holder(info),
+        timer_(util::bind(&histogram_statistics_counter::evaluate, this_()),
+            util::bind(&histogram_statistics_counter::on_terminate, this_()),
+            1000 * detail::get_interval(parameters), info.fullname_, true),
+        base_counter_name_(ensure_counter_prefix(base_counter_name)),
+        statistic_(statistic), quantile_(quantile),
+        samples_(&own_samples_),
+        min_boundary_(detail::get_parameter(parameters, 1, 0)),
+        max_boundary_(detail::get_parameter(parameters, 2, 1000000)),
+        num_buckets_(detail::get_parameter(parameters, 3, 20)),
+        half_life_(1e6 * double(detail::get_parameter(parameters, 1,
+            10 * detail::get_interval(parameters)))),
+        rate_(0), last_value_(0), last_time_(0),
+        has_rate_(false), has_last_value_(false)
+    {
+        if (detail::get_interval(parameters) <= 0) {
+            HPX_THROW_EXCEPTION(bad_parameter,
+                "histogram_statistics_counter::histogram_statistics_counter",
+                "base interval is specified to be zero");
+        }
+
+        counter_type expected_type = (statistic == statistic_histogram) ?
+            counter_histogram : counter_aggregating;
+        if (info.type_ != expected_type) {
+            HPX_THROW_EXCEPTION(bad_parameter,
+                "histogram_statistics_counter::histogram_statistics_counter",
+                "unexpected counter type specified");
+        }
+
+        if (statistic == statistic_histogram &&
+            (num_buckets_ <= 0 || max_boundary_ <= min_boundary_))
+        {
+            HPX_THROW_EXCEPTION(bad_parameter,
+                "histogram_statistics_counter::histogram_statistics_counter",
+                "invalid histogram parameters specified");
+        }
+
+        if (statistic == statistic_ewma_rate && half_life_ <= 0) {
+            HPX_THROW_EXCEPTION(bad_parameter,
+                "histogram_statistics_counter::histogram_statistics_counter",
+                "half-life is specified to be zero");
+        }
+
+        // use the samples recorded by instrumented code if the base counter
+        // refers to a sample source on this locality
+        error_code ec(lightweight);
+        counter_path_elements p;
+        get_counter_path_elements(base_counter_name_, p, ec);
+        if (!ec && p.parentinstancename_ == "locality" &&
+            p.parentinstanceindex_ == boost::int64_t(hpx::get_locality_id()))
+        {
+            std::string type_name;
+            get_counter_type_name(base_counter_name_, type_name, ec);
+            if (!ec)
+            {
+                util::sharded_histogram* samples =
+                    find_sample_source(type_name);
+                if (samples)
+                    samples_ = samples;
+            }
+        }
+
+        // make sure this counter starts collecting data
+        start();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void histogram_statistics_counter::get_counts(
+        std::vector<boost::uint64_t>& counts, bool reset)
+    {
+        samples_->get_counts(counts);
+
+        std::lock_guard<mutex_type> l(mtx_);
+        if (reset_counts_.empty())
+        {
+            if (reset)
+                reset_counts_ = counts;
+            return;
+        }
+
+        for (std::size_t i = 0; i != counts.size(); ++i)
+        {
+            boost::uint64_t count = counts[i];
+            counts[i] -= reset_counts_[i];
+            if (reset)
+                reset_counts_[i] = count;
+        }
+    }
+
+    hpx::performance_counters::counter_value
+        histogram_statistics_counter::get_counter_value(bool reset)
+    {
+        hpx::performance_counters::counter_value value;
+
+        if (statistic_ == statistic_ewma_rate)
+        {
+            // the rate is not affected by resetting the counter
+            std::lock_guard<mutex_type> l(mtx_);
+            value.value_ = static_cast<boost::int64_t>(rate_);
+            value.status_ = has_rate_ ? status_new_data : status_invalid_data;
+        }
+        else if (statistic_ == statistic_percentile)
+        {
+            std::vector<boost::uint64_t> counts;
+            get_counts(counts, reset);
+
+            boost::uint64_t result =
+                util::sharded_histogram::value_at_quantile(counts, quantile_);
+            boost::uint64_t const max_value =
+                (std::numeric_limits<boost::int64_t>::max)();
+
+            bool has_samples = false;
+            for (boost::uint64_t c : counts)
+                has_samples = has_samples || c != 0;
+
+            value.value_ = static_cast<boost::int64_t>(
+                result < max_value ? result : max_value);
+            value.status_ = has_samples ? status_new_data : status_invalid_data;
+        }
+        else
+        {
+            HPX_THROW_EXCEPTION(invalid_status,
+                "histogram_statistics_counter::get_counter_value",
+                "histogram counters expose their values as an array");
+            return value;
+        }
+
+        value.time_ = static_cast<boost::int64_t>(hpx::get_system_uptime());
+        value.count_ = ++invocation_count_;
+        return value;
+    }
+
+    // The returned histogram holds the lower and upper boundary and the
+    // number of buckets followed by the fraction (in 1/1000) of the samples
+    // in each bucket, including one for the underflow and one for the
+    // overflow bucket. A sample is assigned to the bucket containing the
+    // middle of its (logarithmically sized) bucket.
+    hpx::performance_counters::counter_values_array
+        histogram_statistics_counter::get_counter_values_array(bool reset)
+    {
+        std::vector<boost::uint64_t> counts;
+        get_counts(counts, reset);
+
+        std::vector<boost::uint64_t> buckets(
+            static_cast<std::size_t>(num_buckets_) + 2, 0);
+        double const width =
+            double(max_boundary_ - min_boundary_) / double(num_buckets_);
+
+        boost::uint64_t total = 0;
+        for (std::size_t i = 0; i != counts.size(); ++i)
+        {
+            if (counts[i] == 0)
+                continue;
+
+            boost::uint64_t lower =
+                util::sharded_histogram::bucket_lower_bound(i);
+            double middle = double(lower) + double(
+                util::sharded_histogram::bucket_upper_bound(i) - lower) / 2;
+
+            std::size_t bucket = 0;
+            if (middle >= double(max_boundary_))
+            {
+                bucket = buckets.size() - 1;
+            }
+            else if (middle >= double(min_boundary_))
+            {
+                bucket = 1 + static_cast<std::size_t>(
+                    (middle - double(min_boundary_)) / width);
+            }
+
+            buckets[bucket] += counts[i];
+            total += counts[i];
+        }
+
+        hpx::performance_counters::counter_values_array values;
+        values.values_.reserve(buckets.size() + 3);
+        values.values_.push_back(min_boundary_);
+        values.values_.push_back(max_boundary_);
+        values.values_.push_back(num_buckets_);
+        for (boost::uint64_t b : buckets)
+        {
+            values.values_.push_back(total == 0 ? 0 :
+                static_cast<boost::int64_t>((1000 * b) / total));
+        }
+
+        values.scaling_ = 1;
+        values.scale_inverse_ = false;
+        values.status_ = status_new_data;
+        values.time_ = static_cast<boost::int64_t>(hpx::get_system_uptime());
+        values.count_ = ++invocation_count_;
+        return values;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void histogram_statistics_counter::update_rate(boost::int64_t value,
+        boost::int64_t now)
+    {
+        std::lock_guard<mutex_type> l(mtx_);
+
+        if (has_last_value_ && now > last_time_)
+        {
+            double elapsed = double(now - last_time_);
+            double rate = 1e9 * double(value - last_value_) / elapsed;
+
+            if (has_rate_)
+            {
+                double alpha =
+                    1.0 - std::exp(-elapsed * std::log(2.0) / half_life_);
+                rate_ += alpha * (rate - rate_);
+            }
+            else
+            {
+                rate_ = rate;
+                has_rate_ = true;
+            }
+        }
+
+        last_value_ = value;
+        last_time_ = now;
+        has_last_value_ = true;
+    }
+
+    void histogram_statistics_counter::add_value(
+        counter_value const& base_value)
+    {
+        if (statistic_ == statistic_ewma_rate)
+        {
+            // the rate of a sample source is the number of recorded samples
+            // per second
+            boost::int64_t value = base_value.value_;
+            if (samples_ != &own_samples_)
+                value = static_cast<boost::int64_t>(samples_->get_count());
+
+            update_rate(value, static_cast<boost::int64_t>(
+                util::high_resolution_clock::now()));
+        }
+        else if (samples_ == &own_samples_)
+        {
+            // negative values are accounted for as zero
+            own_samples_.record(base_value.value_ > 0 ?
+                static_cast<boost::uint64_t>(base_value.value_) : 0, 0);
+        }
+    }
+
+    bool histogram_statistics_counter::evaluate()
+    {
+        // gather current base value
+        counter_value base_value;
+        if (!evaluate_base_counter(base_value))
+            return false;
+
+        add_value(base_value);
+        return true;
+    }
+
+    bool histogram_statistics_counter::ensure_base_counter()
+    {
+        // lock here to avoid checking out multiple reference counted GIDs
+        // from AGAS
+        std::unique_lock<mutex_type> l(mtx_);
+
+        if (!base_counter_id_) {
+            // get or create the base counter
+            error_code ec(lightweight);
+            hpx::id_type base_counter_id;
+            {
+                // We need to unlock the lock here since get_counter might
+                // suspend
+                util::unlock_guard<std::unique_lock<mutex_type> > unlock(l);
+                base_counter_id = get_counter(base_counter_name_, ec);
+            }
+
+            // After reacquiring the lock, we need to check again if
+            // base_counter_id_ hasn't been set yet
+            if (!base_counter_id_)
+            {
+                base_counter_id_ = base_counter_id;
+            }
+            else
+            {
+                // If it was set already by a different thread, return true.
+                return true;
+            }
+
+            if (HPX_UNLIKELY(ec || !base_counter_id_))
+            {
+                // base counter could not be retrieved
+                HPX_THROW_EXCEPTION(bad_parameter,
+                    "histogram_statistics_counter::evaluate_base_counter",
+                    boost::str(boost::format(
+                        "could not get or create performance counter: '%s'") %
+                            base_counter_name_)
+                    );
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool histogram_statistics_counter::evaluate_base_counter(
+        counter_value& value)
+    {
+        // query the actual value
+        if (!base_counter_id_ && !ensure_base_counter())
+            return false;
+
+        value = stubs::performance_counter::get_value(base_counter_id_);
+        return true;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Start and stop this counter. We dispatch the calls to the base counter
+    // and control our own interval_timer, which is not needed if the samples
+    // are recorded by a sample source.
+    bool histogram_statistics_counter::start()
+    {
+        if (!timer_.is_started()) {
+            // start base counter
+            if (!base_counter_id_ && !ensure_base_counter())
+                return false;
+
+            bool result = stubs::performance_counter::start(base_counter_id_);
+            if (!is_polling())
+                return result;
+
+            if (result) {
+                // acquire the current value of the base counter
+                counter_value base_value;
+                if (evaluate_base_counter(base_value))
+                    add_value(base_value);
+
+                // start timer
+                timer_.start();
+            }
+            else {
+                // start timer even if base counter does not support being
+                // start/stop operations
+                timer_.start(true);
+            }
+            return result;
+        }
+        return false;
+    }
+
+    bool histogram_statistics_counter::stop()
+    {
+        if (!base_counter_id_ && !ensure_base_counter())
+            return false;
+
+        timer_.stop();
+        return stubs::performance_counter::stop(base_counter_id_);
+    }
+
+    void histogram_statistics_counter::reset_counter_value()
+    {
+        std::vector<boost::uint64_t> counts;
+        get_counts(counts, true);
+    }
+}}}
@@ -540,6 +540,7 @@ namespace hpx { namespace performance_counters { namespace detail
     {
         switch (info.type_) {
         case counter_aggregating:
+        case counter_histogram:
             {
                 counter_path_elements paths;
                 get_counter_path_elements(info.fullname_, paths, ec);
@@ -572,8 +573,9 @@ namespace hpx { namespace performance_counters { namespace detail
                     }
                 }
                 else {
+                    // the remaining parameters have counter specific
+                    // defaults
                     parameters.push_back(1000);       // sample interval
-                    parameters.push_back(10);         // rolling window
                 }
                 return create_statistics_counter(info, base_name, parameters, ec);
             }
@@ -718,6 +718,78 @@ namespace hpx
               ""
             },
 
+            // 50th percentile counter
+            { "/statistics/p50", performance_counters::counter_aggregating,
+              "returns the median (50th percentile) of the values of its "
+              "base counter; pass required base counter as the instance name: "
+              "/statistics{<base_counter_name>}/p50",
+              HPX_PERFORMANCE_COUNTER_V1,
+              &performance_counters::detail::statistics_counter_creator,
+              &performance_counters::default_counter_discoverer,
+              ""
+            },
+
+            // 90th percentile counter
+            { "/statistics/p90", performance_counters::counter_aggregating,
+              "returns the 90th percentile of the values of its base counter; "
+              "pass required base counter as the instance name: "
+              "/statistics{<base_counter_name>}/p90",
+              HPX_PERFORMANCE_COUNTER_V1,
+              &performance_counters::detail::statistics_counter_creator,
+              &performance_counters::default_counter_discoverer,
+              ""
+            },
+
+            // 99th percentile counter
+            { "/statistics/p99", performance_counters::counter_aggregating,
+              "returns the 99th percentile of the values of its base counter; "
+              "pass required base counter as the instance name: "
+              "/statistics{<base_counter_name>}/p99",
+              HPX_PERFORMANCE_COUNTER_V1,
+              &performance_counters::detail::statistics_counter_creator,
+              &performance_counters::default_counter_discoverer,
+              ""
+            },
+
+            // 99.9th percentile counter
+            { "/statistics/p999", performance_counters::counter_aggregating,
+              "returns the 99.9th percentile of the values of its base "
+              "counter; "
+              "pass required base counter as the instance name: "
+              "/statistics{<base_counter_name>}/p999",
+              HPX_PERFORMANCE_COUNTER_V1,
+              &performance_counters::detail::statistics_counter_creator,
+              &performance_counters::default_counter_discoverer,
+              ""
+            },
+
+            // histogram counter
+            { "/statistics/histogram", performance_counters::counter_histogram,
+              "returns a histogram of the values of its base counter; pass "
+              "required base counter as the instance name and the base time "
+              "interval, the lower and upper boundary, and the number of "
+              "buckets as parameters: "
+              "/statistics{<base_counter_name>}/histogram@<interval>,<min>,"
+              "<max>,<buckets>",
+              HPX_PERFORMANCE_COUNTER_V1,
+              &performance_counters::detail::statistics_counter_creator,
+              &performance_counters::default_counter_discoverer,
+              ""
+            },
+
+            // exponentially weighted rate counter
+            { "/statistics/ewma_rate", performance_counters::counter_aggregating,
+              "returns the exponentially weighted rate of change (per second) "
+              "of its base counter; pass required base counter as the "
+              "instance name and the base time interval and the half-life "
+              "as parameters: "
+              "/statistics{<base_counter_name>}/ewma_rate@<interval>,<half-life>",
+              HPX_PERFORMANCE_COUNTER_V1,
+              &performance_counters::detail::statistics_counter_creator,
+              &performance_counters::default_counter_discoverer,
+              ""
+            },
+
             // uptime counters
             { "/runtime/uptime", performance_counters::counter_elapsed_time,
               "returns the up time of the runtime instance for the referenced "
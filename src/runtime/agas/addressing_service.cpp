@@ -40,11 +40,12 @@
 #include <hpx/performance_counters/counter_creators.hpp>
 #include <hpx/performance_counters/manage_counter_type.hpp>
 #include <hpx/lcos/wait_all.hpp>
+#include <hpx/lcos/when_all.hpp>
 #include <hpx/lcos/broadcast.hpp>
 
 #include <boost/format.hpp>
-#include <boost/icl/closed_interval.hpp>
 
+#include <cstddef>
 #include <cstdint>
 #include <map>
 #include <memory>
@@ -55,76 +56,12 @@
 
 namespace hpx { namespace agas
 {
-struct addressing_service::gva_cache_key
-{ // {{{ gva_cache_key implementation
-  private:
-    typedef boost::icl::closed_interval<naming::gid_type, std::less>
-        key_type;
-
-    key_type key_;
-
-  public:
-    gva_cache_key()
-      : key_()
-    {}
-
-    explicit gva_cache_key(
-        naming::gid_type const& id_
-      , boost::uint64_t count_ = 1
-        )
-      : key_(naming::detail::get_stripped_gid(id_)
-           , naming::detail::get_stripped_gid(id_) + (count_ - 1))
-    {
-        HPX_ASSERT(count_);
-    }
-
-    naming::gid_type get_gid() const
-    {
-        return boost::icl::lower(key_);
-    }
-
-    boost::uint64_t get_count() const
-    {
-        naming::gid_type const size = boost::icl::length(key_);
-        HPX_ASSERT(size.get_msb() == 0);
-        return size.get_lsb();
-    }
-
-    friend bool operator<(
-        gva_cache_key const& lhs
-      , gva_cache_key const& rhs
-        )
-    {
-        return boost::icl::exclusive_less(lhs.key_, rhs.key_);
-    }
-
-    friend bool operator==(
-        gva_cache_key const& lhs
-      , gva_cache_key const& rhs
-        )
-    {
-        // Direct hit
-        if(lhs.key_ == rhs.key_)
-            return true;
-
-        // Is lhs in rhs?
-        if (1 == lhs.get_count() && 1 != rhs.get_count())
-            return boost::icl::contains(rhs.key_, lhs.key_);
-
-        // Is rhs in lhs?
-        else if (1 != lhs.get_count() && 1 == rhs.get_count())
-            return boost::icl::contains(lhs.key_, rhs.key_);
-
-        return false;
-    }
-}; // }}}
-
 addressing_service::addressing_service(
     parcelset::parcelhandler& ph
   , util::runtime_configuration const& ini_
   , runtime_mode runtime_type_
     )
-  : gva_cache_(new gva_cache_type)
+  : gva_cache_(new gva_cache_type(2 * ini_.get_os_thread_count()))
   , console_cache_(naming::invalid_locality_id)
   , max_refcnt_requests_(ini_.get_agas_max_pending_refcnt_requests())
   , refcnt_requests_count_(0)
@@ -1435,10 +1372,16 @@ hpx::future<naming::id_type> addressing_service::get_colocation_id_async(
 naming::address addressing_service::resolve_full_postproc(
     future<response> f, naming::gid_type const& id
     )
+{
+    return resolve_full_response(f.get(), id);
+}
+
+naming::address addressing_service::resolve_full_response(
+    response const& rep, naming::gid_type const& id
+    )
 {
     naming::address addr;
 
-    response rep = f.get();
     if (success != rep.get_status())
     {
         HPX_THROW_EXCEPTION(bad_parameter,
@@ -1502,6 +1445,106 @@ hpx::future<naming::address> addressing_service::resolve_full_async(
         ));
 }
 
+///////////////////////////////////////////////////////////////////////////////
+hpx::future<std::vector<naming::address> > addressing_service::resolve_async(
+    std::vector<naming::gid_type> const& gids
+    )
+{
+    std::vector<naming::address> addrs(gids.size());
+
+    // The ids which are not in the cache are grouped by the primary
+    // namespace instance responsible for them, every instance receives one
+    // request only.
+    std::map<naming::gid_type, std::vector<std::size_t> > groups;
+    for (std::size_t i = 0; i != gids.size(); ++i)
+    {
+        if (!gids[i])
+        {
+            HPX_THROW_EXCEPTION(bad_parameter,
+                "addressing_service::resolve_async",
+                "invalid reference id");
+            return make_ready_future(std::vector<naming::address>());
+        }
+
+        if (caching_)
+        {
+            error_code ec;
+            if (resolve_cached(gids[i], addrs[i], ec))
+                continue;
+
+            if (ec)
+            {
+                return hpx::make_exceptional_future<
+                        std::vector<naming::address>
+                    >(hpx::detail::access_exception(ec));
+            }
+        }
+
+        groups[stubs::primary_namespace::get_service_instance(gids[i])]
+            .push_back(i);
+    }
+
+    if (groups.empty())
+        return make_ready_future(std::move(addrs));
+
+    std::vector<future<std::vector<response> > > responses;
+    responses.reserve(groups.size());
+    std::vector<std::vector<std::size_t> > indices;
+    indices.reserve(groups.size());
+
+    typedef std::map<naming::gid_type, std::vector<std::size_t> >::value_type
+        group_type;
+    for (group_type& group : groups)
+    {
+        std::vector<request> reqs;
+        reqs.reserve(group.second.size());
+        for (std::size_t i : group.second)
+            reqs.push_back(request(primary_ns_resolve_gid, gids[i]));
+
+        naming::id_type target(group.first, naming::id_type::unmanaged);
+        responses.push_back(stubs::primary_namespace::bulk_service_async(
+            target, std::move(reqs)));
+        indices.push_back(std::move(group.second));
+    }
+
+    using util::placeholders::_1;
+    return when_all(responses).then(util::bind(
+            util::one_shot(&addressing_service::resolve_bulk_postproc),
+            this, _1, gids, std::move(addrs), std::move(indices)
+        ));
+}
+
+std::vector<naming::address> addressing_service::resolve_bulk_postproc(
+    future<std::vector<future<std::vector<response> > > > f
+  , std::vector<naming::gid_type> const& gids
+  , std::vector<naming::address> addrs
+  , std::vector<std::vector<std::size_t> > const& indices
+    )
+{
+    std::vector<future<std::vector<response> > > responses = f.get();
+
+    HPX_ASSERT(responses.size() == indices.size());
+    for (std::size_t j = 0; j != responses.size(); ++j)
+    {
+        std::vector<response> reps = responses[j].get();
+        if (reps.size() != indices[j].size())
+        {
+            HPX_THROW_EXCEPTION(bad_parameter,
+                "addressing_service::resolve_bulk_postproc",
+                "could no resolve global id");
+            return addrs;
+        }
+
+        for (std::size_t k = 0; k != reps.size(); ++k)
+        {
+            std::size_t const i = indices[j][k];
+            addrs[i] = resolve_full_response(reps[k], gids[i]);
+        }
+    }
+
+    return addrs;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 bool addressing_service::resolve_full_local(
     naming::gid_type const* gids
@@ -1738,37 +1781,17 @@ boost::int64_t addressing_service::synchronize_with_async_incref(
     return fut.get() + compensated_credit;
 }
 
-lcos::future<boost::int64_t> addressing_service::incref_async(
-    naming::gid_type const& id
+///////////////////////////////////////////////////////////////////////////////
+// Offset the given incref against a pending decref of the same id. Returns
+// whether (and which) incref still has to be sent to AGAS, 'pending_decrefs'
+// receives the amount of credits to be added to the acknowledged credits.
+bool addressing_service::compensate_pending_decrefs(
+    naming::gid_type const& raw
   , boost::int64_t credit
-  , naming::id_type const& keep_alive
+  , std::pair<naming::gid_type, boost::int64_t>& pending_incref
+  , boost::int64_t& pending_decrefs
     )
-{ // {{{ incref implementation
-    naming::gid_type raw(naming::detail::get_stripped_gid(id));
-
-    if (HPX_UNLIKELY(nullptr == threads::get_self_ptr()))
-    {
-        // reschedule this call as an HPX thread
-        lcos::future<boost::int64_t> (
-                addressing_service::*incref_async_ptr)(
-            naming::gid_type const&
-          , boost::int64_t
-          , naming::id_type const&
-        ) = &addressing_service::incref_async;
-
-        return async(incref_async_ptr, this, raw, credit, keep_alive);
-    }
-
-    if (HPX_UNLIKELY(0 >= credit))
-    {
-        HPX_THROW_EXCEPTION(bad_parameter
-          , "addressing_service::incref_async"
-          , boost::str(boost::format("invalid credit count of %1%") % credit));
-        return lcos::future<boost::int64_t>();
-    }
-
-    HPX_ASSERT(keep_alive != naming::invalid_id);
-
+{
     typedef refcnt_requests_type::value_type mapping;
 
     // Some examples of calculating the compensated credits below
@@ -1781,9 +1804,8 @@ lcos::future<boost::int64_t> addressing_service::incref_async(
     //   3        10        10        0           0        10
     //   4        10        11        0           1        10
 
-    std::pair<naming::gid_type, boost::int64_t> pending_incref;
     bool has_pending_incref = false;
-    boost::int64_t pending_decrefs = 0;
+    pending_decrefs = 0;
 
     {
         std::lock_guard<mutex_type> l(refcnt_requests_mtx_);
@@ -1829,6 +1851,46 @@ lcos::future<boost::int64_t> addressing_service::incref_async(
         }
     }
 
+    return has_pending_incref;
+}
+
+lcos::future<boost::int64_t> addressing_service::incref_async(
+    naming::gid_type const& id
+  , boost::int64_t credit
+  , naming::id_type const& keep_alive
+    )
+{ // {{{ incref implementation
+    naming::gid_type raw(naming::detail::get_stripped_gid(id));
+
+    if (HPX_UNLIKELY(nullptr == threads::get_self_ptr()))
+    {
+        // reschedule this call as an HPX thread
+        lcos::future<boost::int64_t> (
+                addressing_service::*incref_async_ptr)(
+            naming::gid_type const&
+          , boost::int64_t
+          , naming::id_type const&
+        ) = &addressing_service::incref_async;
+
+        return async(incref_async_ptr, this, raw, credit, keep_alive);
+    }
+
+    if (HPX_UNLIKELY(0 >= credit))
+    {
+        HPX_THROW_EXCEPTION(bad_parameter
+          , "addressing_service::incref_async"
+          , boost::str(boost::format("invalid credit count of %1%") % credit));
+        return lcos::future<boost::int64_t>();
+    }
+
+    HPX_ASSERT(keep_alive != naming::invalid_id);
+
+    std::pair<naming::gid_type, boost::int64_t> pending_incref;
+    boost::int64_t pending_decrefs = 0;
+
+    bool has_pending_incref = compensate_pending_decrefs(
+        raw, credit, pending_incref, pending_decrefs);
+
     if (!has_pending_incref)
     {
         // no need to talk to AGAS, acknowledge the incref immediately
@@ -1853,6 +1915,119 @@ lcos::future<boost::int64_t> addressing_service::incref_async(
         ));
 } // }}}
 
+///////////////////////////////////////////////////////////////////////////////
+lcos::future<std::vector<boost::int64_t> > addressing_service::incref_async(
+    std::vector<std::pair<naming::gid_type, boost::int64_t> > const& increfs
+    )
+{ // {{{ bulk incref implementation
+    if (HPX_UNLIKELY(nullptr == threads::get_self_ptr()))
+    {
+        // reschedule this call as an HPX thread
+        lcos::future<std::vector<boost::int64_t> > (
+                addressing_service::*incref_async_ptr)(
+            std::vector<std::pair<naming::gid_type, boost::int64_t> > const&
+        ) = &addressing_service::incref_async;
+
+        return async(incref_async_ptr, this, increfs);
+    }
+
+    std::vector<boost::int64_t> credits(increfs.size(), 0);
+
+    // The remaining increfs are grouped by the primary namespace instance
+    // responsible for them, every instance receives one request only.
+    std::map<naming::gid_type, std::vector<std::size_t> > groups;
+    std::map<naming::gid_type, std::vector<request> > requests;
+
+    for (std::size_t i = 0; i != increfs.size(); ++i)
+    {
+        boost::int64_t credit = increfs[i].second;
+        if (HPX_UNLIKELY(0 >= credit))
+        {
+            HPX_THROW_EXCEPTION(bad_parameter
+              , "addressing_service::incref_async"
+              , boost::str(boost::format("invalid credit count of %1%")
+                    % credit));
+            return lcos::future<std::vector<boost::int64_t> >();
+        }
+
+        naming::gid_type raw(
+            naming::detail::get_stripped_gid(increfs[i].first));
+
+        std::pair<naming::gid_type, boost::int64_t> pending_incref;
+        if (!compensate_pending_decrefs(
+                raw, credit, pending_incref, credits[i]))
+        {
+            continue;
+        }
+
+        naming::gid_type const e_lower = pending_incref.first;
+        naming::gid_type const service =
+            stubs::primary_namespace::get_service_instance(e_lower);
+
+        groups[service].push_back(i);
+        requests[service].push_back(request(primary_ns_increment_credit,
+            e_lower, e_lower, pending_incref.second));
+    }
+
+    if (groups.empty())
+    {
+        // no need to talk to AGAS, acknowledge the increfs immediately
+        return hpx::make_ready_future(std::move(credits));
+    }
+
+    std::vector<future<std::vector<response> > > responses;
+    responses.reserve(groups.size());
+    std::vector<std::vector<std::size_t> > indices;
+    indices.reserve(groups.size());
+
+    typedef std::map<naming::gid_type, std::vector<std::size_t> >::value_type
+        group_type;
+    for (group_type& group : groups)
+    {
+        naming::id_type target(group.first, naming::id_type::unmanaged);
+        responses.push_back(stubs::primary_namespace::bulk_service_async(
+            target, std::move(requests[group.first])));
+        indices.push_back(std::move(group.second));
+    }
+
+    // pass the amount of compensated decrefs to the callback
+    using util::placeholders::_1;
+    return when_all(responses).then(util::bind(
+            util::one_shot(&addressing_service::synchronize_with_bulk_incref),
+            this, _1, std::move(credits), std::move(indices)
+        ));
+} // }}}
+
+std::vector<boost::int64_t> addressing_service::synchronize_with_bulk_incref(
+    hpx::future<std::vector<hpx::future<std::vector<response> > > > fut
+  , std::vector<boost::int64_t> credits
+  , std::vector<std::vector<std::size_t> > const& indices
+    )
+{
+    std::vector<future<std::vector<response> > > responses = fut.get();
+
+    HPX_ASSERT(responses.size() == indices.size());
+    for (std::size_t j = 0; j != responses.size(); ++j)
+    {
+        std::vector<response> reps = responses[j].get();
+        HPX_ASSERT(reps.size() == indices[j].size());
+
+        for (std::size_t k = 0; k != reps.size(); ++k)
+        {
+            if (success != reps[k].get_status())
+            {
+                HPX_THROW_EXCEPTION(reps[k].get_status(),
+                    "addressing_service::synchronize_with_bulk_incref",
+                    "could not increment the credits of a global id");
+                return credits;
+            }
+            credits[indices[j][k]] += reps[k].get_added_credits();
+        }
+    }
+
+    return credits;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void addressing_service::decref(
     naming::gid_type const& gid
@@ -2143,17 +2318,6 @@ bool addressing_service::iterate_ids(
     }
 } // }}}
 
-// This function has to return false if the key is already in the cache (true
-// means go ahead with the cache update).
-bool check_for_collisions(
-    addressing_service::gva_cache_key const& new_key
-  , addressing_service::gva_cache_key const& old_key
-    )
-{
-    return (new_key.get_gid() != old_key.get_gid())
-        || (new_key.get_count() != old_key.get_count());
-}
-
 void addressing_service::update_cache_entry(
     naming::gid_type const& id
   , gva const& g
@@ -2216,34 +2380,19 @@ void addressing_service::update_cache_entry(
             "addressing_service::update_cache_entry, gid(%1%), count(%2%)"
             ) % gid % count);
 
-        const gva_cache_key key(gid, count);
-
+        naming::gid_type old_gid;
+        boost::uint64_t old_count = 0;
+        if (!gva_cache_->update_if(gid, count, g, old_gid, old_count))
         {
-            std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-            if (!gva_cache_->update_if(key, g, check_for_collisions))
+            if (LAGAS_ENABLED(warning))
             {
-                if (LAGAS_ENABLED(warning))
-                {
-                    // Figure out who we collided with.
-                    addressing_service::gva_cache_key idbase;
-                    addressing_service::gva_cache_type::entry_type e;
-
-                    if (!gva_cache_->get_entry(key, idbase, e))
-                    {
-                        // This is impossible under sane conditions.
-                        HPX_THROWS_IF(ec, invalid_data
-                          , "addressing_service::update_cache_entry"
-                          , "data corruption or lock error occurred in cache");
-                        return;
-                    }
-
-                    LAGAS_(warning) <<
-                        ( boost::format(
-                            "addressing_service::update_cache_entry, "
-                            "aborting update due to key collision in cache, "
-                            "new_gid(%1%), new_count(%2%), old_gid(%3%), old_count(%4%)"
-                        ) % gid % count % idbase.get_gid() % idbase.get_count());
-                }
+                LAGAS_(warning) <<
+                    ( boost::format(
+                        "addressing_service::update_cache_entry, "
+                        "aborting update due to key collision in cache, "
+                        "new_gid(%1%), new_count(%2%), old_gid(%3%), "
+                        "old_count(%4%)"
+                    ) % gid % count % old_gid % old_count);
             }
         }
 
@@ -2268,24 +2417,20 @@ bool addressing_service::get_cache_entry(
         return false;
     }
     HPX_ASSERT(hpx::threads::get_self_ptr());
-    gva_cache_key k(gid);
-    gva_cache_key idbase_key;
-
-    std::unique_lock<mutex_type> lock(gva_cache_mtx_);
-    if(gva_cache_->get_entry(k, idbase_key, gva))
+    naming::gid_type idbase_gid;
+    if(gva_cache_->get_entry(gid, idbase_gid, gva))
     {
         const boost::uint64_t id_msb =
             naming::detail::strip_internal_bits_from_gid(gid.get_msb());
 
-        if (HPX_UNLIKELY(id_msb != idbase_key.get_gid().get_msb()))
+        if (HPX_UNLIKELY(id_msb != idbase_gid.get_msb()))
         {
-            lock.unlock();
             HPX_THROWS_IF(ec, internal_server_error
               , "addressing_service::get_cache_entry"
               , "bad entry in cache, MSBs of GID base and GID do not match");
             return false;
         }
-        idbase = idbase_key.get_gid();
+        idbase = idbase_gid;
         return true;
     }
 
@@ -2308,8 +2453,6 @@ void addressing_service::clear_cache(
     try {
         LAGAS_(warning) << "addressing_service::clear_cache, clearing cache";
 
-        std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-
         gva_cache_->clear();
 
         if (&ec != &throws)
@@ -2355,13 +2498,7 @@ void addressing_service::remove_cache_entry(
     try {
         LAGAS_(warning) << "addressing_service::remove_cache_entry";
 
-        std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-
-        gva_cache_->erase(
-            [&gid](std::pair<gva_cache_key, gva> const& p)
-            {
-                return gid == p.first.get_gid();
-            });
+        gva_cache_->erase(gid);
 
         if (&ec != &throws)
             ec = make_success_code();
@@ -2536,81 +2673,68 @@ bool addressing_service::retrieve_statistics_counter(
 // Helper functions to access the current cache statistics
 boost::uint64_t addressing_service::get_cache_entries(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
     return gva_cache_->size();
 }
 
 boost::uint64_t addressing_service::get_cache_hits(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().hits(reset);
+    return gva_cache_->hits(reset);
 }
 
 boost::uint64_t addressing_service::get_cache_misses(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().misses(reset);
+    return gva_cache_->misses(reset);
 }
 
 boost::uint64_t addressing_service::get_cache_evictions(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().evictions(reset);
+    return gva_cache_->evictions(reset);
 }
 
 boost::uint64_t addressing_service::get_cache_insertions(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().insertions(reset);
+    return gva_cache_->insertions(reset);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 boost::uint64_t addressing_service::get_cache_get_entry_count(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().get_get_entry_count(reset);
+    return gva_cache_->get_get_entry_count(reset);
 }
 
 boost::uint64_t addressing_service::get_cache_insertion_entry_count(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().get_insert_entry_count(reset);
+    return gva_cache_->get_insert_entry_count(reset);
 }
 
 boost::uint64_t addressing_service::get_cache_update_entry_count(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().get_update_entry_count(reset);
+    return gva_cache_->get_update_entry_count(reset);
 }
 
 boost::uint64_t addressing_service::get_cache_erase_entry_count(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().get_erase_entry_count(reset);
+    return gva_cache_->get_erase_entry_count(reset);
 }
 
 boost::uint64_t addressing_service::get_cache_get_entry_time(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().get_get_entry_time(reset);
+    return gva_cache_->get_get_entry_time(reset);
 }
 
 boost::uint64_t addressing_service::get_cache_insertion_entry_time(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().get_insert_entry_time(reset);
+    return gva_cache_->get_insert_entry_time(reset);
 }
 
 boost::uint64_t addressing_service::get_cache_update_entry_time(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().get_update_entry_time(reset);
+    return gva_cache_->get_update_entry_time(reset);
 }
 
 boost::uint64_t addressing_service::get_cache_erase_entry_time(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().get_erase_entry_time(reset);
+    return gva_cache_->get_erase_entry_time(reset);
 }
 
 /// Install performance counter types exposing properties from the local cache.
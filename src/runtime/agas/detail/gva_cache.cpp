@@ -0,0 +1,1121 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/agas/detail/gva_cache.hpp>
+#include <hpx/runtime/agas/gva.hpp>
+#include <hpx/runtime/naming/name.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/cache/lru_cache.hpp>
+#include <hpx/util/cache/statistics/local_full_statistics.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/icl/closed_interval.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace agas { namespace detail
+{
+    namespace
+    {
+        // number of entries per set
+        std::size_t const cache_ways = 8;
+
+        // number of consecutive ids mapped onto the same set on the lowest
+        // level (log2)
+        std::size_t const cache_block_bits = 4;
+
+        // factor the block size grows by from one level to the next (log2)
+        std::size_t const cache_level_bits = 2;
+
+        // number of levels needed to cover the lsb of a global id
+        std::size_t const cache_levels =
+            (64 - cache_block_bits + cache_level_bits - 1) / cache_level_bits;
+
+        // maximal number of blocks a range may cover on its level
+        std::size_t const max_range_blocks = 4;
+
+        // words of one slot
+        enum slot_word
+        {
+            word_key_msb = 0,
+            word_key_lsb = 1,
+            word_key_count = 2,     // zero for empty slots
+            word_prefix_msb = 3,
+            word_prefix_lsb = 4,
+            word_type = 5,
+            word_count = 6,
+            word_lva = 7,
+            word_offset = 8,
+            word_level = 9,
+            word_block = 10,        // block this copy of the entry belongs to
+            num_slot_words = 11
+        };
+
+        typedef boost::uint64_t slot_data[num_slot_words];
+
+        inline std::size_t get_shift(std::size_t level)
+        {
+            return cache_block_bits + level * cache_level_bits;
+        }
+
+        // lowest level on which the given range covers not more than
+        // max_range_blocks blocks
+        inline std::size_t get_level(boost::uint64_t lsb,
+            boost::uint64_t last_lsb)
+        {
+            std::size_t level = 0;
+            while (level != cache_levels - 1 &&
+                (last_lsb >> get_shift(level)) - (lsb >> get_shift(level)) >=
+                    max_range_blocks)
+            {
+                ++level;
+            }
+            return level;
+        }
+
+        inline boost::uint64_t mix(boost::uint64_t h)
+        {
+            h ^= h >> 33;
+            h *= 0xff51afd7ed558ccdull;
+            h ^= h >> 33;
+            return h;
+        }
+
+        inline boost::uint64_t hash_block(boost::uint64_t msb,
+            boost::uint64_t block, std::size_t level)
+        {
+            return mix((msb * 0x9e3779b97f4a7c15ull) ^ block ^
+                (boost::uint64_t(level) * 0xc2b2ae3d27d4eb4full));
+        }
+
+        inline boost::uint64_t now()
+        {
+            std::chrono::nanoseconds ns =
+                std::chrono::steady_clock::now().time_since_epoch();
+            return static_cast<boost::uint64_t>(ns.count());
+        }
+
+        inline void make_slot_data(slot_data& data, naming::gid_type const& id,
+            boost::uint64_t count, gva const& g, std::size_t level,
+            boost::uint64_t block)
+        {
+            data[word_key_msb] = id.get_msb();
+            data[word_key_lsb] = id.get_lsb();
+            data[word_key_count] = count;
+            data[word_prefix_msb] = g.prefix.get_msb();
+            data[word_prefix_lsb] = g.prefix.get_lsb();
+            data[word_type] = static_cast<boost::uint32_t>(g.type);
+            data[word_count] = g.count;
+            data[word_lva] = g.lva();
+            data[word_offset] = g.offset;
+            data[word_level] = level;
+            data[word_block] = block;
+        }
+
+        inline gva get_gva(slot_data const& data)
+        {
+            return gva(
+                naming::gid_type(data[word_prefix_msb], data[word_prefix_lsb]),
+                static_cast<gva::component_type>(
+                    static_cast<boost::uint32_t>(data[word_type])),
+                data[word_count], gva::lva_type(data[word_lva]),
+                data[word_offset]);
+        }
+
+        // The copy stored for the first block of a range represents the
+        // entry, all other copies are not accounted for in the size of the
+        // cache.
+        inline bool is_primary(slot_data const& data)
+        {
+            return data[word_key_count] != 0 &&
+                data[word_block] == (data[word_key_lsb] >>
+                    get_shift(std::size_t(data[word_level])));
+        }
+
+        // Mirrors the comparison semantics of the ranges used as keys in the
+        // overflow cache.
+        inline bool matches(slot_data const& data, boost::uint64_t msb,
+            boost::uint64_t lsb, boost::uint64_t count)
+        {
+            boost::uint64_t const kcount = data[word_key_count];
+            if (kcount == 0 || data[word_key_msb] != msb)
+                return false;
+
+            boost::uint64_t const klsb = data[word_key_lsb];
+            if (klsb == lsb && kcount == count)
+                return true;
+            if (count == 1 && kcount != 1)
+                return lsb - klsb < kcount;
+            if (count != 1 && kcount == 1)
+                return klsb - lsb < count;
+            return false;
+        }
+
+        // Mirrors the ordering of the overflow cache, which considers
+        // overlapping ranges to be the same key.
+        inline bool overlaps(slot_data const& data, boost::uint64_t msb,
+            boost::uint64_t lsb, boost::uint64_t last_lsb)
+        {
+            boost::uint64_t const kcount = data[word_key_count];
+            if (kcount == 0 || data[word_key_msb] != msb)
+                return false;
+
+            boost::uint64_t const klsb = data[word_key_lsb];
+            return klsb <= last_lsb && lsb <= klsb + (kcount - 1);
+        }
+
+        inline std::size_t get_reader_index()
+        {
+            return std::size_t(mix(boost::uint64_t(
+                std::hash<std::thread::id>()(std::this_thread::get_id()))));
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    struct gva_cache::slot
+    {
+        slot()
+          : seq_(0), referenced_(false)
+        {
+            for (std::size_t i = 0; i != num_slot_words; ++i)
+                data_[i].store(0, boost::memory_order_relaxed);
+        }
+
+        // readers never block, they retry if a writer interfered
+        void read(slot_data& data) const
+        {
+            while (true)
+            {
+                boost::uint64_t seq = seq_.load(boost::memory_order_acquire);
+                if (seq & 1)
+                    continue;           // writer in progress
+
+                for (std::size_t i = 0; i != num_slot_words; ++i)
+                    data[i] = data_[i].load(boost::memory_order_relaxed);
+
+                boost::atomic_thread_fence(boost::memory_order_acquire);
+                if (seq_.load(boost::memory_order_relaxed) == seq)
+                    return;
+            }
+        }
+
+        // writers are serialized by the lock of the shard
+        void write(slot_data const& data)
+        {
+            boost::uint64_t seq = seq_.load(boost::memory_order_relaxed);
+            seq_.store(seq + 1, boost::memory_order_relaxed);
+            boost::atomic_thread_fence(boost::memory_order_release);
+
+            for (std::size_t i = 0; i != num_slot_words; ++i)
+                data_[i].store(data[i], boost::memory_order_relaxed);
+
+            seq_.store(seq + 2, boost::memory_order_release);
+        }
+
+        bool empty() const
+        {
+            return data_[word_key_count].load(boost::memory_order_relaxed) == 0;
+        }
+
+        void touch()
+        {
+            if (!referenced_.load(boost::memory_order_relaxed))
+                referenced_.store(true, boost::memory_order_relaxed);
+        }
+
+        boost::atomic<boost::uint64_t> seq_;
+        boost::atomic<boost::uint64_t> data_[num_slot_words];
+        boost::atomic<bool> referenced_;
+    };
+
+    struct gva_cache::table
+    {
+        explicit table(std::size_t num_sets)
+          : num_sets_(num_sets),
+            slots_(new slot[num_sets * cache_ways]),
+            hands_(num_sets, 0)
+        {}
+
+        slot* get_set(boost::uint64_t hash) const
+        {
+            return &slots_[(hash % num_sets_) * cache_ways];
+        }
+
+        // CLOCK replacement, returns the slot to (re-)use in the given set
+        slot* get_victim(boost::uint64_t hash)
+        {
+            std::size_t set = hash % num_sets_;
+            slot* s = &slots_[set * cache_ways];
+
+            for (std::size_t i = 0; i != cache_ways; ++i)
+            {
+                if (s[i].empty())
+                    return &s[i];
+            }
+
+            std::size_t& hand = hands_[set];
+            while (true)
+            {
+                slot& candidate = s[hand];
+                hand = (hand + 1) % cache_ways;
+
+                if (!candidate.referenced_.load(boost::memory_order_relaxed))
+                    return &candidate;
+                candidate.referenced_.store(false, boost::memory_order_relaxed);
+            }
+        }
+
+        std::size_t num_sets_;
+        std::unique_ptr<slot[]> slots_;
+        std::vector<std::size_t> hands_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    struct gva_cache::statistics
+    {
+        struct api_counter_data
+        {
+            api_counter_data()
+              : count_(0), time_(0)
+            {}
+
+            boost::atomic<boost::int64_t> count_;
+            boost::atomic<boost::int64_t> time_;
+        };
+
+        statistics()
+          : hits_(0), misses_(0), insertions_(0), evictions_(0)
+        {}
+
+        boost::atomic<boost::int64_t> hits_;
+        boost::atomic<boost::int64_t> misses_;
+        boost::atomic<boost::int64_t> insertions_;
+        boost::atomic<boost::int64_t> evictions_;
+
+        api_counter_data get_entry_;
+        api_counter_data insert_entry_;
+        api_counter_data update_entry_;
+        api_counter_data erase_entry_;
+    };
+
+    struct gva_cache::update_on_exit
+    {
+        explicit update_on_exit(statistics::api_counter_data& data)
+          : started_at_(now()), data_(data)
+        {}
+
+        ~update_on_exit()
+        {
+            data_.time_.fetch_add(boost::int64_t(now() - started_at_),
+                boost::memory_order_relaxed);
+            data_.count_.fetch_add(1, boost::memory_order_relaxed);
+        }
+
+        boost::uint64_t started_at_;
+        statistics::api_counter_data& data_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    struct gva_cache::shard
+    {
+        shard()
+          : table_(nullptr)
+        {}
+
+        ~shard()
+        {
+            delete table_.load();
+        }
+
+        // pad to avoid false sharing between the shards
+        char pad0_[64];
+
+        mutable mutex_type mtx_;
+        boost::atomic<table*> table_;
+
+        statistics statistics_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Every lookup increments one of two counters of the slot selected by
+    // the calling thread while it accesses the tables, the low bit of the
+    // epoch selects the counter.
+    struct gva_cache::reader_slot
+    {
+        reader_slot()
+        {
+            active_[0].store(0, boost::memory_order_relaxed);
+            active_[1].store(0, boost::memory_order_relaxed);
+        }
+
+        boost::atomic<boost::int64_t> active_[2];
+
+        // pad to avoid false sharing between the reader slots
+        char pad0_[64 - 2 * sizeof(boost::atomic<boost::int64_t>)];
+    };
+
+    struct gva_cache::read_guard
+    {
+        explicit read_guard(gva_cache const& cache)
+          : active_(cache.enter_read())
+        {}
+
+        ~read_guard()
+        {
+            active_.fetch_sub(1, boost::memory_order_release);
+        }
+
+        boost::atomic<boost::int64_t>& active_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // ranges wrapping around the lsb are held in a conventional cache
+    struct gva_cache::overflow_cache
+    {
+        struct key
+        { // {{{ key implementation
+          private:
+            typedef boost::icl::closed_interval<naming::gid_type, std::less>
+                key_type;
+
+            key_type key_;
+
+          public:
+            key()
+              : key_()
+            {}
+
+            explicit key(naming::gid_type const& id_,
+                    boost::uint64_t count_ = 1)
+              : key_(naming::detail::get_stripped_gid(id_)
+                   , naming::detail::get_stripped_gid(id_) + (count_ - 1))
+            {
+                HPX_ASSERT(count_);
+            }
+
+            naming::gid_type get_gid() const
+            {
+                return boost::icl::lower(key_);
+            }
+
+            boost::uint64_t get_count() const
+            {
+                naming::gid_type const size = boost::icl::length(key_);
+                HPX_ASSERT(size.get_msb() == 0);
+                return size.get_lsb();
+            }
+
+            friend bool operator<(key const& lhs, key const& rhs)
+            {
+                return boost::icl::exclusive_less(lhs.key_, rhs.key_);
+            }
+
+            friend bool operator==(key const& lhs, key const& rhs)
+            {
+                // Direct hit
+                if(lhs.key_ == rhs.key_)
+                    return true;
+
+                // Is lhs in rhs?
+                if (1 == lhs.get_count() && 1 != rhs.get_count())
+                    return boost::icl::contains(rhs.key_, lhs.key_);
+
+                // Is rhs in lhs?
+                else if (1 != lhs.get_count() && 1 == rhs.get_count())
+                    return boost::icl::contains(lhs.key_, rhs.key_);
+
+                return false;
+            }
+        }; // }}}
+
+        typedef hpx::util::cache::lru_cache<key, gva> cache_type;
+
+        mutable mutex_type mtx_;
+        cache_type cache_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    gva_cache::gva_cache(size_type num_shards)
+      : num_shards_(1),
+        shard_bits_(0),
+        max_size_(0),
+        size_(0),
+        levels_(0),
+        epoch_(0),
+        num_readers_(0),
+        overflow_size_(0),
+        overflow_(new overflow_cache)
+    {
+        if (num_shards == 0)
+            num_shards = 2 * (std::max)(std::thread::hardware_concurrency(), 1u);
+
+        while (num_shards_ < num_shards)
+        {
+            num_shards_ <<= 1;
+            ++shard_bits_;
+        }
+
+        shards_.reset(new shard[num_shards_]);
+        for (std::size_t i = 0; i != num_shards_; ++i)
+            shards_[i].table_.store(new table(1));
+
+        num_readers_ = num_shards_;
+        readers_.reset(new reader_slot[num_readers_]);
+    }
+
+    gva_cache::~gva_cache()
+    {}
+
+    gva_cache::shard& gva_cache::get_shard(boost::uint64_t hash) const
+    {
+        return shards_[hash & (num_shards_ - 1)];
+    }
+
+    gva_cache::size_type gva_cache::size() const
+    {
+        return size_.load(boost::memory_order_relaxed) +
+            overflow_size_.load(boost::memory_order_relaxed);
+    }
+
+    gva_cache::size_type gva_cache::capacity() const
+    {
+        return max_size_.load(boost::memory_order_relaxed);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    boost::atomic<boost::int64_t>& gva_cache::enter_read() const
+    {
+        reader_slot& r = readers_[get_reader_index() & (num_readers_ - 1)];
+        boost::atomic<boost::int64_t>& active =
+            r.active_[epoch_.load(boost::memory_order_seq_cst) & 1];
+        active.fetch_add(1, boost::memory_order_seq_cst);
+        return active;
+    }
+
+    // Lookups which started before the epoch was advanced may still refer to
+    // superseded tables, wait for them to finish. Lookups never block, so
+    // this will not take long.
+    void gva_cache::wait_for_readers()
+    {
+        std::size_t const epoch =
+            epoch_.fetch_add(1, boost::memory_order_seq_cst);
+
+        for (std::size_t i = 0; i != num_readers_; ++i)
+        {
+            boost::atomic<boost::int64_t>& active =
+                readers_[i].active_[epoch & 1];
+            while (active.load(boost::memory_order_seq_cst) != 0)
+                std::this_thread::yield();
+        }
+    }
+
+    void gva_cache::reserve(size_type max_size)
+    {
+        std::lock_guard<mutex_type> rl(reserve_mtx_);
+
+        max_size_.store(max_size);
+
+        std::size_t num_sets = (max_size + num_shards_ * cache_ways - 1) /
+            (num_shards_ * cache_ways);
+        if (num_sets == 0)
+            num_sets = 1;
+
+        std::vector<std::unique_ptr<table> > retired;
+        for (std::size_t i = 0; i != num_shards_; ++i)
+        {
+            shard& s = shards_[i];
+            std::lock_guard<mutex_type> l(s.mtx_);
+
+            table* old_table = s.table_.load(boost::memory_order_relaxed);
+            if (old_table->num_sets_ == num_sets)
+                continue;
+
+            // move all existing entries over to the new table, drop entries
+            // if the new table is too small
+            std::unique_ptr<table> new_table(new table(num_sets));
+            slot_data data, victim_data;
+            for (std::size_t j = 0; j != old_table->num_sets_ * cache_ways; ++j)
+            {
+                slot const& old_slot = old_table->slots_[j];
+                if (old_slot.empty())
+                    continue;
+
+                old_slot.read(data);
+
+                boost::uint64_t const hash = hash_block(data[word_key_msb],
+                    data[word_block], std::size_t(data[word_level]));
+                HPX_ASSERT((hash & (num_shards_ - 1)) == i);
+
+                slot* victim = new_table->get_victim(hash >> shard_bits_);
+                if (!victim->empty())
+                {
+                    victim->read(victim_data);
+                    if (is_primary(victim_data))
+                    {
+                        --size_;
+                        s.statistics_.evictions_.fetch_add(1,
+                            boost::memory_order_relaxed);
+                    }
+                }
+                victim->write(data);
+            }
+
+            s.table_.store(new_table.release(), boost::memory_order_release);
+            retired.emplace_back(old_table);
+        }
+
+        {
+            std::lock_guard<mutex_type> l(overflow_->mtx_);
+            overflow_->cache_.reserve((std::max)(max_size / num_shards_,
+                std::size_t(16)));
+            overflow_size_.store(overflow_->cache_.size());
+        }
+
+        if (!retired.empty())
+            wait_for_readers();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    bool gva_cache::get_entry(naming::gid_type const& gid,
+        naming::gid_type& idbase, gva& g)
+    {
+        naming::gid_type const id = naming::detail::get_stripped_gid(gid);
+        boost::uint64_t const msb = id.get_msb();
+        boost::uint64_t const lsb = id.get_lsb();
+
+        shard& s = get_shard(hash_block(msb, lsb >> cache_block_bits, 0));
+        update_on_exit update(s.statistics_.get_entry_);
+
+        {
+            read_guard guard(*this);
+
+            slot_data data;
+            boost::uint32_t levels = levels_.load(boost::memory_order_acquire);
+            for (std::size_t level = 0; levels != 0; ++level, levels >>= 1)
+            {
+                if (!(levels & 1))
+                    continue;
+
+                boost::uint64_t const hash =
+                    hash_block(msb, lsb >> get_shift(level), level);
+                table const* t =
+                    get_shard(hash).table_.load(boost::memory_order_acquire);
+                slot* set = t->get_set(hash >> shard_bits_);
+
+                for (std::size_t i = 0; i != cache_ways; ++i)
+                {
+                    set[i].read(data);
+                    if (matches(data, msb, lsb, 1))
+                    {
+                        set[i].touch();
+                        s.statistics_.hits_.fetch_add(1,
+                            boost::memory_order_relaxed);
+
+                        idbase = naming::gid_type(data[word_key_msb],
+                            data[word_key_lsb]);
+                        g = get_gva(data);
+                        return true;
+                    }
+                }
+            }
+        }
+
+        if (overflow_size_.load(boost::memory_order_relaxed) != 0)
+        {
+            overflow_cache::key k(id);
+            overflow_cache::key realkey;
+
+            std::lock_guard<mutex_type> l(overflow_->mtx_);
+            if (overflow_->cache_.get_entry(k, realkey, g))
+            {
+                s.statistics_.hits_.fetch_add(1, boost::memory_order_relaxed);
+                idbase = realkey.get_gid();
+                return true;
+            }
+        }
+
+        s.statistics_.misses_.fetch_add(1, boost::memory_order_relaxed);
+        return false;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    bool gva_cache::update_range(naming::gid_type const& id,
+        boost::uint64_t count, gva const& g, naming::gid_type& old_gid,
+        boost::uint64_t& old_count)
+    {
+        overflow_cache::key k(id, count);
+
+        std::lock_guard<mutex_type> l(overflow_->mtx_);
+        overflow_cache::cache_type& cache = overflow_->cache_;
+
+        bool result = cache.update_if(k, g,
+            [](overflow_cache::key const& new_key,
+                overflow_cache::key const& old_key)
+            {
+                return new_key.get_gid() != old_key.get_gid() ||
+                    new_key.get_count() != old_key.get_count();
+            });
+
+        if (!result)
+        {
+            overflow_cache::key realkey;
+            gva old_g;
+            if (cache.get_entry(k, realkey, old_g))
+            {
+                old_gid = realkey.get_gid();
+                old_count = realkey.get_count();
+            }
+        }
+
+        overflow_size_.store(cache.size());
+        return result;
+    }
+
+    // Look for an entry stored on a level above the given one which
+    // overlaps with the given range of ids.
+    bool gva_cache::find_overlapping(boost::uint64_t msb, boost::uint64_t lsb,
+        boost::uint64_t last_lsb, std::size_t level,
+        naming::gid_type& old_gid, boost::uint64_t& old_count) const
+    {
+        read_guard guard(*this);
+
+        slot_data data;
+        boost::uint32_t levels =
+            levels_.load(boost::memory_order_acquire) >> (level + 1);
+        for (std::size_t l = level + 1; levels != 0; ++l, levels >>= 1)
+        {
+            if (!(levels & 1))
+                continue;
+
+            std::size_t const shift = get_shift(l);
+            for (boost::uint64_t block = lsb >> shift;
+                 block <= (last_lsb >> shift); ++block)
+            {
+                boost::uint64_t const hash = hash_block(msb, block, l);
+                table const* t =
+                    get_shard(hash).table_.load(boost::memory_order_acquire);
+                slot* set = t->get_set(hash >> shard_bits_);
+
+                for (std::size_t i = 0; i != cache_ways; ++i)
+                {
+                    set[i].read(data);
+                    if (overlaps(data, msb, lsb, last_lsb))
+                    {
+                        old_gid = naming::gid_type(data[word_key_msb],
+                            data[word_key_lsb]);
+                        old_count = data[word_key_count];
+                        return true;
+                    }
+                }
+            }
+        }
+        return false;
+    }
+
+    bool gva_cache::update_if(naming::gid_type const& gid,
+        boost::uint64_t count, gva const& g, naming::gid_type& old_gid,
+        boost::uint64_t& old_count)
+    {
+        HPX_ASSERT(count != 0);
+
+        naming::gid_type const id = naming::detail::get_stripped_gid(gid);
+        boost::uint64_t const msb = id.get_msb();
+        boost::uint64_t const lsb = id.get_lsb();
+
+        // ranges wrapping around the lsb go to the overflow cache
+        boost::uint64_t const last_lsb = lsb + (count - 1);
+        if (last_lsb < lsb)
+        {
+            shard& s = get_shard(hash_block(msb, lsb >> cache_block_bits, 0));
+            update_on_exit update(s.statistics_.update_entry_);
+            return update_range(id, count, g, old_gid, old_count);
+        }
+
+        std::size_t const level = get_level(lsb, last_lsb);
+        std::size_t const shift = get_shift(level);
+        boost::uint64_t const first_block = lsb >> shift;
+        std::size_t const num_blocks =
+            std::size_t((last_lsb >> shift) - first_block + 1);
+        HPX_ASSERT(num_blocks <= max_range_blocks);
+
+        boost::uint64_t hashes[max_range_blocks];
+        shard* shards[max_range_blocks];
+        for (std::size_t i = 0; i != num_blocks; ++i)
+        {
+            hashes[i] = hash_block(msb, first_block + i, level);
+            shards[i] = &get_shard(hashes[i]);
+        }
+
+        statistics& stats = shards[0]->statistics_;
+        update_on_exit update(stats.update_entry_);
+
+        // lock all affected shards in a fixed order to avoid deadlocks
+        shard* ordered[max_range_blocks];
+        std::copy(shards, shards + num_blocks, ordered);
+        std::sort(ordered, ordered + num_blocks);
+        std::size_t const num_locks =
+            std::unique(ordered, ordered + num_blocks) - ordered;
+
+        std::unique_lock<mutex_type> locks[max_range_blocks];
+        for (std::size_t i = 0; i != num_locks; ++i)
+            locks[i] = std::unique_lock<mutex_type>(ordered[i]->mtx_);
+
+        // check all covered sets before modifying anything, the cache is
+        // left unchanged if the new range collides with a different one
+        slot* sets[max_range_blocks];
+        slot* existing[max_range_blocks];
+        boost::uint64_t existing_blocks[max_range_blocks];
+
+        slot_data data;
+        for (std::size_t i = 0; i != num_blocks; ++i)
+        {
+            table* t = shards[i]->table_.load(boost::memory_order_relaxed);
+            sets[i] = t->get_set(hashes[i] >> shard_bits_);
+            existing[i] = nullptr;
+
+            for (std::size_t j = 0; j != cache_ways; ++j)
+            {
+                sets[i][j].read(data);
+                if (!overlaps(data, msb, lsb, last_lsb))
+                    continue;
+
+                if (data[word_key_lsb] != lsb || data[word_key_count] != count)
+                {
+                    old_gid = naming::gid_type(data[word_key_msb],
+                        data[word_key_lsb]);
+                    old_count = data[word_key_count];
+                    return false;
+                }
+
+                existing[i] = &sets[i][j];
+                existing_blocks[i] = data[word_block];
+            }
+        }
+
+        // wider ranges are stored on higher levels only, ranges on lower
+        // levels are not checked (just as evicted ones)
+        if (find_overlapping(msb, lsb, last_lsb, level, old_gid, old_count))
+            return false;
+
+        levels_.fetch_or(boost::uint32_t(1) << level,
+            boost::memory_order_acq_rel);
+
+        auto store_copies =
+            [&]()
+            {
+                slot_data new_data;
+                for (std::size_t i = 0; i != num_blocks; ++i)
+                {
+                    // a set holds a single copy even if several of the
+                    // blocks map onto it
+                    if (std::find(sets, sets + i, sets[i]) != sets + i)
+                        continue;
+
+                    if (existing[i] != nullptr)
+                    {
+                        make_slot_data(new_data, id, count, g, level,
+                            existing_blocks[i]);
+                        existing[i]->write(new_data);
+                        existing[i]->touch();
+                        continue;
+                    }
+
+                    table* t =
+                        shards[i]->table_.load(boost::memory_order_relaxed);
+                    slot* victim = t->get_victim(hashes[i] >> shard_bits_);
+                    if (!victim->empty())
+                    {
+                        victim->read(data);
+                        if (is_primary(data))
+                        {
+                            --size_;
+                            shards[i]->statistics_.evictions_.fetch_add(1,
+                                boost::memory_order_relaxed);
+                        }
+                    }
+
+                    make_slot_data(new_data, id, count, g, level,
+                        first_block + i);
+                    victim->write(new_data);
+                    victim->referenced_.store(false,
+                        boost::memory_order_relaxed);
+
+                    if (i == 0)
+                    {
+                        ++size_;
+                        stats.insertions_.fetch_add(1,
+                            boost::memory_order_relaxed);
+                    }
+                }
+            };
+
+        if (existing[0] != nullptr)
+        {
+            stats.hits_.fetch_add(1, boost::memory_order_relaxed);
+            store_copies();
+        }
+        else
+        {
+            stats.misses_.fetch_add(1, boost::memory_order_relaxed);
+
+            update_on_exit insert(stats.insert_entry_);
+            store_copies();
+        }
+
+        return true;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    gva_cache::size_type gva_cache::erase(naming::gid_type const& gid)
+    {
+        naming::gid_type const id = naming::detail::get_stripped_gid(gid);
+        boost::uint64_t const msb = id.get_msb();
+        boost::uint64_t const lsb = id.get_lsb();
+
+        update_on_exit update(get_shard(hash_block(
+            msb, lsb >> cache_block_bits, 0)).statistics_.erase_entry_);
+
+        // All copies of a range starting at the given id are stored in the
+        // sets of the first few blocks starting at this id on the level of
+        // the range.
+        slot_data const empty_data = { 0 };
+        size_type erased = 0;
+
+        slot_data data;
+        boost::uint32_t levels = levels_.load(boost::memory_order_acquire);
+        for (std::size_t level = 0; levels != 0; ++level, levels >>= 1)
+        {
+            if (!(levels & 1))
+                continue;
+
+            std::size_t const shift = get_shift(level);
+            boost::uint64_t const first_block = lsb >> shift;
+            boost::uint64_t const max_block = ~boost::uint64_t(0) >> shift;
+
+            for (boost::uint64_t block = first_block;
+                 block != first_block + max_range_blocks && block <= max_block;
+                 ++block)
+            {
+                boost::uint64_t const hash = hash_block(msb, block, level);
+                shard& s = get_shard(hash);
+                std::lock_guard<mutex_type> l(s.mtx_);
+
+                table* t = s.table_.load(boost::memory_order_relaxed);
+                slot* set = t->get_set(hash >> shard_bits_);
+                for (std::size_t i = 0; i != cache_ways; ++i)
+                {
+                    if (set[i].empty())
+                        continue;
+
+                    set[i].read(data);
+                    if (data[word_key_msb] != msb || data[word_key_lsb] != lsb)
+                        continue;
+
+                    if (is_primary(data))
+                    {
+                        --size_;
+                        ++erased;
+                        s.statistics_.evictions_.fetch_add(1,
+                            boost::memory_order_relaxed);
+                    }
+                    set[i].write(empty_data);
+                }
+            }
+        }
+
+        if (overflow_size_.load() != 0)
+        {
+            std::lock_guard<mutex_type> l(overflow_->mtx_);
+            erased += overflow_->cache_.erase(
+                [&id](std::pair<overflow_cache::key, gva> const& p)
+                {
+                    return id == p.first.get_gid();
+                });
+            overflow_size_.store(overflow_->cache_.size());
+        }
+
+        return erased;
+    }
+
+    // The mask of used levels is left alone, resetting it could hide entries
+    // inserted concurrently.
+    gva_cache::size_type gva_cache::clear()
+    {
+        slot_data const empty_data = { 0 };
+        size_type erased = 0;
+
+        slot_data data;
+        for (std::size_t i = 0; i != num_shards_; ++i)
+        {
+            shard& s = shards_[i];
+            std::lock_guard<mutex_type> l(s.mtx_);
+
+            table* t = s.table_.load(boost::memory_order_relaxed);
+            for (std::size_t j = 0; j != t->num_sets_ * cache_ways; ++j)
+            {
+                slot& sl = t->slots_[j];
+                if (sl.empty())
+                    continue;
+
+                sl.read(data);
+                if (is_primary(data))
+                {
+                    --size_;
+                    ++erased;
+                }
+                sl.write(empty_data);
+            }
+        }
+
+        std::lock_guard<mutex_type> l(overflow_->mtx_);
+        erased += overflow_->cache_.clear();
+        overflow_size_.store(0);
+
+        return erased;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename F>
+    boost::int64_t gva_cache::accumulate(F && f, bool reset)
+    {
+        boost::int64_t result = 0;
+        for (std::size_t i = 0; i != num_shards_; ++i)
+        {
+            boost::atomic<boost::int64_t>& value = f(shards_[i].statistics_);
+            result += reset ? value.exchange(0) : value.load();
+        }
+        return result;
+    }
+
+    std::size_t gva_cache::hits(bool reset)
+    {
+        return std::size_t(accumulate(
+            [](statistics& s) -> boost::atomic<boost::int64_t>&
+            {
+                return s.hits_;
+            },
+            reset));
+    }
+
+    std::size_t gva_cache::misses(bool reset)
+    {
+        return std::size_t(accumulate(
+            [](statistics& s) -> boost::atomic<boost::int64_t>&
+            {
+                return s.misses_;
+            },
+            reset));
+    }
+
+    std::size_t gva_cache::insertions(bool reset)
+    {
+        return std::size_t(accumulate(
+            [](statistics& s) -> boost::atomic<boost::int64_t>&
+            {
+                return s.insertions_;
+            },
+            reset));
+    }
+
+    std::size_t gva_cache::evictions(bool reset)
+    {
+        return std::size_t(accumulate(
+            [](statistics& s) -> boost::atomic<boost::int64_t>&
+            {
+                return s.evictions_;
+            },
+            reset));
+    }
+
+    boost::int64_t gva_cache::get_get_entry_count(bool reset)
+    {
+        return accumulate(
+            [](statistics& s) -> boost::atomic<boost::int64_t>&
+            {
+                return s.get_entry_.count_;
+            },
+            reset);
+    }
+
+    boost::int64_t gva_cache::get_insert_entry_count(bool reset)
+    {
+        return accumulate(
+            [](statistics& s) -> boost::atomic<boost::int64_t>&
+            {
+                return s.insert_entry_.count_;
+            },
+            reset);
+    }
+
+    boost::int64_t gva_cache::get_update_entry_count(bool reset)
+    {
+        return accumulate(
+            [](statistics& s) -> boost::atomic<boost::int64_t>&
+            {
+                return s.update_entry_.count_;
+            },
+            reset);
+    }
+
+    boost::int64_t gva_cache::get_erase_entry_count(bool reset)
+    {
+        return accumulate(
+            [](statistics& s) -> boost::atomic<boost::int64_t>&
+            {
+                return s.erase_entry_.count_;
+            },
+            reset);
+    }
+
+    boost::int64_t gva_cache::get_get_entry_time(bool reset)
+    {
+        return accumulate(
+            [](statistics& s) -> boost::atomic<boost::int64_t>&
+            {
+                return s.get_entry_.time_;
+            },
+            reset);
+    }
+
+    boost::int64_t gva_cache::get_insert_entry_time(bool reset)
+    {
+        return accumulate(
+            [](statistics& s) -> boost::atomic<boost::int64_t>&
+            {
+                return s.insert_entry_.time_;
+            },
+            reset);
+    }
+
+    boost::int64_t gva_cache::get_update_entry_time(bool reset)
+    {
+        return accumulate(
+            [](statistics& s) -> boost::atomic<boost::int64_t>&
+            {
+                return s.update_entry_.time_;
+            },
+            reset);
+    }
+
+    boost::int64_t gva_cache::get_erase_entry_time(bool reset)
+    {
+        return accumulate(
+            [](statistics& s) -> boost::atomic<boost::int64_t>&
+            {
+                return s.erase_entry_.time_;
+            },
+            reset);
+    }
+}}}
@@ -294,6 +294,19 @@ naming::address resolve_sync(
     return agas_.resolve_async(id).get(ec);
 }
 
+hpx::future<std::vector<naming::address> > resolve(
+    std::vector<naming::id_type> const& ids
+    )
+{
+    std::vector<naming::gid_type> gids;
+    gids.reserve(ids.size());
+    for (naming::id_type const& id : ids)
+        gids.push_back(id.get_gid());
+
+    naming::resolver_client& agas_ = naming::get_agas_client();
+    return agas_.resolve_async(gids);
+}
+
 hpx::future<bool> bind(
     naming::gid_type const& gid
   , naming::address const& addr
@@ -493,6 +506,20 @@ boost::int64_t incref(
     return resolver.incref_async(gid, credits, keep_alive).get();
 }
 
+hpx::future<std::vector<boost::int64_t> > incref_async(
+    std::vector<std::pair<naming::gid_type, boost::int64_t> > const& increfs
+  )
+{
+#if defined(HPX_DEBUG)
+    typedef std::pair<naming::gid_type, boost::int64_t> incref_type;
+    for (incref_type const& incref : increfs)
+        HPX_ASSERT(!naming::detail::is_locked(incref.first));
+#endif
+
+    naming::resolver_client& resolver = naming::get_agas_client();
+    return resolver.incref_async(increfs);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 hpx::future<naming::id_type> get_colocation_id(
     naming::id_type const& id)
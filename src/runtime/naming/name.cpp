@@ -29,6 +29,7 @@
 #include <boost/io/ios_state.hpp>
 #include <boost/ref.hpp>
 
+#include <cstddef>
 #include <cstdint>
 #include <iomanip>
 #include <iostream>
@@ -37,6 +38,7 @@
 #include <sstream>
 #include <string>
 #include <utility>
+#include <vector>
 
 ///////////////////////////////////////////////////////////////////////////////
 //
@@ -370,6 +372,85 @@ namespace hpx { namespace naming
             return hpx::make_ready_future(new_gid);
         }
 
+        ///////////////////////////////////////////////////////////////////////
+        hpx::future<std::vector<id_type> > split_gids(
+            std::vector<id_type> const& ids)
+        {
+            std::vector<id_type> split_ids(ids.size());
+
+            // the ids which ran out of credits are replenished together
+            std::vector<std::size_t> exhausted;
+            std::vector<std::pair<gid_type, std::int64_t> > increfs;
+
+            for (std::size_t i = 0; i != ids.size(); ++i)
+            {
+                if (!ids[i] ||
+                    id_type::managed != ids[i].get_management_type())
+                {
+                    split_ids[i] = ids[i];
+                    continue;
+                }
+
+                typedef std::unique_lock<gid_type::mutex_type> scoped_lock;
+
+                gid_type& gid = const_cast<id_type&>(ids[i]).get_gid();
+                scoped_lock l(gid.get_mutex());
+
+                if (!naming::detail::has_credits(gid))
+                {
+                    l.unlock();
+                    split_ids[i] = ids[i];
+                    continue;
+                }
+
+                HPX_ASSERT(get_log2credit_from_gid(gid) > 0);
+                if (get_log2credit_from_gid(gid) == 1)
+                {
+                    // Credit exhaustion, see split_gid_if_needed_locked
+                    // for the details.
+                    set_credit_split_mask_for_gid(gid);
+
+                    naming::gid_type new_gid = gid;     // strips lock-bit
+                    HPX_ASSERT(new_gid != invalid_gid);
+                    l.unlock();
+
+                    std::int64_t new_credit = 2 *
+                        (static_cast<std::int64_t>(HPX_GLOBALCREDIT_INITIAL) - 1);
+
+                    exhausted.push_back(i);
+                    increfs.push_back(std::make_pair(new_gid, new_credit));
+                    continue;
+                }
+
+                naming::gid_type new_gid = split_credits_for_gid_locked(l, gid);
+                l.unlock();
+
+                // the split credits are moved when the id is sent
+                split_ids[i] = id_type(new_gid, id_type::managed_move_credit);
+            }
+
+            if (exhausted.empty())
+                return hpx::make_ready_future(std::move(split_ids));
+
+            // the original ids are kept alive until the credits have arrived
+            std::vector<id_type> keep_alive(ids);
+            return agas::incref_async(increfs).then(
+                [keep_alive, exhausted, split_ids](
+                    hpx::future<std::vector<std::int64_t> > f) mutable
+                ->  std::vector<id_type>
+                {
+                    f.get();            // rethrow exceptions
+
+                    for (std::size_t i : exhausted)
+                    {
+                        split_ids[i] = id_type(
+                            postprocess_incref(keep_alive[i].get_gid()),
+                            id_type::managed_move_credit);
+                    }
+                    return std::move(split_ids);
+                });
+        }
+
         ///////////////////////////////////////////////////////////////////////
         gid_type move_gid(gid_type& gid)
         {
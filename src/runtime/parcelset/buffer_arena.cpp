@@ -0,0 +1,246 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/parcelset/detail/buffer_arena.hpp>
+#include <hpx/runtime/serialization/serialization_chunk.hpp>
+#include <hpx/util/get_and_reset_value.hpp>
+#include <hpx/util/spinlock.hpp>
+#include <hpx/util/thread_specific_ptr.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+
+#include <cstddef>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parcelset { namespace detail
+{
+    namespace
+    {
+        boost::atomic<boost::int64_t> buffer_arena_hits(0);
+        boost::atomic<boost::int64_t> buffer_arena_misses(0);
+
+        // The size classes cover buffers of 256 bytes up to 16MByte.
+        std::size_t const min_buffer_bytes = 0x100;
+        std::size_t const max_buffer_bytes = 0x1000000;
+        std::size_t const num_size_classes = 17;
+
+        // The number of buffers of one size class kept by each OS-thread
+        // and by the global depot. Buffers larger than cache_limit_bytes
+        // are kept sparingly.
+        std::size_t const thread_cache_limit = 8;
+        std::size_t const depot_limit = 64;
+        std::size_t const cache_limit_bytes = 0x10000;
+
+        // The smallest size class holding at least the given number of
+        // bytes.
+        std::size_t ceil_size_class(std::size_t bytes)
+        {
+            std::size_t size_class = 0;
+            for (std::size_t s = min_buffer_bytes; s < bytes; s <<= 1)
+                ++size_class;
+            return size_class;
+        }
+
+        // The largest size class not exceeding the given number of bytes,
+        // which must be at least min_buffer_bytes.
+        std::size_t floor_size_class(std::size_t bytes)
+        {
+            std::size_t size_class = 0;
+            for (std::size_t s = 2 * min_buffer_bytes; s <= bytes; s <<= 1)
+                ++size_class;
+            return size_class;
+        }
+
+        std::size_t size_class_limit(std::size_t size_class,
+            std::size_t limit)
+        {
+            std::size_t const bytes = min_buffer_bytes << size_class;
+            if (bytes <= cache_limit_bytes)
+                return limit;
+
+            limit /= bytes / cache_limit_bytes;
+            return limit != 0 ? limit : 1;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename T>
+        struct buffer_cache
+        {
+            typedef std::vector<std::vector<T> > buffers_type;
+
+            explicit buffer_cache(std::size_t limit)
+            {
+                for (std::size_t i = 0; i != num_size_classes; ++i)
+                    buffers_[i].reserve(size_class_limit(i, limit));
+            }
+
+            bool get(std::size_t size_class, std::vector<T>& buffer)
+            {
+                buffers_type& buffers = buffers_[size_class];
+                if (buffers.empty())
+                    return false;
+
+                buffer = std::move(buffers.back());
+                buffers.pop_back();
+                return true;
+            }
+
+            bool put(std::size_t size_class, std::vector<T>& buffer)
+            {
+                buffers_type& buffers = buffers_[size_class];
+                if (buffers.size() == buffers.capacity())
+                    return false;
+
+                buffers.push_back(std::move(buffer));
+                return true;
+            }
+
+            buffers_type buffers_[num_size_classes];
+        };
+
+        template <typename T>
+        struct buffer_depot
+        {
+            buffer_depot()
+              : cache_(depot_limit)
+            {}
+
+            bool get(std::size_t size_class, std::vector<T>& buffer)
+            {
+                std::lock_guard<util::spinlock> l(mtx_);
+                return cache_.get(size_class, buffer);
+            }
+
+            bool put(std::size_t size_class, std::vector<T>& buffer)
+            {
+                std::lock_guard<util::spinlock> l(mtx_);
+                return cache_.put(size_class, buffer);
+            }
+
+            util::spinlock mtx_;
+            buffer_cache<T> cache_;
+        };
+
+        template <typename T>
+        buffer_depot<T>& get_buffer_depot()
+        {
+            static buffer_depot<T> depot;
+            return depot;
+        }
+
+        template <typename T>
+        buffer_cache<T>& get_thread_cache()
+        {
+            static util::thread_specific_ptr<buffer_cache<T>, buffer_cache<T> >
+                cache;
+            if (nullptr == cache.get())
+                cache.reset(new buffer_cache<T>(thread_cache_limit));
+            return *cache;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename T>
+        void recycle(std::vector<T>& buffer)
+        {
+            std::size_t const bytes = buffer.capacity() * sizeof(T);
+            if (bytes >= min_buffer_bytes && bytes <= max_buffer_bytes)
+            {
+                std::size_t const size_class = floor_size_class(bytes);
+
+                buffer.clear();
+                if (get_thread_cache<T>().put(size_class, buffer) ||
+                    get_buffer_depot<T>().put(size_class, buffer))
+                {
+                    return;
+                }
+            }
+
+            std::vector<T>().swap(buffer);
+        }
+
+        template <typename T>
+        void reserve(std::vector<T>& buffer, std::size_t size)
+        {
+            if (buffer.capacity() >= size)
+                return;
+
+            std::size_t const bytes = size * sizeof(T);
+            if (!buffer.empty() || bytes > max_buffer_bytes)
+            {
+                buffer.reserve(size);
+                ++buffer_arena_misses;
+                return;
+            }
+
+            std::size_t const size_class = ceil_size_class(bytes);
+
+            std::vector<T> recycled;
+            if (get_thread_cache<T>().get(size_class, recycled) ||
+                get_buffer_depot<T>().get(size_class, recycled))
+            {
+                recycle(buffer);
+                buffer = std::move(recycled);
+                ++buffer_arena_hits;
+                return;
+            }
+
+            // allocate the full size class to make the buffer reusable for
+            // all requests falling into it
+            std::size_t const class_bytes = min_buffer_bytes << size_class;
+            buffer.reserve((class_bytes + sizeof(T) - 1) / sizeof(T));
+            ++buffer_arena_misses;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void reserve_buffer(std::vector<char>& buffer, std::size_t size)
+    {
+        reserve(buffer, size);
+    }
+
+    void reserve_buffer(
+        std::vector<serialization::serialization_chunk>& buffer,
+        std::size_t size)
+    {
+        reserve(buffer, size);
+    }
+
+    void reserve_buffer(std::vector<transmission_chunk_type>& buffer,
+        std::size_t size)
+    {
+        reserve(buffer, size);
+    }
+
+    void recycle_buffer(std::vector<char>& buffer)
+    {
+        recycle(buffer);
+    }
+
+    void recycle_buffer(
+        std::vector<serialization::serialization_chunk>& buffer)
+    {
+        recycle(buffer);
+    }
+
+    void recycle_buffer(std::vector<transmission_chunk_type>& buffer)
+    {
+        recycle(buffer);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    boost::int64_t get_buffer_arena_hits(bool reset)
+    {
+        return util::get_and_reset_value(buffer_arena_hits, reset);
+    }
+
+    boost::int64_t get_buffer_arena_misses(bool reset)
+    {
+        return util::get_and_reset_value(buffer_arena_misses, reset);
+    }
+}}}
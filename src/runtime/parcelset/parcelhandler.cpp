@@ -22,6 +22,7 @@
 #include <hpx/runtime/message_handler_fwd.hpp>
 #include <hpx/runtime/naming/resolver_client.hpp>
 #include <hpx/runtime/message_handler_fwd.hpp>
+#include <hpx/runtime/parcelset/detail/buffer_arena.hpp>
 #include <hpx/runtime/parcelset/parcelhandler.hpp>
 #include <hpx/runtime/parcelset/static_parcelports.hpp>
 #include <hpx/runtime/parcelset/policies/message_handler.hpp>
@@ -983,6 +984,26 @@ namespace hpx { namespace parcelset
                   _1, outgoing_routed_count, _2),
               &performance_counters::locality_counter_discoverer,
               ""
+            },
+            { "/parcels/count/arena/hits",
+              performance_counters::counter_raw,
+              "returns the number of parcel buffers which were taken from the "
+                  "arena of recycled buffers",
+              HPX_PERFORMANCE_COUNTER_V1,
+              util::bind(&performance_counters::locality_raw_counter_creator,
+                  _1, &detail::get_buffer_arena_hits, _2),
+              &performance_counters::locality_counter_discoverer,
+              ""
+            },
+            { "/parcels/count/arena/misses",
+              performance_counters::counter_raw,
+              "returns the number of parcel buffers which had to be allocated "
+                  "as no recycled buffer was available",
+              HPX_PERFORMANCE_COUNTER_V1,
+              util::bind(&performance_counters::locality_raw_counter_creator,
+                  _1, &detail::get_buffer_arena_misses, _2),
+              &performance_counters::locality_counter_discoverer,
+              ""
             }
         };
         performance_counters::install_counter_types(
@@ -129,6 +129,11 @@ namespace hpx { namespace serialization { namespace detail
         return result;
     }
 
+    boost::uint32_t try_get_type_id(std::string const& type_name)
+    {
+        return id_registry::instance().try_get_id(type_name);
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     polymorphic_id_factory& polymorphic_id_factory::instance()
     {
@@ -150,6 +155,25 @@ namespace hpx { namespace serialization { namespace detail
         return id;
     }
 
+    void* polymorphic_id_factory::create(std::string const& name)
+    {
+        id_registry const& registry = id_registry::instance();
+
+        id_registry::typename_to_ctor_t::const_iterator it =
+            registry.typename_to_ctor.find(name);
+        if (it == registry.typename_to_ctor.end())
+        {
+            std::string msg("Unknown typename " + name);
+#if defined(HPX_DEBUG)
+            msg += "\n" + collect_registered_typenames();
+#endif
+            HPX_THROW_EXCEPTION(serialization_error
+                , "polymorphic_id_factory::create", msg);
+        }
+
+        return it->second();
+    }
+
     std::string polymorphic_id_factory::collect_registered_typenames()
     {
 #if defined(HPX_DEBUG)
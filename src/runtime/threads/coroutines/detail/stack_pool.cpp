@@ -0,0 +1,349 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_UNISTD_H)
+#include <unistd.h>
+#endif
+
+#if defined(_POSIX_VERSION)
+#include <hpx/runtime/threads/coroutines/detail/posix_utility.hpp>
+#include <hpx/runtime/threads/coroutines/detail/stack_pool.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/get_and_reset_value.hpp>
+#include <hpx/util/thread_specific_ptr.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+
+#include <cstddef>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace hpx { namespace threads { namespace coroutines { namespace detail {
+namespace posix
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // these global variables are set once by the runtime configuration
+    // startup code
+    HPX_EXPORT bool use_stack_pool = true;
+    HPX_EXPORT std::size_t stack_pool_high_water_mark = 128;
+
+    namespace
+    {
+        boost::atomic<boost::uint64_t> stack_allocation_count(0);
+        boost::atomic<boost::uint64_t> stack_reuse_count(0);
+        boost::atomic<boost::uint64_t> stack_trim_count(0);
+    }
+
+    boost::uint64_t get_stack_allocation_count(bool reset)
+    {
+        return util::get_and_reset_value(stack_allocation_count, reset);
+    }
+
+    boost::uint64_t get_stack_reuse_count(bool reset)
+    {
+        return util::get_and_reset_value(stack_reuse_count, reset);
+    }
+
+    boost::uint64_t get_stack_trim_count(bool reset)
+    {
+        return util::get_and_reset_value(stack_trim_count, reset);
+    }
+
+#if defined(HPX_HAVE_THREAD_STACK_MMAP) && defined(_POSIX_MAPPED_FILES) \
+ && _POSIX_MAPPED_FILES > 0
+
+    namespace
+    {
+        // Stacks of up to this many different sizes are pooled (the runtime
+        // uses four: small, medium, large, and huge).
+        std::size_t const max_size_classes = 8;
+
+        // New stacks are carved out of slabs of (at least) this size.
+        std::size_t const slab_size = 0x100000;      // 1MByte
+
+        ///////////////////////////////////////////////////////////////////////
+        // The global pool holds the (trimmed) stacks which did not fit into
+        // the cache of the OS-thread which released them.
+        struct global_pool
+        {
+            global_pool()
+            {
+                for (std::size_t i = 0; i != max_size_classes; ++i)
+                    sizes_[i].store(0);
+            }
+
+            // Return the index of the size class for stacks of the given
+            // size, register a new size class if needed. Returns -1 if all
+            // size classes are taken by other sizes.
+            std::size_t get_size_class(std::size_t size)
+            {
+                for (std::size_t i = 0; i != max_size_classes; ++i)
+                {
+                    std::size_t s = sizes_[i].load(boost::memory_order_acquire);
+                    if (s == 0)
+                    {
+                        if (sizes_[i].compare_exchange_strong(s, size))
+                            return i;
+                    }
+                    if (s == size)
+                        return i;
+                }
+                return std::size_t(-1);
+            }
+
+            bool get_stack(std::size_t size_class, void*& stack)
+            {
+                std::lock_guard<std::mutex> l(mtx_);
+
+                std::vector<void*>& stacks = stacks_[size_class];
+                if (stacks.empty())
+                    return false;
+
+                stack = stacks.back();
+                stacks.pop_back();
+                return true;
+            }
+
+            void add_stack(std::size_t size_class, void* stack)
+            {
+                std::lock_guard<std::mutex> l(mtx_);
+                stacks_[size_class].push_back(stack);
+            }
+
+            void add_stacks(std::size_t size_class,
+                std::vector<void*> const& stacks)
+            {
+                std::lock_guard<std::mutex> l(mtx_);
+                stacks_[size_class].insert(stacks_[size_class].end(),
+                    stacks.begin(), stacks.end());
+            }
+
+            boost::atomic<std::size_t> sizes_[max_size_classes];
+
+            std::mutex mtx_;
+            std::vector<void*> stacks_[max_size_classes];
+        };
+
+        global_pool& get_global_pool()
+        {
+            static global_pool pool;
+            return pool;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Each OS-thread caches the stacks it released most recently (these
+        // are likely to still be hot in the cache and are already backed by
+        // physical memory) and the not yet used stacks of the slab it mapped
+        // last.
+        struct thread_cache
+        {
+            std::vector<void*> used_[max_size_classes];
+            std::vector<void*> fresh_[max_size_classes];
+        };
+
+        struct thread_cache_tag {};
+
+        util::thread_specific_ptr<thread_cache, thread_cache_tag>&
+        get_thread_cache_ptr()
+        {
+            static util::thread_specific_ptr<thread_cache, thread_cache_tag>
+                cache;
+            return cache;
+        }
+
+        thread_cache& get_thread_cache()
+        {
+            util::thread_specific_ptr<thread_cache, thread_cache_tag>& cache =
+                get_thread_cache_ptr();
+            if (nullptr == cache.get())
+                cache.reset(new thread_cache);
+            return *cache;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Map a slab holding as many stacks of the given size as fit into
+        // slab_size (but at least one). As stacks grow downwards, the guard
+        // page (if enabled) of each stack is placed directly below it, i.e.
+        // the same page guards the top of the preceding stack from being
+        // overrun from below:
+        //
+        //      [guard|stack 0|guard|stack 1|...|guard|stack n-1]
+        //
+        void map_slab(std::size_t size, std::vector<void*>& stacks)
+        {
+            std::size_t guard_size = 0;
+#if defined(HPX_HAVE_THREAD_GUARD_PAGE)
+            if (use_guard_pages)
+                guard_size = EXEC_PAGESIZE;
+#endif
+            std::size_t const stride = size + guard_size;
+            std::size_t count = slab_size / stride;
+            if (count == 0)
+                count = 1;
+
+            void* slab = ::mmap(nullptr,
+                count * stride,
+                PROT_EXEC | PROT_READ | PROT_WRITE,
+#if defined(__APPLE__)
+                MAP_PRIVATE | MAP_ANON | MAP_NORESERVE,
+#else
+                MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE,
+#endif
+                -1,
+                0
+                );
+
+            if (slab == MAP_FAILED)
+            {
+                if (ENOMEM == errno)
+                    throw std::runtime_error("mmap() failed to allocate thread "
+                        "stack slab due to insufficient resources, "
+                        "increase /proc/sys/vm/max_map_count or add "
+                        "-Ihpx.stacks.use_guard_pages=0 to the command line");
+                else
+                    throw std::runtime_error(
+                        "mmap() failed to allocate thread stack slab");
+            }
+
+            // hand out the stacks at the lower addresses first
+            char* base = static_cast<char*>(slab);
+            for (std::size_t i = count; i != 0; --i)
+            {
+                char* p = base + (i - 1) * stride;
+                if (guard_size != 0)
+                    ::mprotect(p, guard_size, PROT_NONE);
+                stacks.push_back(p + guard_size);
+            }
+        }
+
+        // Give the memory of the given stack back to the operating system.
+        // The address range stays valid and will be backed by zeroed pages
+        // on the next access.
+        void trim_stack(void* stack, std::size_t size)
+        {
+            ::madvise(stack, size, MADV_DONTNEED);
+            ++stack_trim_count;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void* pool_alloc_stack(std::size_t size)
+    {
+        global_pool& pool = get_global_pool();
+        std::size_t const size_class = pool.get_size_class(size);
+        if (size_class == std::size_t(-1))
+            return nullptr;
+
+        thread_cache& cache = get_thread_cache();
+        void* stack = nullptr;
+
+        // prefer stacks which have been in use recently
+        std::vector<void*>& used = cache.used_[size_class];
+        if (!used.empty())
+        {
+            stack = used.back();
+            used.pop_back();
+            ++stack_reuse_count;
+            return stack;
+        }
+
+        // then use the remainder of the last slab mapped by this OS-thread
+        std::vector<void*>& fresh = cache.fresh_[size_class];
+        if (!fresh.empty())
+        {
+            stack = fresh.back();
+            fresh.pop_back();
+            ++stack_allocation_count;
+            return stack;
+        }
+
+        // then try the stacks released by other OS-threads
+        if (pool.get_stack(size_class, stack))
+        {
+            ++stack_reuse_count;
+            return stack;
+        }
+
+        // finally, map a new slab
+        map_slab(size, fresh);
+        HPX_ASSERT(!fresh.empty());
+
+        stack = fresh.back();
+        fresh.pop_back();
+        ++stack_allocation_count;
+        return stack;
+    }
+
+    bool pool_free_stack(void* stack, std::size_t size)
+    {
+        global_pool& pool = get_global_pool();
+        std::size_t const size_class = pool.get_size_class(size);
+        if (size_class == std::size_t(-1))
+            return false;
+
+        thread_cache& cache = get_thread_cache();
+        std::vector<void*>& used = cache.used_[size_class];
+        if (used.size() < stack_pool_high_water_mark)
+        {
+            used.push_back(stack);
+            return true;
+        }
+
+        // this OS-thread holds enough stacks already
+        trim_stack(stack, size);
+        pool.add_stack(size_class, stack);
+        return true;
+    }
+
+    void flush_stack_pool()
+    {
+        util::thread_specific_ptr<thread_cache, thread_cache_tag>& cache_ptr =
+            get_thread_cache_ptr();
+        if (nullptr == cache_ptr.get())
+            return;
+
+        global_pool& pool = get_global_pool();
+        thread_cache& cache = *cache_ptr;
+        for (std::size_t i = 0; i != max_size_classes; ++i)
+        {
+            std::size_t const size = pool.sizes_[i].load();
+            if (size == 0)
+                break;
+
+            for (void* stack : cache.used_[i])
+                trim_stack(stack, size);
+
+            pool.add_stacks(i, cache.used_[i]);
+            pool.add_stacks(i, cache.fresh_[i]);
+        }
+
+        cache_ptr.reset();
+    }
+
+#else  // non-mmap()
+
+    void* pool_alloc_stack(std::size_t size)
+    {
+        return nullptr;
+    }
+
+    bool pool_free_stack(void* stack, std::size_t size)
+    {
+        return false;
+    }
+
+    void flush_stack_pool()
+    {
+    }
+
+#endif
+}
+}}}}
+
+#endif
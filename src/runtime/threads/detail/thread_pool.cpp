@@ -10,6 +10,7 @@
 #include <hpx/state.hpp>
 #include <hpx/throw_exception.hpp>
 #include <hpx/lcos/local/no_mutex.hpp>
+#include <hpx/runtime/get_config_entry.hpp>
 #include <hpx/runtime/get_worker_thread_num.hpp>
 #include <hpx/runtime/threads/detail/create_thread.hpp>
 #include <hpx/runtime/threads/detail/create_work.hpp>
@@ -23,6 +24,7 @@
 #include <hpx/util/logging.hpp>
 #include <hpx/util/hardware/timestamp.hpp>
 #include <hpx/util/high_resolution_clock.hpp>
+#include <hpx/util/safe_lexical_cast.hpp>
 #include <hpx/util/unlock_guard.hpp>
 
 #include <boost/atomic.hpp>
@@ -38,6 +40,7 @@
 #include <cstdint>
 #include <exception>
 #include <iomanip>
+#include <limits>
 #include <mutex>
 #include <numeric>
 
@@ -65,6 +68,9 @@ namespace hpx { namespace threads { namespace detail
         notifier_(notifier),
         pool_name_(pool_name),
         thread_count_(0),
+#if defined(HPX_HAVE_THREAD_IDLE_RATES)
+        phase_durations_(threads::hardware_concurrency()),
+#endif
         used_processing_units_(),
         mode_(m)
     {
@@ -470,7 +476,7 @@ namespace hpx { namespace threads { namespace detail
             sched_.set_all_states(state_stopping);
 
             // make sure we're not waiting
-            sched_.Scheduler::do_some_work(std::size_t(-1));
+            sched_.Scheduler::unpark_all_workers();
 
             if (blocking) {
                 for (std::size_t i = 0; i != threads_.size(); ++i)
@@ -480,7 +486,7 @@ namespace hpx { namespace threads { namespace detail
                         << "thread_pool::stop: " << pool_name_
                         << " notify_all";
 
-                    sched_.Scheduler::do_some_work(std::size_t(-1));
+                    sched_.Scheduler::unpark_all_workers();
 
                     LTM_(info) //-V128
                         << "thread_pool::stop: " << pool_name_
@@ -600,12 +606,34 @@ namespace hpx { namespace threads { namespace detail
                     detail::scheduling_counters counters(
                         executed_threads_[num_thread],
                         executed_thread_phases_[num_thread],
-                        tfunc_times_[num_thread], exec_times_[num_thread]);
+                        tfunc_times_[num_thread], exec_times_[num_thread]
+#if defined(HPX_HAVE_THREAD_IDLE_RATES)
+                      , &phase_durations_, timestamp_scale_
+#endif
+                        );
+
+                    // maximal time [ms] an idle worker thread stays parked
+                    // before looking for work again, a parked thread has
+                    // to wait for at least one millisecond to not spin
+                    boost::int64_t max_idle_backoff_time =
+                        hpx::util::safe_lexical_cast<boost::int64_t>(
+                            hpx::get_config_entry("hpx.max_idle_backoff_time",
+                                1000));
+                    if (max_idle_backoff_time < 1)
+                    {
+                        max_idle_backoff_time = 1;
+                    }
+                    else if (max_idle_backoff_time >
+                        (std::numeric_limits<boost::uint32_t>::max)())
+                    {
+                        max_idle_backoff_time =
+                            (std::numeric_limits<boost::uint32_t>::max)();
+                    }
 
                     detail::scheduling_callbacks callbacks(
                         util::bind( //-V107
                             &policies::scheduler_base::idle_callback,
-                            &sched_, num_thread
+                            &sched_, num_thread, max_idle_backoff_time
                         ),
                         detail::scheduling_callbacks::callback_type());
 
@@ -1379,6 +1407,28 @@ namespace hpx { namespace threads { namespace detail
     {
         return sched_.Scheduler::get_num_stolen_to_staged(num, reset);
     }
+
+    template <typename Scheduler>
+    std::int64_t thread_pool<Scheduler>::
+        get_num_stolen_in_core(std::size_t num, bool reset)
+    {
+        return sched_.Scheduler::get_num_stolen_in_core(num, reset);
+    }
+
+    template <typename Scheduler>
+    std::int64_t thread_pool<Scheduler>::
+        get_num_stolen_in_numa_domain(std::size_t num, bool reset)
+    {
+        return sched_.Scheduler::get_num_stolen_in_numa_domain(num, reset);
+    }
+
+    template <typename Scheduler>
+    std::int64_t thread_pool<Scheduler>::
+        get_num_stolen_outside_numa_domain(std::size_t num, bool reset)
+    {
+        return sched_.Scheduler::get_num_stolen_outside_numa_domain(num,
+            reset);
+    }
 #endif
 
 }}}
@@ -1418,6 +1468,11 @@ template class HPX_EXPORT hpx::threads::detail::thread_pool<
     hpx::threads::policies::abp_fifo_priority_queue_scheduler>;
 #endif
 
+#if defined(HPX_HAVE_CHASE_LEV_SCHEDULER)
+template class HPX_EXPORT hpx::threads::detail::thread_pool<
+    hpx::threads::policies::chase_lev_priority_queue_scheduler>;
+#endif
+
 #if defined(HPX_HAVE_HIERARCHY_SCHEDULER)
 #include <hpx/runtime/threads/policies/hierarchy_scheduler.hpp>
 template class HPX_EXPORT hpx::threads::detail::thread_pool<
@@ -130,6 +130,12 @@ namespace hpx { namespace threads
         return thread_self::get_self();
     }
 
+    thread_self* get_suspendable_self_ptr()
+    {
+        thread_self* p = thread_self::get_self();
+        return (p != nullptr && !p->is_stackless()) ? p : nullptr;
+    }
+
     namespace detail
     {
         void set_self_ptr(thread_self* self)
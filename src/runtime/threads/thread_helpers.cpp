@@ -449,6 +449,16 @@ namespace hpx { namespace this_thread
         threads::thread_self& self = threads::get_self();
         threads::thread_id_type id = threads::get_self_id();
 
+        // stackless threads run on the stack of the worker thread, nothing
+        // else could run on it while they are suspended
+        if (self.is_stackless())
+        {
+            HPX_THROWS_IF(ec, invalid_status, "suspend",
+                "stackless threads (thread_stacksize_nostack) can't be "
+                "suspended");
+            return threads::wait_unknown;
+        }
+
         // handle interruption, if needed
         threads::interruption_point(id, ec);
         if (ec) return threads::wait_unknown;
@@ -499,6 +509,15 @@ namespace hpx { namespace this_thread
         threads::thread_self& self = threads::get_self();
         threads::thread_id_type id = threads::get_self_id();
 
+        // stackless threads run on the stack of the worker thread
+        if (self.is_stackless())
+        {
+            HPX_THROWS_IF(ec, invalid_status, "suspend_at",
+                "stackless threads (thread_stacksize_nostack) can't be "
+                "suspended");
+            return threads::wait_unknown;
+        }
+
         // handle interruption, if needed
         threads::interruption_point(id, ec);
         if (ec) return threads::wait_unknown;
@@ -517,21 +536,19 @@ namespace hpx { namespace this_thread
 #ifdef HPX_HAVE_THREAD_BACKTRACE_ON_SUSPENSION
             detail::reset_backtrace bt(id, ec);
 #endif
-            threads::thread_id_type timer_id = threads::set_thread_state(id,
-                abs_time, threads::pending, threads::wait_timeout,
-                threads::thread_priority_boost, ec);
+            threads::detail::timer_entry_ptr timer =
+                threads::detail::set_thread_state_timer(
+                    *id->get_scheduler_base(), abs_time, id, threads::pending,
+                    threads::wait_timeout, threads::thread_priority_boost,
+                    std::size_t(-1), ec);
             if (ec) return threads::wait_unknown;
 
             // suspend the HPX-thread
             statex = self.yield(threads::suspended);
 
+            // make sure the timer does not fire anymore
             if (statex != threads::wait_timeout)
-            {
-                error_code ec1(lightweight);    // do not throw
-                threads::set_thread_state(timer_id,
-                    threads::pending, threads::wait_abort,
-                    threads::thread_priority_boost, ec1);
-            }
+                timer->cancel();
         }
 
         // handle interruption, if needed
@@ -11,8 +11,12 @@
 #include <hpx/performance_counters/counters.hpp>
 #include <hpx/performance_counters/counter_creators.hpp>
 #include <hpx/performance_counters/manage_counter_type.hpp>
+#include <hpx/performance_counters/sample_source.hpp>
 #include <hpx/runtime/threads/topology.hpp>
 #include <hpx/runtime/threads/threadmanager_impl.hpp>
+#if !defined(HPX_WINDOWS)
+#include <hpx/runtime/threads/coroutines/detail/stack_pool.hpp>
+#endif
 #include <hpx/runtime/threads/thread_data.hpp>
 #include <hpx/runtime/threads/thread_helpers.hpp>
 #include <hpx/runtime/threads/thread_init_data.hpp>
@@ -125,6 +129,7 @@ namespace hpx { namespace threads
             "medium",
             "large",
             "huge",
+            "nostack",
         };
     }
 
@@ -143,7 +148,7 @@ namespace hpx { namespace threads
         else if (rtcfg.get_stack_size(thread_stacksize_huge) == size)
             size = thread_stacksize_huge;
 
-        if (size < thread_stacksize_small || size > thread_stacksize_huge)
+        if (size < thread_stacksize_small || size > thread_stacksize_nostack)
             return "custom";
 
         return strings::stack_size_names[size-1];
@@ -759,6 +764,23 @@ namespace hpx { namespace threads
               util::bind(&coroutine_type::impl_type::get_stack_unbind_count, _1),
               util::function_nonser<boost::uint64_t(bool)>(), "", 0
             },
+#endif
+#if !defined(HPX_WINDOWS)
+            // /threads{locality#%d/total}/count/stacks-allocated
+            { "count/stacks-allocated",
+              &coroutines::detail::posix::get_stack_allocation_count,
+              util::function_nonser<boost::uint64_t(bool)>(), "", 0
+            },
+            // /threads{locality#%d/total}/count/stacks-reused
+            { "count/stacks-reused",
+              &coroutines::detail::posix::get_stack_reuse_count,
+              util::function_nonser<boost::uint64_t(bool)>(), "", 0
+            },
+            // /threads{locality#%d/total}/count/stacks-trimmed
+            { "count/stacks-trimmed",
+              &coroutines::detail::posix::get_stack_trim_count,
+              util::function_nonser<boost::uint64_t(bool)>(), "", 0
+            },
 #endif
             // /threads{locality#%d/total}/count/objects
             // /threads{locality#%d/allocator%d}/count/objects
@@ -822,6 +844,33 @@ namespace hpx { namespace threads
               util::bind(&spt::get_num_stolen_to_staged, &pool_,
                   static_cast<std::size_t>(paths.instanceindex_), _1),
               "worker-thread", shepherd_count
+            },
+            // /threads{locality#%d/total}/count/stolen-in-core
+            // /threads{locality#%d/worker-thread%d}/count/stolen-in-core
+            { "count/stolen-in-core",
+              util::bind(&spt::get_num_stolen_in_core, &pool_,
+                  std::size_t(-1), _1),
+              util::bind(&spt::get_num_stolen_in_core, &pool_,
+                  static_cast<std::size_t>(paths.instanceindex_), _1),
+              "worker-thread", shepherd_count
+            },
+            // /threads{locality#%d/total}/count/stolen-in-numa-domain
+            // /threads{locality#%d/worker-thread%d}/count/stolen-in-numa-domain
+            { "count/stolen-in-numa-domain",
+              util::bind(&spt::get_num_stolen_in_numa_domain, &pool_,
+                  std::size_t(-1), _1),
+              util::bind(&spt::get_num_stolen_in_numa_domain, &pool_,
+                  static_cast<std::size_t>(paths.instanceindex_), _1),
+              "worker-thread", shepherd_count
+            },
+            // /threads{locality#%d/total}/count/stolen-outside-numa-domain
+            // /threads{locality#%d/worker-thread%d}/count/stolen-outside-numa-domain
+            { "count/stolen-outside-numa-domain",
+              util::bind(&spt::get_num_stolen_outside_numa_domain, &pool_,
+                  std::size_t(-1), _1),
+              util::bind(&spt::get_num_stolen_outside_numa_domain, &pool_,
+                  static_cast<std::size_t>(paths.instanceindex_), _1),
+              "worker-thread", shepherd_count
             }
 #endif
         };
@@ -1023,6 +1072,28 @@ namespace hpx { namespace threads
               counts_creator, &performance_counters::locality_counter_discoverer,
               ""
             },
+#endif
+#if !defined(HPX_WINDOWS)
+            { "/threads/count/stacks-allocated", performance_counters::counter_raw,
+              "returns the total number of HPX-thread stacks newly taken from "
+              "mapped stack slabs by the stack pool for the referenced locality",
+              HPX_PERFORMANCE_COUNTER_V1,
+              counts_creator, &performance_counters::locality_counter_discoverer,
+              ""
+            },
+            { "/threads/count/stacks-reused", performance_counters::counter_raw,
+              "returns the total number of HPX-thread stacks reused by the "
+              "stack pool for the referenced locality", HPX_PERFORMANCE_COUNTER_V1,
+              counts_creator, &performance_counters::locality_counter_discoverer,
+              ""
+            },
+            { "/threads/count/stacks-trimmed", performance_counters::counter_raw,
+              "returns the total number of idle HPX-thread stacks whose memory "
+              "was returned to the operating system (madvise) by the stack pool "
+              "for the referenced locality", HPX_PERFORMANCE_COUNTER_V1,
+              counts_creator, &performance_counters::locality_counter_discoverer,
+              ""
+            },
 #endif
             { "/threads/count/objects", performance_counters::counter_raw,
               "returns the overall number of created HPX-thread objects for "
@@ -1075,11 +1146,47 @@ namespace hpx { namespace threads
               counts_creator,
               &performance_counters::locality_thread_counter_discoverer,
               ""
+            },
+            { "/threads/count/stolen-in-core", performance_counters::counter_raw,
+              "returns the overall number of HPX-threads and task descriptions "
+              "stolen by the referenced worker-thread from schedulers running "
+              "on the same core (hierarchical stealing only)",
+              HPX_PERFORMANCE_COUNTER_V1, counts_creator,
+              &performance_counters::locality_thread_counter_discoverer,
+              ""
+            },
+            { "/threads/count/stolen-in-numa-domain",
+              performance_counters::counter_raw,
+              "returns the overall number of HPX-threads and task descriptions "
+              "stolen by the referenced worker-thread from schedulers running "
+              "in the same NUMA domain (hierarchical stealing only)",
+              HPX_PERFORMANCE_COUNTER_V1, counts_creator,
+              &performance_counters::locality_thread_counter_discoverer,
+              ""
+            },
+            { "/threads/count/stolen-outside-numa-domain",
+              performance_counters::counter_raw,
+              "returns the overall number of HPX-threads and task descriptions "
+              "stolen by the referenced worker-thread from schedulers running "
+              "in a different NUMA domain (hierarchical stealing only)",
+              HPX_PERFORMANCE_COUNTER_V1, counts_creator,
+              &performance_counters::locality_thread_counter_discoverer,
+              ""
             }
 #endif
         };
         performance_counters::install_counter_types(
             counter_types, sizeof(counter_types)/sizeof(counter_types[0]));
+
+#ifdef HPX_HAVE_THREAD_IDLE_RATES
+        // the durations of the thread phases are recorded by the scheduling
+        // loop, use /statistics{...}/p99 etc. to query their distribution
+        performance_counters::install_sample_source(
+            "/threads/time/phase-duration", pool_.get_phase_durations(),
+            "returns the number of executed HPX-thread phases whose duration "
+            "[ns] has been recorded, use the percentile and histogram "
+            "statistics counters to query the distribution of the durations");
+#endif
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -1263,6 +1370,11 @@ template class HPX_EXPORT hpx::threads::threadmanager_impl<
     hpx::threads::policies::abp_fifo_priority_queue_scheduler>;
 #endif
 
+#if defined(HPX_HAVE_CHASE_LEV_SCHEDULER)
+template class HPX_EXPORT hpx::threads::threadmanager_impl<
+    hpx::threads::policies::chase_lev_priority_queue_scheduler>;
+#endif
+
 #if defined(HPX_HAVE_HIERARCHY_SCHEDULER)
 #include <hpx/runtime/threads/policies/hierarchy_scheduler.hpp>
 template class HPX_EXPORT hpx::threads::threadmanager_impl<
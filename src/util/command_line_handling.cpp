@@ -277,6 +277,17 @@ namespace hpx { namespace util
             return cfgmap.get_value<std::size_t>("hpx.numa_sensitive", default_);
         }
 
+        bool handle_hierarchical_stealing(util::manage_config& cfgmap,
+            boost::program_options::variables_map& vm, bool default_)
+        {
+            if (vm.count("hpx:hierarchical-stealing") != 0)
+                return true;
+
+            // use either cfgmap value or default
+            return cfgmap.get_value<int>("hpx.hierarchical_stealing",
+                default_ ? 1 : 0) != 0;
+        }
+
         ///////////////////////////////////////////////////////////////////////
         std::size_t handle_num_threads(util::manage_config& cfgmap,
             boost::program_options::variables_map& vm,
@@ -693,6 +704,11 @@ namespace hpx { namespace util
             affinity_bind_.empty() ? 0 : 1);
         ini_config += "hpx.numa_sensitive=" + std::to_string(numa_sensitive_);
 
+        hierarchical_stealing_ =
+            detail::handle_hierarchical_stealing(cfgmap, vm, false);
+        ini_config += std::string("hpx.hierarchical_stealing=") +
+            (hierarchical_stealing_ ? "1" : "0");
+
         // default affinity mode is now 'balanced'
         if (affinity_bind_.empty())
         {
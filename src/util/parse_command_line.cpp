@@ -450,7 +450,7 @@ namespace hpx { namespace util
                 ("hpx:queuing", value<std::string>(),
                   "the queue scheduling policy to use, options are "
                   "'local', 'local-priority', 'abp-priority', "
-                  "'hierarchy', 'static', 'static-priority', and "
+                  "'chase-lev-priority', 'hierarchy', 'static', 'static-priority', and "
                   "'periodic-priority' (default: 'local-priority'; "
                   "all option values can be abbreviated)")
                 ("hpx:hierarchy-arity", value<std::size_t>(),
@@ -460,12 +460,20 @@ namespace hpx { namespace util
                   "the number of operating system threads maintaining a high "
                   "priority queue (default: number of OS threads), valid for "
                   "--hpx:queuing=local-priority,--hpx:queuing=static-priority, "
+                  "--hpx:queuing=chase-lev-priority, "
                   " and --hpx:queuing=abp-priority only)")
                 ("hpx:numa-sensitive", value<std::size_t>()->implicit_value(0),
                   "makes the local-priority scheduler NUMA sensitive ("
                   "allowed values: 0 - no NUMA sensitivity, 1 - allow only for "
                   "boundary cores to steal across NUMA domains, 2 - "
                   "no cross boundary stealing is allowed (default value: 0)")
+                ("hpx:hierarchical-stealing",
+                  "makes idle worker threads steal work from threads running "
+                  "on the same core first, then from threads in the same NUMA "
+                  "domain, and only then from threads in other NUMA domains "
+                  "(respecting --hpx:numa-sensitive), valid for "
+                  "--hpx:queuing=local-priority, --hpx:queuing=abp-priority, "
+                  "and --hpx:queuing=chase-lev-priority only")
             ;
 
             options_description config_options("HPX configuration options");
@@ -552,6 +560,25 @@ namespace hpx { namespace util
                 ("hpx:reset-counters",
                   "reset the performance counter(s) specified with --hpx:print-counter "
                   "after they have been evaluated")
+                ("hpx:stream-counter",
+                    value<std::vector<std::string> >()->composing(),
+                  "sample the specified performance counter repeatedly and "
+                  "stream the values in binary form, every locality samples "
+                  "its local counters only "
+                  "(see option --hpx:stream-counter-interval)")
+                ("hpx:stream-counter-interval", value<std::size_t>(),
+                  "sample the performance counter(s) specified with "
+                  "--hpx:stream-counter after the time interval (specified in "
+                  "milliseconds) (default: 1)")
+                ("hpx:stream-counter-destination", value<std::string>(),
+                  "stream the performance counter(s) specified with "
+                  "--hpx:stream-counter to the given file or to "
+                  "'tcp://host:port', '{locality}' is replaced with the "
+                  "locality id (default: counters.{locality}.bin)")
+                ("hpx:stream-counter-downsample", value<std::size_t>(),
+                  "stream the average of the given number of consecutive "
+                  "samples of the performance counter(s) specified with "
+                  "--hpx:stream-counter (default: 1)")
             ;
 
             hidden_options.add_options()
@@ -47,6 +47,8 @@ namespace hpx { namespace util { namespace detail
         ~pool_timer();
 
         bool start(bool evaluate);
+        bool start(util::steady_clock::time_point const& abs_time,
+            bool evaluate);
         bool stop();
 
         bool is_started() const { return is_started_; }
@@ -147,6 +149,18 @@ namespace hpx { namespace util { namespace detail
         return false;
     }
 
+    bool pool_timer::start(util::steady_clock::time_point const& abs_time,
+        bool evaluate_)
+    {
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+            if (is_terminated_ || is_started_)
+                return false;
+            abs_time_ = abs_time;
+        }
+        return start(evaluate_);
+    }
+
     bool pool_timer::stop()
     {
         std::lock_guard<mutex_type> l(mtx_);
@@ -225,6 +239,12 @@ namespace hpx { namespace util
         return timer_->start(evaluate);
     }
 
+    bool pool_timer::start(hpx::util::steady_duration const& rel_time,
+        bool evaluate)
+    {
+        return timer_->start(rel_time.from_now(), evaluate);
+    }
+
     bool pool_timer::stop()
     {
         return timer_->stop();
@@ -9,6 +9,7 @@
 #include <hpx/config/defaults.hpp>
 // TODO: move parcel ports into plugins
 #include <hpx/runtime/parcelset/parcelhandler.hpp>
+#include <hpx/runtime/threads/coroutines/detail/stack_pool.hpp>
 #include <hpx/util/filesystem_compatibility.hpp>
 #include <hpx/util/find_prefix.hpp>
 #include <hpx/util/init_ini_data.hpp>
@@ -186,7 +187,11 @@ namespace hpx { namespace util
             "pu_step = 1",
             "pu_offset = 0",
             "numa_sensitive = 0",
+            "hierarchical_stealing = 0",
             "max_background_threads = ${MAX_BACKGROUND_THREADS:$[hpx.os_threads]}",
+            "max_idle_loop_count = ${HPX_MAX_IDLE_LOOP_COUNT:"
+                BOOST_PP_STRINGIZE(HPX_IDLE_LOOP_COUNT_MAX) "}",
+            "max_idle_backoff_time = ${HPX_MAX_IDLE_BACKOFF_TIME:1000}",
 
             // connect back to the given latch if specified
             "[hpx.on_startup]",
@@ -203,6 +208,8 @@ namespace hpx { namespace util
                 BOOST_PP_STRINGIZE(HPX_HUGE_STACK_SIZE) "}",
 #if defined(__linux) || defined(linux) || defined(__linux__) || defined(__FreeBSD__)
             "use_guard_pages = ${HPX_USE_GUARD_PAGES:1}",
+            "use_stack_pool = ${HPX_USE_STACK_POOL:1}",
+            "stack_pool_high_water_mark = ${HPX_STACK_POOL_HIGH_WATER_MARK:128}",
 #endif
 
             "[hpx.threadpools]",
@@ -466,6 +473,10 @@ namespace hpx { namespace util
 #if defined(__linux) || defined(linux) || defined(__linux__) || defined(__FreeBSD__)
         threads::coroutines::detail::posix::use_guard_pages =
             init_use_stack_guard_pages();
+        threads::coroutines::detail::posix::use_stack_pool =
+            init_use_stack_pool();
+        threads::coroutines::detail::posix::stack_pool_high_water_mark =
+            init_stack_pool_high_water_mark();
 #endif
 #ifdef HPX_HAVE_VERIFY_LOCKS
         if (enable_lock_detection())
@@ -527,6 +538,10 @@ namespace hpx { namespace util
 #if defined(__linux) || defined(linux) || defined(__linux__) || defined(__FreeBSD__)
         threads::coroutines::detail::posix::use_guard_pages =
             init_use_stack_guard_pages();
+        threads::coroutines::detail::posix::use_stack_pool =
+            init_use_stack_pool();
+        threads::coroutines::detail::posix::stack_pool_high_water_mark =
+            init_stack_pool_high_water_mark();
 #endif
 #ifdef HPX_HAVE_VERIFY_LOCKS
         if (enable_lock_detection())
@@ -918,6 +933,30 @@ namespace hpx { namespace util
         }
         return true;    // default is true
     }
+
+    bool runtime_configuration::init_use_stack_pool() const
+    {
+        if (has_section("hpx")) {
+            util::section const* sec = get_section("hpx.stacks");
+            if (nullptr != sec) {
+                return hpx::util::get_entry_as<int>(
+                    *sec, "use_stack_pool", "1") != 0;
+            }
+        }
+        return true;    // default is true
+    }
+
+    std::size_t runtime_configuration::init_stack_pool_high_water_mark() const
+    {
+        if (has_section("hpx")) {
+            util::section const* sec = get_section("hpx.stacks");
+            if (nullptr != sec) {
+                return hpx::util::get_entry_as<std::size_t>(
+                    *sec, "stack_pool_high_water_mark", "128");
+            }
+        }
+        return 128;
+    }
 #endif
 
     std::ptrdiff_t runtime_configuration::init_small_stack_size() const
@@ -1011,6 +1050,11 @@ namespace hpx { namespace util
         case threads::thread_stacksize_huge:
             return huge_stacksize;
 
+        // stackless threads don't allocate a stack, they are identified by
+        // the enumerator itself
+        case threads::thread_stacksize_nostack:
+            return std::ptrdiff_t(threads::thread_stacksize_nostack);
+
         default:
         case threads::thread_stacksize_small:
             break;
@@ -0,0 +1,661 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/performance_counters/counters.hpp>
+#include <hpx/performance_counters/server/base_performance_counter.hpp>
+#include <hpx/performance_counters/stubs/performance_counter.hpp>
+#include <hpx/runtime/agas/interface.hpp>
+#include <hpx/runtime/get_lva.hpp>
+#include <hpx/runtime/naming/name.hpp>
+#include <hpx/runtime_fwd.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/bind.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+#include <hpx/util/logging.hpp>
+#include <hpx/util/runtime_configuration.hpp>
+#include <hpx/util/stream_counters.hpp>
+#include <hpx/util/unlock_guard.hpp>
+
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/exception_ptr.hpp>
+#include <boost/format.hpp>
+#include <boost/thread/locks.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace util
+{
+    namespace
+    {
+        char const stream_magic[] = { 'H', 'P', 'X', 'C' };
+        char const stream_version = 1;
+
+        void encode_unsigned(std::vector<char>& buffer, boost::uint64_t value)
+        {
+            while (value >= 0x80)
+            {
+                buffer.push_back(static_cast<char>((value & 0x7f) | 0x80));
+                value >>= 7;
+            }
+            buffer.push_back(static_cast<char>(value));
+        }
+
+        void encode_signed(std::vector<char>& buffer, boost::int64_t value)
+        {
+            encode_unsigned(buffer, (static_cast<boost::uint64_t>(value) << 1) ^
+                static_cast<boost::uint64_t>(value >> 63));
+        }
+
+        void encode_string(std::vector<char>& buffer, std::string const& s)
+        {
+            encode_unsigned(buffer, s.size());
+            buffer.insert(buffer.end(), s.begin(), s.end());
+        }
+
+        bool decode_unsigned(std::istream& in, boost::uint64_t& value)
+        {
+            value = 0;
+            for (int shift = 0; shift < 64; shift += 7)
+            {
+                int c = in.get();
+                if (c == EOF)
+                    return false;
+
+                value |= static_cast<boost::uint64_t>(c & 0x7f) << shift;
+                if (!(c & 0x80))
+                    return true;
+            }
+            return false;
+        }
+
+        bool decode_signed(std::istream& in, boost::int64_t& value)
+        {
+            boost::uint64_t v = 0;
+            if (!decode_unsigned(in, v))
+                return false;
+
+            value = static_cast<boost::int64_t>(v >> 1) ^
+                -static_cast<boost::int64_t>(v & 1);
+            return true;
+        }
+
+        bool decode_string(std::istream& in, std::string& s)
+        {
+            boost::uint64_t size = 0;
+            if (!decode_unsigned(in, size))
+                return false;
+
+            s.resize(static_cast<std::size_t>(size));
+            return size == 0 ||
+                in.read(&s[0], static_cast<std::streamsize>(size));
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    stream_counters::stream_counters(std::vector<std::string> const& names,
+            boost::int64_t interval, std::string const& dest,
+            std::size_t downsample, std::size_t buffer_size)
+      : names_(names), destination_(dest), header_written_(false),
+        running_(false),
+        downsample_((std::max)(downsample, std::size_t(1))),
+        buffer_size_((std::max)(buffer_size, std::size_t(1))),
+        num_accumulated_(0),
+        ring_capacity_(4 * buffer_size_), ring_head_(0), ring_count_(0),
+        dropped_(0), flush_requested_(false), stop_requested_(false),
+        interval_(interval),
+        timer_(util::bind(&stream_counters::evaluate, this_()),
+            util::bind(&stream_counters::terminate, this_()),
+            interval*1000, "stream_counters", true)
+    {
+        // add counter prefix, if necessary
+        for (std::string& name : names_)
+            performance_counters::ensure_counter_prefix(name);
+    }
+
+    stream_counters::~stream_counters()
+    {
+        // stop was not called, don't leave the writer thread running
+        if (writer_.joinable())
+            stop_writer();
+    }
+
+    bool stream_counters::find_counter(
+        performance_counters::counter_info const& info, error_code& ec)
+    {
+        // only the counters located on this locality are sampled
+        boost::uint32_t const locality_id =
+            naming::get_locality_id_from_gid(hpx::get_locality());
+
+        performance_counters::counter_path_elements p;
+        performance_counters::get_counter_path_elements(info.fullname_, p, ec);
+        if (ec) return false;
+
+        if (p.parentinstancename_ == "locality" &&
+            p.parentinstanceindex_ != static_cast<boost::int64_t>(locality_id))
+        {
+            return true;
+        }
+
+        // array valued and text counters can't be streamed
+        if (info.type_ == performance_counters::counter_histogram ||
+            info.type_ == performance_counters::counter_text)
+        {
+            return true;
+        }
+
+        naming::id_type id =
+            performance_counters::get_counter(info.fullname_, ec);
+        if (HPX_UNLIKELY(!id))
+        {
+            HPX_THROWS_IF(ec, bad_parameter,
+                "stream_counters::find_counter",
+                boost::str(boost::format(
+                    "unknown performance counter: '%1%' (%2%)") %
+                    info.fullname_ % ec.get_message()));
+            return false;
+        }
+
+        if (naming::get_locality_id_from_id(id) != locality_id)
+            return true;
+
+        names_.push_back(info.fullname_);
+        ids_.push_back(id);
+        uoms_.push_back(info.unit_of_measure_);
+
+        return true;
+    }
+
+    void stream_counters::find_counters()
+    {
+        std::unique_lock<mutex_type> l(mtx_);
+
+        std::vector<std::string> names;
+        std::swap(names, names_);
+
+        names_.reserve(names.size());
+        if (ids_.empty())
+        {
+            using util::placeholders::_1;
+            using util::placeholders::_2;
+
+            performance_counters::discover_counter_func func(
+                util::bind(&stream_counters::find_counter, this, _1, _2));
+
+            ids_.reserve(names.size());
+            uoms_.reserve(names.size());
+            for (std::string& name : names)
+            {
+                // do INI expansion on counter name
+                util::expand(name);
+
+                // find matching counter type
+                {
+                    hpx::util::unlock_guard<std::unique_lock<mutex_type> >
+                        ul(l);
+                    performance_counters::discover_counter_type(name, func,
+                        performance_counters::discover_counters_full);
+                }
+            }
+        }
+
+        // the counters are local and kept alive by their ids, access them
+        // directly
+        counters_.reserve(ids_.size());
+        for (naming::id_type const& id : ids_)
+        {
+            naming::address addr;
+            {
+                hpx::util::unlock_guard<std::unique_lock<mutex_type> > ul(l);
+                addr = agas::resolve(id).get();
+            }
+            counters_.push_back(get_lva<counter_type>::call(addr.address_));
+        }
+
+        HPX_ASSERT(ids_.size() == names_.size());
+        HPX_ASSERT(ids_.size() == uoms_.size());
+        HPX_ASSERT(ids_.size() == counters_.size());
+    }
+
+    void stream_counters::resolve_destination()
+    {
+        // every locality writes its own stream, '{locality}' is replaced
+        // with the id of this locality
+        util::expand(destination_);
+
+        std::string::size_type pos = destination_.find("{locality}");
+        if (pos != std::string::npos)
+        {
+            destination_.replace(pos, 10, std::to_string(
+                naming::get_locality_id_from_gid(hpx::get_locality())));
+        }
+
+        if (destination_.compare(0, 6, "tcp://") == 0 &&
+            destination_.find_last_of(':') == 3)
+        {
+            HPX_THROW_EXCEPTION(bad_parameter,
+                "stream_counters::resolve_destination",
+                boost::str(boost::format(
+                    "missing port in counter stream destination: '%1%'") %
+                    destination_));
+        }
+    }
+
+    // This is executed by the writer thread, connecting to a TCP destination
+    // may take a while.
+    void stream_counters::open_destination()
+    {
+        if (destination_.compare(0, 6, "tcp://") == 0)
+        {
+            std::string::size_type colon = destination_.find_last_of(':');
+
+            std::unique_ptr<boost::asio::ip::tcp::iostream> s(
+                new boost::asio::ip::tcp::iostream(
+                    destination_.substr(6, colon - 6),
+                    destination_.substr(colon + 1)));
+            if (!*s)
+            {
+                HPX_THROW_EXCEPTION(bad_parameter,
+                    "stream_counters::open_destination",
+                    boost::str(boost::format(
+                        "could not connect to counter stream destination: "
+                        "'%1%'") % destination_));
+                return;
+            }
+            stream_ = std::move(s);
+        }
+        else
+        {
+            std::unique_ptr<std::ofstream> s(new std::ofstream(
+                destination_.c_str(),
+                std::ios_base::out | std::ios_base::binary |
+                    std::ios_base::trunc));
+            if (!*s)
+            {
+                HPX_THROW_EXCEPTION(bad_parameter,
+                    "stream_counters::open_destination",
+                    boost::str(boost::format(
+                        "could not open counter stream destination: '%1%'") %
+                        destination_));
+                return;
+            }
+            stream_ = std::move(s);
+        }
+    }
+
+    void stream_counters::start()
+    {
+        find_counters();
+
+        for (std::size_t i = 0; i != ids_.size(); ++i)
+        {
+            // start the performance counter
+            using performance_counters::stubs::performance_counter;
+            performance_counter::start(ids_[i]);
+        }
+
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+            resolve_destination();
+
+            std::size_t const sample_size = counters_.size() + 1;
+            accumulated_.assign(sample_size, 0);
+            last_values_.assign(counters_.size(), 0);
+            last_sample_.assign(sample_size, 0);
+            ring_.assign(ring_capacity_ * sample_size, 0);
+
+            // the writer thread opens the destination
+            writer_ = boost::thread(&stream_counters::writer_main, this);
+            running_ = true;
+        }
+
+        // this will invoke the evaluate function for the first time
+        timer_.start();
+    }
+
+    void stream_counters::stop()
+    {
+        timer_.stop();
+
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+            if (!running_)
+                return;
+            running_ = false;
+        }
+
+        // this waits for the buffered samples to be written
+        stop_writer();
+
+        if (dropped_ != 0)
+        {
+            LPCS_(warning) << "stream_counters: dropped " << dropped_
+                << " samples, the destination could not keep up: "
+                << destination_;
+        }
+
+        if (writer_error_)
+            boost::rethrow_exception(writer_error_);
+    }
+
+    void stream_counters::stop_writer()
+    {
+        {
+            boost::lock_guard<boost::mutex> l(ring_mtx_);
+            stop_requested_ = true;
+        }
+        ring_cond_.notify_one();
+
+        writer_.join();
+    }
+
+    void stream_counters::terminate()
+    {
+        flush();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    bool stream_counters::evaluate()
+    {
+        std::unique_lock<mutex_type> l(mtx_);
+
+        if (!running_)
+            return false;
+
+        std::size_t const count = counters_.size();
+        bool const first = scaling_.empty();
+
+        accumulated_[0] = static_cast<boost::int64_t>(
+            util::high_resolution_clock::now());
+        for (std::size_t i = 0; i != count; ++i)
+        {
+            performance_counters::counter_value value =
+                counters_[i]->get_counter_value_nonvirt(false);
+
+            if (first)
+            {
+                scaling_.push_back(value.scaling_);
+                scale_inverse_.push_back(value.scale_inverse_);
+            }
+
+            if (performance_counters::status_is_valid(value.status_))
+                last_values_[i] = value.value_;
+
+            accumulated_[i + 1] += last_values_[i];
+        }
+
+        if (++num_accumulated_ != downsample_)
+            return true;
+
+        return push_sample();
+    }
+
+    // Store the average of the accumulated samples in the ring buffer, this
+    // never waits for the writer thread.
+    bool stream_counters::push_sample()
+    {
+        std::size_t const sample_size = accumulated_.size();
+        bool notify = false;
+
+        {
+            boost::lock_guard<boost::mutex> l(ring_mtx_);
+
+            if (writer_error_)
+                return false;           // the writer thread has given up
+
+            if (!header_written_)
+                write_header(header_);
+
+            if (ring_count_ == ring_capacity_)
+            {
+                ++dropped_;
+            }
+            else
+            {
+                std::size_t const pos =
+                    ((ring_head_ + ring_count_) % ring_capacity_) *
+                        sample_size;
+
+                ring_[pos] = accumulated_[0];
+                for (std::size_t i = 1; i != sample_size; ++i)
+                {
+                    ring_[pos + i] = accumulated_[i] /
+                        static_cast<boost::int64_t>(downsample_);
+                }
+                notify = ++ring_count_ == buffer_size_;
+            }
+        }
+
+        for (std::size_t i = 1; i != sample_size; ++i)
+            accumulated_[i] = 0;
+        num_accumulated_ = 0;
+
+        if (notify)
+            ring_cond_.notify_one();
+
+        return true;
+    }
+
+    void stream_counters::flush()
+    {
+        {
+            boost::lock_guard<boost::mutex> l(ring_mtx_);
+            flush_requested_ = true;
+        }
+        ring_cond_.notify_one();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void stream_counters::writer_main()
+    {
+        try {
+            open_destination();
+        }
+        catch (...) {
+            boost::lock_guard<boost::mutex> l(ring_mtx_);
+            writer_error_ = boost::current_exception();
+            return;
+        }
+
+        std::size_t const sample_size = last_sample_.size();
+
+        std::vector<char> buffer;
+        std::vector<boost::int64_t> samples;
+        samples.reserve(ring_.size());
+
+        boost::unique_lock<boost::mutex> l(ring_mtx_);
+        for (;;)
+        {
+            while (!stop_requested_ && !flush_requested_ &&
+                ring_count_ < buffer_size_)
+            {
+                ring_cond_.wait(l);
+            }
+
+            bool const stop = stop_requested_;
+            bool const flush = stop || flush_requested_;
+            flush_requested_ = false;
+
+            // drain the ring buffer
+            buffer.clear();
+            buffer.swap(header_);
+
+            samples.clear();
+            for (std::size_t n = 0; n != ring_count_; ++n)
+            {
+                std::size_t const pos =
+                    ((ring_head_ + n) % ring_capacity_) * sample_size;
+                samples.insert(samples.end(), ring_.begin() + pos,
+                    ring_.begin() + pos + sample_size);
+            }
+            ring_head_ = (ring_head_ + ring_count_) % ring_capacity_;
+            ring_count_ = 0;
+
+            // write without holding the lock
+            bool good = true;
+            {
+                util::unlock_guard<boost::unique_lock<boost::mutex> > ul(l);
+
+                write_samples(buffer, samples);
+                if (!buffer.empty())
+                {
+                    stream_->write(buffer.data(),
+                        static_cast<std::streamsize>(buffer.size()));
+                }
+                if (flush)
+                    stream_->flush();
+
+                good = static_cast<bool>(*stream_);
+                if (stop)
+                    stream_.reset();
+            }
+
+            if (!good)
+            {
+                writer_error_ = HPX_GET_EXCEPTION(bad_parameter,
+                    "stream_counters::writer_main",
+                    boost::str(boost::format(
+                        "could not write to counter stream destination: "
+                        "'%1%'") % destination_));
+                stream_.reset();
+                return;
+            }
+
+            if (stop)
+                return;
+        }
+    }
+
+    void stream_counters::write_header(std::vector<char>& buffer)
+    {
+        buffer.insert(buffer.end(), stream_magic,
+            stream_magic + sizeof(stream_magic));
+        buffer.push_back(stream_version);
+
+        encode_unsigned(buffer,
+            naming::get_locality_id_from_gid(hpx::get_locality()));
+        encode_unsigned(buffer,
+            static_cast<boost::uint64_t>(interval_) * 1000000);
+        encode_unsigned(buffer, downsample_);
+
+        encode_unsigned(buffer, counters_.size());
+        for (std::size_t i = 0; i != counters_.size(); ++i)
+        {
+            encode_string(buffer, names_[i]);
+            encode_string(buffer, uoms_[i]);
+            encode_signed(buffer, scaling_[i]);
+            buffer.push_back(scale_inverse_[i] ? 1 : 0);
+        }
+
+        header_written_ = true;
+    }
+
+    void stream_counters::write_samples(std::vector<char>& buffer,
+        std::vector<boost::int64_t> const& samples)
+    {
+        if (samples.empty())
+            return;
+
+        std::size_t const sample_size = last_sample_.size();
+        std::size_t const num_samples = samples.size() / sample_size;
+
+        // most deltas fit into a single byte
+        buffer.reserve(buffer.size() + samples.size() + 10);
+
+        encode_unsigned(buffer, num_samples);
+        for (std::size_t i = 0; i != samples.size(); ++i)
+        {
+            std::size_t const j = i % sample_size;
+            encode_signed(buffer, samples[i] - last_sample_[j]);
+            last_sample_[j] = samples[i];
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    bool read_counter_stream(std::istream& in, counter_time_series& data)
+    {
+        char magic[sizeof(stream_magic)];
+        if (!in.read(magic, sizeof(magic)) ||
+            !std::equal(magic, magic + sizeof(magic), stream_magic))
+        {
+            return false;
+        }
+
+        if (in.get() != stream_version)
+            return false;
+
+        boost::uint64_t locality_id = 0, interval = 0, downsample = 0;
+        boost::uint64_t count = 0;
+        if (!decode_unsigned(in, locality_id) ||
+            !decode_unsigned(in, interval) ||
+            !decode_unsigned(in, downsample) ||
+            !decode_unsigned(in, count))
+        {
+            return false;
+        }
+
+        data.locality_id_ = static_cast<boost::uint32_t>(locality_id);
+        data.interval_ = static_cast<boost::int64_t>(interval);
+        data.downsample_ = static_cast<std::size_t>(downsample);
+
+        data.names_.resize(static_cast<std::size_t>(count));
+        data.uoms_.resize(static_cast<std::size_t>(count));
+        data.scaling_.resize(static_cast<std::size_t>(count));
+        data.scale_inverse_.resize(static_cast<std::size_t>(count));
+        for (std::size_t i = 0; i != count; ++i)
+        {
+            if (!decode_string(in, data.names_[i]) ||
+                !decode_string(in, data.uoms_[i]) ||
+                !decode_signed(in, data.scaling_[i]))
+            {
+                return false;
+            }
+
+            int scale_inverse = in.get();
+            if (scale_inverse == EOF)
+                return false;
+            data.scale_inverse_[i] = scale_inverse != 0;
+        }
+
+        data.timestamps_.clear();
+        data.values_.clear();
+
+        std::vector<boost::int64_t> last(
+            static_cast<std::size_t>(count) + 1, 0);
+        while (in.peek() != EOF)
+        {
+            boost::uint64_t num_samples = 0;
+            if (!decode_unsigned(in, num_samples))
+                return false;
+
+            for (std::size_t n = 0; n != num_samples; ++n)
+            {
+                for (boost::int64_t& value : last)
+                {
+                    boost::int64_t delta = 0;
+                    if (!decode_signed(in, delta))
+                        return false;
+                    value += delta;
+                }
+
+                data.timestamps_.push_back(last[0]);
+                data.values_.push_back(
+                    std::vector<boost::int64_t>(last.begin() + 1, last.end()));
+            }
+        }
+
+        return true;
+    }
+}}
@@ -11,9 +11,12 @@
 #include <hpx/hpx.hpp>
 #include <hpx/hpx_init.hpp>
 
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/runtime/agas/detail/gva_cache.hpp>
 #include <hpx/util/cache/entries/lfu_entry.hpp>
 #include <hpx/util/cache/local_cache.hpp>
 #include <hpx/util/cache/statistics/local_full_statistics.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
 #include <hpx/util/histogram.hpp>
 
 #include <boost/cstdint.hpp>
@@ -24,6 +27,7 @@
 #include <algorithm>
 #include <iostream>
 #include <map>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -213,6 +217,100 @@ void test_update(gva_cache_type& cache, hpx::naming::gid_type first_key)
     calculate_histogram("update", timings);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// Measure the lookup throughput of the original (single lock) cache and of the
+// sharded cache used by the addressing_service for an increasing number of
+// concurrently looking up threads.
+double lookup_throughput(std::size_t num_threads, std::size_t num_lookups,
+    std::size_t num_entries, hpx::util::function_nonser<void(std::size_t)> f)
+{
+    std::vector<hpx::future<void> > lookups;
+    lookups.reserve(num_threads);
+
+    hpx::util::high_resolution_timer t;
+
+    for (std::size_t i = 0; i != num_threads; ++i)
+    {
+        lookups.push_back(hpx::async(
+            [=]()
+            {
+                for (std::size_t j = 0; j != num_lookups; ++j)
+                    f((i * num_lookups + j) % num_entries);
+            }));
+    }
+    hpx::wait_all(lookups);
+
+    return (num_threads * num_lookups) / t.elapsed();
+}
+
+void test_lookup_scaling(std::size_t cache_size, std::size_t num_entries,
+    std::size_t num_lookups)
+{
+    hpx::naming::gid_type locality = hpx::get_locality();
+    boost::uint32_t ct = hpx::components::component_invalid;
+
+    // original cache, protected by a single lock
+    typedef hpx::lcos::local::spinlock mutex_type;
+    mutex_type mtx;
+    gva_cache_type locked_cache;
+    locked_cache.reserve(cache_size);
+
+    // sharded cache
+    hpx::agas::detail::gva_cache sharded_cache(
+        2 * hpx::get_os_thread_count());
+    sharded_cache.reserve(cache_size);
+
+    std::vector<hpx::naming::gid_type> keys;
+    keys.reserve(num_entries);
+    for (std::size_t i = 0; i != num_entries; ++i)
+    {
+        keys.push_back(hpx::detail::get_next_id());
+
+        hpx::agas::gva value(locality, ct, 1, boost::uint64_t(i), 0);
+        locked_cache.insert(gva_cache_key(keys.back(), 1), value);
+
+        hpx::naming::gid_type old_gid;
+        boost::uint64_t old_count = 0;
+        sharded_cache.update_if(keys.back(), 1, value, old_gid, old_count);
+    }
+
+    std::cout << "threads, locked [lookups/s], sharded [lookups/s]"
+              << std::endl;
+
+    std::size_t num_os_threads = hpx::get_os_thread_count();
+    std::vector<std::size_t> thread_counts;
+    for (std::size_t n = 1; n < num_os_threads; n *= 2)
+        thread_counts.push_back(n);
+    thread_counts.push_back(num_os_threads);
+
+    for (std::size_t num_threads : thread_counts)
+    {
+        double locked = lookup_throughput(num_threads, num_lookups,
+            num_entries,
+            [&](std::size_t i)
+            {
+                gva_cache_key idbase;
+                gva_cache_type::entry_type e;
+
+                std::lock_guard<mutex_type> l(mtx);
+                locked_cache.get_entry(gva_cache_key(keys[i], 1), idbase, e);
+            });
+
+        double sharded = lookup_throughput(num_threads, num_lookups,
+            num_entries,
+            [&](std::size_t i)
+            {
+                hpx::naming::gid_type idbase;
+                hpx::agas::gva g;
+
+                sharded_cache.get_entry(keys[i], idbase, g);
+            });
+
+        std::cout << num_threads << ", " << locked << ", " << sharded
+                  << std::endl;
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int hpx_main(boost::program_options::variables_map& vm)
 {
@@ -233,6 +331,12 @@ int hpx_main(boost::program_options::variables_map& vm)
     test_get(cache, first_key);
     test_update(cache, first_key);
 
+    std::size_t num_lookups = 100000;
+    if (vm.count("num_lookups"))
+        num_lookups = vm["num_lookups"].as<std::size_t>();
+
+    test_lookup_scaling(cache_size, num_entries, num_lookups);
+
     return hpx::finalize();
 }
 
@@ -248,6 +352,9 @@ int main(int argc, char* argv[])
          BOOST_PP_STRINGIZE(HPX_AGAS_LOCAL_CACHE_SIZE_PER_THREAD) ")")
         ("num_entries,n", value<std::size_t>(),
          "number of items to insert into cache (default: 1000)")
+        ("num_lookups", value<std::size_t>(),
+         "number of lookups per thread for measuring the lookup throughput "
+         "(default: 100000)")
         ;
 
     // Initialize and run HPX
@@ -0,0 +1,248 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This benchmark measures the throughput of migrate_to_storage and
+// migrate_from_storage for many small and for a few large components, both
+// for the in-memory component_storage and for the persistent (memory mapped)
+// one.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/actions.hpp>
+#include <hpx/include/component_storage.hpp>
+#include <hpx/include/components.hpp>
+#include <hpx/include/iostreams.hpp>
+#include <hpx/include/serialization.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+
+#include <boost/cstdint.hpp>
+
+#include <cstddef>
+#include <cstdio>
+#include <iomanip>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+struct payload_server
+  : hpx::components::migration_support<
+        hpx::components::simple_component_base<payload_server>
+    >
+{
+    payload_server() {}
+    payload_server(std::size_t size) : data_(size, 'x') {}
+
+    payload_server(payload_server const& rhs) : data_(rhs.data_) {}
+    payload_server(payload_server && rhs) : data_(std::move(rhs.data_)) {}
+
+    payload_server& operator=(payload_server const& rhs)
+    {
+        data_ = rhs.data_;
+        return *this;
+    }
+    payload_server& operator=(payload_server && rhs)
+    {
+        data_ = std::move(rhs.data_);
+        return *this;
+    }
+
+    template <typename Archive>
+    void serialize(Archive& ar, unsigned version)
+    {
+        ar & data_;
+    }
+
+    std::vector<char> data_;
+};
+
+typedef hpx::components::simple_component<payload_server> server_type;
+HPX_REGISTER_COMPONENT(server_type, payload_server);
+
+///////////////////////////////////////////////////////////////////////////////
+struct result
+{
+    double to_storage_;         // [components/s]
+    double from_storage_;       // [components/s]
+    double bytes_;              // number of bytes migrated
+    double to_storage_time_;    // [s]
+    double from_storage_time_;  // [s]
+};
+
+// Migrate count components of the given size to the storage and back,
+// returns the average throughput of test_count runs.
+result measure(hpx::components::component_storage const& storage,
+    std::size_t count, std::size_t size, int test_count)
+{
+    hpx::id_type here = hpx::find_here();
+
+    boost::uint64_t to_storage = 0;
+    boost::uint64_t from_storage = 0;
+    for (int i = 0; i != test_count; ++i)
+    {
+        std::vector<hpx::id_type> ids;
+        ids.reserve(count);
+        {
+            std::vector<hpx::future<hpx::id_type> > objects;
+            objects.reserve(count);
+            for (std::size_t j = 0; j != count; ++j)
+                objects.push_back(hpx::new_<payload_server>(here, size));
+
+            for (hpx::future<hpx::id_type>& f : objects)
+                ids.push_back(f.get());
+        }
+
+        std::vector<hpx::future<hpx::id_type> > migrated;
+        migrated.reserve(count);
+
+        boost::uint64_t start = hpx::util::high_resolution_clock::now();
+        for (hpx::id_type const& id : ids)
+        {
+            migrated.push_back(
+                hpx::components::migrate_to_storage<payload_server>(
+                    id, storage.get_id()));
+        }
+        hpx::wait_all(migrated);
+        to_storage += hpx::util::high_resolution_clock::now() - start;
+
+        migrated.clear();
+
+        start = hpx::util::high_resolution_clock::now();
+        for (hpx::id_type const& id : ids)
+        {
+            migrated.push_back(
+                hpx::components::migrate_from_storage<payload_server>(id));
+        }
+        hpx::wait_all(migrated);
+        from_storage += hpx::util::high_resolution_clock::now() - start;
+
+        // the resurrected components are released here
+    }
+
+    double total = double(test_count) * double(count);
+
+    result r;
+    r.to_storage_time_ = to_storage / 1e9;
+    r.from_storage_time_ = from_storage / 1e9;
+    r.to_storage_ = total / r.to_storage_time_;
+    r.from_storage_ = total / r.from_storage_time_;
+    r.bytes_ = total * double(size);
+    return r;
+}
+
+void print_result(char const* storage, char const* workload, result const& r,
+    bool csvoutput)
+{
+    double const mb = 1024. * 1024.;
+    if (csvoutput)
+    {
+        hpx::cout << storage << "," << workload
+            << "," << r.to_storage_
+            << "," << r.bytes_ / mb / r.to_storage_time_
+            << "," << r.from_storage_
+            << "," << r.bytes_ / mb / r.from_storage_time_
+            << "\n" << hpx::flush;
+    }
+    else
+    {
+        hpx::cout << std::left << std::setw(12) << storage
+            << std::setw(10) << workload
+            << std::right << std::setw(16) << r.to_storage_
+            << std::setw(12) << r.bytes_ / mb / r.to_storage_time_
+            << std::setw(16) << r.from_storage_
+            << std::setw(12) << r.bytes_ / mb / r.from_storage_time_
+            << "\n" << hpx::flush;
+    }
+}
+
+void run(char const* name, hpx::components::component_storage const& storage,
+    boost::program_options::variables_map& vm, bool csvoutput)
+{
+    int test_count = vm["test_count"].as<int>();
+
+    print_result(name, "small", measure(storage,
+            vm["num_small"].as<std::size_t>(),
+            vm["small_size"].as<std::size_t>(), test_count),
+        csvoutput);
+    print_result(name, "large", measure(storage,
+            vm["num_large"].as<std::size_t>(),
+            vm["large_size"].as<std::size_t>(), test_count),
+        csvoutput);
+}
+
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    bool csvoutput = vm["csv_output"].as<int>() ? true : false;
+    std::string path = vm["storage_file"].as<std::string>();
+
+    if (vm["test_count"].as<int>() <= 0) {
+        hpx::cout << "test_count cannot be less than zero...\n" << hpx::flush;
+        return hpx::finalize();
+    }
+
+    if (!csvoutput) {
+        hpx::cout << std::left << std::setw(12) << "storage"
+            << std::setw(10) << "workload"
+            << std::right << std::setw(16) << "to [objects/s]"
+            << std::setw(12) << "to [MB/s]"
+            << std::setw(16) << "from [objects/s]"
+            << std::setw(12) << "from [MB/s]" << "\n" << hpx::flush;
+    }
+
+    {
+        hpx::components::component_storage storage(hpx::find_here());
+        run("memory", storage, vm, csvoutput);
+    }
+
+    {
+        // start with an empty log
+        std::remove(path.c_str());
+
+        hpx::components::component_storage storage(hpx::find_here(), path);
+        run("persistent", storage, vm, csvoutput);
+    }
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    boost::program_options::options_description cmdline(
+        "usage: " HPX_APPLICATION_STRING " [options]");
+
+    cmdline.add_options()
+        ("num_small"
+        , boost::program_options::value<std::size_t>()->default_value(10000)
+        , "number of small components to migrate")
+
+        ("small_size"
+        , boost::program_options::value<std::size_t>()->default_value(64)
+        , "size of the payload of the small components [bytes]")
+
+        ("num_large"
+        , boost::program_options::value<std::size_t>()->default_value(16)
+        , "number of large components to migrate")
+
+        ("large_size"
+        , boost::program_options::value<std::size_t>()->default_value(
+            16 * 1024 * 1024)
+        , "size of the payload of the large components [bytes]")
+
+        ("storage_file"
+        , boost::program_options::value<std::string>()->default_value(
+            "component_storage_throughput.log")
+        , "file used by the persistent component storage")
+
+        ("csv_output"
+        , boost::program_options::value<int>()->default_value(0)
+        , "print results in csv format")
+
+        ("test_count"
+        , boost::program_options::value<int>()->default_value(5)
+        , "number of tests to take average from")
+        ;
+
+    return hpx::init(cmdline, argc, argv);
+}
@@ -6,12 +6,14 @@
 // TODO: Update
 
 #include <hpx/hpx_init.hpp>
+#include <hpx/lcos/wait_all.hpp>
 #include <hpx/lcos/wait_each.hpp>
 #include <hpx/runtime/actions/plain_action.hpp>
 #include <hpx/runtime/actions/continuation.hpp>
 #include <hpx/util/high_resolution_timer.hpp>
 #include <hpx/include/async.hpp>
 #include <hpx/include/iostreams.hpp>
+#include <hpx/include/local_lcos.hpp>
 
 #include <stdexcept>
 #include <vector>
@@ -121,6 +123,54 @@ void measure_function_futures(boost::uint64_t count, bool csv)
               << flush;
 }
 
+// every future has continuations_per_future continuations attached before it
+// becomes ready
+void measure_future_continuations(boost::uint64_t count,
+    boost::uint64_t continuations_per_future, bool csv)
+{
+    std::vector<hpx::lcos::local::promise<double> > promises(count);
+
+    std::vector<future<void> > continuations;
+    continuations.reserve(count * continuations_per_future);
+
+    // start the clock
+    high_resolution_timer walltime;
+
+    for (boost::uint64_t i = 0; i < count; ++i)
+    {
+        hpx::shared_future<double> f = promises[i].get_future();
+        for (boost::uint64_t j = 0; j < continuations_per_future; ++j)
+        {
+            continuations.push_back(f.then(hpx::launch::sync,
+                [](hpx::shared_future<double> && r)
+                {
+                    global_scratch += r.get();
+                }));
+        }
+    }
+
+    for (boost::uint64_t i = 0; i < count; ++i)
+        promises[i].set_value(null_function());
+
+    hpx::wait_all(continuations);
+
+    // stop the clock
+    const double duration = walltime.elapsed();
+
+    if (csv)
+        cout << ( boost::format("%1%,%2%\n")
+                % count
+                % duration)
+              << flush;
+    else
+        cout << ( boost::format("invoked %1% futures (%2% continuations "
+                    "each) in %3% seconds\n")
+                % count
+                % continuations_per_future
+                % duration)
+              << flush;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int hpx_main(
     variables_map& vm
@@ -136,6 +186,8 @@ int hpx_main(
 
         measure_action_futures(count, vm.count("csv") != 0);
         measure_function_futures(count, vm.count("csv") != 0);
+        measure_future_continuations(count,
+            vm["continuations"].as<boost::uint64_t>(), vm.count("csv") != 0);
     }
 
     finalize();
@@ -156,6 +208,10 @@ int main(
         , value<boost::uint64_t>()->default_value(500000)
         , "number of futures to invoke")
 
+        ( "continuations"
+        , value<boost::uint64_t>()->default_value(2)
+        , "number of continuations attached to each future")
+
         ( "delay-iterations"
         , value<boost::uint64_t>()->default_value(0)
         , "number of iterations in the delay loop")
@@ -0,0 +1,161 @@
+//  Copyright (c) 2011-2014 Bryce Adelstein-Lelbach
+//  Copyright (c) 2007-2014 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This benchmark compares the queuing policies usable for the pending work
+// items of a thread_queue (lockfree_fifo, lockfree_lifo, and, if enabled,
+// lockfree_chase_lev_lifo) outside of the HPX runtime. Each OS-thread owns one
+// queue which it fills with its tasks, it then drains its own queue before
+// stealing from the queues of the other OS-threads, mimicking the access
+// pattern of the local_priority_queue_scheduler.
+
+#define HPX_NO_VERSION_CHECK
+#include "htts2.hpp"
+
+#include <hpx/runtime/threads/policies/lockfree_queue_backends.hpp>
+
+#include <boost/atomic.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <vector>
+
+struct htts2_task
+{
+    boost::uint64_t payload_duration_;
+};
+
+template <typename BaseClock = std::chrono::steady_clock>
+struct queuing_driver : htts2::driver
+{
+    queuing_driver(int argc, char** argv)
+      : htts2::driver(argc, argv)
+    {}
+
+    void run()
+    {
+        if (this->io_ == htts2::csv_with_headers)
+            std::cout
+                << "Queuing Policy (Independent Variable),"
+                << "OS-threads (Control Variable),"
+                << "Tasks per OS-thread (Control Variable) [tasks/OS-threads],"
+                << "Payload Duration (Control Variable) [nanoseconds],"
+                << "Total Walltime [nanoseconds]"
+                << "\n";
+
+        using namespace hpx::threads::policies;
+
+        print_results("lockfree_fifo", kernel<lockfree_fifo>());
+        print_results("lockfree_lifo", kernel<lockfree_lifo>());
+#if defined(HPX_HAVE_CHASE_LEV_SCHEDULER)
+        print_results("lockfree_chase_lev_lifo",
+            kernel<lockfree_chase_lev_lifo>());
+#endif
+    }
+
+  private:
+    typedef double results_type;
+
+    template <typename Queue>
+    void worker(std::vector<std::unique_ptr<Queue> >& queues,
+        boost::uint64_t num_thread, boost::atomic<boost::uint64_t>& ready,
+        boost::atomic<boost::uint64_t>& executed)
+    {
+        boost::uint64_t const total = this->tasks_ * this->osthreads_;
+        Queue& this_queue = *queues[num_thread];
+
+        // Stage our tasks. The initial (failing) pop makes this OS-thread the
+        // owner of its queue for those backends which care, just as the first
+        // invocation of the scheduling loop does.
+        htts2_task* t = nullptr;
+        this_queue.pop(t, false);
+
+        std::vector<htts2_task> tasks(this->tasks_,
+            htts2_task{this->payload_duration_});
+        for (htts2_task& t : tasks)
+            this_queue.push(&t);
+
+        ++ready;
+        while (ready.load() != this->osthreads_)
+            ;
+
+        // Execute local tasks first, then steal.
+        while (executed.load(boost::memory_order_relaxed) != total)
+        {
+            bool found = this_queue.pop(t, false);
+            for (boost::uint64_t i = 1;
+                 !found && i != this->osthreads_; ++i)
+            {
+                std::size_t idx = (num_thread + i) % this->osthreads_;
+                found = queues[idx]->pop(t, true);
+            }
+
+            if (found)
+            {
+                htts2::payload<BaseClock>(t->payload_duration_);
+                ++executed;
+            }
+        }
+
+        // Keep our tasks alive until everybody is done.
+        while (executed.load() != total)
+            ;
+    }
+
+    template <typename Queuing>
+    results_type kernel()
+    {
+        typedef typename Queuing::template apply<htts2_task*>::type
+            queue_type;
+
+        std::vector<std::unique_ptr<queue_type> > queues;
+        queues.reserve(this->osthreads_);
+        for (boost::uint64_t i = 0; i != this->osthreads_; ++i)
+            queues.emplace_back(new queue_type(128, i));
+
+        boost::atomic<boost::uint64_t> ready(0);
+        boost::atomic<boost::uint64_t> executed(0);
+
+        htts2::timer<BaseClock> t;
+
+        std::vector<std::thread> threads;
+        threads.reserve(this->osthreads_);
+        for (boost::uint64_t i = 0; i != this->osthreads_; ++i)
+        {
+            threads.emplace_back(&queuing_driver::template worker<queue_type>, this,
+                std::ref(queues), i, std::ref(ready), std::ref(executed));
+        }
+
+        for (std::thread& thread : threads)
+            thread.join();
+
+        // w_M [nanoseconds]
+        return static_cast<double>(t.elapsed());
+    }
+
+    void print_results(char const* queuing, results_type results) const
+    {
+        std::cout
+            << ( boost::format("%s,%lu,%lu,%lu,%.14g\n")
+               % queuing
+               % this->osthreads_
+               % this->tasks_
+               % this->payload_duration_
+               % results
+               )
+            ;
+    }
+};
+
+int main(int argc, char** argv)
+{
+    queuing_driver<> d(argc, argv);
+
+    d.run();
+
+    return 0;
+}
@@ -0,0 +1,174 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+#include <hpx/include/parallel_sort.hpp>
+#include <hpx/include/iostreams.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+#include <boost/cstdint.hpp>
+#include <boost/range/functions.hpp>
+
+///////////////////////////////////////////////////////////////////////////////
+int test_count = 100;
+
+std::vector<double> make_data(std::size_t size)
+{
+    std::vector<double> data(size);
+    for (double& d : data)
+        d = double(std::rand());
+    return data;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Run the given function test_count times on a fresh copy of the data and
+// return the average time spent (in nanoseconds).
+template <typename F>
+boost::uint64_t average_out(std::vector<double> const& data, F && f)
+{
+    boost::uint64_t elapsed = 0;
+    for (int i = 0; i != test_count; ++i)
+    {
+        std::vector<double> c = data;
+
+        boost::uint64_t start = hpx::util::high_resolution_clock::now();
+        f(c);
+        elapsed += hpx::util::high_resolution_clock::now() - start;
+    }
+    return elapsed / test_count;
+}
+
+void print_result(char const* name, boost::uint64_t par_time,
+    boost::uint64_t std_time)
+{
+    hpx::cout << std::left << std::setw(20) << name
+        << std::right << std::setw(15) << par_time / 1e9
+        << std::setw(15) << std_time / 1e9
+        << std::setw(10) << std::setprecision(3)
+        << double(std_time) / double(par_time) << "\n" << hpx::flush;
+}
+
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    std::size_t vector_size = vm["vector_size"].as<std::size_t>();
+    bool csvoutput = vm["csv_output"].as<int>() ? true : false;
+    test_count = vm["test_count"].as<int>();
+    if (test_count <= 0) {
+        hpx::cout << "test_count cannot be less than zero...\n" << hpx::flush;
+        return hpx::finalize();
+    }
+
+    using hpx::parallel::par;
+
+    std::vector<double> data = make_data(vector_size);
+    std::size_t middle = vector_size / 10;
+    std::size_t nth = vector_size / 2;
+
+    boost::uint64_t sort_time = average_out(data,
+        [](std::vector<double>& c)
+        {
+            hpx::parallel::sort(par, boost::begin(c), boost::end(c));
+        });
+    boost::uint64_t std_sort_time = average_out(data,
+        [](std::vector<double>& c)
+        {
+            std::sort(boost::begin(c), boost::end(c));
+        });
+
+    boost::uint64_t stable_sort_time = average_out(data,
+        [](std::vector<double>& c)
+        {
+            hpx::parallel::stable_sort(par, boost::begin(c), boost::end(c));
+        });
+    boost::uint64_t std_stable_sort_time = average_out(data,
+        [](std::vector<double>& c)
+        {
+            std::stable_sort(boost::begin(c), boost::end(c));
+        });
+
+    boost::uint64_t partial_sort_time = average_out(data,
+        [middle](std::vector<double>& c)
+        {
+            hpx::parallel::partial_sort(par, boost::begin(c),
+                boost::begin(c) + middle, boost::end(c));
+        });
+    boost::uint64_t std_partial_sort_time = average_out(data,
+        [middle](std::vector<double>& c)
+        {
+            std::partial_sort(boost::begin(c), boost::begin(c) + middle,
+                boost::end(c));
+        });
+
+    boost::uint64_t nth_element_time = average_out(data,
+        [nth](std::vector<double>& c)
+        {
+            hpx::parallel::nth_element(par, boost::begin(c),
+                boost::begin(c) + nth, boost::end(c));
+        });
+    boost::uint64_t std_nth_element_time = average_out(data,
+        [nth](std::vector<double>& c)
+        {
+            std::nth_element(boost::begin(c), boost::begin(c) + nth,
+                boost::end(c));
+        });
+
+    if (csvoutput) {
+        hpx::cout
+            << "," << sort_time / 1e9 << "," << std_sort_time / 1e9
+            << "," << stable_sort_time / 1e9
+            << "," << std_stable_sort_time / 1e9
+            << "," << partial_sort_time / 1e9
+            << "," << std_partial_sort_time / 1e9
+            << "," << nth_element_time / 1e9
+            << "," << std_nth_element_time / 1e9
+            << "\n" << hpx::flush;
+    } else {
+        hpx::cout << std::left << std::setw(20) << "algorithm"
+            << std::right << std::setw(15) << "par [s]"
+            << std::setw(15) << "std [s]"
+            << std::setw(10) << "speedup" << "\n" << hpx::flush;
+
+        print_result("sort", sort_time, std_sort_time);
+        print_result("stable_sort", stable_sort_time, std_stable_sort_time);
+        print_result("partial_sort", partial_sort_time,
+            std_partial_sort_time);
+        print_result("nth_element", nth_element_time, std_nth_element_time);
+    }
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> const cfg = {
+        "hpx.os_threads=all"
+    };
+
+    boost::program_options::options_description cmdline(
+        "usage: " HPX_APPLICATION_STRING " [options]");
+
+    cmdline.add_options()
+        ("vector_size"
+        , boost::program_options::value<std::size_t>()->default_value(1000000)
+        , "size of vector")
+
+        ("csv_output"
+        , boost::program_options::value<int>()->default_value(0)
+        , "print results in csv format")
+
+        ("test_count"
+        , boost::program_options::value<int>()->default_value(10)
+        , "number of tests to take average from")
+        ;
+
+    return hpx::init(cmdline, argc, argv, cfg);
+}
@@ -240,27 +240,11 @@ struct triad_step
 };
 
 ///////////////////////////////////////////////////////////////////////////////
-template <typename Allocator, typename Executor, typename Target, typename Chunker>
+template <typename Policy, typename Vector>
 std::vector<std::vector<double> >
-run_benchmark(
-    std::size_t iterations, std::size_t size, Target target, Chunker chunker)
+run_kernels(Policy policy, std::size_t iterations,
+    Vector& a, Vector& b, Vector& c)
 {
-    // Creating our allocator ...
-    Allocator alloc(target);
-
-    // Allocate our data
-    typedef hpx::compute::vector<STREAM_TYPE, Allocator> vector_type;
-
-    vector_type a(size, alloc);
-    vector_type b(size, alloc);
-    vector_type c(size, alloc);
-
-    // Creating our executor ....
-    Executor exec(target);
-
-    // Creating the policy used in the parallel algorithms
-    auto policy = hpx::parallel::par.on(exec).with(chunker);
-
     // Initialize arrays
     hpx::parallel::fill(policy, a.begin(), a.end(), 1.0);
     hpx::parallel::fill(policy, b.begin(), b.end(), 2.0);
@@ -353,6 +337,35 @@ run_benchmark(
     return timing;
 }
 
+template <typename Allocator, typename Executor, typename Target, typename Chunker>
+std::vector<std::vector<double> >
+run_benchmark(std::size_t iterations, std::size_t size, Target target,
+    Chunker chunker, bool vectorize)
+{
+    // Creating our allocator ...
+    Allocator alloc(target);
+
+    // Allocate our data
+    typedef hpx::compute::vector<STREAM_TYPE, Allocator> vector_type;
+
+    vector_type a(size, alloc);
+    vector_type b(size, alloc);
+    vector_type c(size, alloc);
+
+    // Creating our executor ....
+    Executor exec(target);
+
+    // Creating the policy used in the parallel algorithms, the vector policy
+    // lets the algorithms process contiguous arrays in packs
+    if (vectorize)
+    {
+        return run_kernels(hpx::parallel::par_vec.on(exec).with(chunker),
+            iterations, a, b, c);
+    }
+    return run_kernels(hpx::parallel::par.on(exec).with(chunker),
+        iterations, a, b, c);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int hpx_main(boost::program_options::variables_map& vm)
 {
@@ -363,6 +376,7 @@ int hpx_main(boost::program_options::variables_map& vm)
     std::string num_numa_domains_str = vm["stream-numa-domains"].as<std::string>();
 
     std::string chunker = vm["chunker"].as<std::string>();
+    bool vectorize = vm.count("vector") != 0;
 
     std::cout
         << "-------------------------------------------------------------\n"
@@ -386,6 +400,7 @@ int hpx_main(boost::program_options::variables_map& vm)
         << "Number of Threads requested = "
             << hpx::get_os_thread_count() << "\n"
         << "Chunking policy requested: " << chunker << "\n"
+        << "Vectorization requested: " << (vectorize ? "yes" : "no") << "\n"
         << "-------------------------------------------------------------\n"
         ;
 
@@ -415,28 +430,28 @@ int hpx_main(boost::program_options::variables_map& vm)
 //             timing =
 //                 run_benchmark<allocator_type, executor_type>(
 //                     iterations, vector_size, std::move(target),
-//                     hpx::parallel::auto_chunk_size());
+//                     hpx::parallel::auto_chunk_size(), vectorize);
 //         }
 //         else if(chunker == "guided")
 //         {
 //             timing =
 //                 run_benchmark<allocator_type, executor_type>(
 //                     iterations, vector_size, std::move(target),
-//                     hpx::parallel::guided_chunk_size());
+//                     hpx::parallel::guided_chunk_size(), vectorize);
 //         }
 //         else if(chunker == "dynamic")
 //         {
 //             timing =
 //                 run_benchmark<allocator_type, executor_type>(
 //                     iterations, vector_size, std::move(target),
-//                     hpx::parallel::dynamic_chunk_size());
+//                     hpx::parallel::dynamic_chunk_size(), vectorize);
 //         }
 //         else
         {
             timing =
                 run_benchmark<allocator_type, executor_type>(
                     iterations, vector_size, std::move(target),
-                    hpx::parallel::static_chunk_size());
+                    hpx::parallel::static_chunk_size(), vectorize);
         }
     }
     else
@@ -454,28 +469,28 @@ int hpx_main(boost::program_options::variables_map& vm)
             timing =
                 run_benchmark<allocator_type, executor_type>(
                     iterations, vector_size, numa_nodes,
-                    hpx::parallel::auto_chunk_size());
+                    hpx::parallel::auto_chunk_size(), vectorize);
         }
         else if(chunker == "guided")
         {
             timing =
                 run_benchmark<allocator_type, executor_type>(
                     iterations, vector_size, numa_nodes,
-                    hpx::parallel::guided_chunk_size());
+                    hpx::parallel::guided_chunk_size(), vectorize);
         }
         else if(chunker == "dynamic")
         {
             timing =
                 run_benchmark<allocator_type, executor_type>(
                     iterations, vector_size, numa_nodes,
-                    hpx::parallel::dynamic_chunk_size());
+                    hpx::parallel::dynamic_chunk_size(), vectorize);
         }
         else
         {
             timing =
                 run_benchmark<allocator_type, executor_type>(
                     iterations, vector_size, numa_nodes,
-                    hpx::parallel::static_chunk_size());
+                    hpx::parallel::static_chunk_size(), vectorize);
         }
     }
     time_total = mysecond() - time_total;
@@ -601,6 +616,8 @@ int main(int argc, char* argv[])
             boost::program_options::value<std::string>()->default_value("default"),
             "Which chunker to use for the parallel algorithms. "
             "possible values: dynamic, auto, guided. (default: default)")
+        (   "vector",
+            "Use the vector execution policy (par_vec) for the kernels")
 #if defined(HPX_HAVE_COMPUTE)
         (   "use-accelerator",
             "Use this flag to run the stream benchmark on the GPU")
@@ -0,0 +1,281 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This benchmark compares the throughput of the concurrent hash table used
+// by the partitions of hpx::unordered_map with a std::unordered_map guarded
+// by a single lock (which is what the partitions used to rely on by means
+// of locking_hook) under a mixed read/write load.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/iostreams.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+
+#include <hpx/components/containers/unordered/concurrent_unordered_map.hpp>
+
+#include <boost/cstdint.hpp>
+#include <boost/optional.hpp>
+
+#include <cstddef>
+#include <iomanip>
+#include <mutex>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+int test_count = 10;
+std::size_t num_keys = 100000;
+std::size_t num_tasks = 0;
+std::size_t ops_per_task = 100000;
+std::size_t batch_size = 8192;
+int read_percentage = 90;
+
+///////////////////////////////////////////////////////////////////////////////
+// std::unordered_map protected by one lock
+class locked_unordered_map
+{
+    typedef hpx::lcos::local::spinlock mutex_type;
+    typedef std::unordered_map<std::size_t, double> data_type;
+
+public:
+    boost::optional<double> get_value(std::size_t key) const
+    {
+        std::lock_guard<mutex_type> l(mtx_);
+        data_type::const_iterator it = data_.find(key);
+        if (it == data_.end())
+            return boost::optional<double>();
+        return boost::optional<double>(it->second);
+    }
+
+    void set_value(std::size_t key, double val)
+    {
+        std::lock_guard<mutex_type> l(mtx_);
+        data_[key] = val;
+    }
+
+    bool get_values(std::vector<std::size_t> const& keys,
+        std::vector<double>& vals) const
+    {
+        vals.resize(keys.size());
+
+        std::lock_guard<mutex_type> l(mtx_);
+        for (std::size_t i = 0; i != keys.size(); ++i)
+        {
+            data_type::const_iterator it = data_.find(keys[i]);
+            if (it == data_.end())
+                return false;
+            vals[i] = it->second;
+        }
+        return true;
+    }
+
+    void set_values(std::vector<std::size_t> const& keys,
+        std::vector<double> const& vals)
+    {
+        std::lock_guard<mutex_type> l(mtx_);
+        for (std::size_t i = 0; i != keys.size(); ++i)
+            data_[keys[i]] = vals[i];
+    }
+
+private:
+    mutable mutex_type mtx_;
+    data_type data_;
+};
+
+typedef hpx::detail::concurrent_unordered_map<std::size_t, double>
+    concurrent_unordered_map;
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename Map>
+void fill(Map& m)
+{
+    for (std::size_t i = 0; i != num_keys; ++i)
+        m.set_value(i, double(i));
+}
+
+// Every task performs ops_per_task single key operations on random keys,
+// read_percentage percent of which are lookups.
+template <typename Map>
+void single_key_operations(Map& m, std::size_t seed)
+{
+    std::mt19937 gen(static_cast<unsigned int>(seed));
+    std::uniform_int_distribution<std::size_t> keys(0, num_keys - 1);
+    std::uniform_int_distribution<int> percentage(0, 99);
+
+    double val = 0;
+    for (std::size_t i = 0; i != ops_per_task; ++i)
+    {
+        std::size_t key = keys(gen);
+        if (percentage(gen) < read_percentage)
+        {
+            boost::optional<double> found = m.get_value(key);
+            if (!found)
+                hpx::cout << "key not found: " << key << "\n" << hpx::flush;
+            else
+                val = *found;
+        }
+        else
+        {
+            m.set_value(key, val + 1.0);
+        }
+    }
+}
+
+// Every task performs batched operations of batch_size random keys until
+// it has touched ops_per_task keys, read_percentage percent of the batches
+// are lookups.
+template <typename Map>
+void batched_operations(Map& m, std::size_t seed)
+{
+    std::mt19937 gen(static_cast<unsigned int>(seed));
+    std::uniform_int_distribution<std::size_t> keys(0, num_keys - 1);
+    std::uniform_int_distribution<int> percentage(0, 99);
+
+    std::vector<std::size_t> batch(batch_size);
+    std::vector<double> vals(batch_size, 1.0);
+    for (std::size_t i = 0; i < ops_per_task; i += batch_size)
+    {
+        for (std::size_t& key : batch)
+            key = keys(gen);
+
+        if (percentage(gen) < read_percentage)
+        {
+            if (!m.get_values(batch, vals))
+                hpx::cout << "key not found\n" << hpx::flush;
+        }
+        else
+        {
+            m.set_values(batch, vals);
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Run the given operations on num_tasks concurrent tasks test_count times
+// and return the average number of operations per second.
+template <typename Map, typename F>
+double measure_throughput(F f)
+{
+    Map m;
+    fill(m);
+
+    boost::uint64_t elapsed = 0;
+    for (int i = 0; i != test_count; ++i)
+    {
+        std::vector<hpx::future<void> > tasks;
+        tasks.reserve(num_tasks);
+
+        boost::uint64_t start = hpx::util::high_resolution_clock::now();
+        for (std::size_t t = 0; t != num_tasks; ++t)
+        {
+            std::size_t seed = i * num_tasks + t;
+            tasks.push_back(hpx::async([&m, f, seed]() { f(m, seed); }));
+        }
+        hpx::wait_all(tasks);
+        elapsed += hpx::util::high_resolution_clock::now() - start;
+    }
+
+    double ops = double(test_count) * double(num_tasks) * double(ops_per_task);
+    return ops / (elapsed / 1e9);
+}
+
+void print_result(char const* name, double locked, double concurrent)
+{
+    hpx::cout << std::left << std::setw(20) << name
+        << std::right << std::setw(18) << locked
+        << std::setw(18) << concurrent
+        << std::setw(10) << std::setprecision(3)
+        << concurrent / locked << "\n" << hpx::flush;
+}
+
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    bool csvoutput = vm["csv_output"].as<int>() ? true : false;
+    test_count = vm["test_count"].as<int>();
+    num_keys = vm["num_keys"].as<std::size_t>();
+    num_tasks = vm["num_tasks"].as<std::size_t>();
+    ops_per_task = vm["ops_per_task"].as<std::size_t>();
+    batch_size = vm["batch_size"].as<std::size_t>();
+    read_percentage = vm["read_percentage"].as<int>();
+
+    if (test_count <= 0 || num_keys == 0 || batch_size == 0) {
+        hpx::cout << "test_count, num_keys, and batch_size have to be "
+            "larger than zero...\n" << hpx::flush;
+        return hpx::finalize();
+    }
+    if (num_tasks == 0)
+        num_tasks = hpx::get_os_thread_count();
+
+    double single_locked = measure_throughput<locked_unordered_map>(
+        &single_key_operations<locked_unordered_map>);
+    double single_concurrent = measure_throughput<concurrent_unordered_map>(
+        &single_key_operations<concurrent_unordered_map>);
+
+    double batched_locked = measure_throughput<locked_unordered_map>(
+        &batched_operations<locked_unordered_map>);
+    double batched_concurrent = measure_throughput<concurrent_unordered_map>(
+        &batched_operations<concurrent_unordered_map>);
+
+    if (csvoutput) {
+        hpx::cout
+            << "," << single_locked << "," << single_concurrent
+            << "," << batched_locked << "," << batched_concurrent
+            << "\n" << hpx::flush;
+    } else {
+        hpx::cout << std::left << std::setw(20) << "operations"
+            << std::right << std::setw(18) << "locked [ops/s]"
+            << std::setw(18) << "concurrent [ops/s]"
+            << std::setw(10) << "speedup" << "\n" << hpx::flush;
+
+        print_result("single key", single_locked, single_concurrent);
+        print_result("batched", batched_locked, batched_concurrent);
+    }
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> const cfg = {
+        "hpx.os_threads=all"
+    };
+
+    boost::program_options::options_description cmdline(
+        "usage: " HPX_APPLICATION_STRING " [options]");
+
+    cmdline.add_options()
+        ("num_keys"
+        , boost::program_options::value<std::size_t>()->default_value(100000)
+        , "number of keys stored in the table")
+
+        ("num_tasks"
+        , boost::program_options::value<std::size_t>()->default_value(0)
+        , "number of concurrent tasks (default: number of cores)")
+
+        ("ops_per_task"
+        , boost::program_options::value<std::size_t>()->default_value(100000)
+        , "number of keys accessed by each of the tasks")
+
+        ("batch_size"
+        , boost::program_options::value<std::size_t>()->default_value(8192)
+        , "number of keys accessed by every batched operation")
+
+        ("read_percentage"
+        , boost::program_options::value<int>()->default_value(90)
+        , "percentage of the operations which are lookups")
+
+        ("csv_output"
+        , boost::program_options::value<int>()->default_value(0)
+        , "print results in csv format")
+
+        ("test_count"
+        , boost::program_options::value<int>()->default_value(10)
+        , "number of tests to take average from")
+        ;
+
+    return hpx::init(cmdline, argc, argv, cfg);
+}
@@ -0,0 +1,350 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Collective operations network test
+//
+// This measures the latency of broadcast, reduce, allreduce and allgather
+// for a growing number of sites. Every site is represented by a component,
+// the components are distributed in blocks over all localities. This allows
+// to simulate many localities with only a few of them. The broadcast is
+// measured twice: once using hpx::lcos::broadcast, and once sending the
+// value in segments which are pipelined along the same tree.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/iostreams.hpp>
+#include <hpx/include/serialization.hpp>
+#include <hpx/lcos/broadcast.hpp>
+#include <hpx/lcos/detail/collective_tree.hpp>
+#include <hpx/lcos/reduce.hpp>
+#include <hpx/runtime/serialization/serialize_buffer.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <iomanip>
+#include <utility>
+#include <vector>
+
+#define SKIP 10
+
+typedef hpx::serialization::serialize_buffer<double> buffer_type;
+
+///////////////////////////////////////////////////////////////////////////////
+hpx::future<void> send_segment(std::vector<hpx::id_type> const& sites,
+    std::size_t offset, std::size_t size, buffer_type const& segment);
+
+struct coll_server
+  : hpx::components::simple_component_base<coll_server>
+{
+    void set_data(std::vector<double> const& data)
+    {
+        data_ = data;
+    }
+
+    std::vector<double> get_data(std::size_t count)
+    {
+        return std::vector<double>(count, 1.0);
+    }
+
+    // Store one segment of a pipelined broadcast and forward it to the
+    // remaining sites of the subtree rooted here.
+    void set_segment(std::vector<hpx::id_type> const& sites,
+        std::size_t offset, std::size_t size, buffer_type const& segment)
+    {
+        hpx::future<void> f = send_segment(
+            std::vector<hpx::id_type>(sites.begin() + 1, sites.end()),
+            offset, size, segment);
+
+        data_.resize(size);
+        std::copy(segment.data(), segment.data() + segment.size(),
+            data_.begin() + offset);
+
+        f.get();
+    }
+
+    HPX_DEFINE_COMPONENT_ACTION(coll_server, set_data);
+    HPX_DEFINE_COMPONENT_ACTION(coll_server, get_data);
+    HPX_DEFINE_COMPONENT_ACTION(coll_server, set_segment);
+
+    std::vector<double> data_;
+};
+
+typedef hpx::components::simple_component<coll_server> coll_server_type;
+HPX_REGISTER_COMPONENT(coll_server_type, osu_coll_server);
+
+typedef coll_server::set_data_action coll_set_data_action;
+typedef coll_server::get_data_action coll_get_data_action;
+typedef coll_server::set_segment_action coll_set_segment_action;
+
+HPX_REGISTER_ACTION(coll_set_segment_action);
+
+HPX_REGISTER_BROADCAST_ACTION_DECLARATION(coll_set_data_action)
+HPX_REGISTER_BROADCAST_ACTION(coll_set_data_action)
+HPX_REGISTER_BROADCAST_ACTION_DECLARATION(coll_get_data_action)
+HPX_REGISTER_BROADCAST_ACTION(coll_get_data_action)
+
+struct vector_plus
+{
+    std::vector<double> operator()(std::vector<double> lhs,
+        std::vector<double> const& rhs) const
+    {
+        for (std::size_t i = 0; i != lhs.size(); ++i)
+            lhs[i] += rhs[i];
+        return lhs;
+    }
+
+    template <typename Archive>
+    void serialize(Archive&, unsigned) {}
+};
+
+HPX_REGISTER_REDUCE_ACTION_DECLARATION(coll_get_data_action, vector_plus)
+HPX_REGISTER_REDUCE_ACTION(coll_get_data_action, vector_plus)
+
+///////////////////////////////////////////////////////////////////////////////
+// Send the segment to the given sites along the same tree as used by
+// hpx::lcos::broadcast. The subtrees are delegated to their first site which
+// forwards the segment as soon as it has arrived.
+hpx::future<void> send_segment(std::vector<hpx::id_type> const& sites,
+    std::size_t offset, std::size_t size, buffer_type const& segment)
+{
+    if (sites.empty())
+        return hpx::make_ready_future();
+
+    std::vector<std::size_t> const bounds =
+        hpx::lcos::detail::collective_tree_split(sites,
+            HPX_BROADCAST_FANOUT);
+
+    std::vector<hpx::future<void> > futures;
+    futures.reserve(bounds[0] + bounds.size() - 1);
+    for (std::size_t i = 0; i != bounds[0]; ++i)
+    {
+        futures.push_back(hpx::async<coll_set_segment_action>(sites[i],
+            std::vector<hpx::id_type>(1, sites[i]), offset, size, segment));
+    }
+
+    for (std::size_t i = 1; i != bounds.size(); ++i)
+    {
+        std::vector<hpx::id_type> subtree(
+            sites.begin() + bounds[i - 1], sites.begin() + bounds[i]);
+
+        hpx::id_type id = subtree[0];
+        futures.push_back(hpx::async<coll_set_segment_action>(id,
+            std::move(subtree), offset, size, segment));
+    }
+
+    return hpx::when_all(futures).then(
+        [](hpx::future<std::vector<hpx::future<void> > > f)
+        {
+            for (hpx::future<void>& g : f.get())
+                g.get();
+        });
+}
+
+///////////////////////////////////////////////////////////////////////////////
+struct params
+{
+    std::size_t min_sites;
+    std::size_t max_sites;
+    std::size_t max_msg_size;
+    std::size_t max_gather_size;
+    std::size_t segment_size;
+    std::size_t iterations;
+};
+
+std::vector<hpx::id_type> create_sites(std::size_t num_sites)
+{
+    std::vector<hpx::id_type> localities = hpx::find_all_localities();
+
+    std::vector<hpx::future<hpx::id_type> > futures;
+    futures.reserve(num_sites);
+    for (std::size_t i = 0; i != num_sites; ++i)
+    {
+        futures.push_back(hpx::new_<coll_server>(
+            localities[i * localities.size() / num_sites]));
+    }
+
+    std::vector<hpx::id_type> sites;
+    sites.reserve(num_sites);
+    for (hpx::future<hpx::id_type>& f : futures)
+        sites.push_back(f.get());
+
+    return sites;
+}
+
+// Run the given operation and return its average latency [microsec]
+template <typename F>
+double measure(std::size_t iterations, F && f)
+{
+    double elapsed = 0.0;
+    for (std::size_t i = 0; i != iterations + SKIP; ++i)
+    {
+        hpx::util::high_resolution_timer t;
+        f();
+        if (i >= SKIP)
+            elapsed += t.elapsed();
+    }
+    return (elapsed * 1e6) / iterations;
+}
+
+void print_latency(double latency, bool enabled)
+{
+    if (enabled)
+        hpx::cout << std::right << std::setw(14) << std::fixed
+                  << std::setprecision(2) << latency;
+    else
+        hpx::cout << std::right << std::setw(14) << "-";
+}
+
+void run_benchmark(params const& p, std::size_t num_sites)
+{
+    std::vector<hpx::id_type> sites = create_sites(num_sites);
+
+    for (std::size_t size = sizeof(double); size <= p.max_msg_size; size *= 2)
+    {
+        std::size_t count = size / sizeof(double);
+        std::vector<double> data(count, 1.0);
+
+        double bcast = measure(p.iterations,
+            [&]()
+            {
+                hpx::lcos::broadcast<coll_set_data_action>(sites, data).get();
+            });
+
+        std::size_t segment = (std::max)(
+            p.segment_size / sizeof(double), std::size_t(1));
+        double bcast_pipelined = measure(p.iterations,
+            [&]()
+            {
+                std::vector<hpx::future<void> > futures;
+                futures.reserve(count / segment + 1);
+                for (std::size_t offset = 0; offset < count; offset += segment)
+                {
+                    buffer_type b(data.data() + offset,
+                        (std::min)(segment, count - offset),
+                        buffer_type::reference);
+                    futures.push_back(send_segment(sites, offset, count, b));
+                }
+                hpx::wait_all(futures);
+            });
+
+        double reduce = measure(p.iterations,
+            [&]()
+            {
+                hpx::lcos::reduce<coll_get_data_action>(
+                    sites, vector_plus(), count).get();
+            });
+
+        double allreduce = measure(p.iterations,
+            [&]()
+            {
+                std::vector<double> result =
+                    hpx::lcos::reduce<coll_get_data_action>(
+                        sites, vector_plus(), count).get();
+                hpx::lcos::broadcast<coll_set_data_action>(
+                    sites, result).get();
+            });
+
+        // the gathered data grows with the number of sites
+        bool gather = num_sites * size <= p.max_gather_size;
+        double allgather = 0.0;
+        if (gather)
+        {
+            allgather = measure(p.iterations,
+                [&]()
+                {
+                    std::vector<std::vector<double> > parts =
+                        hpx::lcos::broadcast<coll_get_data_action>(
+                            sites, count).get();
+
+                    std::vector<double> result;
+                    result.reserve(num_sites * count);
+                    for (std::vector<double> const& part : parts)
+                        result.insert(result.end(), part.begin(), part.end());
+
+                    hpx::lcos::broadcast<coll_set_data_action>(
+                        sites, result).get();
+                });
+        }
+
+        hpx::cout << std::left << std::setw(8) << num_sites
+                  << std::setw(10) << size;
+        print_latency(bcast, true);
+        print_latency(bcast_pipelined, true);
+        print_latency(reduce, true);
+        print_latency(allreduce, true);
+        print_latency(allgather, gather);
+        hpx::cout << hpx::endl << hpx::flush;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    params p = {
+        vm["min-sites"].as<std::size_t>(),
+        vm["max-sites"].as<std::size_t>(),
+        vm["max-msg-size"].as<std::size_t>(),
+        vm["max-gather-size"].as<std::size_t>(),
+        vm["segment-size"].as<std::size_t>(),
+        vm["iter"].as<std::size_t>()
+    };
+
+    if (p.min_sites < 2 || p.iterations == 0)
+    {
+        hpx::cout << "This benchmark needs at least 2 sites and 1 iteration"
+                  << hpx::endl << hpx::flush;
+        return hpx::finalize();
+    }
+
+    hpx::cout << "# OSU HPX Collective Operations Latency Test" << hpx::endl
+              << "# Latency (microsec)" << hpx::endl
+              << std::left << std::setw(8) << "# Sites"
+              << std::setw(10) << "Size"
+              << std::right << std::setw(14) << "bcast"
+              << std::setw(14) << "bcast(pipe)"
+              << std::setw(14) << "reduce"
+              << std::setw(14) << "allreduce"
+              << std::setw(14) << "allgather"
+              << hpx::endl << hpx::flush;
+
+    for (std::size_t num_sites = p.min_sites; num_sites <= p.max_sites;
+         num_sites *= 2)
+    {
+        run_benchmark(p, num_sites);
+    }
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    boost::program_options::options_description
+        desc("Usage: " HPX_APPLICATION_STRING " [options]");
+
+    desc.add_options()
+        ("min-sites",
+         boost::program_options::value<std::size_t>()->default_value(2),
+         "Set minimal number of simulated localities.")
+        ("max-sites",
+         boost::program_options::value<std::size_t>()->default_value(1024),
+         "Set maximal number of simulated localities.")
+        ("max-msg-size",
+         boost::program_options::value<std::size_t>()->default_value(65536),
+         "Set maximum message size in bytes.")
+        ("max-gather-size",
+         boost::program_options::value<std::size_t>()->default_value(
+            4 * 1048576),
+         "Set maximum size of the gathered data in bytes.")
+        ("segment-size",
+         boost::program_options::value<std::size_t>()->default_value(8192),
+         "Set size of the segments of the pipelined broadcast in bytes.")
+        ("iter",
+         boost::program_options::value<std::size_t>()->default_value(100),
+         "Set number of iterations per message size.")
+        ;
+
+    return hpx::init(desc, argc, argv);
+}
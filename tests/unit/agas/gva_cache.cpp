@@ -0,0 +1,162 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx.hpp>
+#include <hpx/runtime/agas/detail/gva_cache.hpp>
+#include <hpx/runtime/agas/gva.hpp>
+#include <hpx/runtime/naming/name.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <boost/cstdint.hpp>
+
+#include <cstddef>
+
+using hpx::agas::gva;
+using hpx::agas::detail::gva_cache;
+using hpx::naming::gid_type;
+
+///////////////////////////////////////////////////////////////////////////////
+gva make_gva(boost::uint64_t count, boost::uint64_t lva)
+{
+    return gva(gid_type(1, 0), 42, count, lva);
+}
+
+bool lookup(gva_cache& cache, gid_type const& id, gid_type& idbase,
+    boost::uint64_t& lva)
+{
+    gva g;
+    if (!cache.get_entry(id, idbase, g))
+        return false;
+    lva = g.lva();
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_ranges()
+{
+    gva_cache cache(4);
+    cache.reserve(1024);
+
+    gid_type old_gid;
+    boost::uint64_t old_count = 0;
+
+    // a single id, a narrow range and a range wide enough to need a higher
+    // level
+    HPX_TEST(cache.update_if(gid_type(1, 3), 1, make_gva(1, 1),
+        old_gid, old_count));
+    HPX_TEST(cache.update_if(gid_type(1, 100), 40, make_gva(40, 2),
+        old_gid, old_count));
+    HPX_TEST(cache.update_if(gid_type(1, 1000), 100000,
+        make_gva(100000, 3), old_gid, old_count));
+
+    // every range accounts for one entry
+    HPX_TEST_EQ(cache.size(), std::size_t(3));
+
+    gid_type idbase;
+    boost::uint64_t lva = 0;
+    HPX_TEST(lookup(cache, gid_type(1, 3), idbase, lva));
+    HPX_TEST_EQ(idbase, gid_type(1, 3));
+    HPX_TEST_EQ(lva, boost::uint64_t(1));
+
+    HPX_TEST(lookup(cache, gid_type(1, 139), idbase, lva));
+    HPX_TEST_EQ(idbase, gid_type(1, 100));
+    HPX_TEST_EQ(lva, boost::uint64_t(2));
+
+    HPX_TEST(lookup(cache, gid_type(1, 50000), idbase, lva));
+    HPX_TEST_EQ(idbase, gid_type(1, 1000));
+    HPX_TEST_EQ(lva, boost::uint64_t(3));
+
+    HPX_TEST(!lookup(cache, gid_type(1, 140), idbase, lva));
+    HPX_TEST(!lookup(cache, gid_type(2, 3), idbase, lva));
+
+    // updating an entry does not change the size
+    HPX_TEST(cache.update_if(gid_type(1, 100), 40, make_gva(40, 4),
+        old_gid, old_count));
+    HPX_TEST_EQ(cache.size(), std::size_t(3));
+    HPX_TEST(lookup(cache, gid_type(1, 120), idbase, lva));
+    HPX_TEST_EQ(lva, boost::uint64_t(4));
+
+    // erasing removes all copies of a range
+    HPX_TEST_EQ(cache.erase(gid_type(1, 100)), std::size_t(1));
+    HPX_TEST_EQ(cache.size(), std::size_t(2));
+    HPX_TEST(!lookup(cache, gid_type(1, 100), idbase, lva));
+    HPX_TEST(!lookup(cache, gid_type(1, 139), idbase, lva));
+
+    // entries survive resizing the cache
+    cache.reserve(4096);
+    HPX_TEST_EQ(cache.size(), std::size_t(2));
+    HPX_TEST(lookup(cache, gid_type(1, 3), idbase, lva));
+    HPX_TEST(lookup(cache, gid_type(1, 100999), idbase, lva));
+    HPX_TEST_EQ(idbase, gid_type(1, 1000));
+
+    HPX_TEST_EQ(cache.clear(), std::size_t(2));
+    HPX_TEST_EQ(cache.size(), std::size_t(0));
+    HPX_TEST(!lookup(cache, gid_type(1, 3), idbase, lva));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_collisions()
+{
+    gva_cache cache(4);
+    cache.reserve(1024);
+
+    gid_type old_gid;
+    boost::uint64_t old_count = 0;
+
+    HPX_TEST(cache.update_if(gid_type(1, 60), 1, make_gva(1, 1),
+        old_gid, old_count));
+
+    // the new range covers several blocks, only the last one collides,
+    // nothing may be inserted for the other blocks
+    HPX_TEST(!cache.update_if(gid_type(1, 0), 61, make_gva(61, 2),
+        old_gid, old_count));
+    HPX_TEST_EQ(old_gid, gid_type(1, 60));
+    HPX_TEST_EQ(old_count, boost::uint64_t(1));
+
+    HPX_TEST_EQ(cache.size(), std::size_t(1));
+
+    gid_type idbase;
+    boost::uint64_t lva = 0;
+    HPX_TEST(!lookup(cache, gid_type(1, 0), idbase, lva));
+    HPX_TEST(!lookup(cache, gid_type(1, 20), idbase, lva));
+    HPX_TEST(lookup(cache, gid_type(1, 60), idbase, lva));
+    HPX_TEST_EQ(lva, boost::uint64_t(1));
+
+    // a single id inside a range stored on a higher level collides as well
+    HPX_TEST(cache.update_if(gid_type(1, 1000), 100000,
+        make_gva(100000, 3), old_gid, old_count));
+    HPX_TEST(!cache.update_if(gid_type(1, 2000), 1, make_gva(1, 4),
+        old_gid, old_count));
+    HPX_TEST_EQ(old_gid, gid_type(1, 1000));
+    HPX_TEST_EQ(old_count, boost::uint64_t(100000));
+    HPX_TEST_EQ(cache.size(), std::size_t(2));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_eviction()
+{
+    gva_cache cache(1);
+    cache.reserve(8);
+
+    gid_type old_gid;
+    boost::uint64_t old_count = 0;
+
+    // the cache never accounts for more entries than it can hold
+    for (boost::uint64_t i = 0; i != 1000; ++i)
+    {
+        HPX_TEST(cache.update_if(gid_type(1, i * 100), 20,
+            make_gva(20, i), old_gid, old_count));
+        HPX_TEST(cache.size() <= cache.capacity());
+    }
+}
+
+int main()
+{
+    test_ranges();
+    test_collisions();
+    test_eviction();
+
+    return hpx::util::report_errors();
+}
@@ -11,6 +11,9 @@
 #include <hpx/include/serialization.hpp>
 #include <hpx/util/lightweight_test.hpp>
 
+#include <cstdio>
+#include <string>
+
 ///////////////////////////////////////////////////////////////////////////////
 struct test_server
   : hpx::components::migration_support<
@@ -209,10 +212,9 @@ bool test_migrate_component_from_storage(hpx::id_type const& source,
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void test_storage(hpx::id_type const& here, hpx::id_type const& there)
+void test_storage(hpx::id_type const& here, hpx::id_type const& there,
+    hpx::components::component_storage storage)
 {
-    // create a new storage instance
-    hpx::components::component_storage storage(here);
     HPX_TEST_NEQ(hpx::naming::invalid_id, storage.get_id());
 
     HPX_TEST(test_migrate_component_to_storage(here, storage,
@@ -228,15 +230,74 @@ void test_storage(hpx::id_type const& here, hpx::id_type const& there)
 //     HPX_TEST(test_migrate_component_from_storage(here, storage));
 }
 
+void test_storage(hpx::id_type const& here, hpx::id_type const& there)
+{
+    // create a new storage instance
+    test_storage(here, there, hpx::components::component_storage(here));
+}
+
+// a component stored in a persistent storage can be resurrected after the
+// storage was destroyed and recreated from the same file
+void test_restore_from_storage(hpx::id_type const& source,
+    std::string const& path)
+{
+    hpx::id_type oldid;
+
+    {
+        hpx::components::component_storage storage(hpx::find_here(), path);
+
+        test_client t1(source);
+        HPX_TEST_EQ(t1.call(), source);
+
+        oldid = hpx::id_type(t1.get_id().get_gid(), hpx::id_type::unmanaged);
+
+        test_client t2(hpx::components::migrate_to_storage(t1, storage));
+        HPX_TEST_EQ(hpx::naming::invalid_id, t2.get_id());
+        HPX_TEST_EQ(storage.size_sync(), std::size_t(1));
+    }
+
+    {
+        // this rebinds the stored component to the new storage instance
+        hpx::components::component_storage storage(hpx::find_here(), path);
+        HPX_TEST_EQ(storage.size_sync(), std::size_t(1));
+
+        test_client t1(
+            hpx::components::migrate_from_storage<test_server>(oldid));
+        HPX_TEST_EQ(oldid, t1.get_id());
+        HPX_TEST_EQ(t1.call(), source);
+
+        HPX_TEST_EQ(storage.size_sync(), std::size_t(0));
+    }
+}
+
+// the persistent storage is always created on this locality
+void test_persistent_storage(hpx::id_type const& there)
+{
+    std::string path("migrate_component_to_storage." +
+        std::to_string(hpx::get_locality_id()) + ".log");
+    std::remove(path.c_str());
+
+    test_storage(hpx::find_here(), there,
+        hpx::components::component_storage(hpx::find_here(), path));
+
+    std::remove(path.c_str());
+
+    test_restore_from_storage(there, path);
+
+    std::remove(path.c_str());
+}
+
 int main()
 {
     test_storage(hpx::find_here(), hpx::find_here());
+    test_persistent_storage(hpx::find_here());
 
     for (hpx::id_type const& id: hpx::find_remote_localities())
     {
         test_storage(hpx::find_here(), id);
         test_storage(id, hpx::find_here());
         test_storage(id, id);
+        test_persistent_storage(id);
     }
 
     return hpx::util::report_errors();
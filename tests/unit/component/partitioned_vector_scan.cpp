@@ -0,0 +1,200 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/partitioned_vector.hpp>
+#include <hpx/include/parallel_scan.hpp>
+#include <hpx/include/parallel_transform_scan.hpp>
+
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// Define the vector types to be used.
+HPX_REGISTER_PARTITIONED_VECTOR(double);
+HPX_REGISTER_PARTITIONED_VECTOR(int);
+
+struct twice
+{
+    template <typename T>
+    T operator()(T const& val) const
+    {
+        return val + val;
+    }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename T>
+std::vector<T> fill_random(hpx::partitioned_vector<T>& v)
+{
+    std::vector<T> values(v.size());
+    for (std::size_t i = 0; i != values.size(); ++i)
+    {
+        values[i] = T(std::rand() % 100);
+        v.set_value_sync(i, values[i]);
+    }
+    return values;
+}
+
+template <typename T>
+void verify_values(hpx::partitioned_vector<T> const& v,
+    std::vector<T> const& expected)
+{
+    HPX_TEST_EQ(v.size(), expected.size());
+    for (std::size_t i = 0; i != expected.size(); ++i)
+        HPX_TEST_EQ(v.get_value_sync(i), expected[i]);
+}
+
+template <typename T>
+std::vector<T> expected_scan(std::vector<T> const& values, T init,
+    bool inclusive, bool doubled)
+{
+    std::vector<T> expected(values.size());
+    for (std::size_t i = 0; i != values.size(); ++i)
+    {
+        T val = doubled ? T(values[i] + values[i]) : values[i];
+        if (inclusive)
+        {
+            init = init + val;
+            expected[i] = init;
+        }
+        else
+        {
+            expected[i] = init;
+            init = init + val;
+        }
+    }
+    return expected;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename T, typename ExPolicy>
+void scan_algo_tests_with_policy(hpx::partitioned_vector<T>& v,
+    hpx::partitioned_vector<T>& w, ExPolicy const& policy)
+{
+    using namespace hpx::parallel;
+
+    std::vector<T> values = fill_random(v);
+
+    auto result = inclusive_scan(policy, v.begin(), v.end(), w.begin(),
+        T(0), std::plus<T>());
+    HPX_TEST(result == w.end());
+    verify_values(w, expected_scan(values, T(0), true, false));
+
+    result = exclusive_scan(policy, v.begin(), v.end(), w.begin(),
+        T(5), std::plus<T>());
+    HPX_TEST(result == w.end());
+    verify_values(w, expected_scan(values, T(5), false, false));
+
+    result = transform_inclusive_scan(policy, v.begin(), v.end(), w.begin(),
+        twice(), T(1), std::plus<T>());
+    HPX_TEST(result == w.end());
+    verify_values(w, expected_scan(values, T(1), true, true));
+
+    result = transform_exclusive_scan(policy, v.begin(), v.end(), w.begin(),
+        twice(), T(0), std::plus<T>());
+    HPX_TEST(result == w.end());
+    verify_values(w, expected_scan(values, T(0), false, true));
+
+    // scan in place
+    result = inclusive_scan(policy, v.begin(), v.end(), v.begin());
+    HPX_TEST(result == v.end());
+    verify_values(v, expected_scan(values, T(0), true, false));
+}
+
+template <typename T, typename ExPolicy>
+void scan_algo_tests_with_policy_async(hpx::partitioned_vector<T>& v,
+    hpx::partitioned_vector<T>& w, ExPolicy const& policy)
+{
+    using namespace hpx::parallel;
+
+    std::vector<T> values = fill_random(v);
+
+    auto f1 = inclusive_scan(policy, v.begin(), v.end(), w.begin(),
+        T(3), std::plus<T>());
+    HPX_TEST(f1.get() == w.end());
+    verify_values(w, expected_scan(values, T(3), true, false));
+
+    auto f2 = transform_exclusive_scan(policy, v.begin(), v.end(), w.begin(),
+        twice(), T(0), std::plus<T>());
+    HPX_TEST(f2.get() == w.end());
+    verify_values(w, expected_scan(values, T(0), false, true));
+
+    // scan in place
+    auto f3 = exclusive_scan(policy, v.begin(), v.end(), v.begin(), T(0));
+    HPX_TEST(f3.get() == v.end());
+    verify_values(v, expected_scan(values, T(0), false, false));
+}
+
+template <typename T, typename DistPolicy>
+void scan_tests_with_policy(std::size_t size, DistPolicy const& dist_policy)
+{
+    using namespace hpx::parallel;
+    using hpx::parallel::task;
+
+    hpx::partitioned_vector<T> v(size, dist_policy);
+    hpx::partitioned_vector<T> w(size, dist_policy);
+
+    scan_algo_tests_with_policy<T>(v, w, seq);
+    scan_algo_tests_with_policy<T>(v, w, par);
+
+    scan_algo_tests_with_policy_async<T>(v, w, seq(task));
+    scan_algo_tests_with_policy_async<T>(v, w, par(task));
+}
+
+// the output partitions have to be located on the same localities as the
+// corresponding input partitions
+template <typename T>
+void scan_tests_mismatched_localities()
+{
+    std::vector<hpx::id_type> localities = hpx::find_all_localities();
+    if (localities.size() < 2)
+        return;
+
+    std::vector<hpx::id_type> reversed(localities.rbegin(), localities.rend());
+
+    std::size_t const length = 10007;
+    hpx::partitioned_vector<T> v(length, hpx::container_layout(localities));
+    hpx::partitioned_vector<T> w(length, hpx::container_layout(reversed));
+
+    bool caught_exception = false;
+    try {
+        hpx::parallel::inclusive_scan(hpx::parallel::par,
+            v.begin(), v.end(), w.begin(), T(0), std::plus<T>());
+    }
+    catch (hpx::exception const& e) {
+        HPX_TEST_EQ(e.get_error(), hpx::bad_parameter);
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+}
+
+template <typename T>
+void scan_tests()
+{
+    std::size_t const length = 10007;
+    std::vector<hpx::id_type> localities = hpx::find_all_localities();
+
+    scan_tests_with_policy<T>(length, hpx::container_layout);
+    scan_tests_with_policy<T>(length, hpx::container_layout(3));
+    scan_tests_with_policy<T>(length, hpx::container_layout(7, localities));
+    scan_tests_with_policy<T>(length, hpx::container_layout(localities));
+    scan_tests_with_policy<T>(5, hpx::container_layout(7, localities));
+
+    scan_tests_mismatched_localities<T>();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    scan_tests<double>();
+    scan_tests<int>();
+
+    return 0;
+}
@@ -0,0 +1,116 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/partitioned_vector.hpp>
+#include <hpx/include/parallel_sort.hpp>
+
+#include <hpx/util/lightweight_test.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// Define the vector types to be used.
+HPX_REGISTER_PARTITIONED_VECTOR(double);
+HPX_REGISTER_PARTITIONED_VECTOR(int);
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename T>
+std::vector<T> fill_random(hpx::partitioned_vector<T>& v, int range)
+{
+    std::vector<T> values(v.size());
+    for (std::size_t i = 0; i != values.size(); ++i)
+    {
+        values[i] = T(std::rand() % range);
+        v.set_value_sync(i, values[i]);
+    }
+    return values;
+}
+
+template <typename T>
+void verify_values(hpx::partitioned_vector<T> const& v,
+    std::vector<T> const& expected)
+{
+    HPX_TEST_EQ(v.size(), expected.size());
+    for (std::size_t i = 0; i != expected.size(); ++i)
+        HPX_TEST_EQ(v.get_value_sync(i), expected[i]);
+}
+
+template <typename T, typename ExPolicy>
+void sort_algo_tests_with_policy(std::size_t size, int range,
+    hpx::partitioned_vector<T>& v, ExPolicy const& policy)
+{
+    std::vector<T> expected = fill_random(v, range);
+    std::sort(expected.begin(), expected.end());
+
+    auto result = hpx::parallel::sort(policy, v.begin(), v.end(),
+        std::less<T>());
+    HPX_TEST(result == v.end());
+    verify_values(v, expected);
+
+    // sort the already sorted sequence in reverse order
+    hpx::parallel::sort(policy, v.begin(), v.end(), std::greater<T>());
+    std::reverse(expected.begin(), expected.end());
+    verify_values(v, expected);
+}
+
+template <typename T, typename ExPolicy>
+void sort_algo_tests_with_policy_async(std::size_t size, int range,
+    hpx::partitioned_vector<T>& v, ExPolicy const& policy)
+{
+    std::vector<T> expected = fill_random(v, range);
+    std::sort(expected.begin(), expected.end(), std::greater<T>());
+
+    auto f = hpx::parallel::sort(policy, v.begin(), v.end(),
+        std::greater<T>());
+    HPX_TEST(f.get() == v.end());
+    verify_values(v, expected);
+}
+
+template <typename T, typename DistPolicy>
+void sort_tests_with_policy(std::size_t size, DistPolicy const& dist_policy)
+{
+    using namespace hpx::parallel;
+    using hpx::parallel::task;
+
+    hpx::partitioned_vector<T> v(size, dist_policy);
+
+    // few and many duplicate values
+    int const ranges[] = { 1 << 30, 10, 1 };
+    for (int range : ranges)
+    {
+        sort_algo_tests_with_policy<T>(size, range, v, seq);
+        sort_algo_tests_with_policy<T>(size, range, v, par);
+
+        sort_algo_tests_with_policy_async<T>(size, range, v, seq(task));
+        sort_algo_tests_with_policy_async<T>(size, range, v, par(task));
+    }
+}
+
+template <typename T>
+void sort_tests()
+{
+    std::size_t const length = 10007;
+    std::vector<hpx::id_type> localities = hpx::find_all_localities();
+
+    sort_tests_with_policy<T>(length, hpx::container_layout);
+    sort_tests_with_policy<T>(length, hpx::container_layout(3));
+    sort_tests_with_policy<T>(length, hpx::container_layout(7, localities));
+    sort_tests_with_policy<T>(length, hpx::container_layout(localities));
+    sort_tests_with_policy<T>(5, hpx::container_layout(7, localities));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    sort_tests<double>();
+    sort_tests<int>();
+
+    return 0;
+}
@@ -0,0 +1,280 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Exercise the memory mapped log used by the persistent component storage:
+// reopening an existing log (which rebuilds the index) and compacting the
+// log while components are stored and erased concurrently.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/naming.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <hpx/components/component_storage/server/persistent_storage.hpp>
+
+#include <boost/cstdint.hpp>
+
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+using hpx::components::server::persistent_storage;
+
+///////////////////////////////////////////////////////////////////////////////
+hpx::naming::gid_type make_gid(std::size_t i)
+{
+    return hpx::naming::gid_type(boost::uint64_t(1), boost::uint64_t(i + 1));
+}
+
+hpx::naming::address make_address(std::size_t i)
+{
+    return hpx::naming::address(hpx::get_locality(),
+        hpx::components::component_type(i % 7 + 1),
+        hpx::naming::address::address_type(0));
+}
+
+std::vector<char> make_data(std::size_t i, std::size_t generation,
+    std::size_t size)
+{
+    std::vector<char> data(size);
+    for (std::size_t j = 0; j != size; ++j)
+        data[j] = static_cast<char>((i * 31 + j + generation) & 0xff);
+    return data;
+}
+
+typedef std::map<std::size_t, std::vector<char> > expected_type;
+
+// verify that the storage holds exactly the expected components
+void verify(persistent_storage& storage, expected_type const& expected)
+{
+    HPX_TEST_EQ(storage.size(), expected.size());
+
+    typedef std::pair<hpx::naming::gid_type, hpx::naming::address> entry_type;
+    std::vector<entry_type> entries = storage.entries();
+    HPX_TEST_EQ(entries.size(), expected.size());
+
+    for (entry_type const& e : entries)
+    {
+        std::size_t i = std::size_t(e.first.get_lsb() - 1);
+        HPX_TEST(expected.find(i) != expected.end());
+        HPX_TEST_EQ(e.second.locality_, hpx::get_locality());
+        HPX_TEST_EQ(e.second.type_, make_address(i).type_);
+    }
+
+    for (expected_type::value_type const& e : expected)
+    {
+        std::vector<char> data;
+        HPX_TEST(storage.load(make_gid(e.first), data));
+        HPX_TEST(data == e.second);
+    }
+}
+
+std::size_t file_size(std::string const& path)
+{
+    std::ifstream in(path.c_str(), std::ios_base::binary | std::ios_base::ate);
+    return std::size_t(in.tellg());
+}
+
+bool file_exists(std::string const& path)
+{
+    std::ifstream in(path.c_str());
+    return in.good();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// store, replace and erase components, close the log and verify that all
+// live components are found again after reopening it
+void test_reopen(std::string const& path)
+{
+    std::remove(path.c_str());
+
+    expected_type expected;
+    {
+        persistent_storage storage(path);
+        HPX_TEST_EQ(storage.size(), std::size_t(0));
+
+        for (std::size_t i = 0; i != 100; ++i)
+        {
+            expected[i] = make_data(i, 0, i * 13);
+            storage.store(make_gid(i), make_address(i), expected[i]);
+        }
+
+        // replace every third component
+        for (std::size_t i = 0; i < 100; i += 3)
+        {
+            expected[i] = make_data(i, 1, i * 7 + 1);
+            storage.store(make_gid(i), make_address(i), expected[i]);
+        }
+
+        // erase every fifth component
+        for (std::size_t i = 0; i < 100; i += 5)
+        {
+            std::vector<char> data;
+            HPX_TEST(storage.load(make_gid(i), data, true));
+            HPX_TEST(data == expected[i]);
+            expected.erase(i);
+        }
+
+        std::vector<char> data;
+        HPX_TEST(!storage.load(make_gid(0), data));
+
+        verify(storage, expected);
+        storage.flush();
+    }
+
+    {
+        persistent_storage storage(path);
+        verify(storage, expected);
+
+        // the reopened log can be appended to
+        for (std::size_t i = 100; i != 110; ++i)
+        {
+            expected[i] = make_data(i, 2, 100);
+            storage.store(make_gid(i), make_address(i), expected[i]);
+        }
+    }
+
+    {
+        persistent_storage storage(path);
+        verify(storage, expected);
+    }
+
+    std::remove(path.c_str());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+std::size_t const record_size = 64 * 1024;
+std::size_t const writer_record_size = 8 * 1024;
+std::size_t const num_records = 64;
+std::size_t const num_writers = 4;
+std::size_t const records_per_writer = 32;
+
+// store and erase components while the storage compacts the log
+void writer(persistent_storage& storage, std::size_t first)
+{
+    for (std::size_t i = first; i != first + records_per_writer; ++i)
+    {
+        storage.store(make_gid(i), make_address(i),
+            make_data(i, 0, writer_record_size));
+
+        // replace and erase some of the components written before
+        if (i % 2 == 0)
+        {
+            storage.store(make_gid(i), make_address(i),
+                make_data(i, 1, writer_record_size / 2));
+        }
+        if (i % 4 == 1)
+        {
+            std::vector<char> data;
+            HPX_TEST(storage.load(make_gid(i), data, true));
+        }
+    }
+}
+
+void add_expected(expected_type& expected, std::size_t first)
+{
+    for (std::size_t i = first; i != first + records_per_writer; ++i)
+    {
+        if (i % 2 == 0)
+            expected[i] = make_data(i, 1, writer_record_size / 2);
+        else if (i % 4 != 1)
+            expected[i] = make_data(i, 0, writer_record_size);
+    }
+}
+
+void test_compaction(std::string const& path)
+{
+    std::remove(path.c_str());
+
+    expected_type expected;
+    std::size_t size_before = 0;
+    {
+        persistent_storage storage(path);
+
+        for (std::size_t i = 0; i != num_records; ++i)
+        {
+            expected[i] = make_data(i, 0, record_size);
+            storage.store(make_gid(i), make_address(i), expected[i]);
+        }
+        size_before = file_size(path);
+
+        std::vector<hpx::future<void> > writers;
+        for (std::size_t w = 0; w != num_writers; ++w)
+        {
+            std::size_t first = num_records + w * records_per_writer;
+            writers.push_back(hpx::async(&writer, std::ref(storage), first));
+            add_expected(expected, first);
+        }
+
+        // erasing most of the initial components triggers a compaction
+        // which runs concurrently to the writers, compact explicitly as
+        // well
+        for (std::size_t i = 0; i != num_records; ++i)
+        {
+            if (i % 8 == 0)
+                continue;
+
+            std::vector<char> data;
+            HPX_TEST(storage.load(make_gid(i), data, true));
+            HPX_TEST(data == expected[i]);
+            expected.erase(i);
+
+            if (i == num_records / 2)
+                storage.compact();
+        }
+
+        hpx::wait_all(writers);
+        verify(storage, expected);
+
+        // the destructor waits for a running compaction
+    }
+
+    {
+        // the compacted log holds the same components
+        persistent_storage storage(path);
+        verify(storage, expected);
+
+        // no compaction is running after reopening, compact synchronously
+        storage.compact();
+        verify(storage, expected);
+    }
+
+    HPX_TEST(!file_exists(path + ".compact"));
+    HPX_TEST(file_size(path) < size_before);
+
+    {
+        persistent_storage storage(path);
+        verify(storage, expected);
+    }
+
+    std::remove(path.c_str());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    std::string const prefix("persistent_component_storage." +
+        std::to_string(hpx::get_locality_id()));
+
+    test_reopen(prefix + ".reopen.log");
+    test_compaction(prefix + ".compact.log");
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,139 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// The bulk invocations resolve all ids at once and split the credits of the
+// ids in advance. This verifies the results for local and remote targets
+// and sends the same ids often enough to exhaust their credits.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/lcos/bulk_async.hpp>
+#include <hpx/runtime/agas/interface.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <boost/atomic.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+struct test_server
+  : hpx::components::simple_component_base<test_server>
+{
+    std::size_t add(std::size_t i)
+    {
+        return i + hpx::get_locality_id();
+    }
+
+    HPX_DEFINE_COMPONENT_ACTION(test_server, add);
+};
+
+typedef hpx::components::simple_component<test_server> test_server_type;
+HPX_REGISTER_COMPONENT(test_server_type, test_server);
+
+typedef test_server::add_action add_action;
+HPX_REGISTER_ACTION(add_action);
+
+///////////////////////////////////////////////////////////////////////////////
+boost::atomic<std::size_t> invocations(0);
+
+void count()
+{
+    ++invocations;
+}
+HPX_PLAIN_ACTION(count);
+
+std::size_t get_invocations()
+{
+    return invocations.load();
+}
+HPX_PLAIN_ACTION(get_invocations);
+
+///////////////////////////////////////////////////////////////////////////////
+std::vector<hpx::id_type> create_objects(std::size_t count)
+{
+    std::vector<hpx::id_type> localities = hpx::find_all_localities();
+
+    std::vector<hpx::id_type> ids;
+    ids.reserve(count);
+    for (std::size_t i = 0; i != count; ++i)
+    {
+        ids.push_back(hpx::new_<test_server>(
+            localities[i % localities.size()]).get());
+    }
+    return ids;
+}
+
+void test_resolve(std::vector<hpx::id_type> const& ids)
+{
+    std::vector<hpx::naming::address> addrs =
+        hpx::agas::resolve(ids).get();
+
+    HPX_TEST_EQ(addrs.size(), ids.size());
+    for (std::size_t i = 0; i != ids.size(); ++i)
+    {
+        HPX_TEST(addrs[i] == hpx::agas::resolve(ids[i]).get());
+    }
+}
+
+void test_bulk_async(std::vector<hpx::id_type> const& ids,
+    std::size_t iterations)
+{
+    for (std::size_t j = 0; j != iterations; ++j)
+    {
+        std::vector<hpx::future<std::size_t> > results =
+            hpx::lcos::bulk_async<add_action>(ids, j);
+
+        HPX_TEST_EQ(results.size(), ids.size());
+        for (std::size_t i = 0; i != results.size(); ++i)
+        {
+            HPX_TEST_EQ(results[i].get(),
+                j + hpx::naming::get_locality_id_from_id(ids[i]));
+        }
+    }
+}
+
+void test_bulk_apply(std::size_t iterations)
+{
+    std::vector<hpx::id_type> localities = hpx::find_all_localities();
+
+    std::vector<std::size_t> expected;
+    for (hpx::id_type const& id : localities)
+        expected.push_back(get_invocations_action()(id) + iterations);
+
+    for (std::size_t j = 0; j != iterations; ++j)
+        hpx::lcos::bulk_apply<count_action>(localities);
+
+    for (std::size_t i = 0; i != localities.size(); ++i)
+    {
+        while (get_invocations_action()(localities[i]) != expected[i])
+            hpx::this_thread::yield();
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    std::vector<hpx::id_type> ids = create_objects(64);
+
+    test_resolve(ids);
+
+    // the credits of the ids are exhausted after a few iterations
+    test_bulk_async(ids, 100);
+    test_bulk_async(std::vector<hpx::id_type>(), 1);
+
+    test_bulk_apply(100);
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,145 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// The collective operations span their sites with trees. This verifies the
+// results for site counts which need more than one level of the tree. The
+// sites are simulated by repeating the ids of the localities and by using
+// arbitrary site numbers for gather.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/lcos/broadcast.hpp>
+#include <hpx/lcos/gather.hpp>
+#include <hpx/lcos/reduce.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <boost/cstdint.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+std::size_t f_idx(std::size_t i, std::size_t idx)
+{
+    return i + idx;
+}
+HPX_PLAIN_ACTION(f_idx);
+
+HPX_REGISTER_BROADCAST_WITH_INDEX_ACTION_DECLARATION(f_idx_action)
+HPX_REGISTER_BROADCAST_WITH_INDEX_ACTION(f_idx_action)
+HPX_REGISTER_BROADCAST_APPLY_WITH_INDEX_ACTION_DECLARATION(f_idx_action)
+HPX_REGISTER_BROADCAST_APPLY_WITH_INDEX_ACTION(f_idx_action)
+
+typedef std::plus<std::size_t> std_plus_type;
+HPX_REGISTER_REDUCE_WITH_INDEX_ACTION_DECLARATION(f_idx_action, std_plus_type)
+HPX_REGISTER_REDUCE_WITH_INDEX_ACTION(f_idx_action, std_plus_type)
+
+HPX_REGISTER_GATHER(boost::uint32_t, collective_tree_gather);
+
+char const* gather_basename = "/test/collective_tree/gather/";
+
+///////////////////////////////////////////////////////////////////////////////
+std::vector<hpx::id_type> make_sites(std::size_t num_sites)
+{
+    std::vector<hpx::id_type> localities = hpx::find_all_localities();
+
+    // sites on the same locality are kept next to each other
+    std::vector<hpx::id_type> sites;
+    sites.reserve(num_sites);
+    for (std::size_t i = 0; i != num_sites; ++i)
+        sites.push_back(localities[i * localities.size() / num_sites]);
+
+    return sites;
+}
+
+void test_broadcast(std::size_t num_sites)
+{
+    std::vector<hpx::id_type> sites = make_sites(num_sites);
+
+    std::vector<std::size_t> result =
+        hpx::lcos::broadcast_with_index<f_idx_action>(sites,
+            std::size_t(1)).get();
+
+    HPX_TEST_EQ(result.size(), num_sites);
+    for (std::size_t i = 0; i != result.size(); ++i)
+    {
+        HPX_TEST_EQ(result[i], i + 1);
+    }
+
+    hpx::lcos::broadcast_apply_with_index<f_idx_action>(sites,
+        std::size_t(1));
+}
+
+void test_reduce(std::size_t num_sites)
+{
+    std::vector<hpx::id_type> sites = make_sites(num_sites);
+
+    std::size_t result =
+        hpx::lcos::reduce_with_index<f_idx_action>(sites,
+            std::plus<std::size_t>(), std::size_t(1)).get();
+
+    HPX_TEST_EQ(result, num_sites * (num_sites + 1) / 2);
+}
+
+void test_gather(std::size_t num_sites, std::size_t root_site,
+    std::size_t generation)
+{
+    std::vector<hpx::future<void> > sent;
+    sent.reserve(num_sites - 1);
+    for (std::size_t site = 0; site != num_sites; ++site)
+    {
+        if (site == root_site)
+            continue;
+
+        sent.push_back(
+            hpx::lcos::gather_there(gather_basename,
+                hpx::make_ready_future(boost::uint32_t(10 * site)),
+                generation, root_site, site, num_sites));
+    }
+
+    std::vector<boost::uint32_t> result =
+        hpx::lcos::gather_here(gather_basename,
+            hpx::make_ready_future(boost::uint32_t(10 * root_site)),
+            num_sites, generation, root_site).get();
+
+    hpx::wait_all(sent);
+
+    HPX_TEST_EQ(result.size(), num_sites);
+    for (std::size_t i = 0; i != result.size(); ++i)
+    {
+        HPX_TEST_EQ(result[i], boost::uint32_t(10 * i));
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    std::size_t const sizes[] = { 2, 17, 18, 100, 300 };
+    for (std::size_t num_sites : sizes)
+    {
+        test_broadcast(num_sites);
+        test_reduce(num_sites);
+    }
+
+    std::size_t generation = 0;
+    for (std::size_t num_sites : sizes)
+    {
+        test_gather(num_sites, 0, generation++);
+        test_gather(num_sites, num_sites / 2, generation++);
+    }
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,165 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/local_lcos.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#define NUM_PRODUCERS std::size_t(10)
+#define NUM_VALUES std::size_t(1000)
+
+///////////////////////////////////////////////////////////////////////////////
+void produce(hpx::lcos::local::channel<std::size_t>& c, std::size_t first)
+{
+    for (std::size_t i = first; i != first + NUM_VALUES; ++i)
+        c.set(i);
+}
+
+std::size_t consume(hpx::lcos::local::channel<std::size_t>& c)
+{
+    std::size_t sum = 0;
+    for (std::size_t i = 0; i != NUM_VALUES; ++i)
+        sum += c.get().get();
+    return sum;
+}
+
+struct no_default
+{
+    explicit no_default(int value) : value_(value) {}
+    int value_;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    // values set before they are requested are handed out in order
+    {
+        hpx::lcos::local::channel<int> c;
+        c.set(1);
+        c.set(2);
+        HPX_TEST_EQ(c.balance(), 2);
+
+        HPX_TEST_EQ(c.get().get(), 1);
+        HPX_TEST_EQ(c.get().get(), 2);
+        HPX_TEST_EQ(c.balance(), 0);
+    }
+
+    // requests made before the values are set are served in order
+    {
+        hpx::lcos::local::channel<std::string> c;
+        hpx::future<std::string> f1 = c.get();
+        hpx::future<std::string> f2 = c.get();
+        HPX_TEST(!f1.is_ready());
+        HPX_TEST(!f2.is_ready());
+        HPX_TEST_EQ(c.balance(), -2);
+
+        c.set(std::string("first"));
+        c.set(std::string("second"));
+
+        HPX_TEST_EQ(f1.get(), std::string("first"));
+        HPX_TEST_EQ(f2.get(), std::string("second"));
+    }
+
+    // try_get does not wait
+    {
+        hpx::lcos::local::channel<int> c;
+        int value = 0;
+        HPX_TEST(!c.try_get(value));
+
+        c.set(42);
+        HPX_TEST(c.try_get(value));
+        HPX_TEST_EQ(value, 42);
+    }
+
+    // abort_pending makes waiting consumers fail
+    {
+        hpx::lcos::local::channel<int> c;
+        hpx::future<int> f = c.get();
+
+        HPX_TEST_EQ(c.abort_pending(HPX_GET_EXCEPTION(hpx::no_success,
+            "hpx_main", "abort")), std::size_t(1));
+        HPX_TEST(f.has_exception());
+        HPX_TEST_EQ(c.balance(), 0);
+    }
+
+    // values do not have to be default constructible
+    {
+        hpx::lcos::local::channel<no_default> c;
+        c.set(no_default(1));
+        HPX_TEST_EQ(c.get().get().value_, 1);
+    }
+
+    // a single producer blocked on a full buffer keeps its order
+    {
+        hpx::lcos::local::channel<std::size_t> c(2);
+        hpx::future<void> producer = hpx::async(&produce, std::ref(c), 0);
+
+        for (std::size_t i = 0; i != NUM_VALUES; ++i)
+            HPX_TEST_EQ(c.get().get(), i);
+
+        producer.get();
+        HPX_TEST_EQ(c.balance(), 0);
+    }
+
+    // more waiting consumers than the buffer can hold
+    {
+        hpx::lcos::local::channel<std::size_t> c(2);
+
+        std::vector<hpx::future<std::size_t> > consumers;
+        for (std::size_t i = 0; i != NUM_PRODUCERS; ++i)
+            consumers.push_back(hpx::async(&consume, std::ref(c)));
+
+        for (std::size_t i = 0; i != NUM_PRODUCERS; ++i)
+            produce(c, i * NUM_VALUES);
+
+        std::size_t sum = 0;
+        for (hpx::future<std::size_t>& f : consumers)
+            sum += f.get();
+
+        std::size_t const n = NUM_PRODUCERS * NUM_VALUES;
+        HPX_TEST_EQ(sum, n * (n - 1) / 2);
+        HPX_TEST_EQ(c.balance(), 0);
+    }
+
+    // many producers, many consumers, small buffer
+    {
+        hpx::lcos::local::channel<std::size_t> c(16);
+
+        std::vector<hpx::future<std::size_t> > consumers;
+        for (std::size_t i = 0; i != NUM_PRODUCERS; ++i)
+            consumers.push_back(hpx::async(&consume, std::ref(c)));
+
+        std::vector<hpx::future<void> > producers;
+        for (std::size_t i = 0; i != NUM_PRODUCERS; ++i)
+        {
+            producers.push_back(
+                hpx::async(&produce, std::ref(c), i * NUM_VALUES));
+        }
+
+        hpx::wait_all(producers);
+
+        std::size_t sum = 0;
+        for (hpx::future<std::size_t>& f : consumers)
+            sum += f.get();
+
+        std::size_t const n = NUM_PRODUCERS * NUM_VALUES;
+        HPX_TEST_EQ(sum, n * (n - 1) / 2);
+        HPX_TEST_EQ(c.balance(), 0);
+    }
+
+    HPX_TEST_EQ(hpx::finalize(), 0);
+    return 0;
+}
+
+int main(int argc, char* argv[])
+{
+    HPX_TEST_EQ(hpx::init(argc, argv), 0);
+    return hpx::util::report_errors();
+}
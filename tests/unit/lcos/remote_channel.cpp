@@ -0,0 +1,112 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/actions.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+typedef hpx::lcos::channel<int> channel_type;
+
+HPX_REGISTER_CHANNEL(int, int)
+
+#define NUM_VALUES 100
+
+///////////////////////////////////////////////////////////////////////////////
+void test_channel(hpx::id_type const& locality)
+{
+    channel_type c = hpx::new_<channel_type>(locality, std::size_t(16));
+
+    // request some values before they are sent
+    std::vector<hpx::future<int> > values;
+    for (int i = 0; i != NUM_VALUES / 2; ++i)
+        values.push_back(c.get());
+
+    for (int i = 0; i != NUM_VALUES; ++i)
+        c.set(i);
+
+    for (int i = NUM_VALUES / 2; i != NUM_VALUES; ++i)
+        values.push_back(c.get());
+
+    // values are handed to the waiting consumers in any order
+    int sum = 0;
+    for (hpx::future<int>& f : values)
+        sum += f.get();
+
+    HPX_TEST_EQ(sum, NUM_VALUES * (NUM_VALUES - 1) / 2);
+}
+
+// values sent with set_sync by one thread arrive in order, even if the
+// sender has to wait for the consumer as the channel is full
+void produce_ordered(channel_type c)
+{
+    for (int i = 0; i != NUM_VALUES; ++i)
+        c.set_sync(i);
+}
+
+void test_channel_ordered(hpx::id_type const& locality)
+{
+    channel_type c = hpx::new_<channel_type>(locality, std::size_t(4));
+
+    hpx::future<void> producer = hpx::async(&produce_ordered, c);
+
+    for (int i = 0; i != NUM_VALUES; ++i)
+        HPX_TEST_EQ(c.get_sync(), i);
+
+    producer.get();
+}
+
+// values streamed by one remote producer using set arrive in order
+void produce_streamed(hpx::id_type const& id)
+{
+    channel_type c(id);
+    for (int i = 0; i != NUM_VALUES; ++i)
+        c.set(i);
+}
+HPX_PLAIN_ACTION(produce_streamed, produce_streamed_action);
+
+void test_channel_streamed(hpx::id_type const& locality,
+    hpx::id_type const& producer_locality)
+{
+    channel_type c = hpx::new_<channel_type>(locality, std::size_t(4));
+
+    hpx::future<void> producer =
+        hpx::async<produce_streamed_action>(producer_locality, c.get_id());
+
+    for (int i = 0; i != NUM_VALUES; ++i)
+        HPX_TEST_EQ(c.get_sync(), i);
+
+    producer.get();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    std::vector<hpx::id_type> localities = hpx::find_all_localities();
+    for (hpx::id_type const& id : localities)
+    {
+        test_channel(id);
+        test_channel_ordered(id);
+
+        for (hpx::id_type const& producer : localities)
+            test_channel_streamed(id, producer);
+    }
+
+    HPX_TEST_EQ(hpx::finalize(), 0);
+    return 0;
+}
+
+int main(int argc, char* argv[])
+{
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,314 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/parallel_sort.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <boost/range/functions.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <ctime>
+#include <functional>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+std::vector<int> make_test_data(std::size_t size, int range)
+{
+    std::vector<int> c(size);
+    for (int& val : c)
+        val = std::rand() % range;
+    return c;
+}
+
+// verify that the element at position nth is where it belongs and that the
+// sequence has been partitioned around it
+template <typename Compare>
+void verify_nth_element(std::vector<int> const& c, std::vector<int> sorted,
+    std::size_t nth, Compare comp)
+{
+    std::vector<int> tmp = c;
+    std::sort(boost::begin(tmp), boost::end(tmp), comp);
+    std::sort(boost::begin(sorted), boost::end(sorted), comp);
+    HPX_TEST(tmp == sorted);
+
+    if (nth >= c.size())
+        return;
+
+    HPX_TEST_EQ(c[nth], sorted[nth]);
+    for (std::size_t i = 0; i != nth; ++i)
+        HPX_TEST(!comp(c[nth], c[i]));
+    for (std::size_t i = nth + 1; i < c.size(); ++i)
+        HPX_TEST(!comp(c[i], c[nth]));
+}
+
+template <typename ExPolicy>
+void test_nth_element(ExPolicy policy, std::size_t size, int range)
+{
+    static_assert(
+        hpx::parallel::is_execution_policy<ExPolicy>::value,
+        "hpx::parallel::is_execution_policy<ExPolicy>::value");
+
+    std::vector<int> c = make_test_data(size, range);
+    std::vector<int> d = c;
+
+    std::size_t nth = size == 0 ? 0 : std::rand() % size;
+    std::vector<int>::iterator result =
+        hpx::parallel::nth_element(policy, boost::begin(c),
+            boost::begin(c) + nth, boost::end(c));
+
+    HPX_TEST(result == boost::end(c));
+    verify_nth_element(c, d, nth, std::less<int>());
+}
+
+template <typename ExPolicy>
+void test_nth_element_comp(ExPolicy policy, std::size_t size, int range)
+{
+    std::vector<int> c = make_test_data(size, range);
+    std::vector<int> d = c;
+
+    std::size_t nth = size / 2;
+    hpx::parallel::nth_element(policy, boost::begin(c),
+        boost::begin(c) + nth, boost::end(c), std::greater<int>());
+
+    verify_nth_element(c, d, nth, std::greater<int>());
+}
+
+template <typename ExPolicy>
+void test_nth_element_async(ExPolicy p, std::size_t size, int range)
+{
+    std::vector<int> c = make_test_data(size, range);
+    std::vector<int> d = c;
+
+    std::size_t nth = size / 3;
+    hpx::future<std::vector<int>::iterator> f =
+        hpx::parallel::nth_element(p, boost::begin(c),
+            boost::begin(c) + nth, boost::end(c));
+
+    HPX_TEST(f.get() == boost::end(c));
+    verify_nth_element(c, d, nth, std::less<int>());
+}
+
+void nth_element_test()
+{
+    using namespace hpx::parallel;
+
+    std::size_t const sizes[] = { 0, 1, 1000, 65537, 300007 };
+    for (std::size_t size : sizes)
+    {
+        // many equal elements
+        test_nth_element(seq, size, 10);
+        test_nth_element(par, size, 10);
+        test_nth_element(par_vec, size, 10);
+
+        // few equal elements
+        test_nth_element(seq, size, 1 << 30);
+        test_nth_element(par, size, 1 << 30);
+        test_nth_element(par_vec, size, 1 << 30);
+
+        test_nth_element_comp(seq, size, 1000);
+        test_nth_element_comp(par, size, 1000);
+
+        test_nth_element_async(seq(task), size, 1000);
+        test_nth_element_async(par(task), size, 1000);
+    }
+
+    // all elements are equal
+    test_nth_element(par, 300007, 1);
+
+#if defined(HPX_HAVE_GENERIC_EXECUTION_POLICY)
+    test_nth_element(execution_policy(seq), 100007, 100);
+    test_nth_element(execution_policy(par), 100007, 100);
+    test_nth_element(execution_policy(par_vec), 100007, 100);
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename ExPolicy>
+void test_nth_element_exception(ExPolicy policy, std::size_t size)
+{
+    static_assert(
+        hpx::parallel::is_execution_policy<ExPolicy>::value,
+        "hpx::parallel::is_execution_policy<ExPolicy>::value");
+
+    std::vector<int> c = make_test_data(size, 1000);
+
+    bool caught_exception = false;
+    try {
+        hpx::parallel::nth_element(policy, boost::begin(c),
+            boost::begin(c) + size / 3, boost::end(c),
+            [](int, int) -> bool
+            {
+                throw std::runtime_error("test");
+            });
+        HPX_TEST(false);
+    }
+    catch (hpx::exception_list const&) {
+        caught_exception = true;
+    }
+    catch (...) {
+        HPX_TEST(false);
+    }
+
+    HPX_TEST(caught_exception);
+}
+
+template <typename ExPolicy>
+void test_nth_element_exception_async(ExPolicy p, std::size_t size)
+{
+    std::vector<int> c = make_test_data(size, 1000);
+
+    bool caught_exception = false;
+    bool returned_from_algorithm = false;
+    try {
+        hpx::future<std::vector<int>::iterator> f =
+            hpx::parallel::nth_element(p, boost::begin(c),
+                boost::begin(c) + size / 3, boost::end(c),
+                [](int, int) -> bool
+                {
+                    throw std::runtime_error("test");
+                });
+        returned_from_algorithm = true;
+        f.get();
+
+        HPX_TEST(false);
+    }
+    catch (hpx::exception_list const&) {
+        caught_exception = true;
+    }
+    catch (...) {
+        HPX_TEST(false);
+    }
+
+    HPX_TEST(caught_exception);
+    HPX_TEST(returned_from_algorithm);
+}
+
+template <typename ExPolicy>
+void test_nth_element_bad_alloc(ExPolicy policy, std::size_t size)
+{
+    static_assert(
+        hpx::parallel::is_execution_policy<ExPolicy>::value,
+        "hpx::parallel::is_execution_policy<ExPolicy>::value");
+
+    std::vector<int> c = make_test_data(size, 1000);
+
+    bool caught_bad_alloc = false;
+    try {
+        hpx::parallel::nth_element(policy, boost::begin(c),
+            boost::begin(c) + size / 3, boost::end(c),
+            [](int, int) -> bool
+            {
+                throw std::bad_alloc();
+            });
+        HPX_TEST(false);
+    }
+    catch (std::bad_alloc const&) {
+        caught_bad_alloc = true;
+    }
+    catch (...) {
+        HPX_TEST(false);
+    }
+
+    HPX_TEST(caught_bad_alloc);
+}
+
+template <typename ExPolicy>
+void test_nth_element_bad_alloc_async(ExPolicy p, std::size_t size)
+{
+    std::vector<int> c = make_test_data(size, 1000);
+
+    bool caught_bad_alloc = false;
+    bool returned_from_algorithm = false;
+    try {
+        hpx::future<std::vector<int>::iterator> f =
+            hpx::parallel::nth_element(p, boost::begin(c),
+                boost::begin(c) + size / 3, boost::end(c),
+                [](int, int) -> bool
+                {
+                    throw std::bad_alloc();
+                });
+        returned_from_algorithm = true;
+        f.get();
+
+        HPX_TEST(false);
+    }
+    catch (std::bad_alloc const&) {
+        caught_bad_alloc = true;
+    }
+    catch (...) {
+        HPX_TEST(false);
+    }
+
+    HPX_TEST(caught_bad_alloc);
+    HPX_TEST(returned_from_algorithm);
+}
+
+void nth_element_exception_test()
+{
+    using namespace hpx::parallel;
+
+    // the parallel versions split large sequences into several tasks
+    std::size_t const sizes[] = { 1000, 300007 };
+    for (std::size_t size : sizes)
+    {
+        test_nth_element_exception(seq, size);
+        test_nth_element_exception(par, size);
+
+        test_nth_element_exception_async(seq(task), size);
+        test_nth_element_exception_async(par(task), size);
+
+        test_nth_element_bad_alloc(seq, size);
+        test_nth_element_bad_alloc(par, size);
+
+        test_nth_element_bad_alloc_async(seq(task), size);
+        test_nth_element_bad_alloc_async(par(task), size);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    unsigned int seed = (unsigned int)std::time(nullptr);
+    if (vm.count("seed"))
+        seed = vm["seed"].as<unsigned int>();
+
+    std::cout << "using seed: " << seed << std::endl;
+    std::srand(seed);
+
+    nth_element_test();
+    nth_element_exception_test();
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // add command line option which controls the random number generator seed
+    using namespace boost::program_options;
+    options_description desc_commandline(
+        "Usage: " HPX_APPLICATION_STRING " [options]");
+
+    desc_commandline.add_options()
+        ("seed,s", value<unsigned int>(),
+        "the random number generator seed to use for this run")
+        ;
+
+    // By default this test should run on all available cores
+    std::vector<std::string> const cfg = {
+        "hpx.os_threads=all"
+    };
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(desc_commandline, argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,478 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/parallel_sort.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <boost/range/functions.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <ctime>
+#include <functional>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+std::vector<int> make_test_data(std::size_t size, int range)
+{
+    std::vector<int> c(size);
+    for (int& val : c)
+        val = std::rand() % range;
+    return c;
+}
+
+template <typename ExPolicy>
+void test_partial_sort(ExPolicy policy, std::size_t size, std::size_t middle)
+{
+    static_assert(
+        hpx::parallel::is_execution_policy<ExPolicy>::value,
+        "hpx::parallel::is_execution_policy<ExPolicy>::value");
+
+    std::vector<int> c = make_test_data(size, 100000);
+    std::vector<int> d = c;
+
+    std::vector<int>::iterator result =
+        hpx::parallel::partial_sort(policy, boost::begin(c),
+            boost::begin(c) + middle, boost::end(c));
+    std::sort(boost::begin(d), boost::end(d));
+
+    HPX_TEST(result == boost::end(c));
+    HPX_TEST(std::equal(boost::begin(c), boost::begin(c) + middle,
+        boost::begin(d)));
+
+    std::sort(boost::begin(c) + middle, boost::end(c));
+    HPX_TEST(std::equal(boost::begin(c) + middle, boost::end(c),
+        boost::begin(d) + middle));
+}
+
+template <typename ExPolicy>
+void test_partial_sort_async(ExPolicy p, std::size_t size, std::size_t middle)
+{
+    std::vector<int> c = make_test_data(size, 100000);
+    std::vector<int> d = c;
+
+    hpx::future<std::vector<int>::iterator> f =
+        hpx::parallel::partial_sort(p, boost::begin(c),
+            boost::begin(c) + middle, boost::end(c), std::greater<int>());
+    std::sort(boost::begin(d), boost::end(d), std::greater<int>());
+
+    HPX_TEST(f.get() == boost::end(c));
+    HPX_TEST(std::equal(boost::begin(c), boost::begin(c) + middle,
+        boost::begin(d)));
+}
+
+template <typename ExPolicy>
+void test_partial_sort_copy(ExPolicy policy, std::size_t size,
+    std::size_t dest_size)
+{
+    static_assert(
+        hpx::parallel::is_execution_policy<ExPolicy>::value,
+        "hpx::parallel::is_execution_policy<ExPolicy>::value");
+
+    std::vector<int> c = make_test_data(size, 100000);
+    std::vector<int> const orig = c;
+    std::vector<int> dest(dest_size, -1);
+    std::vector<int> d(dest_size, -1);
+
+    std::vector<int>::iterator result =
+        hpx::parallel::partial_sort_copy(policy, boost::begin(c),
+            boost::end(c), boost::begin(dest), boost::end(dest));
+    std::vector<int>::iterator expected =
+        std::partial_sort_copy(boost::begin(c), boost::end(c),
+            boost::begin(d), boost::end(d));
+
+    HPX_TEST(c == orig);
+    HPX_TEST(result - boost::begin(dest) == expected - boost::begin(d));
+    HPX_TEST(dest == d);
+}
+
+template <typename ExPolicy>
+void test_partial_sort_copy_async(ExPolicy p, std::size_t size,
+    std::size_t dest_size)
+{
+    std::vector<int> c = make_test_data(size, 100000);
+    std::vector<int> dest(dest_size, -1);
+    std::vector<int> d(dest_size, -1);
+
+    hpx::future<std::vector<int>::iterator> f =
+        hpx::parallel::partial_sort_copy(p, boost::begin(c), boost::end(c),
+            boost::begin(dest), boost::end(dest), std::greater<int>());
+    std::vector<int>::iterator expected =
+        std::partial_sort_copy(boost::begin(c), boost::end(c),
+            boost::begin(d), boost::end(d), std::greater<int>());
+
+    HPX_TEST(f.get() - boost::begin(dest) == expected - boost::begin(d));
+    HPX_TEST(dest == d);
+}
+
+void partial_sort_test()
+{
+    using namespace hpx::parallel;
+
+    std::size_t const size = 300007;
+    std::size_t const middles[] = { 0, 1, 1000, 100000, size };
+    for (std::size_t middle : middles)
+    {
+        test_partial_sort(seq, size, middle);
+        test_partial_sort(par, size, middle);
+        test_partial_sort(par_vec, size, middle);
+
+        test_partial_sort_async(seq(task), size, middle);
+        test_partial_sort_async(par(task), size, middle);
+
+        test_partial_sort_copy(seq, size, middle);
+        test_partial_sort_copy(par, size, middle);
+        test_partial_sort_copy(par_vec, size, middle);
+
+        test_partial_sort_copy_async(seq(task), size, middle);
+        test_partial_sort_copy_async(par(task), size, middle);
+    }
+
+    // destination range larger than the source range
+    test_partial_sort_copy(par, 1000, 2000);
+    test_partial_sort_copy(par, 100000, 200000);
+
+#if defined(HPX_HAVE_GENERIC_EXECUTION_POLICY)
+    test_partial_sort(execution_policy(seq), 100007, 1000);
+    test_partial_sort(execution_policy(par), 100007, 1000);
+    test_partial_sort(execution_policy(par_vec), 100007, 1000);
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename ExPolicy>
+void test_partial_sort_exception(ExPolicy policy, std::size_t size)
+{
+    static_assert(
+        hpx::parallel::is_execution_policy<ExPolicy>::value,
+        "hpx::parallel::is_execution_policy<ExPolicy>::value");
+
+    std::vector<int> c = make_test_data(size, 1000);
+
+    bool caught_exception = false;
+    try {
+        hpx::parallel::partial_sort(policy, boost::begin(c),
+            boost::begin(c) + size / 3, boost::end(c),
+            [](int, int) -> bool
+            {
+                throw std::runtime_error("test");
+            });
+        HPX_TEST(false);
+    }
+    catch (hpx::exception_list const&) {
+        caught_exception = true;
+    }
+    catch (...) {
+        HPX_TEST(false);
+    }
+
+    HPX_TEST(caught_exception);
+}
+
+template <typename ExPolicy>
+void test_partial_sort_exception_async(ExPolicy p, std::size_t size)
+{
+    std::vector<int> c = make_test_data(size, 1000);
+
+    bool caught_exception = false;
+    bool returned_from_algorithm = false;
+    try {
+        hpx::future<std::vector<int>::iterator> f =
+            hpx::parallel::partial_sort(p, boost::begin(c),
+                boost::begin(c) + size / 3, boost::end(c),
+                [](int, int) -> bool
+                {
+                    throw std::runtime_error("test");
+                });
+        returned_from_algorithm = true;
+        f.get();
+
+        HPX_TEST(false);
+    }
+    catch (hpx::exception_list const&) {
+        caught_exception = true;
+    }
+    catch (...) {
+        HPX_TEST(false);
+    }
+
+    HPX_TEST(caught_exception);
+    HPX_TEST(returned_from_algorithm);
+}
+
+template <typename ExPolicy>
+void test_partial_sort_bad_alloc(ExPolicy policy, std::size_t size)
+{
+    static_assert(
+        hpx::parallel::is_execution_policy<ExPolicy>::value,
+        "hpx::parallel::is_execution_policy<ExPolicy>::value");
+
+    std::vector<int> c = make_test_data(size, 1000);
+
+    bool caught_bad_alloc = false;
+    try {
+        hpx::parallel::partial_sort(policy, boost::begin(c),
+            boost::begin(c) + size / 3, boost::end(c),
+            [](int, int) -> bool
+            {
+                throw std::bad_alloc();
+            });
+        HPX_TEST(false);
+    }
+    catch (std::bad_alloc const&) {
+        caught_bad_alloc = true;
+    }
+    catch (...) {
+        HPX_TEST(false);
+    }
+
+    HPX_TEST(caught_bad_alloc);
+}
+
+template <typename ExPolicy>
+void test_partial_sort_bad_alloc_async(ExPolicy p, std::size_t size)
+{
+    std::vector<int> c = make_test_data(size, 1000);
+
+    bool caught_bad_alloc = false;
+    bool returned_from_algorithm = false;
+    try {
+        hpx::future<std::vector<int>::iterator> f =
+            hpx::parallel::partial_sort(p, boost::begin(c),
+                boost::begin(c) + size / 3, boost::end(c),
+                [](int, int) -> bool
+                {
+                    throw std::bad_alloc();
+                });
+        returned_from_algorithm = true;
+        f.get();
+
+        HPX_TEST(false);
+    }
+    catch (std::bad_alloc const&) {
+        caught_bad_alloc = true;
+    }
+    catch (...) {
+        HPX_TEST(false);
+    }
+
+    HPX_TEST(caught_bad_alloc);
+    HPX_TEST(returned_from_algorithm);
+}
+
+void partial_sort_exception_test()
+{
+    using namespace hpx::parallel;
+
+    // the parallel versions split large sequences into several tasks
+    std::size_t const sizes[] = { 1000, 300007 };
+    for (std::size_t size : sizes)
+    {
+        test_partial_sort_exception(seq, size);
+        test_partial_sort_exception(par, size);
+
+        test_partial_sort_exception_async(seq(task), size);
+        test_partial_sort_exception_async(par(task), size);
+
+        test_partial_sort_bad_alloc(seq, size);
+        test_partial_sort_bad_alloc(par, size);
+
+        test_partial_sort_bad_alloc_async(seq(task), size);
+        test_partial_sort_bad_alloc_async(par(task), size);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename ExPolicy>
+void test_partial_sort_copy_exception(ExPolicy policy, std::size_t size)
+{
+    static_assert(
+        hpx::parallel::is_execution_policy<ExPolicy>::value,
+        "hpx::parallel::is_execution_policy<ExPolicy>::value");
+
+    std::vector<int> c = make_test_data(size, 1000);
+    std::vector<int> d(size / 3);
+
+    bool caught_exception = false;
+    try {
+        hpx::parallel::partial_sort_copy(policy, boost::begin(c),
+            boost::end(c), boost::begin(d), boost::end(d),
+            [](int, int) -> bool
+            {
+                throw std::runtime_error("test");
+            });
+        HPX_TEST(false);
+    }
+    catch (hpx::exception_list const&) {
+        caught_exception = true;
+    }
+    catch (...) {
+        HPX_TEST(false);
+    }
+
+    HPX_TEST(caught_exception);
+}
+
+template <typename ExPolicy>
+void test_partial_sort_copy_exception_async(ExPolicy p, std::size_t size)
+{
+    std::vector<int> c = make_test_data(size, 1000);
+    std::vector<int> d(size / 3);
+
+    bool caught_exception = false;
+    bool returned_from_algorithm = false;
+    try {
+        hpx::future<std::vector<int>::iterator> f =
+            hpx::parallel::partial_sort_copy(p, boost::begin(c),
+                boost::end(c), boost::begin(d), boost::end(d),
+                [](int, int) -> bool
+                {
+                    throw std::runtime_error("test");
+                });
+        returned_from_algorithm = true;
+        f.get();
+
+        HPX_TEST(false);
+    }
+    catch (hpx::exception_list const&) {
+        caught_exception = true;
+    }
+    catch (...) {
+        HPX_TEST(false);
+    }
+
+    HPX_TEST(caught_exception);
+    HPX_TEST(returned_from_algorithm);
+}
+
+template <typename ExPolicy>
+void test_partial_sort_copy_bad_alloc(ExPolicy policy, std::size_t size)
+{
+    static_assert(
+        hpx::parallel::is_execution_policy<ExPolicy>::value,
+        "hpx::parallel::is_execution_policy<ExPolicy>::value");
+
+    std::vector<int> c = make_test_data(size, 1000);
+    std::vector<int> d(size / 3);
+
+    bool caught_bad_alloc = false;
+    try {
+        hpx::parallel::partial_sort_copy(policy, boost::begin(c),
+            boost::end(c), boost::begin(d), boost::end(d),
+            [](int, int) -> bool
+            {
+                throw std::bad_alloc();
+            });
+        HPX_TEST(false);
+    }
+    catch (std::bad_alloc const&) {
+        caught_bad_alloc = true;
+    }
+    catch (...) {
+        HPX_TEST(false);
+    }
+
+    HPX_TEST(caught_bad_alloc);
+}
+
+template <typename ExPolicy>
+void test_partial_sort_copy_bad_alloc_async(ExPolicy p, std::size_t size)
+{
+    std::vector<int> c = make_test_data(size, 1000);
+    std::vector<int> d(size / 3);
+
+    bool caught_bad_alloc = false;
+    bool returned_from_algorithm = false;
+    try {
+        hpx::future<std::vector<int>::iterator> f =
+            hpx::parallel::partial_sort_copy(p, boost::begin(c),
+                boost::end(c), boost::begin(d), boost::end(d),
+                [](int, int) -> bool
+                {
+                    throw std::bad_alloc();
+                });
+        returned_from_algorithm = true;
+        f.get();
+
+        HPX_TEST(false);
+    }
+    catch (std::bad_alloc const&) {
+        caught_bad_alloc = true;
+    }
+    catch (...) {
+        HPX_TEST(false);
+    }
+
+    HPX_TEST(caught_bad_alloc);
+    HPX_TEST(returned_from_algorithm);
+}
+
+void partial_sort_copy_exception_test()
+{
+    using namespace hpx::parallel;
+
+    // the parallel versions split large sequences into several tasks
+    std::size_t const sizes[] = { 1000, 300007 };
+    for (std::size_t size : sizes)
+    {
+        test_partial_sort_copy_exception(seq, size);
+        test_partial_sort_copy_exception(par, size);
+
+        test_partial_sort_copy_exception_async(seq(task), size);
+        test_partial_sort_copy_exception_async(par(task), size);
+
+        test_partial_sort_copy_bad_alloc(seq, size);
+        test_partial_sort_copy_bad_alloc(par, size);
+
+        test_partial_sort_copy_bad_alloc_async(seq(task), size);
+        test_partial_sort_copy_bad_alloc_async(par(task), size);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    unsigned int seed = (unsigned int)std::time(nullptr);
+    if (vm.count("seed"))
+        seed = vm["seed"].as<unsigned int>();
+
+    std::cout << "using seed: " << seed << std::endl;
+    std::srand(seed);
+
+    partial_sort_test();
+    partial_sort_exception_test();
+    partial_sort_copy_exception_test();
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // add command line option which controls the random number generator seed
+    using namespace boost::program_options;
+    options_description desc_commandline(
+        "Usage: " HPX_APPLICATION_STRING " [options]");
+
+    desc_commandline.add_options()
+        ("seed,s", value<unsigned int>(),
+        "the random number generator seed to use for this run")
+        ;
+
+    // By default this test should run on all available cores
+    std::vector<std::string> const cfg = {
+        "hpx.os_threads=all"
+    };
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(desc_commandline, argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
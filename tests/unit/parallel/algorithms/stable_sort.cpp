@@ -0,0 +1,321 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/parallel_sort.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <boost/range/functions.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <ctime>
+#include <functional>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// the second member records the original position of an element, which is
+// used to verify that the order of equal elements is preserved
+typedef std::pair<int, std::size_t> element_type;
+
+std::vector<element_type> make_test_data(std::size_t size, int range)
+{
+    std::vector<element_type> c(size);
+    for (std::size_t i = 0; i != size; ++i)
+        c[i] = element_type(std::rand() % range, i);
+    return c;
+}
+
+struct compare_first
+{
+    bool operator()(element_type const& lhs, element_type const& rhs) const
+    {
+        return lhs.first < rhs.first;
+    }
+};
+
+template <typename ExPolicy>
+void test_stable_sort(ExPolicy policy, std::size_t size, int range)
+{
+    static_assert(
+        hpx::parallel::is_execution_policy<ExPolicy>::value,
+        "hpx::parallel::is_execution_policy<ExPolicy>::value");
+
+    std::vector<element_type> c = make_test_data(size, range);
+    std::vector<element_type> d = c;
+
+    std::vector<element_type>::iterator result =
+        hpx::parallel::stable_sort(policy, boost::begin(c), boost::end(c),
+            compare_first());
+    std::stable_sort(boost::begin(d), boost::end(d), compare_first());
+
+    HPX_TEST(result == boost::end(c));
+    HPX_TEST(c == d);
+}
+
+template <typename ExPolicy>
+void test_stable_sort_async(ExPolicy p, std::size_t size, int range)
+{
+    std::vector<element_type> c = make_test_data(size, range);
+    std::vector<element_type> d = c;
+
+    hpx::future<std::vector<element_type>::iterator> f =
+        hpx::parallel::stable_sort(p, boost::begin(c), boost::end(c),
+            compare_first());
+    std::stable_sort(boost::begin(d), boost::end(d), compare_first());
+
+    HPX_TEST(f.get() == boost::end(c));
+    HPX_TEST(c == d);
+}
+
+template <typename ExPolicy>
+void test_stable_sort_projection(ExPolicy policy, std::size_t size)
+{
+    std::vector<element_type> c = make_test_data(size, 1000);
+    std::vector<element_type> d = c;
+
+    hpx::parallel::stable_sort(policy, boost::begin(c), boost::end(c),
+        std::greater<int>(),
+        [](element_type const& e) { return e.first; });
+    std::stable_sort(boost::begin(d), boost::end(d),
+        [](element_type const& lhs, element_type const& rhs)
+        {
+            return lhs.first > rhs.first;
+        });
+
+    HPX_TEST(c == d);
+}
+
+template <typename ExPolicy>
+void test_stable_sort_strings(ExPolicy policy, std::size_t size)
+{
+    std::vector<std::string> c(size);
+    for (std::string& s : c)
+        s = std::to_string(std::rand() % 10000);
+    std::vector<std::string> d = c;
+
+    hpx::parallel::stable_sort(policy, boost::begin(c), boost::end(c));
+    std::stable_sort(boost::begin(d), boost::end(d));
+
+    HPX_TEST(c == d);
+}
+
+void stable_sort_test()
+{
+    using namespace hpx::parallel;
+
+    std::size_t const sizes[] = { 0, 1, 1000, 65537, 300007 };
+    for (std::size_t size : sizes)
+    {
+        // many equal elements
+        test_stable_sort(seq, size, 10);
+        test_stable_sort(par, size, 10);
+        test_stable_sort(par_vec, size, 10);
+
+        // few equal elements
+        test_stable_sort(seq, size, 1 << 30);
+        test_stable_sort(par, size, 1 << 30);
+        test_stable_sort(par_vec, size, 1 << 30);
+
+        test_stable_sort_async(seq(task), size, 100);
+        test_stable_sort_async(par(task), size, 100);
+
+        test_stable_sort_projection(seq, size);
+        test_stable_sort_projection(par, size);
+    }
+
+    test_stable_sort_strings(seq, 100007);
+    test_stable_sort_strings(par, 100007);
+
+#if defined(HPX_HAVE_GENERIC_EXECUTION_POLICY)
+    test_stable_sort(execution_policy(seq), 100007, 100);
+    test_stable_sort(execution_policy(par), 100007, 100);
+    test_stable_sort(execution_policy(par_vec), 100007, 100);
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename ExPolicy>
+void test_stable_sort_exception(ExPolicy policy, std::size_t size)
+{
+    static_assert(
+        hpx::parallel::is_execution_policy<ExPolicy>::value,
+        "hpx::parallel::is_execution_policy<ExPolicy>::value");
+
+    std::vector<element_type> c = make_test_data(size, 1000);
+
+    bool caught_exception = false;
+    try {
+        hpx::parallel::stable_sort(policy, boost::begin(c), boost::end(c),
+            [](element_type const&, element_type const&) -> bool
+            {
+                throw std::runtime_error("test");
+            });
+        HPX_TEST(false);
+    }
+    catch (hpx::exception_list const&) {
+        caught_exception = true;
+    }
+    catch (...) {
+        HPX_TEST(false);
+    }
+
+    HPX_TEST(caught_exception);
+}
+
+template <typename ExPolicy>
+void test_stable_sort_exception_async(ExPolicy p, std::size_t size)
+{
+    std::vector<element_type> c = make_test_data(size, 1000);
+
+    bool caught_exception = false;
+    bool returned_from_algorithm = false;
+    try {
+        hpx::future<std::vector<element_type>::iterator> f =
+            hpx::parallel::stable_sort(p, boost::begin(c), boost::end(c),
+                [](element_type const&, element_type const&) -> bool
+                {
+                    throw std::runtime_error("test");
+                });
+        returned_from_algorithm = true;
+        f.get();
+
+        HPX_TEST(false);
+    }
+    catch (hpx::exception_list const&) {
+        caught_exception = true;
+    }
+    catch (...) {
+        HPX_TEST(false);
+    }
+
+    HPX_TEST(caught_exception);
+    HPX_TEST(returned_from_algorithm);
+}
+
+template <typename ExPolicy>
+void test_stable_sort_bad_alloc(ExPolicy policy, std::size_t size)
+{
+    static_assert(
+        hpx::parallel::is_execution_policy<ExPolicy>::value,
+        "hpx::parallel::is_execution_policy<ExPolicy>::value");
+
+    std::vector<element_type> c = make_test_data(size, 1000);
+
+    bool caught_bad_alloc = false;
+    try {
+        hpx::parallel::stable_sort(policy, boost::begin(c), boost::end(c),
+            [](element_type const&, element_type const&) -> bool
+            {
+                throw std::bad_alloc();
+            });
+        HPX_TEST(false);
+    }
+    catch (std::bad_alloc const&) {
+        caught_bad_alloc = true;
+    }
+    catch (...) {
+        HPX_TEST(false);
+    }
+
+    HPX_TEST(caught_bad_alloc);
+}
+
+template <typename ExPolicy>
+void test_stable_sort_bad_alloc_async(ExPolicy p, std::size_t size)
+{
+    std::vector<element_type> c = make_test_data(size, 1000);
+
+    bool caught_bad_alloc = false;
+    bool returned_from_algorithm = false;
+    try {
+        hpx::future<std::vector<element_type>::iterator> f =
+            hpx::parallel::stable_sort(p, boost::begin(c), boost::end(c),
+                [](element_type const&, element_type const&) -> bool
+                {
+                    throw std::bad_alloc();
+                });
+        returned_from_algorithm = true;
+        f.get();
+
+        HPX_TEST(false);
+    }
+    catch (std::bad_alloc const&) {
+        caught_bad_alloc = true;
+    }
+    catch (...) {
+        HPX_TEST(false);
+    }
+
+    HPX_TEST(caught_bad_alloc);
+    HPX_TEST(returned_from_algorithm);
+}
+
+void stable_sort_exception_test()
+{
+    using namespace hpx::parallel;
+
+    // the parallel versions split large sequences into several tasks
+    std::size_t const sizes[] = { 1000, 300007 };
+    for (std::size_t size : sizes)
+    {
+        test_stable_sort_exception(seq, size);
+        test_stable_sort_exception(par, size);
+
+        test_stable_sort_exception_async(seq(task), size);
+        test_stable_sort_exception_async(par(task), size);
+
+        test_stable_sort_bad_alloc(seq, size);
+        test_stable_sort_bad_alloc(par, size);
+
+        test_stable_sort_bad_alloc_async(seq(task), size);
+        test_stable_sort_bad_alloc_async(par(task), size);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    unsigned int seed = (unsigned int)std::time(nullptr);
+    if (vm.count("seed"))
+        seed = vm["seed"].as<unsigned int>();
+
+    std::cout << "using seed: " << seed << std::endl;
+    std::srand(seed);
+
+    stable_sort_test();
+    stable_sort_exception_test();
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // add command line option which controls the random number generator seed
+    using namespace boost::program_options;
+    options_description desc_commandline(
+        "Usage: " HPX_APPLICATION_STRING " [options]");
+
+    desc_commandline.add_options()
+        ("seed,s", value<unsigned int>(),
+        "the random number generator seed to use for this run")
+        ;
+
+    // By default this test should run on all available cores
+    std::vector<std::string> const cfg = {
+        "hpx.os_threads=all"
+    };
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(desc_commandline, argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,133 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// The algorithms process contiguous ranges in packs if they are invoked with
+// the parallel_vector_execution_policy. This verifies the pack kernels for
+// ranges which do not start at a pack boundary and whose size is not a
+// multiple of the pack size.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/parallel_copy.hpp>
+#include <hpx/include/parallel_count.hpp>
+#include <hpx/include/parallel_executor_parameters.hpp>
+#include <hpx/include/parallel_fill.hpp>
+#include <hpx/include/parallel_for_each.hpp>
+#include <hpx/include/parallel_inner_product.hpp>
+#include <hpx/include/parallel_reduce.hpp>
+#include <hpx/include/parallel_transform.hpp>
+#include <hpx/include/parallel_transform_reduce.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <numeric>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename ExPolicy>
+void test_vector_pack(ExPolicy policy, std::size_t offset, std::size_t size)
+{
+    typedef std::vector<std::size_t>::iterator iterator;
+
+    static_assert(
+        hpx::parallel::util::detail::is_vectorpack<ExPolicy, iterator>::value,
+        "hpx::parallel::util::detail::is_vectorpack<ExPolicy, iterator>::value");
+
+    std::vector<std::size_t> a(offset + size);
+    std::vector<std::size_t> b(offset + size);
+    std::vector<std::size_t> c(offset + size);
+
+    iterator a_first = a.begin() + offset, a_last = a.end();
+    iterator b_first = b.begin() + offset, b_last = b.end();
+    iterator c_first = c.begin() + offset;
+
+    // fill, for_each
+    hpx::parallel::fill(policy, a_first, a_last, std::size_t(1));
+    hpx::parallel::for_each(policy, a_first, a_last,
+        [](std::size_t& v) { v += 1; });
+    HPX_TEST_EQ(std::count(a_first, a_last, std::size_t(2)),
+        std::ptrdiff_t(size));
+
+    std::iota(a_first, a_last, std::size_t(0));
+
+    // transform, unary and binary
+    hpx::parallel::transform(policy, a_first, a_last, b_first,
+        [](std::size_t v) { return 2 * v; });
+    hpx::parallel::transform(policy, a_first, a_last, b_first, c_first,
+        std::plus<std::size_t>());
+    for (std::size_t i = 0; i != size; ++i)
+    {
+        HPX_TEST_EQ(b_first[i], 2 * i);
+        HPX_TEST_EQ(c_first[i], 3 * i);
+    }
+
+    // copy
+    hpx::parallel::copy(policy, a_first, a_last, c_first);
+    HPX_TEST(std::equal(a_first, a_last, c_first));
+
+    // reduce, transform_reduce, inner_product
+    std::size_t sum = size * (size - 1) / 2;
+    HPX_TEST_EQ(
+        hpx::parallel::reduce(policy, a_first, a_last, std::size_t(1)),
+        sum + 1);
+    HPX_TEST_EQ(
+        hpx::parallel::transform_reduce(policy, a_first, a_last,
+            [](std::size_t v) { return 3 * v; }, std::size_t(0),
+            std::plus<std::size_t>()),
+        3 * sum);
+    HPX_TEST_EQ(
+        hpx::parallel::inner_product(policy, a_first, a_last, b_first,
+            std::size_t(0)),
+        std::inner_product(a_first, a_last, b_first, std::size_t(0)));
+
+    // count, count_if
+    HPX_TEST_EQ(
+        hpx::parallel::count(policy, a_first, a_last, std::size_t(size / 2)),
+        std::ptrdiff_t(1));
+    HPX_TEST_EQ(
+        hpx::parallel::count_if(policy, b_first, b_last,
+            [](std::size_t v) { return v % 4 == 0; }),
+        std::ptrdiff_t((size + 1) / 2));
+}
+
+void test_vector_pack()
+{
+    using namespace hpx::parallel;
+
+    std::size_t const sizes[] = { 1, 7, 8, 17, 100, 10007 };
+    for (std::size_t size : sizes)
+    {
+        for (std::size_t offset = 0; offset != 3; ++offset)
+        {
+            test_vector_pack(par_vec, offset, size);
+            test_vector_pack(
+                par_vec.on(parallel_executor()).with(static_chunk_size(64)),
+                offset, size);
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    test_vector_pack();
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // By default this test should run on all available cores
+    std::vector<std::string> const cfg = {
+        "hpx.os_threads=all"
+    };
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
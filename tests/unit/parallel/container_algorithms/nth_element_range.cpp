@@ -0,0 +1,116 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/parallel_sort.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <boost/range/functions.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <ctime>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+std::vector<int> make_test_data(std::size_t size)
+{
+    std::vector<int> c(size);
+    for (int& val : c)
+        val = std::rand() % 1000;
+    return c;
+}
+
+template <typename ExPolicy>
+void test_nth_element(ExPolicy policy)
+{
+    static_assert(
+        hpx::parallel::is_execution_policy<ExPolicy>::value,
+        "hpx::parallel::is_execution_policy<ExPolicy>::value");
+
+    std::vector<int> c = make_test_data(100007);
+    std::vector<int> d = c;
+
+    std::size_t nth = std::rand() % c.size();
+    auto result = hpx::parallel::nth_element(policy, c,
+        boost::begin(c) + nth, std::greater<int>());
+    std::sort(boost::begin(d), boost::end(d), std::greater<int>());
+
+    HPX_TEST(result == boost::end(c));
+    HPX_TEST_EQ(c[nth], d[nth]);
+    HPX_TEST(std::all_of(boost::begin(c), boost::begin(c) + nth,
+        [&](int v) { return v >= d[nth]; }));
+    HPX_TEST(std::all_of(boost::begin(c) + nth, boost::end(c),
+        [&](int v) { return v <= d[nth]; }));
+}
+
+template <typename ExPolicy>
+void test_nth_element_async(ExPolicy p)
+{
+    std::vector<int> c = make_test_data(100007);
+    std::vector<int> d = c;
+
+    std::size_t nth = c.size() / 2;
+    auto f = hpx::parallel::nth_element(p, c, boost::begin(c) + nth);
+    std::sort(boost::begin(d), boost::end(d));
+
+    HPX_TEST(f.get() == boost::end(c));
+    HPX_TEST_EQ(c[nth], d[nth]);
+}
+
+void nth_element_test()
+{
+    using namespace hpx::parallel;
+
+    test_nth_element(seq);
+    test_nth_element(par);
+    test_nth_element(par_vec);
+
+    test_nth_element_async(seq(task));
+    test_nth_element_async(par(task));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    unsigned int seed = (unsigned int)std::time(nullptr);
+    if (vm.count("seed"))
+        seed = vm["seed"].as<unsigned int>();
+
+    std::cout << "using seed: " << seed << std::endl;
+    std::srand(seed);
+
+    nth_element_test();
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // add command line option which controls the random number generator seed
+    using namespace boost::program_options;
+    options_description desc_commandline(
+        "Usage: " HPX_APPLICATION_STRING " [options]");
+
+    desc_commandline.add_options()
+        ("seed,s", value<unsigned int>(),
+        "the random number generator seed to use for this run")
+        ;
+
+    // By default this test should run on all available cores
+    std::vector<std::string> const cfg = {
+        "hpx.os_threads=all"
+    };
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(desc_commandline, argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,139 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/parallel_sort.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <boost/range/functions.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <ctime>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+std::vector<int> make_test_data(std::size_t size)
+{
+    std::vector<int> c(size);
+    for (int& val : c)
+        val = std::rand() % 1000;
+    return c;
+}
+
+template <typename ExPolicy>
+void test_partial_sort(ExPolicy policy)
+{
+    static_assert(
+        hpx::parallel::is_execution_policy<ExPolicy>::value,
+        "hpx::parallel::is_execution_policy<ExPolicy>::value");
+
+    std::vector<int> c = make_test_data(100007);
+    std::vector<int> d = c;
+
+    std::size_t middle = 1000;
+    auto result = hpx::parallel::partial_sort(policy, c,
+        boost::begin(c) + middle);
+    std::sort(boost::begin(d), boost::end(d));
+
+    HPX_TEST(result == boost::end(c));
+    HPX_TEST(std::equal(boost::begin(c), boost::begin(c) + middle,
+        boost::begin(d)));
+}
+
+template <typename ExPolicy>
+void test_partial_sort_copy(ExPolicy policy)
+{
+    std::vector<int> c = make_test_data(100007);
+    std::vector<int> dest(1000);
+    std::vector<int> d(1000);
+
+    auto result = hpx::parallel::partial_sort_copy(policy, c, dest,
+        std::greater<int>());
+    std::partial_sort_copy(boost::begin(c), boost::end(c),
+        boost::begin(d), boost::end(d), std::greater<int>());
+
+    HPX_TEST(result == boost::end(dest));
+    HPX_TEST(dest == d);
+}
+
+template <typename ExPolicy>
+void test_partial_sort_async(ExPolicy p)
+{
+    std::vector<int> c = make_test_data(100007);
+    std::vector<int> dest(1000);
+    std::vector<int> d(1000);
+
+    auto f = hpx::parallel::partial_sort_copy(p, c, dest);
+    std::partial_sort_copy(boost::begin(c), boost::end(c),
+        boost::begin(d), boost::end(d));
+
+    HPX_TEST(f.get() == boost::end(dest));
+    HPX_TEST(dest == d);
+
+    auto f2 = hpx::parallel::partial_sort(p, c, boost::begin(c) + 1000);
+    HPX_TEST(f2.get() == boost::end(c));
+    HPX_TEST(std::equal(boost::begin(c), boost::begin(c) + 1000,
+        boost::begin(d)));
+}
+
+void partial_sort_test()
+{
+    using namespace hpx::parallel;
+
+    test_partial_sort(seq);
+    test_partial_sort(par);
+    test_partial_sort(par_vec);
+
+    test_partial_sort_copy(seq);
+    test_partial_sort_copy(par);
+    test_partial_sort_copy(par_vec);
+
+    test_partial_sort_async(seq(task));
+    test_partial_sort_async(par(task));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    unsigned int seed = (unsigned int)std::time(nullptr);
+    if (vm.count("seed"))
+        seed = vm["seed"].as<unsigned int>();
+
+    std::cout << "using seed: " << seed << std::endl;
+    std::srand(seed);
+
+    partial_sort_test();
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // add command line option which controls the random number generator seed
+    using namespace boost::program_options;
+    options_description desc_commandline(
+        "Usage: " HPX_APPLICATION_STRING " [options]");
+
+    desc_commandline.add_options()
+        ("seed,s", value<unsigned int>(),
+        "the random number generator seed to use for this run")
+        ;
+
+    // By default this test should run on all available cores
+    std::vector<std::string> const cfg = {
+        "hpx.os_threads=all"
+    };
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(desc_commandline, argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
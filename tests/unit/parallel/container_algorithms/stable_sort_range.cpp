@@ -0,0 +1,123 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/parallel_sort.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <boost/range/functions.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <ctime>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+std::vector<int> make_test_data(std::size_t size)
+{
+    std::vector<int> c(size);
+    for (int& val : c)
+        val = std::rand() % 1000;
+    return c;
+}
+
+typedef std::pair<int, std::size_t> element_type;
+
+template <typename ExPolicy>
+void test_stable_sort(ExPolicy policy)
+{
+    static_assert(
+        hpx::parallel::is_execution_policy<ExPolicy>::value,
+        "hpx::parallel::is_execution_policy<ExPolicy>::value");
+
+    std::vector<int> values = make_test_data(100007);
+    std::vector<element_type> c;
+    c.reserve(values.size());
+    for (std::size_t i = 0; i != values.size(); ++i)
+        c.push_back(element_type(values[i], i));
+    std::vector<element_type> d = c;
+
+    // sort by the first member only, the original position must be
+    // preserved for equal keys
+    auto result = hpx::parallel::stable_sort(policy, c, std::less<int>(),
+        [](element_type const& e) { return e.first; });
+    std::stable_sort(boost::begin(d), boost::end(d),
+        [](element_type const& lhs, element_type const& rhs)
+        {
+            return lhs.first < rhs.first;
+        });
+
+    HPX_TEST(result == boost::end(c));
+    HPX_TEST(c == d);
+}
+
+template <typename ExPolicy>
+void test_stable_sort_async(ExPolicy p)
+{
+    std::vector<int> c = make_test_data(100007);
+    std::vector<int> d = c;
+
+    auto f = hpx::parallel::stable_sort(p, c, std::greater<int>());
+    std::stable_sort(boost::begin(d), boost::end(d), std::greater<int>());
+
+    HPX_TEST(f.get() == boost::end(c));
+    HPX_TEST(c == d);
+}
+
+void stable_sort_test()
+{
+    using namespace hpx::parallel;
+
+    test_stable_sort(seq);
+    test_stable_sort(par);
+    test_stable_sort(par_vec);
+
+    test_stable_sort_async(seq(task));
+    test_stable_sort_async(par(task));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    unsigned int seed = (unsigned int)std::time(nullptr);
+    if (vm.count("seed"))
+        seed = vm["seed"].as<unsigned int>();
+
+    std::cout << "using seed: " << seed << std::endl;
+    std::srand(seed);
+
+    stable_sort_test();
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // add command line option which controls the random number generator seed
+    using namespace boost::program_options;
+    options_description desc_commandline(
+        "Usage: " HPX_APPLICATION_STRING " [options]");
+
+    desc_commandline.add_options()
+        ("seed,s", value<unsigned int>(),
+        "the random number generator seed to use for this run")
+        ;
+
+    // By default this test should run on all available cores
+    std::vector<std::string> const cfg = {
+        "hpx.os_threads=all"
+    };
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(desc_commandline, argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
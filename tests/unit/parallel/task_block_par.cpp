@@ -9,6 +9,9 @@
 #include <hpx/include/parallel_task_block.hpp>
 #include <hpx/util/lightweight_test.hpp>
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -125,12 +128,45 @@ void define_task_block_exceptions_test2()
     }
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// recursive fork/join, most of the tasks are executed by the thread owning
+// their task block, the others are stolen by helper threads
+std::uint64_t fib(std::uint64_t n)
+{
+    if (n < 2)
+        return n;
+
+    std::uint64_t n1 = 0, n2 = 0;
+    define_task_block([&](task_block<>& trh)
+    {
+        trh.run([&]() { n1 = fib(n - 1); });
+        n2 = fib(n - 2);
+    });
+    return n1 + n2;
+}
+
+void define_task_block_recursive_test()
+{
+    HPX_TEST_EQ(fib(22), std::uint64_t(17711));
+
+    std::atomic<std::size_t> count(0);
+    define_task_block([&](task_block<>& trh)
+    {
+        for (std::size_t i = 0; i != 10000; ++i)
+        {
+            trh.run([&]() { ++count; });
+        }
+    });
+    HPX_TEST_EQ(count.load(), std::size_t(10000));
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int hpx_main()
 {
     define_task_block_test();
     define_task_block_exceptions_test1();
     define_task_block_exceptions_test2();
+    define_task_block_recursive_test();
 
     return hpx::finalize();
 }
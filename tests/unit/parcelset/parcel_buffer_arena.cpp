@@ -0,0 +1,125 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// The memory of the parcel buffers is recycled after the parcels have been
+// sent or decoded. This verifies that recycled buffers are handed out again
+// and that the arena counters reflect the traffic.
+
+#include <hpx/hpx.hpp>
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/performance_counters.hpp>
+#include <hpx/runtime/parcelset/detail/buffer_arena.hpp>
+#include <hpx/runtime/parcelset/parcel_buffer.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <boost/cstdint.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+std::size_t echo(std::vector<char> const& data)
+{
+    return data.size();
+}
+HPX_PLAIN_ACTION(echo);
+
+///////////////////////////////////////////////////////////////////////////////
+void test_reuse()
+{
+    using hpx::parcelset::detail::get_buffer_arena_hits;
+    using hpx::parcelset::detail::get_buffer_arena_misses;
+
+    typedef hpx::parcelset::parcel_buffer<std::vector<char> > buffer_type;
+
+    buffer_type buffer;
+    buffer.reserve_data(1000);
+    HPX_TEST(buffer.data_.capacity() >= 1000);
+
+    buffer.data_.resize(1000);
+    buffer.recycle();
+
+    HPX_TEST(buffer.data_.empty());
+    HPX_TEST_EQ(buffer.data_.capacity(), std::size_t(0));
+
+    // a buffer of the same size class is taken from the arena (other
+    // threads may use the arena concurrently)
+    boost::int64_t hits = get_buffer_arena_hits(false);
+
+    buffer_type other;
+    other.reserve_data(600);
+    HPX_TEST(other.data_.capacity() >= 600);
+    HPX_TEST(get_buffer_arena_hits(false) > hits);
+
+    // buffers exceeding the largest size class are not recycled
+    boost::int64_t misses = get_buffer_arena_misses(false);
+
+    std::size_t const huge = 0x2000000;
+    other.recycle();
+    other.reserve_data(huge);
+    HPX_TEST(other.data_.capacity() >= huge);
+    HPX_TEST(get_buffer_arena_misses(false) > misses);
+
+    other.recycle();
+    HPX_TEST_EQ(other.data_.capacity(), std::size_t(0));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+boost::int64_t query_counter(std::string const& name,
+    hpx::id_type const& locality)
+{
+    using hpx::performance_counters::performance_counter;
+
+    performance_counter counter(
+        "/parcels{locality#" +
+            std::to_string(hpx::naming::get_locality_id_from_id(locality)) +
+            "/total}/count/arena/" + name);
+
+    return counter.get_value_sync<boost::int64_t>();
+}
+
+void test_counters(hpx::id_type const& id)
+{
+    std::size_t const sizes[] = { 16, 1000, 100000 };
+    for (std::size_t size : sizes)
+    {
+        for (std::size_t i = 0; i != 100; ++i)
+        {
+            HPX_TEST_EQ(echo_action()(id, std::vector<char>(size)), size);
+        }
+    }
+
+    // the buffers of later parcels are taken from the arena on both ends
+    HPX_TEST(query_counter("hits", hpx::find_here()) != 0);
+    HPX_TEST(query_counter("misses", hpx::find_here()) != 0);
+    HPX_TEST(query_counter("hits", id) != 0);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    test_reuse();
+
+    for (hpx::id_type const& id : hpx::find_remote_localities())
+    {
+        test_counters(id);
+    }
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // explicitly disable message handlers (parcel coalescing)
+    std::vector<std::string> const cfg = {
+        "hpx.parcel.message_handlers=0"
+    };
+
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
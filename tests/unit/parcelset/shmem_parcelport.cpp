@@ -0,0 +1,121 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Smoke test for the shared memory parcelport: echo messages of all sizes
+// between two localities on the same node. Small messages are copied through
+// the ring, large chunks are handed over through the slab, and chunks which
+// do not fit into the slab are streamed through the ring.
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/runtime/parcelset/parcelhandler.hpp>
+#include <hpx/runtime/serialization/serialize_buffer.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+typedef hpx::serialization::serialize_buffer<char> buffer_type;
+
+///////////////////////////////////////////////////////////////////////////////
+buffer_type echo(buffer_type const& buffer)
+{
+    return buffer;
+}
+HPX_PLAIN_ACTION(echo);     // defines echo_action
+
+std::vector<char> echo_vector(std::vector<char> const& data)
+{
+    return data;
+}
+HPX_PLAIN_ACTION(echo_vector);
+
+///////////////////////////////////////////////////////////////////////////////
+buffer_type make_buffer(std::size_t size, std::size_t seed)
+{
+    buffer_type buffer(size);
+    for (std::size_t i = 0; i != size; ++i)
+        buffer[i] = static_cast<char>((i * 7 + seed) & 0xff);
+    return buffer;
+}
+
+bool equal(buffer_type const& lhs, buffer_type const& rhs)
+{
+    if (lhs.size() != rhs.size())
+        return false;
+
+    for (std::size_t i = 0; i != lhs.size(); ++i)
+    {
+        if (lhs[i] != rhs[i])
+            return false;
+    }
+    return true;
+}
+
+void test_echo(hpx::id_type const& id, std::size_t size)
+{
+    buffer_type buffer = make_buffer(size, size);
+    HPX_TEST(equal(hpx::async<echo_action>(id, buffer).get(), buffer));
+}
+
+// keep many messages in flight to wrap around the ring and to exhaust the
+// slab
+void test_echo_many(hpx::id_type const& id, std::size_t size,
+    std::size_t count)
+{
+    std::vector<buffer_type> buffers;
+    std::vector<hpx::future<buffer_type> > results;
+    buffers.reserve(count);
+    results.reserve(count);
+
+    for (std::size_t i = 0; i != count; ++i)
+    {
+        buffers.push_back(make_buffer(size, i));
+        results.push_back(hpx::async<echo_action>(id, buffers.back()));
+    }
+
+    for (std::size_t i = 0; i != count; ++i)
+        HPX_TEST(equal(results[i].get(), buffers[i]));
+}
+
+void test_echo_vector(hpx::id_type const& id)
+{
+    std::vector<char> data(1000);
+    for (std::size_t i = 0; i != data.size(); ++i)
+        data[i] = static_cast<char>(i & 0xff);
+
+    HPX_TEST(hpx::async<echo_vector_action>(id, data).get() == data);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    // make sure the parcels are really sent through shared memory
+    HPX_TEST_EQ(hpx::get_config_entry("hpx.parcel.shmem.enable", "0"),
+        std::string("1"));
+    HPX_TEST(hpx::get_runtime().get_parcel_handler().endpoints().count(
+        "shmem") != 0);
+
+    std::vector<hpx::id_type> localities = hpx::find_remote_localities();
+    HPX_TEST(!localities.empty());
+
+    for (hpx::id_type const& id : localities)
+    {
+        test_echo_vector(id);
+
+        // below the slab threshold and in the slab
+        for (std::size_t size = 1; size <= 4 * 1024 * 1024; size *= 4)
+            test_echo(id, size);
+
+        // too large for the default slab of 256 blocks of 64KB
+        test_echo(id, 24 * 1024 * 1024);
+
+        test_echo_many(id, 100, 1000);
+        test_echo_many(id, 1024 * 1024, 64);
+    }
+
+    return hpx::util::report_errors();
+}
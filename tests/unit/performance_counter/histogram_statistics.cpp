@@ -0,0 +1,118 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Record samples into a sample source and verify the percentiles and the
+// histogram reported by the corresponding statistics counters.
+
+#include <hpx/hpx.hpp>
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/performance_counters.hpp>
+#include <hpx/performance_counters/sample_source.hpp>
+#include <hpx/util/lightweight_test.hpp>
+#include <hpx/util/sharded_histogram.hpp>
+
+#include <boost/cstdint.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+hpx::util::sharded_histogram samples(4);
+
+std::string statistics_counter(char const* statistic)
+{
+    return "/statistics{/test{locality#" +
+        std::to_string(hpx::get_locality_id()) + "/total}/samples}/" +
+        statistic;
+}
+
+void test_sharded_histogram()
+{
+    typedef hpx::util::sharded_histogram histogram;
+
+    // every value falls into its own bucket and the buckets are contiguous
+    for (std::size_t i = 0; i + 1 != histogram::num_buckets; ++i)
+    {
+        HPX_TEST_EQ(histogram::bucket_index(histogram::bucket_lower_bound(i)),
+            i);
+        HPX_TEST_EQ(histogram::bucket_upper_bound(i) + 1,
+            histogram::bucket_lower_bound(i + 1));
+    }
+    HPX_TEST_EQ(histogram::bucket_index(~boost::uint64_t(0)),
+        std::size_t(histogram::num_buckets - 1));
+}
+
+void test_percentiles()
+{
+    using hpx::performance_counters::performance_counter;
+
+    performance_counter p50(statistics_counter("p50"));
+    performance_counter p99(statistics_counter("p99"));
+
+    for (boost::uint64_t i = 1; i <= 1000; ++i)
+        samples.record(i);
+
+    // the relative error is bounded by 1/16
+    boost::int64_t median = p50.get_value_sync<boost::int64_t>();
+    HPX_TEST(median >= 500 && median <= 500 + 500 / 16);
+
+    boost::int64_t tail = p99.get_value_sync<boost::int64_t>(true);
+    HPX_TEST(tail >= 990 && tail <= 990 + 990 / 16);
+
+    // after the reset only the new samples are taken into account
+    for (std::size_t i = 0; i != 100; ++i)
+        samples.record(10);
+    HPX_TEST_EQ(p99.get_value_sync<boost::int64_t>(), 10);
+}
+
+void test_histogram()
+{
+    using hpx::performance_counters::performance_counter;
+
+    performance_counter histogram(
+        statistics_counter("histogram@1000,0,100,10"));
+
+    for (std::size_t i = 0; i != 100; ++i)
+        samples.record(5);
+    for (std::size_t i = 0; i != 100; ++i)
+        samples.record(1000);
+
+    hpx::performance_counters::counter_values_array values =
+        histogram.get_counter_values_array_sync(true);
+
+    // boundaries, underflow bucket, ten buckets, and overflow bucket
+    HPX_TEST_EQ(values.values_.size(), std::size_t(3 + 12));
+    HPX_TEST_EQ(values.values_[0], 0);
+    HPX_TEST_EQ(values.values_[1], 100);
+    HPX_TEST_EQ(values.values_[2], 10);
+
+    boost::int64_t total = 0;
+    for (std::size_t i = 3; i != values.values_.size(); ++i)
+        total += values.values_[i];
+    HPX_TEST(total >= 990 && total <= 1000);
+
+    HPX_TEST(values.values_[3 + 1] > 0);            // first bucket
+    HPX_TEST(values.values_.back() > 0);            // overflow bucket
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(int argc, char ** argv)
+{
+    hpx::performance_counters::install_sample_source("/test/samples",
+        samples, "test samples");
+
+    test_sharded_histogram();
+    test_percentiles();
+    test_histogram();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char **argv)
+{
+    HPX_TEST_EQ(hpx::init(argc, argv), 0);
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,104 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/runtime/serialization/serialize.hpp>
+#include <hpx/runtime/serialization/base_object.hpp>
+#include <hpx/runtime/serialization/detail/polymorphic_id_factory.hpp>
+#include <hpx/runtime/serialization/unique_ptr.hpp>
+
+#include <hpx/runtime/serialization/input_archive.hpp>
+#include <hpx/runtime/serialization/output_archive.hpp>
+
+#include <hpx/util/lightweight_test.hpp>
+
+#include <memory>
+#include <vector>
+
+// Types derived from a base exposing 'serialized_with_id' are sent using
+// the id all localities agree on during startup, or by name as long as no
+// id has been assigned.
+struct A
+{
+    typedef void serialized_with_id;
+
+    A() : a(8) {}
+    virtual ~A() {}
+
+    virtual int f() const = 0;
+
+    int a;
+
+    template <typename Archive>
+    void serialize(Archive & ar, unsigned)
+    {
+        ar & a;
+    }
+    HPX_SERIALIZATION_POLYMORPHIC_ABSTRACT(A);
+};
+
+struct B : A
+{
+    B() : b(6) {}
+    explicit B(int i) : b(i) {}
+
+    int f() const { return b; }
+
+    int b;
+
+    template <typename Archive>
+    void serialize(Archive & ar, unsigned)
+    {
+        ar & hpx::serialization::base_object<A>(*this);
+        ar & b;
+    }
+    HPX_SERIALIZATION_POLYMORPHIC(B);
+};
+
+std::size_t round_trip(int value)
+{
+    std::vector<char> buffer;
+    {
+        hpx::serialization::output_archive oarchive(buffer);
+        std::unique_ptr<A> op(new B(value));
+        oarchive << op;
+    }
+
+    std::unique_ptr<A> ip;
+    {
+        hpx::serialization::input_archive iarchive(buffer);
+        iarchive >> ip;
+    }
+
+    HPX_TEST(ip);
+    HPX_TEST(dynamic_cast<B*>(ip.get()) != nullptr);
+    HPX_TEST_EQ(ip->a, 8);
+    HPX_TEST_EQ(ip->f(), value);
+
+    return buffer.size();
+}
+
+int main()
+{
+    using hpx::serialization::detail::id_registry;
+
+    // no ids have been assigned yet, the type name is sent instead
+    HPX_TEST_EQ(id_registry::instance().try_get_id(
+        B::hpx_serialization_get_name_impl()), id_registry::invalid_id);
+    std::size_t by_name = round_trip(42);
+
+    // this is done by the runtime during startup
+    id_registry::instance().fill_missing_typenames();
+    HPX_TEST_NEQ(id_registry::instance().try_get_id(
+        B::hpx_serialization_get_name_impl()), id_registry::invalid_id);
+    std::size_t by_id = round_trip(43);
+
+#if !defined(HPX_DEBUG)
+    HPX_TEST_LT(by_id, by_name);
+#else
+    HPX_TEST_EQ(by_id, by_name);
+#endif
+
+    return hpx::util::report_errors();
+}
@@ -11,6 +11,8 @@
 #include <hpx/util/lightweight_test.hpp>
 #include <hpx/runtime/serialization/serialize_buffer.hpp>
 
+#include <algorithm>
+#include <cstring>
 #include <memory>
 #include <vector>
 
@@ -127,6 +129,68 @@ void test_initialization_from_vector(std::size_t max_size)
     }
 }
 
+// Zero-copy chunks which are owned by the receiving side are referred to by
+// the deserialized buffer instead of being copied.
+template <typename T>
+void test_shared_chunk_adoption(std::size_t size)
+{
+    typedef hpx::serialization::serialize_buffer<T> buffer_type;
+
+    buffer_type send_buffer(size);
+    for (std::size_t i = 0; i != size; ++i)
+        send_buffer[i] = T(i);
+
+    std::vector<char> out_buffer;
+    std::vector<hpx::serialization::serialization_chunk> chunks;
+    {
+        hpx::serialization::output_archive archive(out_buffer, 0, 0, &chunks);
+        archive << send_buffer;
+    }
+
+    // move the pointer chunks into separately owned memory, just like the
+    // parcelports do on receipt
+    std::vector<std::shared_ptr<void> > owners(chunks.size());
+    for (std::size_t i = 0; i != chunks.size(); ++i)
+    {
+        if (chunks[i].type_ != hpx::serialization::chunk_type_pointer)
+            continue;
+
+        std::size_t chunk_size = chunks[i].size_;
+        std::shared_ptr<char> data(new char[chunk_size],
+            std::default_delete<char[]>());
+        std::memcpy(data.get(), chunks[i].data_.cpos_, chunk_size);
+
+        chunks[i] = hpx::serialization::create_pointer_chunk(
+            data.get(), chunk_size);
+        owners[i] = data;
+    }
+
+    buffer_type recv_buffer;
+    {
+        hpx::serialization::input_archive archive(
+            out_buffer, out_buffer.size(), &chunks, &owners);
+        archive >> recv_buffer;
+    }
+
+    HPX_TEST_EQ(recv_buffer.size(), size);
+    HPX_TEST(std::equal(send_buffer.begin(), send_buffer.end(),
+        recv_buffer.begin()));
+
+    if (size * sizeof(T) >= HPX_ZERO_COPY_SERIALIZATION_THRESHOLD)
+    {
+        bool adopted = false;
+        for (std::shared_ptr<void> const& owner : owners)
+        {
+            if (owner.get() == static_cast<void*>(recv_buffer.data()))
+            {
+                adopted = true;
+                HPX_TEST_LT(1, owner.use_count());
+            }
+        }
+        HPX_TEST(adopted);
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int hpx_main(int argc, char* argv[])
 {
@@ -150,6 +214,9 @@ int hpx_main(int argc, char* argv[])
         test_fixed_size_initialization_for_persistent_buffers<char>(size);
         test_fixed_size_initialization_for_persistent_buffers<float>(size);
         test_fixed_size_initialization_for_persistent_buffers<double>(size);
+
+        test_shared_chunk_adoption<char>(size);
+        test_shared_chunk_adoption<double>(size);
     }
 
     return hpx::finalize();
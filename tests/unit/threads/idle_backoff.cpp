@@ -0,0 +1,89 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Idle worker threads park themselves with a growing timeout. After a few
+// seconds without any work this timeout is much larger than the latencies
+// checked here, which therefore hold only if a parked worker thread is woken
+// by new work and by the deadline of a timer armed on it.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+// time to stay idle before measuring
+std::chrono::seconds const idle_time(5);
+
+// maximal acceptable latency
+std::chrono::milliseconds const max_latency(50);
+
+///////////////////////////////////////////////////////////////////////////////
+// work scheduled from outside the runtime wakes a parked worker thread
+void test_wake_on_work()
+{
+    hpx::lcos::local::promise<void> p;
+    hpx::future<void> f = p.get_future();
+
+    std::chrono::steady_clock::time_point set_time;
+    std::thread t(
+        [&]()
+        {
+            std::this_thread::sleep_for(idle_time);
+            set_time = std::chrono::steady_clock::now();
+            p.set_value();
+        });
+
+    // no work is left while this thread waits for the value
+    f.get();
+    std::chrono::steady_clock::duration latency =
+        std::chrono::steady_clock::now() - set_time;
+
+    t.join();
+
+    HPX_TEST(latency < max_latency);
+}
+
+// a parked worker thread does not oversleep the next timer armed on it
+void test_wake_on_timer()
+{
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+
+    hpx::this_thread::sleep_for(idle_time);
+
+    std::chrono::steady_clock::duration elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    HPX_TEST(elapsed >= idle_time);
+    HPX_TEST(elapsed < idle_time + max_latency);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    test_wake_on_work();
+    test_wake_on_timer();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // let the timeout of parked worker threads grow far beyond the
+    // checked latencies
+    std::vector<std::string> const cfg = {
+        "hpx.max_idle_backoff_time=10000"
+    };
+
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,183 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Exercise the pool for coroutine stacks directly (without running the
+// runtime): reuse of released stacks, trimming of stacks released above the
+// high-water mark, and the layout of the guard pages in a slab.
+
+#include <hpx/config.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#if defined(HPX_HAVE_THREAD_STACK_MMAP)
+#include <hpx/runtime/threads/coroutines/detail/posix_utility.hpp>
+#include <hpx/runtime/threads/coroutines/detail/stack_pool.hpp>
+
+#include <boost/cstdint.hpp>
+
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <csignal>
+#include <cstddef>
+#include <vector>
+
+namespace posix = hpx::threads::coroutines::detail::posix;
+
+// every test uses its own stack size to get its own size class, the
+// runtime is not running and does not use any of these sizes
+std::size_t const page_size = EXEC_PAGESIZE;
+
+///////////////////////////////////////////////////////////////////////////////
+void fill(char* stack, std::size_t size, char value)
+{
+    for (std::size_t i = 0; i != size; ++i)
+        stack[i] = static_cast<char>(value + i);
+}
+
+bool check(char const* stack, std::size_t size, char value)
+{
+    for (std::size_t i = 0; i != size; ++i)
+    {
+        if (stack[i] != static_cast<char>(value + i))
+            return false;
+    }
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// a released stack is handed out again by the same OS-thread
+void test_reuse()
+{
+    std::size_t const size = 5 * page_size;
+
+    void* stack = posix::pool_alloc_stack(size);
+    HPX_TEST(stack != nullptr);
+    fill(static_cast<char*>(stack), size, 1);
+
+    boost::uint64_t reused = posix::get_stack_reuse_count(false);
+
+    HPX_TEST(posix::pool_free_stack(stack, size));
+    void* again = posix::pool_alloc_stack(size);
+
+    HPX_TEST_EQ(again, stack);
+    HPX_TEST_EQ(posix::get_stack_reuse_count(false), reused + 1);
+
+    HPX_TEST(posix::pool_free_stack(again, size));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// a stack released above the high-water mark is trimmed and moved to the
+// global pool, it is handed out again once the slab is used up
+void test_trim()
+{
+    std::size_t const size = 7 * page_size;
+    std::size_t const high_water_mark = posix::stack_pool_high_water_mark;
+    posix::stack_pool_high_water_mark = 0;
+
+    void* stack = posix::pool_alloc_stack(size);
+    HPX_TEST(stack != nullptr);
+    fill(static_cast<char*>(stack), size, 2);
+
+    boost::uint64_t trimmed = posix::get_stack_trim_count(false);
+    HPX_TEST(posix::pool_free_stack(stack, size));
+    HPX_TEST_EQ(posix::get_stack_trim_count(false), trimmed + 1);
+
+    // the remainder of the slab is used first
+    boost::uint64_t reused = posix::get_stack_reuse_count(false);
+    std::vector<void*> stacks;
+    void* again = nullptr;
+    while (again != stack && stacks.size() != 1000)
+    {
+        again = posix::pool_alloc_stack(size);
+        HPX_TEST(again != nullptr);
+        stacks.push_back(again);
+    }
+    HPX_TEST_EQ(again, stack);
+    HPX_TEST_EQ(posix::get_stack_reuse_count(false), reused + 1);
+
+    // the trimmed stack is still usable
+    fill(static_cast<char*>(stack), size, 3);
+    HPX_TEST(check(static_cast<char*>(stack), size, 3));
+
+    posix::stack_pool_high_water_mark = high_water_mark;
+    for (void* s : stacks)
+        HPX_TEST(posix::pool_free_stack(s, size));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// return whether writing to the given address kills the process
+bool faults(char* p)
+{
+    pid_t pid = ::fork();
+    if (pid == 0)
+    {
+        *static_cast<char volatile*>(p) = 1;
+        ::_exit(0);
+    }
+
+    int status = 0;
+    HPX_TEST(pid > 0 && ::waitpid(pid, &status, 0) == pid);
+    return WIFSIGNALED(status) &&
+        (WTERMSIG(status) == SIGSEGV || WTERMSIG(status) == SIGBUS);
+}
+
+// the stacks of a slab are laid out as [guard|stack 0|guard|stack 1|...]
+void test_guard_pages()
+{
+    std::size_t const size = 3 * page_size;
+
+    char* stack0 = static_cast<char*>(posix::pool_alloc_stack(size));
+    char* stack1 = static_cast<char*>(posix::pool_alloc_stack(size));
+    HPX_TEST(stack0 != nullptr && stack1 != nullptr);
+
+    fill(stack0, size, 4);
+    fill(stack1, size, 5);
+
+#if defined(HPX_HAVE_THREAD_GUARD_PAGE)
+    if (posix::use_guard_pages)
+    {
+        // the guard page below stack 1 sits directly above stack 0
+        HPX_TEST_EQ(stack0 + size + page_size, stack1);
+
+        HPX_TEST(faults(stack0 - 1));
+        HPX_TEST(faults(stack1 - 1));
+        HPX_TEST(faults(stack1 - page_size));
+        HPX_TEST(!faults(stack0));
+        HPX_TEST(!faults(stack0 + size - 1));
+    }
+    else
+#endif
+    {
+        HPX_TEST_EQ(stack0 + size, stack1);
+    }
+
+    HPX_TEST(check(stack0, size, 4));
+    HPX_TEST(check(stack1, size, 5));
+
+    HPX_TEST(posix::pool_free_stack(stack1, size));
+    HPX_TEST(posix::pool_free_stack(stack0, size));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    test_reuse();
+    test_trim();
+    test_guard_pages();
+
+    posix::flush_stack_pool();
+
+    return hpx::util::report_errors();
+}
+
+#else
+
+int main()
+{
+    return hpx::util::report_errors();
+}
+
+#endif
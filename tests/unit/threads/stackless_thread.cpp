@@ -0,0 +1,101 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/actions.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/include/thread_executors.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/runtime/threads/thread_data.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// stackless threads run on the stack of the worker thread, they still have a
+// thread id
+std::size_t test_stackless(std::size_t i)
+{
+    HPX_TEST(hpx::threads::get_self_ptr());
+    HPX_TEST(hpx::threads::get_self().is_stackless());
+    HPX_TEST(hpx::threads::get_self_id() != hpx::threads::invalid_thread_id);
+    HPX_TEST_EQ(hpx::threads::get_self_id()->get_stack_size(),
+        std::ptrdiff_t(hpx::threads::thread_stacksize_nostack));
+
+    return i;
+}
+HPX_DECLARE_ACTION(test_stackless, test_stackless_action)
+HPX_ACTION_USES_NO_STACK(test_stackless_action)
+HPX_PLAIN_ACTION(test_stackless, test_stackless_action)
+
+void test_stackless_executor()
+{
+    hpx::threads::executors::default_executor exec(
+        hpx::threads::thread_stacksize_nostack);
+
+    std::vector<hpx::future<std::size_t> > results;
+    results.reserve(1000);
+    for (std::size_t i = 0; i != 1000; ++i)
+        results.push_back(hpx::async(exec, &test_stackless, i));
+
+    for (std::size_t i = 0; i != 1000; ++i)
+        HPX_TEST_EQ(results[i].get(), i);
+}
+
+void test_nostack_action()
+{
+    test_stackless_action act;
+    HPX_TEST_EQ(hpx::async(act, hpx::find_here(), 42).get(), std::size_t(42));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// stackless threads which try to suspend or yield fail
+template <typename F>
+void test_stackless_fails(F && f)
+{
+    hpx::threads::executors::default_executor exec(
+        hpx::threads::thread_stacksize_nostack);
+
+    hpx::future<void> fut = hpx::async(exec, std::forward<F>(f));
+
+    bool caught_exception = false;
+    try {
+        fut.get();
+    }
+    catch (hpx::exception const& e) {
+        HPX_TEST_EQ(e.get_error(), hpx::invalid_status);
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+}
+
+void test_stackless_suspend()
+{
+    test_stackless_fails(
+        []()
+        {
+            hpx::this_thread::sleep_for(std::chrono::milliseconds(1));
+        });
+
+    test_stackless_fails(
+        []()
+        {
+            hpx::this_thread::yield();
+        });
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    test_stackless_executor();
+    test_nostack_action();
+    test_stackless_suspend();
+
+    return hpx::util::report_errors();
+}
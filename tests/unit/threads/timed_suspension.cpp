@@ -0,0 +1,127 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/lcos/local/condition_variable.hpp>
+#include <hpx/lcos/local/latch.hpp>
+#include <hpx/lcos/local/mutex.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#define NUM_TIMERS 1000
+
+///////////////////////////////////////////////////////////////////////////////
+// every timed suspension has to last at least as long as requested
+void test_sleep_for(std::chrono::milliseconds duration)
+{
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+
+    hpx::this_thread::sleep_for(duration);
+
+    HPX_TEST(std::chrono::steady_clock::now() - start >= duration);
+}
+
+void test_sleep()
+{
+    std::vector<hpx::future<void> > finished;
+    finished.reserve(NUM_TIMERS);
+
+    for (std::size_t i = 0; i != NUM_TIMERS; ++i)
+    {
+        finished.push_back(hpx::async(&test_sleep_for,
+            std::chrono::milliseconds(i % 50)));
+    }
+
+    hpx::wait_all(finished);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// timed waits which are notified before their timeout cancel their timer, the
+// canceled timer must not interrupt any later suspension of the same thread
+void test_cancel()
+{
+    typedef hpx::lcos::local::mutex mutex_type;
+
+    mutex_type mtx;
+    hpx::lcos::local::condition_variable cond;
+    std::size_t waiting = 0;
+    bool notified = false;
+
+    // all threads have to be running before the first timed wait starts,
+    // otherwise slow thread startup could exceed its timeout
+    hpx::lcos::local::latch started(NUM_TIMERS + 1);
+
+    std::vector<hpx::future<void> > finished;
+    finished.reserve(NUM_TIMERS);
+
+    for (std::size_t i = 0; i != NUM_TIMERS; ++i)
+    {
+        finished.push_back(hpx::async(
+            [&]()
+            {
+                started.count_down_and_wait();
+
+                {
+                    std::unique_lock<mutex_type> l(mtx);
+                    ++waiting;
+                    while (!notified)
+                    {
+                        HPX_TEST(cond.wait_for(l, std::chrono::seconds(1)) ==
+                            hpx::lcos::local::cv_status::no_timeout);
+                    }
+                }
+
+                // suspend past the deadline of the canceled timer
+                test_sleep_for(std::chrono::seconds(2));
+            }));
+    }
+
+    started.count_down_and_wait();
+
+    // wait for all threads to be suspended
+    while (true)
+    {
+        {
+            std::lock_guard<mutex_type> l(mtx);
+            if (waiting == NUM_TIMERS)
+            {
+                notified = true;
+                break;
+            }
+        }
+        hpx::this_thread::yield();
+    }
+    cond.notify_all();
+
+    hpx::wait_all(finished);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    test_sleep();
+    test_cancel();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // By default this test should run on all available cores
+    std::vector<std::string> const cfg = {
+        "hpx.os_threads=all"
+    };
+
+    HPX_TEST_EQ(hpx::init(argc, argv, cfg), 0);
+    return hpx::util::report_errors();
+}
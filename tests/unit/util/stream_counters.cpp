@@ -0,0 +1,82 @@
+//  Copyright (c) 2016 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Stream a couple of counters to a file and verify the decoded time series.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/util/stream_counters.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <boost/cstdint.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+void test_stream_counters(std::size_t downsample)
+{
+    std::string const dest("stream_counters_test.{locality}.bin");
+    std::string const file("stream_counters_test." +
+        std::to_string(hpx::get_locality_id()) + ".bin");
+
+    std::vector<std::string> names;
+    names.push_back("/runtime{locality#*/total}/uptime");
+    names.push_back("/threads{locality#*/total}/count/cumulative");
+
+    {
+        hpx::util::stream_counters sc(names, 1, dest, downsample, 16);
+        sc.start();
+        hpx::this_thread::sleep_for(std::chrono::milliseconds(100));
+        sc.stop();
+    }
+
+    hpx::util::counter_time_series data;
+    {
+        std::ifstream in(file.c_str(), std::ios_base::binary);
+        HPX_TEST(in.good());
+        HPX_TEST(hpx::util::read_counter_stream(in, data));
+    }
+    std::remove(file.c_str());
+
+    HPX_TEST_EQ(data.locality_id_, hpx::get_locality_id());
+    HPX_TEST_EQ(data.interval_, 1000000);
+    HPX_TEST_EQ(data.downsample_, downsample);
+    HPX_TEST_EQ(data.names_.size(), names.size());
+    HPX_TEST_EQ(data.uoms_.size(), names.size());
+
+    HPX_TEST(!data.timestamps_.empty());
+    HPX_TEST_EQ(data.timestamps_.size(), data.values_.size());
+    for (std::size_t i = 1; i < data.timestamps_.size(); ++i)
+    {
+        // timestamps are strictly increasing, the counted threads never
+        // decrease
+        HPX_TEST(data.timestamps_[i - 1] < data.timestamps_[i]);
+        HPX_TEST(data.values_[i - 1][1] <= data.values_[i][1]);
+    }
+    for (std::vector<boost::int64_t> const& values : data.values_)
+        HPX_TEST_EQ(values.size(), names.size());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    test_stream_counters(1);
+    test_stream_counters(4);
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}